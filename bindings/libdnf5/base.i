@@ -1,9 +1,9 @@
 #if defined(SWIGPYTHON)
-%module(package="libdnf5") base
+%module(package="libdnf5", directors="1", threads="1") base
 #elif defined(SWIGPERL)
 %module "libdnf5::base"
 #elif defined(SWIGRUBY)
-%module "libdnf5/base"
+%module(directors="1") "libdnf5/base"
 #endif
 
 %include <exception.i>
@@ -37,6 +37,7 @@
 %{
     #include "libdnf5/logger/memory_buffer_logger.hpp"
     #include "libdnf5/base/base.hpp"
+    #include "libdnf5/base/trace.hpp"
     #include "libdnf5/base/solver_problems.hpp"
     #include "libdnf5/base/log_event.hpp"
     #include "libdnf5/base/transaction.hpp"
@@ -47,15 +48,33 @@
 
 #define CV __perl_CV
 
+#if defined(SWIGPYTHON)
+// Release the GIL during the long-running calls so that other Python threads can run meanwhile.
+%feature("nothreadallow", "0") libdnf5::Goal::resolve;
+%feature("nothreadallow", "0") libdnf5::base::Transaction::download;
+%feature("nothreadallow", "0") libdnf5::base::Transaction::test;
+%feature("nothreadallow", "0") libdnf5::base::Transaction::run;
+%feature("nothreadallow", "0") libdnf5::base::Transaction::check_gpg_signatures;
+#endif
+
 %template(BaseWeakPtr) libdnf5::WeakPtr<libdnf5::Base, false>;
 %template(VarsWeakPtr) libdnf5::WeakPtr<libdnf5::Vars, false>;
 
+// Exporters implemented in the bindings receive the std::chrono time points as opaque objects
+%feature("director") TraceExporter;
+// TraceSpan keeps a pointer to the name of the span, it is meant for the C++ code only
+%ignore libdnf5::TraceSpan;
+%include "libdnf5/base/trace.hpp"
+wrap_unique_ptr(TraceExporterUniquePtr, libdnf5::TraceExporter);
+
 %include "libdnf5/base/base.hpp"
 
 %include "libdnf5/base/solver_problems.hpp"
 %include "libdnf5/base/log_event.hpp"
 
 %ignore libdnf5::base::TransactionError;
+// std::chrono types are not wrapped
+%ignore libdnf5::base::Transaction::get_run_phase_durations;
 %include "libdnf5/base/transaction.hpp"
 
 %template(VectorLogEvent) std::vector<libdnf5::base::LogEvent>;
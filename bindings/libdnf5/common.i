@@ -57,6 +57,7 @@
 %ignore std::vector::resize;
 
 %template(VectorString) std::vector<std::string>;
+%template(VectorVectorString) std::vector<std::vector<std::string>>;
 #if defined(SWIGPYTHON) || defined(SWIGRUBY)
 %template(SetString) std::set<std::string>;
 #endif
@@ -65,6 +66,7 @@
 %template(MapStringString) std::map<std::string, std::string>;
 %template(MapStringMapStringString) std::map<std::string, std::map<std::string, std::string>>;
 %template(MapStringPairStringString) std::map<std::string, std::pair<std::string, std::string>>;
+%template(MapStringSizeT) std::map<std::string, std::size_t>;
 
 namespace std {
   %feature("novaluewrapper") unique_ptr;
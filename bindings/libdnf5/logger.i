@@ -1,5 +1,5 @@
 #if defined(SWIGPYTHON)
-%module(package="libdnf5", directors="1") logger
+%module(package="libdnf5", directors="1", threads="1") logger
 #elif defined(SWIGPERL)
 %module(directors="1") "libdnf5::logger"
 #elif defined(SWIGRUBY)
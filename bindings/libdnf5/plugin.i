@@ -1,5 +1,5 @@
 #if defined(SWIGPYTHON)
-%module(package="libdnf5", directors="1") plugin
+%module(package="libdnf5", directors="1", threads="1") plugin
 #elif defined(SWIGPERL)
 %module "libdnf5::plugin"
 #elif defined(SWIGRUBY)
@@ -1,5 +1,5 @@
 #if defined(SWIGPYTHON)
-%module(package="libdnf5", directors="1") repo
+%module(package="libdnf5", directors="1", threads="1") repo
 #elif defined(SWIGPERL)
 %module "libdnf5::repo"
 #elif defined(SWIGRUBY)
@@ -43,6 +43,17 @@
 
 #define CV __perl_CV
 
+#if defined(SWIGPYTHON)
+// Release the GIL during the long-running calls so that other Python threads can run meanwhile.
+%feature("nothreadallow", "0") libdnf5::repo::FileDownloader::download;
+%feature("nothreadallow", "0") libdnf5::repo::PackageDownloader::download;
+%feature("nothreadallow", "0") libdnf5::repo::Repo::download_metadata;
+%feature("nothreadallow", "0") libdnf5::repo::Repo::load;
+%feature("nothreadallow", "0") libdnf5::repo::Repo::read_metadata_cache;
+%feature("nothreadallow", "0") libdnf5::repo::RepoSack::update_and_load_enabled_repos;
+%feature("nothreadallow", "0") libdnf5::repo::RepoSack::update_and_load_repos;
+#endif
+
 %feature("valuewrapper") Package;
 
 %include "libdnf5/repo/config_repo.hpp"
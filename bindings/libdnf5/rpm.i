@@ -1,5 +1,5 @@
 #if defined(SWIGPYTHON)
-%module(package="libdnf5") rpm
+%module(package="libdnf5", threads="1") rpm
 #elif defined(SWIGPERL)
 %module "libdnf5::rpm"
 #elif defined(SWIGRUBY)
@@ -67,6 +67,10 @@
 %rename(value) libdnf5::rpm::ReldepListIterator::operator*();
 %include "libdnf5/rpm/reldep_list_iterator.hpp"
 %include "libdnf5/rpm/reldep_list.hpp"
+// The views are only valid until the pool changes, the bindings use the std::string getters.
+%ignore libdnf5::rpm::Package::get_name_view;
+%ignore libdnf5::rpm::Package::get_arch_view;
+%ignore libdnf5::rpm::Package::get_evr_view;
 %include "libdnf5/rpm/package.hpp"
 
 %template(VectorPackage) std::vector<libdnf5::rpm::Package>;
@@ -82,6 +86,94 @@
 %ignore libdnf5::rpm::PackageQuery::PackageQuery(PackageQuery && src);
 %include "libdnf5/rpm/package_query.hpp"
 
+%{
+    #include <map>
+
+    namespace {
+
+    using PackageStringGetter = std::string (libdnf5::rpm::Package::*)() const;
+
+    // Package attributes available to the bulk getters of PackageSet.
+    const std::map<std::string, PackageStringGetter> package_string_attributes{
+        {"name", &libdnf5::rpm::Package::get_name},
+        {"epoch", &libdnf5::rpm::Package::get_epoch},
+        {"version", &libdnf5::rpm::Package::get_version},
+        {"release", &libdnf5::rpm::Package::get_release},
+        {"arch", &libdnf5::rpm::Package::get_arch},
+        {"evr", &libdnf5::rpm::Package::get_evr},
+        {"nevra", &libdnf5::rpm::Package::get_nevra},
+        {"full_nevra", &libdnf5::rpm::Package::get_full_nevra},
+        {"na", &libdnf5::rpm::Package::get_na},
+        {"sourcerpm", &libdnf5::rpm::Package::get_sourcerpm},
+        {"source_name", &libdnf5::rpm::Package::get_source_name},
+        {"license", &libdnf5::rpm::Package::get_license},
+        {"vendor", &libdnf5::rpm::Package::get_vendor},
+        {"url", &libdnf5::rpm::Package::get_url},
+        {"summary", &libdnf5::rpm::Package::get_summary},
+        {"description", &libdnf5::rpm::Package::get_description},
+        {"repo_id", &libdnf5::rpm::Package::get_repo_id},
+        {"from_repo_id", &libdnf5::rpm::Package::get_from_repo_id}};
+
+    std::vector<std::string> package_set_get_strings(
+        const libdnf5::rpm::PackageSet & package_set, PackageStringGetter getter) {
+        std::vector<std::string> values;
+        values.reserve(package_set.size());
+        for (const auto & package : package_set) {
+            values.emplace_back((package.*getter)());
+        }
+        return values;
+    }
+
+    }  // namespace
+%}
+
+// Bulk getters return the attributes of all packages in the set in a single call, without creating
+// a proxy object for each package and crossing the bindings boundary for each attribute.
+%extend libdnf5::rpm::PackageSet {
+    std::vector<std::string> get_names() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_name);
+    }
+    std::vector<std::string> get_arches() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_arch);
+    }
+    std::vector<std::string> get_evrs() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_evr);
+    }
+    std::vector<std::string> get_nevras() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_nevra);
+    }
+    std::vector<std::string> get_full_nevras() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_full_nevra);
+    }
+    std::vector<std::string> get_repo_ids() const {
+        return package_set_get_strings(*$self, &libdnf5::rpm::Package::get_repo_id);
+    }
+
+    // Returns one row with the requested attributes for each package in the set.
+    std::vector<std::vector<std::string>> get_attributes(const std::vector<std::string> & attributes) const {
+        std::vector<PackageStringGetter> getters;
+        getters.reserve(attributes.size());
+        for (const auto & attribute : attributes) {
+            auto it = package_string_attributes.find(attribute);
+            if (it == package_string_attributes.end()) {
+                throw std::runtime_error("Unsupported package attribute: \"" + attribute + "\"");
+            }
+            getters.push_back(it->second);
+        }
+
+        std::vector<std::vector<std::string>> rows;
+        rows.reserve($self->size());
+        for (const auto & package : *$self) {
+            auto & row = rows.emplace_back();
+            row.reserve(getters.size());
+            for (auto getter : getters) {
+                row.emplace_back((package.*getter)());
+            }
+        }
+        return rows;
+    }
+}
+
 add_iterator(PackageSet)
 add_iterator(ReldepList)
 
@@ -94,3 +186,4 @@ wrap_unique_ptr(TransactionCallbacksUniquePtr, libdnf5::rpm::TransactionCallback
 %include "libdnf5/rpm/rpm_signature.hpp"
 
 %template(VectorKeyInfo) std::vector<libdnf5::rpm::KeyInfo>;
+%template(VectorRpmSignatureCheckResult) std::vector<libdnf5::rpm::RpmSignature::CheckResult>;
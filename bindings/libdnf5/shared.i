@@ -21,3 +21,10 @@
     // be renamed to Perl_get_context
     #undef get_context
 %}
+
+#if defined(SWIGPYTHON)
+// Modules built with threads="1" would release the GIL around every wrapped call. Keep it held by
+// default and release it only around the long-running calls, which opt in with
+// `%feature("nothreadallow", "0")`. Directors still acquire the GIL before calling into Python.
+%feature("nothreadallow");
+#endif
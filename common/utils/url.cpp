@@ -20,6 +20,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "url.hpp"
 
+#include <cctype>
+
 
 namespace libdnf5::utils::url {
 
@@ -34,4 +36,33 @@ bool is_url(std::string path) {
            path.starts_with("https://");
 }
 
+std::string file_url_to_path(std::string_view url) {
+    if (!url.starts_with("file:")) {
+        return {};
+    }
+    url.remove_prefix(5);
+    if (url.starts_with("//")) {
+        url.remove_prefix(2);
+        if (url.starts_with("localhost/")) {
+            url.remove_prefix(9);
+        }
+    }
+    if (!url.starts_with("/")) {
+        return {};
+    }
+
+    std::string path;
+    path.reserve(url.size());
+    for (std::size_t idx = 0; idx < url.size(); ++idx) {
+        if (url[idx] == '%' && idx + 2 < url.size() && std::isxdigit(static_cast<unsigned char>(url[idx + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(url[idx + 2]))) {
+            path += static_cast<char>(std::stoi(std::string(url.substr(idx + 1, 2)), nullptr, 16));
+            idx += 2;
+        } else {
+            path += url[idx];
+        }
+    }
+    return path;
+}
+
 }  // namespace libdnf5::utils::url
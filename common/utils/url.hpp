@@ -21,12 +21,17 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define LIBDNF5_UTILS_URL_HPP
 
 #include <string>
+#include <string_view>
 
 
 namespace libdnf5::utils::url {
 
 bool is_url(std::string path);
 
+/// Returns the local path of the "file:/path", "file:///path" or "file://localhost/path" URL with
+/// the percent-encoded characters decoded. Returns an empty string for other URLs.
+std::string file_url_to_path(std::string_view url);
+
 }  // namespace libdnf5::utils::url
 
 #endif  // LIBDNF5_UTILS_URL_HPP
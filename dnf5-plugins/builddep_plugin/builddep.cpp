@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils/string.hpp"
 
 #include <dnf5/shared_options.hpp>
+#include <fmt/format.h>
 #include <libdnf5-cli/exception.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
@@ -32,6 +33,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <rpm/rpmmacro.h>
 #include <rpm/rpmts.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace dnf5 {
@@ -64,6 +66,13 @@ void BuildDepCommand::set_argument_parser() {
     cmd.register_positional_arg(specs);
 
     allow_erasing = std::make_unique<AllowErasingOption>(*this);
+    resolve_separately = std::make_unique<libdnf5::cli::session::BoolOption>(
+        *this,
+        "resolve-separately",
+        '\0',
+        "Resolve the build dependencies of each input separately and print the packages that would be installed "
+        "for each of them. Nothing is installed.",
+        false);
     auto skip_unavailable = std::make_unique<SkipUnavailableOption>(*this);
     create_allow_downgrade_options(*this);
 
@@ -230,9 +239,26 @@ std::string escape_glob(const std::string & in) {
 }
 
 void BuildDepCommand::run() {
+    // Build dependencies of the inputs. When resolving separately, there is an entry for each input,
+    // otherwise the dependencies of all inputs are merged into a single entry.
+    struct InputDeps {
+        std::string input;
+        std::set<std::string> install_specs;
+        std::set<std::string> conflicts_specs;
+    };
+    const bool separately = resolve_separately->get_value();
+    std::vector<InputDeps> inputs_deps;
+    if (!separately) {
+        inputs_deps.emplace_back();
+    }
+    auto deps_for = [&](const std::string & input) -> InputDeps & {
+        if (separately) {
+            inputs_deps.push_back({input, {}, {}});
+        }
+        return inputs_deps.back();
+    };
+
     // get build dependencies from various inputs
-    std::set<std::string> install_specs{};
-    std::set<std::string> conflicts_specs{};
     bool parse_ok = true;
 
     if (spec_file_paths.size() > 0) {
@@ -241,7 +267,8 @@ void BuildDepCommand::run() {
         }
 
         for (const auto & spec : spec_file_paths) {
-            parse_ok &= add_from_spec_file(install_specs, conflicts_specs, spec.c_str());
+            auto & deps = deps_for(spec);
+            parse_ok &= add_from_spec_file(deps.install_specs, deps.conflicts_specs, spec.c_str());
         }
 
         for (const auto & macro : rpm_macros) {
@@ -254,11 +281,13 @@ void BuildDepCommand::run() {
     }
 
     for (const auto & srpm : srpm_file_paths) {
-        parse_ok &= add_from_srpm_file(install_specs, conflicts_specs, srpm.c_str());
+        auto & deps = deps_for(srpm);
+        parse_ok &= add_from_srpm_file(deps.install_specs, deps.conflicts_specs, srpm.c_str());
     }
 
     for (const auto & pkg : pkg_specs) {
-        parse_ok &= add_from_pkg(install_specs, conflicts_specs, pkg);
+        auto & deps = deps_for(pkg);
+        parse_ok &= add_from_pkg(deps.install_specs, deps.conflicts_specs, pkg);
     }
 
     if (!parse_ok) {
@@ -266,10 +295,61 @@ void BuildDepCommand::run() {
         throw libdnf5::cli::Error(M_("Failed to parse some inputs."));
     }
 
-    // fill the goal with build dependencies
-    auto goal = get_context().get_goal();
-    goal->set_allow_erasing(allow_erasing->get_value());
+    if (!separately) {
+        // fill the goal with build dependencies
+        auto goal = get_context().get_goal();
+        goal->set_allow_erasing(allow_erasing->get_value());
+        add_goal_jobs(*goal, inputs_deps.front().install_specs, inputs_deps.front().conflicts_specs);
+        return;
+    }
+
+    // Resolve the build dependencies of each input against the same loaded repositories.
+    // The excludes of conflicting packages added for an input must not affect the other inputs.
+    auto & ctx = get_context();
+    auto rpm_package_sack = ctx.base.get_rpm_package_sack();
+    const auto user_excludes = rpm_package_sack->get_user_excludes();
+    const auto skip_unavailable = ctx.base.get_config().get_skip_unavailable_option().get_value();
+    bool resolve_ok = true;
+    for (const auto & deps : inputs_deps) {
+        libdnf5::Goal goal(ctx.base);
+        goal.set_allow_erasing(allow_erasing->get_value());
+        add_goal_jobs(goal, deps.install_specs, deps.conflicts_specs);
+        auto transaction = goal.resolve();
+        rpm_package_sack->set_user_excludes(user_excludes);
+
+        std::cout << deps.input << ":" << std::endl;
+        auto transaction_problems = transaction.get_problems();
+        if (transaction_problems != libdnf5::GoalProblem::NO_PROBLEM &&
+            (transaction_problems != libdnf5::GoalProblem::NOT_FOUND || !skip_unavailable)) {
+            for (const auto & log : transaction.get_resolve_logs_as_strings()) {
+                std::cerr << log << std::endl;
+            }
+            resolve_ok = false;
+            continue;
+        }
+
+        std::vector<std::string> lines;
+        for (const auto & tspkg : transaction.get_transaction_packages_ref()) {
+            if (tspkg.get_action() != libdnf5::transaction::TransactionItemAction::REPLACED) {
+                lines.emplace_back(fmt::format(
+                    "  {} {}",
+                    libdnf5::transaction::transaction_item_action_to_string(tspkg.get_action()),
+                    tspkg.get_package().get_full_nevra()));
+            }
+        }
+        std::sort(lines.begin(), lines.end());
+        for (const auto & line : lines) {
+            std::cout << line << std::endl;
+        }
+    }
+
+    if (!resolve_ok) {
+        throw libdnf5::cli::Error(M_("Failed to resolve build dependencies of some inputs."));
+    }
+}
 
+void BuildDepCommand::add_goal_jobs(
+    libdnf5::Goal & goal, const std::set<std::string> & install_specs, const std::set<std::string> & conflicts_specs) {
     // Search only for solution in provides and files. Use buildrequire with name search migh result in inconsistent
     // behavior with installing dependencies of RPMs
     libdnf5::GoalJobSettings settings;
@@ -278,7 +358,7 @@ void BuildDepCommand::run() {
 
     for (const auto & spec : install_specs) {
         if (libdnf5::rpm::Reldep::is_rich_dependency(spec)) {
-            goal->add_provide_install(spec);
+            goal.add_provide_install(spec);
         } else {
             // File provides could be satisfied by standard provides or files. With DNF5 we have to test both because
             // we do not download filelists and some files could be explicitly mentioned in provide section. The best
@@ -290,7 +370,7 @@ void BuildDepCommand::run() {
             // be needed:
             // https://github.com/rpm-software-management/dnf5/pull/1085
             const auto & escaped_spec = escape_glob(spec);
-            goal->add_rpm_install(escaped_spec, settings);
+            goal.add_rpm_install(escaped_spec, settings);
         }
     }
 
@@ -307,7 +387,7 @@ void BuildDepCommand::run() {
 
         // remove already installed conflicting packages
         conflicts_query_installed.filter_repo_id({system_repo->get_id()});
-        goal->add_rpm_remove(conflicts_query_installed);
+        goal.add_rpm_remove(conflicts_query_installed);
     }
 }
 
@@ -49,6 +49,10 @@ private:
         std::set<std::string> & install_specs, std::set<std::string> & conflicts_specs, const char * srpm_file_name);
     bool add_from_pkg(
         std::set<std::string> & install_specs, std::set<std::string> & conflicts_specs, const std::string & pkg_spec);
+    void add_goal_jobs(
+        libdnf5::Goal & goal,
+        const std::set<std::string> & install_specs,
+        const std::set<std::string> & conflicts_specs);
 
     std::vector<std::string> pkg_specs{};
     std::vector<std::string> spec_file_paths{};
@@ -56,6 +60,7 @@ private:
     std::vector<std::pair<std::string, std::string>> rpm_macros{};
 
     std::unique_ptr<AllowErasingOption> allow_erasing;
+    std::unique_ptr<libdnf5::cli::session::BoolOption> resolve_separately;
 };
 
 
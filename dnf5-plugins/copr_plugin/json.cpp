@@ -23,16 +23,13 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "libdnf5/utils/fs/temp.hpp"
 
-#include <fstream>
 #include <iostream>
 
 Json::Json(libdnf5::Base & base, const std::string & url) {
     auto temp_file = libdnf5::utils::fs::TempFile("/tmp", "dnf5-copr-plugin");
     download_file(base, url, temp_file.get_path());
-    std::ifstream file(temp_file.get_path());
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    root = json_tokener_parse(buffer.str().c_str());
+    // Parse the downloaded file directly, without reading it into an intermediate string first
+    root = json_object_from_file(temp_file.get_path().c_str());
     this->cleanup = true;
 }
 
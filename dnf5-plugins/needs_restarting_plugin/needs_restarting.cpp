@@ -25,18 +25,21 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/conf/option_string.hpp>
 #include <libdnf5/rpm/package.hpp>
 #include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/rpm/package_set.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <utils/string.hpp>
 
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <vector>
 
 const std::string SYSTEMD_DESTINATION_NAME{"org.freedesktop.systemd1"};
 const std::string SYSTEMD_OBJECT_PATH{"/org/freedesktop/systemd1"};
 const std::string SYSTEMD_MANAGER_INTERFACE{"org.freedesktop.systemd1.Manager"};
 const std::string SYSTEMD_UNIT_INTERFACE{"org.freedesktop.systemd1.Unit"};
+const std::string DBUS_PROPERTIES_INTERFACE{"org.freedesktop.DBus.Properties"};
 
 namespace dnf5 {
 
@@ -115,7 +118,7 @@ time_t NeedsRestartingCommand::get_boot_time(Context & ctx) {
     try {
         std::unique_ptr<sdbus::IConnection> connection;
         connection = sdbus::createSystemBusConnection();
-        auto proxy = sdbus::createProxy(SYSTEMD_DESTINATION_NAME, SYSTEMD_OBJECT_PATH);
+        auto proxy = sdbus::createProxy(*connection, SYSTEMD_DESTINATION_NAME, SYSTEMD_OBJECT_PATH);
 
         const uint64_t systemd_boot_time_us =
             proxy->getProperty("UserspaceTimestamp").onInterface(SYSTEMD_MANAGER_INTERFACE);
@@ -158,33 +161,6 @@ time_t NeedsRestartingCommand::get_boot_time(Context & ctx) {
     return boot_time;
 }
 
-libdnf5::rpm::PackageSet recursive_dependencies(
-    const libdnf5::rpm::Package & package, libdnf5::rpm::PackageQuery & installed) {
-    libdnf5::rpm::PackageSet dependencies{package.get_base()};
-    dependencies.add(package);
-
-    std::vector<libdnf5::rpm::Package> stack;
-    stack.emplace_back(package);
-
-    while (!stack.empty()) {
-        const auto & current = stack.back();
-        stack.pop_back();
-
-        libdnf5::rpm::PackageQuery query{installed};
-        query.filter_provides(current.get_requires());
-
-        for (const auto & dependency : query) {
-            if (!dependencies.contains(dependency)) {
-                stack.emplace_back(dependency);
-            }
-        }
-
-        dependencies |= query;
-    }
-
-    return dependencies;
-}
-
 void NeedsRestartingCommand::system_needs_restarting(Context & ctx) {
     const auto boot_time = get_boot_time(ctx);
 
@@ -231,7 +207,7 @@ void NeedsRestartingCommand::services_need_restarting(Context & ctx) {
         throw libdnf5::cli::CommandExitError(1, M_("Couldn't connect to D-Bus: {}"), error_message);
     }
 
-    auto systemd_proxy = sdbus::createProxy(SYSTEMD_DESTINATION_NAME, SYSTEMD_OBJECT_PATH);
+    auto systemd_proxy = sdbus::createProxy(*connection, SYSTEMD_DESTINATION_NAME, SYSTEMD_OBJECT_PATH);
 
     std::vector<sdbus::Struct<
         std::string,
@@ -264,51 +240,68 @@ void NeedsRestartingCommand::services_need_restarting(Context & ctx) {
             continue;
         }
 
-        const auto unit_object_path = std::get<6>(unit);
-        auto unit_proxy = sdbus::createProxy(SYSTEMD_DESTINATION_NAME, unit_object_path);
-
         // Only consider active (running) services
-        const auto active_state = unit_proxy->getProperty("ActiveState").onInterface(SYSTEMD_UNIT_INTERFACE);
-        if (std::string{active_state} != "active") {
+        const auto & active_state = std::get<3>(unit);
+        if (active_state != "active") {
             continue;
         }
 
+        // Get all the properties of the unit in a single call, reusing the connection
+        const auto unit_object_path = std::get<6>(unit);
+        auto unit_proxy = sdbus::createProxy(*connection, SYSTEMD_DESTINATION_NAME, unit_object_path);
+        std::map<std::string, sdbus::Variant> properties;
+        unit_proxy->callMethod("GetAll")
+            .onInterface(DBUS_PROPERTIES_INTERFACE)
+            .withArguments(SYSTEMD_UNIT_INTERFACE)
+            .storeResultsTo(properties);
+
         // FragmentPath is the path to the unit file that defines the service
-        const auto fragment_path = unit_proxy->getProperty("FragmentPath").onInterface(SYSTEMD_UNIT_INTERFACE);
-        const auto start_timestamp_us =
-            unit_proxy->getProperty("ActiveEnterTimestamp").onInterface(SYSTEMD_UNIT_INTERFACE);
+        const auto fragment_path = properties.at("FragmentPath").get<std::string>();
+        const auto start_timestamp_us = properties.at("ActiveEnterTimestamp").get<uint64_t>();
 
         unit_file_to_service.insert(std::make_pair(fragment_path, Service{unit_name, start_timestamp_us}));
     }
 
-    // Iterate over each file from each installed package and check whether it
-    // is a unit file for a running service. This is much faster than running
-    // filter_file on each unit file.
-    libdnf5::rpm::PackageQuery installed{ctx.base};
-    installed.filter_installed();
-
     std::vector<std::string> service_names;
-    for (const auto & package : installed) {
-        for (const auto & file : package.get_files()) {
-            const auto & service_pair = unit_file_to_service.find(file);
-            if (service_pair != unit_file_to_service.end()) {
-                // If the file is a unit file for a running service
-                const auto & service = service_pair->second;
-
-                // Recursively get all dependencies of the package that
-                // provides the service (and include the package itself)
-                const auto & deps = recursive_dependencies(package, installed);
-                for (const auto & dep : deps) {
-                    // If any dependency (or the package itself) has been
-                    // updated since the service started, recommend restarting
-                    // of that service
-                    const uint64_t install_timestamp_us = 1000L * 1000L * dep.get_install_time();
-                    if (install_timestamp_us > service.start_timestamp_us) {
-                        service_names.emplace_back(service.name);
-                        break;
+    if (!unit_file_to_service.empty()) {
+        libdnf5::rpm::PackageQuery installed{ctx.base};
+        installed.filter_installed();
+
+        // Find the installed packages that own the unit files with a single lookup (it uses the file index).
+        // Only the files of these few packages are then searched.
+        std::vector<std::string> unit_files;
+        unit_files.reserve(unit_file_to_service.size());
+        for (const auto & [unit_file, service] : unit_file_to_service) {
+            unit_files.emplace_back(unit_file);
+        }
+        libdnf5::rpm::PackageQuery unit_file_owners{installed};
+        unit_file_owners.filter_file(unit_files);
+
+        for (const auto & package : unit_file_owners) {
+            for (const auto & file : package.get_files()) {
+                const auto & service_pair = unit_file_to_service.find(file);
+                if (service_pair != unit_file_to_service.end()) {
+                    // If the file is a unit file for a running service
+                    const auto & service = service_pair->second;
+
+                    // Recursively get all dependencies of the package that
+                    // provides the service (and include the package itself)
+                    libdnf5::rpm::PackageSet service_package{ctx.base};
+                    service_package.add(package);
+                    libdnf5::rpm::PackageQuery deps{installed};
+                    deps.filter_requires_closure(service_package);
+                    for (const auto & dep : deps) {
+                        // If any dependency (or the package itself) has been
+                        // updated since the service started, recommend restarting
+                        // of that service
+                        const uint64_t install_timestamp_us = 1000L * 1000L * dep.get_install_time();
+                        if (install_timestamp_us > service.start_timestamp_us) {
+                            service_names.emplace_back(service.name);
+                            break;
+                        }
                     }
+                    break;
                 }
-                break;
             }
         }
     }
@@ -23,14 +23,83 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/conf/const.hpp>
 #include <libdnf5/rpm/package.hpp>
 #include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/rpm/reldep_list.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <libdnf5/utils/format.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
 
 
 namespace dnf5 {
 
+namespace {
+
+using UnresolvedPackages = std::vector<std::pair<libdnf5::rpm::Package, std::vector<std::string>>>;
+
+// Appends the packages from `to_check_query` that have requires not provided by any package
+// from `available_query` to `unresolved_packages`.
+void find_unresolved_packages(
+    libdnf5::Base & base,
+    const libdnf5::rpm::PackageQuery & available_query,
+    const libdnf5::rpm::PackageQuery & to_check_query,
+    UnresolvedPackages & unresolved_packages) {
+    // collect unique requires of all checked packages and find the unsatisfied ones at once
+    libdnf5::rpm::ReldepList requires_list(base);
+    std::unordered_set<int> requires_ids;
+    for (const auto & pkg : to_check_query) {
+        for (const auto & reldep : pkg.get_requires()) {
+            if (requires_ids.insert(reldep.get_id().id).second) {
+                requires_list.add(reldep.get_id());
+            }
+        }
+    }
+    std::unordered_set<int> unsatisfied_ids;
+    for (const auto & reldep : available_query.get_unprovided_reldeps(requires_list)) {
+        unsatisfied_ids.insert(reldep.get_id().id);
+    }
+
+    if (!unsatisfied_ids.empty()) {
+        for (const auto & pkg : to_check_query) {
+            std::vector<std::string> unsatisfied;
+            for (const auto & reldep : pkg.get_requires()) {
+                if (unsatisfied_ids.contains(reldep.get_id().id)) {
+                    unsatisfied.emplace_back(reldep.to_string());
+                }
+            }
+            if (!unsatisfied.empty()) {
+                std::sort(unsatisfied.begin(), unsatisfied.end());
+                unresolved_packages.emplace_back(pkg, std::move(unsatisfied));
+            }
+        }
+    }
+}
+
+// Merges the entries of the same package into one. With --per-arch the noarch packages are checked together
+// with the packages of each architecture and can be unresolved for several of them.
+void merge_unresolved_packages(UnresolvedPackages & unresolved_packages) {
+    UnresolvedPackages merged;
+    std::unordered_map<int, std::size_t> pkg_indexes;
+    for (auto & [pkg, unsatisfied] : unresolved_packages) {
+        auto [it, inserted] = pkg_indexes.emplace(pkg.get_id().id, merged.size());
+        if (inserted) {
+            merged.emplace_back(pkg, std::move(unsatisfied));
+            continue;
+        }
+        auto & merged_unsatisfied = merged[it->second].second;
+        merged_unsatisfied.insert(merged_unsatisfied.end(), unsatisfied.begin(), unsatisfied.end());
+        std::sort(merged_unsatisfied.begin(), merged_unsatisfied.end());
+        merged_unsatisfied.erase(
+            std::unique(merged_unsatisfied.begin(), merged_unsatisfied.end()), merged_unsatisfied.end());
+    }
+    unresolved_packages = std::move(merged);
+}
+
+}  // namespace
+
 void RepoclosureCommand::set_parent_command() {
     auto * arg_parser_parent_cmd = get_session().get_argument_parser().get_root_command();
     auto * arg_parser_this_cmd = get_argument_parser_command();
@@ -85,7 +154,9 @@ void RepoclosureCommand::set_argument_parser() {
                                         const char * value) {
         libdnf5::OptionStringList list_value(value);
         for (const auto & arch : list_value.get_value()) {
-            arches.emplace_back(arch);
+            if (std::find(arches.begin(), arches.end(), arch) == arches.end()) {
+                arches.emplace_back(arch);
+            }
         }
         return true;
     });
@@ -93,6 +164,14 @@ void RepoclosureCommand::set_argument_parser() {
 
     newest = std::make_unique<libdnf5::cli::session::BoolOption>(
         *this, "newest", '\0', "Only consider the latest version of a package from each repo.", false);
+
+    per_arch = std::make_unique<libdnf5::cli::session::BoolOption>(
+        *this,
+        "per-arch",
+        '\0',
+        "Check the packages of each architecture specified by --arch separately, resolving their dependencies "
+        "only with packages of the same architecture or noarch. noarch packages are checked with each architecture.",
+        false);
 }
 
 void RepoclosureCommand::configure() {
@@ -116,20 +195,22 @@ void RepoclosureCommand::run() {
     if (newest_used) {
         libdnf5::repo::RepoQuery repos(ctx.base);
         repos.filter_enabled(true);
+        std::vector<std::string> repo_ids;
         for (const auto & repo : repos) {
-            libdnf5::rpm::PackageQuery repo_pkgs(ctx.base);
-            repo_pkgs.filter_repo_id({repo->get_id()});
-            repo_pkgs.filter_latest_evr();
-            available_query |= repo_pkgs;
-            to_check_query |= repo_pkgs;
+            repo_ids.push_back(repo->get_id());
         }
+        libdnf5::rpm::PackageQuery repo_pkgs(ctx.base);
+        repo_pkgs.filter_repo_id(repo_ids);
+        repo_pkgs.filter_latest_evr_per_repo();
+        available_query |= repo_pkgs;
+        to_check_query |= repo_pkgs;
     }
 
     if (!check_repos.empty()) {
         to_check_query.filter_repo_id(check_repos);
     }
 
-    if (!arches.empty()) {
+    if (!arches.empty() && !per_arch->get_value()) {
         to_check_query.filter_arch(arches);
     }
 
@@ -159,31 +240,33 @@ void RepoclosureCommand::run() {
     }
 
 
-    // cache query results: reldepid -> whether the reldep is satisfied
-    std::unordered_map<int, bool> resolved;
-    std::vector<std::pair<libdnf5::rpm::Package, std::vector<std::string>>> unresolved_packages;
-    for (const auto & pkg : to_check_query) {
-        std::vector<std::string> unsatisfied;
-        for (const auto & reldep : pkg.get_requires()) {
-            int reldep_id = reldep.get_id().id;
-            auto resolved_it = resolved.find(reldep_id);
-            bool satisfied;
-            if (resolved_it == resolved.end()) {
-                libdnf5::rpm::PackageQuery reldep_q(available_query);
-                reldep_q.filter_provides(reldep);
-                satisfied = !reldep_q.empty();
-                resolved.emplace(reldep_id, satisfied);
-            } else {
-                satisfied = resolved_it->second;
-            }
-            if (!satisfied) {
-                unsatisfied.emplace_back(reldep.to_string());
-            }
+    UnresolvedPackages unresolved_packages;
+    if (per_arch->get_value() && !arches.empty()) {
+        // check the packages of each architecture separately, using only the providers of the same architecture
+        // or noarch; all combinations share the loaded metadata
+        // noarch packages are checked with each of the architectures, as they can be installed on any of them
+        bool check_noarch = std::find(arches.begin(), arches.end(), "noarch") != arches.end();
+        std::vector<std::string> check_arches;
+        std::copy_if(arches.begin(), arches.end(), std::back_inserter(check_arches), [](const std::string & arch) {
+            return arch != "noarch";
+        });
+        if (check_arches.empty()) {
+            check_arches.emplace_back("noarch");
         }
-        if (!unsatisfied.empty()) {
-            std::sort(unsatisfied.begin(), unsatisfied.end());
-            unresolved_packages.emplace_back(pkg, std::move(unsatisfied));
+        for (const auto & arch : check_arches) {
+            std::vector<std::string> arch_with_noarch{arch};
+            if (arch != "noarch") {
+                arch_with_noarch.emplace_back("noarch");
+            }
+            libdnf5::rpm::PackageQuery arch_to_check_query(to_check_query);
+            arch_to_check_query.filter_arch(check_noarch ? arch_with_noarch : std::vector<std::string>{arch});
+            libdnf5::rpm::PackageQuery arch_available_query(available_query);
+            arch_available_query.filter_arch(arch_with_noarch);
+            find_unresolved_packages(ctx.base, arch_available_query, arch_to_check_query, unresolved_packages);
         }
+        merge_unresolved_packages(unresolved_packages);
+    } else {
+        find_unresolved_packages(ctx.base, available_query, to_check_query, unresolved_packages);
     }
 
     if (!unresolved_packages.empty()) {
@@ -107,7 +107,6 @@ void CheckUpgradeCommand::run() {
     auto & ctx = get_context();
     auto & config = ctx.base.get_config();
 
-    libdnf5::rpm::PackageQuery full_package_query(ctx.base);
     libdnf5::rpm::PackageQuery upgrades_query(ctx.base);
 
     // filter by provided specs, for `check-upgrade <pkg1> <pkg2> ...`
@@ -188,6 +187,7 @@ void CheckUpgradeCommand::run() {
         // If any upgrades were found, print a table of them, and optionally print changelogs. Return exit code 100.
         sections->print();
         if (changelogs->get_value()) {
+            libdnf5::rpm::PackageQuery full_package_query(ctx.base);
             libdnf5::cli::output::print_changelogs(
                 upgrades_query, {libdnf5::cli::output::ChangelogFilterType::UPGRADES, full_package_query});
         }
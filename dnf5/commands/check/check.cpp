@@ -270,6 +270,9 @@ void CheckCommand::run() {
     auto ts = rpmtsCreate();
     auto & config = ctx.base.get_config();
     rpmtsSetRootDir(ts, config.get_installroot_option().get_value().c_str());
+    // Only the dependencies of the installed packages are checked. Skip the digest and signature verification
+    // of every header read from the rpmdb, both when iterating the packages and in the lookups of rpmtsCheck().
+    rpmtsSetVSFlags(ts, rpmtsVSFlags(ts) | RPMVSF_NOHDRCHK);
 
     rpmdbMatchIterator mi = rpmtsInitIterator(ts, RPMDBI_PACKAGES, NULL, 0);
     std::unique_ptr<std::remove_pointer_t<rpmdbMatchIterator>, decltype(&rpmdbFreeIterator)> mi_owner(
@@ -25,8 +25,12 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/utils/bgettext/bgettext-lib.h>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 
 namespace fs = std::filesystem;
@@ -130,17 +134,26 @@ void CleanCommand::run() {
     fs::path cachedir{ctx.base.get_config().get_cachedir_option().get_value()};
 
     std::error_code ec;
-    libdnf5::repo::RepoCache::RemoveStatistics statistics{};
+    std::vector<fs::path> repo_cache_dirs;
     for (const auto & dir_entry : std::filesystem::directory_iterator(cachedir, ec)) {
-        if (!dir_entry.is_directory()) {
-            continue;
+        if (dir_entry.is_directory()) {
+            repo_cache_dirs.emplace_back(dir_entry.path());
         }
-        libdnf5::repo::RepoCache cache(ctx.base.get_weak_ptr(), dir_entry.path());
+    }
+
+    if (ec) {
+        throw std::runtime_error(fmt::format("Cannot iterate the cache directory: \"{}\"", cachedir.string()));
+    }
 
+    std::vector<libdnf5::repo::RepoCache::RemoveStatistics> repo_statistics(repo_cache_dirs.size());
+    std::vector<std::string> repo_errors(repo_cache_dirs.size());
+    auto clean_repo_cache = [&](std::size_t idx) {
+        libdnf5::repo::RepoCache cache(ctx.base.get_weak_ptr(), repo_cache_dirs[idx]);
+        auto & statistics = repo_statistics[idx];
         try {
             if (required_actions & CLEAN_ALL) {
                 statistics += cache.remove_all();
-                continue;
+                return;
             }
             if (required_actions & CLEAN_METADATA) {
                 statistics += cache.remove_metadata();
@@ -155,18 +168,41 @@ void CleanCommand::run() {
                 cache.write_attribute(libdnf5::repo::RepoCache::ATTRIBUTE_EXPIRED);
             }
         } catch (const std::exception & ex) {
+            repo_errors[idx] = ex.what();
+        }
+    };
+
+    // Removing files is bound by the filesystem latency (especially on network filesystems), repository
+    // caches are cleaned in parallel.
+    const auto workers_count =
+        std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), repo_cache_dirs.size());
+    std::atomic<std::size_t> next_idx{0};
+    auto worker = [&]() {
+        for (auto idx = next_idx++; idx < repo_cache_dirs.size(); idx = next_idx++) {
+            clean_repo_cache(idx);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto & thread : workers) {
+        thread.join();
+    }
+
+    libdnf5::repo::RepoCache::RemoveStatistics statistics{};
+    for (std::size_t idx = 0; idx < repo_cache_dirs.size(); ++idx) {
+        statistics += repo_statistics[idx];
+        if (!repo_errors[idx].empty()) {
             std::cerr << libdnf5::utils::sformat(
                              _("Failed to cleanup repository cache in path \"{0}\": {1}"),
-                             dir_entry.path().native(),
-                             ex.what())
+                             repo_cache_dirs[idx].native(),
+                             repo_errors[idx])
                       << std::endl;
         }
     }
 
-    if (ec) {
-        throw std::runtime_error(fmt::format("Cannot iterate the cache directory: \"{}\"", cachedir.string()));
-    }
-
     std::cout << fmt::format(
                      "Removed {} files, {} directories. {} errors occurred.",
                      statistics.files_removed,
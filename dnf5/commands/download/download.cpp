@@ -113,19 +113,20 @@ void DownloadCommand::run() {
     auto create_nevra_pkg_pair = [](const libdnf5::rpm::Package & pkg) { return std::make_pair(pkg.get_nevra(), pkg); };
 
     std::map<std::string, libdnf5::rpm::Package> download_pkgs;
+    // Packages brought in by resolving a previous package, their dependencies are already being downloaded
+    libdnf5::rpm::PackageSet resolved_pkgs(ctx.base);
     libdnf5::rpm::PackageQuery full_pkg_query(ctx.base);
     for (auto & pattern : *patterns_to_download_options) {
         libdnf5::rpm::PackageQuery pkg_query(full_pkg_query);
         auto option = dynamic_cast<libdnf5::OptionString *>(pattern.get());
         pkg_query.resolve_pkg_spec(option->get_value(), {}, true);
         pkg_query.filter_available();
-        pkg_query.filter_priority();
-        pkg_query.filter_latest_evr();
+        pkg_query.filter_latest_evr_by_priority();
 
         for (const auto & pkg : pkg_query) {
             download_pkgs.insert(create_nevra_pkg_pair(pkg));
 
-            if (resolve_option->get_value()) {
+            if (resolve_option->get_value() && !resolved_pkgs.contains(pkg)) {
                 auto goal = std::make_unique<libdnf5::Goal>(ctx.base);
                 goal->add_rpm_install(pkg, {});
 
@@ -136,10 +137,11 @@ void DownloadCommand::run() {
                         throw GoalResolveError(transaction);
                     }
                 }
-                for (auto & tspkg : transaction.get_transaction_packages()) {
+                for (auto & tspkg : transaction.get_transaction_packages_ref()) {
                     if (transaction_item_action_is_inbound(tspkg.get_action()) &&
                         tspkg.get_package().get_repo()->get_type() != libdnf5::repo::Repo::Type::COMMANDLINE) {
                         download_pkgs.insert(create_nevra_pkg_pair(tspkg.get_package()));
+                        resolved_pkgs.add(tspkg.get_package());
                     }
                 }
             }
@@ -54,6 +54,8 @@ void HistoryListCommand::run() {
         std::sort(transactions.begin(), transactions.end());
     }
 
+    // the list shows the number of altered packages of each transaction
+    history.load_transactions_packages(transactions);
     libdnf5::cli::output::print_transaction_list(transactions);
 }
 
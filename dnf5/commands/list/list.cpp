@@ -182,8 +182,7 @@ void ListCommand::run() {
             libdnf5::rpm::PackageQuery available(base_query);
             available.filter_available();
             if (!show_duplicates->get_value()) {
-                available.filter_priority();
-                available.filter_latest_evr();
+                available.filter_latest_evr_by_priority();
                 // keep only those available packages that are either not installed or
                 // available EVR is higher than the installed one
                 libdnf5::rpm::PackageQuery installed_latest(installed);
@@ -201,8 +200,7 @@ void ListCommand::run() {
         case PkgNarrow::AVAILABLE: {
             base_query.filter_available();
             if (!show_duplicates->get_value()) {
-                base_query.filter_priority();
-                base_query.filter_latest_evr();
+                base_query.filter_latest_evr_by_priority();
             }
             package_matched |= sections->add_section("Available packages", base_query, colorizer);
             break;
@@ -242,8 +240,7 @@ void ListCommand::run() {
         case PkgNarrow::RECENT:
             base_query.filter_available();
             if (!show_duplicates->get_value()) {
-                base_query.filter_priority();
-                base_query.filter_latest_evr();
+                base_query.filter_latest_evr_by_priority();
             }
             auto recent_limit_days = config.get_recent_option().get_value();
             auto now = time(NULL);
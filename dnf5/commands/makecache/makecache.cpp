@@ -21,13 +21,38 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <dnf5/shared_options.hpp>
 #include <fmt/format.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 
 namespace dnf5 {
 
 using namespace libdnf5::cli;
 
+namespace {
+
+// Values from the kernel's linux/ioprio.h, which is not available with older kernel headers
+constexpr int IOPRIO_WHO_PROCESS = 1;
+constexpr int IOPRIO_CLASS_IDLE = 3;
+constexpr int IOPRIO_CLASS_SHIFT = 13;
+
+// Lowers the CPU and IO priority of the process, the failures are only logged.
+void set_background_priority(libdnf5::Logger & logger) {
+    errno = 0;
+    if (nice(19) == -1 && errno != 0) {
+        logger.warning("Cannot lower the CPU priority: {}", std::strerror(errno));
+    }
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) == -1) {
+        logger.warning("Cannot set the idle IO scheduling class: {}", std::strerror(errno));
+    }
+}
+
+}  // namespace
+
 void MakeCacheCommand::set_parent_command() {
     auto * arg_parser_parent_cmd = get_session().get_argument_parser().get_root_command();
     auto * arg_parser_this_cmd = get_argument_parser_command();
@@ -35,7 +60,18 @@ void MakeCacheCommand::set_parent_command() {
 }
 
 void MakeCacheCommand::set_argument_parser() {
-    get_argument_parser_command()->set_description("Generate the metadata cache");
+    auto & parser = get_context().get_argument_parser();
+    auto & cmd = *get_argument_parser_command();
+    cmd.set_description("Generate the metadata cache");
+
+    background = dynamic_cast<libdnf5::OptionBool *>(
+        parser.add_init_value(std::unique_ptr<libdnf5::OptionBool>(new libdnf5::OptionBool(false))));
+    auto background_opt = parser.add_new_named_arg("background");
+    background_opt->set_long_name("background");
+    background_opt->set_description("Run with the lowest CPU priority and the idle IO scheduling class");
+    background_opt->set_const_value("true");
+    background_opt->link_value(background);
+    cmd.register_named_arg(background_opt);
 }
 
 void MakeCacheCommand::run() {
@@ -57,8 +93,15 @@ void MakeCacheCommand::run() {
         return;
     }
 
+    if (background->get_value()) {
+        set_background_priority(*ctx.base.get_logger());
+    }
+
     ctx.load_repos(false);
 
+    // Opportunistically drop the least recently used caches of no longer enabled repositories.
+    ctx.base.get_repo_sack()->apply_cache_budget();
+
     std::cout << "Metadata cache created." << std::endl;
 }
 
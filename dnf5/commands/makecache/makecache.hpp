@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define DNF5_COMMANDS_MAKECAHE_MAKECACHE_HPP
 
 #include <dnf5/context.hpp>
+#include <libdnf5/conf/option_bool.hpp>
 
 namespace dnf5 {
 
@@ -30,6 +31,9 @@ public:
     void set_parent_command() override;
     void set_argument_parser() override;
     void run() override;
+
+private:
+    libdnf5::OptionBool * background{nullptr};
 };
 
 }  // namespace dnf5
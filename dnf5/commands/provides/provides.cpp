@@ -69,12 +69,9 @@ void ProvidesCommand::configure() {
 
 std::pair<libdnf5::rpm::PackageQuery, libdnf5::cli::output::ProvidesMatchedBy> ProvidesCommand::filter_spec(
     std::string spec, const libdnf5::rpm::PackageQuery & full_package_query) {
-    auto provides_query = full_package_query;
-    auto filename_query = full_package_query;
-    auto binary_query = full_package_query;
-
     // if the spec starts with "/" assume it's a provide by filename and skip this query
     if (!(spec.rfind("/", 0) == 0)) {
+        auto provides_query = full_package_query;
         provides_query.filter_provides(std::vector<std::string>({spec}), libdnf5::sack::QueryCmp::GLOB);
         if (!provides_query.empty()) {
             return std::make_pair(provides_query, libdnf5::cli::output::ProvidesMatchedBy::PROVIDES);
@@ -86,6 +83,7 @@ std::pair<libdnf5::rpm::PackageQuery, libdnf5::cli::output::ProvidesMatchedBy> P
             std::string sbin_spec = "/sbin/" + spec;
             std::string usr_bin_spec = "/usr/bin/" + spec;
             std::string usr_sbin_spec = "/usr/sbin/" + spec;
+            auto binary_query = full_package_query;
             binary_query.filter_file(
                 std::vector<std::string>({bin_spec, sbin_spec, usr_bin_spec, usr_sbin_spec}),
                 libdnf5::sack::QueryCmp::GLOB);
@@ -98,6 +96,7 @@ std::pair<libdnf5::rpm::PackageQuery, libdnf5::cli::output::ProvidesMatchedBy> P
     if ((spec.rfind("/bin/", 0) == 0) || (spec.rfind("/sbin/", 0) == 0)) {
         spec.insert(0, "/usr");
     }
+    auto filename_query = full_package_query;
     filename_query.filter_file(std::vector<std::string>({spec}), libdnf5::sack::QueryCmp::GLOB);
     if (!filename_query.empty()) {
         return std::make_pair(filename_query, libdnf5::cli::output::ProvidesMatchedBy::FILENAME);
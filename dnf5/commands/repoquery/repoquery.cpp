@@ -32,6 +32,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <libdnf5/utils/patterns.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace dnf5 {
@@ -339,6 +340,20 @@ void RepoqueryCommand::set_argument_parser() {
     cmd.register_named_arg(query_format);
     formatting_conflicts->push_back(query_format);
 
+    json_option = dynamic_cast<libdnf5::OptionStringList *>(parser.add_init_value(
+        std::make_unique<libdnf5::OptionStringList>(std::vector<std::string>{})));
+    auto json = parser.add_new_named_arg("json");
+    json->set_long_name("json");
+    json->set_description(
+        "Display packages as JSON objects, one per line, with the given comma-separated attributes. "
+        "The attributes are the tags for --queryformat.");
+    json->set_has_value(true);
+    json->set_arg_value_help("ATTRIBUTES");
+    json->link_value(json_option);
+    repoquery_formatting->register_argument(json);
+    cmd.register_named_arg(json);
+    formatting_conflicts->push_back(json);
+
     changelogs = std::make_unique<libdnf5::cli::session::BoolOption>(
         *this, "changelogs", '\0', "Display package changelogs.", false);
     repoquery_formatting->register_argument(changelogs->arg);
@@ -432,8 +447,10 @@ void RepoqueryCommand::configure() {
             libdnf5::Option::Priority::RUNTIME, libdnf5::METADATA_TYPE_OTHER);
     }
 
+    const auto & json_attrs = json_option->get_value();
     if ((pkg_attr_option->get_value() == "files") ||
-        (libdnf5::cli::output::requires_filelists(query_format_option->get_value()))) {
+        (libdnf5::cli::output::requires_filelists(query_format_option->get_value())) ||
+        (std::find(json_attrs.begin(), json_attrs.end(), "files") != json_attrs.end())) {
         context.base.get_config().get_optional_metadata_types_option().add_item(
             libdnf5::Option::Priority::RUNTIME, libdnf5::METADATA_TYPE_FILELISTS);
         return;
@@ -740,6 +757,8 @@ void RepoqueryCommand::run() {
         out.setup_cols();
         out.add_section("", result_query);
         out.print();
+    } else if (!json_option->get_value().empty()) {
+        libdnf5::cli::output::print_pkg_set_as_json(stdout, result_query, json_option->get_value());
     } else if (!pkg_attr_option->get_value().empty()) {
         libdnf5::cli::output::print_pkg_attr_uniq_sorted(stdout, result_query, pkg_attr_option->get_value());
     } else {
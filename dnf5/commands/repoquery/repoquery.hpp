@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <dnf5/context.hpp>
 #include <libdnf5/conf/option_bool.hpp>
+#include <libdnf5/conf/option_string_list.hpp>
 
 #include <memory>
 #include <vector>
@@ -78,6 +79,7 @@ private:
 
     libdnf5::OptionBool * querytags_option{nullptr};
     libdnf5::OptionString * query_format_option{nullptr};
+    libdnf5::OptionStringList * json_option{nullptr};
     libdnf5::OptionEnum<std::string> * pkg_attr_option{nullptr};
     std::unique_ptr<libdnf5::cli::session::BoolOption> changelogs{nullptr};
 
@@ -124,7 +124,7 @@ libdnf5::rpm::PackageSet SearchProcessor::get_url_matches(const std::string & pa
 
 void SearchProcessor::update_priorities(const libdnf5::rpm::PackageSet & packages, int priority) {
     for (auto const & package : packages) {
-        packages_priorities[package.get_full_nevra()] |= priority;
+        packages_priorities[package.get_id().id] |= priority;
     }
 }
 
@@ -149,6 +149,12 @@ SearchResults SearchProcessor::get_results() {
         } else {
             all_matches.intersection(std::move(pattern_matches));
         }
+
+        // Without the "--all" option only the packages matching all the patterns are in the result,
+        // so the remaining patterns need to be matched only against the packages matched so far.
+        if (!search_all) {
+            full_package_query.intersection(all_matches);
+        }
     }
 
     // Aggregate packages into the groups based on their priorities.
@@ -156,7 +162,7 @@ SearchResults SearchProcessor::get_results() {
     // Results are sorted with the highest priorities first.
     std::map<int, SearchPackages, std::greater<int>> priority_matches;
     for (auto const & package : all_matches) {
-        auto priority = packages_priorities[package.get_full_nevra()];
+        auto priority = packages_priorities[package.get_id().id];
         priority_matches[priority].packages.insert(std::move(package));
     }
 
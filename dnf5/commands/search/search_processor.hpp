@@ -100,8 +100,10 @@ private:
     libdnf5::Base & base;
     std::vector<std::string> patterns;
     bool search_all;
+    /// Packages to be searched. Narrowed to the matches of the previous patterns if all patterns have to match.
     libdnf5::rpm::PackageQuery full_package_query;
-    std::unordered_map<std::string, int> packages_priorities;
+    /// Accumulated priorities of the matched packages by their ids.
+    std::unordered_map<int, int> packages_priorities;
     bool showdupes;
 };
 
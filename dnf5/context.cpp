@@ -420,7 +420,7 @@ void Context::download_and_run(libdnf5::base::Transaction & transaction) {
     // Total number of actions = number of packages in the transaction +
     //                           action of verifying package files if new package files are present in the transaction +
     //                           action of preparing transaction
-    const auto & trans_packages = transaction.get_transaction_packages();
+    const auto & trans_packages = transaction.get_transaction_packages_ref();
     auto num_of_actions = trans_packages.size() + 1;
     for (auto & trans_pkg : trans_packages) {
         if (libdnf5::transaction::transaction_item_action_is_inbound(trans_pkg.get_action())) {
@@ -565,6 +565,9 @@ std::vector<std::string> match_specs(
         }
     }
 
+    // Names of available packages read from the package names indexes in the repository caches.
+    std::vector<std::string> cached_available_names;
+
     if (available) {
         try {
             // create rpm repositories according configuration files
@@ -577,18 +580,33 @@ std::vector<std::string> match_specs(
             libdnf5::repo::RepoQuery enabled_repos(base);
             enabled_repos.filter_enabled(true);
             enabled_repos.filter_type(libdnf5::repo::Repo::Type::AVAILABLE);
+
+            // optimization - if all enabled repositories have the package names index in their cache,
+            // complete the names of available packages from it instead of loading the repositories
+            bool all_names_cached = !nevra_for_same_name;
             for (auto & repo : enabled_repos.get_data()) {
-                repo->set_sync_strategy(libdnf5::repo::Repo::SyncStrategy::ONLY_CACHE);
-                repo->get_config().get_skip_if_unavailable_option().set(libdnf5::Option::Priority::RUNTIME, true);
+                if (!all_names_cached || !repo->read_cached_package_names(pattern, cached_available_names)) {
+                    all_names_cached = false;
+                    break;
+                }
             }
 
-            ctx.load_repos(false);
+            if (!all_names_cached) {
+                cached_available_names.clear();
+                for (auto & repo : enabled_repos.get_data()) {
+                    repo->set_sync_strategy(libdnf5::repo::Repo::SyncStrategy::ONLY_CACHE);
+                    repo->get_config().get_skip_if_unavailable_option().set(
+                        libdnf5::Option::Priority::RUNTIME, true);
+                }
+
+                ctx.load_repos(false);
+            }
         } catch (...) {
             // Ignores errors when completing available packages, other completions may still work.
         }
     }
 
-    std::set<std::string> result_set;
+    std::set<std::string> result_set(cached_available_names.begin(), cached_available_names.end());
     {
         libdnf5::rpm::PackageQuery matched_pkgs_query(base);
         matched_pkgs_query.resolve_pkg_spec(
@@ -47,6 +47,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "dnf5/context.hpp"
 #include "download_callbacks.hpp"
 #include "plugins.hpp"
+#include "startup_profiler.hpp"
 
 #include <fcntl.h>
 #include <fmt/format.h>
@@ -529,6 +530,13 @@ void RootCommand::set_argument_parser() {
         global_options_group->register_argument(debug_solver);
     }
 
+    {
+        auto debug_memory = parser.add_new_named_arg("debug-memory");
+        debug_memory->set_long_name("debug-memory");
+        debug_memory->set_description("Print a summary of the memory used by libdnf5 to stderr");
+        global_options_group->register_argument(debug_memory);
+    }
+
     {
         auto dump_config = parser.add_new_named_arg("dump-main-config");
         dump_config->set_long_name("dump-main-config");
@@ -760,7 +768,7 @@ static void print_transaction_size_stats(Context & context) {
     int64_t install_size{0};
     int64_t remove_size{0};
 
-    for (const auto & trans_pkg : context.get_transaction()->get_transaction_packages()) {
+    for (const auto & trans_pkg : context.get_transaction()->get_transaction_packages_ref()) {
         const auto pkg = trans_pkg.get_package();
         if (transaction_item_action_is_inbound(trans_pkg.get_action())) {
             const auto pkg_size = pkg.get_download_size();
@@ -882,6 +890,16 @@ static void dump_variables(Context & context) {
     }
 }
 
+static void print_memory_usage(Context & context) {
+    std::size_t total{0};
+    std::cerr << _("======== Memory usage: ========") << std::endl;
+    for (const auto & [name, size] : context.base.get_memory_usage()) {
+        std::cerr << fmt::format("{:<40} {:>10} KiB", name, size / 1024) << std::endl;
+        total += size;
+    }
+    std::cerr << fmt::format("{:<40} {:>10} KiB", _("Total"), total / 1024) << std::endl;
+}
+
 static void print_new_leaves(Context & context) {
     libdnf5::rpm::PackageQuery pkg_query(context.base);
     pkg_query.filter_installed();
@@ -890,7 +908,7 @@ static void print_new_leaves(Context & context) {
 
     // Calculate the new system state (list of installed packages) after a successful transaction.
     // Current state plus inbound minus outbound packages.
-    for (const auto & trans_pkg : context.get_transaction()->get_transaction_packages()) {
+    for (const auto & trans_pkg : context.get_transaction()->get_transaction_packages_ref()) {
         if (libdnf5::transaction::transaction_item_action_is_inbound(trans_pkg.get_action())) {
             pkg_query.add(trans_pkg.get_package());
         } else if (libdnf5::transaction::transaction_item_action_is_outbound(trans_pkg.get_action())) {
@@ -927,6 +945,9 @@ static void print_new_leaves(Context & context) {
 
 
 int main(int argc, char * argv[]) try {
+    // Enabled by the DNF5_PROFILE_STARTUP environment variable
+    dnf5::StartupProfiler profiler;
+
     // Creates a vector of loggers with one circular memory buffer logger
     std::vector<std::unique_ptr<libdnf5::Logger>> loggers;
     const std::size_t max_log_items_to_keep = 10000;
@@ -949,9 +970,18 @@ int main(int argc, char * argv[]) try {
 
         context.set_prg_arguments(static_cast<size_t>(argc), argv);
 
-        dnf5::add_commands(context);
-        dnf5::load_plugins(context);
-        dnf5::load_cmdline_aliases(context);
+        {
+            auto scope = profiler.scope("add_commands");
+            dnf5::add_commands(context);
+        }
+        {
+            auto scope = profiler.scope("load_plugins");
+            dnf5::load_plugins(context);
+        }
+        {
+            auto scope = profiler.scope("load_cmdline_aliases");
+            dnf5::load_cmdline_aliases(context);
+        }
 
         // Argument completion handler
         // If the argument at position 1 is "--complete=<index>", this is a request to complete the argument
@@ -972,6 +1002,7 @@ int main(int argc, char * argv[]) try {
 
         // Parse command line arguments
         {
+            auto scope = profiler.scope("parse_arguments");
             auto & arg_parser = context.get_argument_parser();
             try {
                 arg_parser.parse(argc, argv);
@@ -1029,10 +1060,16 @@ int main(int argc, char * argv[]) try {
         bool any_repos_from_system_configuration = false;
 
         try {
-            command->pre_configure();
+            {
+                auto scope = profiler.scope("pre_configure");
+                command->pre_configure();
+            }
 
             // Load main configuration
-            base.load_config();
+            {
+                auto scope = profiler.scope("load_config");
+                base.load_config();
+            }
 
             // Try to open the current directory to see if we have
             // read and execute access. If not, chdir to /
@@ -1044,7 +1081,10 @@ int main(int argc, char * argv[]) try {
                 close(fd);
             }
 
-            base.setup();
+            {
+                auto scope = profiler.scope("base_setup");
+                base.setup();
+            }
 
             auto destination_logger = libdnf5::create_rotating_file_logger(base, DNF5_LOGGER_FILENAME);
             // Swap to destination logger
@@ -1057,7 +1097,10 @@ int main(int argc, char * argv[]) try {
             }
 
             auto repo_sack = base.get_repo_sack();
-            repo_sack->create_repos_from_system_configuration();
+            {
+                auto scope = profiler.scope("create_repos_from_system_configuration");
+                repo_sack->create_repos_from_system_configuration();
+            }
             any_repos_from_system_configuration = repo_sack->size() > 0;
 
             repo_sack->create_repos_from_paths(context.repos_from_path, libdnf5::Option::Priority::COMMANDLINE);
@@ -1068,7 +1111,10 @@ int main(int argc, char * argv[]) try {
             context.apply_repository_setopts();
 
             // Run selected command
-            command->configure();
+            {
+                auto scope = profiler.scope("configure");
+                command->configure();
+            }
 
             if (context.get_dump_main_config()) {
                 dump_main_configuration(context);
@@ -1079,6 +1125,7 @@ int main(int argc, char * argv[]) try {
             }
 
             {
+                auto scope = profiler.scope("load_repos");
                 if (context.get_load_available_repos() != dnf5::Context::LoadAvailableRepos::NONE) {
                     context.load_repos(context.get_load_system_repo());
                 } else if (context.get_load_system_repo()) {
@@ -1088,14 +1135,26 @@ int main(int argc, char * argv[]) try {
                 }
             }
 
-            command->load_additional_packages();
+            {
+                auto scope = profiler.scope("load_additional_packages");
+                command->load_additional_packages();
+            }
 
-            command->run();
+            {
+                auto scope = profiler.scope("run");
+                command->run();
+            }
+            const bool debug_memory =
+                context.get_argument_parser().get_named_arg("debug-memory", false).get_parse_count() > 0;
             if (auto goal = context.get_goal(false)) {
                 context.set_transaction(goal->resolve());
 
                 command->goal_resolved();
 
+                if (debug_memory) {
+                    dnf5::print_memory_usage(context);
+                }
+
                 download_callbacks->reset_progress_bar();
                 download_callbacks->set_number_widget_visible(true);
                 download_callbacks->set_show_total_bar_limit(0);
@@ -1129,6 +1188,8 @@ int main(int argc, char * argv[]) try {
                 }
 
                 context.download_and_run(*context.get_transaction());
+            } else if (debug_memory) {
+                dnf5::print_memory_usage(context);
             }
         } catch (libdnf5::cli::GoalResolveError & ex) {
             if (!any_repos_from_system_configuration && base.get_config().get_installroot_option().get_value() != "/" &&
@@ -0,0 +1,90 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "startup_profiler.hpp"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+
+
+namespace dnf5 {
+
+StartupProfiler::Scope::Scope(StartupProfiler * profiler, const char * name)
+    : profiler(profiler),
+      name(name),
+      begin(profiler ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {}
+
+
+StartupProfiler::Scope::~Scope() {
+    if (profiler) {
+        profiler->add_event(name, begin);
+    }
+}
+
+
+StartupProfiler::StartupProfiler() {
+    const char * path = std::getenv("DNF5_PROFILE_STARTUP");
+    if (path && *path) {
+        enabled = true;
+        output_path = path;
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+
+StartupProfiler::~StartupProfiler() {
+    if (!enabled) {
+        return;
+    }
+    add_event("dnf5", start);
+
+    auto to_us = [this](std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - start).count();
+    };
+
+    // Errors are ignored, the profiling must not change the result of dnf5.
+    std::ofstream out(output_path);
+    const auto pid = getpid();
+    out << "{\"traceEvents\":[";
+    for (std::size_t idx = 0; idx < events.size(); ++idx) {
+        const auto & event = events[idx];
+        out << fmt::format(
+            "{}\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":{},\"tid\":{}}}",
+            idx == 0 ? "" : ",",
+            event.name,
+            to_us(event.begin),
+            to_us(event.end) - to_us(event.begin),
+            pid,
+            event.tid);
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+
+void StartupProfiler::add_event(const char * name, std::chrono::steady_clock::time_point begin) {
+    auto end = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> guard(events_mutex);
+    events.push_back({name, begin, end, gettid()});
+}
+
+}  // namespace dnf5
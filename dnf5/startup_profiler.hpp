@@ -0,0 +1,86 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DNF5_STARTUP_PROFILER_HPP
+#define DNF5_STARTUP_PROFILER_HPP
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace dnf5 {
+
+/// Measures durations of the dnf5 phases.
+/// The profiler is enabled by setting the "DNF5_PROFILE_STARTUP" environment variable to the path
+/// of an output file. On destruction, the recorded events are written to that file in the Chrome trace
+/// event format, which can be loaded e.g. into chrome://tracing or https://ui.perfetto.dev.
+/// When disabled, the scopes do nothing.
+class StartupProfiler {
+public:
+    /// Records the duration of a phase from its construction to its destruction.
+    class Scope {
+    public:
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+        ~Scope();
+
+    private:
+        friend StartupProfiler;
+        Scope(StartupProfiler * profiler, const char * name);
+
+        StartupProfiler * profiler;
+        const char * name;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    StartupProfiler();
+    ~StartupProfiler();
+
+    StartupProfiler(const StartupProfiler &) = delete;
+    StartupProfiler & operator=(const StartupProfiler &) = delete;
+
+    /// Starts measuring a phase named `name`. The returned scope ends it.
+    /// @param name Name of the phase, it must be a string literal without characters requiring JSON escaping.
+    Scope scope(const char * name) { return Scope(enabled ? this : nullptr, name); }
+
+private:
+    struct Event {
+        const char * name;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+        pid_t tid;
+    };
+
+    void add_event(const char * name, std::chrono::steady_clock::time_point begin);
+
+    bool enabled{false};
+    std::string output_path;
+    std::chrono::steady_clock::time_point start;
+    std::mutex events_mutex;
+    std::vector<Event> events;
+};
+
+}  // namespace dnf5
+
+#endif
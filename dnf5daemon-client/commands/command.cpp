@@ -50,7 +50,7 @@ void TransactionCommand::run_transaction() {
         .withArguments(options)
         .storeResultsTo(transaction, result_int);
     dnfdaemon::ResolveResult result = static_cast<dnfdaemon::ResolveResult>(result_int);
-    DbusGoalWrapper dbus_goal_wrapper(transaction);
+    DbusGoalWrapper dbus_goal_wrapper(std::move(transaction));
 
     if (result != dnfdaemon::ResolveResult::NO_PROBLEM) {
         // retrieve and print resolving error messages
@@ -30,12 +30,21 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_set.hpp>
 
+#include <cstdint>
 #include <iostream>
+#include <utility>
 
 namespace dnfdaemon::client {
 
 using namespace libdnf5::cli;
 
+namespace {
+
+// Number of packages requested from the server in one next_list_page() call
+constexpr uint32_t LIST_PAGE_SIZE = 1000;
+
+}  // namespace
+
 void RepoqueryCommand::set_parent_command() {
     auto * arg_parser_parent_cmd = get_session().get_argument_parser().get_root_command();
     auto * arg_parser_this_cmd = get_argument_parser_command();
@@ -135,29 +144,58 @@ void RepoqueryCommand::run() {
         options.insert(std::pair<std::string, std::vector<std::string>>("package_attrs", {"full_nevra"}));
     }
 
-    dnfdaemon::KeyValueMapList packages;
-    ctx.session_proxy->callMethod("list")
+    // Read the packages page by page and print them as they arrive, so that the memory
+    // stays flat and the output starts quickly even for listings of the whole pool.
+    uint64_t cursor_id;
+    ctx.session_proxy->callMethod("open_list")
         .onInterface(dnfdaemon::INTERFACE_RPM)
         .withTimeout(static_cast<uint64_t>(-1))
         .withArguments(options)
-        .storeResultsTo(packages);
-
-    auto num_packages = packages.size();
-    for (auto & raw_package : packages) {
-        --num_packages;
-        DbusPackageWrapper package(raw_package);
-        if (info_option->get_value()) {
-            auto out = libdnf5::cli::output::PackageInfoSections();
-            out.setup_cols();
-            out.add_package(package);
-            out.print();
-            if (num_packages) {
-                std::cout << std::endl;
+        .storeResultsTo(cursor_id);
+
+    auto close_list = [&ctx, cursor_id]() {
+        ctx.session_proxy->callMethod("close_list")
+            .onInterface(dnfdaemon::INTERFACE_RPM)
+            .withTimeout(static_cast<uint64_t>(-1))
+            .withArguments(cursor_id);
+    };
+
+    try {
+        bool first_package = true;
+        dnfdaemon::KeyValueMapList packages;
+        while (true) {
+            packages.clear();
+            ctx.session_proxy->callMethod("next_list_page")
+                .onInterface(dnfdaemon::INTERFACE_RPM)
+                .withTimeout(static_cast<uint64_t>(-1))
+                .withArguments(cursor_id, LIST_PAGE_SIZE)
+                .storeResultsTo(packages);
+            if (packages.empty()) {
+                break;
+            }
+
+            for (auto & raw_package : packages) {
+                DbusPackageWrapper package(std::move(raw_package));
+                if (info_option->get_value()) {
+                    if (!first_package) {
+                        std::cout << std::endl;
+                    }
+                    auto out = libdnf5::cli::output::PackageInfoSections();
+                    out.setup_cols();
+                    out.add_package(package);
+                    out.print();
+                } else {
+                    std::cout << package.get_full_nevra() << '\n';
+                }
+                first_package = false;
             }
-        } else {
-            std::cout << package.get_full_nevra() << std::endl;
+            std::cout.flush();
         }
+    } catch (...) {
+        close_list();
+        throw;
     }
+    close_list();
 }
 
 }  // namespace dnfdaemon::client
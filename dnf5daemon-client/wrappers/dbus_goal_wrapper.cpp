@@ -30,10 +30,12 @@ DbusGoalWrapper::DbusGoalWrapper(std::vector<dnfdaemon::DbusTransactionItem> tra
     // used to resolve replaces from id to DbusPackageWrapper instance
     std::map<int, size_t> transaction_packages_by_id;
 
-    for (const auto & ti : transaction) {
+    // the reply is not needed afterwards, package attributes are moved into the wrappers
+    transaction_packages.reserve(transaction.size());
+    for (auto & ti : transaction) {
         auto object_type = libdnf5::transaction::transaction_item_type_from_string(std::get<0>(ti));
         if (object_type == libdnf5::transaction::TransactionItemType::PACKAGE) {
-            transaction_packages.push_back(DbusTransactionPackageWrapper(ti));
+            transaction_packages.emplace_back(std::move(ti));
             transaction_packages_by_id.emplace(
                 transaction_packages.back().get_package().get_id(), transaction_packages.size() - 1);
         } else if (object_type == libdnf5::transaction::TransactionItemType::GROUP) {
@@ -48,7 +50,7 @@ DbusGoalWrapper::DbusGoalWrapper(std::vector<dnfdaemon::DbusTransactionItem> tra
     // id of replaced packages we must convert them to packages using transaction_packages_by_id map
     for (auto & tpkg : transaction_packages) {
         // ids of replaced packages are stored in "replaces" transaction item attribute
-        auto ti_attrs = tpkg.get_transaction_item_attrs();
+        auto & ti_attrs = tpkg.get_transaction_item_attrs();
         auto ti_replaces = ti_attrs.find("replaces");
         if (ti_replaces != ti_attrs.end()) {
             std::vector<DbusPackageWrapper> replaces;
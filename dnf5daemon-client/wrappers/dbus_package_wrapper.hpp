@@ -23,6 +23,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <dnf5daemon-server/dbus.hpp>
 #include <libdnf5/transaction/transaction_item_reason.hpp>
 
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 
@@ -31,19 +35,24 @@ namespace dnfdaemon::client {
 class DbusPackageWrapper {
 public:
     explicit DbusPackageWrapper(const dnfdaemon::KeyValueMap & rawdata) : rawdata(rawdata){};
+    explicit DbusPackageWrapper(dnfdaemon::KeyValueMap && rawdata) : rawdata(std::move(rawdata)){};
 
     int get_id() { return rawdata.at("id"); }
     std::string get_name() const { return rawdata.at("name"); }
+    /// The views of name, arch and evr point to values cached in the wrapper, they are valid while it exists.
+    std::string_view get_name_view() const { return get_cached(name, "name"); }
     std::string get_na() const { return get_name() + "." + get_arch(); }
     std::string get_epoch() const { return rawdata.at("epoch"); }
     std::string get_version() const { return rawdata.at("version"); }
     std::string get_release() const { return rawdata.at("release"); }
     std::string get_arch() const { return rawdata.at("arch"); }
+    std::string_view get_arch_view() const { return get_cached(arch, "arch"); }
     std::string get_repo_id() const { return rawdata.at("repo_id"); }
     std::string get_from_repo_id() const { return rawdata.at("from_repo_id"); }
     std::string get_nevra() const { return rawdata.at("nevra"); }
     std::string get_full_nevra() const { return rawdata.at("full_nevra"); }
     std::string get_evr() const { return rawdata.at("evr"); }
+    std::string_view get_evr_view() const { return get_cached(evr, "evr"); }
     bool is_installed() const { return rawdata.at("is_installed"); }
     uint64_t get_install_size() const { return rawdata.at("install_size"); }
     uint64_t get_download_size() const { return rawdata.at("download_size"); }
@@ -58,7 +67,18 @@ public:
     std::string get_vendor() const { return rawdata.at("vendor"); }
 
 private:
+    const std::string & get_cached(std::optional<std::string> & cache, const std::string & key) const {
+        if (!cache) {
+            std::string value = rawdata.at(key);
+            cache = std::move(value);
+        }
+        return *cache;
+    }
+
     dnfdaemon::KeyValueMap rawdata;
+    mutable std::optional<std::string> name;
+    mutable std::optional<std::string> arch;
+    mutable std::optional<std::string> evr;
 };
 
 }  // namespace dnfdaemon::client
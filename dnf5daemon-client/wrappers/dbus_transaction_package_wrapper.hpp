@@ -26,6 +26,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/transaction/transaction_item_action.hpp>
 #include <libdnf5/transaction/transaction_item_reason.hpp>
 
+#include <utility>
 #include <vector>
 
 
@@ -38,6 +39,11 @@ public:
           reason(libdnf5::transaction::transaction_item_reason_from_string(std::get<2>(dti))),
           transaction_item_attrs(std::get<3>(dti)),
           package(std::get<4>(dti)) {}
+    explicit DbusTransactionPackageWrapper(dnfdaemon::DbusTransactionItem && dti)
+        : action(libdnf5::transaction::transaction_item_action_from_string(std::get<1>(dti))),
+          reason(libdnf5::transaction::transaction_item_reason_from_string(std::get<2>(dti))),
+          transaction_item_attrs(std::move(std::get<3>(dti))),
+          package(std::move(std::get<4>(dti))) {}
 
     DbusPackageWrapper & get_package() noexcept { return package; }
     libdnf5::transaction::TransactionItemAction get_action() const noexcept { return action; }
@@ -46,7 +52,7 @@ public:
     // TODO(jmracek) get_replaces() is only a dummy method. In future it requires a private setter and a way how to get
     // data from dnf-deamon server
     const std::vector<DbusPackageWrapper> & get_replaces() const noexcept { return replaces; }
-    void set_replaces(std::vector<DbusPackageWrapper> && replaces) { this->replaces = replaces; }
+    void set_replaces(std::vector<DbusPackageWrapper> && replaces) { this->replaces = std::move(replaces); }
 
 private:
     libdnf5::transaction::TransactionItemAction action;
@@ -31,7 +31,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 namespace dnf5daemon {
 
 
-DbusCallback::DbusCallback(Session & session) : session(session) {
+DbusCallback::DbusCallback(Session & session)
+    : session(session),
+      progress_interval(session.session_configuration_value<uint32_t>("progress_interval", 400)),
+      prev_print_time(std::chrono::steady_clock::now()) {
     dbus_object = session.get_dbus_object();
 }
 
@@ -42,8 +45,6 @@ sdbus::Signal DbusCallback::create_signal(std::string interface, std::string sig
     return signal;
 }
 
-std::chrono::time_point<std::chrono::steady_clock> DbusCallback::prev_print_time = std::chrono::steady_clock::now();
-
 
 sdbus::Signal DownloadCB::create_signal_download(const std::string & signal_name, void * user_data) {
     auto signal = create_signal(dnfdaemon::INTERFACE_BASE, signal_name);
@@ -67,11 +68,16 @@ void * DownloadCB::add_new_download(void * user_data, const char * description,
 
 int DownloadCB::progress(void * user_cb_data, double total_to_download, double downloaded) {
     try {
+        pending_progress[user_cb_data] = {total_to_download, downloaded};
+        downloaded_sizes[user_cb_data] = downloaded;
         if (is_time_to_print()) {
-            auto signal = create_signal_download(dnfdaemon::SIGNAL_DOWNLOAD_PROGRESS, user_cb_data);
-            signal << static_cast<int64_t>(total_to_download);
-            signal << static_cast<int64_t>(downloaded);
-            dbus_object->emitSignal(signal);
+            for (const auto & [user_data, download_progress] : pending_progress) {
+                auto signal = create_signal_download(dnfdaemon::SIGNAL_DOWNLOAD_PROGRESS, user_data);
+                signal << static_cast<int64_t>(download_progress.total_to_download);
+                signal << static_cast<int64_t>(download_progress.downloaded);
+                dbus_object->emitSignal(signal);
+            }
+            pending_progress.clear();
         }
     } catch (...) {
     }
@@ -80,6 +86,13 @@ int DownloadCB::progress(void * user_cb_data, double total_to_download, double d
 
 int DownloadCB::end(void * user_cb_data, TransferStatus status, const char * msg) {
     try {
+        // the end signal is always sent immediately, the pending progress of the download is superseded by it
+        pending_progress.erase(user_cb_data);
+        auto downloaded_size = downloaded_sizes.find(user_cb_data);
+        if (downloaded_size != downloaded_sizes.end()) {
+            session.get_metrics().add_downloaded_bytes(static_cast<uint64_t>(downloaded_size->second));
+            downloaded_sizes.erase(downloaded_size);
+        }
         auto signal = create_signal_download(dnfdaemon::SIGNAL_DOWNLOAD_END, user_cb_data);
         signal << static_cast<int>(status);
         signal << msg;
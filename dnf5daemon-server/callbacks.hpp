@@ -28,6 +28,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <sdbus-c++/sdbus-c++.h>
 
 #include <chrono>
+#include <map>
 #include <string>
 
 class Session;
@@ -45,21 +46,25 @@ public:
     virtual ~DbusCallback() = default;
 
 protected:
-    static std::chrono::time_point<std::chrono::steady_clock> prev_print_time;
     Session & session;
     sdbus::IObject * dbus_object;
 
     virtual sdbus::Signal create_signal(std::string interface, std::string signal_name);
-    static bool is_time_to_print() {
+
+    // Progress signals are throttled for each callbacks object (i.e. per session), one session's signals
+    // must not delay other sessions. The interval is set by the "progress_interval" session option.
+    bool is_time_to_print() {
         auto now = std::chrono::steady_clock::now();
-        auto delta = now - prev_print_time;
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(delta).count();
-        if (ms > 400) {
+        if (now - prev_print_time > progress_interval) {
             prev_print_time = now;
             return true;
         }
         return false;
     }
+
+private:
+    std::chrono::milliseconds progress_interval;
+    std::chrono::time_point<std::chrono::steady_clock> prev_print_time;
 };
 
 
@@ -76,7 +81,19 @@ public:
     int mirror_failure(void * user_cb_data, const char * msg, const char * url, const char * metadata) override;
 
 private:
+    struct DownloadProgress {
+        double total_to_download;
+        double downloaded;
+    };
+
     sdbus::Signal create_signal_download(const std::string & signal_name, void * user_data);
+
+    // The latest not yet emitted progress of the running downloads. Once the progress interval elapses,
+    // progress signals for all of them are emitted at once.
+    std::map<void *, DownloadProgress> pending_progress;
+
+    // The latest downloaded size of the running downloads, added to the daemon metrics when they finish.
+    std::map<void *, double> downloaded_sizes;
 };
 
 
@@ -0,0 +1,92 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <vector>
+
+void Metrics::record_method_call(
+    const std::string & method, std::chrono::steady_clock::duration duration, bool success) {
+    auto seconds = std::chrono::duration<double>(duration).count();
+    auto bucket = static_cast<std::size_t>(
+        std::lower_bound(LATENCY_BUCKETS.begin(), LATENCY_BUCKETS.end(), seconds) - LATENCY_BUCKETS.begin());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto & stats = methods[method];
+    ++stats.calls;
+    if (!success) {
+        ++stats.errors;
+    }
+    stats.seconds_total += seconds;
+    stats.seconds_max = std::max(stats.seconds_max, seconds);
+    ++stats.latency_histogram[bucket];
+}
+
+void Metrics::record_span(const std::string & name, std::chrono::steady_clock::duration duration) {
+    auto seconds = std::chrono::duration<double>(duration).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto & stats = spans[name];
+    ++stats.count;
+    stats.seconds_total += seconds;
+    stats.seconds_max = std::max(stats.seconds_max, seconds);
+}
+
+dnfdaemon::KeyValueMap Metrics::get_key_value_map() {
+    dnfdaemon::KeyValueMap result;
+    result.emplace("downloaded_bytes", static_cast<uint64_t>(downloaded_bytes));
+    result.emplace("latency_buckets", std::vector<double>(LATENCY_BUCKETS.begin(), LATENCY_BUCKETS.end()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    dnfdaemon::KeyValueMap methods_map;
+    for (const auto & [method, stats] : methods) {
+        dnfdaemon::KeyValueMap method_map;
+        method_map.emplace("calls", stats.calls);
+        method_map.emplace("errors", stats.errors);
+        method_map.emplace("seconds_total", stats.seconds_total);
+        method_map.emplace("seconds_max", stats.seconds_max);
+        method_map.emplace(
+            "latency_histogram",
+            std::vector<uint64_t>(stats.latency_histogram.begin(), stats.latency_histogram.end()));
+        methods_map.emplace(method, method_map);
+    }
+    result.emplace("methods", methods_map);
+
+    dnfdaemon::KeyValueMap spans_map;
+    for (const auto & [name, stats] : spans) {
+        dnfdaemon::KeyValueMap span_map;
+        span_map.emplace("count", stats.count);
+        span_map.emplace("seconds_total", stats.seconds_total);
+        span_map.emplace("seconds_max", stats.seconds_max);
+        spans_map.emplace(name, span_map);
+    }
+    result.emplace("spans", spans_map);
+
+    return result;
+}
+
+void MetricsTraceExporter::export_span(
+    const char * name,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end,
+    [[maybe_unused]] const Attributes & attributes) {
+    metrics.record_span(name, end - start);
+}
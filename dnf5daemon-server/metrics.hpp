@@ -0,0 +1,94 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DNF5DAEMON_SERVER_METRICS_HPP
+#define DNF5DAEMON_SERVER_METRICS_HPP
+
+#include "dbus.hpp"
+
+#include <libdnf5/base/trace.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/// Counters and timings of the work of the daemon aggregated over all sessions, reported by the
+/// `get_metrics` method of the SessionManager interface. All methods are thread-safe.
+class Metrics {
+public:
+    /// Upper bounds (in seconds) of the buckets of the method call latency histogram.
+    /// The last bucket of the histogram has no upper bound.
+    static constexpr std::array<double, 9> LATENCY_BUCKETS{0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 60};
+
+    /// Records a finished D-Bus method call. The `method` is "<interface>.<member>".
+    void record_method_call(const std::string & method, std::chrono::steady_clock::duration duration, bool success);
+
+    /// Records a finished trace span of a session Base (repository loading, goal resolving, ...).
+    void record_span(const std::string & name, std::chrono::steady_clock::duration duration);
+
+    /// Adds the size of a finished download.
+    void add_downloaded_bytes(std::uint64_t bytes) { downloaded_bytes += bytes; }
+
+    /// @return The metrics as a key/value map: "downloaded_bytes", "latency_buckets", "methods" (map
+    ///         {method: {calls, errors, seconds_total, seconds_max, latency_histogram}}) and "spans"
+    ///         (map {span name: {count, seconds_total, seconds_max}}).
+    dnfdaemon::KeyValueMap get_key_value_map();
+
+private:
+    struct MethodStats {
+        std::uint64_t calls{0};
+        std::uint64_t errors{0};
+        double seconds_total{0};
+        double seconds_max{0};
+        std::array<std::uint64_t, LATENCY_BUCKETS.size() + 1> latency_histogram{};
+    };
+
+    struct SpanStats {
+        std::uint64_t count{0};
+        double seconds_total{0};
+        double seconds_max{0};
+    };
+
+    std::mutex mutex;
+    std::map<std::string, MethodStats> methods;
+    std::map<std::string, SpanStats> spans;
+    std::atomic<std::uint64_t> downloaded_bytes{0};
+};
+
+/// Records the trace spans of a session Base to the Metrics.
+class MetricsTraceExporter : public libdnf5::TraceExporter {
+public:
+    explicit MetricsTraceExporter(Metrics & metrics) : metrics(metrics) {}
+
+    void export_span(
+        const char * name,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end,
+        const Attributes & attributes) override;
+
+private:
+    Metrics & metrics;
+};
+
+#endif
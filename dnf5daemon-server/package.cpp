@@ -76,18 +76,32 @@ std::vector<dnfdaemon::Changelog> changelogs_to_list(const libdnf5::rpm::Package
     return changelogs;
 }
 
+PackageAttributes resolve_package_attributes(const std::vector<std::string> & attributes) {
+    PackageAttributes resolved;
+    resolved.reserve(attributes.size());
+    for (auto & attr : attributes) {
+        auto it = package_attributes.find(attr);
+        if (it == package_attributes.end()) {
+            throw std::runtime_error(fmt::format("Package attribute '{}' not supported", attr));
+        }
+        resolved.emplace_back(attr, it->second);
+    }
+    return resolved;
+}
+
 dnfdaemon::KeyValueMap package_to_map(
     const libdnf5::rpm::Package & libdnf_package, const std::vector<std::string> & attributes) {
+    return package_to_map(libdnf_package, resolve_package_attributes(attributes));
+}
+
+dnfdaemon::KeyValueMap package_to_map(
+    const libdnf5::rpm::Package & libdnf_package, const PackageAttributes & attributes) {
     dnfdaemon::KeyValueMap dbus_package;
     // add package id by default
     dbus_package.emplace(std::make_pair("id", libdnf_package.get_id().id));
     // attributes required by client
-    for (auto & attr : attributes) {
-        auto it = package_attributes.find(attr);
-        if (it == package_attributes.end()) {
-            throw std::runtime_error(fmt::format("Package attribute '{}' not supported", attr));
-        }
-        switch (it->second) {
+    for (auto & [attr, attribute] : attributes) {
+        switch (attribute) {
             case PackageAttribute::name:
                 dbus_package.emplace(attr, libdnf_package.get_name());
                 break;
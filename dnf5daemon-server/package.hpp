@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package.hpp>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 // TODO(mblaha): add all other package attributes
@@ -68,7 +69,17 @@ enum class PackageAttribute {
     vendor
 };
 
+// attribute names requested by a client together with the corresponding attributes
+using PackageAttributes = std::vector<std::pair<std::string, PackageAttribute>>;
+
+// Resolves attribute names requested by a client. Throws std::runtime_error for unsupported attributes.
+PackageAttributes resolve_package_attributes(const std::vector<std::string> & attributes);
+
 dnfdaemon::KeyValueMap package_to_map(
     const libdnf5::rpm::Package & libdnf_package, const std::vector<std::string> & attributes);
 
+// Variant of package_to_map() for serializing many packages, the attributes are resolved only once.
+dnfdaemon::KeyValueMap package_to_map(
+    const libdnf5::rpm::Package & libdnf_package, const PackageAttributes & attributes);
+
 #endif
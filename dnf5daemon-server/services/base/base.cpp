@@ -28,6 +28,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <unistd.h>
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <thread>
 
@@ -37,6 +38,10 @@ void Base::dbus_register() {
         dnfdaemon::INTERFACE_BASE, "read_all_repos", "", "b", [this](sdbus::MethodCall call) -> void {
             session.get_threads_manager().handle_method(*this, &Base::read_all_repos, call, session.session_locale);
         });
+    dbus_object->registerMethod(
+        dnfdaemon::INTERFACE_BASE, "get_memory_usage", "", "a{st}", [this](sdbus::MethodCall call) -> void {
+            session.get_threads_manager().handle_method(*this, &Base::get_memory_usage, call, session.session_locale);
+        });
     dbus_object->registerSignal(dnfdaemon::INTERFACE_REPO, dnfdaemon::SIGNAL_REPO_KEY_IMPORT_REQUEST, "ossssx");
     dbus_object->registerSignal(dnfdaemon::INTERFACE_BASE, dnfdaemon::SIGNAL_DOWNLOAD_ADD_NEW, "os");
     dbus_object->registerSignal(dnfdaemon::INTERFACE_BASE, dnfdaemon::SIGNAL_DOWNLOAD_PROGRESS, "ott");
@@ -50,3 +55,13 @@ sdbus::MethodReply Base::read_all_repos(sdbus::MethodCall & call) {
     reply << retval;
     return reply;
 }
+
+sdbus::MethodReply Base::get_memory_usage(sdbus::MethodCall & call) {
+    std::map<std::string, uint64_t> usage;
+    for (const auto & [name, size] : session.get_base()->get_memory_usage()) {
+        usage.emplace(name, size);
+    }
+    auto reply = call.createReply();
+    reply << usage;
+    return reply;
+}
@@ -36,6 +36,7 @@ public:
 
 private:
     sdbus::MethodReply read_all_repos(sdbus::MethodCall & call);
+    sdbus::MethodReply get_memory_usage(sdbus::MethodCall & call);
 };
 
 #endif
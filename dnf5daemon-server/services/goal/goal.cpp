@@ -84,7 +84,7 @@ sdbus::MethodReply Goal::resolve(sdbus::MethodCall & call) {
     auto overall_result = dnfdaemon::ResolveResult::ERROR;
     if (transaction.get_problems() == libdnf5::GoalProblem::NO_PROBLEM) {
         // return the transaction only if there were no problems
-        std::vector<std::string> pkg_attrs{
+        const auto pkg_attrs = resolve_package_attributes({
             "name",
             "epoch",
             "version",
@@ -95,13 +95,13 @@ sdbus::MethodReply Goal::resolve(sdbus::MethodCall & call) {
             "download_size",
             "install_size",
             "evr",
-            "reason"};
-        for (auto & tspkg : transaction.get_transaction_packages()) {
+            "reason"});
+        for (auto & tspkg : transaction.get_transaction_packages_ref()) {
             dnfdaemon::KeyValueMap trans_item_attrs{};
             if (tspkg.get_reason_change_group_id()) {
                 trans_item_attrs.emplace("reason_change_group_id", *tspkg.get_reason_change_group_id());
             }
-            auto replaces = tspkg.get_replaces();
+            const auto & replaces = tspkg.get_replaces();
             if (replaces.size() > 0) {
                 std::vector<int> replaces_ids{};
                 for (auto & r : replaces) {
@@ -210,7 +210,7 @@ void download_packages(Session & session, libdnf5::base::Transaction & transacti
 
     // container is owner of package callbacks user_data
     std::vector<std::unique_ptr<dnf5daemon::DownloadUserData>> user_data;
-    for (auto & tspkg : transaction.get_transaction_packages()) {
+    for (auto & tspkg : transaction.get_transaction_packages_ref()) {
         if (transaction_item_action_is_inbound(tspkg.get_action()) &&
             tspkg.get_package().get_repo()->get_type() != libdnf5::repo::Repo::Type::COMMANDLINE) {
             auto & data = user_data.emplace_back(std::make_unique<dnf5daemon::DownloadUserData>());
@@ -26,6 +26,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package_set.hpp>
 #include <sdbus-c++/sdbus-c++.h>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -45,6 +47,18 @@ void Rpm::dbus_register() {
         dnfdaemon::INTERFACE_RPM, "list", "a{sv}", "aa{sv}", [this](sdbus::MethodCall call) -> void {
             session.get_threads_manager().handle_method(*this, &Rpm::list, call, session.session_locale);
         });
+    dbus_object->registerMethod(
+        dnfdaemon::INTERFACE_RPM, "open_list", "a{sv}", "t", [this](sdbus::MethodCall call) -> void {
+            session.get_threads_manager().handle_method(*this, &Rpm::open_list, call, session.session_locale);
+        });
+    dbus_object->registerMethod(
+        dnfdaemon::INTERFACE_RPM, "next_list_page", "tu", "aa{sv}", [this](sdbus::MethodCall call) -> void {
+            session.get_threads_manager().handle_method(*this, &Rpm::next_list_page, call, session.session_locale);
+        });
+    dbus_object->registerMethod(
+        dnfdaemon::INTERFACE_RPM, "close_list", "t", "", [this](sdbus::MethodCall call) -> void {
+            session.get_threads_manager().handle_method(*this, &Rpm::close_list, call, session.session_locale);
+        });
     dbus_object->registerMethod(
         dnfdaemon::INTERFACE_RPM, "install", "asa{sv}", "", [this](sdbus::MethodCall call) -> void {
             session.get_threads_manager().handle_method(*this, &Rpm::install, call, session.session_locale);
@@ -82,11 +96,7 @@ libdnf5::rpm::PackageQuery resolve_nevras(libdnf5::rpm::PackageQuery base_query,
     return result;
 }
 
-sdbus::MethodReply Rpm::list(sdbus::MethodCall & call) {
-    // read options from dbus call
-    dnfdaemon::KeyValueMap options;
-    call >> options;
-
+libdnf5::rpm::PackageQuery Rpm::filter_packages(const dnfdaemon::KeyValueMap & options) {
     session.fill_sack();
     auto base = session.get_base();
 
@@ -259,13 +269,98 @@ sdbus::MethodReply Rpm::list(sdbus::MethodCall & call) {
         query.filter_latest_evr(key_value_map_get<int>(options, "latest-limit"));
     }
 
+    return query;
+}
+
+sdbus::MethodReply Rpm::list(sdbus::MethodCall & call) {
+    // read options from dbus call
+    dnfdaemon::KeyValueMap options;
+    call >> options;
+
+    auto query = filter_packages(options);
+
     // create reply from the query
     dnfdaemon::KeyValueMapList out_packages;
     std::vector<std::string> default_attrs{};
     std::vector<std::string> package_attrs =
         key_value_map_get<std::vector<std::string>>(options, "package_attrs", default_attrs);
+    if (!query.empty()) {
+        auto resolved_attrs = resolve_package_attributes(package_attrs);
+        out_packages.reserve(query.size());
+        for (const auto & pkg : query) {
+            out_packages.push_back(package_to_map(pkg, resolved_attrs));
+        }
+    }
+
+    auto reply = call.createReply();
+    reply << out_packages;
+    return reply;
+}
+
+sdbus::MethodReply Rpm::open_list(sdbus::MethodCall & call) {
+    // read options from dbus call
+    dnfdaemon::KeyValueMap options;
+    call >> options;
+
+    auto query = filter_packages(options);
+
+    ListCursor cursor;
+    std::vector<std::string> default_attrs{};
+    cursor.package_attrs = key_value_map_get<std::vector<std::string>>(options, "package_attrs", default_attrs);
+    cursor.packages.reserve(query.size());
     for (const auto & pkg : query) {
-        out_packages.push_back(package_to_map(pkg, package_attrs));
+        cursor.packages.push_back(pkg);
+    }
+
+    uint64_t cursor_id;
+    {
+        std::lock_guard<std::mutex> lock(list_cursors_mutex);
+        cursor.last_used = std::chrono::steady_clock::now();
+        remove_expired_list_cursors(cursor.last_used);
+        if (list_cursors.size() >= MAX_LIST_CURSORS) {
+            list_cursors.erase(std::min_element(
+                list_cursors.begin(), list_cursors.end(), [](const auto & lhs, const auto & rhs) {
+                    return lhs.second.last_used < rhs.second.last_used;
+                }));
+        }
+        cursor_id = ++last_list_cursor_id;
+        list_cursors.emplace(cursor_id, std::move(cursor));
+    }
+
+    auto reply = call.createReply();
+    reply << cursor_id;
+    return reply;
+}
+
+sdbus::MethodReply Rpm::next_list_page(sdbus::MethodCall & call) {
+    uint64_t cursor_id;
+    call >> cursor_id;
+    uint32_t page_size;
+    call >> page_size;
+    if (page_size == 0) {
+        throw sdbus::Error(dnfdaemon::ERROR, "The page size must be greater than zero.");
+    }
+
+    std::lock_guard<std::mutex> lock(list_cursors_mutex);
+    auto now = std::chrono::steady_clock::now();
+    remove_expired_list_cursors(now);
+    auto cursor = list_cursors.find(cursor_id);
+    if (cursor == list_cursors.end()) {
+        throw sdbus::Error(dnfdaemon::ERROR, fmt::format("Unknown package list cursor \"{}\".", cursor_id));
+    }
+    cursor->second.last_used = now;
+
+    // package attributes are serialized only for the returned page
+    auto & packages = cursor->second.packages;
+    auto & position = cursor->second.position;
+    auto page_end = position + std::min<std::size_t>(page_size, packages.size() - position);
+    dnfdaemon::KeyValueMapList out_packages;
+    out_packages.reserve(page_end - position);
+    if (position < page_end) {
+        auto package_attrs = resolve_package_attributes(cursor->second.package_attrs);
+        for (; position < page_end; ++position) {
+            out_packages.push_back(package_to_map(packages[position], package_attrs));
+        }
     }
 
     auto reply = call.createReply();
@@ -273,6 +368,23 @@ sdbus::MethodReply Rpm::list(sdbus::MethodCall & call) {
     return reply;
 }
 
+sdbus::MethodReply Rpm::close_list(sdbus::MethodCall & call) {
+    uint64_t cursor_id;
+    call >> cursor_id;
+
+    {
+        std::lock_guard<std::mutex> lock(list_cursors_mutex);
+        list_cursors.erase(cursor_id);
+    }
+
+    auto reply = call.createReply();
+    return reply;
+}
+
+void Rpm::remove_expired_list_cursors(std::chrono::steady_clock::time_point now) {
+    std::erase_if(list_cursors, [now](const auto & item) { return now - item.second.last_used > LIST_CURSOR_TIMEOUT; });
+}
+
 sdbus::MethodReply Rpm::distro_sync(sdbus::MethodCall & call) {
     std::vector<std::string> specs;
     call >> specs;
@@ -22,8 +22,17 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "session.hpp"
 
+#include <libdnf5/rpm/package.hpp>
+#include <libdnf5/rpm/package_query.hpp>
 #include <sdbus-c++/sdbus-c++.h>
 
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 class Rpm : public IDbusSessionService {
 public:
     using IDbusSessionService::IDbusSessionService;
@@ -32,13 +41,37 @@ public:
     void dbus_deregister();
 
 private:
+    /// State of a package list opened by `open_list` and read page by page by `next_list_page`
+    struct ListCursor {
+        std::vector<libdnf5::rpm::Package> packages;
+        std::vector<std::string> package_attrs;
+        std::size_t position{0};
+        std::chrono::steady_clock::time_point last_used;
+    };
+
+    /// Returns query with packages matching the filters in `options` of `list` and `open_list` methods.
+    libdnf5::rpm::PackageQuery filter_packages(const dnfdaemon::KeyValueMap & options);
+
     sdbus::MethodReply list(sdbus::MethodCall & call);
+    sdbus::MethodReply open_list(sdbus::MethodCall & call);
+    sdbus::MethodReply next_list_page(sdbus::MethodCall & call);
+    sdbus::MethodReply close_list(sdbus::MethodCall & call);
+    /// Removes cursors that were not used for `LIST_CURSOR_TIMEOUT`. Requires `list_cursors_mutex` to be locked.
+    void remove_expired_list_cursors(std::chrono::steady_clock::time_point now);
     sdbus::MethodReply install(sdbus::MethodCall & call);
     sdbus::MethodReply upgrade(sdbus::MethodCall & call);
     sdbus::MethodReply remove(sdbus::MethodCall & call);
     sdbus::MethodReply distro_sync(sdbus::MethodCall & call);
     sdbus::MethodReply downgrade(sdbus::MethodCall & call);
     sdbus::MethodReply reinstall(sdbus::MethodCall & call);
+
+    /// Cursors of clients that neither read the list to the end nor close it are released after the timeout.
+    /// At most `MAX_LIST_CURSORS` cursors are kept, the least recently used one is released to open a new one.
+    static constexpr auto LIST_CURSOR_TIMEOUT = std::chrono::minutes(10);
+    static constexpr std::size_t MAX_LIST_CURSORS = 16;
+    std::mutex list_cursors_mutex;
+    uint64_t last_list_cursor_id{0};
+    std::map<uint64_t, ListCursor> list_cursors;
 };
 
 #endif
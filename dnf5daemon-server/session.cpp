@@ -35,16 +35,47 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <chrono>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
 
 
+namespace {
+
+// Returns the mutex serializing loading of repositories that use the `cachedir`.
+// Sessions with the same cache directory then do not download and parse the same metadata concurrently.
+// The session that comes second loads the solv cache files written by the first one.
+std::mutex & get_cachedir_mutex(const std::string & cachedir) {
+    static std::mutex cachedir_mutexes_guard;
+    static std::map<std::string, std::mutex> cachedir_mutexes;
+    std::lock_guard<std::mutex> guard(cachedir_mutexes_guard);
+    return cachedir_mutexes[cachedir];
+}
+
+// The cache directory lock held by the current thread while it loads repositories.
+// It is released for the time the thread waits for the user to confirm a repository key import.
+thread_local std::unique_lock<std::mutex> * thread_cachedir_lock{nullptr};
+
+class CachedirLockScope {
+public:
+    explicit CachedirLockScope(std::unique_lock<std::mutex> & lock) { thread_cachedir_lock = &lock; }
+    ~CachedirLockScope() { thread_cachedir_lock = nullptr; }
+    CachedirLockScope(const CachedirLockScope &) = delete;
+    CachedirLockScope & operator=(const CachedirLockScope &) = delete;
+};
+
+}  // namespace
+
+
 Session::Session(
     std::vector<std::unique_ptr<libdnf5::Logger>> && loggers,
     sdbus::IConnection & connection,
+    Metrics & metrics,
     dnfdaemon::KeyValueMap session_configuration,
     std::string object_path,
     std::string sender)
     : connection(connection),
+      metrics(metrics),
       base(std::make_unique<libdnf5::Base>(std::move(loggers))),
       goal(*base),
       session_configuration(session_configuration),
@@ -54,6 +85,9 @@ Session::Session(
         session_locale = session_configuration_value<std::string>("locale");
     }
 
+    // repository loading, goal resolving, ... of all sessions are aggregated in the daemon metrics
+    base->set_trace_exporter(std::make_unique<MetricsTraceExporter>(metrics));
+
     auto & config = base->get_config();
 
     // adjust base.config from session_configuration config overrides
@@ -129,17 +163,26 @@ bool Session::wait_for_key_confirmation(const std::string & key_id, sdbus::Signa
         dbus_object->emitSignal(request_signal);
     }
 
+    // do not block other sessions sharing the cache directory while the user decides
+    auto * cachedir_lock = thread_cachedir_lock;
+    if (cachedir_lock) {
+        cachedir_lock->unlock();
+    }
+
     // wait for a confirmation for <timeout>
     auto timeout = std::chrono::minutes(5);
     auto wait = key_import_condition.wait_for(key_import_lock, timeout, [this, &key_id]() {
         return key_import_status.at(key_id) != KeyConfirmationStatus::PENDING;
     });
+    auto confirmation = key_import_status.at(key_id);
+    key_import_lock.unlock();
+
+    if (cachedir_lock) {
+        cachedir_lock->lock();
+    }
     if (!wait) {
-        key_import_lock.unlock();
         throw sdbus::Error(dnfdaemon::ERROR, "Timeout while waiting for the repository key import confirmation.");
     }
-    auto confirmation = key_import_status.at(key_id);
-    key_import_lock.unlock();
 
     return confirmation == KeyConfirmationStatus::CONFIRMED;
 }
@@ -186,6 +229,9 @@ bool Session::read_all_repos() {
         }
 
         try {
+            std::unique_lock<std::mutex> cachedir_lock(
+                get_cachedir_mutex(base->get_config().get_cachedir_option().get_value()));
+            CachedirLockScope cachedir_lock_scope(cachedir_lock);
             base->get_repo_sack()->update_and_load_enabled_repos(load_system_repo);
         } catch (const std::runtime_error & ex) {
             retval = false;
@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define DNF5DAEMON_SERVER_SESSION_HPP
 
 #include "dbus.hpp"
+#include "metrics.hpp"
 #include "threads_manager.hpp"
 #include "utils.hpp"
 
@@ -53,6 +54,7 @@ public:
     Session(
         std::vector<std::unique_ptr<libdnf5::Logger>> && loggers,
         sdbus::IConnection & connection,
+        Metrics & metrics,
         dnfdaemon::KeyValueMap session_configuration,
         std::string object_path,
         std::string sender);
@@ -69,6 +71,7 @@ public:
 
     std::string get_object_path() { return object_path; };
     sdbus::IConnection & get_connection() { return connection; };
+    Metrics & get_metrics() { return metrics; };
     libdnf5::Base * get_base() { return base.get(); };
     ThreadsManager & get_threads_manager() { return threads_manager; };
     sdbus::IObject * get_dbus_object() { return dbus_object.get(); };
@@ -88,13 +91,14 @@ public:
 
 private:
     sdbus::IConnection & connection;
+    Metrics & metrics;
     std::unique_ptr<libdnf5::Base> base;
     libdnf5::Goal goal;
     std::unique_ptr<libdnf5::base::Transaction> transaction{nullptr};
     dnfdaemon::KeyValueMap session_configuration;
     std::string object_path;
     std::vector<std::unique_ptr<IDbusSessionService>> services{};
-    ThreadsManager threads_manager;
+    ThreadsManager threads_manager{metrics};
     std::atomic<dnfdaemon::RepoStatus> repositories_status{dnfdaemon::RepoStatus::NOT_READY};
     std::unique_ptr<sdbus::IObject> dbus_object;
     std::string sender;
@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/logger/stream_logger.hpp>
 #include <sdbus-c++/sdbus-c++.h>
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <sstream>
@@ -51,6 +52,10 @@ void SessionManager::dbus_register() {
         dnfdaemon::INTERFACE_SESSION_MANAGER, "close_session", "o", "b", [this](sdbus::MethodCall call) -> void {
             threads_manager.handle_method(*this, &SessionManager::close_session, call);
         });
+    dbus_object->registerMethod(
+        dnfdaemon::INTERFACE_SESSION_MANAGER, "get_metrics", "", "a{sv}", [this](sdbus::MethodCall call) -> void {
+            threads_manager.handle_method(*this, &SessionManager::get_metrics, call);
+        });
     dbus_object->finishRegistration();
 
     // register signal handler for NameOwnerChanged
@@ -81,15 +86,19 @@ void SessionManager::on_name_owner_changed(sdbus::Signal & signal) {
     std::string old_owner;
     std::string new_owner;
     signal >> name >> old_owner >> new_owner;
-    if (new_owner.empty() && sessions.count(old_owner) > 0) {
-        std::map<std::string, std::map<std::string, std::unique_ptr<Session>>> to_be_erased;
+    if (new_owner.empty()) {
+        std::map<std::string, std::unique_ptr<Session>> to_be_erased;
         {
             std::lock_guard<std::mutex> lock(sessions_mutex);
-            // the sender name disappeared from the dbus, erase all its sessions
-            to_be_erased[old_owner] = std::move(sessions.at(old_owner));
-            sessions.erase(old_owner);
+            // the sender name disappeared from the dbus, erase all its sessions including the ones being opened
+            auto sender_it = sessions.find(old_owner);
+            if (sender_it != sessions.end()) {
+                to_be_erased = std::move(sender_it->second);
+                sessions.erase(sender_it);
+            }
         }
-        to_be_erased.erase(old_owner);
+        // the sessions are destroyed only after the sessions_mutex is released
+        to_be_erased.clear();
     }
 }
 
@@ -105,16 +114,53 @@ sdbus::MethodReply SessionManager::open_session(sdbus::MethodCall & call) {
 
     // generate UUID-like session id
     const std::string sessionid = dnfdaemon::DBUS_OBJECT_PATH + std::string("/") + gen_session_id();
-    // store newly created session
+    // create a vector of loggers with one logger
+    std::vector<std::unique_ptr<libdnf5::Logger>> loggers;
+    loggers.emplace_back(std::make_unique<libdnf5::StdCStreamLogger>(std::cerr));
+
+    // Reserve the session entry. If the client disconnects while the session is being set up, the entry is erased
+    // together with the other sessions of the client and the new session is dropped instead of being stored.
     {
-        // create a vector of loggers with one logger
-        std::vector<std::unique_ptr<libdnf5::Logger>> loggers;
-        loggers.emplace_back(std::make_unique<libdnf5::StdCStreamLogger>(std::cerr));
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        sessions[sender].emplace(sessionid, nullptr);
+    }
 
+    // Setting up the session (configuration, Base setup, plugins, repositories configuration) is expensive.
+    // Do it without holding the sessions_mutex so that closing of other sessions and clean up of sessions
+    // of disconnected clients are not blocked meanwhile. The active_mutex still prevents shut down.
+    std::unique_ptr<Session> session;
+    try {
+        session = std::make_unique<Session>(
+            std::move(loggers), *connection, metrics, std::move(configuration), sessionid, sender);
+    } catch (...) {
         std::lock_guard<std::mutex> lock(sessions_mutex);
-        sessions[sender].emplace(
-            sessionid,
-            std::make_unique<Session>(std::move(loggers), *connection, std::move(configuration), sessionid, sender));
+        auto sender_it = sessions.find(sender);
+        if (sender_it != sessions.end()) {
+            sender_it->second.erase(sessionid);
+            if (sender_it->second.empty()) {
+                sessions.erase(sender_it);
+            }
+        }
+        throw;
+    }
+
+    // store newly created session
+    bool stored = false;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        auto sender_it = sessions.find(sender);
+        if (sender_it != sessions.end()) {
+            auto session_it = sender_it->second.find(sessionid);
+            if (session_it != sender_it->second.end()) {
+                session_it->second = std::move(session);
+                stored = true;
+            }
+        }
+    }
+    if (!stored) {
+        // the client disconnected meanwhile, the session is destroyed outside of the sessions_mutex
+        session.reset();
+        throw sdbus::Error(dnfdaemon::ERROR, "Client disconnected while the session was being opened.");
     }
 
     auto reply = call.createReply();
@@ -129,13 +175,20 @@ sdbus::MethodReply SessionManager::close_session(sdbus::MethodCall & call) {
     call >> session_id;
 
     bool retval = false;
-    // find sessions created by the same sender
-    auto sender_it = sessions.find(sender);
-    if (sender_it != sessions.end()) {
+    // the removed session is destroyed only after the sessions_mutex is released
+    std::unique_ptr<Session> session;
+    {
         std::lock_guard<std::mutex> lock(sessions_mutex);
-        // delete session with given session_id
-        if (sender_it->second.erase(session_id) > 0) {
-            retval = true;
+        // find sessions created by the same sender
+        auto sender_it = sessions.find(sender);
+        if (sender_it != sessions.end()) {
+            // delete session with given session_id
+            auto session_it = sender_it->second.find(session_id);
+            if (session_it != sender_it->second.end() && session_it->second) {
+                session = std::move(session_it->second);
+                sender_it->second.erase(session_it);
+                retval = true;
+            }
         }
     }
 
@@ -144,6 +197,25 @@ sdbus::MethodReply SessionManager::close_session(sdbus::MethodCall & call) {
     return reply;
 }
 
+sdbus::MethodReply SessionManager::get_metrics(sdbus::MethodCall & call) {
+    auto metrics_map = metrics.get_key_value_map();
+
+    uint64_t active_sessions = 0;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        for (const auto & [sender, sender_sessions] : sessions) {
+            // sessions being opened are not active yet
+            active_sessions += static_cast<uint64_t>(std::count_if(
+                sender_sessions.begin(), sender_sessions.end(), [](const auto & item) { return item.second; }));
+        }
+    }
+    metrics_map.emplace("active_sessions", active_sessions);
+
+    auto reply = call.createReply();
+    reply << metrics_map;
+    return reply;
+}
+
 void SessionManager::start_event_loop() {
     connection->enterEventLoop();
 };
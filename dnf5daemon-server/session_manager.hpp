@@ -20,6 +20,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #ifndef DNF5DAEMON_SERVER_SESSIONMANAGER_HPP
 #define DNF5DAEMON_SERVER_SESSIONMANAGER_HPP
 
+#include "metrics.hpp"
 #include "session.hpp"
 #include "threads_manager.hpp"
 
@@ -41,19 +42,21 @@ public:
 
 private:
     std::unique_ptr<sdbus::IConnection> connection = nullptr;
-    ThreadsManager threads_manager;
+    Metrics metrics;
+    ThreadsManager threads_manager{metrics};
     std::unique_ptr<sdbus::IObject> dbus_object;
     std::unique_ptr<sdbus::IProxy> name_changed_proxy;
     std::mutex active_mutex;
     bool active = true;
 
     std::mutex sessions_mutex;
-    // map {sender_address: {session_id: Session object}}
+    // map {sender_address: {session_id: Session object}}, the Session is null while the session is being opened
     std::map<std::string, std::map<std::string, std::unique_ptr<Session>>> sessions;
 
     void dbus_register();
     sdbus::MethodReply open_session(sdbus::MethodCall & call);
     sdbus::MethodReply close_session(sdbus::MethodCall & call);
+    sdbus::MethodReply get_metrics(sdbus::MethodCall & call);
     void on_name_owner_changed(sdbus::Signal & signal);
 };
 
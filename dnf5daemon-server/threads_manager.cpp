@@ -23,67 +23,76 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <locale.h>
 
-#include <algorithm>
-#include <chrono>
-#include <iostream>
-
-ThreadsManager::ThreadsManager() {
-    // collecting finished worker threads
-    running_threads_collector = std::thread([this]() {
-        while (!finish_collector) {
-            join_threads(true);
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
-    });
-}
+#include <utility>
+
+ThreadsManager::ThreadsManager(Metrics & metrics) : metrics(metrics) {}
 
 ThreadsManager::~ThreadsManager() {
     finish();
 }
 
-void ThreadsManager::register_thread(std::thread && thread) {
-    std::lock_guard<std::mutex> lock(running_threads_mutex);
-    running_threads.emplace_back(std::move(thread));
-}
-
-void ThreadsManager::mark_thread_finished(std::thread::id thread_id) {
-    std::lock_guard<std::mutex> lock(running_threads_mutex);
-    finished_threads.emplace_back(std::move(thread_id));
+void ThreadsManager::run_task(std::function<void()> && task) {
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    join_finished_workers();
+    tasks.emplace_back(std::move(task));
+    if (idle_workers >= tasks.size()) {
+        tasks_condition.notify_one();
+    } else {
+        auto worker = std::thread(&ThreadsManager::worker_loop, this);
+        auto worker_id = worker.get_id();
+        workers.emplace(worker_id, std::move(worker));
+    }
 }
 
-void ThreadsManager::join_threads(const bool only_finished) {
-    std::vector<std::thread> to_be_joined{};
-
-    {
-        std::lock_guard<std::mutex> lock(running_threads_mutex);
-        for (auto thread = running_threads.begin(); thread < running_threads.end();) {
-            auto in_finished = std::find(finished_threads.begin(), finished_threads.end(), thread->get_id());
-            if (thread->joinable() && (!only_finished || (in_finished != finished_threads.end()))) {
-                to_be_joined.push_back(std::move(*thread));
-                running_threads.erase(thread);
-                if (in_finished != finished_threads.end()) {
-                    finished_threads.erase(in_finished);
-                }
-            } else {
-                ++thread;
-            }
+void ThreadsManager::worker_loop() {
+    std::unique_lock<std::mutex> lock(tasks_mutex);
+    while (true) {
+        ++idle_workers;
+        tasks_condition.wait_for(lock, WORKER_IDLE_TIMEOUT, [this]() { return finishing || !tasks.empty(); });
+        --idle_workers;
+        if (tasks.empty()) {
+            // idle timeout expired or the manager is finishing
+            break;
         }
+
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
     }
+    finished_workers.emplace_back(std::this_thread::get_id());
+}
 
-    for (auto thread = to_be_joined.begin(); thread < to_be_joined.end(); ++thread) {
-        // join the thread and remove it from registry
-        thread->join();
+void ThreadsManager::join_finished_workers() {
+    for (const auto & worker_id : finished_workers) {
+        auto worker = workers.find(worker_id);
+        if (worker != workers.end()) {
+            // the worker has already left its loop, the join does not block
+            worker->second.join();
+            workers.erase(worker);
+        }
     }
+    finished_workers.clear();
 }
 
 void ThreadsManager::finish() {
-    if (!running_threads_collector.joinable()) {
-        return;
+    while (true) {
+        std::map<std::thread::id, std::thread> to_be_joined;
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            finishing = true;
+            finished_workers.clear();
+            to_be_joined.swap(workers);
+        }
+        if (to_be_joined.empty()) {
+            break;
+        }
+        tasks_condition.notify_all();
+        for (auto & [worker_id, worker] : to_be_joined) {
+            worker.join();
+        }
     }
-    // join all threads
-    finish_collector = true;
-    join_threads(false);
-    running_threads_collector.join();
 }
 
 
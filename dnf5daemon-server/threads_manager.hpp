@@ -21,26 +21,31 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define DNF5DAEMON_SERVER_THREADS_MANAGER_HPP
 
 #include "dbus.hpp"
+#include "metrics.hpp"
 
 #include <fmt/format.h>
 #include <locale.h>
 #include <sdbus-c++/sdbus-c++.h>
 
-#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
 
+/// Runs D-Bus method calls and signal handlers in a pool of worker threads.
+/// Idle workers are reused for new calls. A new worker is started only if all existing ones are busy.
+/// Workers that stay idle for longer than WORKER_IDLE_TIMEOUT exit.
+/// The number and the duration of the handled method calls are recorded to the `metrics`.
 class ThreadsManager {
 public:
-    ThreadsManager();
+    explicit ThreadsManager(Metrics & metrics);
     virtual ~ThreadsManager();
-    void register_thread(std::thread && thread);
-    void mark_thread_finished(std::thread::id thread_id);
-    void current_thread_finished() { mark_thread_finished(std::this_thread::get_id()); };
-    void join_threads(const bool only_finished);
     void finish();
 
     template <class S>
@@ -49,100 +54,104 @@ public:
         sdbus::MethodReply (S::*method)(sdbus::MethodCall &),
         sdbus::MethodCall & call,
         std::optional<std::string> thread_locale = std::nullopt) {
-        auto worker = std::thread(
-            [this](
-                S & service,
-                sdbus::MethodReply (S::*method)(sdbus::MethodCall &),
-                sdbus::MethodCall call,
-                std::optional<std::string> thread_locale = std::nullopt) {
-                locale_t new_locale{nullptr};
-                locale_t orig_locale{nullptr};
-                if (thread_locale) {
-                    orig_locale = set_thread_locale(thread_locale.value(), new_locale);
-                }
-
-                sdbus::MethodReply reply;
-                try {
-                    reply = (service.*method)(call);
-                } catch (const sdbus::Error & ex) {
-                    reply = call.createErrorReply(ex);
-                } catch (const std::exception & ex) {
-                    reply = call.createErrorReply(sdbus::Error(dnfdaemon::ERROR, ex.what()));
-                } catch (...) {
-                    reply = call.createErrorReply(sdbus::Error(dnfdaemon::ERROR, "Unknown exception caught"));
-                }
-                bool success = false;
-                std::string error_msg;
-                try {
-                    reply.send();
-                    success = true;
-                } catch (const std::exception & e) {
-                    error_msg = e.what();
-                } catch (...) {
-                    error_msg = "Unknown exception caught";
-                }
-                if (!success) {
-                    std::cerr << fmt::format(
-                                     "Error sending D-Bus reply to {}:{}() call: {}",
-                                     call.getInterfaceName(),
-                                     call.getMemberName(),
-                                     error_msg)
-                              << std::endl;
-                }
-
-                if (thread_locale) {
-                    uselocale(orig_locale);
-                    freelocale(new_locale);
-                }
-                current_thread_finished();
-            },
-            std::ref(service),
-            method,
-            call,
-            thread_locale);
-        register_thread(std::move(worker));
+        run_task([this, &service, method, call, thread_locale]() mutable {
+            locale_t new_locale{nullptr};
+            locale_t orig_locale{nullptr};
+            if (thread_locale) {
+                orig_locale = set_thread_locale(thread_locale.value(), new_locale);
+            }
+
+            auto call_start = std::chrono::steady_clock::now();
+            bool call_success = false;
+            sdbus::MethodReply reply;
+            try {
+                reply = (service.*method)(call);
+                call_success = true;
+            } catch (const sdbus::Error & ex) {
+                reply = call.createErrorReply(ex);
+            } catch (const std::exception & ex) {
+                reply = call.createErrorReply(sdbus::Error(dnfdaemon::ERROR, ex.what()));
+            } catch (...) {
+                reply = call.createErrorReply(sdbus::Error(dnfdaemon::ERROR, "Unknown exception caught"));
+            }
+            metrics.record_method_call(
+                fmt::format("{}.{}", call.getInterfaceName(), call.getMemberName()),
+                std::chrono::steady_clock::now() - call_start,
+                call_success);
+            bool success = false;
+            std::string error_msg;
+            try {
+                reply.send();
+                success = true;
+            } catch (const std::exception & e) {
+                error_msg = e.what();
+            } catch (...) {
+                error_msg = "Unknown exception caught";
+            }
+            if (!success) {
+                std::cerr << fmt::format(
+                                 "Error sending D-Bus reply to {}:{}() call: {}",
+                                 call.getInterfaceName(),
+                                 call.getMemberName(),
+                                 error_msg)
+                          << std::endl;
+            }
+
+            if (thread_locale) {
+                uselocale(orig_locale);
+                freelocale(new_locale);
+            }
+        });
     }
 
     template <class S>
     void handle_signal(S & service, void (S::*method)(sdbus::Signal &), sdbus::Signal & signal) {
-        auto worker = std::thread(
-            [this](S & service, void (S::*method)(sdbus::Signal &), sdbus::Signal signal) {
-                bool success = false;
-                std::string error_msg;
-                try {
-                    (service.*method)(signal);
-                    success = true;
-                } catch (const std::exception & ex) {
-                    error_msg = ex.what();
-                } catch (...) {
-                    error_msg = "Unknown exception caught";
-                }
-                if (!success) {
-                    std::cerr << fmt::format(
-                                     "Error handling signal {}:{}: {}",
-                                     signal.getInterfaceName(),
-                                     signal.getMemberName(),
-                                     error_msg)
-                              << std::endl;
-                }
-                current_thread_finished();
-            },
-            std::ref(service),
-            method,
-            signal);
-        register_thread(std::move(worker));
+        run_task([&service, method, signal]() mutable {
+            bool success = false;
+            std::string error_msg;
+            try {
+                (service.*method)(signal);
+                success = true;
+            } catch (const std::exception & ex) {
+                error_msg = ex.what();
+            } catch (...) {
+                error_msg = "Unknown exception caught";
+            }
+            if (!success) {
+                std::cerr << fmt::format(
+                                 "Error handling signal {}:{}: {}",
+                                 signal.getInterfaceName(),
+                                 signal.getMemberName(),
+                                 error_msg)
+                          << std::endl;
+            }
+        });
     }
 
 private:
-    std::mutex running_threads_mutex;
-    // flag whether to break the finished threads collector infinite loop
-    std::atomic<bool> finish_collector{false};
-    // thread that joins finished worker threads
-    std::thread running_threads_collector;
-    // vector of started worker threads
-    std::vector<std::thread> running_threads{};
-    // vector of finished threads id
-    std::vector<std::thread::id> finished_threads{};
+    static constexpr std::chrono::seconds WORKER_IDLE_TIMEOUT{60};
+
+    /// Queues the task and wakes up an idle worker. Starts a new worker if there is none idle.
+    void run_task(std::function<void()> && task);
+    /// Main loop of worker threads. Runs queued tasks until idle timeout or until finish() is called.
+    void worker_loop();
+    /// Joins workers that exited their loop. Must be called with `tasks_mutex` locked.
+    void join_finished_workers();
+
+    Metrics & metrics;
+
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_condition;
+    // queue of tasks waiting for a worker
+    std::deque<std::function<void()>> tasks;
+    // number of workers waiting for a task
+    std::size_t idle_workers{0};
+    // set by finish(), workers exit when the queue is empty
+    bool finishing{false};
+    // started worker threads
+    std::map<std::thread::id, std::thread> workers;
+    // ids of workers that exited their loop and are waiting to be joined
+    std::vector<std::thread::id> finished_workers;
     static locale_t set_thread_locale(const std::string & thread_locale, locale_t & new_locale);
 };
 
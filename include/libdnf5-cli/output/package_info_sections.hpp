@@ -65,7 +65,7 @@ public:
             add_line("Download size", utils::units::format_size_aligned(static_cast<int64_t>(pkg.get_download_size())));
         }
         add_line("Installed size", utils::units::format_size_aligned(static_cast<int64_t>(pkg.get_install_size())));
-        if (pkg.get_arch() != "src") {
+        if (pkg.get_arch_view() != "src") {
             add_line("Source", pkg.get_sourcerpm());
         }
         if (pkg.is_installed()) {
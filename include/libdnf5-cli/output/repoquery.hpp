@@ -24,6 +24,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package_set.hpp>
 #include <libsmartcols/libsmartcols.h>
 
+#include <string>
+#include <vector>
+
 namespace libdnf5::cli::output {
 
 bool requires_filelists(const std::string & queryformat);
@@ -31,6 +34,14 @@ bool requires_filelists(const std::string & queryformat);
 void print_pkg_set_with_format(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat);
 
+/// Prints the packages as newline-delimited JSON, one object per package with the `pkg_attrs` members.
+/// The attribute names are the same as the queryformat tags. Numbers are printed as JSON numbers,
+/// lists (provides, files, ...) as arrays of strings and the rest as strings.
+/// The packages are printed as they are formatted, in the order of the package set.
+/// @throws libdnf5::cli::ArgumentParserInvalidValueError if an attribute is unknown.
+void print_pkg_set_as_json(
+    std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::vector<std::string> & pkg_attrs);
+
 void print_pkg_attr_uniq_sorted(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & getter_name);
 
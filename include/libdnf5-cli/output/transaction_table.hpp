@@ -31,7 +31,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/utils/to_underlying.hpp>
 #include <libsmartcols/libsmartcols.h>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 #include <vector>
 
 
@@ -382,6 +384,52 @@ static bool transaction_package_cmp(const TransactionPackage & tspkg1, const Tra
 }
 
 
+/// Sorts the transaction packages into the order in which they are printed (see `transaction_package_cmp()`).
+/// Names and arches are fetched only once per package instead of in every comparison and the transaction
+/// packages themselves are moved only once, after their order is known.
+template <class TransactionPackages>
+void sort_transaction_packages(TransactionPackages & tspkgs) {
+    struct SortKey {
+        std::size_t index;
+        std::string name;
+        std::string arch;
+    };
+
+    std::vector<SortKey> keys;
+    keys.reserve(tspkgs.size());
+    for (std::size_t idx = 0; idx < tspkgs.size(); ++idx) {
+        auto && pkg = tspkgs[idx].get_package();
+        keys.push_back({idx, pkg.get_name(), pkg.get_arch()});
+    }
+
+    std::sort(keys.begin(), keys.end(), [&tspkgs](const SortKey & key1, const SortKey & key2) {
+        auto & tspkg1 = tspkgs[key1.index];
+        auto & tspkg2 = tspkgs[key2.index];
+        auto current_action = tspkg1.get_action();
+        if (current_action != tspkg2.get_action() ||
+            ((current_action == libdnf5::transaction::TransactionItemAction::INSTALL ||
+              current_action == libdnf5::transaction::TransactionItemAction::REMOVE) &&
+             tspkg1.get_reason() != tspkg2.get_reason())) {
+            return transaction_package_cmp<decltype(tspkg1)>(tspkg1, tspkg2);
+        }
+        if (int r = key1.name.compare(key2.name)) {
+            return r < 0;
+        }
+        if (int r = key1.arch.compare(key2.arch)) {
+            return r < 0;
+        }
+        return libdnf5::rpm::evrcmp(tspkg1.get_package(), tspkg2.get_package()) < 0;
+    });
+
+    TransactionPackages sorted;
+    sorted.reserve(tspkgs.size());
+    for (const auto & key : keys) {
+        sorted.push_back(std::move(tspkgs[key.index]));
+    }
+    tspkgs = std::move(sorted);
+}
+
+
 template <class TransactionGroup>
 static bool transaction_group_cmp(const TransactionGroup & tsgrp1, const TransactionGroup & tsgrp2) {
     if (tsgrp1.get_action() != tsgrp2.get_action()) {
@@ -398,7 +446,7 @@ static bool transaction_group_cmp(const TransactionGroup & tsgrp1, const Transac
 
 /// Prints all transaction problems
 template <class Transaction>
-void print_resolve_logs(Transaction transaction) {
+void print_resolve_logs(const Transaction & transaction) {
     const std::vector<std::string> logs = transaction.get_resolve_logs_as_strings();
     for (const auto & log : logs) {
         std::cerr << log << std::endl;
@@ -463,7 +511,7 @@ bool print_transaction_table(Transaction & transaction) {
     // TODO(dmach): consider reordering so the major changes (installs, obsoletes, removals) are at the bottom next to the confirmation question
     // TODO(jrohel): Print relations with obsoleted packages
 
-    std::sort(tspkgs.begin(), tspkgs.end(), transaction_package_cmp<decltype(*tspkgs.begin())>);
+    sort_transaction_packages(tspkgs);
     std::sort(tsgrps.begin(), tsgrps.end(), transaction_group_cmp<decltype(*tsgrps.begin())>);
 
     struct libscols_line * header_ln = nullptr;
@@ -517,7 +565,7 @@ bool print_transaction_table(Transaction & transaction) {
             struct libscols_line * ln_replaced = scols_table_new_line(tb, ln);
             // TODO(jmracek) Translate it
             std::string name("replacing ");
-            name.append(replaced.get_name());
+            name.append(replaced.get_name_view());
             scols_line_set_data(ln_replaced, COL_NAME, name.c_str());
             scols_line_set_data(ln_replaced, COL_ARCH, replaced.get_arch().c_str());
             scols_line_set_data(ln_replaced, COL_EVR, replaced.get_evr().c_str());
@@ -530,12 +578,12 @@ bool print_transaction_table(Transaction & transaction) {
             auto obsoleted_color = "brown";
 
             scols_cell_set_color(scols_line_get_cell(ln_replaced, COL_EVR), replaced_color);
-            if (pkg.get_arch() == replaced.get_arch()) {
+            if (pkg.get_arch_view() == replaced.get_arch_view()) {
                 scols_cell_set_color(scols_line_get_cell(ln_replaced, COL_ARCH), replaced_color);
             } else {
                 scols_cell_set_color(scols_line_get_cell(ln_replaced, COL_ARCH), obsoleted_color);
             }
-            if (pkg.get_name() == replaced.get_name()) {
+            if (pkg.get_name_view() == replaced.get_name_view()) {
                 scols_cell_set_color(scols_line_get_cell(ln_replaced, COL_NAME), replaced_color);
             } else {
                 scols_cell_set_color(scols_line_get_cell(ln_replaced, COL_NAME), obsoleted_color);
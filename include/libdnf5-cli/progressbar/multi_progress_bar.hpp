@@ -27,6 +27,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <vector>
 
 
@@ -42,8 +43,10 @@ public:
 
     void add_bar(std::unique_ptr<ProgressBar> && bar);
     void print() {
-        std::cout << *this;
-        std::cout << std::flush;
+        // Render the whole frame first and write it at once, every std::endl would flush the line separately.
+        std::ostringstream frame;
+        frame << *this;
+        std::cout << frame.view() << std::flush;
     }
     friend std::ostream & operator<<(std::ostream & stream, MultiProgressBar & mbar);
 
@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define LIBDNF5_BASE_BASE_HPP
 
 #include "libdnf5/base/base_weak.hpp"
+#include "libdnf5/base/trace.hpp"
 #include "libdnf5/common/exception.hpp"
 #include "libdnf5/common/impl_ptr.hpp"
 #include "libdnf5/common/weak_ptr.hpp"
@@ -68,6 +69,15 @@ public:
     }
     repo::DownloadCallbacks * get_download_callbacks() { return download_callbacks.get(); }
 
+    /// Sets the exporter that receives the trace spans of the work done by this `Base`. Tracing is disabled
+    /// if no exporter is set (the default).
+    /// @since 5.1.10
+    void set_trace_exporter(std::unique_ptr<TraceExporter> && trace_exporter);
+
+    /// @return The trace exporter set by `set_trace_exporter()` or `nullptr`.
+    /// @since 5.1.10
+    TraceExporter * get_trace_exporter() noexcept;
+
     /// Sets the pointer to the locked instance "Base" to "this" instance. Blocks if the pointer is already set.
     /// Pointer to a locked "Base" instance can be obtained using "get_locked_base()".
     void lock();
@@ -109,6 +119,14 @@ public:
     /// Returns true when setup() (mandatory method in many workflows) was alredy called
     bool is_initialized();
 
+    /// Returns the approximate numbers of bytes allocated by the parts of the Base, intended for diagnostics.
+    /// The keys are "<part>.<item>" names, e.g. "rpm_pool.strings", "module_pool.reldeps", "repo.<repo_id>"
+    /// (only the dependency arrays and rpmdb ids of the repository in all pools, the repodata holding
+    /// the extended metadata and advisories is not counted), "rpm_package_sack.caches" and "logger.memory_buffer".
+    /// The set of keys may change between versions.
+    /// @since 5.1.10
+    std::map<std::string, std::size_t> get_memory_usage();
+
     // TODO(jmracek) Remove from public API due to unstability of the code
     transaction::TransactionHistoryWeakPtr get_transaction_history() { return transaction_history.get_weak_ptr(); }
     libdnf5::comps::CompsWeakPtr get_comps() { return comps.get_weak_ptr(); }
@@ -0,0 +1,95 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef LIBDNF5_BASE_TRACE_HPP
+#define LIBDNF5_BASE_TRACE_HPP
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace libdnf5 {
+
+class Base;
+
+/// Base class for trace exporters. A trace exporter receives the spans, the named and timed parts of the work done
+/// by libdnf5 (loading of a repository, resolving of a goal, phases of a transaction, ...), and stores or sends
+/// them somewhere, e.g. into a file in the Chrome trace event format or to an OpenTelemetry collector.
+/// To implement an exporter, inherit from this class, override `export_span()`, and set an instance of it
+/// to the `Base` by `Base::set_trace_exporter()`. Plugins can do it in their initialization.
+/// @since 5.1.10
+class TraceExporter {
+public:
+    using Attributes = std::vector<std::pair<std::string, std::string>>;
+
+    TraceExporter() = default;
+    TraceExporter(const TraceExporter &) = delete;
+    TraceExporter(TraceExporter &&) = delete;
+    TraceExporter & operator=(const TraceExporter &) = delete;
+    TraceExporter & operator=(TraceExporter &&) = delete;
+    virtual ~TraceExporter() = default;
+
+    /// Called when a span ended. Called in the thread that did the work, so it can be called from several threads
+    /// at the same time. Spans of one thread nest, the inner spans are exported before the outer ones.
+    /// @param name The name of the span, e.g. "repo_load" or "goal_resolve".
+    /// @param start The time the span started.
+    /// @param end The time the span ended.
+    /// @param attributes Additional information about the span, e.g. the repository id.
+    virtual void export_span(
+        const char * name,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end,
+        const Attributes & attributes) = 0;
+};
+
+
+/// Measures a named part of the work from the construction to the destruction of the object and passes it
+/// to the trace exporter of the `Base`. If no exporter is set, the span does nothing and costs only a pointer check.
+/// @since 5.1.10
+class TraceSpan {
+public:
+    /// @param base The `Base` whose trace exporter receives the span.
+    /// @param name The name of the span. It has to be valid until the span is destroyed.
+    TraceSpan(Base & base, const char * name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan(TraceSpan &&) = delete;
+    TraceSpan & operator=(const TraceSpan &) = delete;
+    TraceSpan & operator=(TraceSpan &&) = delete;
+
+    /// @return `true` if the span is recorded. Can be used to skip computing of attributes.
+    bool is_active() const noexcept { return exporter != nullptr; }
+
+    /// Adds an attribute to the span. Does nothing if the span is not active.
+    void set_attribute(std::string key, std::string value);
+
+private:
+    TraceExporter * exporter;
+    const char * name;
+    std::chrono::steady_clock::time_point start;
+    TraceExporter::Attributes attributes;
+};
+
+}  // namespace libdnf5
+
+#endif  // LIBDNF5_BASE_TRACE_HPP
@@ -28,6 +28,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/common/proc.hpp"
 #include "libdnf5/rpm/transaction_callbacks.hpp"
 
+#include <chrono>
 #include <optional>
 
 
@@ -84,9 +85,12 @@ public:
     std::vector<std::string> get_resolve_logs_as_strings() const;
 
     /// @return the transaction packages.
-    // TODO(jrohel): Return reference instead of copy?
     std::vector<libdnf5::base::TransactionPackage> get_transaction_packages() const;
 
+    /// @return the transaction packages without copying them. The reference is valid as long as the transaction exists.
+    /// @since 5.1.10
+    const std::vector<libdnf5::base::TransactionPackage> & get_transaction_packages_ref() const;
+
     /// @return the number of transaction packages.
     std::size_t get_transaction_packages_count() const;
 
@@ -163,6 +167,13 @@ public:
     /// Retrieve a list of the problems that occurred during `check_gpg_signatures` procedure.
     std::vector<std::string> get_gpg_signature_problems() const noexcept;
 
+    /// Retrieve the durations of the phases of the last `run()` or `test()` call in the order they were performed.
+    /// The phases are "gpg_check", "lock", "fill", "check", "test", "pre_transaction", "history_start",
+    /// "rpm_run", "system_state", "history_finish" and "post_transaction". Phases that were not reached
+    /// are missing.
+    /// @since 5.1.10
+    std::vector<std::pair<std::string, std::chrono::microseconds>> get_run_phase_durations() const noexcept;
+
     /// @warning This method is experimental/unstable and should not be relied on. It may be removed without warning
     /// Serialize the transaction into a json data format which can be later loaded
     /// into a `libdnf5::Goal` and replayed.
@@ -61,7 +61,7 @@ public:
     Reason get_reason() const noexcept { return reason; }
 
     /// @return packages replaced by this transaction package.
-    const std::vector<rpm::Package> get_replaces() const noexcept { return replaces; }
+    const std::vector<rpm::Package> & get_replaces() const noexcept { return replaces; }
 
     /// @return packages that replace this transaction package (for transaction
     /// packages that are leaving the system).
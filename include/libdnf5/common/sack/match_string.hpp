@@ -22,7 +22,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "query_cmp.hpp"
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -33,6 +35,33 @@ bool match_string(const std::string & value, QueryCmp cmp, const std::vector<std
 bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const std::string & pattern);
 bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const std::vector<std::string> & patterns);
 
+
+/// Matches string values against one or more patterns, the result is the same as of `match_string()`.
+///
+/// The patterns are prepared only once (lowercased for the case-insensitive comparisons, compiled for
+/// the regular expressions), so matching many values does not allocate for each value.
+/// The matcher is stateful and must not be used by more threads at once.
+/// @since 5.1.10
+class StringMatcher {
+public:
+    StringMatcher(QueryCmp cmp, const std::string & pattern);
+    StringMatcher(QueryCmp cmp, const std::vector<std::string> & patterns);
+    ~StringMatcher();
+
+    StringMatcher(const StringMatcher &) = delete;
+    StringMatcher & operator=(const StringMatcher &) = delete;
+
+    bool match(const std::string & value);
+    bool match(std::string_view value);
+    /// `nullptr` is matched as an empty string.
+    bool match(const char * value);
+    bool match(const std::vector<std::string> & values);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> p_impl;
+};
+
 }  // namespace libdnf5::sack
 
 
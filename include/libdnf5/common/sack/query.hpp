@@ -31,6 +31,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -44,8 +45,10 @@ class Query : public Set<T> {
 public:
     using FilterFunctionBool = bool(const T & obj);
     using FilterFunctionCString = char *(const T & obj);
+    using FilterFunctionConstCString = const char *(const T & obj);
     using FilterFunctionInt64 = int64_t(const T & obj);
     using FilterFunctionString = std::string(const T & obj);
+    using FilterFunctionStringView = std::string_view(const T & obj);
     using FilterFunctionVectorInt64 = std::vector<int64_t>(const T & obj);
     using FilterFunctionVectorString = std::vector<std::string>(const T & obj);
 
@@ -67,6 +70,19 @@ public:
 
     void filter(char * (*getter)(const T &), const std::string & pattern, QueryCmp cmp);
 
+    /// Filters using a getter that returns a view of a string owned by the object, no string is allocated
+    /// for the individual objects.
+    /// @since 5.1.10
+    void filter(std::string_view (*getter)(const T &), const std::string & pattern, QueryCmp cmp);
+    /// @since 5.1.10
+    void filter(std::string_view (*getter)(const T &), const std::vector<std::string> & patterns, QueryCmp cmp);
+    /// Filters using a getter that returns a null-terminated string owned by the object, `nullptr` is
+    /// matched as an empty string.
+    /// @since 5.1.10
+    void filter(const char * (*getter)(const T &), const std::string & pattern, QueryCmp cmp);
+    /// @since 5.1.10
+    void filter(const char * (*getter)(const T &), const std::vector<std::string> & patterns, QueryCmp cmp);
+
     /// Get a single object. Raise an exception if none or multiple objects match the query.
     const T & get() const {
         if (get_data().size() == 1) {
@@ -89,9 +105,9 @@ private:
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionString * getter, const std::string & pattern, QueryCmp cmp) {
+    StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
-        auto value = getter(*it);
-        if (match_string(value, cmp, pattern)) {
+        if (matcher.match(getter(*it))) {
             ++it;
         } else {
             // TODO(jrohel): Modifying of iterated dataset. Performance? Can be implement better?
@@ -103,9 +119,9 @@ inline void Query<T>::filter(Query<T>::FilterFunctionString * getter, const std:
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionVectorString * getter, const std::string & pattern, QueryCmp cmp) {
+    StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
-        auto values = getter(*it);
-        if (match_string(values, cmp, pattern)) {
+        if (matcher.match(getter(*it))) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -116,9 +132,9 @@ inline void Query<T>::filter(Query<T>::FilterFunctionVectorString * getter, cons
 template <typename T>
 inline void Query<T>::filter(
     Query<T>::FilterFunctionString * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    StringMatcher matcher(cmp, patterns);
     for (auto it = get_data().begin(); it != get_data().end();) {
-        auto value = getter(*it);
-        if (match_string(value, cmp, patterns)) {
+        if (matcher.match(getter(*it))) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -129,9 +145,9 @@ inline void Query<T>::filter(
 template <typename T>
 inline void Query<T>::filter(
     Query<T>::FilterFunctionVectorString * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    StringMatcher matcher(cmp, patterns);
     for (auto it = get_data().begin(); it != get_data().end();) {
-        auto values = getter(*it);
-        if (match_string(values, cmp, patterns)) {
+        if (matcher.match(getter(*it))) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -202,9 +218,60 @@ inline void Query<T>::filter(Query<T>::FilterFunctionBool * getter, bool pattern
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionCString * getter, const std::string & pattern, QueryCmp cmp) {
+    StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
-        auto value = getter(*it);
-        if (match_string(value, cmp, pattern)) {
+        if (matcher.match(getter(*it))) {
+            ++it;
+        } else {
+            it = get_data().erase(it);
+        }
+    }
+}
+
+template <typename T>
+inline void Query<T>::filter(Query<T>::FilterFunctionStringView * getter, const std::string & pattern, QueryCmp cmp) {
+    StringMatcher matcher(cmp, pattern);
+    for (auto it = get_data().begin(); it != get_data().end();) {
+        if (matcher.match(getter(*it))) {
+            ++it;
+        } else {
+            it = get_data().erase(it);
+        }
+    }
+}
+
+template <typename T>
+inline void Query<T>::filter(
+    Query<T>::FilterFunctionStringView * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    StringMatcher matcher(cmp, patterns);
+    for (auto it = get_data().begin(); it != get_data().end();) {
+        if (matcher.match(getter(*it))) {
+            ++it;
+        } else {
+            it = get_data().erase(it);
+        }
+    }
+}
+
+template <typename T>
+inline void Query<T>::filter(
+    Query<T>::FilterFunctionConstCString * getter, const std::string & pattern, QueryCmp cmp) {
+    StringMatcher matcher(cmp, pattern);
+    for (auto it = get_data().begin(); it != get_data().end();) {
+        if (matcher.match(getter(*it))) {
+            ++it;
+        } else {
+            it = get_data().erase(it);
+        }
+    }
+}
+
+template <typename T>
+inline void Query<T>::filter(
+    Query<T>::FilterFunctionConstCString * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    StringMatcher matcher(cmp, patterns);
+    for (auto it = get_data().begin(); it != get_data().end();) {
+        if (matcher.match(getter(*it))) {
             ++it;
         } else {
             it = get_data().erase(it);
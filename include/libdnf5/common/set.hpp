@@ -150,39 +150,85 @@ inline Set<T> & Set<T>::operator=(std::initializer_list<T> ilist) {
     return *this;
 }
 
+// The set operations below modify `data` in place during a single merge walk over both sorted sets.
+// The untouched elements are neither copied nor reallocated and the insertions use an exact
+// position hint, so every operation is linear in the sizes of both sets.
+
 template <typename T>
 inline Set<T> & Set<T>::operator|=(const Set<T> & other) {
-    std::set<T> result;
-    std::set_union(
-        data.begin(), data.end(), other.data.begin(), other.data.end(), std::inserter(result, result.begin()));
-    data = result;
+    auto less = data.key_comp();
+    auto it = data.begin();
+    for (const auto & obj : other.data) {
+        while (it != data.end() && less(*it, obj)) {
+            ++it;
+        }
+        if (it == data.end() || less(obj, *it)) {
+            data.insert(it, obj);
+        } else {
+            ++it;
+        }
+    }
     return *this;
 }
 
 template <typename T>
 inline Set<T> & Set<T>::operator&=(const Set<T> & other) {
-    std::set<T> result;
-    std::set_intersection(
-        data.begin(), data.end(), other.data.begin(), other.data.end(), std::inserter(result, result.begin()));
-    data = std::move(result);
+    auto less = data.key_comp();
+    auto it = data.begin();
+    auto other_it = other.data.begin();
+    while (it != data.end()) {
+        if (other_it == other.data.end() || less(*it, *other_it)) {
+            it = data.erase(it);
+        } else if (less(*other_it, *it)) {
+            ++other_it;
+        } else {
+            ++it;
+            ++other_it;
+        }
+    }
     return *this;
 }
 
 template <typename T>
 inline Set<T> & Set<T>::operator-=(const Set<T> & other) {
-    std::set<T> result;
-    std::set_difference(
-        data.begin(), data.end(), other.data.begin(), other.data.end(), std::inserter(result, result.begin()));
-    data = result;
+    if (&other == this) {
+        data.clear();
+        return *this;
+    }
+    auto less = data.key_comp();
+    auto it = data.begin();
+    auto other_it = other.data.begin();
+    while (it != data.end() && other_it != other.data.end()) {
+        if (less(*it, *other_it)) {
+            ++it;
+        } else if (less(*other_it, *it)) {
+            ++other_it;
+        } else {
+            it = data.erase(it);
+            ++other_it;
+        }
+    }
     return *this;
 }
 
 template <typename T>
 inline Set<T> & Set<T>::operator^=(const Set<T> & other) {
-    std::set<T> result;
-    std::set_symmetric_difference(
-        data.begin(), data.end(), other.data.begin(), other.data.end(), std::inserter(result, result.begin()));
-    data = result;
+    if (&other == this) {
+        data.clear();
+        return *this;
+    }
+    auto less = data.key_comp();
+    auto it = data.begin();
+    for (const auto & obj : other.data) {
+        while (it != data.end() && less(*it, obj)) {
+            ++it;
+        }
+        if (it == data.end() || less(obj, *it)) {
+            data.insert(it, obj);
+        } else {
+            it = data.erase(it);
+        }
+    }
     return *this;
 }
 
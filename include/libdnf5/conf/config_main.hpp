@@ -94,6 +94,8 @@ public:
     const OptionStringList & get_group_package_types_option() const;
     OptionStringSet & get_optional_metadata_types_option();
     const OptionStringSet & get_optional_metadata_types_option() const;
+    OptionStringSet & get_ondemand_metadata_types_option();
+    const OptionStringSet & get_ondemand_metadata_types_option() const;
     OptionBool & get_use_host_config_option();
     const OptionBool & get_use_host_config_option() const;
 
@@ -193,6 +195,37 @@ public:
     const OptionBool & get_upgrade_group_objects_upgrade_option() const;
     OptionPath & get_destdir_option();
     const OptionPath & get_destdir_option() const;
+    /// Directory with downloaded packages shared by all repositories and installroots.
+    /// The packages are stored under their checksums and hardlinked to the repository cache directories.
+    /// The sharing is disabled if empty.
+    /// @since 5.1.10
+    OptionPath & get_shared_package_cachedir_option();
+    /// @since 5.1.10
+    const OptionPath & get_shared_package_cachedir_option() const;
+    /// Maximum total size of the packages in the "shared_package_cachedir" directory.
+    /// The least recently used packages exceeding it are removed from the shared cache after each download,
+    /// the copies linked to the repository cache directories stay. The value is in bytes, the units 'k', 'M'
+    /// and 'G' can be used. 0 means no limit.
+    /// @since 5.1.10
+    OptionNumber<std::uint64_t> & get_shared_package_cache_size_option();
+    /// @since 5.1.10
+    const OptionNumber<std::uint64_t> & get_shared_package_cache_size_option() const;
+    /// Maximum total size of the repository caches in the "cachedir" directory.
+    /// The least recently used caches exceeding it, which are not in use, are removed
+    /// by `RepoSack::apply_cache_budget()`.
+    /// The value is in bytes, the units 'k', 'M' and 'G' can be used. 0 means no limit.
+    /// @since 5.1.10
+    OptionNumber<std::uint64_t> & get_cache_budget_option();
+    /// @since 5.1.10
+    const OptionNumber<std::uint64_t> & get_cache_budget_option() const;
+    /// Minimum interval in milliseconds between two progress notifications of the same item passed to
+    /// `DownloadCallbacks::progress()` and to the progress methods of `TransactionCallbacks`.
+    /// The notifications in between are dropped, the start, end and failure notifications and the progress
+    /// notification reporting completion are always delivered. 0 means that all notifications are delivered.
+    /// @since 5.1.10
+    OptionNumber<std::uint32_t> & get_progress_interval_option();
+    /// @since 5.1.10
+    const OptionNumber<std::uint32_t> & get_progress_interval_option() const;
     OptionString & get_comment_option();
     const OptionString & get_comment_option() const;
     OptionBool & get_downloadonly_option();
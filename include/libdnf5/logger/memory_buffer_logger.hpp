@@ -52,6 +52,10 @@ public:
     void clear() noexcept;
     void write_to_logger(Logger & logger);
 
+    /// @return The approximate number of bytes allocated by the stored messages.
+    /// @since 5.1.10
+    std::size_t get_memory_usage() const;
+
 private:
     mutable std::mutex items_mutex;
     std::size_t max_items;  // rotation, oldest messages are replaced
@@ -173,11 +173,11 @@ public:
 private:
     // Getter callbacks that return attribute values from an object. Used in query filters.
     struct Get {
-        static std::string name(const ModuleItem & obj) { return obj.get_name(); }
-        static std::string stream(const ModuleItem & obj) { return obj.get_stream(); }
+        static const char * name(const ModuleItem & obj) { return obj.get_name_cstr(); }
+        static const char * stream(const ModuleItem & obj) { return obj.get_stream_cstr(); }
         static std::string version(const ModuleItem & obj) { return obj.get_version_str(); }
-        static std::string context(const ModuleItem & obj) { return obj.get_context(); }
-        static std::string arch(const ModuleItem & obj) { return obj.get_arch(); }
+        static const char * context(const ModuleItem & obj) { return obj.get_context_cstr(); }
+        static const char * arch(const ModuleItem & obj) { return obj.get_arch_cstr(); }
         static bool is_enabled(const ModuleItem & obj);
         static bool is_disabled(const ModuleItem & obj);
     };
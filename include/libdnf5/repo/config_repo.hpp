@@ -131,6 +131,14 @@ public:
     /// If true it will create libsolv cache that will speed up the next loading process
     OptionChild<OptionBool> & get_build_cache_option();
     const OptionChild<OptionBool> & get_build_cache_option() const;
+    /// If true and all baseurls of the repository are local "file:" URLs (and there is no metalink or mirrorlist),
+    /// its metadata are read directly from the first baseurl directory containing them instead of being copied
+    /// into the cache directory and they are never considered expired. Only the solv cache files are stored
+    /// in the cache directory.
+    /// @since 5.1.10
+    OptionBool & get_local_in_place_option();
+    /// @since 5.1.10
+    const OptionBool & get_local_in_place_option() const;
 
     // option recognized by other tools, e.g. gnome-software, but unused in dnf
     OptionString & get_enabled_metadata_option();
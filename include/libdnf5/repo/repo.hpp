@@ -285,6 +285,15 @@ public:
     /// Gets path to the repository persistent directory
     std::string get_persistdir() const;
 
+    /// Reads the names of the packages in the repository from the package names index stored in the repository
+    /// cache. The index is written together with the solv cache of the primary metadata, so the repository
+    /// does not need to be loaded. Intended for quick listing of package names, e.g. in shell completion.
+    /// @param prefix Only the names starting with `prefix` are read.
+    /// @param names The sorted matching names are appended to this vector.
+    /// @return `false` if the index does not exist or cannot be read, `true` otherwise.
+    /// @since 5.1.10
+    bool read_cached_package_names(const std::string & prefix, std::vector<std::string> & names) const;
+
     /// Gets name of repository
     /// Alias
     std::string get_name() { return this->get_config().get_name_option().get_value(); };
@@ -23,6 +23,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/common/exception.hpp"
 
+#include <cstdint>
+#include <ctime>
 #include <filesystem>
 #include <string>
 
@@ -56,6 +58,10 @@ public:
     /// The name of the attribute used to mark the cache as expired.
     static constexpr const char * ATTRIBUTE_EXPIRED = "expired";
 
+    /// The name of the attribute with the time (seconds since the epoch) the cache was last loaded.
+    /// @since 5.1.10
+    static constexpr const char * ATTRIBUTE_LAST_USED = "last_used";
+
     /// Construct a new repository cache management instance.
     ///
     /// @param base            WeakPtr on the Base instance.
@@ -123,6 +129,19 @@ public:
     /// @exception RepoCacheException Throws an exception if the reposiitory id cannot be determined.
     std::string get_repoid();
 
+    /// Gets the total size of the files in the cache.
+    ///
+    /// @return Total size of the regular files in the cache in bytes.
+    /// @since 5.1.10
+    std::uintmax_t get_size();
+
+    /// Gets the time the cache was last used.
+    ///
+    /// @return The value of the `ATTRIBUTE_LAST_USED` attribute. If the attribute does not exist or cannot be parsed,
+    ///         the modification time of the cache directory.
+    /// @since 5.1.10
+    std::time_t get_last_used();
+
 private:
     libdnf5::BaseWeakPtr base;
     std::filesystem::path cache_dir;
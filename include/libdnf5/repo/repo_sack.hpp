@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define LIBDNF5_RPM_REPO_SACK_HPP
 
 #include "repo.hpp"
+#include "repo_cache.hpp"
 #include "repo_query.hpp"
 
 #include "libdnf5/base/base_weak.hpp"
@@ -129,7 +130,9 @@ public:
     /// potentially downloads fresh metadata (by calling the
     /// `download_metadata()` method) and then queues them for loading. This
     /// speeds up the process by loading repos into memory while others are being
-    /// downloaded.
+    /// downloaded. Metadata of several repos are downloaded in parallel, the number
+    /// of repos downloaded at the same time is limited by the "max_parallel_downloads"
+    /// main configuration option.
     ///
     /// @param repos The repositories to update and load
     /// @param import_keys If true, attempts to download and import keys for repositories that failed key validation
@@ -152,6 +155,15 @@ public:
     /// are created from info in system state.
     void fix_group_missing_xml();
 
+    /// Removes the least recently used repository caches from the "cachedir" directory until the total size
+    /// of the caches fits into the "cache_budget" main configuration option. Caches of the enabled repositories,
+    /// caches used by other processes and caches used within the last hour are never removed.
+    /// Nothing is done if "cache_budget" is 0.
+    ///
+    /// @return Number of deleted files and directories. Number of errors.
+    /// @since 5.1.10
+    RepoCache::RemoveStatistics apply_cache_budget();
+
 private:
     friend class libdnf5::Base;
     friend class RepoQuery;
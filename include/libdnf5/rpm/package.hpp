@@ -29,6 +29,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -135,6 +136,16 @@ public:
     // @replaces libdnf:libdnf/hy-package.h:function:dnf_package_get_evr(DnfPackage * pkg)
     std::string get_evr() const;
 
+    /// Allocation free variants of `get_name()`, `get_arch()` and `get_evr()`.
+    /// The returned views point to the strings stored in the pool. They are valid only until the pool strings change,
+    /// that is until a repository is loaded or packages are added. Copy the value if it has to outlive that.
+    /// @since 5.1.10
+    std::string_view get_name_view() const;
+    /// @since 5.1.10
+    std::string_view get_arch_view() const;
+    /// @since 5.1.10
+    std::string_view get_evr_view() const;
+
     /// @return RPM package NEVRA (Name-Epoch:Version-Release.Arch). If the Epoch is 0, it is omitted from the output.
     /// @since 5.0
     //
@@ -365,6 +376,16 @@ public:
     // @replaces libdnf:libdnf/hy-package-private.hpp:function:dnf_package_get_changelogs(DnfPackage * pkg)
     std::vector<Changelog> get_changelogs() const;
 
+    /// Returns the changelog entries with the timestamp greater than or equal to `since`, newest first.
+    /// Only the author and text of the selected entries are read from the repodata, which makes this much
+    /// cheaper than `get_changelogs()` when only a few recent entries are needed.
+    /// @param since The oldest timestamp of the returned entries. Use 0 for no time limit.
+    /// @param limit The maximum number of the returned (newest) entries. Use 0 for no limit.
+    /// @return List of package changelog entries sorted from the newest. If `other` repository metadata are
+    ///         not loaded, empty list is returned.
+    /// @since 5.1.10
+    std::vector<Changelog> get_changelogs_since(time_t since, std::size_t limit = 0) const;
+
     // ===== REPODATA =====
 
     /// @return RPM package baseurl from repodata (`<location xml:base="...">`).
@@ -285,6 +285,16 @@ public:
     void filter_provides(
         const std::vector<std::string> & patterns, libdnf5::sack::QueryCmp cmp_type = libdnf5::sack::QueryCmp::EQ);
 
+    /// Find the reldeps that are not provided by any package in the query.
+    /// The result is the same as of calling `filter_provides()` on a copy of the query for each of the reldeps
+    /// and testing the copy for emptiness, but the query is not copied and the providers of each reldep are
+    /// only looked up until the first one in the query is found.
+    ///
+    /// @param reldep_list      ReldepList with RelDep objects to check.
+    /// @return                 The reldeps from `reldep_list` that are not provided by any package in the query.
+    /// @since 5.1.10
+    ReldepList get_unprovided_reldeps(const ReldepList & reldep_list) const;
+
     /// Filter packages by their `requires`.
     ///
     /// @param reldep_list      ReldepList with RelDep objects the filter is matched against.
@@ -618,6 +628,26 @@ public:
     // @replaces libdnf/sack/query.hpp:method:addFilter(int keyname, int cmp_type, int match) - cmp_type = HY_PKG_LATEST_PER_ARCH
     void filter_latest_evr(int limit = 1);
 
+    /// Group packages by `name` and `arch`. Then within each group, keep the installed packages and the available
+    /// packages that belong to a repo with the highest priority (the lowest number), and of those keep packages that
+    /// correspond with up to `limit` of (all but) latest `evr`s in the group.
+    /// The result is the same as calling `filter_priority()` followed by `filter_latest_evr(limit)`, but the packages
+    /// are sorted only once.
+    ///
+    /// @param limit            If `limit` > 0, keep `limit` number `evr`s in each group.
+    ///                         If `limit` < 0, keep all **but** `limit` last `evr`s in each group.
+    /// @since 5.1.10
+    void filter_latest_evr_by_priority(int limit = 1);
+
+    /// Group packages by `repo`, `name` and `arch`. Then within each group, keep packages that correspond with up to
+    /// `limit` of (all but) latest `evr`s in the group.
+    /// The result is the same as calling `filter_latest_evr(limit)` on a query of each repo separately.
+    ///
+    /// @param limit            If `limit` > 0, keep `limit` number `evr`s in each group.
+    ///                         If `limit` < 0, keep all **but** `limit` last `evr`s in each group.
+    /// @since 5.1.10
+    void filter_latest_evr_per_repo(int limit = 1);
+
     /// Group packages by `name` and `arch`. Then within each group, keep packages that correspond with up to `limit` of (all but) earliest `evr`s in the group.
     ///
     /// @param limit            If `limit` > 0, keep `limit` number `evr`s in each group.
@@ -680,6 +710,15 @@ public:
     /// in such cycles that are not required by any other installed package are also leaf.
     void filter_leaves();
 
+    /// Filter the dependency closure of `package_set` within the query.
+    ///
+    /// Keeps the packages of the query that are in `package_set` or are required by them through a chain
+    /// of `requires` resolved only with the packages of the query. All providers of a requirement are kept.
+    ///
+    /// @param package_set      PackageSet with the packages the closure starts from.
+    /// @since 5.1.10
+    void filter_requires_closure(const PackageSet & package_set);
+
     /// Filter packages whose installation or upgrade should cause a system
     /// reboot to be recommended. These are packages that either (1) belong to
     /// a hardcoded set of "core packages", including the kernel and systemd,
@@ -147,7 +147,19 @@ public:
 
     rpm::Package get_running_kernel();
 
+    /// Computes the internal indexes used by the package queries right away, they are otherwise computed lazily
+    /// by the first query needing them. Apart from moving the cost out of the first query, it means the queries
+    /// no longer modify the state of the sack until packages, repositories or excludes are changed.
+    ///
+    /// The Base remains not thread-safe. In particular, the package getters and some filters use the temporary
+    /// string space of the shared libsolv pool and the metadata postponed by the "ondemand_metadata_types"
+    /// configuration option are still loaded by the first query that needs them. Accesses from several threads
+    /// have to be serialized.
+    /// @since 5.1.10
+    void make_indexes_ready();
+
 private:
+    friend class libdnf5::Base;
     friend libdnf5::Goal;
     friend Package;
     friend PackageSet;
@@ -26,6 +26,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace libdnf5::rpm {
 
@@ -93,6 +94,14 @@ public:
     ///         CheckResult::FAILED - check failed for another reason
     CheckResult check_package_signature(Package package) const;
 
+    /// Check signatures of the `packages` using public keys stored in rpm database.
+    /// All the packages are verified within a single rpm transaction, which is faster
+    /// than checking them one by one.
+    /// @param packages: packages to check.
+    /// @return Check results (see `check_package_signature()`) in the order of `packages`.
+    /// @since 5.1.10
+    std::vector<CheckResult> check_package_signatures(const std::vector<Package> & packages) const;
+
     /// Import public key into rpm database.
     /// @param key: GPG key to be imported into rpm database.
     bool import_key(const KeyInfo & key) const;
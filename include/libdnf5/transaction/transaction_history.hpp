@@ -64,6 +64,23 @@ public:
     /// @return The listed transactions.
     std::vector<Transaction> list_all_transactions();
 
+    /// Lists transactions from the transaction history that contain a package whose name or NEVRA matches
+    /// the `pattern`. The pattern is evaluated by the database, see the SQLite GLOB operator.
+    ///
+    /// @param pattern The glob pattern to match the package name or NEVRA (with or without the epoch) against.
+    /// @return The listed transactions.
+    /// @since 5.1.10
+    std::vector<Transaction> list_transactions_by_package(const std::string & pattern);
+
+    /// Loads the packages of all `transactions` from the transaction history database using a single query.
+    ///
+    /// Otherwise each transaction queries the database for its packages on the first call of
+    /// `Transaction::get_packages()`, which is slow for long lists of transactions.
+    ///
+    /// @param transactions The transactions for which to load the packages.
+    /// @since 5.1.10
+    void load_transactions_packages(std::vector<Transaction> & transactions);
+
     /// @return The `Base` object to which this object belongs.
     /// @since 5.0
     libdnf5::BaseWeakPtr get_base() const;
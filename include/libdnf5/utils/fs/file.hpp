@@ -138,6 +138,10 @@ public:
     /// Reads the contents of the file from current position to the end or
     /// until `count` chars are read.
     ///
+    /// Regular files are read at once into a string of the remaining length.
+    /// Other streams (compressed files opened using `solv_xfopen`, pipes) are
+    /// read in growing chunks.
+    ///
     /// @param count The maximum number of characters to read, 0 to read till the end.
     /// @return The contents read from the file.
     std::string read(std::size_t count = 0);
@@ -59,15 +59,8 @@ void print_changelogs(
         }
         std::cout << std::endl;
 
-        auto changelogs = packages[0].get_changelogs();
-        std::sort(
-            changelogs.begin(),
-            changelogs.end(),
-            [](const libdnf5::rpm::Changelog & a, const libdnf5::rpm::Changelog & b) {
-                return a.timestamp > b.timestamp;
-            });
-
-        // filter changelog
+        // Only the entries passing the filter are read from the repodata, sorted from the newest
+        std::vector<libdnf5::rpm::Changelog> changelogs;
         if (filter.first == ChangelogFilterType::UPGRADES) {
             auto & installed = std::get<libdnf5::rpm::PackageQuery>(filter.second);
             // Find the newest changelog on the installed version of the
@@ -77,23 +70,19 @@ void print_changelogs(
             query.filter_name({packages[0].get_name()});
             time_t newest_timestamp = 0;
             for (auto pkg : query) {
-                for (auto & chlog : pkg.get_changelogs()) {
+                for (auto & chlog : pkg.get_changelogs_since(0, 1)) {
                     if (chlog.timestamp > newest_timestamp) {
                         newest_timestamp = chlog.timestamp;
                     }
                 }
             }
-            size_t idx;
-            for (idx = 0; idx < changelogs.size() && changelogs[idx].timestamp > newest_timestamp; ++idx) {
-            }
-            changelogs.erase(changelogs.begin() + static_cast<int>(idx), changelogs.end());
+            changelogs = packages[0].get_changelogs_since(newest_timestamp + 1);
         } else if (filter.first == ChangelogFilterType::COUNT) {
             int32_t count = std::get<int32_t>(filter.second);
             if (count > 0) {
-                if (static_cast<size_t>(count) < changelogs.size()) {
-                    changelogs.erase(changelogs.begin() + count, changelogs.end());
-                }
+                changelogs = packages[0].get_changelogs_since(0, static_cast<size_t>(count));
             } else {
+                changelogs = packages[0].get_changelogs_since(0);
                 if (static_cast<size_t>(-count) < changelogs.size()) {
                     changelogs.erase(changelogs.end() + count, changelogs.end());
                 } else {
@@ -101,11 +90,9 @@ void print_changelogs(
                 }
             }
         } else if (filter.first == ChangelogFilterType::SINCE) {
-            int64_t since = std::get<int64_t>(filter.second);
-            size_t idx;
-            for (idx = 0; idx < changelogs.size() && changelogs[idx].timestamp >= since; ++idx) {
-            }
-            changelogs.erase(changelogs.begin() + static_cast<int>(idx), changelogs.end());
+            changelogs = packages[0].get_changelogs_since(static_cast<time_t>(std::get<int64_t>(filter.second)));
+        } else {
+            changelogs = packages[0].get_changelogs_since(0);
         }
 
         for (auto & chlog : changelogs) {
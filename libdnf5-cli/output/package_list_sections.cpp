@@ -31,6 +31,28 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 namespace libdnf5::cli::output {
 
+namespace {
+
+// The same ordering as libdnf5::rpm::cmp_nevra(), but the names and arches are compared through views
+// of the pool strings. The allocating evrcmp() is needed only for different versions of the same name.
+bool cmp_package_nevra(const libdnf5::rpm::Package & lhs, const libdnf5::rpm::Package & rhs) {
+    int r = lhs.get_name_view().compare(rhs.get_name_view());
+    if (r != 0) {
+        return r < 0;
+    }
+
+    if (lhs.get_evr_view() != rhs.get_evr_view()) {
+        r = libdnf5::rpm::evrcmp(lhs, rhs);
+        if (r != 0) {
+            return r < 0;
+        }
+    }
+
+    return lhs.get_arch_view() < rhs.get_arch_view();
+}
+
+}  // namespace
+
 PackageListSections::PackageListSections() {
     table = scols_new_table();
     scols_table_enable_noheadings(table, 1);
@@ -82,10 +104,11 @@ bool PackageListSections::add_section(
     if (!pkg_set.empty()) {
         // sort the packages in section according to NEVRA
         std::vector<libdnf5::rpm::Package> packages;
+        packages.reserve(pkg_set.size());
         for (const auto & pkg : pkg_set) {
             packages.emplace_back(std::move(pkg));
         }
-        std::sort(packages.begin(), packages.end(), libdnf5::rpm::cmp_nevra<libdnf5::rpm::Package>);
+        std::sort(packages.begin(), packages.end(), cmp_package_nevra);
 
         struct libscols_line * first_line = nullptr;
         struct libscols_line * last_line = nullptr;
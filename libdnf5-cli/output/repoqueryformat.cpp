@@ -18,20 +18,27 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 
-#include "fmt/args.h"
 #include "utils/string.hpp"
 
+#include "libdnf5-cli/argument_parser.hpp"
 #include "libdnf5-cli/output/repoquery.hpp"
 
 #include <libdnf5/common/exception.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <set>
+#include <string_view>
 #include <variant>
 
 namespace libdnf5::cli::output {
 
 using StrGetter = std::string (libdnf5::rpm::Package::*)() const;
+using StrViewGetter = std::string_view (libdnf5::rpm::Package::*)() const;
 using VecStrGetter = std::vector<std::string> (libdnf5::rpm::Package::*)() const;
 using UnsignedLongLongGetter = unsigned long long (libdnf5::rpm::Package::*)() const;
 using ReldepListGetter = libdnf5::rpm::ReldepList (libdnf5::rpm::Package::*)() const;
@@ -40,6 +47,7 @@ using StrGetterLambda = std::function<std::string(const libdnf5::rpm::Package &)
 
 using Getter = std::variant<
     StrGetter,
+    StrViewGetter,
     VecStrGetter,
     UnsignedLongLongGetter,
     ReldepListGetter,
@@ -47,12 +55,12 @@ using Getter = std::variant<
     StrGetterLambda>;
 
 static const std::unordered_map<std::string, Getter> NAME_TO_GETTER = {
-    {"name", &libdnf5::rpm::Package::get_name},
+    {"name", &libdnf5::rpm::Package::get_name_view},
     {"epoch", &libdnf5::rpm::Package::get_epoch},
     {"version", &libdnf5::rpm::Package::get_version},
     {"release", &libdnf5::rpm::Package::get_release},
-    {"arch", &libdnf5::rpm::Package::get_arch},
-    {"evr", &libdnf5::rpm::Package::get_evr},
+    {"arch", &libdnf5::rpm::Package::get_arch_view},
+    {"evr", &libdnf5::rpm::Package::get_evr_view},
     {"full_nevra", &libdnf5::rpm::Package::get_full_nevra},
     {"group", &libdnf5::rpm::Package::get_group},
     {"downloadsize", &libdnf5::rpm::Package::get_download_size},
@@ -106,69 +114,52 @@ void print_available_pkg_attrs(std::FILE * target) {
     }
 }
 
-// Argument format contains partially copied and converted queryformat, for example: "name: %-30{{name".
-// We know the tag "name" is valid so this function check align spec "-30" and if it is valid
-// it overwrites the format with fmt formatting: "name: {:<30}".
-static bool replace_tag_in_format(
-    std::string & format,
-    std::string::size_type & format_size,
-    std::string::size_type tag_start,
-    std::string::size_type tag_name_start) {
-    std::string align_spec;
-    // Check if there is valid align spec between '%' and '{' -> ..%-30{...
-    if (tag_start + 1 != tag_name_start) {
-        align_spec = format.substr(tag_start + 1, tag_name_start - tag_start - 1);
-        auto iter = align_spec.begin();
-        // first char can be either a digit or '-' sign
-        if ((*iter != '-') && (std::isdigit(*iter) == 0)) {
-            return false;
-        }
-        // verify the rest is only digits
-        ++iter;
-        while (iter != align_spec.end() && (std::isdigit(*iter) != 0)) {
-            ++iter;
-        }
-        if (iter != align_spec.end()) {
-            return false;
-        }
-    }
-
-    // Since we use positional args for fmt::vprint we have to remove the tag name.
-    // We do this by overwriting the previously copied tag.
-    format_size = tag_start;
-    format[format_size] = '{';
-    format_size++;
+namespace {
 
-    if (!align_spec.empty()) {
-        format[format_size] = ':';
-        format_size++;
+// One compiled piece of a queryformat: a literal text followed by an optional tag.
+struct QueryFormatSegment {
+    std::string literal;
+    std::optional<Getter> getter;
+    // Alignment of the tag value: '<' (left), '>' (right) or 0 (no padding).
+    char align{0};
+    std::size_t width{0};
+};
 
-        auto iter = align_spec.begin();
-        if (*iter == '-') {
-            format[format_size] = '<';
-            iter++;  //skip the sign
-        } else {
-            format[format_size] = '>';
-        }
-        format_size++;
-        while (iter != align_spec.end()) {
-            format[format_size] = *iter;
-            format_size++;
-            ++iter;
+// Checks the align spec between '%' and '{' of a tag, for example "-30" in "%-30{name}".
+// If it is valid, it stores it into the segment as the fmt alignment and width.
+bool parse_align_spec(std::string_view align_spec, QueryFormatSegment & segment) {
+    if (align_spec.empty()) {
+        return true;
+    }
+    // first char can be either a digit or '-' sign
+    char align = '>';
+    if (align_spec.front() == '-') {
+        align = '<';
+        align_spec.remove_prefix(1);
+    } else if (std::isdigit(align_spec.front()) == 0) {
+        return false;
+    }
+    // verify the rest is only digits
+    std::size_t width = 0;
+    for (char c : align_spec) {
+        if (std::isdigit(c) == 0) {
+            return false;
         }
+        width = width * 10 + static_cast<std::size_t>(c - '0');
     }
-
-    format[format_size] = '}';
-    format_size++;
+    segment.align = align;
+    segment.width = width;
     return true;
 }
 
-std::pair<std::vector<Getter>, std::string> parse_queryformat(const std::string & queryformat) {
-    std::vector<Getter> getters;
-    std::string format;
-    // format max possible len is 2 * queryformat.size() (if it contained just curly braces)
-    format.resize(2 * queryformat.size());
-    std::string::size_type format_size = 0;
+// Compiles the queryformat into a list of segments. We try to match rpm query formatting.
+// For example: "%-30{name}: %{evr}\n" is compiled into two segments, the first one is an empty literal followed
+// by the get_name() getter left aligned to 30 characters, the second one is the ": " literal followed by
+// the get_evr() getter, and a trailing literal "\n" without a getter.
+// Unknown tags and tags with invalid align spec are kept as literals.
+std::vector<QueryFormatSegment> parse_queryformat(const std::string & queryformat) {
+    std::vector<QueryFormatSegment> segments;
+    std::string literal;
     std::string::size_type tag_start = 0;
     std::string::size_type tag_name_start = 0;
     char previous_qf_char = 0;
@@ -176,59 +167,158 @@ std::pair<std::vector<Getter>, std::string> parse_queryformat(const std::string
     enum State { OUTSIDE, IN_TAG, IN_TAG_NAME };
     State state = OUTSIDE;
 
-    // Prepare format string and getters.
-    // We try to match rpm query formatting.
-    // For example: "%-30{name}%{evr}" needs to be converted to "{:<30}{}" that is
-    // two positional fmt arguments (first one with align formatting) and we need
-    // get_name() and get_evr() getters.
     for (char qf_char : queryformat) {
         if (qf_char == '%') {  // start of tag
             state = IN_TAG;
-            tag_start = format_size;
+            tag_start = literal.size();
         } else if (qf_char == '{' && state == IN_TAG) {  // start of tag name
             state = IN_TAG_NAME;
-            tag_name_start = format_size;
+            tag_name_start = literal.size();
         } else if (qf_char == '}' && state == IN_TAG_NAME) {  // end of tag
             state = OUTSIDE;
-            // To get the name we add/subtract 2 becasue each tag name (after brace expansion) starts with "{{".
-            auto getter_name = format.substr(tag_name_start + 2, format_size - tag_name_start - 2);
+            auto getter_name = literal.substr(tag_name_start + 1);
             auto getter = NAME_TO_GETTER.find(libdnf5::utils::string::tolower(getter_name));
             if (getter != NAME_TO_GETTER.end()) {
-                if (replace_tag_in_format(format, format_size, tag_start, tag_name_start)) {
-                    getters.push_back(getter->second);
+                QueryFormatSegment segment;
+                std::string_view align_spec(literal);
+                align_spec = align_spec.substr(tag_start + 1, tag_name_start - tag_start - 1);
+                if (parse_align_spec(align_spec, segment)) {
+                    // The tag is replaced by the getter, remove its copied text from the literal.
+                    literal.resize(tag_start);
+                    segment.literal = std::move(literal);
+                    segment.getter = getter->second;
+                    segments.push_back(std::move(segment));
+                    literal.clear();
                     continue;  // continue to skip adding the current qf_char ('}')
                 }
             }
         }
 
-        // Copy each char of queryformat to format string with required changes.
-        if (qf_char == '{' || qf_char == '}') {
-            // double the brace -> escaping for fmt
-            format[format_size] = qf_char;
-            format_size++;
-            format[format_size] = qf_char;
-            format_size++;
-        } else if (previous_qf_char == '\\' && qf_char == 'n') {
+        if (previous_qf_char == '\\' && qf_char == 'n' && !literal.empty()) {
             // replace new lines, two characters in input: '\' 'n' -> '\n'
-            format[format_size - 1] = '\n';  //replace the previous '\'
+            literal.back() = '\n';  //replace the previous '\'
         } else {
-            format[format_size] = qf_char;
-            format_size++;
+            literal.push_back(qf_char);
         }
 
         previous_qf_char = qf_char;
     }
 
-    // Resize the format to resulting size to trim excess characters.
-    format.resize(format_size);
+    if (!literal.empty()) {
+        segments.push_back({std::move(literal), std::nullopt, 0, 0});
+    }
+
+    return segments;
+}
 
-    return {getters, format};
+// Appends the value of the getter for the package to the output.
+void append_getter_value(std::string & output, const Getter & getter, const libdnf5::rpm::Package & package) {
+    std::visit(
+        [&output, &package](const auto & getter_func) {
+            using T = std::decay_t<decltype(getter_func)>;
+            if constexpr (std::is_same_v<T, ReldepListGetter>) {
+                for (const auto & reldep : (package.*getter_func)()) {
+                    output.append(reldep.to_string());
+                    output.push_back('\n');
+                }
+            } else if constexpr (std::is_same_v<T, VecStrGetter>) {
+                for (const auto & str : (package.*getter_func)()) {
+                    output.append(str);
+                    output.push_back('\n');
+                }
+            } else if constexpr (std::is_same_v<T, UnsignedLongLongGetter>) {
+                fmt::format_to(std::back_inserter(output), "{}", (package.*getter_func)());
+            } else if constexpr (std::is_same_v<T, TransactionItemReasonGetter>) {
+                output.append(transaction_item_reason_to_string((package.*getter_func)()));
+            } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
+                output.append((getter_func)(package));
+            } else {
+                output.append((package.*getter_func)());
+            }
+        },
+        getter);
+}
+
+// Appends the text as a JSON string.
+void append_json_string(std::string & output, std::string_view text) {
+    output.push_back('"');
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                output.append("\\\"");
+                break;
+            case '\\':
+                output.append("\\\\");
+                break;
+            case '\n':
+                output.append("\\n");
+                break;
+            case '\r':
+                output.append("\\r");
+                break;
+            case '\t':
+                output.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    fmt::format_to(std::back_inserter(output), "\\u{:04x}", static_cast<unsigned char>(c));
+                } else {
+                    output.push_back(c);
+                }
+        }
+    }
+    output.push_back('"');
 }
 
+// Appends the value of the getter for the package to the output as a JSON value.
+// Numbers are JSON numbers, lists are JSON arrays of strings, everything else is a JSON string.
+void append_getter_json_value(std::string & output, const Getter & getter, const libdnf5::rpm::Package & package) {
+    std::visit(
+        [&output, &package](const auto & getter_func) {
+            using T = std::decay_t<decltype(getter_func)>;
+            if constexpr (std::is_same_v<T, ReldepListGetter>) {
+                output.push_back('[');
+                bool first = true;
+                for (const auto & reldep : (package.*getter_func)()) {
+                    if (!first) {
+                        output.push_back(',');
+                    }
+                    append_json_string(output, reldep.to_string());
+                    first = false;
+                }
+                output.push_back(']');
+            } else if constexpr (std::is_same_v<T, VecStrGetter>) {
+                output.push_back('[');
+                bool first = true;
+                for (const auto & str : (package.*getter_func)()) {
+                    if (!first) {
+                        output.push_back(',');
+                    }
+                    append_json_string(output, str);
+                    first = false;
+                }
+                output.push_back(']');
+            } else if constexpr (std::is_same_v<T, UnsignedLongLongGetter>) {
+                fmt::format_to(std::back_inserter(output), "{}", (package.*getter_func)());
+            } else if constexpr (std::is_same_v<T, TransactionItemReasonGetter>) {
+                append_json_string(output, transaction_item_reason_to_string((package.*getter_func)()));
+            } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
+                append_json_string(output, (getter_func)(package));
+            } else {
+                append_json_string(output, (package.*getter_func)());
+            }
+        },
+        getter);
+}
+
+}  // namespace
+
 bool requires_filelists(const std::string & queryformat) {
-    auto [getters, _] = parse_queryformat(queryformat);
-    for (auto getter : getters) {
-        auto * getter_pointer = std::get_if<VecStrGetter>(&getter);
+    for (const auto & segment : parse_queryformat(queryformat)) {
+        if (!segment.getter) {
+            continue;
+        }
+        auto * getter_pointer = std::get_if<VecStrGetter>(&*segment.getter);
         if (getter_pointer && (*getter_pointer == &libdnf5::rpm::Package::get_files)) {
             return true;
         }
@@ -239,48 +329,75 @@ bool requires_filelists(const std::string & queryformat) {
 
 void print_pkg_set_with_format(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat) {
-    auto [getters, format] = parse_queryformat(queryformat);
-
-    std::set<std::string> output;
-    // Format and print each package.
-    fmt::dynamic_format_arg_store<fmt::format_context> arg_store;
-    arg_store.reserve(getters.size(), getters.size());
+    // The queryformat is compiled once, each package is then formatted just by appending the literals and the values
+    // of the getters to a line. Only the padded values go through fmt.
+    const auto segments = parse_queryformat(queryformat);
+
+    std::vector<std::string> output;
+    output.reserve(pkgs.size());
+    std::string line;
+    std::string value;
     for (auto package : pkgs) {
-        arg_store.clear();
-        for (const auto & getter : getters) {
-            std::visit(
-                [&arg_store, &package](const auto & getter_func) {
-                    using T = std::decay_t<decltype(getter_func)>;
-                    if constexpr (std::is_same_v<T, ReldepListGetter>) {
-                        std::string joined;
-                        for (const auto & reldep : (package.*getter_func)()) {
-                            joined.append(std::move(reldep.to_string()));
-                            joined.push_back('\n');
-                        }
-                        arg_store.push_back(joined);
-                    } else if constexpr (std::is_same_v<T, VecStrGetter>) {
-                        std::string joined;
-                        for (const auto & str : (package.*getter_func)()) {
-                            joined.append(std::move(str));
-                            joined.push_back('\n');
-                        }
-                        arg_store.push_back(joined);
-                    } else if constexpr (std::is_same_v<T, TransactionItemReasonGetter>) {
-                        arg_store.push_back(std::move(transaction_item_reason_to_string((package.*getter_func)())));
-                    } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
-                        arg_store.push_back((getter_func)(package));
-                    } else {
-                        arg_store.push_back((package.*getter_func)());
-                    }
-                },
-                getter);
+        line.clear();
+        for (const auto & segment : segments) {
+            line.append(segment.literal);
+            if (!segment.getter) {
+                continue;
+            }
+            if (segment.align == 0) {
+                append_getter_value(line, *segment.getter, package);
+                continue;
+            }
+            value.clear();
+            append_getter_value(value, *segment.getter, package);
+            if (segment.align == '<') {
+                fmt::format_to(std::back_inserter(line), "{:<{}}", value, segment.width);
+            } else {
+                fmt::format_to(std::back_inserter(line), "{:>{}}", value, segment.width);
+            }
         }
-
-        output.insert(fmt::vformat(format, arg_store));
+        output.push_back(line);
     }
 
+    // The lines are printed sorted and without duplicates.
+    std::sort(output.begin(), output.end());
+    output.erase(std::unique(output.begin(), output.end()), output.end());
+
     for (const auto & line : output) {
-        fmt::print(target, "{}", line);
+        std::fwrite(line.data(), 1, line.size(), target);
+    }
+}
+
+void print_pkg_set_as_json(
+    std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::vector<std::string> & pkg_attrs) {
+    // Look up the getters and prepare the JSON keys just once.
+    std::vector<std::pair<std::string, const Getter *>> members;
+    for (const auto & pkg_attr : pkg_attrs) {
+        auto getter = NAME_TO_GETTER.find(pkg_attr);
+        if (getter == NAME_TO_GETTER.end()) {
+            throw libdnf5::cli::ArgumentParserInvalidValueError(
+                M_("Unknown package attribute \"{}\". Use --querytags to list the available ones."), pkg_attr);
+        }
+        std::string key;
+        append_json_string(key, pkg_attr);
+        key.push_back(':');
+        members.emplace_back(std::move(key), &getter->second);
+    }
+
+    // Each package is printed as soon as it is formatted, one JSON object per line.
+    std::string line;
+    for (auto package : pkgs) {
+        line.clear();
+        line.push_back('{');
+        for (std::size_t idx = 0; idx < members.size(); ++idx) {
+            if (idx > 0) {
+                line.push_back(',');
+            }
+            line.append(members[idx].first);
+            append_getter_json_value(line, *members[idx].second, package);
+        }
+        line.append("}\n");
+        std::fwrite(line.data(), 1, line.size(), target);
     }
 }
 
@@ -307,6 +424,8 @@ void print_pkg_attr_uniq_sorted(
                     for (const auto & str : (package.*getter_func)()) {
                         output.insert(std::move(str));
                     }
+                } else if constexpr (std::is_same_v<T, StrViewGetter>) {
+                    output.emplace((package.*getter_func)());
                 } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
                     output.insert(std::move((getter_func)(package)));
                 } else {
@@ -21,13 +21,14 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5-cli/output/search.hpp"
 
 #include "libdnf5-cli/tty.hpp"
+#include "utils/string.hpp"
 
 #include <libdnf5/utils/patterns.hpp>
 
 #include <algorithm>
 #include <iostream>
 #include <numeric>
-#include <regex>
+#include <sstream>
 
 namespace libdnf5::cli::output {
 
@@ -53,25 +54,68 @@ static std::string construct_keys_string(const std::vector<matched_key_pair> & k
     return std::accumulate(key_pairs.begin(), key_pairs.end(), std::string{}, concat_keys);
 }
 
-/// Auxilliary method for aggregating a pattern matching expression into a string.
-static std::string concat_patterns(const std::string & acc, const std::string & pattern) {
-    return acc.empty() ? pattern : acc + "|" + pattern;
+/// Prepare the patterns for highlighting. Glob patterns are skipped from highlighting for now,
+/// the rest is lowercased for case-insensitive matching.
+static std::vector<std::string> construct_highlight_patterns(std::vector<std::string> patterns) {
+    std::erase_if(patterns, [](const auto & pattern) {
+        return pattern.empty() || libdnf5::utils::is_glob_pattern(pattern.c_str());
+    });
+    for (auto & pattern : patterns) {
+        pattern = libdnf5::utils::string::tolower(pattern);
+    }
+    return patterns;
 }
 
-/// Construct a regular expression for matching all occurrences of any given pattern in the text.
-static std::regex construct_patterns_regex(std::vector<std::string> patterns) {
-    // Glob patterns are skipped from highlighting for now.
-    std::erase_if(patterns, [](const auto & pattern) { return libdnf5::utils::is_glob_pattern(pattern.c_str()); });
-    auto inner_patterns_regex_str = std::accumulate(patterns.begin(), patterns.end(), std::string{}, concat_patterns);
-    return std::regex("(" + inner_patterns_regex_str + ")", std::regex_constants::icase);
+/// Wrap all occurrences of any given pattern in the text with green highlighting markup.
+/// The patterns are matched as literal strings, overlapping and adjacent occurrences are highlighted together.
+static std::string highlight_patterns(
+    const std::string & text,
+    const std::vector<std::string> & patterns,
+    const std::string & highlight_start,
+    const std::string & highlight_end) {
+    if (patterns.empty()) {
+        return text;
+    }
+
+    const auto lower_text = libdnf5::utils::string::tolower(text);
+    std::vector<bool> highlighted(text.size(), false);
+    bool found = false;
+    for (const auto & pattern : patterns) {
+        for (auto pos = lower_text.find(pattern); pos != std::string::npos; pos = lower_text.find(pattern, pos + 1)) {
+            std::fill_n(highlighted.begin() + static_cast<std::ptrdiff_t>(pos), pattern.size(), true);
+            found = true;
+        }
+    }
+    if (!found) {
+        return text;
+    }
+
+    std::string result;
+    result.reserve(text.size() + 2 * (highlight_start.size() + highlight_end.size()));
+    for (std::size_t begin = 0; begin < text.size();) {
+        auto end = begin;
+        while (end < text.size() && highlighted[end] == highlighted[begin]) {
+            ++end;
+        }
+        if (highlighted[begin]) {
+            result.append(highlight_start);
+            result.append(text, begin, end - begin);
+            result.append(highlight_end);
+        } else {
+            result.append(text, begin, end - begin);
+        }
+        begin = end;
+    }
+    return result;
 }
 
-/// Construct a highlighting regex replacement format string.
-/// In the end this is just wrapping all matched patterns with green highlighting markup.
-static std::string construct_highlight_regex_format() {
-    std::stringstream replace_format;
-    replace_format << green << "$1" << reset;
-    return replace_format.str();
+/// Construct the markup that starts and ends highlighting of a matched pattern.
+static std::pair<std::string, std::string> construct_highlight_markup() {
+    std::stringstream highlight_start;
+    highlight_start << green;
+    std::stringstream highlight_end;
+    highlight_end << reset;
+    return {highlight_start.str(), highlight_end.str()};
 }
 
 void print_search_results(const SearchResults & results) {
@@ -80,10 +124,10 @@ void print_search_results(const SearchResults & results) {
         return;
     }
 
-    auto patterns_regex = construct_patterns_regex(results.patterns);
-    auto highlight_regex_format = construct_highlight_regex_format();
-    auto highlight = [&](auto const & text) {
-        return std::regex_replace(text, patterns_regex, highlight_regex_format);
+    const auto patterns = construct_highlight_patterns(results.patterns);
+    const auto [highlight_start, highlight_end] = construct_highlight_markup();
+    auto highlight = [&](const std::string & text) {
+        return highlight_patterns(text, patterns, highlight_start, highlight_end);
     };
 
     for (auto const & result : results.group_results) {
@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utf8.hpp"
 
 #include <clocale>
+#include <cstdint>
 #include <cstring>
 #include <cwchar>
 
@@ -28,16 +29,47 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 namespace libdnf5::cli::utils::utf8 {
 
 
+static bool is_printable_ascii(char ch) {
+    return ch >= 0x20 && ch < 0x7f;
+}
+
+
+/// return number of leading printable ascii characters; each of them has length and width 1
+/// most of the package data are ascii, the string is checked 8 bytes at once instead of decoding characters
+static std::size_t printable_ascii_prefix(const std::string & str) {
+    constexpr std::uint64_t ONES = 0x0101010101010101ULL;
+    constexpr std::uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+    std::size_t pos = 0;
+    for (; pos + sizeof(std::uint64_t) <= str.size(); pos += sizeof(std::uint64_t)) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, str.data() + pos, sizeof(chunk));
+        // a byte is not printable ascii if it has the high bit set, is lower than 0x20 or equals 0x7f
+        auto non_ascii = chunk & HIGH_BITS;
+        auto control = (chunk - 0x20 * ONES) & ~chunk & HIGH_BITS;
+        auto not_del = chunk ^ (0x7f * ONES);
+        auto del = (not_del - ONES) & ~not_del & HIGH_BITS;
+        if ((non_ascii | control | del) != 0) {
+            break;
+        }
+    }
+    while (pos < str.size() && is_printable_ascii(str[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+
 /// return length of an utf-8 encoded string
 std::size_t length(const std::string & str) {
-    std::size_t result = 0;
+    std::size_t result = printable_ascii_prefix(str);
 
-    if (str.empty()) {
+    if (result == str.size()) {
         return result;
     }
 
-    // pointers to the current position (defaults to begin) and the end of the input string
-    auto ptr = &str.front();
+    // pointers to the current position (defaults to the first non-ascii character) and the end of the input string
+    auto ptr = &str.front() + result;
     auto end = &str.back();
 
     // multi-byte string state; required by mbrtowc()
@@ -69,14 +101,14 @@ std::size_t length(const std::string & str) {
 
 /// return printable width of an utf-8 encoded string (considers non-printable and wide characters)
 std::size_t width(const std::string & str) {
-    std::size_t result = 0;
+    std::size_t result = printable_ascii_prefix(str);
 
-    if (str.empty()) {
+    if (result == str.size()) {
         return result;
     }
 
-    // pointers to the current position (defaults to begin) and the end of the input string
-    auto ptr = &str.front();
+    // pointers to the current position (defaults to the first non-ascii character) and the end of the input string
+    auto ptr = &str.front() + result;
     auto end = &str.back();
 
     // multi-byte string state; required by mbrtowc()
@@ -115,6 +147,11 @@ std::string substr_length(const std::string & str, std::string::size_type pos, s
         return result;
     }
 
+    // characters of a printable ascii string are single bytes
+    if (printable_ascii_prefix(str) == str.size()) {
+        return pos < str.size() ? str.substr(pos, len) : result;
+    }
+
     // pointers to the current position (defaults to begin) and the end of the input string
     auto ptr = &str.front();
     auto end = &str.back();
@@ -167,6 +204,11 @@ std::string substr_width(const std::string & str, std::string::size_type pos, st
         return result;
     }
 
+    // characters of a printable ascii string are single bytes of width 1
+    if (printable_ascii_prefix(str) == str.size()) {
+        return pos < str.size() ? str.substr(pos, wid) : result;
+    }
+
     // pointers to the current position (defaults to begin) and the end of the input string
     auto ptr = &str.front();
     auto end = &str.back();
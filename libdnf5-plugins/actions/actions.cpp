@@ -23,16 +23,22 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/common/exception.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
+#include <libdnf5/utils/fs/temp.hpp>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -41,7 +47,7 @@ using namespace libdnf5;
 namespace {
 
 constexpr const char * PLUGIN_NAME = "actions";
-constexpr plugin::Version PLUGIN_VERSION{0, 3, 0};
+constexpr plugin::Version PLUGIN_VERSION{0, 4, 0};
 
 constexpr const char * attrs[]{"author.name", "author.email", "description", nullptr};
 constexpr const char * attrs_value[]{"Jaroslav Rohel", "jrohel@redhat.com", "Actions Plugin."};
@@ -52,6 +58,7 @@ struct Action {
     int line_number;
     std::string pkg_filter;
     enum class Direction { IN, OUT, ALL } direction;
+    enum class Mode { SEQUENTIAL, PARALLEL, BATCH } mode{Mode::SEQUENTIAL};
     std::string command;
     std::vector<std::string> args;
 };
@@ -65,6 +72,17 @@ struct CommandToRun {
 };
 
 
+enum class Hooks { PRE_BASE_SETUP, POST_BASE_SETUP, PRE_TRANS, POST_TRANS };
+
+
+// Cached result of parsing an actions file
+struct ParsedActionsFile {
+    bool valid{false};
+    std::filesystem::file_time_type mtime;
+    std::vector<std::pair<Hooks, Action>> actions;
+};
+
+
 class Actions : public plugin::IPlugin {
 public:
     Actions(libdnf5::Base & base, libdnf5::ConfigParser &) : IPlugin(base) {}
@@ -105,7 +123,9 @@ private:
     void parse_action_files();
     void on_base_setup(const std::vector<Action> & trans_actions);
     void on_transaction(const libdnf5::base::Transaction & transaction, const std::vector<Action> & trans_actions);
-    void execute_command(CommandToRun & command);
+    void execute_command(CommandToRun & command, int stdin_fd = -1);
+    void execute_commands_parallel(std::vector<CommandToRun> & commands);
+    pid_t start_command(CommandToRun & command, int stdin_fd, int & stdout_fd);
 
     [[nodiscard]] std::pair<std::string, bool> substitute(
         const libdnf5::base::TransactionPackage * trans_pkg,
@@ -118,6 +138,7 @@ private:
         const libdnf5::base::TransactionPackage * trans_pkg, const libdnf5::rpm::Package * pkg, const Action & action);
 
     void process_command_output_line(std::string_view line);
+    void process_command_output(std::string_view output);
 
     // Parsed actions for individual hooks
     std::vector<Action> pre_base_setup_actions;
@@ -364,6 +385,170 @@ void Actions::on_base_setup(const std::vector<Action> & trans_actions) {
     }
 }
 
+// Parses one actions file. The actions that are not enabled for the current `installroot` are skipped.
+std::vector<std::pair<Hooks, Action>> parse_action_file(const std::filesystem::path & path, bool installroot) {
+    std::vector<std::pair<Hooks, Action>> actions;
+    std::ifstream action_file(path);
+    std::string line;
+    int line_number = 0;
+    while (std::getline(action_file, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto pkg_filter_pos = line.find(':');
+        if (pkg_filter_pos == std::string::npos) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
+                path.native(),
+                line_number);
+        }
+        ++pkg_filter_pos;
+        auto direction_pos = line.find(':', pkg_filter_pos);
+        if (direction_pos == std::string::npos) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
+                path.native(),
+                line_number);
+        }
+        ++direction_pos;
+        auto options_pos = line.find(':', direction_pos);
+        if (options_pos == std::string::npos) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
+                path.native(),
+                line_number);
+        }
+        ++options_pos;
+        auto command_pos = line.find(':', options_pos);
+        if (command_pos == std::string::npos) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
+                path.native(),
+                line_number);
+        }
+        ++command_pos;
+
+        bool action_enabled{true};
+        auto mode = Action::Mode::SEQUENTIAL;
+        auto options_str = line.substr(options_pos, command_pos - options_pos - 1);
+        const auto options = split(options_str);
+        for (const auto & opt : options) {
+            if (opt.starts_with("enabled=")) {
+                const auto value = opt.substr(8);
+                if (value == "1") {
+                    action_enabled = true;
+                } else if (value == "host-only") {
+                    action_enabled = !installroot;
+                } else if (value == "installroot-only") {
+                    action_enabled = installroot;
+                } else {
+                    throw ActionsPluginError(
+                        M_("Error in file \"{}\" on line {}: Unknown \"enabled\" option value \"{}\""),
+                        path.native(),
+                        line_number,
+                        value);
+                }
+            } else if (opt.starts_with("mode=")) {
+                const auto value = opt.substr(5);
+                if (value == "sequential") {
+                    mode = Action::Mode::SEQUENTIAL;
+                } else if (value == "parallel") {
+                    mode = Action::Mode::PARALLEL;
+                } else if (value == "batch") {
+                    mode = Action::Mode::BATCH;
+                } else {
+                    throw ActionsPluginError(
+                        M_("Error in file \"{}\" on line {}: Unknown \"mode\" option value \"{}\""),
+                        path.native(),
+                        line_number,
+                        value);
+                }
+            } else {
+                throw ActionsPluginError(
+                    M_("Error in file \"{}\" on line {}: Unknown option \"{}\""), path.native(), line_number, opt);
+            }
+        }
+        if (!action_enabled) {
+            continue;
+        }
+
+        Hooks hook;
+        if (line.starts_with("pre_base_setup:")) {
+            hook = Hooks::PRE_BASE_SETUP;
+        } else if (line.starts_with("post_base_setup:")) {
+            hook = Hooks::POST_BASE_SETUP;
+        } else if (line.starts_with("pre_transaction:")) {
+            hook = Hooks::PRE_TRANS;
+        } else if (line.starts_with("post_transaction:")) {
+            hook = Hooks::POST_TRANS;
+        } else {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: Unknown hook \"{}\""),
+                path.native(),
+                line_number,
+                line.substr(0, pkg_filter_pos - 1));
+        }
+
+        auto pkg_filter = line.substr(pkg_filter_pos, direction_pos - pkg_filter_pos - 1);
+        if (hook != Hooks::PRE_TRANS && hook != Hooks::POST_TRANS) {
+            if (!pkg_filter.empty()) {
+                throw ActionsPluginError(
+                    M_("Error in file \"{}\" on line {}: Package filter can only be used in PRE_TRANS and "
+                       "POST_TRANS hooks"),
+                    path.native(),
+                    line_number);
+            }
+        }
+
+        if (pkg_filter.empty() && mode != Action::Mode::SEQUENTIAL) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: The \"parallel\" and \"batch\" modes can only be used with "
+                   "package filter"),
+                path.native(),
+                line_number);
+        }
+
+        auto direction = line.substr(direction_pos, options_pos - direction_pos - 1);
+        if (pkg_filter.empty() && !direction.empty()) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: Cannot use direction without package filter"),
+                path.native(),
+                line_number);
+        }
+
+        Action act;
+        act.file_path = path;
+        act.line_number = line_number;
+        act.pkg_filter = pkg_filter;
+        act.mode = mode;
+        if (direction == "in") {
+            act.direction = Action::Direction::IN;
+        } else if (direction == "out") {
+            act.direction = Action::Direction::OUT;
+        } else if (direction == "") {
+            act.direction = Action::Direction::ALL;
+        } else {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: Unknown package direction \"{}\""),
+                path.native(),
+                line_number,
+                direction);
+        }
+
+        act.args = split(line.substr(command_pos));
+        if (act.args.empty()) {
+            throw ActionsPluginError(
+                M_("Error in file \"{}\" on line {}: Missing command"), path.native(), line_number);
+        }
+        act.command = act.args[0];
+
+        actions.emplace_back(hook, std::move(act));
+    }
+
+    return actions;
+}
+
 void Actions::parse_action_files() {
     const auto & config = get_base().get_config();
     const char * env_plugins_config_dir = std::getenv("LIBDNF_PLUGINS_CONFIG_DIR");
@@ -371,6 +556,7 @@ void Actions::parse_action_files() {
                                                                          libdnf5::Option::Priority::COMMANDLINE
                                                ? env_plugins_config_dir
                                                : config.get_pluginconfpath_option().get_value();
+    const bool installroot = config.get_installroot_option().get_value() != "/";
 
     auto action_dir_path = std::filesystem::path(plugins_config_dir) / "actions.d";
     std::vector<std::filesystem::path> action_paths;
@@ -382,151 +568,35 @@ void Actions::parse_action_files() {
     }
     std::sort(action_paths.begin(), action_paths.end());
 
-    for (const auto & path : action_paths) {
-        std::ifstream action_file(path);
-        std::string line;
-        int line_number = 0;
-        while (std::getline(action_file, line)) {
-            ++line_number;
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            auto pkg_filter_pos = line.find(':');
-            if (pkg_filter_pos == std::string::npos) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
-                    path.native(),
-                    line_number);
-            }
-            ++pkg_filter_pos;
-            auto direction_pos = line.find(':', pkg_filter_pos);
-            if (direction_pos == std::string::npos) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
-                    path.native(),
-                    line_number);
-            }
-            ++direction_pos;
-            auto options_pos = line.find(':', direction_pos);
-            if (options_pos == std::string::npos) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
-                    path.native(),
-                    line_number);
-            }
-            ++options_pos;
-            auto command_pos = line.find(':', options_pos);
-            if (command_pos == std::string::npos) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: \"HOOK:PKG_FILTER:DIRECTION:OPTIONS:CMD\" format expected"),
-                    path.native(),
-                    line_number);
-            }
-            ++command_pos;
-
-            bool action_enabled{true};
-            auto options_str = line.substr(options_pos, command_pos - options_pos - 1);
-            const auto options = split(options_str);
-            for (const auto & opt : options) {
-                if (opt.starts_with("enabled=")) {
-                    const auto value = opt.substr(8);
-                    auto installroot_path = config.get_installroot_option().get_value();
-                    bool installroot = installroot_path != "/";
-                    if (value == "1") {
-                        action_enabled = true;
-                    } else if (value == "host-only") {
-                        action_enabled = !installroot;
-                    } else if (value == "installroot-only") {
-                        action_enabled = installroot;
-                    } else {
-                        throw ActionsPluginError(
-                            M_("Error in file \"{}\" on line {}: Unknown \"enabled\" option value \"{}\""),
-                            path.native(),
-                            line_number,
-                            value);
-                    }
-                } else {
-                    throw ActionsPluginError(
-                        M_("Error in file \"{}\" on line {}: Unknown option \"{}\""), path.native(), line_number, opt);
-                }
-            }
-            if (!action_enabled) {
-                continue;
-            }
-
-            enum class Hooks { PRE_BASE_SETUP, POST_BASE_SETUP, PRE_TRANS, POST_TRANS } hook;
-            if (line.starts_with("pre_base_setup:")) {
-                hook = Hooks::PRE_BASE_SETUP;
-            } else if (line.starts_with("post_base_setup:")) {
-                hook = Hooks::POST_BASE_SETUP;
-            } else if (line.starts_with("pre_transaction:")) {
-                hook = Hooks::PRE_TRANS;
-            } else if (line.starts_with("post_transaction:")) {
-                hook = Hooks::POST_TRANS;
-            } else {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: Unknown hook \"{}\""),
-                    path.native(),
-                    line_number,
-                    line.substr(0, pkg_filter_pos - 1));
-            }
-
-            auto pkg_filter = line.substr(pkg_filter_pos, direction_pos - pkg_filter_pos - 1);
-            if (hook != Hooks::PRE_TRANS && hook != Hooks::POST_TRANS) {
-                if (!pkg_filter.empty()) {
-                    throw ActionsPluginError(
-                        M_("Error in file \"{}\" on line {}: Package filter can only be used in PRE_TRANS and "
-                           "POST_TRANS hooks"),
-                        path.native(),
-                        line_number);
-                }
-            }
-
-            auto direction = line.substr(direction_pos, options_pos - direction_pos - 1);
-            if (pkg_filter.empty() && !direction.empty()) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: Cannot use direction without package filter"),
-                    path.native(),
-                    line_number);
-            }
-
-            Action act;
-            act.file_path = path;
-            act.line_number = line_number;
-            act.pkg_filter = pkg_filter;
-            if (direction == "in") {
-                act.direction = Action::Direction::IN;
-            } else if (direction == "out") {
-                act.direction = Action::Direction::OUT;
-            } else if (direction == "") {
-                act.direction = Action::Direction::ALL;
-            } else {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: Unknown package direction \"{}\""),
-                    path.native(),
-                    line_number,
-                    direction);
-            }
+    // The parsed files are shared by all instances of the plugin in the process (e.g. by the daemon sessions).
+    // A file is parsed again only if its modification time has changed.
+    static std::mutex parsed_files_mutex;
+    static std::map<std::pair<std::filesystem::path, bool>, ParsedActionsFile> parsed_files;
+    std::lock_guard<std::mutex> lock(parsed_files_mutex);
 
-            act.args = split(line.substr(command_pos));
-            if (act.args.empty()) {
-                throw ActionsPluginError(
-                    M_("Error in file \"{}\" on line {}: Missing command"), path.native(), line_number);
-            }
-            act.command = act.args[0];
+    for (const auto & path : action_paths) {
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        auto & parsed_file = parsed_files[{path, installroot}];
+        if (ec || !parsed_file.valid || parsed_file.mtime != mtime) {
+            parsed_file.valid = false;
+            parsed_file.actions = parse_action_file(path, installroot);
+            parsed_file.mtime = mtime;
+            parsed_file.valid = !ec;
+        }
 
+        for (const auto & [hook, act] : parsed_file.actions) {
             switch (hook) {
                 case Hooks::PRE_BASE_SETUP:
-                    pre_base_setup_actions.emplace_back(std::move(act));
+                    pre_base_setup_actions.push_back(act);
                     break;
                 case Hooks::POST_BASE_SETUP:
-                    post_base_setup_actions.emplace_back(std::move(act));
+                    post_base_setup_actions.push_back(act);
                     break;
                 case Hooks::PRE_TRANS:
-                    pre_trans_actions.emplace_back(std::move(act));
+                    pre_trans_actions.push_back(act);
                     break;
                 case Hooks::POST_TRANS:
-                    post_trans_actions.emplace_back(std::move(act));
+                    post_trans_actions.push_back(act);
             }
         }
     }
@@ -580,21 +650,34 @@ void Actions::process_command_output_line(std::string_view line) {
     }
 }
 
-void Actions::execute_command(CommandToRun & command) {
+void Actions::process_command_output(std::string_view output) {
+    std::size_t line_begin_pos = 0;
+    while (line_begin_pos < output.size()) {
+        auto line_end_pos = output.find('\n', line_begin_pos);
+        if (line_end_pos == std::string::npos) {
+            process_command_output_line(output.substr(line_begin_pos));
+            break;
+        }
+        process_command_output_line(output.substr(line_begin_pos, line_end_pos - line_begin_pos));
+        line_begin_pos = line_end_pos + 1;
+    }
+}
+
+pid_t Actions::start_command(CommandToRun & command, int stdin_fd, int & stdout_fd) {
     auto & base = get_base();
 
     int pipe_out_from_child[2];
     int pipe_to_child[2];
     if (pipe(pipe_to_child) == -1) {
         base.get_logger()->error("Actions plugin: Cannot create pipe: {}", std::strerror(errno));
-        return;
+        return -1;
     }
     if (pipe(pipe_out_from_child) == -1) {
         auto errnum = errno;
         close(pipe_to_child[1]);
         close(pipe_to_child[0]);
         base.get_logger()->error("Actions plugin: Cannot create pipe: {}", std::strerror(errnum));
-        return;
+        return -1;
     }
 
     auto child_pid = fork();
@@ -609,8 +692,8 @@ void Actions::execute_command(CommandToRun & command) {
         close(pipe_to_child[1]);        // close writing end of the pipe on the child side
         close(pipe_out_from_child[0]);  // close reading end of the pipe on the child side
 
-        // bind stdin of the child process to the reading end of the pipe
-        if (dup2(pipe_to_child[0], fileno(stdin)) == -1) {
+        // bind stdin of the child process to the passed file descriptor or to the reading end of the pipe
+        if (dup2(stdin_fd != -1 ? stdin_fd : pipe_to_child[0], fileno(stdin)) == -1) {
             base.get_logger()->error("Actions plugin: Cannot bind command stdin: {}", std::strerror(errno));
             _exit(255);
         }
@@ -645,39 +728,90 @@ void Actions::execute_command(CommandToRun & command) {
         close(pipe_to_child[1]);
 
         close(pipe_out_from_child[1]);
-        char read_buf[256];
-        std::string input;
-        std::size_t num_tested_chars = 0;
-        do {
-            auto len = read(pipe_out_from_child[0], read_buf, sizeof(read_buf));
-            if (len > 0) {
-                std::size_t line_begin_pos = 0;
-                input.append(read_buf, static_cast<std::size_t>(len));
-                std::string_view input_view(input);
-                do {
-                    auto line_end_pos = input_view.find('\n', num_tested_chars);
-                    if (line_end_pos == std::string::npos) {
-                        num_tested_chars = input_view.size();
-                    } else {
-                        process_command_output_line(input_view.substr(line_begin_pos, line_end_pos - line_begin_pos));
-                        num_tested_chars = line_begin_pos = line_end_pos + 1;
-                    }
-                } while (num_tested_chars < input_view.size());
-
-                // shift - erase processed lines from the input buffer
-                input.erase(0, line_begin_pos);
-                num_tested_chars -= line_begin_pos;
-                line_begin_pos = 0;
-            } else {
-                if (!input.empty()) {
-                    process_command_output_line(input);
+        stdout_fd = pipe_out_from_child[0];
+    }
+    return child_pid;
+}
+
+void Actions::execute_command(CommandToRun & command, int stdin_fd) {
+    int stdout_fd;
+    auto child_pid = start_command(command, stdin_fd, stdout_fd);
+    if (child_pid == -1) {
+        return;
+    }
+
+    char read_buf[256];
+    std::string input;
+    std::size_t num_tested_chars = 0;
+    do {
+        auto len = read(stdout_fd, read_buf, sizeof(read_buf));
+        if (len > 0) {
+            std::size_t line_begin_pos = 0;
+            input.append(read_buf, static_cast<std::size_t>(len));
+            std::string_view input_view(input);
+            do {
+                auto line_end_pos = input_view.find('\n', num_tested_chars);
+                if (line_end_pos == std::string::npos) {
+                    num_tested_chars = input_view.size();
+                } else {
+                    process_command_output_line(input_view.substr(line_begin_pos, line_end_pos - line_begin_pos));
+                    num_tested_chars = line_begin_pos = line_end_pos + 1;
                 }
-                break;
+            } while (num_tested_chars < input_view.size());
+
+            // shift - erase processed lines from the input buffer
+            input.erase(0, line_begin_pos);
+            num_tested_chars -= line_begin_pos;
+            line_begin_pos = 0;
+        } else {
+            if (!input.empty()) {
+                process_command_output_line(input);
             }
-        } while (true);
-        close(pipe_out_from_child[0]);
+            break;
+        }
+    } while (true);
+    close(stdout_fd);
+
+    waitpid(child_pid, nullptr, 0);
+}
 
-        waitpid(child_pid, nullptr, 0);
+void Actions::execute_commands_parallel(std::vector<CommandToRun> & commands) {
+    // Up to `max_running` commands run at the same time. The outputs are read and processed in the order
+    // of the commands, so the resulting variables and options are the same as for the sequential execution.
+    // The other running commands are not blocked unless their output fills the pipe buffer.
+    const std::size_t max_running = std::max(1u, std::thread::hardware_concurrency());
+
+    struct RunningCommand {
+        pid_t pid;
+        int stdout_fd;
+    };
+    std::deque<RunningCommand> running;
+    std::size_t next_idx = 0;
+    while (next_idx < commands.size() || !running.empty()) {
+        while (next_idx < commands.size() && running.size() < max_running) {
+            int stdout_fd;
+            if (auto pid = start_command(commands[next_idx], -1, stdout_fd); pid != -1) {
+                running.push_back({pid, stdout_fd});
+            }
+            ++next_idx;
+        }
+        if (running.empty()) {
+            continue;
+        }
+
+        auto [pid, stdout_fd] = running.front();
+        running.pop_front();
+        char read_buf[4096];
+        std::string output;
+        ssize_t len;
+        while ((len = read(stdout_fd, read_buf, sizeof(read_buf))) > 0 || (len == -1 && errno == EINTR)) {
+            if (len > 0) {
+                output.append(read_buf, static_cast<std::size_t>(len));
+            }
+        }
+        close(stdout_fd);
+        waitpid(pid, nullptr, 0);
+        process_command_output(output);
     }
 }
 
@@ -710,6 +844,7 @@ void Actions::on_transaction(
     }
 
     std::set<CommandToRun> unique_commands_to_run;  // std::set is used to detect duplicate commands
+    std::map<std::pair<Action::Direction, std::string>, libdnf5::rpm::PackageQuery> filter_queries;
 
     libdnf5::ResolveSpecSettings spec_settings{
         .ignore_case = false,
@@ -731,10 +866,55 @@ void Actions::on_transaction(
             }
         } else {
             // actions for packages - the action is called for each package that matches the criteria pkg_filter and direction
-            auto query = action.direction == Action::Direction::IN
-                             ? *in_full_query
-                             : (action.direction == Action::Direction::OUT ? *out_full_query : *all_full_query);
-            query.resolve_pkg_spec(action.pkg_filter, spec_settings, false);
+            // the packages matching the same filter are resolved only once for all actions
+            auto query_it = filter_queries.find({action.direction, action.pkg_filter});
+            if (query_it == filter_queries.end()) {
+                auto filter_query = action.direction == Action::Direction::IN
+                                        ? *in_full_query
+                                        : (action.direction == Action::Direction::OUT ? *out_full_query
+                                                                                      : *all_full_query);
+                filter_query.resolve_pkg_spec(action.pkg_filter, spec_settings, false);
+                query_it = filter_queries.emplace(std::make_pair(action.direction, action.pkg_filter), filter_query)
+                               .first;
+            }
+            const auto & query = query_it->second;
+
+            if (action.mode == Action::Mode::BATCH) {
+                // a single command for all matching packages, the packages are passed on its standard input
+                if (query.empty()) {
+                    continue;
+                }
+                auto [substituted_args, subst_error] = substitute_args(nullptr, nullptr, action);
+                if (subst_error) {
+                    continue;
+                }
+                for (auto & arg : substituted_args) {
+                    unescape(arg);
+                }
+                CommandToRun cmd_to_run{action.command, std::move(substituted_args)};
+                if (auto [it, inserted] = unique_commands_to_run.insert(cmd_to_run); !inserted) {
+                    continue;
+                }
+
+                std::string pkgs_list;
+                for (auto pkg : query) {
+                    const auto * trans_pkg = pkg_id_to_trans_pkg.at(pkg.get_id());
+                    pkgs_list += libdnf5::transaction::transaction_item_action_to_letter(trans_pkg->get_action());
+                    pkgs_list += ' ' + pkg.get_full_nevra() + ' ' + pkg.get_repo_id() + '\n';
+                }
+                try {
+                    libdnf5::utils::fs::TempFile pkgs_file("dnf5-actions");
+                    auto & file = pkgs_file.open_as_file("w+");
+                    file.write(pkgs_list);
+                    file.flush();
+                    file.rewind();
+                    execute_command(cmd_to_run, file.get_fd());
+                } catch (const libdnf5::Error & ex) {
+                    get_base().get_logger()->error(
+                        "Actions plugin: Cannot pass packages to command \"{}\": {}", action.command, ex.what());
+                }
+                continue;
+            }
 
             std::vector<CommandToRun> commands_to_run;
             for (auto pkg : query) {
@@ -755,8 +935,12 @@ void Actions::on_transaction(
             }
 
             // execute commands
-            for (auto & cmd : commands_to_run) {
-                execute_command(cmd);
+            if (action.mode == Action::Mode::PARALLEL) {
+                execute_commands_parallel(commands_to_run);
+            } else {
+                for (auto & cmd : commands_to_run) {
+                    execute_command(cmd);
+                }
             }
         }
     }
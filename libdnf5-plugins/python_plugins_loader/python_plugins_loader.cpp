@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <cstring>
 #include <filesystem>
 #include <mutex>
+#include <vector>
 
 using namespace libdnf5;
 
@@ -64,7 +65,8 @@ public:
 
 private:
     void load_plugin_file(const fs::path & file);
-    void load_plugins_from_dir(const fs::path & dir_path);
+    std::vector<fs::path> find_plugin_files(const fs::path & dir_path);
+    void load_plugin_files(const std::vector<fs::path> & file_paths);
 
     static int python_ref_counter;
     bool active{false};
@@ -236,11 +238,12 @@ void PythonPluginLoader::load_plugin_file(const fs::path & file_path) {
 }
 
 
-void PythonPluginLoader::load_plugins_from_dir(const fs::path & dir_path) {
+/// Returns sorted paths to the Python plugin files in the directory
+std::vector<fs::path> PythonPluginLoader::find_plugin_files(const fs::path & dir_path) {
     auto & logger = *get_base().get_logger();
 
     if (dir_path.empty())
-        throw std::runtime_error("PythonPluginLoader::load_from_dir() dir_path cannot be empty");
+        throw std::runtime_error("PythonPluginLoader::find_plugin_files() dir_path cannot be empty");
 
     std::vector<fs::path> lib_names;
     std::error_code ec;
@@ -251,12 +254,18 @@ void PythonPluginLoader::load_plugins_from_dir(const fs::path & dir_path) {
     }
     if (ec) {
         logger.warning("PythonPluginLoader: Cannot read plugins directory \"{}\": {}", dir_path.string(), ec.message());
-        return;
+        return {};
     }
     std::sort(lib_names.begin(), lib_names.end());
+    return lib_names;
+}
+
+
+void PythonPluginLoader::load_plugin_files(const std::vector<fs::path> & file_paths) {
+    auto & logger = *get_base().get_logger();
 
     std::string error_msgs;
-    for (auto & p : lib_names) {
+    for (auto & p : file_paths) {
         try {
             load_plugin_file(p);
         } catch (const std::exception & ex) {
@@ -278,6 +287,12 @@ void PythonPluginLoader::load_plugins() {
     }
     const fs::path path(plugin_dir);
 
+    // Do not start the Python interpreter if there is no plugin to load
+    const auto plugin_files = find_plugin_files(path);
+    if (plugin_files.empty()) {
+        return;
+    }
+
     std::lock_guard<libdnf5::Base> guard(get_base());
 
     if (python_ref_counter == 0) {
@@ -304,13 +319,25 @@ void PythonPluginLoader::load_plugins() {
     if (!path_object) {
         fetch_python_error_to_exception("PyDict_GetItemString(sys_dict, \"path\"): ");
     }
-    UniquePtrPyObject append(PyObject_CallMethod(path_object, "append", "(s)", path.c_str()));
-    if (!append) {
-        fetch_python_error_to_exception(
-            ("PyDict_CallMethod(path_object, \"append\", \"(s)\", " + path.string() + "): ").c_str());
+    // The interpreter is shared by all loader instances (e.g. the dnf5daemon sessions).
+    // Append the directory only once so that sys.path does not grow with every new instance.
+    UniquePtrPyObject path_string(PyUnicode_FromString(path.c_str()));
+    if (!path_string) {
+        fetch_python_error_to_exception("PyUnicode_FromString(): ");
+    }
+    const int path_present = PySequence_Contains(path_object, path_string.get());
+    if (path_present == -1) {
+        fetch_python_error_to_exception("PySequence_Contains(path_object, path_string): ");
+    }
+    if (path_present == 0) {
+        UniquePtrPyObject append(PyObject_CallMethod(path_object, "append", "(s)", path.c_str()));
+        if (!append) {
+            fetch_python_error_to_exception(
+                ("PyDict_CallMethod(path_object, \"append\", \"(s)\", " + path.string() + "): ").c_str());
+        }
     }
 
-    load_plugins_from_dir(path);
+    load_plugin_files(plugin_files);
 }
 
 
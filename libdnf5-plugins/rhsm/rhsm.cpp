@@ -18,12 +18,22 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include <fcntl.h>
+#include <fmt/format.h>
 #include <libdnf5/base/base.hpp>
 #include <libdnf5/common/exception.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <rhsm/rhsm.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 
 using namespace libdnf5;
 
@@ -73,6 +83,67 @@ class RhsmPluginError : public libdnf5::Error {
 };
 
 
+// Files and directories read by librhsm when generating the repository configuration
+constexpr const char * RHSM_INPUT_PATHS[]{
+    "/etc/pki/entitlement", "/etc/pki/product", "/etc/pki/product-default", "/etc/rhsm/rhsm.conf"};
+
+// Name of the file in the system cache directory with the fingerprint of the last generation
+constexpr const char * RHSM_STAMP_FILE_NAME = "rhsm-redhat-repo.stamp";
+
+// The stamp is trusted only for a limited time, because the validity of entitlements changes over time
+// without any change of the certificate files.
+constexpr std::chrono::hours RHSM_STAMP_MAX_AGE{1};
+
+
+// Returns a string that changes when any of the librhsm inputs or the generated repository file changes.
+std::string get_inputs_fingerprint(const std::filesystem::path & repo_file_path) {
+    std::string fingerprint;
+    auto add_path = [&fingerprint](const std::filesystem::path & path) {
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            fingerprint += fmt::format(
+                "{} {} {} {}.{}\n", path.native(), st.st_ino, st.st_size, st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+        } else {
+            fingerprint += path.native() + " -\n";
+        }
+    };
+
+    for (const auto * input_path : RHSM_INPUT_PATHS) {
+        add_path(input_path);
+        std::vector<std::filesystem::path> entries;
+        std::error_code ec;  // The path does not have to exist or it may be a regular file
+        for (const auto & entry : std::filesystem::directory_iterator(input_path, ec)) {
+            entries.push_back(entry.path());
+        }
+        std::sort(entries.begin(), entries.end());
+        for (const auto & entry : entries) {
+            add_path(entry);
+        }
+    }
+    add_path(repo_file_path);
+
+    return fingerprint;
+}
+
+
+// Returns true if the stamp file exists, is fresh, and contains the `fingerprint`.
+bool is_stamp_valid(const std::filesystem::path & stamp_path, const std::string & fingerprint) {
+    std::error_code ec;
+    auto stamp_mtime = std::filesystem::last_write_time(stamp_path, ec);
+    if (ec) {
+        return false;
+    }
+    auto stamp_age = std::filesystem::file_time_type::clock::now() - stamp_mtime;
+    if (stamp_age < std::chrono::seconds(0) || stamp_age > RHSM_STAMP_MAX_AGE) {
+        return false;
+    }
+    std::ifstream stamp_file(stamp_path);
+    std::stringstream buffer;
+    buffer << stamp_file.rdbuf();
+    return stamp_file && buffer.str() == fingerprint;
+}
+
+
 // Resyncs the enrollment with the vendor system. This can change the contents
 // of the repositories configuration files according to the subscription levels.
 void Rhsm::setup_enrollments() {
@@ -97,6 +168,14 @@ void Rhsm::setup_enrollments() {
         throw RhsmPluginError(M_("Missing path to repository configuration directory"));
     }
     g_autofree gchar * repofname = g_build_filename(repo_dirs[0].c_str(), "redhat.repo", NULL);
+
+    // Skip the generation if nothing has changed since the last run
+    const auto stamp_path =
+        std::filesystem::path(config.get_system_cachedir_option().get_value()) / RHSM_STAMP_FILE_NAME;
+    if (is_stamp_valid(stamp_path, get_inputs_fingerprint(repofname))) {
+        return;
+    }
+
     g_autoptr(RHSMContext) rhsm_ctx = rhsm_context_new();
     g_autoptr(GKeyFile) repofile = rhsm_utils_yum_repo_from_context(rhsm_ctx);
 
@@ -136,6 +215,12 @@ void Rhsm::setup_enrollments() {
                 std::string(err->message));
         }
     }
+
+    // Failure to write the stamp is not an error, the repository file is only generated again the next time
+    std::error_code ec;
+    std::filesystem::create_directories(stamp_path.parent_path(), ec);
+    std::ofstream stamp_file(stamp_path, std::ios::trunc);
+    stamp_file << get_inputs_fingerprint(repofname);
 }
 
 }  // namespace
@@ -19,6 +19,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "libdnf5/advisory/advisory.hpp"
 
+#include "advisory_sack.hpp"
+#include "base/base_impl.hpp"
 #include "solv/pool.hpp"
 #include "utils/string.hpp"
 
@@ -29,6 +31,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace libdnf5::advisory {
 
 Advisory::Advisory(const libdnf5::BaseWeakPtr & base, AdvisoryId id) : base(base), id(id) {}
@@ -96,38 +100,44 @@ AdvisoryId Advisory::get_id() const {
 
 std::vector<AdvisoryReference> Advisory::get_references(std::vector<std::string> types) const {
     auto & pool = get_rpm_pool(base);
+    auto advisory_sack = InternalBaseUser::get_rpm_advisory_sack(base);
 
-    std::vector<AdvisoryReference> output;
-
-    Dataiterator di;
-    dataiterator_init(&di, *pool, 0, id.id, UPDATE_REFERENCE, 0, 0);
+    // Compare reference types by pool ids, a type that is not in the pool matches nothing
+    std::vector<Id> type_ids;
+    for (const auto & type : types) {
+        if (Id type_id = pool.str2id(type.c_str(), false)) {
+            type_ids.push_back(type_id);
+        }
+    }
 
-    for (int index = 0; dataiterator_step(&di); index++) {
-        dataiterator_setpos(&di);
-        std::string current_type = std::string(pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_TYPE));
+    std::vector<AdvisoryReference> output;
+    if (!types.empty() && type_ids.empty()) {
+        return output;
+    }
 
-        if (types.empty() || std::find(types.begin(), types.end(), current_type) != types.end()) {
-            output.emplace_back(AdvisoryReference(base, id, index));
+    auto count = advisory_sack->get_references_count(id.id);
+    for (std::size_t index = 0; index < count; ++index) {
+        if (!type_ids.empty()) {
+            Id type = advisory_sack->get_reference(id.id, index).type;
+            if (std::find(type_ids.begin(), type_ids.end(), type) == type_ids.end()) {
+                continue;
+            }
         }
+        output.emplace_back(AdvisoryReference(base, id, static_cast<int>(index)));
     }
 
-    dataiterator_free(&di);
     return output;
 }
 
 std::vector<AdvisoryCollection> Advisory::get_collections() const {
     std::vector<AdvisoryCollection> output;
 
-    Dataiterator di;
-    dataiterator_init(&di, *get_rpm_pool(base), 0, id.id, UPDATE_COLLECTIONLIST, 0, 0);
-
-    for (int index = 0; dataiterator_step(&di); index++) {
-        dataiterator_setpos(&di);
-        output.emplace_back(AdvisoryCollection(base, id, index));
+    auto count = InternalBaseUser::get_rpm_advisory_sack(base)->get_collections_count(id.id);
+    output.reserve(count);
+    for (std::size_t index = 0; index < count; ++index) {
+        output.emplace_back(AdvisoryCollection(base, id, static_cast<int>(index)));
     }
 
-    dataiterator_free(&di);
-
     return output;
 }
 
@@ -108,14 +108,6 @@ public:
         return solvable->evr < adv_pkg.evr;
     }
 
-    /// Check whether this AdvisoryPackage is resolved (meaning there is a counterpart
-    /// package with lower or equal EVR and matching name and arch) in pkgs PackageSet.
-    ///
-    /// @param pkgs             libdnf5::rpm::PackageSet of packages to check
-    ///
-    /// @return true or false whether this AdvisoryPackage is resolved in pkgs
-    bool is_resolved_in(const libdnf5::rpm::PackageSet & pkgs) const;
-
 private:
     friend class AdvisoryCollection;
     friend AdvisoryPackage;
@@ -117,6 +117,9 @@ static void filter_reference_by_type_and_id(
         cmp_type = cmp_type - libdnf5::sack::QueryCmp::NOT;
     }
 
+    // Reference types are stored as pool strings, compare them by id
+    Id type_id = type ? pool.str2id(type->c_str(), false) : 0;
+
     for (auto & pattern : patterns) {
         int flags = libsolv_cmp_flags(cmp_type, pattern.c_str());
 
@@ -127,9 +130,9 @@ static void filter_reference_by_type_and_id(
             dataiterator_prepend_keyname(&di, UPDATE_REFERENCE);
             while (dataiterator_step(&di) != 0) {
                 dataiterator_setpos_parent(&di);
-                const char * current_type = pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_TYPE);
+                Id current_type = pool.lookup_id(SOLVID_POS, UPDATE_REFERENCE_TYPE);
                 if (type && current_type) {
-                    if (!strcmp(type->c_str(), current_type)) {
+                    if (current_type == type_id) {
                         filter_result.add_unsafe(candidate_id);
                         break;
                     }
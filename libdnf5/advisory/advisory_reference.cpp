@@ -19,7 +19,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "libdnf5/advisory/advisory_reference.hpp"
 
+#include "advisory_sack.hpp"
+#include "base/base_impl.hpp"
 #include "rpm/package_sack_impl.hpp"
+#include "utils/string.hpp"
 
 #include <solv/chksum.h>
 #include <solv/repo.h>
@@ -33,19 +36,20 @@ AdvisoryReference::AdvisoryReference(const libdnf5::BaseWeakPtr & base, Advisory
       index(index) {}
 
 std::string AdvisoryReference::get_id() const {
-    return std::string(get_rpm_pool(base).get_str_from_pool(UPDATE_REFERENCE_ID, advisory.id, index));
+    return std::string(InternalBaseUser::get_rpm_advisory_sack(base)->get_reference(advisory.id, index).id);
 }
 std::string AdvisoryReference::get_type() const {
-    return std::string(get_rpm_pool(base).get_str_from_pool(UPDATE_REFERENCE_TYPE, advisory.id, index));
+    return libdnf5::utils::string::c_to_str(get_type_cstring());
 }
 const char * AdvisoryReference::get_type_cstring() const {
-    return get_rpm_pool(base).get_str_from_pool(UPDATE_REFERENCE_TYPE, advisory.id, index);
+    Id type = InternalBaseUser::get_rpm_advisory_sack(base)->get_reference(advisory.id, index).type;
+    return type ? get_rpm_pool(base).id2str(type) : nullptr;
 }
 std::string AdvisoryReference::get_title() const {
-    return std::string(get_rpm_pool(base).get_str_from_pool(UPDATE_REFERENCE_TITLE, advisory.id, index));
+    return std::string(InternalBaseUser::get_rpm_advisory_sack(base)->get_reference(advisory.id, index).title);
 }
 std::string AdvisoryReference::get_url() const {
-    return std::string(get_rpm_pool(base).get_str_from_pool(UPDATE_REFERENCE_HREF, advisory.id, index));
+    return std::string(InternalBaseUser::get_rpm_advisory_sack(base)->get_reference(advisory.id, index).url);
 }
 
 }  // namespace libdnf5::advisory
@@ -19,11 +19,17 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "advisory_sack.hpp"
 
+#include "advisory_package_private.hpp"
 #include "solv/pool.hpp"
 #include "solv/solv_map.hpp"
 
+#include "libdnf5/advisory/advisory.hpp"
+
 #include <solv/dataiterator.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace libdnf5::advisory {
 
 libdnf5::solv::SolvMap & AdvisorySack::get_solvables() {
@@ -60,6 +66,147 @@ libdnf5::solv::SolvMap & AdvisorySack::get_solvables() {
     return data_map;
 }
 
+const std::vector<AdvisoryPackage> & AdvisorySack::get_sorted_advisory_packages() {
+    auto & pool = get_rpm_pool(base);
+
+    if (sorted_advisory_packages_solvables_size == pool.get_nsolvables()) {
+        return sorted_advisory_packages;
+    }
+
+    sorted_advisory_packages.clear();
+    for (Id advisory_id : get_solvables()) {
+        Advisory advisory(base, AdvisoryId(advisory_id));
+        for (auto & collection : advisory.get_collections()) {
+            collection.get_packages(sorted_advisory_packages);
+        }
+    }
+    std::sort(
+        sorted_advisory_packages.begin(),
+        sorted_advisory_packages.end(),
+        AdvisoryPackage::Impl::nevra_compare_lower_id);
+
+    sorted_advisory_packages_solvables_size = pool.get_nsolvables();
+
+    return sorted_advisory_packages;
+}
+
+void AdvisorySack::update_index() {
+    auto & pool = get_rpm_pool(base);
+
+    if (index_solvables_size == pool.get_nsolvables()) {
+        return;
+    }
+
+    index_advisories.clear();
+    index_references.clear();
+    index_strings.clear();
+
+    auto add_string = [this](const char * str) {
+        StringRef ref{static_cast<std::uint32_t>(index_strings.size()), 0};
+        if (str) {
+            ref.length = static_cast<std::uint32_t>(strlen(str));
+            index_strings.append(str, ref.length);
+        }
+        return ref;
+    };
+
+    // Advisories are visited in the order of repositories which need not match the order of ids.
+    // Collect (advisory, reference) pairs first and sort them stably to keep the updateinfo order
+    // of references inside each advisory.
+    std::vector<std::pair<Id, ReferenceEntry>> references;
+
+    Dataiterator di;
+    dataiterator_init(&di, *pool, 0, 0, UPDATE_REFERENCE, 0, 0);
+    while (dataiterator_step(&di)) {
+        Id advisory = di.solvid;
+        dataiterator_setpos(&di);
+        // The type is stored as a pool string, the comparisons are done on its id
+        const char * type = pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_TYPE);
+        ReferenceEntry entry;
+        entry.type = type ? pool.str2id(type, true) : 0;
+        entry.id = add_string(pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_ID));
+        entry.title = add_string(pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_TITLE));
+        entry.url = add_string(pool.lookup_str(SOLVID_POS, UPDATE_REFERENCE_HREF));
+        references.emplace_back(advisory, entry);
+    }
+    dataiterator_free(&di);
+
+    std::vector<std::pair<Id, std::uint32_t>> collections;
+    dataiterator_init(&di, *pool, 0, 0, UPDATE_COLLECTIONLIST, 0, 0);
+    while (dataiterator_step(&di)) {
+        if (collections.empty() || collections.back().first != di.solvid) {
+            collections.emplace_back(di.solvid, 0);
+        }
+        ++collections.back().second;
+    }
+    dataiterator_free(&di);
+
+    std::stable_sort(references.begin(), references.end(), [](const auto & lhs, const auto & rhs) {
+        return lhs.first < rhs.first;
+    });
+    std::sort(collections.begin(), collections.end());
+
+    // Merge both sorted lists into one entry per advisory
+    index_references.reserve(references.size());
+    auto ref_it = references.begin();
+    auto coll_it = collections.begin();
+    while (ref_it != references.end() || coll_it != collections.end()) {
+        Id advisory;
+        if (ref_it == references.end()) {
+            advisory = coll_it->first;
+        } else if (coll_it == collections.end()) {
+            advisory = ref_it->first;
+        } else {
+            advisory = std::min(ref_it->first, coll_it->first);
+        }
+
+        AdvisoryEntry entry{advisory, static_cast<std::uint32_t>(index_references.size()), 0, 0};
+        for (; ref_it != references.end() && ref_it->first == advisory; ++ref_it) {
+            index_references.push_back(ref_it->second);
+        }
+        entry.references_end = static_cast<std::uint32_t>(index_references.size());
+        if (coll_it != collections.end() && coll_it->first == advisory) {
+            entry.collections_count = coll_it->second;
+            ++coll_it;
+        }
+        index_advisories.push_back(entry);
+    }
+
+    index_solvables_size = pool.get_nsolvables();
+}
+
+const AdvisorySack::AdvisoryEntry * AdvisorySack::find_index_entry(Id advisory) {
+    update_index();
+    auto it = std::lower_bound(
+        index_advisories.begin(), index_advisories.end(), advisory, [](const AdvisoryEntry & entry, Id id) {
+            return entry.advisory < id;
+        });
+    if (it == index_advisories.end() || it->advisory != advisory) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+std::size_t AdvisorySack::get_references_count(Id advisory) {
+    auto * entry = find_index_entry(advisory);
+    return entry ? entry->references_end - entry->references_begin : 0;
+}
+
+AdvisorySack::ReferenceView AdvisorySack::get_reference(Id advisory, std::size_t index) {
+    auto * entry = find_index_entry(advisory);
+    if (!entry || index >= entry->references_end - entry->references_begin) {
+        return ReferenceView{0, {}, {}, {}};
+    }
+    auto & reference = index_references[entry->references_begin + index];
+    return ReferenceView{
+        reference.type, to_string_view(reference.id), to_string_view(reference.title), to_string_view(reference.url)};
+}
+
+std::size_t AdvisorySack::get_collections_count(Id advisory) {
+    auto * entry = find_index_entry(advisory);
+    return entry ? entry->collections_count : 0;
+}
+
 AdvisorySack::AdvisorySack(const libdnf5::BaseWeakPtr & base) : base(base) {}
 
 AdvisorySackWeakPtr AdvisorySack::get_weak_ptr() {
@@ -22,9 +22,16 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "solv/solv_map.hpp"
 
+#include "libdnf5/advisory/advisory_package.hpp"
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/common/weak_ptr.hpp"
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 
 namespace libdnf5::advisory {
 
@@ -45,12 +52,73 @@ public:
     /// @return All advisories from pool inside of base.
     libdnf5::solv::SolvMap & get_solvables();
 
+    /// @return Packages of all advisories from pool inside of base sorted by name, arch and evr.
+    /// The list is cached, it is rebuilt only when the number of solvables in the pool changes.
+    const std::vector<AdvisoryPackage> & get_sorted_advisory_packages();
+
+    /// Data of one advisory reference. The strings point into the index owned by the sack,
+    /// they are valid until the index is rebuilt (the number of solvables in the pool changes).
+    struct ReferenceView {
+        Id type;
+        std::string_view id;
+        std::string_view title;
+        std::string_view url;
+    };
+
+    /// @return Number of references of the `advisory`.
+    std::size_t get_references_count(Id advisory);
+
+    /// @return Reference of the `advisory` at `index` (in updateinfo order).
+    ReferenceView get_reference(Id advisory, std::size_t index);
+
+    /// @return Number of collections of the `advisory`.
+    std::size_t get_collections_count(Id advisory);
+
+private:
+    struct StringRef {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    struct ReferenceEntry {
+        Id type;
+        StringRef id;
+        StringRef title;
+        StringRef url;
+    };
+
+    struct AdvisoryEntry {
+        Id advisory;
+        std::uint32_t references_begin;
+        std::uint32_t references_end;
+        std::uint32_t collections_count;
+    };
+
+    /// Builds the reference and collection index of all advisories in the pool.
+    /// The index is cached, it is rebuilt only when the number of solvables in the pool changes.
+    void update_index();
+
+    const AdvisoryEntry * find_index_entry(Id advisory);
+
+    std::string_view to_string_view(StringRef ref) const {
+        return std::string_view(index_strings.data() + ref.offset, ref.length);
+    }
+
 private:
     libdnf5::BaseWeakPtr base;
     WeakPtrGuard<AdvisorySack, false> sack_guard;
 
     libdnf5::solv::SolvMap data_map{0};
     int cached_solvables_size{0};
+
+    std::vector<AdvisoryPackage> sorted_advisory_packages;
+    int sorted_advisory_packages_solvables_size{0};
+
+    // Advisories sorted by id, each pointing to its range in index_references
+    std::vector<AdvisoryEntry> index_advisories;
+    std::vector<ReferenceEntry> index_references;
+    std::string index_strings;
+    int index_solvables_size{0};
 };
 
 }  // namespace libdnf5::advisory
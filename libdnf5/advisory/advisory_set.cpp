@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "advisory/advisory_package_private.hpp"
 #include "advisory_set_impl.hpp"
+#include "base/base_impl.hpp"
 #include "base/base_private.hpp"
 #include "solv/solv_map.hpp"
 
@@ -120,19 +121,20 @@ BaseWeakPtr AdvisorySet::get_base() const {
 
 std::vector<AdvisoryPackage> AdvisorySet::get_advisory_packages_sorted_by_name_arch_evr(bool only_applicable) const {
     std::vector<AdvisoryPackage> out;
-    for (Id candidate_id : *p_impl) {
-        Advisory advisory2 = Advisory(p_impl->base, AdvisoryId(candidate_id));
-        auto collections = advisory2.get_collections();
-        for (auto & collection : collections) {
-            if (only_applicable && !collection.is_applicable()) {
-                continue;
-            }
-            collection.get_packages(out);
+
+    // Select packages of the advisories in the set from the cached sorted list of all advisory packages,
+    // that is cheaper than collecting and sorting the packages on every call.
+    auto & sorted_packages = InternalBaseUser::get_rpm_advisory_sack(p_impl->base)->get_sorted_advisory_packages();
+    for (const auto & adv_pkg : sorted_packages) {
+        if (!p_impl->contains(adv_pkg.p_impl->get_advisory_id().id)) {
+            continue;
+        }
+        if (only_applicable && !adv_pkg.get_advisory_collection().is_applicable()) {
+            continue;
         }
+        out.push_back(adv_pkg);
     }
 
-    std::sort(out.begin(), out.end(), AdvisoryPackage::Impl::nevra_compare_lower_id);
-
     return out;
 }
 
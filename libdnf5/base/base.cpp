@@ -22,12 +22,16 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "base_impl.hpp"
 #include "conf/config.h"
 #include "module/module_sack_impl.hpp"
+#include "repo/repo_pgp.hpp"
+#include "rpm/package_sack_impl.hpp"
+#include "rpm/solv/solver_cache.hpp"
 #include "solv/pool.hpp"
 #include "utils/dnf4convert/dnf4convert.hpp"
 #include "utils/fs/utils.hpp"
 
 #include "libdnf5/conf/config_parser.hpp"
 #include "libdnf5/conf/const.hpp"
+#include "libdnf5/logger/memory_buffer_logger.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
 #include <algorithm>
@@ -55,7 +59,17 @@ Base::Base(std::vector<std::unique_ptr<Logger>> && loggers)
 
 Base::~Base() = default;
 
-Base::Impl::Impl(const libdnf5::BaseWeakPtr & base) : rpm_advisory_sack(base), plugins(*base) {}
+Base::Impl::Impl(const libdnf5::BaseWeakPtr & base)
+    : solver_cache(std::make_unique<rpm::solv::SolverCache>(base)),
+      rpm_advisory_sack(base),
+      plugins(*base) {}
+
+repo::PgpKeyCache & Base::Impl::get_pgp_key_cache() {
+    if (!pgp_key_cache) {
+        pgp_key_cache = std::make_unique<repo::PgpKeyCache>();
+    }
+    return *pgp_key_cache;
+}
 
 void Base::lock() {
     locked_base_mutex.lock();
@@ -230,8 +244,56 @@ void Base::setup() {
     p_impl->plugins.post_base_setup();
 }
 
+void Base::set_trace_exporter(std::unique_ptr<TraceExporter> && trace_exporter) {
+    p_impl->trace_exporter = std::move(trace_exporter);
+}
+
+TraceExporter * Base::get_trace_exporter() noexcept {
+    return p_impl->trace_exporter.get();
+}
+
 bool Base::is_initialized() {
     return p_impl->pool.get() != nullptr;
 }
 
+std::map<std::string, std::size_t> Base::get_memory_usage() {
+    std::map<std::string, std::size_t> usage;
+
+    auto add_pool_usage = [&usage](const std::string & prefix, const ::Pool * pool) {
+        auto pool_usage = solv::get_pool_memory_usage(pool);
+        usage[prefix + ".strings"] += pool_usage.strings;
+        usage[prefix + ".reldeps"] += pool_usage.reldeps;
+        usage[prefix + ".whatprovides"] += pool_usage.whatprovides;
+        usage[prefix + ".solvables"] += pool_usage.solvables;
+
+        Id repo_id;
+        ::Repo * solv_repo;
+        FOR_REPOS(repo_id, solv_repo) {
+            usage[std::string("repo.") + solv_repo->name] += solv::get_repo_memory_usage(solv_repo);
+        }
+    };
+
+    if (p_impl->pool) {
+        add_pool_usage("rpm_pool", **p_impl->pool);
+    }
+    if (p_impl->comps_pool) {
+        add_pool_usage("comps_pool", **p_impl->comps_pool);
+    }
+    if (const auto * module_pool = module_sack.p_impl->get_pool()) {
+        add_pool_usage("module_pool", module_pool);
+    }
+
+    usage["rpm_package_sack.caches"] = rpm_package_sack.p_impl->get_caches_memory_usage();
+
+    std::size_t logger_usage = 0;
+    for (std::size_t idx = 0; idx < log_router.get_loggers_count(); ++idx) {
+        if (auto * memory_logger = dynamic_cast<MemoryBufferLogger *>(log_router.get_logger(idx))) {
+            logger_usage += memory_logger->get_memory_usage();
+        }
+    }
+    usage["logger.memory_buffer"] = logger_usage;
+
+    return usage;
+}
+
 }  // namespace libdnf5
@@ -27,6 +27,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "libdnf5/base/base.hpp"
 
+#include <string>
+#include <unordered_set>
+
 
 namespace libdnf5 {
 
@@ -37,6 +40,18 @@ class RpmPool;
 
 }  // namespace solv
 
+namespace repo {
+
+class PgpKeyCache;
+
+}  // namespace repo
+
+namespace rpm::solv {
+
+class SolverCache;
+
+}  // namespace rpm::solv
+
 class Base::Impl {
 public:
     /// @return The system state object.
@@ -56,6 +71,15 @@ public:
 
     plugin::Plugins & get_plugins() { return plugins; }
 
+    /// @return The ids of all repositories created in the RepoSack.
+    std::unordered_set<std::string> & get_repo_ids() { return repo_ids; }
+
+    /// @return The pgp keys parsed so far, shared by all repositories.
+    repo::PgpKeyCache & get_pgp_key_cache();
+
+    /// @return The solver inputs and solvers shared by the goals.
+    rpm::solv::SolverCache & get_solver_cache() { return *solver_cache; }
+
 private:
     friend class Base;
     Impl(const libdnf5::BaseWeakPtr & base);
@@ -73,10 +97,22 @@ private:
     // Thus we need to keep group solvables in a separate pool.
     std::unique_ptr<solv::CompsPool> comps_pool;
 
+    // Holds libsolv solvers of the RpmPool, it has to be destroyed before the pool, but after all the other
+    // members that can still release the solvers of their goals.
+    std::unique_ptr<rpm::solv::SolverCache> solver_cache;
+
     std::optional<libdnf5::system::State> system_state;
     libdnf5::advisory::AdvisorySack rpm_advisory_sack;
 
     plugin::Plugins plugins;
+
+    // The exporter can be implemented by a plugin, it has to be destroyed before the plugins are unloaded.
+    std::unique_ptr<TraceExporter> trace_exporter;
+
+    // Used by the RepoSack to detect duplicate repository ids without walking all the repositories.
+    std::unordered_set<std::string> repo_ids;
+
+    std::unique_ptr<repo::PgpKeyCache> pgp_key_cache;
 };
 
 
@@ -86,6 +122,18 @@ public:
     static solv::CompsPool & get_comps_pool(const libdnf5::BaseWeakPtr & base) {
         return base->p_impl->get_comps_pool();
     }
+    static repo::PgpKeyCache & get_pgp_key_cache(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_pgp_key_cache();
+    }
+    static advisory::AdvisorySackWeakPtr get_rpm_advisory_sack(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_rpm_advisory_sack();
+    }
+    static system::State & get_system_state(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_system_state();
+    }
+    static rpm::solv::SolverCache & get_solver_cache(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_solver_cache();
+    }
 };
 
 }  // namespace libdnf5
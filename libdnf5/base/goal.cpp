@@ -27,6 +27,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "rpm/package_sack_impl.hpp"
 #include "rpm/package_set_impl.hpp"
 #include "rpm/solv/goal_private.hpp"
+#include "rpm/solv/solver_cache.hpp"
 #include "solv/id_queue.hpp"
 #include "solv/pool.hpp"
 #include "transaction/transaction_sr.hpp"
@@ -46,6 +47,11 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace {
 
@@ -54,17 +60,22 @@ void add_obsoletes_to_data(const libdnf5::rpm::PackageQuery & base_query, libdnf
 
     // In case there is an installed package in the `data` behave consistently
     // with upgrade and add all the obsoleters.
-    libdnf5::rpm::PackageQuery installed_data(data_query);
-    installed_data.filter_installed();
+    // The `data` are usually a few packages, checking them is cheaper than a filtered copy of the query.
+    bool has_installed = false;
+    for (const auto & pkg : data) {
+        if (pkg.is_installed()) {
+            has_installed = true;
+            break;
+        }
+    }
 
-    if (installed_data.empty()) {
+    if (!has_installed) {
         // If there is no installed package in the `data`, add only obsoleters
         // of the latest versions.  This should prevent unexpected results in
         // case a package has multiple versions and some older version is being
         // obsoleted.
         // See also https://bugzilla.redhat.com/show_bug.cgi?id=2176263
-        data_query.filter_priority();
-        data_query.filter_latest_evr();
+        data_query.filter_latest_evr_by_priority();
     }
 
     libdnf5::rpm::PackageQuery obsoletes_query(base_query);
@@ -88,6 +99,152 @@ inline bool name_arch_compare_lower_solvable(const Solvable * first, const Solva
 }
 
 
+/// Differences between the installed and the available definitions of comps groups and environments.
+/// It is created once per resolve and filled lazily, so upgrading many groups and environments does
+/// not construct group and environment queries over the whole comps pool for every group again.
+class CompsUpgradeDelta {
+public:
+    struct GroupDelta {
+        /// Available version of the group, empty when the group is not available any more.
+        std::optional<comps::Group> available_group;
+        /// Packages of the available version that are not part of the installed version.
+        std::vector<comps::Package> added_packages;
+        /// Names of all packages of the available version.
+        std::set<std::string> available_package_names;
+    };
+
+    struct EnvironmentDelta {
+        /// Available version of the environment, empty when the environment is not available any more.
+        std::optional<comps::Environment> available_environment;
+        /// Groups (mandatory and optional) that are part of both versions.
+        std::vector<std::string> kept_groups;
+        /// Mandatory groups that are newly added to the available version.
+        std::vector<std::string> added_groups;
+        /// Groups of the installed version that are not part of the available version.
+        std::vector<std::string> removed_groups;
+    };
+
+    explicit CompsUpgradeDelta(const BaseWeakPtr & base) : base(base) {}
+
+    const GroupDelta & get_group_delta(comps::Group & installed_group) {
+        auto group_id = installed_group.get_groupid();
+        auto [it, inserted] = group_deltas.try_emplace(group_id);
+        if (!inserted) {
+            return it->second;
+        }
+        auto & delta = it->second;
+
+        if (!available_groups) {
+            available_groups.emplace();
+            comps::GroupQuery query(base);
+            query.filter_installed(false);
+            for (const auto & group : query) {
+                available_groups->emplace(group.get_groupid(), group);
+            }
+        }
+        auto available_it = available_groups->find(group_id);
+        if (available_it == available_groups->end()) {
+            return delta;
+        }
+        delta.available_group = available_it->second;
+
+        std::set<std::string> installed_package_names;
+        for (const auto & pkg : installed_group.get_packages()) {
+            installed_package_names.emplace(pkg.get_name());
+        }
+        for (auto & pkg : delta.available_group->get_packages()) {
+            delta.available_package_names.emplace(pkg.get_name());
+            if (!installed_package_names.contains(pkg.get_name())) {
+                delta.added_packages.emplace_back(std::move(pkg));
+            }
+        }
+        return delta;
+    }
+
+    const EnvironmentDelta & get_environment_delta(comps::Environment & installed_environment) {
+        auto environment_id = installed_environment.get_environmentid();
+        auto [it, inserted] = environment_deltas.try_emplace(environment_id);
+        if (!inserted) {
+            return it->second;
+        }
+        auto & delta = it->second;
+
+        if (!available_environments) {
+            available_environments.emplace();
+            comps::EnvironmentQuery query(base);
+            query.filter_installed(false);
+            for (const auto & environment : query) {
+                available_environments->emplace(environment.get_environmentid(), environment);
+            }
+        }
+        auto available_it = available_environments->find(environment_id);
+        if (available_it == available_environments->end()) {
+            return delta;
+        }
+        delta.available_environment = available_it->second;
+
+        auto old_groups = installed_environment.get_groups();
+        std::set<std::string> old_mandatory(old_groups.begin(), old_groups.end());
+        std::set<std::string> old_all(old_mandatory);
+        for (auto & grp : installed_environment.get_optional_groups()) {
+            if (old_all.insert(grp).second) {
+                old_groups.emplace_back(std::move(grp));
+            }
+        }
+
+        std::set<std::string> new_all;
+        for (auto & grp : delta.available_environment->get_groups()) {
+            new_all.emplace(grp);
+            if (old_mandatory.contains(grp)) {
+                delta.kept_groups.emplace_back(std::move(grp));
+            } else {
+                delta.added_groups.emplace_back(std::move(grp));
+            }
+        }
+        // installed optional groups are upgraded as well
+        for (auto & grp : delta.available_environment->get_optional_groups()) {
+            new_all.emplace(grp);
+            if (old_all.contains(grp)) {
+                delta.kept_groups.emplace_back(std::move(grp));
+            }
+        }
+
+        for (auto & grp : old_groups) {
+            if (!new_all.contains(grp)) {
+                delta.removed_groups.emplace_back(std::move(grp));
+            }
+        }
+        return delta;
+    }
+
+    const rpm::PackageQuery & get_installed_packages() {
+        if (!installed_packages) {
+            installed_packages.emplace(base);
+            installed_packages->filter_installed();
+        }
+        return *installed_packages;
+    }
+
+private:
+    BaseWeakPtr base;
+    std::optional<std::map<std::string, comps::Group>> available_groups;
+    std::optional<std::map<std::string, comps::Environment>> available_environments;
+    std::map<std::string, GroupDelta> group_deltas;
+    std::map<std::string, EnvironmentDelta> environment_deltas;
+    std::optional<rpm::PackageQuery> installed_packages;
+};
+
+/// Settings of goal jobs. Jobs added with equal settings share one instance, goals built from large
+/// kickstarts or transaction replays add thousands of jobs with only a few distinct settings.
+struct SharedJobSettings {
+    explicit SharedJobSettings(const GoalJobSettings & settings) : settings(settings), job_settings(settings) {}
+
+    /// Settings as they were added with the jobs.
+    const GoalJobSettings settings;
+    /// Settings the job being resolved works with, they record the values used by that job.
+    GoalJobSettings job_settings;
+};
+
 }  // namespace
 
 using GroupSpec = std::tuple<GoalAction, libdnf5::transaction::TransactionItemReason, std::string, GoalJobSettings>;
@@ -97,8 +254,17 @@ public:
     Impl(const BaseWeakPtr & base);
     ~Impl();
 
-    void add_rpm_ids(GoalAction action, const rpm::Package & rpm_package, const GoalJobSettings & settings);
-    void add_rpm_ids(GoalAction action, const rpm::PackageSet & package_set, const GoalJobSettings & settings);
+    void add_rpm_ids(
+        GoalAction action, const rpm::Package & rpm_package, const std::shared_ptr<SharedJobSettings> & settings);
+    void add_rpm_ids(
+        GoalAction action, const rpm::PackageSet & package_set, const std::shared_ptr<SharedJobSettings> & settings);
+
+    /// @return Shared settings equal to `settings`. Jobs with equal settings share one instance.
+    std::shared_ptr<SharedJobSettings> intern_settings(const GoalJobSettings & settings);
+
+    /// @return Settings to resolve the next job of the `shared` settings with. The values used by
+    /// the previous job are reset.
+    static GoalJobSettings & get_job_settings(SharedJobSettings & shared);
 
     GoalProblem add_specs_to_goal(base::Transaction & transaction);
     GoalProblem resolve_group_specs(std::vector<GroupSpec> & specs, base::Transaction & transaction);
@@ -173,18 +339,24 @@ private:
     BaseWeakPtr base;
     std::vector<std::tuple<GoalAction, std::string, GoalJobSettings>> module_specs;
     /// <libdnf5::GoalAction, std::string pkg_spec, libdnf5::GoalJobSettings settings>
-    std::vector<std::tuple<GoalAction, std::string, GoalJobSettings>> rpm_specs;
+    std::vector<std::tuple<GoalAction, std::string, std::shared_ptr<SharedJobSettings>>> rpm_specs;
     /// <TransactionItemReason reason, std::string pkg_spec, optional<std::string> group id, libdnf5::GoalJobSettings settings>
     std::vector<std::tuple<
         libdnf5::transaction::TransactionItemReason,
         std::string,
         std::optional<std::string>,
-        GoalJobSettings>>
+        std::shared_ptr<SharedJobSettings>>>
         rpm_reason_change_specs;
     /// <libdnf5::GoalAction, rpm Ids, libdnf5::GoalJobSettings settings>
-    std::vector<std::tuple<GoalAction, libdnf5::solv::IdQueue, GoalJobSettings>> rpm_ids;
+    std::vector<std::tuple<GoalAction, libdnf5::solv::IdQueue, std::shared_ptr<SharedJobSettings>>> rpm_ids;
     /// <libdnf5::GoalAction, std::string filepath, libdnf5::GoalJobSettings settings>
-    std::vector<std::tuple<GoalAction, std::string, GoalJobSettings>> rpm_filepaths;
+    std::vector<std::tuple<GoalAction, std::string, std::shared_ptr<SharedJobSettings>>> rpm_filepaths;
+
+    /// Settings of the rpm jobs by hash of their values, see intern_settings()
+    std::unordered_multimap<std::size_t, std::shared_ptr<SharedJobSettings>> interned_settings;
+    std::shared_ptr<SharedJobSettings> last_interned_settings;
+    static std::size_t job_settings_hash(const GoalJobSettings & settings);
+    static bool job_settings_equal(const GoalJobSettings & lhs, const GoalJobSettings & rhs);
 
     // (spec, reason, query, settings)
     using GroupItem = std::tuple<std::string, transaction::TransactionItemReason, comps::GroupQuery, GoalJobSettings>;
@@ -203,10 +375,20 @@ private:
     rpm::solv::GoalPrivate rpm_goal;
     bool allow_erasing{false};
 
-    void install_group_package(base::Transaction & transaction, libdnf5::comps::Package pkg);
+    void install_group_packages(
+        base::Transaction & transaction, const std::vector<libdnf5::comps::Package> & packages);
     void remove_group_packages(const rpm::PackageSet & remove_candidates);
 
     std::unique_ptr<std::pair<transaction::TransactionReplay, GoalJobSettings>> serialized_transaction;
+
+    /// Installed vs. available comps state used by group and environment upgrades, valid during one resolve.
+    std::unique_ptr<CompsUpgradeDelta> comps_upgrade_delta;
+    CompsUpgradeDelta & get_comps_upgrade_delta() {
+        if (!comps_upgrade_delta) {
+            comps_upgrade_delta = std::make_unique<CompsUpgradeDelta>(base);
+        }
+        return *comps_upgrade_delta;
+    }
 };
 
 Goal::Goal(const BaseWeakPtr & base) : p_impl(new Impl(base)) {}
@@ -252,99 +434,100 @@ void Goal::add_remove(const std::string & spec, const GoalJobSettings & settings
 
 
 void Goal::add_rpm_install(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::INSTALL, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::INSTALL, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_install(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::INSTALL, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::INSTALL, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_install(const rpm::PackageSet & package_set, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::INSTALL, package_set, settings);
+    p_impl->add_rpm_ids(GoalAction::INSTALL, package_set, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_install_or_reinstall(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::INSTALL_OR_REINSTALL, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::INSTALL_OR_REINSTALL, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_install_or_reinstall(const rpm::PackageSet & package_set, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::INSTALL_OR_REINSTALL, package_set, settings);
+    p_impl->add_rpm_ids(GoalAction::INSTALL_OR_REINSTALL, package_set, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_reinstall(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::REINSTALL, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::REINSTALL, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_reinstall(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::REINSTALL, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::REINSTALL, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_remove(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::REMOVE, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::REMOVE, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_remove(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::REMOVE, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::REMOVE, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_remove(const rpm::PackageSet & package_set, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::REMOVE, package_set, settings);
+    p_impl->add_rpm_ids(GoalAction::REMOVE, package_set, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_upgrade(const std::string & spec, const GoalJobSettings & settings, bool minimal) {
     if (minimal) {
-        p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::UPGRADE_MINIMAL, spec, settings));
+        p_impl->rpm_specs.emplace_back(GoalAction::UPGRADE_MINIMAL, spec, p_impl->intern_settings(settings));
     } else {
-        p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::UPGRADE, spec, settings));
+        p_impl->rpm_specs.emplace_back(GoalAction::UPGRADE, spec, p_impl->intern_settings(settings));
     }
 }
 
 void Goal::add_rpm_upgrade(const GoalJobSettings & settings, bool minimal) {
     if (minimal) {
-        p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::UPGRADE_ALL_MINIMAL, std::string(), settings));
+        p_impl->rpm_specs.emplace_back(
+            GoalAction::UPGRADE_ALL_MINIMAL, std::string(), p_impl->intern_settings(settings));
     } else {
-        p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::UPGRADE_ALL, std::string(), settings));
+        p_impl->rpm_specs.emplace_back(GoalAction::UPGRADE_ALL, std::string(), p_impl->intern_settings(settings));
     }
 }
 
 void Goal::add_rpm_upgrade(const rpm::Package & rpm_package, const GoalJobSettings & settings, bool minimal) {
     if (minimal) {
-        p_impl->add_rpm_ids(GoalAction::UPGRADE_MINIMAL, rpm_package, settings);
+        p_impl->add_rpm_ids(GoalAction::UPGRADE_MINIMAL, rpm_package, p_impl->intern_settings(settings));
     } else {
-        p_impl->add_rpm_ids(GoalAction::UPGRADE, rpm_package, settings);
+        p_impl->add_rpm_ids(GoalAction::UPGRADE, rpm_package, p_impl->intern_settings(settings));
     }
 }
 
 void Goal::add_rpm_upgrade(const rpm::PackageSet & package_set, const GoalJobSettings & settings, bool minimal) {
     if (minimal) {
-        p_impl->add_rpm_ids(GoalAction::UPGRADE_MINIMAL, package_set, settings);
+        p_impl->add_rpm_ids(GoalAction::UPGRADE_MINIMAL, package_set, p_impl->intern_settings(settings));
     } else {
-        p_impl->add_rpm_ids(GoalAction::UPGRADE, package_set, settings);
+        p_impl->add_rpm_ids(GoalAction::UPGRADE, package_set, p_impl->intern_settings(settings));
     }
 }
 
 void Goal::add_rpm_downgrade(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::DOWNGRADE, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::DOWNGRADE, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_downgrade(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::DOWNGRADE, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::DOWNGRADE, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_distro_sync(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::DISTRO_SYNC, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::DISTRO_SYNC, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_distro_sync(const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::DISTRO_SYNC_ALL, std::string(), settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::DISTRO_SYNC_ALL, std::string(), p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_distro_sync(const rpm::Package & rpm_package, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::DISTRO_SYNC, rpm_package, settings);
+    p_impl->add_rpm_ids(GoalAction::DISTRO_SYNC, rpm_package, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_distro_sync(const rpm::PackageSet & package_set, const GoalJobSettings & settings) {
-    p_impl->add_rpm_ids(GoalAction::DISTRO_SYNC, package_set, settings);
+    p_impl->add_rpm_ids(GoalAction::DISTRO_SYNC, package_set, p_impl->intern_settings(settings));
 }
 
 void Goal::add_rpm_reason_change(
@@ -355,11 +538,11 @@ void Goal::add_rpm_reason_change(
     libdnf_user_assert(
         reason != libdnf5::transaction::TransactionItemReason::GROUP || !group_id.empty(),
         "group_id is required for setting reason \"GROUP\"");
-    p_impl->rpm_reason_change_specs.push_back(std::make_tuple(reason, spec, group_id, settings));
+    p_impl->rpm_reason_change_specs.emplace_back(reason, spec, group_id, p_impl->intern_settings(settings));
 }
 
 void Goal::add_provide_install(const std::string & spec, const GoalJobSettings & settings) {
-    p_impl->rpm_specs.push_back(std::make_tuple(GoalAction::INSTALL_VIA_PROVIDE, spec, settings));
+    p_impl->rpm_specs.emplace_back(GoalAction::INSTALL_VIA_PROVIDE, spec, p_impl->intern_settings(settings));
 }
 
 void Goal::Impl::add_spec(GoalAction action, const std::string & spec, const GoalJobSettings & settings) {
@@ -386,30 +569,113 @@ void Goal::Impl::add_spec(GoalAction action, const std::string & spec, const Goa
             if (action == GoalAction::REMOVE) {
                 throw RuntimeError(M_("Unsupported argument for REMOVE action: {}"), spec);
             }
-            rpm_filepaths.emplace_back(action, spec, settings);
+            rpm_filepaths.emplace_back(action, spec, intern_settings(settings));
         } else {
             // otherwise the spec is a repository package
-            rpm_specs.emplace_back(action, spec, settings);
+            rpm_specs.emplace_back(action, spec, intern_settings(settings));
         }
     }
 }
 
-void Goal::Impl::add_rpm_ids(GoalAction action, const rpm::Package & rpm_package, const GoalJobSettings & settings) {
+void Goal::Impl::add_rpm_ids(
+    GoalAction action, const rpm::Package & rpm_package, const std::shared_ptr<SharedJobSettings> & settings) {
     libdnf_assert_same_base(base, rpm_package.base);
 
     libdnf5::solv::IdQueue ids;
     ids.push_back(rpm_package.get_id().id);
-    rpm_ids.push_back(std::make_tuple(action, std::move(ids), settings));
+    rpm_ids.emplace_back(action, std::move(ids), settings);
 }
 
-void Goal::Impl::add_rpm_ids(GoalAction action, const rpm::PackageSet & package_set, const GoalJobSettings & settings) {
+void Goal::Impl::add_rpm_ids(
+    GoalAction action, const rpm::PackageSet & package_set, const std::shared_ptr<SharedJobSettings> & settings) {
     libdnf_assert_same_base(base, package_set.get_base());
 
     libdnf5::solv::IdQueue ids;
     for (auto package_id : *package_set.p_impl) {
         ids.push_back(package_id);
     }
-    rpm_ids.push_back(std::make_tuple(action, std::move(ids), settings));
+    rpm_ids.emplace_back(action, std::move(ids), settings);
+}
+
+std::size_t Goal::Impl::job_settings_hash(const GoalJobSettings & settings) {
+    std::size_t hash = 0;
+    auto combine = [&hash](std::size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+    for (const auto & repo_id : settings.from_repo_ids) {
+        combine(std::hash<std::string>{}(repo_id));
+    }
+    for (const auto & repo_id : settings.to_repo_ids) {
+        combine(std::hash<std::string>{}(repo_id));
+    }
+    for (auto form : settings.nevra_forms) {
+        combine(static_cast<std::size_t>(form));
+    }
+    combine(static_cast<std::size_t>(settings.skip_broken));
+    combine(static_cast<std::size_t>(settings.skip_unavailable));
+    combine(static_cast<std::size_t>(settings.best));
+    combine(static_cast<std::size_t>(settings.clean_requirements_on_remove));
+    combine(
+        static_cast<std::size_t>(settings.ignore_case) | static_cast<std::size_t>(settings.with_nevra) << 1 |
+        static_cast<std::size_t>(settings.with_provides) << 2 | static_cast<std::size_t>(settings.with_filenames) << 3 |
+        static_cast<std::size_t>(settings.with_binaries) << 4 | static_cast<std::size_t>(settings.group_with_id) << 5 |
+        static_cast<std::size_t>(settings.group_with_name) << 6 |
+        static_cast<std::size_t>(settings.group_search_groups) << 7 |
+        static_cast<std::size_t>(settings.group_search_environments) << 8 |
+        static_cast<std::size_t>(settings.group_no_packages) << 9 |
+        static_cast<std::size_t>(settings.report_hint) << 10);
+    return hash;
+}
+
+bool Goal::Impl::job_settings_equal(const GoalJobSettings & lhs, const GoalJobSettings & rhs) {
+    return lhs.ignore_case == rhs.ignore_case && lhs.with_nevra == rhs.with_nevra &&
+           lhs.with_provides == rhs.with_provides && lhs.with_filenames == rhs.with_filenames &&
+           lhs.with_binaries == rhs.with_binaries && lhs.nevra_forms == rhs.nevra_forms &&
+           lhs.group_with_id == rhs.group_with_id && lhs.group_with_name == rhs.group_with_name &&
+           lhs.group_search_groups == rhs.group_search_groups &&
+           lhs.group_search_environments == rhs.group_search_environments &&
+           lhs.group_no_packages == rhs.group_no_packages && lhs.report_hint == rhs.report_hint &&
+           lhs.skip_broken == rhs.skip_broken && lhs.skip_unavailable == rhs.skip_unavailable &&
+           lhs.best == rhs.best && lhs.clean_requirements_on_remove == rhs.clean_requirements_on_remove &&
+           lhs.from_repo_ids == rhs.from_repo_ids && lhs.to_repo_ids == rhs.to_repo_ids &&
+           lhs.used_skip_broken == rhs.used_skip_broken && lhs.used_skip_unavailable == rhs.used_skip_unavailable &&
+           lhs.used_best == rhs.used_best &&
+           lhs.used_clean_requirements_on_remove == rhs.used_clean_requirements_on_remove &&
+           lhs.used_group_package_types == rhs.used_group_package_types &&
+           lhs.group_package_types == rhs.group_package_types && !lhs.advisory_filter && !rhs.advisory_filter;
+}
+
+std::shared_ptr<SharedJobSettings> Goal::Impl::intern_settings(const GoalJobSettings & settings) {
+    // Settings with an advisory filter are not compared, their jobs keep own instances
+    if (settings.advisory_filter) {
+        return std::make_shared<SharedJobSettings>(settings);
+    }
+
+    // Jobs are usually added in runs with the same settings
+    if (last_interned_settings && job_settings_equal(last_interned_settings->settings, settings)) {
+        return last_interned_settings;
+    }
+
+    auto hash = job_settings_hash(settings);
+    auto [begin, end] = interned_settings.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        if (job_settings_equal(it->second->settings, settings)) {
+            last_interned_settings = it->second;
+            return last_interned_settings;
+        }
+    }
+
+    last_interned_settings = std::make_shared<SharedJobSettings>(settings);
+    interned_settings.emplace(hash, last_interned_settings);
+    return last_interned_settings;
+}
+
+GoalJobSettings & Goal::Impl::get_job_settings(SharedJobSettings & shared) {
+    auto & settings = shared.job_settings;
+    settings.used_skip_broken = shared.settings.used_skip_broken;
+    settings.used_skip_unavailable = shared.settings.used_skip_unavailable;
+    settings.used_best = shared.settings.used_best;
+    settings.used_clean_requirements_on_remove = shared.settings.used_clean_requirements_on_remove;
+    settings.used_group_package_types = shared.settings.used_group_package_types;
+    return settings;
 }
 
 // @replaces part of libdnf/sack/query.cpp:method:filterAdvisory called with HY_EQG and HY_UPGRADE
@@ -478,7 +744,8 @@ GoalProblem Goal::Impl::add_specs_to_goal(base::Transaction & transaction) {
     auto sack = base->get_rpm_package_sack();
     auto & cfg_main = base->get_config();
     auto ret = GoalProblem::NO_PROBLEM;
-    for (auto & [action, spec, settings] : rpm_specs) {
+    for (auto & [action, spec, shared_settings] : rpm_specs) {
+        auto & settings = get_job_settings(*shared_settings);
         switch (action) {
             case GoalAction::INSTALL:
             case GoalAction::INSTALL_BY_COMPS: {
@@ -607,16 +874,32 @@ GoalProblem Goal::Impl::add_transaction_replay_specs_to_goal(base::Transaction &
     libdnf5::GoalJobSettings settings = serialized_transaction->second;
     bool skip_unavailable = settings.resolve_skip_unavailable(base->get_config());
 
+    // Replayed transactions usually reference only a few repositories, compute the enabled ones once
+    // instead of querying the repositories for every replayed item.
+    std::unordered_set<std::string> enabled_repo_ids;
+    {
+        repo::RepoQuery enabled_repos(base);
+        enabled_repos.filter_enabled(true);
+        for (const auto & repo : enabled_repos) {
+            enabled_repo_ids.insert(repo->get_id());
+        }
+    }
+
+    // Replayed packages share the settings, they differ only in the repository the package comes from
+    libdnf5::GoalJobSettings package_settings = settings;
+    package_settings.clean_requirements_on_remove = libdnf5::GoalSetting::SET_FALSE;
+    auto package_settings_any_repo = intern_settings(package_settings);
+    std::unordered_map<std::string, std::shared_ptr<SharedJobSettings>> package_settings_by_repo_id;
+
     for (const auto & package_replay : serialized_transaction->first.packages) {
-        libdnf5::GoalJobSettings settings_per_package = settings;
-        settings_per_package.clean_requirements_on_remove = libdnf5::GoalSetting::SET_FALSE;
-        if (!package_replay.repo_id.empty()) {
-            repo::RepoQuery enabled_repos(base);
-            enabled_repos.filter_enabled(true);
-            enabled_repos.filter_id(package_replay.repo_id);
-            if (!enabled_repos.empty()) {
-                settings_per_package.to_repo_ids = {package_replay.repo_id};
+        auto settings_per_package = package_settings_any_repo;
+        if (!package_replay.repo_id.empty() && enabled_repo_ids.contains(package_replay.repo_id)) {
+            auto [it, inserted] = package_settings_by_repo_id.try_emplace(package_replay.repo_id);
+            if (inserted) {
+                package_settings.to_repo_ids = {package_replay.repo_id};
+                it->second = intern_settings(package_settings);
             }
+            settings_per_package = it->second;
         }
 
         if (package_replay.action == transaction::TransactionItemAction::UPGRADE ||
@@ -656,14 +939,9 @@ GoalProblem Goal::Impl::add_transaction_replay_specs_to_goal(base::Transaction &
         settings_per_group.group_no_packages = true;
         settings_per_group.group_search_groups = true;
         settings_per_group.group_search_environments = false;
-        if (!group_replay.repo_id.empty()) {
-            repo::RepoQuery enabled_repos(base);
-            enabled_repos.filter_enabled(true);
-            enabled_repos.filter_id(group_replay.repo_id);
-            if (!enabled_repos.empty()) {
-                //TODO(amatej): add ci test where we limit a group to repo
-                settings_per_group.to_repo_ids = {group_replay.repo_id};
-            }
+        if (!group_replay.repo_id.empty() && enabled_repo_ids.contains(group_replay.repo_id)) {
+            //TODO(amatej): add ci test where we limit a group to repo
+            settings_per_group.to_repo_ids = {group_replay.repo_id};
         }
 
         //TODO(amatej): we could detect if we have a filepath instead and add_spec(..) or somehow add the filepath
@@ -689,14 +967,9 @@ GoalProblem Goal::Impl::add_transaction_replay_specs_to_goal(base::Transaction &
         //settings_per_environment.environment_no_groups = true;
         settings_per_environment.group_search_groups = false;
         settings_per_environment.group_search_environments = true;
-        if (!env_replay.repo_id.empty()) {
-            repo::RepoQuery enabled_repos(base);
-            enabled_repos.filter_enabled(true);
-            enabled_repos.filter_id(env_replay.repo_id);
-            if (!enabled_repos.empty()) {
-                //TODO(amatej): add ci test where we limit an env to a repo
-                settings_per_environment.to_repo_ids = {env_replay.repo_id};
-            }
+        if (!env_replay.repo_id.empty() && enabled_repo_ids.contains(env_replay.repo_id)) {
+            //TODO(amatej): add ci test where we limit an env to a repo
+            settings_per_environment.to_repo_ids = {env_replay.repo_id};
         }
 
         //TODO(amatej): we could detect if we have a filepath instead and add_spec(..) or somehow add the filepath
@@ -847,8 +1120,8 @@ void Goal::Impl::add_resolved_group_specs_to_goal(base::Transaction & transactio
 
 GoalProblem Goal::Impl::add_reason_change_specs_to_goal(base::Transaction & transaction) {
     auto ret = GoalProblem::NO_PROBLEM;
-    for (auto & [reason, spec, group_id, settings] : rpm_reason_change_specs) {
-        ret |= add_reason_change_to_goal(transaction, spec, reason, group_id, settings);
+    for (auto & [reason, spec, group_id, shared_settings] : rpm_reason_change_specs) {
+        ret |= add_reason_change_to_goal(transaction, spec, reason, group_id, get_job_settings(*shared_settings));
     }
     return ret;
 }
@@ -1054,7 +1327,7 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
                     if (add_obsoletes) {
                         add_obsoletes_to_data(base_query, selected);
                     }
-                    solv_map_to_id_queue(result_queue, static_cast<libdnf5::solv::SolvMap>(*selected.p_impl));
+                    solv_map_to_id_queue(result_queue, *selected.p_impl);
                     rpm_goal.add_install(result_queue, skip_broken, best, clean_requirements_on_remove);
                     selected.clear();
                     selected.p_impl->add_unsafe(pool.solvable2id(*iter));
@@ -1064,7 +1337,7 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
             if (add_obsoletes) {
                 add_obsoletes_to_data(base_query, selected);
             }
-            solv_map_to_id_queue(result_queue, static_cast<libdnf5::solv::SolvMap>(*selected.p_impl));
+            solv_map_to_id_queue(result_queue, *selected.p_impl);
             rpm_goal.add_install(result_queue, skip_broken, best, clean_requirements_on_remove);
         } else {
             if (add_obsoletes) {
@@ -1258,7 +1531,23 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
 
     rpm::PackageQuery installed(base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
     installed.filter_installed();
-    for (auto [action, ids, settings] : rpm_ids) {
+
+    // Installed packages indexed by name. The packages given by ids are matched against them instead of filtering
+    // a copy of the installed query for each of them.
+    std::unordered_map<Id, std::vector<Id>> installed_by_name;
+    if (!rpm_ids.empty()) {
+        for (auto package_id : *installed.p_impl) {
+            installed_by_name[pool.id2solvable(package_id)->name].push_back(package_id);
+        }
+    }
+    const std::vector<Id> no_installed;
+    auto get_installed_with_name = [&](Id id) -> const std::vector<Id> & {
+        auto it = installed_by_name.find(pool.id2solvable(id)->name);
+        return it == installed_by_name.end() ? no_installed : it->second;
+    };
+
+    for (auto [action, ids, shared_settings] : rpm_ids) {
+        auto & settings = get_job_settings(*shared_settings);
         switch (action) {
             case GoalAction::INSTALL: {
                 bool skip_broken = settings.resolve_skip_broken(cfg_main);
@@ -1303,9 +1592,17 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                 bool clean_requirements_on_remove = settings.resolve_clean_requirements_on_remove();
                 solv::IdQueue ids_nevra_installed;
                 for (auto id : ids) {
-                    rpm::PackageQuery query(installed);
-                    query.filter_nevra({pool.get_nevra(id)});
-                    if (query.empty()) {
+                    Solvable * solvable = pool.id2solvable(id);
+                    bool nevra_installed = false;
+                    for (auto installed_id : get_installed_with_name(id)) {
+                        Solvable * installed_solvable = pool.id2solvable(installed_id);
+                        if (installed_solvable->arch == solvable->arch &&
+                            pool.evrcmp(installed_solvable->evr, solvable->evr, EVRCMP_COMPARE) == 0) {
+                            nevra_installed = true;
+                            break;
+                        }
+                    }
+                    if (!nevra_installed) {
                         // Report when package with the same NEVRA is not installed
                         transaction.p_impl->add_resolve_log(
                             action,
@@ -1325,19 +1622,22 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
             case GoalAction::UPGRADE: {
                 bool best = settings.resolve_best(cfg_main);
                 bool clean_requirements_on_remove = settings.resolve_clean_requirements_on_remove();
+                // packages that obsolete an installed package are upgrades, find them for the whole batch at once
+                rpm::PackageQuery obsoleters(base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES, true);
+                if (cfg_main.get_obsoletes_option().get_value()) {
+                    for (auto id : ids) {
+                        obsoleters.p_impl->add_unsafe(id);
+                    }
+                    obsoleters.filter_obsoletes(installed);
+                }
                 // TODO(jrohel): Now logs all packages that are not upgrades. It can be confusing in some cases.
                 for (auto id : ids) {
-                    if (cfg_main.get_obsoletes_option().get_value()) {
-                        rpm::PackageQuery query_id(base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES, true);
-                        query_id.add(rpm::Package(base, rpm::PackageId(id)));
-                        query_id.filter_obsoletes(installed);
-                        if (!query_id.empty()) {
-                            continue;
-                        }
+                    if (obsoleters.p_impl->contains_unsafe(id)) {
+                        continue;
                     }
-                    rpm::PackageQuery query(installed);
-                    query.filter_name({pool.get_name(id)});
-                    if (query.empty()) {
+                    Solvable * solvable = pool.id2solvable(id);
+                    const auto & installed_with_name = get_installed_with_name(id);
+                    if (installed_with_name.empty()) {
                         // Report when package with the same name is not installed
                         transaction.p_impl->add_resolve_log(
                             action,
@@ -1350,9 +1650,16 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                         continue;
                     }
                     std::string arch = pool.get_arch(id);
-                    if (arch != "noarch") {
-                        query.filter_arch({arch, "noarch"});
-                        if (query.empty()) {
+                    std::vector<Id> installed_for_arch;
+                    for (auto installed_id : installed_with_name) {
+                        Id installed_arch = pool.id2solvable(installed_id)->arch;
+                        if (solvable->arch == ARCH_NOARCH || installed_arch == solvable->arch ||
+                            installed_arch == ARCH_NOARCH) {
+                            installed_for_arch.push_back(installed_id);
+                        }
+                    }
+                    if (solvable->arch != ARCH_NOARCH) {
+                        if (installed_for_arch.empty()) {
                             // Report when package with the same name is installed for a different architecture
                             // Conversion from/to "noarch" is allowed for upgrade.
                             transaction.p_impl->add_resolve_log(
@@ -1366,8 +1673,13 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                             continue;
                         }
                     }
-                    query.filter_evr({pool.get_evr(id)}, sack::QueryCmp::GTE);
-                    if (!query.empty()) {
+                    std::vector<Id> installed_higher_or_equal;
+                    for (auto installed_id : installed_for_arch) {
+                        if (pool.evrcmp(pool.id2solvable(installed_id)->evr, solvable->evr, EVRCMP_COMPARE) >= 0) {
+                            installed_higher_or_equal.push_back(installed_id);
+                        }
+                    }
+                    if (!installed_higher_or_equal.empty()) {
                         // Report when package with higher or equal version is installed
                         transaction.p_impl->add_resolve_log(
                             action,
@@ -1378,7 +1690,7 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                             {pool.get_name(id) + ("." + arch)},
                             libdnf5::Logger::Level::WARNING);
                         // include installed packages with higher or equal version into transaction to prevent downgrade
-                        for (auto installed_id : *query.p_impl) {
+                        for (auto installed_id : installed_higher_or_equal) {
                             ids.push_back(installed_id);
                         }
                     }
@@ -1393,9 +1705,9 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                 bool clean_requirements_on_remove = settings.resolve_clean_requirements_on_remove();
                 solv::IdQueue ids_downgrades;
                 for (auto id : ids) {
-                    rpm::PackageQuery query(installed);
-                    query.filter_name({pool.get_name(id)});
-                    if (query.empty()) {
+                    Solvable * solvable = pool.id2solvable(id);
+                    const auto & installed_with_name = get_installed_with_name(id);
+                    if (installed_with_name.empty()) {
                         // Report when package with the same name is not installed
                         transaction.p_impl->add_resolve_log(
                             action,
@@ -1407,8 +1719,13 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                             log_level);
                         continue;
                     }
-                    query.filter_arch({pool.get_arch(id)});
-                    if (query.empty()) {
+                    std::vector<Id> installed_for_arch;
+                    for (auto installed_id : installed_with_name) {
+                        if (pool.id2solvable(installed_id)->arch == solvable->arch) {
+                            installed_for_arch.push_back(installed_id);
+                        }
+                    }
+                    if (installed_for_arch.empty()) {
                         // Report when package with the same name is installed for a different architecture
                         transaction.p_impl->add_resolve_log(
                             action,
@@ -1420,8 +1737,14 @@ void Goal::Impl::add_rpms_to_goal(base::Transaction & transaction) {
                             log_level);
                         continue;
                     }
-                    query.filter_evr({pool.get_evr(id)}, sack::QueryCmp::LTE);
-                    if (!query.empty()) {
+                    bool installed_lower_or_equal = false;
+                    for (auto installed_id : installed_for_arch) {
+                        if (pool.evrcmp(pool.id2solvable(installed_id)->evr, solvable->evr, EVRCMP_COMPARE) <= 0) {
+                            installed_lower_or_equal = true;
+                            break;
+                        }
+                    }
+                    if (installed_lower_or_equal) {
                         // Report when package with lower or equal version is installed
                         std::string name_arch(pool.get_name(id));
                         name_arch.append(".");
@@ -1683,7 +2006,8 @@ GoalProblem Goal::Impl::add_up_down_distrosync_to_goal(
     return GoalProblem::NO_PROBLEM;
 }
 
-void Goal::Impl::install_group_package(base::Transaction & transaction, libdnf5::comps::Package pkg) {
+void Goal::Impl::install_group_packages(
+    base::Transaction & transaction, const std::vector<libdnf5::comps::Package> & packages) {
     auto pkg_settings = GoalJobSettings();
     pkg_settings.with_provides = false;
     pkg_settings.with_filenames = false;
@@ -1691,28 +2015,62 @@ void Goal::Impl::install_group_package(base::Transaction & transaction, libdnf5:
     pkg_settings.nevra_forms.push_back(rpm::Nevra::Form::NAME);
 
     // TODO(mblaha): apply pkg.basearchonly when available in comps
-    auto pkg_name = pkg.get_name();
-    auto pkg_condition = pkg.get_condition();
-    if (pkg_condition.empty()) {
-        auto [pkg_problem, pkg_queue] =
-            // TODO(mblaha): add_install_to_goal needs group spec for better problems reporting
-            add_install_to_goal(transaction, GoalAction::INSTALL_BY_COMPS, pkg_name, pkg_settings);
-        rpm_goal.add_transaction_group_installed(pkg_queue);
-    } else {
-        // check whether condition can even be met
-        rpm::PackageQuery condition_query(base);
-        condition_query.filter_name(std::vector<std::string>{pkg_condition});
-        if (!condition_query.empty()) {
-            // remember names to identify GROUP reason of conditional packages
-            rpm::PackageQuery query(base);
-            query.filter_name(std::vector<std::string>{pkg_name});
-            // TODO(mblaha): log absence of pkg in case the query is empty
-            if (!query.empty()) {
-                add_provide_install_to_goal(fmt::format("({} if {})", pkg_name, pkg_condition), pkg_settings);
-                rpm_goal.add_transaction_group_installed(*query.p_impl);
-            }
+    std::vector<std::pair<std::string, std::string>> conditional_packages;  // pairs <name, condition>
+    for (const auto & pkg : packages) {
+        auto pkg_name = pkg.get_name();
+        auto pkg_condition = pkg.get_condition();
+        if (pkg_condition.empty()) {
+            auto [pkg_problem, pkg_queue] =
+                // TODO(mblaha): add_install_to_goal needs group spec for better problems reporting
+                add_install_to_goal(transaction, GoalAction::INSTALL_BY_COMPS, pkg_name, pkg_settings);
+            rpm_goal.add_transaction_group_installed(pkg_queue);
+        } else {
+            conditional_packages.emplace_back(std::move(pkg_name), std::move(pkg_condition));
         }
     }
+
+    if (conditional_packages.empty()) {
+        return;
+    }
+
+    // The names of all the conditions and of all the conditional packages are each looked up in a single query
+    auto get_existing_names = [this](const std::vector<std::string> & names) {
+        rpm::PackageQuery query(base);
+        query.filter_name(names);
+        std::set<std::string> existing_names;
+        for (const auto & pkg : query) {
+            existing_names.insert(pkg.get_name());
+        }
+        return std::make_pair(std::move(query), std::move(existing_names));
+    };
+
+    std::vector<std::string> condition_names;
+    condition_names.reserve(conditional_packages.size());
+    for (const auto & [pkg_name, pkg_condition] : conditional_packages) {
+        condition_names.push_back(pkg_condition);
+    }
+    const auto existing_conditions = get_existing_names(condition_names).second;
+
+    // check whether condition can even be met
+    std::vector<std::string> pkg_names;
+    for (const auto & [pkg_name, pkg_condition] : conditional_packages) {
+        if (existing_conditions.contains(pkg_condition)) {
+            pkg_names.push_back(pkg_name);
+        }
+    }
+    if (pkg_names.empty()) {
+        return;
+    }
+    auto [query, existing_pkg_names] = get_existing_names(pkg_names);
+
+    // TODO(mblaha): log absence of pkg in case the query is empty
+    for (const auto & [pkg_name, pkg_condition] : conditional_packages) {
+        if (existing_conditions.contains(pkg_condition) && existing_pkg_names.contains(pkg_name)) {
+            add_provide_install_to_goal(fmt::format("({} if {})", pkg_name, pkg_condition), pkg_settings);
+        }
+    }
+    // remember names to identify GROUP reason of conditional packages
+    rpm_goal.add_transaction_group_installed(*query.p_impl);
 }
 
 void Goal::Impl::remove_group_packages(const rpm::PackageSet & remove_candidates) {
@@ -1769,9 +2127,7 @@ void Goal::Impl::add_group_install_to_goal(
                 packages.emplace_back(std::move(p));
             }
         }
-        for (const auto & pkg : packages) {
-            install_group_package(transaction, pkg);
-        }
+        install_group_packages(transaction, packages);
     }
 }
 
@@ -1838,20 +2194,20 @@ void Goal::Impl::add_group_upgrade_to_goal(
     auto & system_state = base->p_impl->get_system_state();
     auto & cfg_main = base->get_config();
     auto allowed_package_types = settings.resolve_group_package_types(cfg_main);
+    auto & comps_delta = get_comps_upgrade_delta();
 
-    comps::GroupQuery available_groups(base);
-    available_groups.filter_installed(false);
+    auto pkg_settings = GoalJobSettings();
+    pkg_settings.with_provides = false;
+    pkg_settings.with_filenames = false;
+    pkg_settings.with_binaries = false;
+    pkg_settings.nevra_forms.push_back(rpm::Nevra::Form::NAME);
 
-    rpm::PackageQuery query_installed(base);
-    query_installed.filter_installed();
-    rpm::PackageSet remove_candidates(base);
+    std::vector<std::string> removed_package_names;
 
     for (auto installed_group : group_query) {
         auto group_id = installed_group.get_groupid();
-        // find available group of the same id
-        comps::GroupQuery available_group_query(available_groups);
-        available_group_query.filter_groupid(group_id);
-        if (available_group_query.empty()) {
+        const auto & delta = comps_delta.get_group_delta(installed_group);
+        if (!delta.available_group) {
             // group is not available any more
             transaction.p_impl->add_resolve_log(
                 GoalAction::UPGRADE,
@@ -1863,10 +2219,9 @@ void Goal::Impl::add_group_upgrade_to_goal(
                 libdnf5::Logger::Level::WARNING);
             continue;
         }
-        auto available_group = available_group_query.get();
         // upgrade the group itself
         rpm_goal.add_group(
-            available_group,
+            *delta.available_group,
             transaction::TransactionItemAction::UPGRADE,
             installed_group.get_reason(),
             allowed_package_types);
@@ -1877,48 +2232,39 @@ void Goal::Impl::add_group_upgrade_to_goal(
 
         auto state_group = system_state.get_group_state(group_id);
 
-        // set of package names that are part of the installed version of the group
-        std::set<std::string> old_set{};
-        for (const auto & pkg : installed_group.get_packages()) {
-            old_set.emplace(pkg.get_name());
-        }
-        // set of package names that are part of the available version of the group
-        std::set<std::string> new_set{};
-        for (const auto & pkg : available_group.get_packages()) {
-            new_set.emplace(pkg.get_name());
-        }
-
         // install packages newly added to the group
-        for (const auto & pkg : available_group.get_packages_of_type(state_group.package_types)) {
-            if (!old_set.contains(pkg.get_name())) {
-                install_group_package(transaction, pkg);
+        std::vector<libdnf5::comps::Package> added_packages;
+        for (const auto & pkg : delta.added_packages) {
+            if (any(pkg.get_type() & state_group.package_types)) {
+                added_packages.emplace_back(pkg);
             }
         }
+        install_group_packages(transaction, added_packages);
 
-        auto pkg_settings = GoalJobSettings();
-        pkg_settings.with_provides = false;
-        pkg_settings.with_filenames = false;
-        pkg_settings.with_binaries = false;
         for (const auto & pkg_name : state_group.packages) {
-            if (new_set.contains(pkg_name)) {
+            if (delta.available_package_names.contains(pkg_name)) {
                 // upgrade all packages installed with the group
-                pkg_settings.nevra_forms.push_back(rpm::Nevra::Form::NAME);
                 add_up_down_distrosync_to_goal(transaction, GoalAction::UPGRADE, pkg_name, pkg_settings);
             } else {
                 // remove those packages that are not part of the group any more
-                // and are not user-installed
-                rpm::PackageQuery query(query_installed);
-                auto nevra_pair = query.resolve_pkg_spec(pkg_name, pkg_settings, false);
-                if (nevra_pair.first) {
-                    for (const auto & pkg : query) {
-                        if (pkg.get_reason() <= transaction::TransactionItemReason::GROUP) {
-                            remove_candidates.add(pkg);
-                        }
-                    }
-                }
+                removed_package_names.push_back(pkg_name);
             }
         }
     }
+
+    if (removed_package_names.empty()) {
+        return;
+    }
+
+    // remove only packages that are not user-installed
+    rpm::PackageQuery query(comps_delta.get_installed_packages());
+    query.filter_name(removed_package_names);
+    rpm::PackageSet remove_candidates(base);
+    for (const auto & pkg : query) {
+        if (pkg.get_reason() <= transaction::TransactionItemReason::GROUP) {
+            remove_candidates.add(pkg);
+        }
+    }
     if (!remove_candidates.empty()) {
         remove_group_packages(remove_candidates);
     }
@@ -2012,13 +2358,7 @@ void Goal::Impl::add_environment_remove_to_goal(
 void Goal::Impl::add_environment_upgrade_to_goal(
     base::Transaction & transaction, comps::EnvironmentQuery environment_query, GoalJobSettings & settings) {
     auto & system_state = base->p_impl->get_system_state();
-
-    comps::EnvironmentQuery available_environments(base);
-    available_environments.filter_installed(false);
-
-    comps::GroupQuery query_installed(base);
-    query_installed.filter_installed(true);
-    std::vector<GroupSpec> remove_group_specs;
+    auto & comps_delta = get_comps_upgrade_delta();
 
     std::vector<GroupSpec> env_group_specs;
     auto group_settings = libdnf5::GoalJobSettings(settings);
@@ -2027,10 +2367,8 @@ void Goal::Impl::add_environment_upgrade_to_goal(
 
     for (auto installed_environment : environment_query) {
         auto environment_id = installed_environment.get_environmentid();
-        // find available environment of the same id
-        comps::EnvironmentQuery available_environment_query(available_environments);
-        available_environment_query.filter_environmentid(environment_id);
-        if (available_environment_query.empty()) {
+        const auto & delta = comps_delta.get_environment_delta(installed_environment);
+        if (!delta.available_environment) {
             // environment is not available any more
             transaction.p_impl->add_resolve_log(
                 GoalAction::UPGRADE,
@@ -2042,70 +2380,42 @@ void Goal::Impl::add_environment_upgrade_to_goal(
                 libdnf5::Logger::Level::WARNING);
             continue;
         }
-        auto available_environment = available_environment_query.get();
 
         // upgrade the environment itself
-        rpm_goal.add_environment(available_environment, transaction::TransactionItemAction::UPGRADE, {});
+        rpm_goal.add_environment(*delta.available_environment, transaction::TransactionItemAction::UPGRADE, {});
 
-        // group names that are part of the installed version of the environment
-        auto old_groups = installed_environment.get_groups();
-
-        // group names that are part of the new version of the environment
-        auto available_groups = available_environment.get_groups();
-
-        for (const auto & grp : available_groups) {
-            if (std::find(old_groups.begin(), old_groups.end(), grp) != old_groups.end()) {
-                // the group was already part of environment definition when it was installed.
-                // upgrade the group if is installed
-                try {
-                    auto group_state = system_state.get_group_state(grp);
-                    env_group_specs.emplace_back(
-                        GoalAction::UPGRADE, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
-                } catch (const system::StateNotFoundError &) {
-                    continue;
-                }
-            } else {
-                // newly added group to environment definition, install it.
+        // groups that were already part of environment definition when it was installed
+        // are upgraded if they are installed
+        for (const auto & grp : delta.kept_groups) {
+            try {
+                auto group_state = system_state.get_group_state(grp);
                 env_group_specs.emplace_back(
-                    GoalAction::INSTALL_BY_COMPS, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
+                    GoalAction::UPGRADE, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
+            } catch (const system::StateNotFoundError &) {
+                continue;
             }
         }
 
-        // upgrade also installed optional groups
-        auto old_optionals = installed_environment.get_optional_groups();
-        old_groups.insert(old_groups.end(), old_optionals.begin(), old_optionals.end());
-        for (const auto & grp : available_environment.get_optional_groups()) {
-            available_groups.emplace_back(grp);
-            if (std::find(old_groups.begin(), old_groups.end(), grp) != old_groups.end()) {
-                try {
-                    auto group_state = system_state.get_group_state(grp);
-                    env_group_specs.emplace_back(
-                        GoalAction::UPGRADE, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
-                } catch (const system::StateNotFoundError &) {
-                    continue;
-                }
-            }
+        // newly added groups to environment definition are installed
+        for (const auto & grp : delta.added_groups) {
+            env_group_specs.emplace_back(
+                GoalAction::INSTALL_BY_COMPS, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
         }
 
         // remove non-userinstalled groups that are not part of environment any more
-        for (const auto & grp : old_groups) {
-            if (std::find(available_groups.begin(), available_groups.end(), grp) == available_groups.end()) {
-                try {
-                    auto group_state = system_state.get_group_state(grp);
-                    if (!group_state.userinstalled) {
-                        auto grp_environments = system_state.get_group_environments(grp);
-                        grp_environments.erase(environment_id);
-                        if (grp_environments.empty()) {
-                            env_group_specs.emplace_back(
-                                GoalAction::REMOVE,
-                                transaction::TransactionItemReason::DEPENDENCY,
-                                grp,
-                                group_settings);
-                        }
+        for (const auto & grp : delta.removed_groups) {
+            try {
+                auto group_state = system_state.get_group_state(grp);
+                if (!group_state.userinstalled) {
+                    auto grp_environments = system_state.get_group_environments(grp);
+                    grp_environments.erase(environment_id);
+                    if (grp_environments.empty()) {
+                        env_group_specs.emplace_back(
+                            GoalAction::REMOVE, transaction::TransactionItemReason::DEPENDENCY, grp, group_settings);
                     }
-                } catch (const system::StateNotFoundError &) {
-                    continue;
                 }
+            } catch (const system::StateNotFoundError &) {
+                continue;
             }
         }
     }
@@ -2195,7 +2505,18 @@ void Goal::Impl::autodetect_unsatisfied_installed_weak_dependencies() {
         return;
     }
     rpm::PackageQuery base_query(base, rpm::PackageQuery::ExcludeFlags::APPLY_EXCLUDES);
-    rpm::ReldepList reldep_list(base);
+    auto & rpm_pool = get_rpm_pool(base);
+    // FOR_PROVIDES needs the libsolv pool named `pool`
+    ::Pool * pool = *rpm_pool;
+    base->get_rpm_package_sack()->p_impl->make_provides_ready();
+
+    // Providers are looked up directly in the whatprovides index and tested against these maps,
+    // the same recommends are usually shared by many installed packages
+    const auto & available_map = *base_query.p_impl;
+    const auto & installed_map = *installed_query.p_impl;
+    libdnf5::solv::SolvMap exclude_from_weak(rpm_pool.get_nsolvables());
+    bool has_exclude_from_weak = false;
+    std::unordered_set<Id> investigated_recommends;
 
     std::vector<std::string> installed_names;
     installed_names.reserve(installed_query.size());
@@ -2204,32 +2525,45 @@ void Goal::Impl::autodetect_unsatisfied_installed_weak_dependencies() {
     for (const auto & pkg : installed_query) {
         installed_names.push_back(pkg.get_name());
         for (const auto & recommend : pkg.get_recommends()) {
+            if (!investigated_recommends.insert(recommend.get_id().id).second) {
+                continue;
+            }
             if (libdnf5::rpm::Reldep::is_rich_dependency(recommend.to_string())) {
                 // Rich dependencies are skipped because they are too complicated to provide correct result
                 continue;
             };
-            rpm::PackageQuery query(base_query);
 
             //  There can be installed provider in a different version or upgraded package can recommend a different
             //  version therefore ignore the version and to search only using reldep name
+            Id dep_id;
             if (auto version = recommend.get_version(); version && strlen(version) > 0) {
-                auto & pool = get_rpm_pool(base);
-                Id id = pool.str2id(recommend.get_name(), 0);
-                reldep_list.add(rpm::ReldepId(id));
+                dep_id = rpm_pool.str2id(recommend.get_name(), 0);
             } else {
-                reldep_list.add(recommend);
+                dep_id = recommend.get_id().id;
             };
-            query.filter_provides(reldep_list);
-            reldep_list.clear();
-            // No providers of recommend => continue
-            if (query.empty()) {
-                continue;
+
+            bool has_provider = false;
+            bool has_installed_provider = false;
+            Id p;
+            Id pp;
+            FOR_PROVIDES(p, pp, dep_id) {
+                if (!available_map.contains_unsafe(p)) {
+                    continue;
+                }
+                has_provider = true;
+                if (installed_map.contains_unsafe(p)) {
+                    has_installed_provider = true;
+                    break;
+                }
             }
-            rpm::PackageQuery test_installed(query);
-            test_installed.filter_installed();
             // when there is not installed any provider of recommend, exclude it
-            if (test_installed.empty()) {
-                rpm_goal.add_exclude_from_weak(*query.p_impl);
+            if (has_provider && !has_installed_provider) {
+                FOR_PROVIDES(p, pp, dep_id) {
+                    if (available_map.contains_unsafe(p)) {
+                        exclude_from_weak.add_unsafe(p);
+                    }
+                }
+                has_exclude_from_weak = true;
             }
         }
     }
@@ -2239,31 +2573,30 @@ void Goal::Impl::autodetect_unsatisfied_installed_weak_dependencies() {
     base_query.filter_name(installed_names, sack::QueryCmp::NEQ);
     // We have to remove all installed packages from testing set
     base_query -= installed_query;
-    rpm::PackageSet exclude_supplements(base);
     for (const auto & pkg : base_query) {
-        auto supplements = pkg.get_supplements();
-        if (supplements.empty()) {
-            continue;
-        }
-        for (const auto & supplement : supplements) {
+        for (const auto & supplement : pkg.get_supplements()) {
             if (libdnf5::rpm::Reldep::is_rich_dependency(supplement.to_string())) {
                 // Rich dependencies are skipped because they are too complicated to provide correct result
                 continue;
             };
-            reldep_list.add(supplement);
-        }
-        if (reldep_list.empty()) {
-            continue;
-        }
-        rpm::PackageQuery query(installed_query);
-        query.filter_provides(reldep_list);
-        reldep_list.clear();
-        if (!query.empty()) {
-            exclude_supplements.add(pkg);
+            bool supplements_installed = false;
+            Id p;
+            Id pp;
+            FOR_PROVIDES(p, pp, supplement.get_id().id) {
+                if (installed_map.contains_unsafe(p)) {
+                    supplements_installed = true;
+                    break;
+                }
+            }
+            if (supplements_installed) {
+                exclude_from_weak.add_unsafe(pkg.get_id().id);
+                has_exclude_from_weak = true;
+                break;
+            }
         }
     }
-    if (!exclude_supplements.empty()) {
-        rpm_goal.add_exclude_from_weak(*exclude_supplements.p_impl);
+    if (has_exclude_from_weak) {
+        rpm_goal.add_exclude_from_weak(exclude_from_weak);
     }
 }
 
@@ -2278,6 +2611,8 @@ bool Goal::get_allow_erasing() const {
 base::Transaction Goal::resolve() {
     libdnf_user_assert(p_impl->base->is_initialized(), "Base instance was not fully initialized by Base::setup()");
 
+    TraceSpan span(*p_impl->base, "goal_resolve");
+
     p_impl->rpm_goal = rpm::solv::GoalPrivate(p_impl->base);
 
     base::Transaction transaction(p_impl->base);
@@ -2311,6 +2646,9 @@ base::Transaction Goal::resolve() {
     ret |= p_impl->add_specs_to_goal(transaction);
     p_impl->add_rpms_to_goal(transaction);
 
+    // The comps upgrade state is computed for this resolve only
+    p_impl->comps_upgrade_delta.reset();
+
     // Resolve group specs to group/environment queries first for two reasons:
     // 1. group spec can also contain an environmental groups
     // 2. group removal needs a list of all groups being removed to correctly remove packages
@@ -2321,6 +2659,7 @@ base::Transaction Goal::resolve() {
 
     // Then handle groups
     p_impl->add_resolved_group_specs_to_goal(transaction);
+    p_impl->comps_upgrade_delta.reset();
 
     ret |= p_impl->add_reason_change_specs_to_goal(transaction);
 
@@ -2335,34 +2674,21 @@ base::Transaction Goal::resolve() {
         p_impl->rpm_goal.set_protected_running_kernel(sack->p_impl->get_running_kernel_id());
     }
 
+    // The solver inputs derived from the system state and configuration are shared by the goals of the Base
+    auto & solver_cache = InternalBaseUser::get_solver_cache(p_impl->base);
+
     // Set user-installed packages (installed packages with reason USER or GROUP)
     // proceed only if the transaction could result in removal of unused dependencies
     if (p_impl->rpm_goal.is_clean_deps_present()) {
-        libdnf5::solv::IdQueue user_installed_packages;
-        rpm::PackageQuery installed_query(p_impl->base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-        installed_query.filter_installed();
-        for (const auto & pkg : installed_query) {
-            if (pkg.get_reason() > transaction::TransactionItemReason::DEPENDENCY) {
-                user_installed_packages.push_back(pkg.get_id().id);
-            }
-        }
-        p_impl->rpm_goal.set_user_installed_packages(std::move(user_installed_packages));
+        p_impl->rpm_goal.set_user_installed_packages(solver_cache.get_user_installed_packages());
     }
 
     // Add protected packages
-    {
-        auto & protected_packages = cfg_main.get_protected_packages_option().get_value();
-        rpm::PackageQuery protected_query(p_impl->base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-        protected_query.filter_name(protected_packages);
-        p_impl->rpm_goal.add_protected_packages(*protected_query.p_impl);
-    }
+    p_impl->rpm_goal.add_protected_packages(solver_cache.get_protected_packages());
 
     // Set installonly packages
-    {
-        auto & installonly_packages = cfg_main.get_installonlypkgs_option().get_value();
-        p_impl->rpm_goal.set_installonly(installonly_packages);
-        p_impl->rpm_goal.set_installonly_limit(cfg_main.get_installonly_limit_option().get_value());
-    }
+    p_impl->rpm_goal.set_installonly(solver_cache.get_installonly());
+    p_impl->rpm_goal.set_installonly_limit(cfg_main.get_installonly_limit_option().get_value());
 
     // Set exclude weak dependencies from configuration
     {
@@ -2418,6 +2744,8 @@ void Goal::reset() {
     p_impl->rpm_ids.clear();
     p_impl->group_specs.clear();
     p_impl->rpm_filepaths.clear();
+    p_impl->interned_settings.clear();
+    p_impl->last_interned_settings.reset();
     p_impl->resolved_group_specs.clear();
     p_impl->resolved_environment_specs.clear();
     p_impl->rpm_goal = rpm::solv::GoalPrivate(p_impl->base);
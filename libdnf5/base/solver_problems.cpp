@@ -25,6 +25,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 #include "libdnf5/utils/format.hpp"
 
+#include <algorithm>
+#include <set>
+
 
 namespace libdnf5::base {
 
@@ -90,26 +93,13 @@ bool is_unique(
     return true;
 }
 
-bool is_unique(
-    const std::vector<std::vector<std::pair<ProblemRules, std::vector<std::string>>>> & problems,
-    const std::vector<std::pair<ProblemRules, std::vector<std::string>>> & new_element) {
-    auto new_element_size = new_element.size();
-    for (auto const & element : problems) {
-        if (element.size() != new_element_size) {
-            continue;
-        }
-        bool identical = true;
-        for (auto & [rule, strings] : element) {
-            if (is_unique(new_element, rule, strings)) {
-                identical = false;
-                break;
-            }
-        }
-        if (identical) {
-            return false;
-        }
-    }
-    return true;
+/// Returns the rules of a problem in a canonical order. Problems are the same if they contain the same rules
+/// regardless of their order.
+std::vector<std::pair<ProblemRules, std::vector<std::string>>> sorted_problem(
+    const std::vector<std::pair<ProblemRules, std::vector<std::string>>> & problem) {
+    auto sorted = problem;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
 }
 
 std::vector<std::pair<ProblemRules, std::vector<std::string>>> get_removal_of_protected(
@@ -275,6 +265,8 @@ std::vector<std::vector<std::pair<libdnf5::ProblemRules, std::vector<std::string
     auto solver_problems = solved_goal.get_problems();
 
     std::vector<std::vector<std::pair<libdnf5::ProblemRules, std::vector<std::string>>>> problems;
+    // The already seen problems in a canonical form, avoids comparing each new problem with all previous ones
+    std::set<std::vector<std::pair<libdnf5::ProblemRules, std::vector<std::string>>>> seen_problems;
 
     for (auto & problem : solver_problems) {
         std::vector<std::pair<ProblemRules, std::vector<std::string>>> problem_output;
@@ -348,13 +340,13 @@ std::vector<std::vector<std::pair<libdnf5::ProblemRules, std::vector<std::string
                 problem_output.push_back(std::make_pair(tmp_rule, std::move(elements)));
             }
         }
-        if (is_unique(problems, problem_output)) {
+        if (seen_problems.insert(sorted_problem(problem_output)).second) {
             problems.push_back(std::move(problem_output));
         }
     }
     auto problem_protected = get_removal_of_protected(solved_goal, broken_installed);
     if (!problem_protected.empty()) {
-        if (is_unique(problems, problem_protected)) {
+        if (!seen_problems.contains(sorted_problem(problem_protected))) {
             problems.insert(problems.begin(), std::move(problem_protected));
         }
     }
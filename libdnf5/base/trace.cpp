@@ -0,0 +1,52 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "libdnf5/base/trace.hpp"
+
+#include "libdnf5/base/base.hpp"
+
+
+namespace libdnf5 {
+
+TraceSpan::TraceSpan(Base & base, const char * name) : exporter(base.get_trace_exporter()), name(name) {
+    if (exporter) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+
+TraceSpan::~TraceSpan() {
+    if (exporter) {
+        try {
+            exporter->export_span(name, start, std::chrono::steady_clock::now(), attributes);
+        } catch (...) {
+            // a failing exporter must not break the traced work
+        }
+    }
+}
+
+
+void TraceSpan::set_attribute(std::string key, std::string value) {
+    if (exporter) {
+        attributes.emplace_back(std::move(key), std::move(value));
+    }
+}
+
+}  // namespace libdnf5
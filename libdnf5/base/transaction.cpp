@@ -44,11 +44,15 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <fmt/format.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <ranges>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 
 namespace libdnf5::base {
@@ -119,7 +123,8 @@ Transaction::Impl::Impl(Transaction & transaction, const Impl & src)
       module_db(src.module_db),
       resolve_logs(src.resolve_logs),
       transaction_problems(src.transaction_problems),
-      signature_problems(src.signature_problems) {}
+      signature_problems(src.signature_problems),
+      run_phase_durations(src.run_phase_durations) {}
 
 Transaction::Impl & Transaction::Impl::operator=(const Impl & other) {
     base = other.base;
@@ -134,6 +139,7 @@ Transaction::Impl & Transaction::Impl::operator=(const Impl & other) {
     resolve_logs = other.resolve_logs;
     transaction_problems = other.transaction_problems;
     signature_problems = other.signature_problems;
+    run_phase_durations = other.run_phase_durations;
     return *this;
 }
 
@@ -145,6 +151,10 @@ std::vector<TransactionPackage> Transaction::get_transaction_packages() const {
     return p_impl->packages;
 }
 
+const std::vector<TransactionPackage> & Transaction::get_transaction_packages_ref() const {
+    return p_impl->packages;
+}
+
 std::size_t Transaction::get_transaction_packages_count() const {
     return p_impl->packages.size();
 }
@@ -303,7 +313,7 @@ std::string Transaction::transaction_result_to_string(const TransactionRunResult
 
 void Transaction::download() {
     libdnf5::repo::PackageDownloader downloader(p_impl->base);
-    for (auto & tspkg : this->get_transaction_packages()) {
+    for (const auto & tspkg : p_impl->packages) {
         if (transaction_item_action_is_inbound(tspkg.get_action()) &&
             tspkg.get_package().get_repo()->get_type() != libdnf5::repo::Repo::Type::COMMANDLINE) {
             downloader.add(tspkg.get_package());
@@ -324,6 +334,10 @@ std::vector<std::string> Transaction::get_transaction_problems() const noexcept
     return p_impl->transaction_problems;
 }
 
+std::vector<std::pair<std::string, std::chrono::microseconds>> Transaction::get_run_phase_durations() const noexcept {
+    return p_impl->run_phase_durations;
+}
+
 void Transaction::set_callbacks(std::unique_ptr<libdnf5::rpm::TransactionCallbacks> && callbacks) {
     this->callbacks = std::move(callbacks);
 }
@@ -575,12 +589,35 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
         return TransactionRunResult::ERROR_RERUN;
     }
 
+    TraceSpan span(*base, test_only ? "transaction_test" : "transaction_run");
+
+    // record how long each phase takes, closing a phase starts the next one
+    run_phase_durations.clear();
+    auto phase_start = std::chrono::steady_clock::now();
+    auto end_phase = [&](const char * phase) {
+        auto phase_end = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(phase_end - phase_start);
+        run_phase_durations.emplace_back(phase, duration);
+        base->get_logger()->debug("Transaction phase \"{}\" took {} ms", phase, duration.count() / 1000.0);
+        if (auto * trace_exporter = base->get_trace_exporter()) {
+            try {
+                trace_exporter->export_span(
+                    fmt::format("transaction_{}", phase).c_str(), phase_start, phase_end, {{"phase", phase}});
+            } catch (...) {
+                // a failing exporter must not break the transaction
+            }
+        }
+        phase_start = phase_end;
+    };
+
     // only successfully resolved transaction can be run
     if (transaction->get_problems() != libdnf5::GoalProblem::NO_PROBLEM) {
         return TransactionRunResult::ERROR_RESOLVE;
     }
 
-    if (!check_gpg_signatures()) {
+    bool gpg_check_passed = check_gpg_signatures();
+    end_phase("gpg_check");
+    if (!gpg_check_passed) {
         return TransactionRunResult::ERROR_GPG_CHECK;
     }
 
@@ -592,14 +629,19 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
     std::filesystem::create_directories(lock_file_path.parent_path());
 
     libdnf5::utils::Locker locker(lock_file_path);
-    if (!locker.write_lock()) {
+    bool locked = locker.write_lock();
+    end_phase("lock");
+    if (!locked) {
         return TransactionRunResult::ERROR_LOCK;
     }
 
     // fill and check the rpm transaction
     libdnf5::rpm::Transaction rpm_transaction(base);
     rpm_transaction.fill(*transaction);
-    if (!rpm_transaction.check()) {
+    end_phase("fill");
+    bool check_passed = rpm_transaction.check();
+    end_phase("check");
+    if (!check_passed) {
         for (auto it : rpm_transaction.get_problems()) {
             transaction_problems.emplace_back(it.to_string());
         }
@@ -632,6 +674,7 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
     //TODO(jrohel): Do we want callbacks for transaction test?
     //rpm_transaction.set_callbacks(std::move(callbacks));
     auto ret = rpm_transaction.run();
+    end_phase("test");
     if (ret != 0) {
         for (auto it : rpm_transaction.get_problems()) {
             transaction_problems.emplace_back(it.to_string());
@@ -646,6 +689,7 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
 
     auto & plugins = base->p_impl->get_plugins();
     plugins.pre_transaction(*transaction);
+    end_phase("pre_transaction");
 
     // start history db transaction
     auto db_transaction = libdnf5::transaction::Transaction(base);
@@ -706,6 +750,7 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
     auto time = std::chrono::system_clock::now().time_since_epoch();
     db_transaction.set_dt_start(std::chrono::duration_cast<std::chrono::seconds>(time).count());
     db_transaction.start();
+    end_phase("history_start");
 
 
     auto logger = base->get_logger().get();
@@ -743,6 +788,7 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
     rpm_transaction.set_script_out_fd(-1);
 
     thread_processes_scriptlets_output.join();
+    end_phase("rpm_run");
 
     // TODO(mblaha): Handle ret == -1 and ret > 0, fill problems list
 
@@ -753,10 +799,13 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
         rpm::PackageQuery installed_query(base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
         installed_query.filter_installed();
         std::set<std::string> inbound_packages_reason_group{};
+        // Names of packages whose reason changes to GROUP, per group id. The group states are updated once
+        // per group instead of copying the state for every package.
+        std::map<std::string, std::vector<std::string>> reason_change_group_packages;
 
         // Iterate in reverse, inbound actions are first in the vector, we want to process outbound first
         for (auto it = packages.rbegin(); it != packages.rend(); ++it) {
-            auto tspkg = *it;
+            const auto & tspkg = *it;
             const auto & pkg = tspkg.get_package();
             auto tspkg_reason = tspkg.get_reason();
             if (transaction_item_action_is_inbound(tspkg.get_action())) {
@@ -799,15 +848,18 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
                 system_state.remove_package_nevra_state(pkg.get_nevra());
             } else if (tspkg.get_action() == TransactionPackage::Action::REASON_CHANGE) {
                 if (tspkg_reason == transaction::TransactionItemReason::GROUP) {
-                    auto group_id = *tspkg.get_reason_change_group_id();
-                    auto state = system_state.get_group_state(group_id);
-                    state.packages.emplace_back(pkg.get_name());
-                    system_state.set_group_state(group_id, state);
+                    reason_change_group_packages[*tspkg.get_reason_change_group_id()].emplace_back(pkg.get_name());
                 } else {
                     system_state.set_package_reason(pkg.get_na(), tspkg_reason);
                 }
             }
         }
+        for (auto & [group_id, names] : reason_change_group_packages) {
+            auto state = system_state.get_group_state(group_id);
+            state.packages.insert(
+                state.packages.end(), std::make_move_iterator(names.begin()), std::make_move_iterator(names.end()));
+            system_state.set_group_state(group_id, state);
+        }
 
         // Set correct system state for groups in the transaction
         auto comps_xml_dir = system_state.get_group_xml_dir();
@@ -882,6 +934,7 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
         system_state.set_rpmdb_cookie(rpm_transaction.get_db_cookie());
 
         system_state.save();
+        end_phase("system_state");
     }
 
     // finish history db transaction
@@ -892,8 +945,10 @@ Transaction::TransactionRunResult Transaction::Impl::_run(
     db_transaction.set_rpmdb_version_end(rpm_transaction.get_db_cookie());
     db_transaction.finish(
         ret == 0 ? libdnf5::transaction::TransactionState::OK : libdnf5::transaction::TransactionState::ERROR);
+    end_phase("history_finish");
 
     plugins.post_transaction(*transaction);
+    end_phase("post_transaction");
 
     if (ret == 0) {
         // removes any temporarily stored packages from the system
@@ -1000,52 +1055,69 @@ bool Transaction::Impl::check_gpg_signatures() {
     libdnf5::rpm::RpmSignature rpm_signature(base);
     std::set<std::string> processed_repos{};
     int num_checks_skipped = 0;
+
+    std::vector<rpm::Package> inbound_packages;
     for (const auto & trans_pkg : packages) {
         if (transaction_item_action_is_inbound(trans_pkg.get_action())) {
-            auto const & pkg = trans_pkg.get_package();
-            auto repo = pkg.get_repo();
-            auto err_msg = utils::sformat(
-                _("PGP check for package \"{}\" ({}) from repo \"{}\" has failed: "),
-                pkg.get_nevra(),
-                pkg.get_package_path(),
-                repo->get_id());
-            auto check_result = rpm_signature.check_package_signature(pkg);
-            if (check_result == libdnf5::rpm::RpmSignature::CheckResult::SKIPPED) {
-                num_checks_skipped += 1;
-            } else if (check_result != libdnf5::rpm::RpmSignature::CheckResult::OK) {
-                // these two errors are possibly recoverable by importing the correct public key
-                auto is_error_recoverable =
-                    check_result == libdnf5::rpm::RpmSignature::CheckResult::FAILED_KEY_MISSING ||
-                    check_result == libdnf5::rpm::RpmSignature::CheckResult::FAILED_NOT_TRUSTED;
-                if (is_error_recoverable) {
-                    // do not try to import keys for the same repo twice
-                    auto repo_id = repo->get_id();
-                    if (processed_repos.contains(repo_id)) {
-                        signature_problems.push_back(
-                            err_msg + import_repo_keys_result_to_string(ImportRepoKeysResult::ALREADY_PRESENT));
-                        result = false;
-                        break;
-                    }
-                    processed_repos.emplace(repo_id);
-
-                    auto import_result = import_repo_keys(*repo);
-                    if (import_result == ImportRepoKeysResult::OK) {
-                        auto check_again = rpm_signature.check_package_signature(pkg);
-                        if (check_again != libdnf5::rpm::RpmSignature::CheckResult::OK) {
-                            signature_problems.push_back(err_msg + _("Import of the key didn't help, wrong key?"));
-                            result = false;
-                            break;
-                        }
-                    } else {
-                        signature_problems.push_back(err_msg + import_repo_keys_result_to_string(import_result));
+            inbound_packages.push_back(trans_pkg.get_package());
+        }
+    }
+
+    // verify all the packages at once, the rpm keyring does not have to be loaded for each of them
+    auto check_results = rpm_signature.check_package_signatures(inbound_packages);
+    bool keys_imported{false};
+
+    // these two errors are possibly recoverable by importing the correct public key
+    auto is_error_recoverable = [](libdnf5::rpm::RpmSignature::CheckResult check_result) {
+        return check_result == libdnf5::rpm::RpmSignature::CheckResult::FAILED_KEY_MISSING ||
+               check_result == libdnf5::rpm::RpmSignature::CheckResult::FAILED_NOT_TRUSTED;
+    };
+
+    for (size_t idx = 0; idx < inbound_packages.size(); ++idx) {
+        auto const & pkg = inbound_packages[idx];
+        auto repo = pkg.get_repo();
+        auto err_msg = utils::sformat(
+            _("PGP check for package \"{}\" ({}) from repo \"{}\" has failed: "),
+            pkg.get_nevra(),
+            pkg.get_package_path(),
+            repo->get_id());
+        auto check_result = check_results[idx];
+        if (keys_imported && is_error_recoverable(check_result)) {
+            // the package was verified before the keys were imported
+            check_result = rpm_signature.check_package_signature(pkg);
+        }
+        if (check_result == libdnf5::rpm::RpmSignature::CheckResult::SKIPPED) {
+            num_checks_skipped += 1;
+        } else if (check_result != libdnf5::rpm::RpmSignature::CheckResult::OK) {
+            if (is_error_recoverable(check_result)) {
+                // do not try to import keys for the same repo twice
+                auto repo_id = repo->get_id();
+                if (processed_repos.contains(repo_id)) {
+                    signature_problems.push_back(
+                        err_msg + import_repo_keys_result_to_string(ImportRepoKeysResult::ALREADY_PRESENT));
+                    result = false;
+                    break;
+                }
+                processed_repos.emplace(repo_id);
+
+                auto import_result = import_repo_keys(*repo);
+                if (import_result == ImportRepoKeysResult::OK) {
+                    keys_imported = true;
+                    auto check_again = rpm_signature.check_package_signature(pkg);
+                    if (check_again != libdnf5::rpm::RpmSignature::CheckResult::OK) {
+                        signature_problems.push_back(err_msg + _("Import of the key didn't help, wrong key?"));
                         result = false;
                         break;
                     }
                 } else {
-                    signature_problems.push_back(err_msg + rpm_signature.check_result_to_string(check_result));
+                    signature_problems.push_back(err_msg + import_repo_keys_result_to_string(import_result));
                     result = false;
                     break;
                 }
+            } else {
+                signature_problems.push_back(err_msg + rpm_signature.check_result_to_string(check_result));
+                result = false;
+                break;
             }
         }
     }
@@ -1059,7 +1131,7 @@ bool Transaction::Impl::check_gpg_signatures() {
 std::string Transaction::serialize() {
     transaction::TransactionReplay transaction_replay;
 
-    for (const auto & pkg : get_transaction_packages()) {
+    for (const auto & pkg : p_impl->packages) {
         transaction::PackageReplay package_replay;
 
         const auto & rpm_pkg = pkg.get_package();
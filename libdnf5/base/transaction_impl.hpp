@@ -104,6 +104,9 @@ private:
     std::vector<std::string> transaction_problems{};
     std::vector<std::string> signature_problems{};
 
+    // durations of the phases of the last _run()
+    std::vector<std::pair<std::string, std::chrono::microseconds>> run_phase_durations{};
+
     // history db transaction id
     int64_t history_db_id = 0;
 
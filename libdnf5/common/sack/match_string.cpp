@@ -26,6 +26,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <fnmatch.h>
 
+#include <algorithm>
+#include <cctype>
 #include <regex>
 #include <stdexcept>
 
@@ -126,4 +128,207 @@ bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const s
 }
 
 
+namespace {
+
+inline char to_lower(char c) {
+    return static_cast<char>(::tolower(c));
+}
+
+// `lower_pattern` must be already lowercased
+inline bool iequals(std::string_view value, std::string_view lower_pattern) {
+    return value.size() == lower_pattern.size() &&
+           std::equal(value.begin(), value.end(), lower_pattern.begin(), [](char v, char p) {
+               return to_lower(v) == p;
+           });
+}
+
+inline bool icontains(std::string_view value, std::string_view lower_pattern) {
+    if (lower_pattern.size() > value.size()) {
+        return false;
+    }
+    for (std::size_t pos = 0; pos <= value.size() - lower_pattern.size(); ++pos) {
+        if (iequals(value.substr(pos, lower_pattern.size()), lower_pattern)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+
+class StringMatcher::Impl {
+public:
+    Impl(QueryCmp cmp, std::vector<std::string> patterns) : cmp(cmp), patterns(std::move(patterns)) {}
+
+    // `c_value` is either a null-terminated copy of the `value` or nullptr if not available
+    bool match(std::string_view value, const char * c_value);
+    bool match(const std::vector<std::string> & values);
+
+private:
+    // Preparation is deferred to the first match to keep the reporting of invalid comparison types
+    // and regular expressions the same as in `match_string()`.
+    void prepare();
+    bool match_any_pattern(std::string_view value, const char * c_value);
+
+    QueryCmp cmp;
+    QueryCmp base_cmp{QueryCmp::EXACT};
+    std::vector<std::string> patterns;
+    std::vector<std::regex> regexes;
+    std::string value_buffer;
+    bool prepared{false};
+};
+
+
+void StringMatcher::Impl::prepare() {
+    base_cmp = cmp - QueryCmp::NOT;
+    switch (base_cmp) {
+        case QueryCmp::IEXACT:
+        case QueryCmp::ICONTAINS:
+        case QueryCmp::ISTARTSWITH:
+        case QueryCmp::IENDSWITH:
+            for (auto & pattern : patterns) {
+                pattern = libdnf5::utils::string::tolower(pattern);
+            }
+            break;
+        case QueryCmp::REGEX:
+        case QueryCmp::IREGEX:
+            regexes.reserve(patterns.size());
+            for (const auto & pattern : patterns) {
+                regexes.push_back(
+                    base_cmp == QueryCmp::IREGEX ? std::regex(pattern, std::regex::icase) : std::regex(pattern));
+            }
+            break;
+        case QueryCmp::EXACT:
+        case QueryCmp::GLOB:
+        case QueryCmp::IGLOB:
+        case QueryCmp::CONTAINS:
+        case QueryCmp::STARTSWITH:
+        case QueryCmp::ENDSWITH:
+            break;
+        default:
+            libdnf_assert(cmp - QueryCmp::NOT - QueryCmp::ICASE, "NOT and ICASE modifiers cannot be used standalone");
+            libdnf_throw_assert_unsupported_query_cmp_type(cmp);
+    }
+    prepared = true;
+}
+
+
+bool StringMatcher::Impl::match_any_pattern(std::string_view value, const char * c_value) {
+    if ((base_cmp == QueryCmp::GLOB || base_cmp == QueryCmp::IGLOB) && !c_value) {
+        value_buffer.assign(value);
+        c_value = value_buffer.c_str();
+    }
+
+    for (std::size_t idx = 0; idx < patterns.size(); ++idx) {
+        const std::string_view pattern = patterns[idx];
+        bool result = false;
+        switch (base_cmp) {
+            case QueryCmp::EXACT:
+                result = value == pattern;
+                break;
+            case QueryCmp::IEXACT:
+                result = iequals(value, pattern);
+                break;
+            case QueryCmp::GLOB:
+                result = fnmatch(patterns[idx].c_str(), c_value, FNM_EXTMATCH) == 0;
+                break;
+            case QueryCmp::IGLOB:
+                result = fnmatch(patterns[idx].c_str(), c_value, FNM_CASEFOLD | FNM_EXTMATCH) == 0;
+                break;
+            case QueryCmp::REGEX:
+            case QueryCmp::IREGEX:
+                result = std::regex_match(value.begin(), value.end(), regexes[idx]);
+                break;
+            case QueryCmp::CONTAINS:
+                result = value.find(pattern) != std::string_view::npos;
+                break;
+            case QueryCmp::ICONTAINS:
+                result = icontains(value, pattern);
+                break;
+            case QueryCmp::STARTSWITH:
+                result = value.substr(0, pattern.size()) == pattern;
+                break;
+            case QueryCmp::ISTARTSWITH:
+                result = value.size() >= pattern.size() && iequals(value.substr(0, pattern.size()), pattern);
+                break;
+            case QueryCmp::ENDSWITH:
+                result = value.size() >= pattern.size() && value.substr(value.size() - pattern.size()) == pattern;
+                break;
+            case QueryCmp::IENDSWITH:
+                result = value.size() >= pattern.size() &&
+                         iequals(value.substr(value.size() - pattern.size()), pattern);
+                break;
+            default:
+                libdnf_throw_assert_unsupported_query_cmp_type(cmp);
+        }
+        if (result) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// cmp is positive: return true if the value matches at least one of patterns
+// cmp is negative: return true if value doesn't match any of patterns
+bool StringMatcher::Impl::match(std::string_view value, const char * c_value) {
+    const bool negate = (cmp & QueryCmp::NOT) == QueryCmp::NOT;
+    if (patterns.empty()) {
+        return negate;
+    }
+    if (!prepared) {
+        prepare();
+    }
+    return match_any_pattern(value, c_value) != negate;
+}
+
+
+// cmp is positive: return true if at least one of the values matches at least one of the patterns
+// cmp is negative: return true if none of the values matches none of the patterns
+bool StringMatcher::Impl::match(const std::vector<std::string> & values) {
+    const bool negate = (cmp & QueryCmp::NOT) == QueryCmp::NOT;
+    if (patterns.empty() || values.empty()) {
+        return negate;
+    }
+    if (!prepared) {
+        prepare();
+    }
+    for (const auto & value : values) {
+        if (match_any_pattern(value, value.c_str())) {
+            return !negate;
+        }
+    }
+    return negate;
+}
+
+
+StringMatcher::StringMatcher(QueryCmp cmp, const std::string & pattern)
+    : p_impl(new Impl(cmp, std::vector<std::string>{pattern})) {}
+
+StringMatcher::StringMatcher(QueryCmp cmp, const std::vector<std::string> & patterns)
+    : p_impl(new Impl(cmp, patterns)) {}
+
+StringMatcher::~StringMatcher() = default;
+
+bool StringMatcher::match(const std::string & value) {
+    return p_impl->match(value, value.c_str());
+}
+
+bool StringMatcher::match(std::string_view value) {
+    return p_impl->match(value, nullptr);
+}
+
+bool StringMatcher::match(const char * value) {
+    if (!value) {
+        return p_impl->match(std::string_view(), "");
+    }
+    return p_impl->match(value, value);
+}
+
+bool StringMatcher::match(const std::vector<std::string> & values) {
+    return p_impl->match(values);
+}
+
+
 }  // namespace libdnf5::sack
@@ -31,9 +31,11 @@ extern "C" {
 #include <solv/pool.h>
 }
 
+#include <cstring>
 #include <map>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -104,12 +106,42 @@ GroupQuery::GroupQuery(const BaseWeakPtr & base, bool empty) : base(base) {
 GroupQuery::GroupQuery(libdnf5::Base & base, bool empty) : GroupQuery(base.get_weak_ptr(), empty) {}
 
 void GroupQuery::filter_package_name(const std::vector<std::string> & patterns, sack::QueryCmp cmp) {
+    libdnf5::solv::CompsPool & pool = get_comps_pool(base);
+
+    // Many groups share the same packages, remember the result of matching each package name
+    // so that the patterns are evaluated only once for every distinct name.
+    std::unordered_map<Id, bool> name_matches;
+    sack::StringMatcher matcher(cmp, patterns);
+    auto name_matches_patterns = [&](Id name_id) {
+        auto [it, inserted] = name_matches.try_emplace(name_id, false);
+        if (inserted) {
+            it->second = matcher.match(pool.id2str(name_id));
+        }
+        return it->second;
+    };
+
     for (auto it = get_data().begin(); it != get_data().end();) {
-        // Copy group so we can call `get_packages()`, this is needed because `it` is from a std::set and thus const
-        // but `get_packages()` modifies its group (it stores cache of its packages).
-        Group group = *it;
-        bool keep = std::ranges::any_of(
-            group.get_packages(), [&](const auto & pkg) { return match_string(pkg.get_name(), cmp, patterns); });
+        // Walk the package lists of the group solvable directly instead of creating `Package` objects
+        // by `Group::get_packages()`. The same lists are used: only the first (highest priority)
+        // solvable, requires, recommends and suggests without a condition.
+        Solvable * solvable = pool.id2solvable(it->group_ids[0].id);
+        auto any_package_matches = [&](Offset packages, bool skip_conditional) {
+            if (!packages) {
+                return false;
+            }
+            for (Id * r_id = solvable->repo->idarraydata + packages; *r_id; ++r_id) {
+                if (skip_conditional && strcmp(pool.id2rel(*r_id), "") != 0) {
+                    continue;
+                }
+                if (name_matches_patterns(*r_id)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        bool keep = any_package_matches(solvable->dep_requires, false) ||
+                    any_package_matches(solvable->dep_recommends, false) ||
+                    any_package_matches(solvable->dep_suggests, true);
         if (keep) {
             ++it;
         } else {
@@ -47,8 +47,8 @@ namespace libdnf5 {
 /// 1k = 1024 bytes is used.
 ///
 /// @param str Bandwidth as user friendly string
-/// @return int Number of bytes
-static int str_to_bytes(const std::string & str) {
+/// @return double Number of bytes
+static double str_to_bytes_double(const std::string & str) {
     if (str.empty()) {
         throw OptionInvalidValueError(M_("Input is empty. Must contain a value."));
     }
@@ -81,7 +81,15 @@ static int str_to_bytes(const std::string & str) {
         }
     }
 
-    return static_cast<int>(res);
+    return res;
+}
+
+static int str_to_bytes(const std::string & str) {
+    return static_cast<int>(str_to_bytes_double(str));
+}
+
+static std::uint64_t str_to_bytes_uint64(const std::string & str) {
+    return static_cast<std::uint64_t>(str_to_bytes_double(str));
 }
 
 static void add_from_file(std::ostream & out, const std::string & file_path) {
@@ -189,6 +197,8 @@ class ConfigMain::Impl {
     OptionStringList group_package_types{GROUP_PACKAGE_TYPES};
     OptionStringSet optional_metadata_types{
         OptionStringSet::ValueType{libdnf5::METADATA_TYPE_COMPS, libdnf5::METADATA_TYPE_UPDATEINFO}};
+    // optional metadata types loaded into the pool only when they are needed for the first time
+    OptionStringSet ondemand_metadata_types{OptionStringSet::ValueType{}};
     OptionNumber<std::uint32_t> installonly_limit{3, 0, [](const std::string & value) -> std::uint32_t {
                                                       if (value == "<off>") {
                                                           return 0;
@@ -268,6 +278,10 @@ class ConfigMain::Impl {
 
     OptionBool upgrade_group_objects_upgrade{true};  // :api
     OptionPath destdir{nullptr};
+    OptionPath shared_package_cachedir{nullptr};
+    OptionNumber<std::uint64_t> shared_package_cache_size{0, str_to_bytes_uint64};
+    OptionNumber<std::uint64_t> cache_budget{0, str_to_bytes_uint64};
+    OptionNumber<std::uint32_t> progress_interval{0};
     OptionString comment{nullptr};
     OptionBool downloadonly{false};  // runtime only option
     OptionBool ignorearch{false};
@@ -460,6 +474,10 @@ ConfigMain::Impl::Impl(Config & owner) : owner(owner) {
     owner.opt_binds().add("history_list_view", history_list_view);
     owner.opt_binds().add("upgrade_group_objects_upgrade", upgrade_group_objects_upgrade);
     owner.opt_binds().add("destdir", destdir);
+    owner.opt_binds().add("shared_package_cachedir", shared_package_cachedir);
+    owner.opt_binds().add("shared_package_cache_size", shared_package_cache_size);
+    owner.opt_binds().add("cache_budget", cache_budget);
+    owner.opt_binds().add("progress_interval", progress_interval);
     owner.opt_binds().add("comment", comment);
     owner.opt_binds().add("ignorearch", ignorearch);
     owner.opt_binds().add("module_platform_id", module_platform_id);
@@ -574,6 +592,15 @@ ConfigMain::Impl::Impl(Config & owner) : owner(owner) {
         },
         nullptr,
         true);
+
+    owner.opt_binds().add(
+        "ondemand_metadata_types",
+        ondemand_metadata_types,
+        [&](Option::Priority priority, const std::string & value) {
+            option_T_list_append(ondemand_metadata_types, priority, value);
+        },
+        nullptr,
+        true);
 }
 
 ConfigMain::ConfigMain() {
@@ -773,6 +800,13 @@ const OptionStringSet & ConfigMain::get_optional_metadata_types_option() const {
     return p_impl->optional_metadata_types;
 }
 
+OptionStringSet & ConfigMain::get_ondemand_metadata_types_option() {
+    return p_impl->ondemand_metadata_types;
+}
+const OptionStringSet & ConfigMain::get_ondemand_metadata_types_option() const {
+    return p_impl->ondemand_metadata_types;
+}
+
 OptionNumber<std::uint32_t> & ConfigMain::get_installonly_limit_option() {
     return p_impl->installonly_limit;
 }
@@ -1081,6 +1115,34 @@ const OptionPath & ConfigMain::get_destdir_option() const {
     return p_impl->destdir;
 }
 
+OptionPath & ConfigMain::get_shared_package_cachedir_option() {
+    return p_impl->shared_package_cachedir;
+}
+const OptionPath & ConfigMain::get_shared_package_cachedir_option() const {
+    return p_impl->shared_package_cachedir;
+}
+
+OptionNumber<std::uint64_t> & ConfigMain::get_shared_package_cache_size_option() {
+    return p_impl->shared_package_cache_size;
+}
+const OptionNumber<std::uint64_t> & ConfigMain::get_shared_package_cache_size_option() const {
+    return p_impl->shared_package_cache_size;
+}
+
+OptionNumber<std::uint64_t> & ConfigMain::get_cache_budget_option() {
+    return p_impl->cache_budget;
+}
+const OptionNumber<std::uint64_t> & ConfigMain::get_cache_budget_option() const {
+    return p_impl->cache_budget;
+}
+
+OptionNumber<std::uint32_t> & ConfigMain::get_progress_interval_option() {
+    return p_impl->progress_interval;
+}
+const OptionNumber<std::uint32_t> & ConfigMain::get_progress_interval_option() const {
+    return p_impl->progress_interval;
+}
+
 OptionString & ConfigMain::get_comment_option() {
     return p_impl->comment;
 }
@@ -90,21 +90,24 @@ OptionBinds::Item & OptionBinds::add(
     Item::NewStringFunc new_string_func,
     Item::GetValueStringFunc get_value_string_func,
     bool add_value) {
-    auto item = items.find(id);
-    if (item != items.end()) {
+    // A single search finds both a duplicate and the insertion position
+    auto item = items.lower_bound(id);
+    if (item != items.end() && item->first == id) {
         throw OptionBindsOptionAlreadyExistsError(id);
     }
-    auto res = items.emplace(id, Item(option, std::move(new_string_func), std::move(get_value_string_func), add_value));
-    return res.first->second;
+    auto res = items.emplace_hint(
+        item, id, Item(option, std::move(new_string_func), std::move(get_value_string_func), add_value));
+    return res->second;
 }
 
 OptionBinds::Item & OptionBinds::add(const std::string & id, Option & option) {
-    auto item = items.find(id);
-    if (item != items.end()) {
+    // A single search finds both a duplicate and the insertion position
+    auto item = items.lower_bound(id);
+    if (item != items.end() && item->first == id) {
         throw OptionBindsOptionAlreadyExistsError(id);
     }
-    auto res = items.emplace(id, Item(option));
-    return res.first->second;
+    auto res = items.emplace_hint(item, id, Item(option));
+    return res->second;
 }
 
 }  // namespace libdnf5
@@ -26,6 +26,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/rpm/arch.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 #include "libdnf5/utils/fs/file.hpp"
+#include "libdnf5/utils/fs/temp.hpp"
 
 #include <dirent.h>
 #include <rpm/rpmdb.h>
@@ -34,6 +35,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <rpm/rpmts.h>
 #include <stdlib.h>
 #include <sys/auxv.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/utsname.h>
 
@@ -42,6 +44,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #define ASCII_LOWERCASE "abcdefghijklmnopqrstuvwxyz"
 #define ASCII_UPPERCASE "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -117,11 +121,94 @@ static std::string detect_arch() {
     return un.machine;
 }
 
+// Returns a signature of the rpm database files (name, size and modification time of each regular file).
+// Any change to the installed packages modifies at least one of them. Unlike the rpmdb cookie, the signature
+// is computed without opening the database. Returns an empty string if the database files cannot be examined.
+static std::string get_rpmdb_files_signature(const std::string & install_root_path) {
+    char * dbpath = rpmExpand("%{_dbpath}", nullptr);
+    auto db_dir = std::filesystem::path(install_root_path) / std::filesystem::path(dbpath).relative_path();
+    free(dbpath);
+
+    std::vector<std::string> entries;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(db_dir, ec), end; !ec && it != end; it.increment(ec)) {
+        struct stat st;
+        if (stat(it->path().c_str(), &st) != 0) {
+            return {};
+        }
+        if (!S_ISREG(st.st_mode)) {
+            continue;
+        }
+        entries.push_back(
+            it->path().filename().native() + ':' + std::to_string(st.st_size) + ':' +
+            std::to_string(st.st_mtim.tv_sec) + '.' + std::to_string(st.st_mtim.tv_nsec));
+    }
+    if (ec || entries.empty()) {
+        return {};
+    }
+    std::sort(entries.begin(), entries.end());
+
+    std::string signature;
+    for (const auto & entry : entries) {
+        signature += entry;
+        signature += ';';
+    }
+    return signature;
+}
+
+// Returns the path to the file that caches the detected release version.
+static std::filesystem::path get_release_cache_path(const BaseWeakPtr & base, const std::string & install_root_path) {
+    std::filesystem::path system_state_dir{base->get_config().get_system_state_dir_option().get_value()};
+    return std::filesystem::path(install_root_path) / system_state_dir.relative_path() / "releasever_cache";
+}
+
+// Reads the release version from the cache file. Returns nullptr if the cache is missing or `signature` differs.
+static std::unique_ptr<std::string> read_cached_release(
+    const std::filesystem::path & cache_path, const std::string & signature) {
+    try {
+        utils::fs::File file(cache_path, "r");
+        std::string cached_signature;
+        std::string release_ver;
+        if (file.read_line(cached_signature) && cached_signature == signature && file.read_line(release_ver) &&
+            !release_ver.empty()) {
+            return std::make_unique<std::string>(std::move(release_ver));
+        }
+    } catch (const std::exception &) {
+    }
+    return {};
+}
+
+// Stores the release version into the cache file. The cache is optional, errors (e.g. insufficient permissions
+// of a non-root user) are ignored. The file is written into a temporary file and renamed to be updated atomically.
+static void write_cached_release(
+    const std::filesystem::path & cache_path, const std::string & signature, const std::string & release_ver) {
+    try {
+        if (!std::filesystem::is_directory(cache_path.parent_path())) {
+            return;
+        }
+        utils::fs::TempFile tmp_file(cache_path.parent_path(), cache_path.filename());
+        tmp_file.open_as_file("w").write(signature + '\n' + release_ver + '\n');
+        tmp_file.close();
+        std::filesystem::rename(tmp_file.get_path(), cache_path);
+        tmp_file.release();
+    } catch (const std::exception &) {
+    }
+}
+
 
 // ==================================================================
 
 
 std::unique_ptr<std::string> Vars::detect_release(const BaseWeakPtr & base, const std::string & install_root_path) {
+    // Detection requires opening the rpm database. Reuse the previous result while the database is unchanged.
+    const auto rpmdb_signature = get_rpmdb_files_signature(install_root_path);
+    const auto cache_path = get_release_cache_path(base, install_root_path);
+    if (!rpmdb_signature.empty()) {
+        if (auto cached_release_ver = read_cached_release(cache_path, rpmdb_signature)) {
+            return cached_release_ver;
+        }
+    }
+
     std::unique_ptr<std::string> release_ver;
 
     libdnf5::rpm::RpmLogGuard rpm_log_guard(base);
@@ -154,6 +241,10 @@ std::unique_ptr<std::string> Vars::detect_release(const BaseWeakPtr & base, cons
         }
     }
     rpmtsFree(ts);
+
+    if (release_ver && !rpmdb_signature.empty()) {
+        write_cached_release(cache_path, rpmdb_signature, *release_ver);
+    }
     return release_ver;
 }
 
@@ -329,6 +420,11 @@ std::pair<std::string, size_t> Vars::substitute_expression(std::string_view text
 }
 
 std::string Vars::substitute(const std::string & text) const {
+    // Most of the configuration values contain neither a variable expression nor an escape,
+    // there is nothing to substitute in them.
+    if (text.find_first_of("$\\") == std::string::npos) {
+        return text;
+    }
     return substitute_expression(text, 0).first;
 }
 
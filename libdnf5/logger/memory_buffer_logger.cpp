@@ -40,7 +40,12 @@ void MemoryBufferLogger::write(
         if (max_items == 0 || items.size() < max_items) {
             items.push_back({time, pid, level, message});
         } else {
-            items[first_item_idx] = {time, pid, level, message};
+            // Reuse the slot of the oldest message, its string keeps the already allocated storage
+            auto & item = items[first_item_idx];
+            item.time = time;
+            item.pid = pid;
+            item.level = level;
+            item.message.assign(message);
             if (++first_item_idx >= max_items) {
                 first_item_idx = 0;
             }
@@ -74,6 +79,16 @@ void MemoryBufferLogger::write_to_logger(Logger & logger) {
     }
 }
 
+std::size_t MemoryBufferLogger::get_memory_usage() const {
+    std::lock_guard<std::mutex> guard(items_mutex);
+    std::size_t size = items.capacity() * sizeof(Item);
+    for (const auto & item : items) {
+        size += item.message.capacity();
+    }
+    return size;
+}
+
+
 void MemoryBufferLogger::clear() noexcept {
     std::lock_guard<std::mutex> guard(items_mutex);
     first_item_idx = 0;
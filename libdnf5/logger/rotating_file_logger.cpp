@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <fmt/format.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <mutex>
@@ -34,16 +35,23 @@ namespace libdnf5 {
 class RotatingFileLogger::Impl {
 public:
     explicit Impl(const std::filesystem::path & base_file_path, std::size_t max_bytes, std::size_t backup_count);
+    ~Impl();
 
     void write(const char * line) noexcept;
 
 private:
+    bool open_base_file() noexcept;
+    void close_base_file() noexcept;
+    bool is_base_file(int fd) const noexcept;
     bool should_rotate(int fd, std::size_t msg_len) const noexcept;
 
     const std::filesystem::path base_file_path;
     const std::size_t max_bytes;
     const std::size_t backup_count;
 
+    // The base log file is kept open between writes.
+    int base_fd{-1};
+
     std::mutex stream_mutex;
 };
 
@@ -53,14 +61,42 @@ RotatingFileLogger::Impl::Impl(
     : base_file_path{base_file_path},
       max_bytes{max_bytes},
       backup_count{backup_count} {
-    if (::open(
-            base_file_path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) ==
-        -1) {
+    if (!open_base_file()) {
         throw FileSystemError(errno, base_file_path, M_("Cannot open log file"));
     }
 }
 
 
+RotatingFileLogger::Impl::~Impl() {
+    close_base_file();
+}
+
+
+bool RotatingFileLogger::Impl::open_base_file() noexcept {
+    base_fd = ::open(
+        base_file_path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    return base_fd != -1;
+}
+
+
+void RotatingFileLogger::Impl::close_base_file() noexcept {
+    if (base_fd != -1) {
+        ::close(base_fd);
+        base_fd = -1;
+    }
+}
+
+
+bool RotatingFileLogger::Impl::is_base_file(int fd) const noexcept {
+    struct stat fd_stat;
+    struct stat path_stat;
+    if (::fstat(fd, &fd_stat) == -1 || ::stat(base_file_path.c_str(), &path_stat) == -1) {
+        return false;
+    }
+    return fd_stat.st_dev == path_stat.st_dev && fd_stat.st_ino == path_stat.st_ino;
+}
+
+
 void RotatingFileLogger::Impl::write(const char * line) noexcept {
     try {
         // required for thread safety
@@ -68,53 +104,36 @@ void RotatingFileLogger::Impl::write(const char * line) noexcept {
 
         auto line_len = strlen(line);
         while (true) {
-            // open (create) the base log file and lock it
-            auto fd = ::open(
-                base_file_path.c_str(),
-                O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC,
-                S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
-            if (fd == -1) {
+            // (re)open (create) the base log file if needed and lock it
+            if (base_fd == -1 && !open_base_file()) {
                 return;
             }
-            ::flock(fd, LOCK_EX);
+            ::flock(base_fd, LOCK_EX);
+
+            if (!is_base_file(base_fd)) {
+                // The open file is no longer the base log file, it was probably rotated by another process.
+                // Close the file descriptor and start from the beginning.
+                close_base_file();
+                continue;
+            }
 
-            if (!should_rotate(fd, line_len)) {
+            if (!should_rotate(base_fd, line_len)) {
                 // no need to rotate log files, just write a message to the log and return
                 std::size_t written = 0;
                 ssize_t ret;
                 do {
-                    ret = ::write(fd, line + written, line_len - written);
+                    ret = ::write(base_fd, line + written, line_len - written);
                     if (ret <= 0) {
                         break;
                     }
                     written += static_cast<std::size_t>(ret);
                 } while (written < line_len);
-                ::close(fd);
+                ::flock(base_fd, LOCK_UN);
                 return;
             }
 
-            // A rotation of the log files is needed, rotate the files and start from the beginning.
-            // But before that, we will verify that another process did not perform the rotation.
-
-            auto fd_base_file = ::open(base_file_path.c_str(), O_RDONLY | O_CLOEXEC);
-            if (fd_base_file == -1) {
-                // Unable to reopen the base log file, it was probably rotated by another process.
-                // Close the locked file descriptor and start from the beginning.
-                ::close(fd);
-                continue;
-            }
-            if (::lseek(fd_base_file, 0, SEEK_END) != ::lseek(fd, 0, SEEK_END)) {
-                // The size of the base log file is different than the size of the locked descriptor,
-                // probably rotated by another process.
-                // Close file descriptors and start from the beginning.
-                ::close(fd_base_file);
-                ::close(fd);
-                continue;
-            }
-            ::close(fd_base_file);
-
-            // A log file rotation is needed and so far no one has done it.
-            // Let's rotate the files and start from the beginning.
+            // A log file rotation is needed and the locked file is still the base log file,
+            // so no one else has done it. Let's rotate the files and start from the beginning.
             try {
                 for (auto file_idx = backup_count; file_idx > 0; --file_idx) {
                     auto path_old = file_idx > 1 ? fmt::format("{}.{}", base_file_path.string(), file_idx - 1)
@@ -124,7 +143,7 @@ void RotatingFileLogger::Impl::write(const char * line) noexcept {
                 }
             } catch (...) {
             }
-            ::close(fd);
+            close_base_file();
         }
     } catch (...) {
     }
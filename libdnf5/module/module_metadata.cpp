@@ -85,6 +85,13 @@ ModuleMetadata::~ModuleMetadata() {
 
 
 void ModuleMetadata::add_metadata_from_string(const std::string & yaml, int priority) {
+    ModulemdModuleIndex * module_index = parse_metadata_from_string(yaml);
+    add_metadata_from_index(module_index, priority);
+    g_object_unref(module_index);
+}
+
+
+ModulemdModuleIndex * ModuleMetadata::parse_metadata_from_string(const std::string & yaml) {
     GError * error = NULL;
     g_autoptr(GPtrArray) failures = NULL;
 
@@ -99,8 +106,14 @@ void ModuleMetadata::add_metadata_from_string(const std::string & yaml, int prio
         }
     }
     if (error) {
+        g_object_unref(module_index);
         throw ModuleResolveError(M_("Failed to update from string: {}"), std::string(error->message));
     }
+    return module_index;
+}
+
+
+void ModuleMetadata::add_metadata_from_index(ModulemdModuleIndex * module_index, int priority) {
     if (!module_merger) {
         module_merger = modulemd_module_index_merger_new();
         if (resulting_module_index) {
@@ -111,7 +124,6 @@ void ModuleMetadata::add_metadata_from_string(const std::string & yaml, int prio
     }
 
     modulemd_module_index_merger_associate_index(module_merger, module_index, priority);
-    g_object_unref(module_index);
     metadata_resolved = false;
 }
 
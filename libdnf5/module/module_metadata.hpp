@@ -56,6 +56,10 @@ private:
     BaseWeakPtr get_base() const;
 
     void add_metadata_from_string(const std::string & yaml, int priority);
+    /// Parse the yaml into a new module index. The caller owns the returned reference.
+    ModulemdModuleIndex * parse_metadata_from_string(const std::string & yaml);
+    /// Add an already parsed module index. A new reference to the index is taken.
+    void add_metadata_from_index(ModulemdModuleIndex * module_index, int priority);
     void resolve_added_metadata();
 
     std::pair<std::vector<ModuleItem *>, std::vector<ModuleItem *>> get_all_module_items(
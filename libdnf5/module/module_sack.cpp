@@ -47,6 +47,7 @@ extern "C" {
 #include "libdnf5/repo/repo_weak.hpp"
 #include "libdnf5/rpm/package_query.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -83,10 +84,12 @@ std::vector<ModuleItem *> ModuleSack::get_active_modules() {
 void ModuleSack::add(const std::string & file_content, const std::string & repo_id) {
     ModuleMetadata md(get_base());
     try {
-        md.add_metadata_from_string(file_content, 0);
-        // The second call to add_metadata_from_string is to load all metadata in to `p_impl->module_metadata` and use
-        // them later to get all defaults.
-        p_impl->module_metadata.add_metadata_from_string(file_content, 0);
+        // The yaml is parsed only once, the resulting index is shared by both mergers.
+        ModulemdModuleIndex * module_index = md.parse_metadata_from_string(file_content);
+        md.add_metadata_from_index(module_index, 0);
+        // Load all metadata also in to `p_impl->module_metadata` to use them later to get all defaults.
+        p_impl->module_metadata.add_metadata_from_index(module_index, 0);
+        g_object_unref(module_index);
     } catch (const ModuleResolveError & e) {
         throw ModuleResolveError(
             M_("Failed to load module metadata for repository \"{}\": {}"), repo_id, std::string(e.what()));
@@ -196,7 +199,6 @@ ModuleSack::Impl::collect_data_for_modular_filtering() {
     std::vector<std::string> exclude_NEVRAs;
     std::vector<std::string> names;
     std::vector<std::string> src_names;
-    libdnf5::rpm::ReldepList reldep_name_list(base);
     for (const auto & module : get_modules()) {
         auto artifacts = module->get_artifacts();
         if (module->is_active()) {
@@ -219,7 +221,6 @@ ModuleSack::Impl::collect_data_for_modular_filtering() {
                         src_names.push_back(nevra.get_name());
                     } else {
                         names.push_back(nevra.get_name());
-                        reldep_name_list.add_reldep(nevra.get_name());
                     }
                 }
             }
@@ -251,12 +252,28 @@ ModuleSack::Impl::collect_data_for_modular_filtering() {
             //         }
             //     }rpm/package_query.hpp
             // }
-            copy(std::begin(artifacts), std::end(artifacts), std::back_inserter(include_NEVRAs));
+            std::move(std::begin(artifacts), std::end(artifacts), std::back_inserter(include_NEVRAs));
         } else {
-            copy(std::begin(artifacts), std::end(artifacts), std::back_inserter(exclude_NEVRAs));
+            std::move(std::begin(artifacts), std::end(artifacts), std::back_inserter(exclude_NEVRAs));
         }
     }
 
+    // Different versions and contexts of the same module stream mostly list the same packages.
+    // Remove the duplicates to not filter the same values repeatedly.
+    auto sort_unique = [](std::vector<std::string> & values) {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    };
+    sort_unique(include_NEVRAs);
+    sort_unique(exclude_NEVRAs);
+    sort_unique(names);
+    sort_unique(src_names);
+
+    libdnf5::rpm::ReldepList reldep_name_list(base);
+    for (const auto & name : names) {
+        reldep_name_list.add_reldep(name);
+    }
+
     return std::make_tuple(
         std::move(include_NEVRAs),
         std::move(exclude_NEVRAs),
@@ -467,6 +484,8 @@ std::pair<std::vector<std::vector<std::string>>, ModuleSack::ModuleErrorType> Mo
         return std::make_pair(problems, ModuleSack::ModuleErrorType::NO_ERROR);
     }
 
+    TraceSpan span(*base, "module_solve");
+
     recompute_considered_in_pool();
     make_provides_ready();
 
@@ -753,9 +772,36 @@ ModuleSack::resolve_active_module_items() {
 }
 
 
-static ModuleQuery module_spec_to_query(BaseWeakPtr & base, const std::string & module_spec) {
+const std::vector<const ModuleItem *> & ModuleSack::Impl::get_modules_by_name(const std::string & name) {
+    static const std::vector<const ModuleItem *> no_modules;
+
+    const auto & all_modules = get_modules();
+    if (modules_by_name_size != all_modules.size()) {
+        modules_by_name.clear();
+        for (const auto & module_item : all_modules) {
+            modules_by_name[module_item->get_name()].push_back(module_item.get());
+        }
+        modules_by_name_size = all_modules.size();
+    }
+
+    auto it = modules_by_name.find(name);
+    return it == modules_by_name.end() ? no_modules : it->second;
+}
+
+
+ModuleQuery ModuleSack::Impl::module_spec_to_query(const std::string & module_spec) {
     for (auto & nsvcap : Nsvcap::parse(module_spec)) {
-        ModuleQuery nsvcap_query(base, false);
+        // A name without any glob characters matches only itself. Start from the modules of that name
+        // instead of copying all modules into the query and matching every one of them.
+        const std::string & name = nsvcap.get_name();
+        ModuleQuery nsvcap_query(base, true);
+        if (!name.empty() && name.find_first_of("*?[\\(") == std::string::npos) {
+            for (const auto * module_item : get_modules_by_name(name)) {
+                nsvcap_query.add(*module_item);
+            }
+        } else {
+            nsvcap_query = ModuleQuery(base, false);
+        }
         nsvcap_query.filter_nsvca(nsvcap, libdnf5::sack::QueryCmp::GLOB);
         if (!nsvcap_query.empty()) {
             return nsvcap_query;
@@ -782,7 +828,7 @@ bool ModuleSack::Impl::enable(const std::string & module_spec, bool count) {
 
     bool changed = false;
     libdnf5::solv::IdQueue queue;
-    for (const auto & module_item : module_spec_to_query(base, module_spec)) {
+    for (const auto & module_item : module_spec_to_query(module_spec)) {
         queue.push_back(module_item.get_id().id);
         changed |= enable(module_item.get_name(), module_item.get_stream(), count);
     }
@@ -796,7 +842,7 @@ bool ModuleSack::Impl::disable(const std::string & module_spec, bool count) {
     module_db->initialize();
 
     bool changed = false;
-    for (const auto & module_item : module_spec_to_query(base, module_spec)) {
+    for (const auto & module_item : module_spec_to_query(module_spec)) {
         const auto & name = module_item.get_name();
         if (module_db->change_status(name, ModuleStatus::DISABLED)) {
             module_db->change_stream(name, "", count);
@@ -813,7 +859,7 @@ bool ModuleSack::Impl::reset(const std::string & module_spec, bool count) {
     module_db->initialize();
 
     bool changed = false;
-    for (const auto & module_item : module_spec_to_query(base, module_spec)) {
+    for (const auto & module_item : module_spec_to_query(module_spec)) {
         const auto & name = module_item.get_name();
         if (module_db->change_status(name, ModuleStatus::AVAILABLE)) {
             module_db->change_stream(name, "", count);
@@ -27,6 +27,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "solv/solv_map.hpp"
 
 #include "libdnf5/base/base.hpp"
+#include "libdnf5/module/module_query.hpp"
 #include "libdnf5/module/module_sack.hpp"
 #include "libdnf5/rpm/reldep_list.hpp"
 
@@ -36,6 +37,7 @@ extern "C" {
 }
 
 #include <optional>
+#include <unordered_map>
 
 
 namespace libdnf5::base {
@@ -151,6 +153,8 @@ public:
     /// @since 5.1.8
     void set_arch(const char * arch) { pool_setarch(pool, arch); };
 
+    const Pool * get_pool() const noexcept { return pool; }
+
 
 private:
     friend class libdnf5::base::Transaction;
@@ -184,6 +188,19 @@ private:
 
     std::unique_ptr<ModuleDB> module_db;
 
+    // Index of `modules` by module name, see `get_modules_by_name()`.
+    std::unordered_map<std::string, std::vector<const ModuleItem *>> modules_by_name;
+    // Number of `modules` when `modules_by_name` was built. Modules are only ever appended.
+    std::size_t modules_by_name_size{0};
+
+    /// @return Modules with the given name. The index is built on the first use and rebuilt after modules
+    ///         were added.
+    const std::vector<const ModuleItem *> & get_modules_by_name(const std::string & name);
+
+    /// @return Query with modules matching the first NSVCAP form of the `module_spec` that matches any module.
+    /// @throw NoModuleError if no module matches.
+    ModuleQuery module_spec_to_query(const std::string & module_spec);
+
     /// @brief Method for autodetection of the platform id.
     /// @return If platform id was detected, it returns a pair where the first item is the platform
     ///         module name and second is the platform stream. Otherwise std::nullopt is returned.
@@ -88,6 +88,7 @@ class ConfigRepo::Impl {
     OptionChild<OptionBool> countme{main_config.get_countme_option()};
     OptionEnum<std::string> failovermethod{"priority", {"priority", "roundrobin"}};
     OptionChild<OptionBool> build_cache{main_config.get_build_cache_option()};
+    OptionBool local_in_place{false};
 };
 
 ConfigRepo::Impl::Impl(Config & owner, ConfigMain & main_config, const std::string & id)
@@ -197,6 +198,7 @@ ConfigRepo::Impl::Impl(Config & owner, ConfigMain & main_config, const std::stri
     owner.opt_binds().add("user_agent", user_agent);
     owner.opt_binds().add("countme", countme);
     owner.opt_binds().add("build_cache", build_cache);
+    owner.opt_binds().add("local_in_place", local_in_place);
 }
 
 ConfigRepo::ConfigRepo(ConfigMain & main_config, const std::string & id) : p_impl(new Impl(*this, main_config, id)) {}
@@ -560,6 +562,13 @@ const OptionChild<OptionBool> & ConfigRepo::get_build_cache_option() const {
     return p_impl->build_cache;
 }
 
+OptionBool & ConfigRepo::get_local_in_place_option() {
+    return p_impl->local_in_place;
+}
+const OptionBool & ConfigRepo::get_local_in_place_option() const {
+    return p_impl->local_in_place;
+}
+
 
 std::string ConfigRepo::get_unique_id() const {
     std::string tmp;
@@ -21,6 +21,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "repo_downloader.hpp"
 #include "temp_files_memory.hpp"
+#include "utils/fs/utils.hpp"
+#include "utils/locker.hpp"
+#include "utils/on_scope_exit.hpp"
+#include "utils/progress_throttle.hpp"
 
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/common/exception.hpp"
@@ -29,10 +33,18 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/repo/repo_errors.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
+#include <fcntl.h>
 #include <librepo/librepo.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <numeric>
+#include <tuple>
+#include <vector>
 
 
 namespace std {
@@ -52,12 +64,15 @@ public:
     PackageTarget(const libdnf5::rpm::Package & package, const std::string & destination, void * user_data)
         : package(package),
           destination(destination),
-          user_data(user_data) {}
+          user_data(user_data),
+          progress_throttle(std::chrono::milliseconds(
+              package.get_base()->get_config().get_progress_interval_option().get_value())) {}
 
     libdnf5::rpm::Package package;
     std::string destination;
     void * user_data;
     void * user_cb_data{nullptr};
+    utils::ProgressThrottle progress_throttle;
 };
 
 static int end_callback(void * data, LrTransferStatus status, const char * msg) {
@@ -76,6 +91,9 @@ static int progress_callback(void * data, double total_to_download, double downl
 
     auto * package_target = static_cast<PackageTarget *>(data);
     if (auto * download_callbacks = package_target->package.get_base()->get_download_callbacks()) {
+        if (!package_target->progress_throttle.should_notify(downloaded, total_to_download)) {
+            return 0;
+        }
         return download_callbacks->progress(package_target->user_cb_data, total_to_download, downloaded);
     }
     return 0;
@@ -91,6 +109,89 @@ static int mirror_failure_callback(void * data, const char * msg, const char * u
     return 0;
 }
 
+// Returns the path of the package in the shared package cache directory.
+// The packages are stored under their checksums, e.g. "<shared_cachedir>/sha256/<checksum>.rpm".
+static std::filesystem::path get_shared_cache_path(
+    const std::filesystem::path & shared_cachedir, const libdnf5::rpm::Package & package) {
+    auto checksum = package.get_checksum();
+    if (checksum.get_type() == libdnf5::rpm::Checksum::Type::UNKNOWN) {
+        return {};
+    }
+    return shared_cachedir / checksum.get_type_str() / (checksum.get_checksum() + ".rpm");
+}
+
+// Checks that the file has the size and the checksum of the package.
+static bool is_package_file(const std::filesystem::path & path, const libdnf5::rpm::Package & package) {
+    gboolean matches{FALSE};
+    if (auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); fd != -1) {
+        utils::OnScopeExit close_fd([fd]() noexcept { ::close(fd); });
+        auto length = static_cast<unsigned long long>(lseek(fd, 0, SEEK_END));
+        if (length == package.get_download_size()) {
+            lseek(fd, 0, SEEK_SET);
+            auto checksum = package.get_checksum();
+            lr_checksum_fd_cmp(
+                static_cast<LrChecksumType>(checksum.get_type()),
+                fd,
+                checksum.get_checksum().c_str(),
+                TRUE,
+                &matches,
+                NULL);
+        }
+    }
+    return matches;
+}
+
+// Removes the package file if it is hardlinked with other files (e.g. with the copy in the shared package
+// cache) and it is not the complete package. librepo resumes and rewrites incomplete files in place, which
+// would change all the linked copies.
+static void unlink_shared_incomplete_file(const std::filesystem::path & path, const libdnf5::rpm::Package & package) {
+    struct stat file_stat;
+    if (::stat(path.c_str(), &file_stat) == 0 && file_stat.st_nlink > 1 && !is_package_file(path, package)) {
+        ::unlink(path.c_str());
+    }
+}
+
+// Marks the copy in the shared package cache as used. The access time orders the packages for the eviction,
+// the modification time is kept, librepo uses it to validate the checksum cached in the file attributes.
+static void touch_shared_file(const std::filesystem::path & path) {
+    const struct timespec times[2] = {{0, UTIME_NOW}, {0, UTIME_OMIT}};
+    utimensat(AT_FDCWD, path.c_str(), times, 0);
+}
+
+// Removes the least recently used packages from the shared package cache until their total size fits
+// the `max_size`. The copies linked to the repository cache directories stay, only their sharing ends.
+static void evict_shared_cache(const std::filesystem::path & shared_cachedir, std::uint64_t max_size) {
+    if (max_size == 0) {
+        return;
+    }
+
+    // tuple<access time (seconds, nanoseconds), size, path>
+    std::vector<std::tuple<time_t, long, std::uint64_t, std::filesystem::path>> files;
+    std::uint64_t total_size{0};
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(shared_cachedir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        struct stat file_stat;
+        if (it->path().extension() != ".rpm" || ::lstat(it->path().c_str(), &file_stat) != 0 ||
+            !S_ISREG(file_stat.st_mode)) {
+            continue;
+        }
+        auto size = static_cast<std::uint64_t>(file_stat.st_size);
+        files.emplace_back(file_stat.st_atim.tv_sec, file_stat.st_atim.tv_nsec, size, it->path());
+        total_size += size;
+    }
+
+    std::sort(files.begin(), files.end());
+    for (const auto & [atime_sec, atime_nsec, size, path] : files) {
+        if (total_size <= max_size) {
+            break;
+        }
+        if (::unlink(path.c_str()) == 0) {
+            total_size -= size;
+        }
+    }
+}
+
 
 class PackageDownloader::Impl {
 public:
@@ -134,8 +235,16 @@ void PackageDownloader::download() try {
         return;
     }
 
+    TraceSpan span(*p_impl->base, "package_download");
+    if (span.is_active()) {
+        span.set_attribute("packages", std::to_string(p_impl->targets.size()));
+    }
+
     auto & config = p_impl->base->get_config();
     auto use_cache_only = config.get_cacheonly_option().get_value() == "all";
+    auto & shared_cachedir_option = config.get_shared_package_cachedir_option();
+    const std::filesystem::path shared_cachedir =
+        shared_cachedir_option.empty() ? std::string() : shared_cachedir_option.get_value();
 
     GError * err{nullptr};
 
@@ -150,6 +259,26 @@ void PackageDownloader::download() try {
 
         std::filesystem::create_directory(pkg_target.destination);
 
+        auto package_path = std::filesystem::path(pkg_target.destination) /
+                            std::filesystem::path(pkg_target.package.get_location()).filename();
+        unlink_shared_incomplete_file(package_path, pkg_target.package);
+
+        // If the package is in the shared package cache, clone it to the destination. librepo then finds
+        // the complete file with the matching checksum and does not download it again. The shared file is
+        // verified first, an incomplete file would be removed again above on the next download.
+        // A reflink is preferred, otherwise the file is hardlinked.
+        if (!shared_cachedir.empty()) {
+            auto shared_path = get_shared_cache_path(shared_cachedir, pkg_target.package);
+            std::error_code ec;
+            if (!shared_path.empty() && !std::filesystem::exists(package_path, ec) &&
+                is_package_file(shared_path, pkg_target.package)) {
+                if (!utils::fs::reflink_file(shared_path, package_path)) {
+                    std::filesystem::create_hard_link(shared_path, package_path, ec);
+                }
+                touch_shared_file(shared_path);
+            }
+        }
+
         if (auto * download_callbacks = pkg_target.package.get_base()->get_download_callbacks()) {
             pkg_target.user_cb_data = download_callbacks->add_new_download(
                 pkg_target.user_data,
@@ -181,10 +310,27 @@ void PackageDownloader::download() try {
         lr_targets.emplace_back(lr_target);
     }
 
+    // librepo starts the downloads in the order of the list. With parallel downloads, start the largest
+    // packages first, so that a large package picked up last does not prolong the whole download.
+    // The download callbacks were already registered in the original order above.
+    std::vector<std::size_t> download_order(lr_targets.size());
+    std::iota(download_order.begin(), download_order.end(), 0);
+    if (config.get_max_parallel_downloads_option().get_value() > 1) {
+        std::vector<unsigned long long> download_sizes;
+        download_sizes.reserve(p_impl->targets.size());
+        for (const auto & pkg_target : p_impl->targets) {
+            download_sizes.push_back(pkg_target.package.get_download_size());
+        }
+        std::stable_sort(
+            download_order.begin(), download_order.end(), [&download_sizes](std::size_t lhs, std::size_t rhs) {
+                return download_sizes[lhs] > download_sizes[rhs];
+            });
+    }
+
     // Adding items to the end of GSList is slow. We go from the back and add items to the beginning.
     GSList * list{nullptr};
-    for (auto it = lr_targets.rbegin(); it != lr_targets.rend(); ++it) {
-        list = g_slist_prepend(list, it->get());
+    for (auto it = download_order.rbegin(); it != download_order.rend(); ++it) {
+        list = g_slist_prepend(list, lr_targets[*it].get());
     }
     std::unique_ptr<GSList, decltype(&g_slist_free)> list_holder(list, &g_slist_free);
 
@@ -216,6 +362,40 @@ void PackageDownloader::download() try {
     if (!lr_download_packages(list, flags, &err)) {
         throw LibrepoError(std::unique_ptr<GError>(err));
     }
+
+    // Store the downloaded packages in the shared package cache. The hardlink count of a shared file is
+    // its reference count. The lock serializes the updates and the eviction by concurrent processes, when
+    // another process holds it, the packages are not shared this time. Failures (e.g. the cache on another
+    // filesystem) only disable the sharing of the package.
+    if (!shared_cachedir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(shared_cachedir, ec);
+        utils::Locker locker(shared_cachedir / "shared_cache.lock");
+        bool locked{false};
+        try {
+            locked = !ec && locker.write_lock();
+        } catch (const SystemError &) {
+        }
+        if (locked) {
+            for (std::size_t idx = 0; idx < lr_targets.size(); ++idx) {
+                if (lr_targets[idx]->err) {
+                    continue;
+                }
+                const auto & pkg_target = p_impl->targets[idx];
+                auto shared_path = get_shared_cache_path(shared_cachedir, pkg_target.package);
+                if (shared_path.empty()) {
+                    continue;
+                }
+                auto package_path = std::filesystem::path(pkg_target.destination) /
+                                    std::filesystem::path(pkg_target.package.get_location()).filename();
+                std::filesystem::create_directories(shared_path.parent_path(), ec);
+                if (!std::filesystem::exists(shared_path, ec)) {
+                    std::filesystem::create_hard_link(package_path, shared_path, ec);
+                }
+            }
+            evict_shared_cache(shared_cachedir, config.get_shared_package_cache_size_option().get_value());
+        }
+    }
 } catch (const RepoCacheonlyError & e) {
     throw;
 } catch (const std::runtime_error & e) {
@@ -23,6 +23,7 @@ constexpr const char * REPOID_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmno
 #include "repo_downloader.hpp"
 #include "rpm/package_sack_impl.hpp"
 #include "solv_repo.hpp"
+#include "utils/fs/utils.hpp"
 #include "utils/string.hpp"
 
 #include "libdnf5/common/exception.hpp"
@@ -33,7 +34,6 @@ constexpr const char * REPOID_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmno
 
 extern "C" {
 #include <solv/repo_rpmdb.h>
-#include <solv/solv_xfopen.h>
 #include <solv/testcase.h>
 }
 
@@ -63,7 +63,7 @@ extern "C" {
 #include <list>
 #include <map>
 #include <set>
-#include <sstream>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
 
@@ -217,10 +217,25 @@ void Repo::load() {
         return;
     }
 
+    TraceSpan span(*base, "repo_load");
+    if (span.is_active()) {
+        span.set_attribute("repo_id", config.get_id());
+    }
+
     make_solv_repo();
 
     if (type == Type::AVAILABLE) {
         load_available_repo();
+
+        // Record the use of the cache for the eviction of the least recently used caches,
+        // see `RepoSack::apply_cache_budget()`. The cache does not have to be writable.
+        try {
+            RepoCache(base, get_cachedir())
+                .write_attribute(RepoCache::ATTRIBUTE_LAST_USED, std::to_string(std::time(nullptr)));
+        } catch (const std::exception & ex) {
+            base->get_logger()->debug(
+                "Cannot record the use of the repository cache \"{}\": {}", get_cachedir(), ex.what());
+        }
     } else if (type == Type::SYSTEM) {
         load_system_repo();
     }
@@ -353,6 +368,34 @@ std::string Repo::get_persistdir() const {
     return config.get_persistdir();
 }
 
+bool Repo::read_cached_package_names(const std::string & prefix, std::vector<std::string> & names) const {
+    auto names_file_path = std::filesystem::path(get_cachedir()) / CACHE_SOLV_FILES_DIR /
+                           (config.get_id() + CACHE_PACKAGE_NAMES_FILE_EXTENSION);
+    std::string content;
+    try {
+        content = utils::fs::File(names_file_path, "r").read();
+    } catch (const FileSystemError &) {
+        return false;
+    }
+
+    // The names are sorted, the matching ones form a contiguous block.
+    std::string_view content_view(content);
+    for (std::size_t begin = 0; begin < content_view.size();) {
+        auto end = content_view.find('\n', begin);
+        if (end == std::string_view::npos) {
+            end = content_view.size();
+        }
+        auto name = content_view.substr(begin, end - begin);
+        if (name.starts_with(prefix)) {
+            names.emplace_back(name);
+        } else if (name > prefix) {
+            break;
+        }
+        begin = end + 1;
+    }
+    return true;
+}
+
 const std::string & Repo::get_revision() const {
     return downloader->revision;
 }
@@ -416,16 +459,34 @@ void Repo::load_available_repo() {
         throw RepoError(M_("Failed to load repository: \"primary\" data not present or in unsupported format"));
     }
 
-    solv_repo->load_repo_main(downloader->repomd_filename, primary_fn);
+    solv_repo->load_repo_main(
+        downloader->repomd_filename,
+        primary_fn,
+        downloader->get_metadata_checksum(RepoDownloader::MD_FILENAME_PRIMARY),
+        downloader->get_metadata_open_size(RepoDownloader::MD_FILENAME_PRIMARY));
 
     auto optional_metadata = config.get_main_config().get_optional_metadata_types_option().get_value();
+    auto & ondemand_metadata = config.get_main_config().get_ondemand_metadata_types_option().get_value();
 
     if (optional_metadata.contains(libdnf5::METADATA_TYPE_FILELISTS)) {
-        solv_repo->load_repo_ext(RepodataType::FILELISTS, *downloader.get());
+        if (ondemand_metadata.contains(libdnf5::METADATA_TYPE_FILELISTS)) {
+            solv_repo->add_ondemand_repo_ext(RepodataType::FILELISTS);
+        } else {
+            solv_repo->load_repo_ext(RepodataType::FILELISTS, *downloader.get());
+        }
+    } else if (ondemand_metadata.contains(libdnf5::METADATA_TYPE_FILELISTS)) {
+        // Not downloaded together with the repository, downloaded by the first query that needs them
+        solv_repo->add_ondemand_repo_ext(RepodataType::FILELISTS);
     }
 
     if (optional_metadata.contains(libdnf5::METADATA_TYPE_OTHER)) {
-        solv_repo->load_repo_ext(RepodataType::OTHER, *downloader.get());
+        if (ondemand_metadata.contains(libdnf5::METADATA_TYPE_OTHER)) {
+            solv_repo->add_ondemand_repo_ext(RepodataType::OTHER);
+        } else {
+            solv_repo->load_repo_ext(RepodataType::OTHER, *downloader.get());
+        }
+    } else if (ondemand_metadata.contains(libdnf5::METADATA_TYPE_OTHER)) {
+        solv_repo->add_ondemand_repo_ext(RepodataType::OTHER);
     }
 
     if (optional_metadata.contains(libdnf5::METADATA_TYPE_PRESTO)) {
@@ -453,30 +514,8 @@ void Repo::load_available_repo() {
     logger.debug(
         "Loading {} extension for repo {} from \"{}\"", RepoDownloader::MD_FILENAME_MODULES, config.get_id(), ext_fn);
 
-    libdnf5::utils::fs::File file;
-    std::string yaml_content;
-
-    // TODO(pkratoch): Replace this by implementation in libdnf5::utils::fs::File.
-    // If the file is comressed, `std::fseek` doesn't work with the way libsolv decompresses the file, so read it by
-    // chunks.
-    if (solv_xfopen_iscompressed(ext_fn.c_str()) == 1) {
-        file = libdnf5::utils::fs::File(ext_fn, "r", true);
-
-        constexpr size_t buffer_size = 4096;
-        char buffer[buffer_size];
-        std::ostringstream ss;
-        size_t bytes_read;
-
-        do {
-            bytes_read = file.read(buffer, buffer_size);
-            ss.write(buffer, long(bytes_read));
-        } while (bytes_read == buffer_size);
-
-        yaml_content.append(ss.str());
-    } else {
-        file = libdnf5::utils::fs::File(ext_fn, "r", false);
-        yaml_content = file.read();
-    }
+    // Compressed files are opened using solv_xfopen, File::read() handles streams that are not seekable.
+    auto yaml_content = libdnf5::utils::fs::File(ext_fn, "r", true).read();
 
     base->get_module_sack()->add(yaml_content, config.get_id());
 #endif
@@ -553,7 +592,7 @@ bool Repo::clone_root_metadata() {
     auto repodata_cachedir = std::filesystem::path(repo_cachedir) / CACHE_METADATA_DIR;
     try {
         std::filesystem::create_directories(repodata_cachedir);
-        std::filesystem::copy(root_repodata_cachedir, repodata_cachedir);
+        utils::fs::clone_directory_files(root_repodata_cachedir, repodata_cachedir);
     } catch (const std::filesystem::filesystem_error & e) {
         logger.debug(
             "Error when cloning root repodata from \"{}\" to \"{}\" : \"{}\"",
@@ -569,7 +608,7 @@ bool Repo::clone_root_metadata() {
     try {
         if (std::filesystem::exists(root_solv_cachedir)) {
             std::filesystem::create_directories(solv_cachedir);
-            std::filesystem::copy(root_solv_cachedir, solv_cachedir);
+            utils::fs::clone_directory_files(root_solv_cachedir, solv_cachedir);
         }
     } catch (const std::filesystem::filesystem_error & e) {
         logger.debug(
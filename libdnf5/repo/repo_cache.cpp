@@ -25,6 +25,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 #include "libdnf5/utils/fs/file.hpp"
 
+#include <sys/stat.h>
+
 
 namespace libdnf5::repo {
 
@@ -210,4 +212,33 @@ std::string RepoCache::get_repoid() {
 }
 
 
+std::uintmax_t RepoCache::get_size() {
+    std::uintmax_t size{0};
+    std::error_code ec;
+    for (const auto & dir_entry : std::filesystem::recursive_directory_iterator(cache_dir, ec)) {
+        if (!dir_entry.is_symlink(ec) && dir_entry.is_regular_file(ec)) {
+            auto file_size = dir_entry.file_size(ec);
+            if (!ec) {
+                size += file_size;
+            }
+        }
+    }
+    return size;
+}
+
+
+std::time_t RepoCache::get_last_used() {
+    try {
+        return static_cast<std::time_t>(std::stoll(read_attribute(ATTRIBUTE_LAST_USED)));
+    } catch (const std::exception &) {
+        // The cache was not loaded since the attribute was introduced or the attribute is damaged.
+    }
+    struct stat st;
+    if (stat(cache_dir.c_str(), &st) == 0) {
+        return st.st_mtime;
+    }
+    return 0;
+}
+
+
 }  // namespace libdnf5::repo
@@ -31,6 +31,7 @@ namespace {
 constexpr const char * CACHE_METADATA_DIR = "repodata";
 constexpr const char * CACHE_PACKAGES_DIR = "packages";
 constexpr const char * CACHE_SOLV_FILES_DIR = "solv";
+constexpr const char * CACHE_PACKAGE_NAMES_FILE_EXTENSION = ".names";
 
 }  // namespace
 
@@ -21,19 +21,26 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "utils/fs/utils.hpp"
 #include "utils/string.hpp"
+#include "utils/url.hpp"
 
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/conf/const.hpp"
 #include "libdnf5/repo/repo_errors.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
+#include "libdnf5/utils/fs/file.hpp"
 #include "libdnf5/utils/fs/temp.hpp"
 
 #include <librepo/librepo.h>
 #include <solv/chksum.h>
 #include <solv/util.h>
 
+#include <fcntl.h>
+
+#include <algorithm>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <random>
 
 
@@ -47,6 +54,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 namespace libdnf5::repo {
 
+// Metadata of several repositories can be downloaded in parallel (see `RepoSack::update_and_load_repos`).
+// The user-provided download callbacks are not required to be thread-safe, so their calls are serialized.
+static std::mutex download_callbacks_mutex;
+
 static void str_vector_to_char_array(const std::vector<std::string> & vec, const char * arr[]) {
     for (size_t i = 0; i < vec.size(); ++i) {
         arr[i] = vec[i].c_str();
@@ -60,6 +71,19 @@ static LrYumRepo * get_yum_repo(LibrepoResult & result) {
     return yum_repo;
 }
 
+// Compares the content of the file opened as `fd` with the "<type>:<hex digest>" checksum recorded in repomd.
+static bool file_matches_checksum(int fd, const std::string & checksum) {
+    auto separator = checksum.find(':');
+    auto checksum_type = lr_checksum_type(checksum.substr(0, separator).c_str());
+    gboolean matches{FALSE};
+    GError * err_p{nullptr};
+    lseek(fd, 0, SEEK_SET);
+    if (!lr_checksum_fd_cmp(checksum_type, fd, checksum.c_str() + separator + 1, FALSE, &matches, &err_p)) {
+        throw LibrepoError(std::unique_ptr<GError>(err_p));
+    }
+    return matches;
+}
+
 static LrYumRepoMd * get_yum_repomd(LibrepoResult & result) {
     LrYumRepoMd * yum_repomd;
     result.get_info(LRR_YUM_REPOMD, &yum_repomd);
@@ -73,6 +97,7 @@ int RepoDownloader::progress_cb(void * data, double total_to_download, double do
     }
     auto repo_downloader = static_cast<RepoDownloader *>(data);
     if (auto * download_callbacks = repo_downloader->base->get_download_callbacks()) {
+        std::lock_guard<std::mutex> lock(download_callbacks_mutex);
         // "total_to_download" and "downloaded" from librepo are related to the currently downloaded file.
         // We add the size of previously downloaded files.
         // ignore zero progress events at the beginning of the download, so we don't start with 100% progress
@@ -116,6 +141,7 @@ void RepoDownloader::fastest_mirror_cb(void * data, LrFastestMirrorStages stage,
         } else {
             msg = nullptr;
         }
+        std::lock_guard<std::mutex> lock(download_callbacks_mutex);
         download_callbacks->fastest_mirror(
             repo_downloader->user_cb_data, static_cast<DownloadCallbacks::FastestMirrorStage>(stage), msg);
     }
@@ -128,6 +154,7 @@ int RepoDownloader::mirror_failure_cb(
     }
     auto repo_downloader = static_cast<RepoDownloader *>(data);
     if (auto * download_callbacks = repo_downloader->base->get_download_callbacks()) {
+        std::lock_guard<std::mutex> lock(download_callbacks_mutex);
         return download_callbacks->mirror_failure(repo_downloader->user_cb_data, msg, url, metadata);
     }
     return 0;
@@ -148,7 +175,29 @@ RepoDownloader::RepoDownloader(const libdnf5::BaseWeakPtr & base, const ConfigRe
 RepoDownloader::~RepoDownloader() = default;
 
 
+void RepoDownloader::lock_cache() {
+    if (cache_locker) {
+        return;
+    }
+    // The lock file is next to the cache directory, it must survive the removal of the directory.
+    const std::filesystem::path cachedir{config.get_cachedir()};
+    std::error_code ec;
+    std::filesystem::create_directories(cachedir.parent_path(), ec);
+    auto locker = std::make_unique<libdnf5::utils::Locker>(cachedir.native() + ".lock", true);
+    try {
+        if (!ec && locker->read_lock()) {
+            cache_locker = std::move(locker);
+            return;
+        }
+    } catch (const SystemError &) {
+    }
+    base->get_logger()->debug("Cannot lock the repository cache \"{}\"", cachedir.native());
+}
+
+
+
 void RepoDownloader::download_metadata(const std::string & destdir) try {
+    lock_cache();
     std::filesystem::create_directories(destdir);
     libdnf5::utils::fs::TempDir tmpdir(destdir, "tmpdir");
 
@@ -160,6 +209,14 @@ void RepoDownloader::download_metadata(const std::string & destdir) try {
         auto tmp_item = dir.path();
 
         auto target_item = destdir / tmp_item.filename();
+
+        // Atomically exchange an existing item with the downloaded one, concurrent readers of the cache then
+        // see either the old or the new metadata, never a removed or partially moved directory.
+        // The old item ends up in the tmpdir and is removed with it.
+        if (renameat2(AT_FDCWD, tmp_item.c_str(), AT_FDCWD, target_item.c_str(), RENAME_EXCHANGE) == 0) {
+            continue;
+        }
+
         std::filesystem::remove_all(target_item);
 
         utils::fs::move_recursive(tmp_item, target_item);
@@ -276,6 +333,7 @@ bool RepoDownloader::is_repomd_in_sync() try {
 
 
 void RepoDownloader::load_local() try {
+    lock_cache();
     LibrepoHandle h(init_local_handle());
 
     auto result = perform(h, config.get_repo_gpgcheck_option().get_value());
@@ -322,6 +380,13 @@ void RepoDownloader::load_local() try {
         if (elem->data) {
             auto rec = static_cast<LrYumRepoMdRecord *>(elem->data);
             metadata_locations.emplace_back(rec->type, rec->location_href);
+            if (rec->checksum) {
+                metadata_checksums[rec->type] =
+                    fmt::format("{}:{}", libdnf5::utils::string::c_to_str(rec->checksum_type), rec->checksum);
+            }
+            if (rec->size_open > 0) {
+                metadata_open_sizes[rec->type] = static_cast<std::uint64_t>(rec->size_open);
+            }
         }
     }
 
@@ -344,6 +409,8 @@ void RepoDownloader::reset_loaded() {
     distro_tags.clear();
     metadata_locations.clear();
     metadata_paths.clear();
+    metadata_checksums.clear();
+    metadata_open_sizes.clear();
 }
 
 /// Returns a librepo handle, set as per the repo options.
@@ -374,18 +441,122 @@ void * RepoDownloader::get_user_data() const noexcept {
 }
 
 const std::string & RepoDownloader::get_metadata_path(const std::string & metadata_type) const {
-    auto it = metadata_paths.end();
+    return find_metadata_value(metadata_paths, metadata_type);
+}
+
+
+const std::string & RepoDownloader::get_metadata_checksum(const std::string & metadata_type) const {
+    return find_metadata_value(metadata_checksums, metadata_type);
+}
+
+
+bool RepoDownloader::download_ondemand_metadata(const std::string & metadata_type) try {
+    if (!get_metadata_path(metadata_type).empty()) {
+        return true;
+    }
+
+    auto location = std::find_if(metadata_locations.begin(), metadata_locations.end(), [&](const auto & item) {
+        return item.first == metadata_type;
+    });
+    if (location == metadata_locations.end() || is_local_in_place()) {
+        return false;
+    }
+
+    // The file can be left in the cache directory by an earlier on-demand download. It is not listed in
+    // the metadata loaded by `load_local()`, so it is reused here when it matches the current repomd.
+    std::filesystem::path path = std::filesystem::path(config.get_cachedir()) / location->second;
+    auto checksum = metadata_checksums.find(metadata_type);
+    if (checksum != metadata_checksums.end() && std::filesystem::exists(path)) {
+        libdnf5::utils::fs::File cached_file(path, "r");
+        if (file_matches_checksum(cached_file.get_fd(), checksum->second)) {
+            metadata_paths[metadata_type] = path;
+            return true;
+        }
+    }
+
+    if (config.get_main_config().get_cacheonly_option().get_value() != "none") {
+        base->get_logger()->debug(
+            "Not downloading {} metadata for repo \"{}\", cacheonly option is activated",
+            metadata_type,
+            config.get_id());
+        return false;
+    }
+
+    // The location is relative to the repository, it is resolved against the mirrors of the cached handle
+    std::filesystem::create_directories(path.parent_path());
+    libdnf5::utils::fs::TempFile tmp_file(path.parent_path(), path.filename().string());
+
+    download_url(location->second.c_str(), tmp_file.get_fd());
+
+    if (checksum != metadata_checksums.end() && !file_matches_checksum(tmp_file.get_fd(), checksum->second)) {
+        throw RepoDownloadError(M_("Checksum of the downloaded file \"{}\" does not match"), location->second);
+    }
+
+    tmp_file.close();
+    std::filesystem::rename(tmp_file.get_path(), path);
+    tmp_file.release();
+
+    metadata_paths[metadata_type] = path;
+    return true;
+} catch (const std::runtime_error & e) {
+    throw_with_nested(
+        RepoDownloadError(M_("Error downloading {} metadata for repository \"{}\""), metadata_type, config.get_id()));
+}
+
+
+std::uint64_t RepoDownloader::get_metadata_open_size(const std::string & metadata_type) const {
+    auto it = metadata_open_sizes.find(metadata_type);
+    return it != metadata_open_sizes.end() ? it->second : 0;
+}
+
+
+const std::string & RepoDownloader::find_metadata_value(
+    const std::map<std::string, std::string> & values, const std::string & metadata_type) const {
+    auto it = values.end();
 
     if (config.get_main_config().get_zchunk_option().get_value() && !utils::string::ends_with(metadata_type, "_zck")) {
-        it = metadata_paths.find(metadata_type + "_zck");
+        it = values.find(metadata_type + "_zck");
     }
 
-    if (it == metadata_paths.end()) {
-        it = metadata_paths.find(metadata_type);
+    if (it == values.end()) {
+        it = values.find(metadata_type);
     }
 
     static const std::string empty;
-    return it != metadata_paths.end() ? it->second : empty;
+    return it != values.end() ? it->second : empty;
+}
+
+
+bool RepoDownloader::is_local_in_place() const {
+    return !get_local_in_place_dir().empty();
+}
+
+
+std::string RepoDownloader::get_local_in_place_dir() const {
+    if (!config.get_local_in_place_option().get_value()) {
+        return {};
+    }
+    if ((!config.get_metalink_option().empty() && !config.get_metalink_option().get_value().empty()) ||
+        (!config.get_mirrorlist_option().empty() && !config.get_mirrorlist_option().get_value().empty())) {
+        return {};
+    }
+
+    // all baseurls must be local, the first directory containing the metadata is used
+    std::vector<std::string> dirs;
+    for (const auto & baseurl : config.get_baseurl_option().get_value()) {
+        auto dir = utils::url::file_url_to_path(baseurl);
+        if (dir.empty()) {
+            return {};
+        }
+        dirs.push_back(std::move(dir));
+    }
+    for (const auto & dir : dirs) {
+        std::error_code ec;
+        if (std::filesystem::exists(std::filesystem::path(dir) / METADATA_RELATIVE_DIR / "repomd.xml", ec)) {
+            return dir;
+        }
+    }
+    return dirs.empty() ? std::string() : dirs.front();
 }
 
 
@@ -394,9 +565,13 @@ LibrepoHandle RepoDownloader::init_local_handle() {
 
     common_handle_setup(h);
 
-    std::string cachedir = config.get_cachedir();
-    h.set_opt(LRO_DESTDIR, cachedir.c_str());
-    const char * urls[] = {cachedir.c_str(), nullptr};
+    // In the in-place mode the metadata are used directly from the local repository directory
+    std::string metadata_dir = get_local_in_place_dir();
+    if (metadata_dir.empty()) {
+        metadata_dir = config.get_cachedir();
+    }
+    h.set_opt(LRO_DESTDIR, metadata_dir.c_str());
+    const char * urls[] = {metadata_dir.c_str(), nullptr};
     h.set_opt(LRO_URLS, urls);
     h.set_opt(LRO_LOCAL, 1L);
 
@@ -570,6 +745,7 @@ LibrepoResult RepoDownloader::perform(LibrepoHandle & handle, bool set_gpg_home_
     add_countme_flag(handle);
 
     if (progress_func && download_callbacks) {
+        std::lock_guard<std::mutex> lock(download_callbacks_mutex);
         user_cb_data = download_callbacks->add_new_download(
             user_data,
             !config.get_name_option().get_value().empty()
@@ -584,11 +760,13 @@ LibrepoResult RepoDownloader::perform(LibrepoHandle & handle, bool set_gpg_home_
     try {
         auto result = handle.perform();
         if (progress_func && download_callbacks) {
+            std::lock_guard<std::mutex> lock(download_callbacks_mutex);
             download_callbacks->end(user_cb_data, DownloadCallbacks::TransferStatus::SUCCESSFUL, nullptr);
         }
         return result;
     } catch (const LibrepoError & ex) {
         if (progress_func && download_callbacks) {
+            std::lock_guard<std::mutex> lock(download_callbacks_mutex);
             download_callbacks->end(user_cb_data, DownloadCallbacks::TransferStatus::ERROR, ex.what());
         }
         throw;
@@ -600,6 +778,8 @@ void RepoDownloader::download_url(const char * url, int fd) {
     auto * download_callbacks = base->get_download_callbacks();
 
     if (download_callbacks) {
+        // On-demand metadata of several repositories can be downloaded in parallel
+        std::lock_guard<std::mutex> lock(download_callbacks_mutex);
         user_cb_data = download_callbacks->add_new_download(user_data, url, -1);
         prev_total_to_download = 0;
         prev_downloaded = 0;
@@ -611,12 +791,14 @@ void RepoDownloader::download_url(const char * url, int fd) {
 
     if (res) {
         if (download_callbacks) {
+            std::lock_guard<std::mutex> lock(download_callbacks_mutex);
             download_callbacks->end(user_cb_data, DownloadCallbacks::TransferStatus::SUCCESSFUL, nullptr);
         }
     } else {
         std::unique_ptr<GError> err(err_p);
 
         if (download_callbacks) {
+            std::lock_guard<std::mutex> lock(download_callbacks_mutex);
             download_callbacks->end(user_cb_data, DownloadCallbacks::TransferStatus::ERROR, err->message);
         }
 
@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "librepo.hpp"
 #include "repo_pgp.hpp"
+#include "utils/locker.hpp"
 
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/common/exception.hpp"
@@ -31,6 +32,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <librepo/librepo.h>
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
@@ -67,6 +69,10 @@ public:
     void load_local();
     void reset_loaded();
 
+    /// @return `true` if the metadata are read directly from the repository's "file://" baseurl directory
+    ///         instead of from the cache directory (see the "local_in_place" repository option).
+    bool is_local_in_place() const;
+
     LibrepoHandle & get_cached_handle();
 
     void set_callbacks(std::unique_ptr<libdnf5::repo::RepoCallbacks> && callbacks) noexcept;
@@ -75,11 +81,27 @@ public:
 
     const std::string & get_metadata_path(const std::string & metadata_type) const;
 
+    /// @return The checksum of the metadata file of the `metadata_type` as recorded in repomd, or an empty string.
+    const std::string & get_metadata_checksum(const std::string & metadata_type) const;
+
+    /// @return The uncompressed size of the metadata file of the `metadata_type` as recorded in repomd, or 0.
+    std::uint64_t get_metadata_open_size(const std::string & metadata_type) const;
+
+    /// Downloads the metadata file of the `metadata_type` listed in repomd into the cache directory if it was not
+    /// downloaded together with the repository metadata. The file is verified against the checksum from repomd.
+    /// A file already present in the cache directory is used when it matches the checksum. Nothing is downloaded
+    /// if the "cacheonly" option is set.
+    /// @return `true` if the metadata file is available, `false` if repomd does not list the `metadata_type`
+    ///         or the file is not cached and cannot be downloaded.
+    bool download_ondemand_metadata(const std::string & metadata_type);
+
 
 private:
     friend class Repo;
     friend class RepoSack;
 
+    /// @return The local directory the metadata are read from in the in-place mode, empty if it is not used.
+    std::string get_local_in_place_dir() const;
     LibrepoHandle init_local_handle();
     LibrepoHandle init_remote_handle(const char * destdir, bool mirror_setup = true, bool set_callbacks = true);
     void common_handle_setup(LibrepoHandle & h);
@@ -95,10 +117,18 @@ private:
     void import_repo_keys();
 
     std::string get_persistdir() const;
+
+    /// Takes a shared lock of the repository cache, so that `RepoSack::apply_cache_budget()` in other processes
+    /// does not remove it while it is used. The lock is held until the downloader is destroyed.
+    void lock_cache();
     void add_countme_flag(LibrepoHandle & handle);
 
     std::set<std::string> get_optional_metadata() const;
 
+    /// Finds the value for the `metadata_type` in `values`. Prefers the zchunk variant if zchunk is enabled.
+    const std::string & find_metadata_value(
+        const std::map<std::string, std::string> & values, const std::string & metadata_type) const;
+
     libdnf5::BaseWeakPtr base;
     const ConfigRepo & config;
     Repo::Type repo_type;
@@ -130,8 +160,12 @@ private:
     std::vector<std::pair<std::string, std::string>> distro_tags;
     std::vector<std::pair<std::string, std::string>> metadata_locations;
     std::map<std::string, std::string> metadata_paths;
+    std::map<std::string, std::string> metadata_checksums;
+    std::map<std::string, std::uint64_t> metadata_open_sizes;
 
     std::optional<LibrepoHandle> handle;
+
+    std::unique_ptr<libdnf5::utils::Locker> cache_locker;
 };
 
 
@@ -19,12 +19,19 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "repo_pgp.hpp"
 
+#include "base/base_impl.hpp"
+
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/logger/logger.hpp"
 #include "libdnf5/repo/repo_errors.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 #include "libdnf5/utils/fs/temp.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <memory>
 
 namespace libdnf5::repo {
@@ -51,18 +58,76 @@ Key::Key(const LrGpgKey * key, const LrGpgSubkey * subkey, const std::string & u
 }
 
 
-std::vector<Key> RepoPgp::rawkey2infos(int fd, const std::string & url, const std::string & path) {
-    std::vector<Key> key_infos;
+static std::string read_key_data(int fd) {
+    std::string key_data;
+    char buf[4096];
+    ssize_t count;
+    while ((count = read(fd, buf, sizeof(buf))) != 0) {
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw RepoPgpError(M_("Failed to read pgp key: {}"), std::string(std::strerror(errno)));
+        }
+        key_data.append(buf, static_cast<size_t>(count));
+    }
+    return key_data;
+}
 
-    libdnf5::utils::fs::TempDir tmpdir("tmpdir");
 
-    GError * err = NULL;
-    if (!lr_gpg_import_key_from_fd(fd, tmpdir.get_path().c_str(), &err)) {
-        throw_repo_pgp_error(M_("Failed to import pgp keys into temporary keyring: {}"), err);
+Key::Key(const Key & key, const std::string & url, const std::string & path) : Key(key) {
+    key_url = url;
+    key_path = path;
+}
+
+
+std::vector<Key> PgpKeyCache::get_keys(
+    const std::string & key_data, const std::string & url, const std::string & path) {
+    std::vector<Key> keys;
+
+    auto it = fingerprints_by_key_data.find(key_data);
+    if (it == fingerprints_by_key_data.end()) {
+        keys = RepoPgp::parse_keys(key_data, url, path);
+        std::vector<std::string> fingerprints;
+        for (const auto & key : keys) {
+            fingerprints.push_back(key.get_fingerprint());
+            keys_by_fingerprint.try_emplace(key.get_fingerprint(), key);
+        }
+        fingerprints_by_key_data.emplace(key_data, std::move(fingerprints));
+        return keys;
     }
 
+    for (const auto & fingerprint : it->second) {
+        keys.emplace_back(keys_by_fingerprint.at(fingerprint), url, path);
+    }
+    return keys;
+}
+
+
+const std::vector<std::string> & PgpKeyCache::get_keyring_key_ids(const std::filesystem::path & keyring_dir) {
+    auto it = keyring_key_ids.find(keyring_dir);
+    if (it == keyring_key_ids.end()) {
+        it = keyring_key_ids.emplace(keyring_dir, RepoPgp::load_keys_ids_from_keyring(keyring_dir)).first;
+    }
+    return it->second;
+}
+
+
+void PgpKeyCache::add_keyring_key_id(const std::filesystem::path & keyring_dir, const std::string & key_id) {
+    auto & key_ids = keyring_key_ids[keyring_dir];
+    if (std::find(key_ids.begin(), key_ids.end(), key_id) == key_ids.end()) {
+        key_ids.push_back(key_id);
+    }
+}
+
+
+static std::vector<Key> list_signing_keys(
+    const std::filesystem::path & gpg_home, const std::string & url, const std::string & path) {
+    std::vector<Key> key_infos;
+
+    GError * err = NULL;
     std::unique_ptr<LrGpgKey, decltype(&lr_gpg_keys_free)> lr_keys{
-        lr_gpg_list_keys(TRUE, tmpdir.get_path().c_str(), &err), &lr_gpg_keys_free};
+        lr_gpg_list_keys(TRUE, gpg_home.c_str(), &err), &lr_gpg_keys_free};
     if (err) {
         throw_repo_pgp_error(M_("Failed to list pgp keys: {}"), err);
     }
@@ -82,10 +147,27 @@ std::vector<Key> RepoPgp::rawkey2infos(int fd, const std::string & url, const st
 }
 
 
-std::vector<std::string> RepoPgp::load_keys_ids_from_keyring() {
+std::vector<Key> RepoPgp::rawkey2infos(
+    const BaseWeakPtr & base, int fd, const std::string & url, const std::string & path) {
+    return InternalBaseUser::get_pgp_key_cache(base).get_keys(read_key_data(fd), url, path);
+}
+
+
+std::vector<Key> RepoPgp::parse_keys(const std::string & key_data, const std::string & url, const std::string & path) {
+    libdnf5::utils::fs::TempDir tmpdir("tmpdir");
+
+    GError * err = NULL;
+    if (!lr_gpg_import_key_from_memory(key_data.c_str(), key_data.size(), tmpdir.get_path().c_str(), &err)) {
+        throw_repo_pgp_error(M_("Failed to import pgp keys into temporary keyring: {}"), err);
+    }
+
+    return list_signing_keys(tmpdir.get_path(), url, path);
+}
+
+
+std::vector<std::string> RepoPgp::load_keys_ids_from_keyring(const std::filesystem::path & keyring_dir) {
     std::vector<std::string> keys_ids;
 
-    auto keyring_dir = get_keyring_dir();
     if (std::filesystem::is_directory(keyring_dir)) {
         GError * err = NULL;
         std::unique_ptr<LrGpgKey, decltype(&lr_gpg_keys_free)> lr_keys{
@@ -115,11 +197,13 @@ RepoPgp::RepoPgp(const BaseWeakPtr & base, const ConfigRepo & config) : base(bas
 
 void RepoPgp::import_key(int fd, const std::string & url) {
     auto & logger = *base->get_logger();
+    auto & key_cache = InternalBaseUser::get_pgp_key_cache(base);
 
-    auto key_infos = rawkey2infos(fd, url);
+    auto key_infos = rawkey2infos(base, fd, url);
 
-    auto known_keys = load_keys_ids_from_keyring();
+    auto keyring_dir = get_keyring_dir();
     for (auto & key_info : key_infos) {
+        const auto & known_keys = key_cache.get_keyring_key_ids(keyring_dir);
         if (std::find(known_keys.begin(), known_keys.end(), key_info.get_key_id()) != known_keys.end()) {
             logger.debug("Pgp key 0x{} for repository {} already imported.", key_info.get_key_id(), config.get_id());
             continue;
@@ -129,8 +213,6 @@ void RepoPgp::import_key(int fd, const std::string & url) {
             continue;
         }
 
-        auto keyring_dir = get_keyring_dir();
-
         if (!std::filesystem::is_directory(keyring_dir)) {
             std::filesystem::create_directories(keyring_dir);
         }
@@ -140,6 +222,7 @@ void RepoPgp::import_key(int fd, const std::string & url) {
                 key_info.get_raw_key().c_str(), key_info.get_raw_key().size(), keyring_dir.c_str(), &err)) {
             throw_repo_pgp_error(M_("Failed to import pgp keys: {}"), err);
         }
+        key_cache.add_keyring_key_id(keyring_dir, key_info.get_key_id());
 
         if (callbacks) {
             callbacks->repokey_imported(key_info);
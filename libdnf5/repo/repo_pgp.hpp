@@ -29,7 +29,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <librepo/librepo.h>
 
 #include <filesystem>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -38,6 +40,34 @@ namespace libdnf5::repo {
 class Key : public libdnf5::rpm::KeyInfo {
 public:
     Key(const LrGpgKey * key, const LrGpgSubkey * subkey, const std::string & url, const std::string & path);
+
+    /// Copy of the `key` read from another location.
+    Key(const Key & key, const std::string & url, const std::string & path);
+};
+
+/// Parsed keys and key ids of the repository keyrings, shared by all repositories of one Base.
+/// Parsing key data imports it into a temporary gpg home directory and listing a keyring runs gpg.
+/// With many repositories, each with its own key file, that is repeated for every repository and key,
+/// so the results are kept for the lifetime of the Base. Parsed keys are stored by fingerprint.
+class PgpKeyCache {
+public:
+    /// @return Signing keys contained in the key data. The data are parsed only the first time they are seen.
+    std::vector<Key> get_keys(const std::string & key_data, const std::string & url, const std::string & path);
+
+    /// @return Ids of the keys in the keyring directory. The keyring is listed only the first time.
+    const std::vector<std::string> & get_keyring_key_ids(const std::filesystem::path & keyring_dir);
+
+    /// Records a key that was imported into the keyring directory.
+    void add_keyring_key_id(const std::filesystem::path & keyring_dir, const std::string & key_id);
+
+    /// @return Number of distinct key data parsed so far.
+    std::size_t get_parsed_key_data_count() const noexcept { return fingerprints_by_key_data.size(); }
+
+private:
+    // key data -> fingerprints of the signing keys it contains
+    std::unordered_map<std::string, std::vector<std::string>> fingerprints_by_key_data;
+    std::unordered_map<std::string, Key> keys_by_fingerprint;
+    std::map<std::filesystem::path, std::vector<std::string>> keyring_key_ids;
 };
 
 /// Wraps pgp in a higher-level interface.
@@ -51,10 +81,18 @@ public:
     std::filesystem::path get_keyring_dir() const { return std::filesystem::path(config.get_cachedir()) / "pubring"; }
 
     void import_key(int fd, const std::string & url);
-    static std::vector<Key> rawkey2infos(int fd, const std::string & url, const std::string & path = "");
+
+    /// @return Signing keys contained in the key file. Keys already parsed by the `base` are reused.
+    static std::vector<Key> rawkey2infos(
+        const BaseWeakPtr & base, int fd, const std::string & url, const std::string & path = "");
+
+    /// @return Signing keys contained in the key data.
+    static std::vector<Key> parse_keys(const std::string & key_data, const std::string & url, const std::string & path);
+
+    /// @return Ids of the signing keys in the keyring directory.
+    static std::vector<std::string> load_keys_ids_from_keyring(const std::filesystem::path & keyring_dir);
 
 private:
-    std::vector<std::string> load_keys_ids_from_keyring();
     BaseWeakPtr base;
     const ConfigRepo & config;
     RepoCallbacks * callbacks = nullptr;
@@ -33,7 +33,9 @@ struct Get {
     static bool expired(const RepoWeakPtr & obj) { return obj->is_expired(); }
     static bool local(const RepoWeakPtr & obj) { return obj->is_local(); }
     static std::string id(const RepoWeakPtr & obj) { return obj->get_id(); }
-    static std::string name(const RepoWeakPtr & obj) { return obj->get_config().get_name_option().get_value(); }
+    static std::string_view name(const RepoWeakPtr & obj) {
+        return obj->get_config().get_name_option().get_value();
+    }
     static int64_t type(const RepoWeakPtr & obj) { return static_cast<int64_t>(obj->get_type()); }
 };
 
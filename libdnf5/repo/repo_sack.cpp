@@ -28,6 +28,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "solv_repo.hpp"
 #include "utils/auth.hpp"
 #include "utils/fs/utils.hpp"
+#include "utils/locker.hpp"
 #include "utils/string.hpp"
 #include "utils/url.hpp"
 #include "utils/xml.hpp"
@@ -48,11 +49,15 @@ extern "C" {
 #include <solv/testcase.h>
 }
 
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
 #include <condition_variable>
+#include <ctime>
+#include <exception>
 #include <filesystem>
 #include <mutex>
+#include <set>
 #include <sstream>
 #include <thread>
 
@@ -66,6 +71,10 @@ namespace {
 // Names of special repositories
 constexpr const char * SYSTEM_REPO_NAME = "@System";
 constexpr const char * CMDLINE_REPO_NAME = "@commandline";
+
+// Repository caches used within the last hour are kept by `RepoSack::apply_cache_budget()` even if they are
+// not locked, a process can be just about to use them again.
+constexpr std::time_t CACHE_BUDGET_MIN_UNUSED_SECONDS = 60 * 60;
 // TODO lukash: unused, remove?
 //constexpr const char * MODULE_FAIL_SAFE_REPO_NAME = "@modulefailsafe";
 
@@ -77,11 +86,9 @@ RepoSack::RepoSack(libdnf5::Base & base) : RepoSack(base.get_weak_ptr()) {}
 
 
 RepoWeakPtr RepoSack::create_repo(const std::string & id) {
-    for (const auto & existing_repo : get_data()) {
-        if (existing_repo->get_id() == id) {
-            throw RepoIdAlreadyExistsError(
-                M_("Failed to create repo \"{}\": Id is present more than once in the configuration"), id);
-        }
+    if (!base->p_impl->get_repo_ids().insert(id).second) {
+        throw RepoIdAlreadyExistsError(
+            M_("Failed to create repo \"{}\": Id is present more than once in the configuration"), id);
     }
     auto repo = std::make_unique<Repo>(base, id, Repo::Type::AVAILABLE);
     return add_item_with_return(std::move(repo));
@@ -98,6 +105,7 @@ RepoWeakPtr RepoSack::create_repo_from_libsolv_testcase(const std::string & id,
 RepoWeakPtr RepoSack::get_cmdline_repo() {
     if (!cmdline_repo) {
         std::unique_ptr<Repo> repo(new Repo(base, CMDLINE_REPO_NAME, Repo::Type::COMMANDLINE));
+        base->p_impl->get_repo_ids().insert(CMDLINE_REPO_NAME);
         repo->get_config().get_build_cache_option().set(libdnf5::Option::Priority::RUNTIME, false);
         cmdline_repo = repo.get();
         add_item(std::move(repo));
@@ -163,27 +171,51 @@ std::map<std::string, libdnf5::rpm::Package> RepoSack::add_cmdline_packages(
     // map a path from the input paths to a Package object created in the cmdline repo
     std::map<std::string, libdnf5::rpm::Package> path_to_package;
 
+    // The remote URLs are downloaded in a separate thread while the headers of the local files are read
+    // into the cmdline repo. Reading the headers is not parallelized itself, the libsolv pool is not thread-safe.
+    libdnf5::repo::FileDownloader downloader(base);
+    std::exception_ptr download_except_ptr;  // for passing an exception from thread_downloader to the main thread
+    std::thread thread_downloader;
     if (!url_to_path.empty()) {
         auto & logger = *base->get_logger();
-        // download remote URLs
-        libdnf5::repo::FileDownloader downloader(base);
         for (auto & [url, dest_path] : url_to_path) {
             logger.debug("Downloading package \"{}\" to file \"{}\"", url, dest_path.string());
             // TODO(mblaha): temporarily used the dummy DownloadCallbacks instance
             downloader.add(std::string{url}, dest_path.string());
         }
-        downloader.download();
+        thread_downloader = std::thread([&]() {
+            try {
+                downloader.download();
+            } catch (...) {
+                // The thread must not throw exceptions. Pass them to the main thread using exception_ptr.
+                download_except_ptr = std::current_exception();
+            }
+        });
+    }
 
-        // fill the command line repo with downloaded URLs
-        for (const auto & [url, path] : url_to_path) {
-            path_to_package.emplace(url, cmdline_repo->add_rpm_package(path.string(), calculate_checksum));
+    // fill the command line repo with local files
+    try {
+        for (const auto & path : rpm_filepaths) {
+            if (!path_to_package.contains(path)) {
+                path_to_package.emplace(path, cmdline_repo->add_rpm_package(path, calculate_checksum));
+            }
         }
+    } catch (...) {
+        if (thread_downloader.joinable()) {
+            thread_downloader.join();
+        }
+        throw;
     }
 
-    // fill the command line repo with local files
-    for (const auto & path : rpm_filepaths) {
-        if (!path_to_package.contains(path)) {
-            path_to_package.emplace(path, cmdline_repo->add_rpm_package(path, calculate_checksum));
+    if (thread_downloader.joinable()) {
+        thread_downloader.join();
+        if (download_except_ptr) {
+            std::rethrow_exception(download_except_ptr);
+        }
+
+        // fill the command line repo with downloaded URLs
+        for (const auto & [url, path] : url_to_path) {
+            path_to_package.emplace(url, cmdline_repo->add_rpm_package(path.string(), calculate_checksum));
         }
     }
 
@@ -198,6 +230,7 @@ std::map<std::string, libdnf5::rpm::Package> RepoSack::add_cmdline_packages(
 RepoWeakPtr RepoSack::get_system_repo() {
     if (!system_repo) {
         std::unique_ptr<Repo> repo(new Repo(base, SYSTEM_REPO_NAME, Repo::Type::SYSTEM));
+        base->p_impl->get_repo_ids().insert(SYSTEM_REPO_NAME);
         // TODO(mblaha): re-enable caching once we can reliably detect whether system repo is up-to-date
         repo->get_config().get_build_cache_option().set(libdnf5::Option::Priority::RUNTIME, false);
         system_repo = repo.get();
@@ -390,15 +423,21 @@ void RepoSack::update_and_load_repos(libdnf5::repo::RepoQuery & repos, bool impo
             catch_thread_sack_loader_exceptions();
             try {
                 bool valid_metadata{false};
+                const bool local_in_place = repo->downloader->is_local_in_place();
                 try {
                     repo->read_metadata_cache();
                     if (!repo->downloader->get_metadata_path(RepoDownloader::MD_FILENAME_PRIMARY).empty()) {
                         // cache loaded
                         repo->recompute_expired();
-                        valid_metadata = !repo->expired || repo->sync_strategy == Repo::SyncStrategy::ONLY_CACHE ||
+                        valid_metadata = !repo->expired || local_in_place ||
+                                         repo->sync_strategy == Repo::SyncStrategy::ONLY_CACHE ||
                                          repo->sync_strategy == Repo::SyncStrategy::LAZY;
                     }
                 } catch (const std::runtime_error & e) {
+                    if (local_in_place) {
+                        // there is no copy to download, the local repository itself is unreadable
+                        throw;
+                    }
                 }
 
                 if (valid_metadata) {
@@ -437,7 +476,16 @@ void RepoSack::update_and_load_repos(libdnf5::repo::RepoQuery & repos, bool impo
                 if (!repo->downloader->get_metadata_path(RepoDownloader::MD_FILENAME_PRIMARY).empty() &&
                     repo->is_in_sync()) {
                     // the expired metadata still reflect the origin
-                    utimes(repo->downloader->get_metadata_path(RepoDownloader::MD_FILENAME_PRIMARY).c_str(), nullptr);
+                    const auto & primary_path =
+                        repo->downloader->get_metadata_path(RepoDownloader::MD_FILENAME_PRIMARY);
+                    try {
+                        // the metadata can be hardlinked from the root cache (see `Repo::clone_root_metadata()`),
+                        // touching them must not change the timestamp of that cache
+                        utils::fs::break_hard_link(primary_path);
+                    } catch (const std::filesystem::filesystem_error & e) {
+                        logger->debug("Cannot break hard link of \"{}\": {}", primary_path, e.what());
+                    }
+                    utimes(primary_path.c_str(), nullptr);
                     RepoCache(base, repo->config.get_cachedir()).remove_attribute(RepoCache::ATTRIBUTE_EXPIRED);
                     repo->expired = false;
                     repos_for_processing.erase(repos_for_processing.begin() + static_cast<ssize_t>(idx));
@@ -462,30 +510,109 @@ void RepoSack::update_and_load_repos(libdnf5::repo::RepoQuery & repos, bool impo
         }
 
         // Prepares (downloads) remaining repositories.
-        for (std::size_t idx = 0; idx < repos_for_processing.size();) {
-            auto * const repo = repos_for_processing[idx];
-            catch_thread_sack_loader_exceptions();
-            try {
+        // The metadata are downloaded in parallel by a pool of worker threads. Each repository is downloaded
+        // by a single worker. The results are processed in the main thread in the order in which the downloads
+        // finish, so the error handling and the feeding of the sack loader stay single-threaded.
+        if (!repos_for_processing.empty()) {
+            std::mutex downloads_mutex;                          // guards the download state below
+            std::condition_variable signal_finished_download;  // signals that a download has finished
+            std::size_t next_repo_to_download{0};               // index of the next repo to download
+            bool stop_downloads{false};                         // workers stop picking up new repositories
+            std::vector<std::pair<Repo *, std::exception_ptr>> finished_downloads;  // results not yet processed
+
+            auto download_worker = [&]() {
+                while (true) {
+                    Repo * repo;
+                    {
+                        std::lock_guard<std::mutex> lock(downloads_mutex);
+                        if (stop_downloads || next_repo_to_download >= repos_for_processing.size()) {
+                            break;
+                        }
+                        repo = repos_for_processing[next_repo_to_download++];
+                    }
+
+                    std::exception_ptr download_except_ptr;
+                    try {
+                        auto cache_dir = repo->config.get_cachedir();
+                        repo->download_metadata(cache_dir);
+                        RepoCache(base, cache_dir).remove_attribute(RepoCache::ATTRIBUTE_EXPIRED);
+                        repo->timestamp = -1;
+                        repo->read_metadata_cache();
+                        repo->expired = false;
+                    } catch (...) {
+                        // The thread must not throw exceptions. Pass them to the main thread using exception_ptr.
+                        download_except_ptr = std::current_exception();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(downloads_mutex);
+                        finished_downloads.emplace_back(repo, download_except_ptr);
+                    }
+                    signal_finished_download.notify_one();
+                }
+            };
+
+            // Every repository uses its own librepo handle limited by its own "max_parallel_downloads".
+            // The number of repositories downloaded at the same time is limited by the main configuration value.
+            const std::size_t max_download_workers = std::max<std::size_t>(
+                1, base->get_config().get_max_parallel_downloads_option().get_value());
+            const std::size_t num_download_workers = std::min(max_download_workers, repos_for_processing.size());
+
+            for (auto * repo : repos_for_processing) {
                 logger->debug("Downloading metadata for repo \"{}\"", repo->config.get_id());
-                auto cache_dir = repo->config.get_cachedir();
-                repo->download_metadata(cache_dir);
-                RepoCache(base, cache_dir).remove_attribute(RepoCache::ATTRIBUTE_EXPIRED);
-                repo->timestamp = -1;
-                repo->read_metadata_cache();
-                repo->expired = false;
+            }
 
-                repos_for_processing.erase(repos_for_processing.begin() + static_cast<ssize_t>(idx));
-                send_to_sack_loader(repo);
-            } catch (const RepoDownloadError & e) {
-                if (handle_repo_download_error(repo, e, import_keys)) {
-                    repos_with_bad_signature.emplace_back(repo);
+            std::vector<std::thread> download_workers;
+            download_workers.reserve(num_download_workers);
+
+            // Stops the workers from picking up more repositories and waits for the running downloads to finish.
+            auto join_download_workers = [&]() {
+                {
+                    std::lock_guard<std::mutex> lock(downloads_mutex);
+                    stop_downloads = true;
                 }
-                repos_for_processing.erase(repos_for_processing.begin() + static_cast<ssize_t>(idx));
-            } catch (const std::runtime_error & e) {
-                except_in_main_thread = true;
-                finish_sack_loader();
+                for (auto & worker : download_workers) {
+                    if (worker.joinable()) {
+                        worker.join();
+                    }
+                }
+            };
+
+            try {
+                for (std::size_t i = 0; i < num_download_workers; ++i) {
+                    download_workers.emplace_back(download_worker);
+                }
+
+                for (std::size_t num_processed = 0; num_processed < repos_for_processing.size(); ++num_processed) {
+                    std::unique_lock<std::mutex> lock(downloads_mutex);
+                    signal_finished_download.wait(lock, [&]() { return !finished_downloads.empty(); });
+                    auto [repo, download_except_ptr] = finished_downloads.front();
+                    finished_downloads.erase(finished_downloads.begin());
+                    lock.unlock();
+
+                    catch_thread_sack_loader_exceptions();
+                    if (!download_except_ptr) {
+                        send_to_sack_loader(repo);
+                        continue;
+                    }
+                    try {
+                        std::rethrow_exception(download_except_ptr);
+                    } catch (const RepoDownloadError & e) {
+                        if (handle_repo_download_error(repo, e, import_keys)) {
+                            repos_with_bad_signature.emplace_back(repo);
+                        }
+                    } catch (const std::runtime_error & e) {
+                        except_in_main_thread = true;
+                        finish_sack_loader();
+                        throw;
+                    }
+                }
+            } catch (...) {
+                join_download_workers();
                 throw;
             }
+
+            join_download_workers();
         }
     };
 
@@ -677,6 +804,94 @@ void RepoSack::enable_source_repos() {
     }
 }
 
+RepoCache::RemoveStatistics RepoSack::apply_cache_budget() {
+    RepoCache::RemoveStatistics statistics{};
+    const auto & config = base->get_config();
+    const auto cache_budget = config.get_cache_budget_option().get_value();
+    if (cache_budget == 0) {
+        return statistics;
+    }
+    auto & logger = *base->get_logger();
+
+    std::set<std::string> enabled_repos_cache_dirs;
+    RepoQuery enabled_repos(base);
+    enabled_repos.filter_enabled(true);
+    for (const auto & repo : enabled_repos) {
+        enabled_repos_cache_dirs.insert(std::filesystem::path(repo->get_cachedir()).filename());
+    }
+
+    struct CacheUsage {
+        std::filesystem::path path;
+        std::time_t last_used;
+        std::uintmax_t size;
+    };
+    std::vector<CacheUsage> eviction_candidates;
+    std::uintmax_t total_size{0};
+
+    const std::filesystem::path cachedir{config.get_cachedir_option().get_value()};
+    std::error_code ec;
+    for (const auto & dir_entry : std::filesystem::directory_iterator(cachedir, ec)) {
+        if (!dir_entry.is_directory(ec)) {
+            continue;
+        }
+        RepoCache cache(base, dir_entry.path());
+        try {
+            cache.get_repoid();
+        } catch (const RepoCacheError &) {
+            // not a repository cache
+            continue;
+        }
+        const auto size = cache.get_size();
+        total_size += size;
+        if (!enabled_repos_cache_dirs.contains(dir_entry.path().filename())) {
+            eviction_candidates.push_back({dir_entry.path(), cache.get_last_used(), size});
+        }
+    }
+
+    std::sort(eviction_candidates.begin(), eviction_candidates.end(), [](const auto & lhs, const auto & rhs) {
+        return lhs.last_used < rhs.last_used;
+    });
+
+    const auto now = std::time(nullptr);
+    for (const auto & candidate : eviction_candidates) {
+        if (total_size <= cache_budget) {
+            break;
+        }
+        if (now - candidate.last_used < CACHE_BUDGET_MIN_UNUSED_SECONDS) {
+            logger.debug("Keeping recently used repository cache \"{}\"", candidate.path.native());
+            continue;
+        }
+        // Other processes hold a shared lock of the caches they use, see `RepoDownloader::lock_cache()`.
+        utils::Locker locker(candidate.path.native() + ".lock");
+        bool locked{false};
+        try {
+            locked = locker.write_lock();
+        } catch (const SystemError &) {
+        }
+        if (!locked) {
+            logger.debug("Keeping repository cache \"{}\" used by another process", candidate.path.native());
+            continue;
+        }
+        logger.debug(
+            "Removing repository cache \"{}\" ({} bytes) to fit into the cache budget",
+            candidate.path.native(),
+            candidate.size);
+        statistics += RepoCache(base, candidate.path).remove_all();
+        total_size -= candidate.size;
+    }
+
+    if (total_size > cache_budget) {
+        logger.info(
+            "Repository caches in \"{}\" take {} bytes, more than the cache budget {} bytes, "
+            "even without caches of disabled repositories",
+            cachedir.native(),
+            total_size,
+            cache_budget);
+    }
+
+    return statistics;
+}
+
 void RepoSack::internalize_repos() {
     auto rq = RepoQuery(base);
     for (auto & repo : rq.get_data()) {
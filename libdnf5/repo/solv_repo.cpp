@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "base/base_impl.hpp"
 #include "repo_cache_private.hpp"
+#include "rpm/transaction.hpp"
 #include "solv/pool.hpp"
 
 #include "libdnf5/base/base.hpp"
@@ -41,6 +42,20 @@ extern "C" {
 #include <solv/solv_xfopen.h>
 }
 
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 
 namespace libdnf5::repo {
 
@@ -50,6 +65,103 @@ namespace fs = libdnf5::utils::fs;
 constexpr auto CHKSUM_TYPE = REPOKEY_TYPE_SHA256;
 constexpr const char * CHKSUM_IDENT = "H000";
 
+// Size of the stream buffer used for reading .solv and .solvx cache files.
+constexpr std::size_t SOLV_CACHE_READ_BUFFER_SIZE = 1024 * 1024;
+
+// Size of the stream buffer used for writing .solv and .solvx cache files.
+constexpr std::size_t SOLV_CACHE_WRITE_BUFFER_SIZE = 1024 * 1024;
+
+// Approximate number of bytes of uncompressed primary metadata per new string in the pool
+// (package names, versions, dependency names and file path components).
+constexpr std::uint64_t PRIMARY_BYTES_PER_NEW_STRING = 256;
+
+// Compressed primary metadata with a larger uncompressed size is decompressed in a separate thread.
+constexpr std::uint64_t PARALLEL_DECOMPRESSION_MIN_OPEN_SIZE = 32 * 1024 * 1024;
+constexpr std::size_t DECOMPRESSION_BUFFER_SIZE = 256 * 1024;
+
+
+// Decompresses a file in a separate thread and passes the data through a socket pair to a reader,
+// so the decompression of large metadata runs in parallel with the parsing by libsolv.
+// A socket pair is used instead of a pipe to avoid SIGPIPE when the reader stops reading early.
+class DecompressingReader {
+public:
+    explicit DecompressingReader(const std::string & path) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+            throw std::filesystem::filesystem_error(
+                "socketpair", path, std::error_code(errno, std::system_category()));
+        }
+        try {
+            reader.open(fds[0], path, "r");
+        } catch (...) {
+            close(fds[0]);
+            close(fds[1]);
+            throw;
+        }
+        writer_thread = std::thread(&DecompressingReader::decompress, this, path, fds[1]);
+    }
+
+    DecompressingReader(const DecompressingReader &) = delete;
+    DecompressingReader & operator=(const DecompressingReader &) = delete;
+
+    ~DecompressingReader() {
+        // closing the reader unblocks the writer thread if the data were not read completely
+        try {
+            reader.close();
+        } catch (...) {
+        }
+        if (writer_thread.joinable()) {
+            writer_thread.join();
+        }
+    }
+
+    FILE * get() const noexcept { return reader.get(); }
+
+    /// Closes the reader, waits for the writer thread and rethrows its exception, if any.
+    /// The reader is closed first, the writer stays blocked in send() when the data were not read completely.
+    void finish() {
+        reader.close();
+        writer_thread.join();
+        if (writer_except_ptr) {
+            std::rethrow_exception(writer_except_ptr);
+        }
+    }
+
+private:
+    void decompress(const std::string & path, int fd) {
+        try {
+            fs::File compressed_file(path, "r", true);
+            std::vector<char> buffer(DECOMPRESSION_BUFFER_SIZE);
+            std::size_t count;
+            while ((count = compressed_file.read(buffer.data(), buffer.size())) > 0) {
+                for (std::size_t written = 0; written < count;) {
+                    auto ret = send(fd, buffer.data() + written, count - written, MSG_NOSIGNAL);
+                    if (ret < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        if (errno == EPIPE || errno == ECONNRESET) {
+                            // the reader stopped reading, it reports its own error
+                            close(fd);
+                            return;
+                        }
+                        throw std::filesystem::filesystem_error(
+                            "send", path, std::error_code(errno, std::system_category()));
+                    }
+                    written += static_cast<std::size_t>(ret);
+                }
+            }
+        } catch (...) {
+            writer_except_ptr = std::current_exception();
+        }
+        close(fd);
+    }
+
+    fs::File reader;
+    std::thread writer_thread;
+    std::exception_ptr writer_except_ptr;
+};
+
 
 static std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> get_padded_solv_toolversion() {
     std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> padded_solv_toolversion{};
@@ -59,7 +171,7 @@ static std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> get_padded_solv_too
     return padded_solv_toolversion;
 }
 
-void SolvRepo::userdata_fill(SolvUserdata * userdata) {
+void SolvRepo::userdata_fill(SolvUserdata * userdata, const unsigned char * cache_checksum) {
     if (strlen(solv_toolversion) > SOLV_USERDATA_SOLV_TOOLVERSION_SIZE) {
         libdnf_throw_assertion(
             "Libsolv's solv_toolvesion is: {} long but we expect max of: {}",
@@ -70,10 +182,11 @@ void SolvRepo::userdata_fill(SolvUserdata * userdata) {
     memcpy(userdata->dnf_magic, SOLV_USERDATA_MAGIC.data(), SOLV_USERDATA_MAGIC.size());
     memcpy(userdata->dnf_version, SOLV_USERDATA_DNF_VERSION.data(), SOLV_USERDATA_DNF_VERSION.size());
     memcpy(userdata->libsolv_version, get_padded_solv_toolversion().data(), SOLV_USERDATA_SOLV_TOOLVERSION_SIZE);
-    memcpy(userdata->checksum, checksum, CHKSUM_BYTES);
+    memcpy(userdata->checksum, cache_checksum, CHKSUM_BYTES);
 }
 
-bool SolvRepo::can_use_solvfile_cache(solv::Pool & pool, fs::File & solvfile_cache) {
+bool SolvRepo::can_use_solvfile_cache(
+    solv::Pool & pool, fs::File & solvfile_cache, const unsigned char * cache_checksum) {
     auto & logger = *base->get_logger();
 
     if (!solvfile_cache) {
@@ -136,11 +249,11 @@ bool SolvRepo::can_use_solvfile_cache(solv::Pool & pool, fs::File & solvfile_cac
     }
 
     // check solvfile checksum
-    if (memcmp(solv_userdata->checksum, checksum, CHKSUM_BYTES) != 0) {
+    if (memcmp(solv_userdata->checksum, cache_checksum, CHKSUM_BYTES) != 0) {
         logger.debug(
-            "Solvfile's repomd checksum doesn't match, read: \"{}\" vs. expected repomd checksum: \"{}\" for: {}",
+            "Solvfile's metadata checksum doesn't match, read: \"{}\" vs. expected metadata checksum: \"{}\" for: {}",
             pool_bin2hex(*pool, solv_userdata->checksum, sizeof solv_userdata->checksum),
-            pool_bin2hex(*pool, checksum, sizeof checksum),
+            pool_bin2hex(*pool, cache_checksum, CHKSUM_BYTES),
             solvfile_cache.get_path().native());
         return false;
     }
@@ -168,6 +281,18 @@ void checksum_calc(unsigned char * out, fs::File & file) {
 }
 
 
+// Computes checksum of the given chunks of data.
+static void checksum_calc(unsigned char * out, std::initializer_list<std::string_view> chunks) {
+    auto h = solv_chksum_create(CHKSUM_TYPE);
+
+    solv_chksum_add(h, CHKSUM_IDENT, strlen(CHKSUM_IDENT));
+    for (const auto & chunk : chunks) {
+        solv_chksum_add(h, chunk.data(), static_cast<int>(chunk.size()));
+    }
+    solv_chksum_free(h, out);
+}
+
+
 static const char * repodata_type_to_name(RepodataType type) {
     switch (type) {
         case RepodataType::FILELISTS:
@@ -234,25 +359,37 @@ SolvRepo::~SolvRepo() {
 }
 
 
-void SolvRepo::load_repo_main(const std::string & repomd_fn, const std::string & primary_fn) {
+void SolvRepo::load_repo_main(
+    const std::string & repomd_fn,
+    const std::string & primary_fn,
+    const std::string & primary_checksum,
+    std::uint64_t primary_open_size) {
     auto & logger = *base->get_logger();
     auto & pool = get_rpm_pool(base);
 
     fs::File repomd_file(repomd_fn, "r");
 
-    checksum_calc(checksum, repomd_file);
+    if (primary_checksum.empty()) {
+        checksum_calc(checksum, repomd_file);
+    } else {
+        checksum_calc(checksum, {primary_checksum});
+    }
 
     int solvables_start = pool->nsolvables;
 
-    if (load_solv_cache(pool, nullptr, 0)) {
+    if (load_solv_cache(pool, nullptr, 0, checksum)) {
         main_solvables_start = solvables_start;
         main_solvables_end = pool->nsolvables;
 
+        // The index may be missing in caches written by older versions.
+        std::error_code ec;
+        if (config.get_build_cache_option().get_value() && !std::filesystem::exists(package_names_file_path(), ec)) {
+            write_package_names();
+        }
+
         return;
     }
 
-    fs::File primary_file(primary_fn, "r", true);
-
     logger.debug("Loading repomd and primary for repo \"{}\"", config.get_id());
     if (repo_add_repomdxml(repo, repomd_file.get(), 0) != 0) {
         throw SolvError(
@@ -262,7 +399,23 @@ void SolvRepo::load_repo_main(const std::string & repomd_fn, const std::string &
             std::string(pool_errstr(*pool)));
     }
 
-    if (repo_add_rpmmd(repo, primary_file.get(), 0, 0) != 0) {
+    if (primary_open_size > 0) {
+        // Grow the string hash once for the estimated number of new strings instead of rehashing it
+        // repeatedly while the primary is parsed. The hash is only grown, never shrunk.
+        auto estimated_new_strings = primary_open_size / PRIMARY_BYTES_PER_NEW_STRING;
+        stringpool_resize_hash(&(*pool)->ss, static_cast<int>(std::min<std::uint64_t>(estimated_new_strings, INT_MAX)));
+    }
+
+    int res;
+    if (primary_open_size >= PARALLEL_DECOMPRESSION_MIN_OPEN_SIZE && !primary_fn.ends_with(".xml")) {
+        DecompressingReader primary_reader(primary_fn);
+        res = repo_add_rpmmd(repo, primary_reader.get(), 0, 0);
+        primary_reader.finish();
+    } else {
+        fs::File primary_file(primary_fn, "r", true);
+        res = repo_add_rpmmd(repo, primary_file.get(), 0, 0);
+    }
+    if (res != 0) {
         throw SolvError(
             M_("Failed to load primary for repo \"{}\" from \"{}\": {}."),
             config.get_id(),
@@ -275,6 +428,7 @@ void SolvRepo::load_repo_main(const std::string & repomd_fn, const std::string &
 
     if (config.get_build_cache_option().get_value()) {
         write_main(true);
+        write_package_names();
     }
 }
 
@@ -285,11 +439,14 @@ void SolvRepo::load_system_repo_ext(RepodataType type) {
         case RepodataType::COMPS: {
             // get installed groups from system state and load respective xml files
             // to the libsolv pool
+            // All the files are read into a single repodata which is internalized once at the end,
+            // instead of creating and internalizing a new repodata for each group.
+            const int flags = REPO_REUSE_REPODATA | REPO_NO_INTERNALIZE;
             auto & system_state = base->p_impl->get_system_state();
             auto comps_dir = system_state.get_group_xml_dir();
             for (auto & group_id : system_state.get_installed_groups()) {
                 auto ext_fn = comps_dir / (group_id + ".xml");
-                if (!read_group_solvable_from_xml(ext_fn)) {
+                if (!read_group_solvable_from_xml(ext_fn, flags)) {
                     // The group xml file either not exists or is not parseable by
                     // libsolv.
                     groups_missing_xml.push_back(std::move(group_id));
@@ -297,12 +454,13 @@ void SolvRepo::load_system_repo_ext(RepodataType type) {
             }
             for (auto & environment_id : system_state.get_installed_environments()) {
                 auto ext_fn = comps_dir / (environment_id + ".xml");
-                if (!read_group_solvable_from_xml(ext_fn)) {
+                if (!read_group_solvable_from_xml(ext_fn, flags)) {
                     // The environment xml file either not exists or is not parseable by
                     // libsolv.
                     environments_missing_xml.push_back(std::move(environment_id));
                 }
             }
+            repo_internalize(comps_repo);
             break;
         }
         case RepodataType::FILELISTS:
@@ -321,25 +479,29 @@ void SolvRepo::load_repo_ext(RepodataType type, const RepoDownloader & downloade
 
     std::string type_name = repodata_type_to_name(type);
 
-    std::string ext_fn;
+    std::string ext_md_type = type_name;
 
-    if (type == RepodataType::COMPS) {
-        ext_fn = downloader.get_metadata_path(RepoDownloader::MD_FILENAME_GROUP_GZ);
-        if (ext_fn.empty()) {
-            ext_fn = downloader.get_metadata_path(type_name);
-        }
-    } else {
-        ext_fn = downloader.get_metadata_path(type_name);
+    if (type == RepodataType::COMPS &&
+        !downloader.get_metadata_path(RepoDownloader::MD_FILENAME_GROUP_GZ).empty()) {
+        ext_md_type = RepoDownloader::MD_FILENAME_GROUP_GZ;
     }
 
-    if (ext_fn.empty()) {
+    std::string ext_fn = downloader.get_metadata_path(ext_md_type);
+    auto & ext_md_checksum = downloader.get_metadata_checksum(ext_md_type);
+
+    // Without the metadata file, the extension can still be loaded from its cache matching the checksum
+    // from repomd. On-demand metadata are not downloaded at all when their cache is valid.
+    if (ext_fn.empty() && ext_md_checksum.empty()) {
         logger.debug("No {} metadata available for repo \"{}\"", type_name, config.get_id());
         return;
     }
 
+    unsigned char ext_checksum[CHKSUM_BYTES];
+    ext_checksum_calc(ext_checksum, ext_md_checksum);
+
     int solvables_start = pool->nsolvables;
 
-    if (load_solv_cache(pool, type_name.c_str(), repodata_type_to_flags(type))) {
+    if (load_solv_cache(pool, type_name.c_str(), repodata_type_to_flags(type), ext_checksum)) {
         if (type == RepodataType::UPDATEINFO) {
             updateinfo_solvables_start = solvables_start;
             updateinfo_solvables_end = pool->nsolvables;
@@ -348,6 +510,11 @@ void SolvRepo::load_repo_ext(RepodataType type, const RepoDownloader & downloade
         return;
     }
 
+    if (ext_fn.empty()) {
+        logger.debug("No {} metadata available for repo \"{}\"", type_name, config.get_id());
+        return;
+    }
+
     fs::File ext_file(ext_fn, "r", true);
     logger.debug("Loading {} extension for repo \"{}\" from \"{}\"", type_name, config.get_id(), ext_fn);
 
@@ -384,11 +551,55 @@ void SolvRepo::load_repo_ext(RepodataType type, const RepoDownloader & downloade
 
     if (config.get_build_cache_option().get_value()) {
         if (type == RepodataType::COMPS) {
-            write_ext(comps_repo->nrepodata - 1, type);
+            write_ext(comps_repo->nrepodata - 1, type, ext_checksum);
         } else {
-            write_ext(repo->nrepodata - 1, type);
+            write_ext(repo->nrepodata - 1, type, ext_checksum);
+        }
+    }
+}
+
+
+void SolvRepo::download_ondemand_repo_ext(RepodataType type, RepoDownloader & downloader) {
+    if (!has_ondemand_repo_ext(type)) {
+        return;
+    }
+
+    std::string type_name = repodata_type_to_name(type);
+    if (!downloader.get_metadata_path(type_name).empty()) {
+        return;
+    }
+
+    // `load_repo_ext()` loads the cache without the metadata file
+    auto & ext_md_checksum = downloader.get_metadata_checksum(type_name);
+    if (!ext_md_checksum.empty()) {
+        unsigned char ext_checksum[CHKSUM_BYTES];
+        ext_checksum_calc(ext_checksum, ext_md_checksum);
+        try {
+            fs::File cache_file(solv_file_path(type_name.c_str()), "r");
+            if (can_use_solvfile_cache(get_rpm_pool(base), cache_file, ext_checksum)) {
+                return;
+            }
+        } catch (const FileSystemError & e) {
+            base->get_logger()->trace("Cache of on-demand {} metadata not available: {}", type_name, e.what());
         }
     }
+
+    base->get_logger()->debug("Downloading on-demand {} metadata for repo \"{}\"", type_name, config.get_id());
+    downloader.download_ondemand_metadata(type_name);
+}
+
+
+bool SolvRepo::load_ondemand_repo_ext(RepodataType type, const RepoDownloader & downloader) {
+    auto node = ondemand_repodata.extract(type);
+    if (node.empty()) {
+        return false;
+    }
+
+    base->get_logger()->debug(
+        "Loading on-demand {} metadata for repo \"{}\"", repodata_type_to_name(type), config.get_id());
+    load_repo_ext(type, downloader);
+    needs_internalizing = true;
+    return true;
 }
 
 
@@ -406,13 +617,44 @@ void SolvRepo::load_system_repo(const std::string & rootdir) {
 
     int solvables_start = pool->nsolvables;
 
-    // TODO(egoode) investigate performance hit of RPM_ADD_WITH_CHANGELOG, possibly make this configurable
-    int flagsrpm = REPO_REUSE_REPODATA | RPM_ADD_WITH_HDRID | REPO_USE_ROOTDIR | RPM_ADD_WITH_CHANGELOG;
-    if (repo_add_rpmdb(repo, nullptr, flagsrpm) != 0) {
-        throw SolvError(
-            M_("Failed to load system repo from root \"{}\": {}"),
-            rootdir.empty() ? "/" : rootdir,
-            std::string(pool_errstr(*get_rpm_pool(base))));
+    // Only the system repo of the installroot is cached. The cache is valid as long as the rpmdb cookie
+    // is unchanged. Extra system repos are always loaded from their rpmdb.
+    std::string rpmdb_cookie;
+    if (rootdir.empty() && config.get_build_cache_option().get_value()) {
+        try {
+            rpmdb_cookie = libdnf5::rpm::Transaction(base).get_db_cookie();
+        } catch (const libdnf5::rpm::TransactionError & e) {
+            logger.debug("Cannot get rpmdb cookie, the system repo cache is not used: {}", e.what());
+        }
+    }
+
+    bool cache_loaded = false;
+    if (!rpmdb_cookie.empty()) {
+        checksum_calc(checksum, {base->get_config().get_installroot_option().get_value(), rpmdb_cookie});
+        cache_loaded = load_solv_cache(pool, nullptr, 0, checksum);
+    }
+
+    if (!cache_loaded) {
+        // TODO(egoode) investigate performance hit of RPM_ADD_WITH_CHANGELOG, possibly make this configurable
+        int flagsrpm = REPO_REUSE_REPODATA | RPM_ADD_WITH_HDRID | REPO_USE_ROOTDIR | RPM_ADD_WITH_CHANGELOG;
+
+        // The outdated cache is used as a reference. libsolv takes the data of packages with unchanged
+        // rpmdb header ids from it instead of reading their headers again.
+        fs::File reference_file;
+        if (!rpmdb_cookie.empty()) {
+            try {
+                reference_file = fs::File(solv_file_path(), "r");
+            } catch (const FileSystemError & e) {
+                logger.trace("Reference system repo cache not available: {}", e.what());
+            }
+        }
+
+        if (repo_add_rpmdb_reffp(repo, reference_file ? reference_file.get() : nullptr, flagsrpm) != 0) {
+            throw SolvError(
+                M_("Failed to load system repo from root \"{}\": {}"),
+                rootdir.empty() ? "/" : rootdir,
+                std::string(pool_errstr(*get_rpm_pool(base))));
+        }
     }
 
     if (!rootdir.empty()) {
@@ -422,8 +664,18 @@ void SolvRepo::load_system_repo(const std::string & rootdir) {
 
     pool_set_installed(*pool, repo);
 
-    main_solvables_start = solvables_start;
-    main_solvables_end = pool->nsolvables;
+    if (rootdir.empty()) {
+        main_solvables_start = solvables_start;
+        main_solvables_end = pool->nsolvables;
+
+        if (!rpmdb_cookie.empty() && !cache_loaded) {
+            write_main(false);
+        }
+    } else {
+        // The repo contains data from several rpmdbs now, it must not be written into the cache
+        main_solvables_start = 0;
+        main_solvables_end = 0;
+    }
 }
 
 
@@ -453,21 +705,24 @@ void SolvRepo::rewrite_repo(libdnf5::solv::IdQueue & fileprovides) {
     auto & logger = *base->get_logger();
     auto & pool = get_rpm_pool(base);
 
-    logger.debug("Rewriting repo \"{}\" with added file provides", config.get_id());
-
     if (!config.get_build_cache_option().get_value() || main_solvables_start == 0 || fileprovides.size() == 0) {
         return;
     }
 
+    // The file provides stored in the cache are used by libsolv to skip searching the file lists of the repo
+    // in the following runs. Only rewrite the cache if some of the file provides are missing there.
     libdnf5::solv::IdQueue fileprovidesq;
-    libdnf5::solv::SolvMap providedids(pool->ss.nstrings);
     Repodata * data = repo_id2repodata(repo, 1);
     if (repodata_lookup_idarray(data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovidesq.get_queue())) {
+        libdnf5::solv::SolvMap providedids(pool->ss.nstrings);
         if (is_superset(fileprovidesq, fileprovides, providedids)) {
+            logger.trace("Cache of repo \"{}\" already contains the added file provides", config.get_id());
             return;
         }
     }
 
+    logger.debug("Rewriting repo \"{}\" with added file provides", config.get_id());
+
     repodata_set_idarray(data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovides.get_queue());
     repodata_internalize(data);
 
@@ -494,15 +749,35 @@ void SolvRepo::set_subpriority(int subpriority) {
 }
 
 
-bool SolvRepo::load_solv_cache(solv::Pool & pool, const char * type_name, int flags) {
+void SolvRepo::ext_checksum_calc(unsigned char * ext_checksum, const std::string & ext_md_checksum) {
+    if (ext_md_checksum.empty()) {
+        memcpy(ext_checksum, checksum, CHKSUM_BYTES);
+    } else {
+        checksum_calc(
+            ext_checksum,
+            {std::string_view(reinterpret_cast<const char *>(checksum), CHKSUM_BYTES), ext_md_checksum});
+    }
+}
+
+
+bool SolvRepo::load_solv_cache(
+    solv::Pool & pool, const char * type_name, int flags, const unsigned char * cache_checksum) {
     auto & logger = *base->get_logger();
 
     auto path = solv_file_path(type_name);
 
     try {
+        // The buffer is used by the FILE stream of cache_file, it must be released after the file is closed.
+        std::unique_ptr<char[]> read_buffer;
         fs::File cache_file(path, "r");
 
-        if (can_use_solvfile_cache(pool, cache_file)) {
+        // libsolv reads the cache through a lot of small stdio reads. Use a large stream buffer to avoid
+        // a read() syscall for each default-sized block and hint the kernel to read ahead.
+        read_buffer.reset(new char[SOLV_CACHE_READ_BUFFER_SIZE]);
+        setvbuf(cache_file.get(), read_buffer.get(), _IOFBF, SOLV_CACHE_READ_BUFFER_SIZE);
+        posix_fadvise(cache_file.get_fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        if (can_use_solvfile_cache(pool, cache_file, cache_checksum)) {
             logger.debug("Loading solv cache file: \"{}\"", path.native());
             if (repo_add_solv(
                     type_name && std::string_view(type_name) == RepoDownloader::MD_FILENAME_GROUP ? comps_repo : repo,
@@ -541,8 +816,13 @@ void SolvRepo::write_main(bool load_after_write) {
 
     std::filesystem::create_directory(solvfile_parent_dir);
 
+    // The buffer is used by the FILE stream of cache_file, it must be released after the file is closed.
+    std::unique_ptr<char[]> write_buffer(new char[SOLV_CACHE_WRITE_BUFFER_SIZE]);
     auto cache_tmp_file = fs::TempFile(solvfile_parent_dir, solvfile_path.filename());
     auto & cache_file = cache_tmp_file.open_as_file("w+");
+    // libsolv writes the cache through a lot of small stdio writes, avoid a write() syscall for each
+    // default-sized block.
+    setvbuf(cache_file.get(), write_buffer.get(), _IOFBF, SOLV_CACHE_WRITE_BUFFER_SIZE);
 
     logger.trace(
         "Writing primary cache for repo \"{}\" to \"{}\" (checksum: 0x{})",
@@ -551,7 +831,7 @@ void SolvRepo::write_main(bool load_after_write) {
         chksum);
 
     SolvUserdata solv_userdata{};
-    userdata_fill(&solv_userdata);
+    userdata_fill(&solv_userdata, checksum);
 
     Repowriter * writer = repowriter_create(repo);
     repowriter_set_userdata(writer, &solv_userdata, SOLV_USERDATA_SIZE);
@@ -594,7 +874,7 @@ void SolvRepo::write_main(bool load_after_write) {
 }
 
 
-void SolvRepo::write_ext(Id repodata_id, RepodataType type) {
+void SolvRepo::write_ext(Id repodata_id, RepodataType type, const unsigned char * cache_checksum) {
     libdnf_assert(repodata_id != 0, "0 is not a valid repodata id");
 
     auto & logger = *base->get_logger();
@@ -607,8 +887,13 @@ void SolvRepo::write_ext(Id repodata_id, RepodataType type) {
 
     std::filesystem::create_directory(solvfile_parent_dir);
 
+    // The buffer is used by the FILE stream of cache_file, it must be released after the file is closed.
+    std::unique_ptr<char[]> write_buffer(new char[SOLV_CACHE_WRITE_BUFFER_SIZE]);
     auto cache_tmp_file = fs::TempFile(solvfile_parent_dir, solvfile_path.filename());
     auto & cache_file = cache_tmp_file.open_as_file("w+");
+    // libsolv writes the cache through a lot of small stdio writes, avoid a write() syscall for each
+    // default-sized block.
+    setvbuf(cache_file.get(), write_buffer.get(), _IOFBF, SOLV_CACHE_WRITE_BUFFER_SIZE);
 
     logger.trace(
         "Writing {} extension cache for repo \"{}\" to \"{}\"",
@@ -618,7 +903,7 @@ void SolvRepo::write_ext(Id repodata_id, RepodataType type) {
 
 
     SolvUserdata solv_userdata{};
-    userdata_fill(&solv_userdata);
+    userdata_fill(&solv_userdata, cache_checksum);
 
     Repowriter * writer;
     if (type == RepodataType::COMPS) {
@@ -694,7 +979,65 @@ std::filesystem::path SolvRepo::solv_file_path(const char * type) {
     return std::filesystem::path(config.get_cachedir()) / CACHE_SOLV_FILES_DIR / solv_file_name(type);
 }
 
-bool SolvRepo::read_group_solvable_from_xml(const std::string & path) {
+
+void SolvRepo::write_package_names() {
+    auto & logger = *base->get_logger();
+    auto & pool = get_rpm_pool(base);
+
+    std::vector<std::string_view> names;
+    names.reserve(static_cast<std::size_t>(main_solvables_end - main_solvables_start));
+    for (Id id = main_solvables_start; id < main_solvables_end; ++id) {
+        auto * solvable = pool.id2solvable(id);
+        if (solvable->repo == repo) {
+            names.emplace_back(pool.id2str(solvable->name));
+        }
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    const auto names_file_path = package_names_file_path();
+    try {
+        const auto names_file_parent_dir = names_file_path.parent_path();
+        std::filesystem::create_directory(names_file_parent_dir);
+
+        auto names_tmp_file = fs::TempFile(names_file_parent_dir, names_file_path.filename());
+        auto & names_file = names_tmp_file.open_as_file("w");
+
+        logger.trace(
+            "Writing package names index for repo \"{}\" to \"{}\"",
+            config.get_id(),
+            names_tmp_file.get_path().native());
+
+        std::string content;
+        for (const auto name : names) {
+            content.append(name);
+            content.push_back('\n');
+        }
+        names_file.write(content);
+        names_tmp_file.close();
+
+        std::filesystem::permissions(
+            names_tmp_file.get_path(),
+            std::filesystem::perms::group_read | std::filesystem::perms::others_read,
+            std::filesystem::perm_options::add);
+        std::filesystem::rename(names_tmp_file.get_path(), names_file_path);
+        names_tmp_file.release();
+    } catch (const std::exception & ex) {
+        logger.warning(
+            "Cannot write package names index for repo \"{}\" to \"{}\": {}",
+            config.get_id(),
+            names_file_path.native(),
+            ex.what());
+    }
+}
+
+
+std::filesystem::path SolvRepo::package_names_file_path() {
+    return std::filesystem::path(config.get_cachedir()) / CACHE_SOLV_FILES_DIR /
+           (config.get_id() + CACHE_PACKAGE_NAMES_FILE_EXTENSION);
+}
+
+bool SolvRepo::read_group_solvable_from_xml(const std::string & path, int flags) {
     auto & logger = *base->get_logger();
     bool read_success = true;
 
@@ -708,7 +1051,7 @@ bool SolvRepo::read_group_solvable_from_xml(const std::string & path) {
 
     if (read_success) {
         logger.debug("Loading group extension for system repo from \"{}\"", path);
-        read_success = repo_add_comps(comps_repo, ext_file.get(), 0) == 0;
+        read_success = repo_add_comps(comps_repo, ext_file.get(), flags) == 0;
         if (!read_success) {
             logger.debug("Loading group extension for system repo from \"{}\" failed.", path);
         }
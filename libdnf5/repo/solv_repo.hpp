@@ -31,7 +31,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <solv/repo.h>
 
+#include <cstdint>
 #include <filesystem>
+#include <set>
 
 
 static const constexpr size_t CHKSUM_BYTES = 32;
@@ -69,11 +71,37 @@ public:
     ~SolvRepo();
 
     /// Loads main metadata (solvables) from available repo.
-    void load_repo_main(const std::string & repomd_fn, const std::string & primary_fn);
+    /// @param primary_checksum  Checksum of the primary metadata file recorded in repomd. If not empty, it is used
+    ///                          as the validity key of the cache files instead of the checksum of the repomd file,
+    ///                          so that the caches survive repomd changes that don't modify primary.
+    /// @param primary_open_size  Uncompressed size of the primary metadata file recorded in repomd, or 0 if unknown.
+    ///                           Used to size the pool string hash before the primary is parsed.
+    void load_repo_main(
+        const std::string & repomd_fn,
+        const std::string & primary_fn,
+        const std::string & primary_checksum = {},
+        std::uint64_t primary_open_size = 0);
 
     /// Loads additional metadata (filelist, others, ...) from available repo.
+    /// The .solvx cache file is valid as long as both the primary and the additional metadata are unchanged.
     void load_repo_ext(RepodataType type, const RepoDownloader & downloader);
 
+    /// Registers additional metadata which are not loaded now, but later by `load_ondemand_repo_ext()`.
+    void add_ondemand_repo_ext(RepodataType type) { ondemand_repodata.insert(type); }
+
+    /// @return `true` if the additional metadata of the `type` were registered for on-demand loading
+    ///         and not loaded yet.
+    bool has_ondemand_repo_ext(RepodataType type) const { return ondemand_repodata.contains(type); }
+
+    /// Downloads the additional metadata registered by `add_ondemand_repo_ext()` if they were not downloaded
+    /// together with the repository metadata. Does nothing if they are not registered, already downloaded
+    /// or their .solvx cache is valid.
+    void download_ondemand_repo_ext(RepodataType type, RepoDownloader & downloader);
+
+    /// Loads additional metadata registered by `add_ondemand_repo_ext()`. Does nothing if they are already loaded.
+    /// @return `true` if the metadata were loaded by this call.
+    bool load_ondemand_repo_ext(RepodataType type, const RepoDownloader & downloader);
+
     /// Loads system repository into the pool.
     ///
     /// @param rootdir If empty, loads the installroot rpmdb, if not loads rpmdb from this root path
@@ -91,8 +119,8 @@ public:
     void set_priority(int priority);
     void set_subpriority(int subpriority);
 
-    // Checksum of data in .solv file. Used for validity check of .solvx files.
-    unsigned char checksum[CHKSUM_BYTES];
+    // Checksum of data in .solv file. Used for validity check of .solv and .solvx files.
+    unsigned char checksum[CHKSUM_BYTES]{};
 
     void set_needs_internalizing() { needs_internalizing = true; };
 
@@ -117,22 +145,33 @@ public:
 
     /// Read comps group solvable from its xml file.
     /// @param path  Path to xml file.
+    /// @param flags Flags passed to libsolv's repo_add_comps().
     /// @return      True if the group was successfully read.
-    bool read_group_solvable_from_xml(const std::string & path);
+    bool read_group_solvable_from_xml(const std::string & path, int flags = 0);
 
 private:
     // "type_name == nullptr" means load "primary" cache (.solv file)
-    bool load_solv_cache(solv::Pool & pool, const char * type_name, int flags);
+    bool load_solv_cache(solv::Pool & pool, const char * type_name, int flags, const unsigned char * cache_checksum);
+
+    /// Computes the checksum of a .solvx cache file. The extension cache depends on the solvables of the main
+    /// cache and on the content of the extension metadata (`ext_md_checksum` from repomd, can be empty).
+    void ext_checksum_calc(unsigned char * ext_checksum, const std::string & ext_md_checksum);
 
     /// Writes libsolv's .solv cache file with main libsolv repodata.
     void write_main(bool load_after_write);
 
     /// Writes libsolv's .solvx cache file with extended libsolv repodata.
-    void write_ext(Id repodata_id, RepodataType type);
+    void write_ext(Id repodata_id, RepodataType type, const unsigned char * cache_checksum);
 
     std::string solv_file_name(const char * type = nullptr);
     std::filesystem::path solv_file_path(const char * type = nullptr);
 
+    /// Writes the sorted names of the packages from the primary metadata to the package names index next to
+    /// the solv cache. The index allows listing package names without loading the repository
+    /// (see `Repo::read_cached_package_names()`). Errors are only logged, the index is optional.
+    void write_package_names();
+    std::filesystem::path package_names_file_path();
+
     libdnf5::BaseWeakPtr base;
     const ConfigRepo & config;
 
@@ -144,8 +183,12 @@ private:
     int updateinfo_solvables_start{0};
     int updateinfo_solvables_end{0};
 
-    bool can_use_solvfile_cache(solv::Pool & pool, utils::fs::File & solvfile_cache);
-    void userdata_fill(SolvUserdata * userdata);
+    bool can_use_solvfile_cache(
+        solv::Pool & pool, utils::fs::File & solvfile_cache, const unsigned char * cache_checksum);
+    void userdata_fill(SolvUserdata * userdata, const unsigned char * cache_checksum);
+
+    /// Additional metadata types waiting for on-demand loading
+    std::set<RepodataType> ondemand_repodata;
 
     /// List of system repo groups without valid file with xml definition
     std::vector<std::string> groups_missing_xml;
@@ -73,8 +73,8 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
             throw NevraIncorrectInputError(M_("Invalid character '{}' in NEVRA string \"{}\""), *end, nevra_str);
         }
     }
+    // All delimiters of a form are validated first, the strings are only created for the accepted forms
     for (auto form : forms) {
-        Nevra nevra;
         switch (form) {
             case Form::NEVRA: {
                 if (before_last_delim == nullptr || last_delim == nullptr || arch_delim == nullptr) {
@@ -86,44 +86,43 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
                     continue;
                 }
 
-                const char * evr_delim_for_nevra = before_last_delim;
-                const char * release_delim_for_nevra = last_delim;
-                const char * arch_delim_for_nevra = arch_delim;
-
-                nevra.name.assign(nevra_pattern, evr_delim_for_nevra);
-                ++evr_delim_for_nevra;
+                const char * epoch_begin = before_last_delim + 1;
+                const char * version_begin = epoch_begin;
 
                 // test presence of epoch (optional)
                 if (epoch_delim != nullptr) {
                     // test that ':' was in range of evr. ':' sign is only allowed in evr as an epoch deliminator
-                    if (epoch_delim - evr_delim_for_nevra < 1 || release_delim_for_nevra - epoch_delim < 2) {
+                    if (epoch_delim - epoch_begin < 1 || last_delim - epoch_delim < 2) {
                         continue;
                     }
-                    nevra.epoch.assign(evr_delim_for_nevra, epoch_delim);
-                    evr_delim_for_nevra = epoch_delim + 1;
+                    version_begin = epoch_delim + 1;
                 }
 
                 // test presence of version
-                if (release_delim_for_nevra - evr_delim_for_nevra < 1) {
+                if (last_delim - version_begin < 1) {
                     continue;
                 }
-                nevra.version.assign(evr_delim_for_nevra, release_delim_for_nevra);
-                ++release_delim_for_nevra;
 
                 // test presence of release
-                if (arch_delim_for_nevra - release_delim_for_nevra < 1) {
+                const char * release_begin = last_delim + 1;
+                if (arch_delim - release_begin < 1) {
                     continue;
                 }
-                nevra.release.assign(release_delim_for_nevra, arch_delim_for_nevra);
-                ++arch_delim_for_nevra;
 
                 // test presence of arch
-                if (end - arch_delim_for_nevra < 1) {
+                const char * arch_begin = arch_delim + 1;
+                if (end - arch_begin < 1) {
                     continue;
                 }
-                nevra.arch.assign(arch_delim_for_nevra);
 
-                result.push_back(std::move(nevra));
+                auto & nevra = result.emplace_back();
+                nevra.name.assign(nevra_pattern, before_last_delim);
+                if (epoch_delim != nullptr) {
+                    nevra.epoch.assign(epoch_begin, epoch_delim);
+                }
+                nevra.version.assign(version_begin, last_delim);
+                nevra.release.assign(release_begin, arch_delim);
+                nevra.arch.assign(arch_begin, end);
             } break;
             case Form::NEVR: {
                 if (before_last_delim == nullptr || last_delim == nullptr) {
@@ -135,36 +134,36 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
                     continue;
                 }
 
-                const char * evr_delim_for_nevr = before_last_delim;
-                const char * release_delim_for_nevr = last_delim;
-
-                nevra.name.assign(nevra_pattern, evr_delim_for_nevr);
-                ++evr_delim_for_nevr;
+                const char * epoch_begin = before_last_delim + 1;
+                const char * version_begin = epoch_begin;
 
                 // test presence of epoch (optional)
                 if (epoch_delim != nullptr) {
                     // test that ':' was in range of evr. ':' sign is only allowed in evr as an epoch deliminator
-                    if (epoch_delim - evr_delim_for_nevr < 1 || release_delim_for_nevr - epoch_delim < 2) {
+                    if (epoch_delim - epoch_begin < 1 || last_delim - epoch_delim < 2) {
                         continue;
                     }
-                    nevra.epoch.assign(evr_delim_for_nevr, epoch_delim);
-                    evr_delim_for_nevr = epoch_delim + 1;
+                    version_begin = epoch_delim + 1;
                 }
 
                 // test presence of version
-                if (release_delim_for_nevr - evr_delim_for_nevr < 1) {
+                if (last_delim - version_begin < 1) {
                     continue;
                 }
-                nevra.version.assign(evr_delim_for_nevr, release_delim_for_nevr);
-                ++release_delim_for_nevr;
 
                 // test presence of release
-                if (end - release_delim_for_nevr < 1) {
+                const char * release_begin = last_delim + 1;
+                if (end - release_begin < 1) {
                     continue;
                 }
-                nevra.release.assign(release_delim_for_nevr);
 
-                result.push_back(std::move(nevra));
+                auto & nevra = result.emplace_back();
+                nevra.name.assign(nevra_pattern, before_last_delim);
+                if (epoch_delim != nullptr) {
+                    nevra.epoch.assign(epoch_begin, epoch_delim);
+                }
+                nevra.version.assign(version_begin, last_delim);
+                nevra.release.assign(release_begin, end);
             } break;
             case Form::NEV: {
                 if (last_delim == nullptr) {
@@ -176,28 +175,29 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
                     continue;
                 }
 
-                const char * evr_delim_for_nev = last_delim;
-
-                nevra.name.assign(nevra_pattern, evr_delim_for_nev);
-                ++evr_delim_for_nev;
+                const char * epoch_begin = last_delim + 1;
+                const char * version_begin = epoch_begin;
 
                 // test presence of epoch (optional)
                 if (epoch_delim != nullptr) {
                     // test that ':' was in range of evr. ':' sign is only allowed in evr as an epoch deliminator
-                    if (epoch_delim - evr_delim_for_nev < 1 || end - epoch_delim < 2) {
+                    if (epoch_delim - epoch_begin < 1 || end - epoch_delim < 2) {
                         continue;
                     }
-                    nevra.epoch.assign(evr_delim_for_nev, epoch_delim);
-                    evr_delim_for_nev = epoch_delim + 1;
+                    version_begin = epoch_delim + 1;
                 }
 
                 // test presence of version
-                if (end - evr_delim_for_nev < 1) {
+                if (end - version_begin < 1) {
                     continue;
                 }
-                nevra.version.assign(evr_delim_for_nev);
 
-                result.push_back(std::move(nevra));
+                auto & nevra = result.emplace_back();
+                nevra.name.assign(nevra_pattern, last_delim);
+                if (epoch_delim != nullptr) {
+                    nevra.epoch.assign(epoch_begin, epoch_delim);
+                }
+                nevra.version.assign(version_begin, end);
             } break;
             case Form::NA: {
                 if (arch_delim == nullptr) {
@@ -223,12 +223,11 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
                     continue;
                 }
 
+                auto & nevra = result.emplace_back();
                 nevra.name.assign(nevra_pattern, arch_delim);
-                nevra.arch.assign(arch_delim + 1);
-
-                result.push_back(std::move(nevra));
+                nevra.arch.assign(arch_delim + 1, end);
             } break;
-            case Form::NAME:
+            case Form::NAME: {
                 // test: Name cannot contain ':'
                 if (epoch_delim != nullptr) {
                     continue;
@@ -239,10 +238,9 @@ std::vector<Nevra> Nevra::parse(const std::string & nevra_str, const std::vector
                     continue;
                 }
 
-                nevra.name.assign(nevra_pattern);
-
-                result.push_back(std::move(nevra));
-                break;
+                auto & nevra = result.emplace_back();
+                nevra.name.assign(nevra_pattern, end);
+            } break;
         }
     }
     return result;
@@ -23,12 +23,12 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "base/base_impl.hpp"
 #include "package_sack_impl.hpp"
 #include "reldep_list_impl.hpp"
+#include "repo/solv_repo.hpp"
 #include "solv/pool.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/string.hpp"
 
 #include "libdnf5/common/exception.hpp"
-#include "libdnf5/rpm/package_query.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
 #include <fcntl.h>
@@ -36,7 +36,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <librepo/util.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 
 
 static inline void reldeps_for(Solvable * solvable, libdnf5::solv::IdQueue & queue, Id type) {
@@ -81,6 +83,18 @@ std::string Package::get_evr() const {
     return libdnf5::utils::string::c_to_str(get_rpm_pool(base).get_evr(id.id));
 }
 
+std::string_view Package::get_name_view() const {
+    return get_rpm_pool(base).get_name(id.id);
+}
+
+std::string_view Package::get_arch_view() const {
+    return get_rpm_pool(base).get_arch(id.id);
+}
+
+std::string_view Package::get_evr_view() const {
+    return get_rpm_pool(base).get_evr(id.id);
+}
+
 std::string Package::get_nevra() const {
     return libdnf5::utils::string::c_to_str(get_rpm_pool(base).get_nevra(id.id));
 }
@@ -90,9 +104,13 @@ std::string Package::get_full_nevra() const {
 }
 
 std::string Package::get_na() const {
-    std::string res = get_name();
+    auto name = get_name_view();
+    auto arch = get_arch_view();
+    std::string res;
+    res.reserve(name.size() + 1 + arch.size());
+    res.append(name);
     res.append(".");
-    res.append(get_arch());
+    res.append(arch);
     return res;
 }
 
@@ -130,11 +148,11 @@ std::string Package::get_debuginfo_name_of_source() const {
 }
 
 std::string Package::get_debuginfo_name() const {
-    if (libdnf5::utils::string::ends_with(get_name(), DEBUGINFO_SUFFIX)) {
-        return get_name();
+    std::string name(get_name_view());
+    if (libdnf5::utils::string::ends_with(name, DEBUGINFO_SUFFIX)) {
+        return name;
     }
 
-    auto name = get_name();
     if (libdnf5::utils::string::ends_with(name, DEBUGSOURCE_SUFFIX)) {
         name.resize(name.size() - strlen(DEBUGSOURCE_SUFFIX));
     }
@@ -174,7 +192,9 @@ std::vector<std::string> Package::get_files() const {
     auto & pool = get_rpm_pool(base);
 
     Solvable * solvable = pool.id2solvable(id.id);
-    libdnf5::solv::get_repo(solvable).internalize();
+    auto & repo = libdnf5::solv::get_repo(solvable);
+    base->get_rpm_package_sack()->p_impl->load_ondemand_repodata(repo, repo::RepodataType::FILELISTS);
+    repo.internalize();
 
     std::vector<std::string> ret;
 
@@ -193,7 +213,9 @@ std::vector<libdnf5::rpm::Changelog> Package::get_changelogs() const {
     std::vector<libdnf5::rpm::Changelog> changelogs;
     auto & pool = get_rpm_pool(base);
     Solvable * solvable = pool.id2solvable(id.id);
-    libdnf5::solv::get_repo(solvable).internalize();
+    auto & repo = libdnf5::solv::get_repo(solvable);
+    base->get_rpm_package_sack()->p_impl->load_ondemand_repodata(repo, repo::RepodataType::OTHER);
+    repo.internalize();
 
     Dataiterator di;
     dataiterator_init(&di, *pool, solvable->repo, id.id, SOLVABLE_CHANGELOG, nullptr, 0);
@@ -209,6 +231,68 @@ std::vector<libdnf5::rpm::Changelog> Package::get_changelogs() const {
     return changelogs;
 }
 
+std::vector<libdnf5::rpm::Changelog> Package::get_changelogs_since(time_t since, std::size_t limit) const {
+    std::vector<libdnf5::rpm::Changelog> changelogs;
+    auto & pool = get_rpm_pool(base);
+    Solvable * solvable = pool.id2solvable(id.id);
+    auto & repo = libdnf5::solv::get_repo(solvable);
+    base->get_rpm_package_sack()->p_impl->load_ondemand_repodata(repo, repo::RepodataType::OTHER);
+    repo.internalize();
+
+    // The first pass reads only the timestamps to find the entries to return. The author and text
+    // strings are copied in the second pass only for them.
+    std::vector<time_t> timestamps;
+    Dataiterator di;
+    dataiterator_init(&di, *pool, solvable->repo, id.id, SOLVABLE_CHANGELOG, nullptr, 0);
+    while (dataiterator_step(&di)) {
+        dataiterator_setpos(&di);
+        timestamps.push_back(static_cast<time_t>(pool_lookup_num(*pool, SOLVID_POS, SOLVABLE_CHANGELOG_TIME, 0)));
+    }
+    dataiterator_free(&di);
+
+    // Entries older than the cutoff are skipped. With a limit, the cutoff is the timestamp of the limit-th
+    // newest entry; the entries sharing this timestamp count against the limit in repodata order.
+    time_t cutoff = since;
+    std::size_t cutoff_slots = timestamps.size();
+    if (limit > 0 && limit < timestamps.size()) {
+        std::vector<time_t> sorted(timestamps);
+        auto limit_it = sorted.begin() + static_cast<std::ptrdiff_t>(limit - 1);
+        std::nth_element(sorted.begin(), limit_it, sorted.end(), std::greater<>());
+        if (*limit_it >= cutoff) {
+            cutoff = *limit_it;
+            auto newer = std::count_if(timestamps.begin(), timestamps.end(), [cutoff](time_t t) { return t > cutoff; });
+            cutoff_slots = limit - static_cast<std::size_t>(newer);
+        }
+    }
+
+    std::size_t idx = 0;
+    dataiterator_init(&di, *pool, solvable->repo, id.id, SOLVABLE_CHANGELOG, nullptr, 0);
+    while (dataiterator_step(&di)) {
+        const auto timestamp = timestamps[idx++];
+        if (timestamp < cutoff) {
+            continue;
+        }
+        if (timestamp == cutoff) {
+            if (cutoff_slots == 0) {
+                continue;
+            }
+            --cutoff_slots;
+        }
+        dataiterator_setpos(&di);
+        std::string author = pool_lookup_str(*pool, SOLVID_POS, SOLVABLE_CHANGELOG_AUTHOR);
+        std::string text = pool_lookup_str(*pool, SOLVID_POS, SOLVABLE_CHANGELOG_TEXT);
+        changelogs.emplace_back(timestamp, std::move(author), std::move(text));
+    }
+    dataiterator_free(&di);
+
+    std::stable_sort(
+        changelogs.begin(),
+        changelogs.end(),
+        [](const libdnf5::rpm::Changelog & a, const libdnf5::rpm::Changelog & b) { return a.timestamp > b.timestamp; });
+
+    return changelogs;
+}
+
 ReldepList Package::get_provides() const {
     ReldepList list(base);
     reldeps_for(get_rpm_pool(base).id2solvable(id.id), list.p_impl->queue, SOLVABLE_PROVIDES);
@@ -387,11 +471,14 @@ bool Package::is_cached() const {
         if (length == get_download_size()) {
             lseek(fd, 0, SEEK_SET);
             auto checksum = get_checksum();
+            // With caching enabled, librepo stores the checksum in an extended attribute of the file
+            // together with its mtime and reuses it until the file changes (including the value
+            // stored by librepo when the package was downloaded).
             lr_checksum_fd_cmp(
                 static_cast<LrChecksumType>(checksum.get_type()),
                 fd,
                 checksum.get_checksum().c_str(),
-                FALSE,
+                TRUE,
                 &cached,
                 NULL);
         }
@@ -450,15 +537,23 @@ std::string Package::get_from_repo_id() const {
 
 
 libdnf5::transaction::TransactionItemReason Package::get_reason() const {
-    // TODO(lukash) this query is a temporary solution.
-    // The logic should be moved to the system::State, where a cache of
-    // installed NAs needs to be created (perhaps still as a query), as it is
-    // needed for transaction reason resolution anyway
-    rpm::PackageQuery installed_query(base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-    installed_query.filter_installed();
-    installed_query.filter_name({get_name()});
-    installed_query.filter_arch({get_arch()});
-    if (!installed_query.empty()) {
+    // The reason is stored for the installed NA. An installed package is its own installed NA, other packages are
+    // matched against the installed ones by the name and arch ids. Building a query over the whole sack
+    // for every call made the bulk callers (filter_userinstalled, Goal::resolve) quadratic.
+    auto & pool = get_rpm_pool(base);
+    bool na_installed = pool.is_installed(id.id);
+    if (!na_installed && pool->installed) {
+        Solvable * solvable = pool.id2solvable(id.id);
+        Id installed_id;
+        Solvable * installed_solvable;
+        FOR_REPO_SOLVABLES(pool->installed, installed_id, installed_solvable) {
+            if (installed_solvable->name == solvable->name && installed_solvable->arch == solvable->arch) {
+                na_installed = true;
+                break;
+            }
+        }
+    }
+    if (na_installed) {
         auto reason = base->p_impl->get_system_state().get_package_reason(get_na());
 
         if (reason == libdnf5::transaction::TransactionItemReason::NONE) {
@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "common/sack/query_cmp_private.hpp"
 #include "package_query_impl.hpp"
 #include "package_set_impl.hpp"
+#include "repo/solv_repo.hpp"
 #include "solv/solver.hpp"
 #include "utils/convert.hpp"
 
@@ -39,7 +40,12 @@ extern "C" {
 
 #include <fnmatch.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <limits>
+#include <optional>
+#include <set>
+#include <span>
 
 namespace libdnf5::rpm {
 
@@ -227,76 +233,106 @@ static inline bool name_arch_compare_lower(const Solvable * first, const T * sec
     return first->arch < second->arch;
 }
 
+/// Directed graph in the compressed sparse row format. The edges of the node `u` are stored in
+/// `edges[offsets[u]]` ... `edges[offsets[u + 1] - 1]`.
+struct DependencyGraph {
+    std::vector<unsigned int> offsets{0};
+    std::vector<unsigned int> edges;
+
+    unsigned int size() const { return static_cast<unsigned int>(offsets.size() - 1); }
+
+    std::span<const unsigned int> get_edges(unsigned int u) const {
+        return {edges.data() + offsets[u], edges.data() + offsets[u + 1]};
+    }
+};
+
+constexpr unsigned int NO_NODE = std::numeric_limits<unsigned int>::max();
+
 void add_edges(
-    Base & base,
-    std::set<unsigned int> & edges,
-    const PackageQuery & full_query,
-    const std::map<PackageId, unsigned int> & pkg_id2idx,
+    Pool * pool,
+    std::vector<unsigned int> & edges,
+    const std::vector<unsigned int> & solvable2node,
     const ReldepList & deps) {
     // resolve dependencies and add an edge if there is exactly one package satisfying it
     for (int i = 0; i < deps.size(); ++i) {
-        ReldepList req_in_list(base);
-        req_in_list.add(deps.get_id(i));
-        PackageQuery query(full_query);
-        query.filter_provides(req_in_list);
-        if (query.size() == 1) {
-            auto pkg = *query.begin();
-            edges.insert(pkg_id2idx.at(pkg.get_id()));
+        unsigned int provider = NO_NODE;
+        unsigned int providers_count = 0;
+        Id p;
+        Id pp;
+        FOR_PROVIDES(p, pp, deps.get_id(i).id) {
+            auto node = solvable2node[static_cast<unsigned int>(p)];
+            if (node != NO_NODE) {
+                provider = node;
+                if (++providers_count > 1) {
+                    break;
+                }
+            }
+        }
+        if (providers_count == 1) {
+            edges.push_back(provider);
         }
     }
 }
 
-std::vector<std::vector<unsigned int>> build_graph(
-    Base & base, const PackageQuery & full_query, const std::vector<Package> & pkgs, bool use_recommends) {
-    // create pkg_id2idx to map Packages to their index in pkgs
-    std::map<PackageId, unsigned int> pkg_id2idx;
-    for (size_t i = 0; i < pkgs.size(); ++i) {
-        pkg_id2idx.emplace(pkgs[i].get_id(), i);
+DependencyGraph build_graph(Pool * pool, const std::vector<Package> & pkgs, bool use_recommends) {
+    // map solvable ids to the index of the package in pkgs
+    std::vector<unsigned int> solvable2node(static_cast<unsigned int>(pool->nsolvables), NO_NODE);
+    for (unsigned int i = 0; i < pkgs.size(); ++i) {
+        solvable2node[static_cast<unsigned int>(pkgs[i].get_id().id)] = i;
     }
 
-    std::vector<std::vector<unsigned int>> graph;
-    graph.reserve(pkgs.size());
+    DependencyGraph graph;
+    graph.offsets.reserve(pkgs.size() + 1);
 
     for (unsigned int i = 0; i < pkgs.size(); ++i) {
-        std::set<unsigned int> edges;
         const auto & package = pkgs[i];
-        add_edges(base, edges, full_query, pkg_id2idx, package.get_requires());
+        auto first = graph.edges.size();
+        add_edges(pool, graph.edges, solvable2node, package.get_requires());
         if (use_recommends) {
-            add_edges(base, edges, full_query, pkg_id2idx, package.get_recommends());
+            add_edges(pool, graph.edges, solvable2node, package.get_recommends());
         }
-        edges.erase(i);  // remove self-edges
-        graph.emplace_back(edges.begin(), edges.end());
+
+        // remove duplicate edges and self-edges
+        auto begin = graph.edges.begin() + static_cast<std::ptrdiff_t>(first);
+        std::sort(begin, graph.edges.end());
+        graph.edges.erase(std::unique(begin, graph.edges.end()), graph.edges.end());
+        auto self = std::lower_bound(begin, graph.edges.end(), i);
+        if (self != graph.edges.end() && *self == i) {
+            graph.edges.erase(self);
+        }
+        graph.offsets.push_back(static_cast<unsigned int>(graph.edges.size()));
     }
 
     return graph;
 }
 
-std::vector<std::vector<unsigned int>> reverse_graph(const std::vector<std::vector<unsigned int>> & graph) {
-    std::vector<std::vector<unsigned int>> rgraph(graph.size());
+DependencyGraph reverse_graph(const DependencyGraph & graph) {
+    const auto N = graph.size();
+    DependencyGraph rgraph;
 
-    // pre-allocate (reserve) memory to prevent reallocations
-    std::vector<unsigned int> lengths(graph.size(), 0);
-    for (const auto & edges : graph) {
-        for (auto edge : edges) {
-            ++lengths[edge];
-        }
+    // count the incoming edges of each node, the offsets are their prefix sums
+    rgraph.offsets.assign(N + 1, 0);
+    for (auto edge : graph.edges) {
+        ++rgraph.offsets[edge + 1];
     }
-    for (unsigned int i = 0; i < graph.size(); ++i) {
-        rgraph[i].reserve(lengths[i]);
+    for (unsigned int i = 0; i < N; ++i) {
+        rgraph.offsets[i + 1] += rgraph.offsets[i];
     }
 
     // reverse graph
-    for (unsigned int i = 0; i < graph.size(); ++i) {
-        for (auto edge : graph[i]) {
-            rgraph[edge].push_back(i);
+    rgraph.edges.resize(graph.edges.size());
+    std::vector<unsigned int> positions(rgraph.offsets.begin(), rgraph.offsets.end() - 1);
+    for (unsigned int i = 0; i < N; ++i) {
+        for (auto edge : graph.get_edges(i)) {
+            rgraph.edges[positions[edge]++] = i;
         }
     }
 
     return rgraph;
 }
 
-std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<unsigned int>> & graph) {
-    const auto N = static_cast<unsigned int>(graph.size());
+std::vector<std::vector<unsigned int>> kosaraju(const DependencyGraph & graph) {
+    const auto N = graph.size();
     std::vector<unsigned int> rstack(N);
     std::vector<unsigned int> stack(N);
     std::vector<bool> tag(N, false);
@@ -315,7 +351,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
         unsigned int j = 0;
         tag[u] = true;
         while (true) {
-            const auto & edges = graph[u];
+            const auto edges = graph.get_edges(u);
             if (j < edges.size()) {
                 const auto v = edges[j++];
                 if (!tag[v]) {
@@ -350,7 +386,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
     // if there are no such incoming edges the component is a leaf and we
     // add it to the array of leaves.
     auto rgraph = reverse_graph(graph);
-    std::set<unsigned int> sccredges;
+    std::vector<unsigned int> component(N, NO_NODE);
     std::vector<std::vector<unsigned int>> leaves;
     for (; r < N; ++r) {
         unsigned int u = rstack[r];
@@ -363,10 +399,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
         unsigned int s = N;
         while (top) {
             u = stack[--s] = stack[--top];
-            const auto & redges = rgraph[u];
-            for (unsigned int j = 0; j < redges.size(); ++j) {
-                const unsigned int v = redges[j];
-                sccredges.insert(v);
+            for (const unsigned int v : rgraph.get_edges(u)) {
                 if (!tag[v]) {
                     continue;
                 }
@@ -376,16 +409,24 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
             }
         }
 
+        // the component is identified by its first node
         for (unsigned int i = s; i < N; ++i) {
-            sccredges.erase(stack[i]);
+            component[stack[i]] = u;
+        }
+        bool has_incoming_edges = false;
+        for (unsigned int i = s; i < N && !has_incoming_edges; ++i) {
+            for (const unsigned int v : rgraph.get_edges(stack[i])) {
+                if (component[v] != u) {
+                    has_incoming_edges = true;
+                    break;
+                }
+            }
         }
 
-        if (sccredges.empty()) {
+        if (!has_incoming_edges) {
             std::vector scc(stack.begin() + s, stack.end());
             std::sort(scc.begin(), scc.end());
             leaves.emplace_back(std::move(scc));
-        } else {
-            sccredges.clear();
         }
     }
 
@@ -472,6 +513,109 @@ inline static void filter_glob_internal(
     }
 }
 
+/// Minimal number of packages in the query for which the name trigram index is used. Smaller queries
+/// are faster to filter by checking the name of each package.
+constexpr std::size_t NAME_TRIGRAM_INDEX_MIN_QUERY_SIZE = 1000;
+
+/// Returns the longest run of characters of the glob pattern that must be present in each matching string.
+static std::string glob_longest_literal(const char * c_pattern) {
+    std::string longest;
+    std::string current;
+    for (const char * ptr = c_pattern; *ptr != '\0'; ++ptr) {
+        if (*ptr == '*' || *ptr == '?' || *ptr == '[') {
+            if (current.size() > longest.size()) {
+                longest = std::move(current);
+            }
+            current.clear();
+            if (*ptr == '[') {
+                // skip the bracket expression, "]" right after "[" or "[!" is a part of it
+                ++ptr;
+                if (*ptr == '!' || *ptr == '^') {
+                    ++ptr;
+                }
+                if (*ptr == ']') {
+                    ++ptr;
+                }
+                while (*ptr != '\0' && *ptr != ']') {
+                    ++ptr;
+                }
+                if (*ptr == '\0') {
+                    break;
+                }
+            }
+        } else if (*ptr == '\\' && ptr[1] != '\0') {
+            current += *++ptr;
+        } else {
+            current += *ptr;
+        }
+    }
+    if (current.size() > longest.size()) {
+        longest = std::move(current);
+    }
+    return longest;
+}
+
+/// Uses the name trigram index to get the sorted ids of package names which may contain `literal`
+/// ignoring case. Returns `std::nullopt` when the literal is too short to use the index.
+static std::optional<std::vector<Id>> get_name_trigram_candidates(
+    const std::unordered_map<uint32_t, std::vector<Id>> & index, std::string_view literal) {
+    if (literal.size() < 3) {
+        return std::nullopt;
+    }
+    std::vector<Id> candidates;
+    std::vector<Id> intersection;
+    for (std::size_t i = 0; i + 3 <= literal.size(); ++i) {
+        auto it = index.find(name_trigram(literal.data() + i));
+        if (it == index.end()) {
+            return std::vector<Id>{};
+        }
+        if (i == 0) {
+            candidates = it->second;
+        } else {
+            intersection.clear();
+            std::set_intersection(
+                candidates.begin(),
+                candidates.end(),
+                it->second.begin(),
+                it->second.end(),
+                std::back_inserter(intersection));
+            candidates.swap(intersection);
+        }
+        if (candidates.empty()) {
+            break;
+        }
+    }
+    return candidates;
+}
+
+/// Adds all packages whose names may contain `literal` according to the name trigram index and pass `match`
+/// into `filter_result`.
+/// Returns `false` when the name trigram index cannot be used for the `literal`.
+template <typename Matcher>
+static bool filter_name_by_trigram_index(
+    libdnf5::solv::RpmPool & pool,
+    const std::unordered_map<uint32_t, std::vector<Id>> & index,
+    const std::vector<Solvable *> & sorted_solvables,
+    std::string_view literal,
+    libdnf5::solv::SolvMap & filter_result,
+    Matcher match) {
+    auto name_ids = get_name_trigram_candidates(index, literal);
+    if (!name_ids) {
+        return false;
+    }
+    for (Id name_id : *name_ids) {
+        if (!match(pool.id2str(name_id))) {
+            continue;
+        }
+        auto low = std::lower_bound(sorted_solvables.begin(), sorted_solvables.end(), name_id, name_compare_lower_id);
+        while (low != sorted_solvables.end() && (*low)->name == name_id) {
+            filter_result.add_unsafe(pool.solvable2id(*low));
+            ++low;
+        }
+    }
+    return true;
+}
+
 void PackageQuery::filter_name(const std::vector<std::string> & patterns, libdnf5::sack::QueryCmp cmp_type) {
     auto & pool = get_rpm_pool(p_impl->base);
     auto sack = p_impl->base->get_rpm_package_sack();
@@ -485,6 +629,13 @@ void PackageQuery::filter_name(const std::vector<std::string> & patterns, libdnf
     }
 
     bool cmp_glob = (cmp_type & libdnf5::sack::QueryCmp::GLOB) == libdnf5::sack::QueryCmp::GLOB;
+    bool cmp_contains = (cmp_type & libdnf5::sack::QueryCmp::CONTAINS) == libdnf5::sack::QueryCmp::CONTAINS;
+
+    // Substring and glob matching of large queries uses the name trigram index instead of checking each package
+    const std::unordered_map<uint32_t, std::vector<Id>> * name_index = nullptr;
+    if ((cmp_glob || cmp_contains) && p_impl->size() >= NAME_TRIGRAM_INDEX_MIN_QUERY_SIZE) {
+        name_index = &sack->p_impl->get_name_trigram_index();
+    }
 
     for (auto & pattern : patterns) {
         libdnf5::sack::QueryCmp tmp_cmp_type = cmp_type;
@@ -524,28 +675,56 @@ void PackageQuery::filter_name(const std::vector<std::string> & patterns, libdnf
                 }
             } break;
             case libdnf5::sack::QueryCmp::ICONTAINS: {
+                auto match = [c_pattern](const char * name) { return strcasestr(name, c_pattern) != nullptr; };
+                if (name_index && filter_name_by_trigram_index(
+                                          pool, *name_index, sorted_solvables, pattern, filter_result, match)) {
+                    break;
+                }
                 for (Id candidate_id : *p_impl) {
-                    const char * name = pool.get_name(candidate_id);
-                    if (strcasestr(name, c_pattern) != nullptr) {
+                    if (match(pool.get_name(candidate_id))) {
                         filter_result.add_unsafe(candidate_id);
                     }
                 }
             } break;
-            case libdnf5::sack::QueryCmp::IGLOB:
+            case libdnf5::sack::QueryCmp::IGLOB: {
+                auto match = [c_pattern](const char * name) { return fnmatch(c_pattern, name, FNM_CASEFOLD) == 0; };
+                if (name_index && filter_name_by_trigram_index(
+                                          pool,
+                                          *name_index,
+                                          sorted_solvables,
+                                          glob_longest_literal(c_pattern),
+                                          filter_result,
+                                          match)) {
+                    break;
+                }
                 filter_glob_internal<&libdnf5::solv::RpmPool::get_name>(
                     pool, c_pattern, *p_impl, filter_result, FNM_CASEFOLD);
-                break;
+            } break;
             case libdnf5::sack::QueryCmp::CONTAINS: {
+                auto match = [c_pattern](const char * name) { return strstr(name, c_pattern) != nullptr; };
+                if (name_index && filter_name_by_trigram_index(
+                                          pool, *name_index, sorted_solvables, pattern, filter_result, match)) {
+                    break;
+                }
                 for (Id candidate_id : *p_impl) {
-                    const char * name = pool.get_name(candidate_id);
-                    if (strstr(name, c_pattern) != nullptr) {
+                    if (match(pool.get_name(candidate_id))) {
                         filter_result.add_unsafe(candidate_id);
                     }
                 }
             } break;
-            case libdnf5::sack::QueryCmp::GLOB:
+            case libdnf5::sack::QueryCmp::GLOB: {
+                auto match = [c_pattern](const char * name) { return fnmatch(c_pattern, name, 0) == 0; };
+                if (name_index && filter_name_by_trigram_index(
+                                          pool,
+                                          *name_index,
+                                          sorted_solvables,
+                                          glob_longest_literal(c_pattern),
+                                          filter_result,
+                                          match)) {
+                    break;
+                }
                 filter_glob_internal<&libdnf5::solv::RpmPool::get_name>(pool, c_pattern, *p_impl, filter_result, 0);
-                break;
+            } break;
             default:
                 libdnf_throw_assert_unsupported_query_cmp_type(cmp_type);
         }
@@ -1348,6 +1527,9 @@ void PackageQuery::filter_epoch(const std::vector<std::string> & patterns, libdn
     }
 }
 
+/// Minimal number of packages in the query for which the file index is used for exact file lookups.
+constexpr std::size_t FILE_INDEX_MIN_QUERY_SIZE = 1000;
+
 static void filter_dataiterator(
     Pool * pool,
     Id keyname,
@@ -1367,6 +1549,32 @@ static void filter_dataiterator(
     }
 }
 
+/// Adds packages from `candidates` containing exactly the file `path` into `filter_result`.
+/// Only the packages found in the file index are checked.
+static void filter_file_by_index(
+    Pool * pool,
+    const std::vector<std::pair<uint32_t, Id>> & file_index,
+    const libdnf5::solv::SolvMap & candidates,
+    libdnf5::solv::SolvMap & filter_result,
+    const char * path) {
+    auto hash = file_path_hash(path);
+    libdnf5::solv::SolvMap index_candidates(pool->nsolvables);
+    for (auto it = std::lower_bound(file_index.begin(), file_index.end(), std::make_pair(hash, static_cast<Id>(0)));
+         it != file_index.end() && it->first == hash;
+         ++it) {
+        if (candidates.contains(it->second)) {
+            index_candidates.add_unsafe(it->second);
+        }
+    }
+    filter_dataiterator(
+        pool,
+        SOLVABLE_FILELIST,
+        SEARCH_FILES | SEARCH_COMPLETE_FILELIST | SEARCH_STRING,
+        index_candidates,
+        filter_result,
+        path);
+}
+
 static void filter_dataiterator_internal(
     Pool * pool,
     Id keyname,
@@ -1426,7 +1634,39 @@ static void filter_dataiterator_internal(
 }
 
 void PackageQuery::filter_file(const std::vector<std::string> & patterns, libdnf5::sack::QueryCmp cmp_type) {
-    filter_dataiterator_internal(*get_rpm_pool(p_impl->base), SOLVABLE_FILELIST, *p_impl, cmp_type, patterns);
+    auto & sack_impl = *p_impl->base->get_rpm_package_sack()->p_impl;
+    sack_impl.load_ondemand_repodata(libdnf5::repo::RepodataType::FILELISTS);
+    auto & pool = get_rpm_pool(p_impl->base);
+
+    // Glob patterns without any wildcard match the path exactly, e.g. "dnf5 provides /usr/bin/foo"
+    if (cmp_type == libdnf5::sack::QueryCmp::GLOB || cmp_type == libdnf5::sack::QueryCmp::NOT_GLOB) {
+        bool any_glob = std::any_of(patterns.begin(), patterns.end(), [](const std::string & pattern) {
+            return libdnf5::utils::is_glob_pattern(pattern.c_str());
+        });
+        if (!any_glob) {
+            cmp_type =
+                cmp_type == libdnf5::sack::QueryCmp::GLOB ? libdnf5::sack::QueryCmp::EQ : libdnf5::sack::QueryCmp::NEQ;
+        }
+    }
+
+    // Exact lookups in large queries use the file index to find the few packages whose filelists need a check
+    if ((cmp_type == libdnf5::sack::QueryCmp::EQ || cmp_type == libdnf5::sack::QueryCmp::NEQ) &&
+        p_impl->size() >= FILE_INDEX_MIN_QUERY_SIZE) {
+        if (auto * file_index = sack_impl.get_file_index(patterns.size())) {
+            libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
+            for (auto & pattern : patterns) {
+                filter_file_by_index(*pool, *file_index, *p_impl, filter_result, pattern.c_str());
+            }
+            if (cmp_type == libdnf5::sack::QueryCmp::NEQ) {
+                *p_impl -= filter_result;
+            } else {
+                *p_impl &= filter_result;
+            }
+            return;
+        }
+    }
+
+    filter_dataiterator_internal(*pool, SOLVABLE_FILELIST, *p_impl, cmp_type, patterns);
 }
 
 void PackageQuery::filter_description(const std::vector<std::string> & patterns, libdnf5::sack::QueryCmp cmp_type) {
@@ -1503,6 +1743,30 @@ void PackageQuery::filter_provides(const Reldep & reldep, libdnf5::sack::QueryCm
     filter_provides(reldep_list, cmp_type);
 }
 
+ReldepList PackageQuery::get_unprovided_reldeps(const ReldepList & reldep_list) const {
+    ::Pool * pool = *get_rpm_pool(p_impl->base);
+    p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
+
+    ReldepList unprovided(p_impl->base);
+    Id p;
+    Id pp;
+    auto reldep_list_size = reldep_list.size();
+    for (int index = 0; index < reldep_list_size; ++index) {
+        Id reldep_id = reldep_list.get_id(index).id;
+        bool provided = false;
+        FOR_PROVIDES(p, pp, reldep_id) {
+            if (p_impl->contains_unsafe(p)) {
+                provided = true;
+                break;
+            }
+        }
+        if (!provided) {
+            unprovided.add(ReldepId(reldep_id));
+        }
+    }
+    return unprovided;
+}
+
 /// Provide libdnf5::sack::QueryCmp without NOT flag
 void PackageQuery::PQImpl::str2reldep_internal(
     ReldepList & reldep_list, libdnf5::sack::QueryCmp cmp_type, bool cmp_glob, const std::string & pattern) {
@@ -2096,10 +2360,12 @@ void PackageQuery::filter_obsoletes(const PackageSet & package_set, libdnf5::sac
     int obsprovides = pool_get_flag(pool, POOL_FLAG_OBSOLETEUSESPROVIDES);
 
     auto & target = *package_set.p_impl;
-    for (auto package_id : *p_impl) {
+
+    // Returns true if the package obsoletes any package of the target
+    auto obsoletes_target = [&](Id package_id) {
         Solvable * solvable = spool.id2solvable(package_id);
         if (!solvable->repo)
-            continue;
+            return false;
         for (Id * r_id = solvable->repo->idarraydata + solvable->dep_obsoletes; *r_id; ++r_id) {
             Id r;
             Id rr;
@@ -2113,8 +2379,42 @@ void PackageQuery::filter_obsoletes(const PackageSet & package_set, libdnf5::sac
                 if (obsprovides == 0 && pool_match_nevr(pool, so, *r_id) == 0) {
                     continue; /* only matching pkg names */
                 }
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // When only the package names are matched, the candidates obsoleting the target packages are looked up
+    // in the obsoletes index instead of checking the obsoletes of every package in the query.
+    const std::vector<std::pair<Id, Id>> * obsoletes_index = nullptr;
+    if (obsprovides == 0 && target.size() < p_impl->size()) {
+        obsoletes_index = p_impl->base->get_rpm_package_sack()->p_impl->get_obsoletes_index(1);
+    }
+
+    if (obsoletes_index) {
+        auto check_candidates = [&](Id name) {
+            auto it = std::lower_bound(obsoletes_index->begin(), obsoletes_index->end(), std::pair<Id, Id>(name, 0));
+            for (; it != obsoletes_index->end() && it->first == name; ++it) {
+                auto package_id = it->second;
+                if (p_impl->contains_unsafe(package_id) && !filter_result.contains_unsafe(package_id) &&
+                    obsoletes_target(package_id)) {
+                    filter_result.add_unsafe(package_id);
+                }
+            }
+        };
+        std::set<Id> target_names;
+        for (auto target_id : target) {
+            target_names.insert(spool.id2solvable(target_id)->name);
+        }
+        for (auto name : target_names) {
+            check_candidates(name);
+        }
+        check_candidates(0);
+    } else {
+        for (auto package_id : *p_impl) {
+            if (obsoletes_target(package_id)) {
                 filter_result.add_unsafe(package_id);
-                break;
             }
         }
     }
@@ -2186,23 +2486,87 @@ void PackageQuery::filter_latest_unresolved_advisories(
     const libdnf5::advisory::AdvisoryQuery & advisory_query,
     PackageQuery & installed,
     libdnf5::sack::QueryCmp cmp_type) {
+    auto & pool = get_rpm_pool(p_impl->base);
+
+    bool cmp_not = (cmp_type & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
+    if (cmp_not) {
+        // Removal of NOT CmpType makes following comparisons easier and effective
+        cmp_type = cmp_type - libdnf5::sack::QueryCmp::NOT;
+    }
+    switch (cmp_type) {
+        case libdnf5::sack::QueryCmp::EQ:
+        case libdnf5::sack::QueryCmp::GTE:
+        case libdnf5::sack::QueryCmp::LTE:
+        case libdnf5::sack::QueryCmp::LT:
+        case libdnf5::sack::QueryCmp::GT:
+            break;
+        default:
+            libdnf_throw_assert_unsupported_query_cmp_type(cmp_type);
+    }
+
     auto adv_pkgs = advisory_query.get_advisory_packages_sorted_by_name_arch_evr();
-    std::vector<libdnf5::advisory::AdvisoryPackage> latest_unresolved_adv_pkgs;
-    for (std::vector<libdnf5::advisory::AdvisoryPackage>::iterator i = adv_pkgs.begin(); i != adv_pkgs.end(); ++i) {
-        // Filter out already resolved advisories
-        if (i->p_impl->is_resolved_in(installed)) {
+    auto & sorted_solvables = p_impl->base->get_rpm_package_sack()->p_impl->get_sorted_solvables();
+
+    // Both the advisory packages and the solvables are sorted by name and arch, so the solvables
+    // with the name and arch of an advisory package are found in a single pass over both of them.
+    libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
+    auto na_begin = sorted_solvables.begin();
+    for (auto adv_pkg_it = adv_pkgs.begin(); adv_pkg_it != adv_pkgs.end(); ++adv_pkg_it) {
+        const auto & adv_pkg = *adv_pkg_it->p_impl;
+
+        // Include only the advisory package with the most recent EVR
+        auto next_adv_pkg = std::next(adv_pkg_it);
+        if (next_adv_pkg != adv_pkgs.end() && adv_pkg.get_name_id() == next_adv_pkg->p_impl->get_name_id() &&
+            adv_pkg.get_arch_id() == next_adv_pkg->p_impl->get_arch_id()) {
             continue;
         }
 
-        // Include only the advisory package with the most recent EVR
-        auto next_adv_pkg = std::next(i);
-        if (next_adv_pkg == adv_pkgs.end() || i->get_name() != next_adv_pkg->get_name() ||
-            i->get_arch() != next_adv_pkg->get_arch()) {
-            latest_unresolved_adv_pkgs.push_back(*i);
+        while (na_begin != sorted_solvables.end() &&
+               libdnf5::advisory::AdvisoryPackage::Impl::name_arch_compare_lower_solvable(*na_begin, adv_pkg)) {
+            ++na_begin;
+        }
+        auto na_end = na_begin;
+        while (na_end != sorted_solvables.end() && (*na_end)->name == adv_pkg.get_name_id() &&
+               (*na_end)->arch == adv_pkg.get_arch_id()) {
+            ++na_end;
+        }
+
+        // Filter out already resolved advisories (an installed package with lower or equal evr is present)
+        bool resolved = false;
+        for (auto it = na_begin; it != na_end; ++it) {
+            if (pool.evrcmp((*it)->evr, adv_pkg.get_evr_id(), EVRCMP_COMPARE) >= 0 &&
+                installed.p_impl->contains(pool.solvable2id(*it))) {
+                resolved = true;
+                break;
+            }
+        }
+
+        if (!resolved) {
+            for (auto it = na_begin; it != na_end; ++it) {
+                bool match;
+                if (cmp_type == libdnf5::sack::QueryCmp::EQ) {
+                    match = (*it)->evr == adv_pkg.get_evr_id();
+                } else {
+                    int libsolv_cmp = pool.evrcmp((*it)->evr, adv_pkg.get_evr_id(), EVRCMP_COMPARE);
+                    match = ((libsolv_cmp > 0) && ((cmp_type & sack::QueryCmp::GT) == sack::QueryCmp::GT)) ||
+                            ((libsolv_cmp < 0) && ((cmp_type & sack::QueryCmp::LT) == sack::QueryCmp::LT)) ||
+                            ((libsolv_cmp == 0) && ((cmp_type & sack::QueryCmp::EQ) == sack::QueryCmp::EQ));
+                }
+                if (match) {
+                    filter_result.add_unsafe(pool.solvable2id(*it));
+                }
+            }
         }
+
+        na_begin = na_end;
     }
 
-    PQImpl::filter_sorted_advisory_pkgs(*this, latest_unresolved_adv_pkgs, cmp_type);
+    // Apply filter results to query
+    if (cmp_not) {
+        *p_impl -= filter_result;
+    } else {
+        *p_impl &= filter_result;
+    }
 }
 
 void PackageQuery::filter_installed() {
@@ -2419,7 +2783,14 @@ static void add_block_to_map(
     }
 }
 
-static int latest_cmp(const Id * ap, const Id * bp, libdnf5::solv::RpmPool * pool) {
+struct EvrCmpData {
+    libdnf5::solv::RpmPool * pool;
+    // EVR ranks of solvables, see `PackageSack::Impl::get_evr_ranks()`, or nullptr to compare the EVRs directly
+    const std::vector<int> * evr_ranks;
+};
+
+static int latest_cmp(const Id * ap, const Id * bp, EvrCmpData * data) {
+    auto * pool = data->pool;
     Solvable * sa = pool->id2solvable(*ap);
     Solvable * sb = pool->id2solvable(*bp);
     int r;
@@ -2429,13 +2800,18 @@ static int latest_cmp(const Id * ap, const Id * bp, libdnf5::solv::RpmPool * poo
     r = sa->arch - sb->arch;
     if (r)
         return r;
-    r = pool->evrcmp(sb->evr, sa->evr, EVRCMP_COMPARE);
+    if (data->evr_ranks) {
+        r = (*data->evr_ranks)[static_cast<std::size_t>(*bp)] - (*data->evr_ranks)[static_cast<std::size_t>(*ap)];
+    } else {
+        r = pool->evrcmp(sb->evr, sa->evr, EVRCMP_COMPARE);
+    }
     if (r)
         return r;
     return *ap - *bp;
 }
 
-static int earliest_cmp(const Id * ap, const Id * bp, libdnf5::solv::RpmPool * pool) {
+static int earliest_cmp(const Id * ap, const Id * bp, EvrCmpData * data) {
+    auto * pool = data->pool;
     Solvable * sa = pool->id2solvable(*ap);
     Solvable * sb = pool->id2solvable(*bp);
     int r;
@@ -2445,7 +2821,11 @@ static int earliest_cmp(const Id * ap, const Id * bp, libdnf5::solv::RpmPool * p
     r = sa->arch - sb->arch;
     if (r)
         return r;
-    r = pool->evrcmp(sb->evr, sa->evr, EVRCMP_COMPARE);
+    if (data->evr_ranks) {
+        r = (*data->evr_ranks)[static_cast<std::size_t>(*bp)] - (*data->evr_ranks)[static_cast<std::size_t>(*ap)];
+    } else {
+        r = pool->evrcmp(sb->evr, sa->evr, EVRCMP_COMPARE);
+    }
     if (r > 0)
         return -1;
     if (r < 0)
@@ -2453,25 +2833,51 @@ static int earliest_cmp(const Id * ap, const Id * bp, libdnf5::solv::RpmPool * p
     return *ap - *bp;
 }
 
-static void filter_first_sorted_by(
-    libdnf5::solv::RpmPool & pool,
-    int limit,
-    int (*cmp)(const Id * a, const Id * b, libdnf5::solv::RpmPool * pool),
-    libdnf5::solv::SolvMap & data) {
-    libdnf5::solv::IdQueue samename;
+// Same as latest_cmp(), but groups the packages by repository first
+static int latest_per_repo_cmp(const Id * ap, const Id * bp, EvrCmpData * data) {
+    auto * pool = data->pool;
+    int r = pool->id2solvable(*ap)->repo->repoid - pool->id2solvable(*bp)->repo->repoid;
+    if (r)
+        return r;
+    return latest_cmp(ap, bp, data);
+}
+
+static inline bool is_same_block(const Solvable * first, const Solvable * second, bool per_repo) {
+    return first->name == second->name && first->arch == second->arch && (!per_repo || first->repo == second->repo);
+}
+
+/// Sorts the packages from `data` by `cmp` into `samename`.
+static void sort_candidates(
+    const BaseWeakPtr & base,
+    int (*cmp)(const Id * a, const Id * b, EvrCmpData * data),
+    const libdnf5::solv::SolvMap & data,
+    libdnf5::solv::IdQueue & samename) {
+    auto & pool = get_rpm_pool(base);
     for (Id candidate_id : data) {
         samename.push_back(candidate_id);
     }
-    samename.sort(cmp, &pool);
+    // Repeated filtering of big queries is faster with the precomputed EVR ranks
+    EvrCmpData cmp_data{
+        &pool, base->get_rpm_package_sack()->p_impl->get_evr_ranks(static_cast<std::size_t>(samename.size()))};
+    samename.sort(cmp, &cmp_data);
+}
 
+/// Replaces the content of `data` with up to `limit` first EVRs of each block of the first `size` sorted
+/// packages in `samename`. A block are the packages with the same name and arch (and repository if `per_repo`).
+static void add_n_first_per_block(
+    libdnf5::solv::RpmPool & pool,
+    libdnf5::solv::SolvMap & data,
+    libdnf5::solv::IdQueue & samename,
+    int size,
+    int limit,
+    bool per_repo) {
     data.clear();
-    // Create blocks per name, arch
     Solvable * highest = nullptr;
     int start_block = -1;
     int i;
-    for (i = 0; i < samename.size(); ++i) {
+    for (i = 0; i < size; ++i) {
         Solvable * considered = pool.id2solvable(samename[i]);
-        if (!highest || highest->name != considered->name || highest->arch != considered->arch) {
+        if (!highest || !is_same_block(highest, considered, per_repo)) {
             /* start of a new block */
             if (start_block == -1) {
                 highest = considered;
@@ -2488,12 +2894,61 @@ static void filter_first_sorted_by(
     }
 }
 
+static void filter_first_sorted_by(
+    const BaseWeakPtr & base,
+    int limit,
+    int (*cmp)(const Id * a, const Id * b, EvrCmpData * data),
+    libdnf5::solv::SolvMap & data,
+    bool per_repo = false) {
+    auto & pool = get_rpm_pool(base);
+    libdnf5::solv::IdQueue samename;
+    sort_candidates(base, cmp, data, samename);
+    add_n_first_per_block(pool, data, samename, samename.size(), limit, per_repo);
+}
+
 void PackageQuery::filter_latest_evr(int limit) {
-    filter_first_sorted_by(get_rpm_pool(p_impl->base), limit, latest_cmp, *p_impl);
+    filter_first_sorted_by(p_impl->base, limit, latest_cmp, *p_impl);
+}
+
+void PackageQuery::filter_latest_evr_by_priority(int limit) {
+    auto & pool = get_rpm_pool(p_impl->base);
+    libdnf5::solv::IdQueue samename;
+    sort_candidates(p_impl->base, latest_cmp, *p_impl, samename);
+
+    // Drop the available packages that are not from the repositories with the highest priority in their
+    // name.arch block, the same as `filter_priority()` does. The order of the remaining packages is kept.
+    int size = 0;
+    for (int start_block = 0, stop_block = 0; start_block < samename.size(); start_block = stop_block) {
+        Solvable * first = pool.id2solvable(samename[start_block]);
+        bool has_available = false;
+        int priority = 0;
+        for (stop_block = start_block; stop_block < samename.size(); ++stop_block) {
+            Solvable * considered = pool.id2solvable(samename[stop_block]);
+            if (!is_same_block(first, considered, false)) {
+                break;
+            }
+            if (!pool.is_installed(considered) && (!has_available || considered->repo->priority > priority)) {
+                has_available = true;
+                priority = considered->repo->priority;
+            }
+        }
+        for (int i = start_block; i < stop_block; ++i) {
+            Solvable * considered = pool.id2solvable(samename[i]);
+            if (pool.is_installed(considered) || considered->repo->priority == priority) {
+                samename[size++] = samename[i];
+            }
+        }
+    }
+
+    add_n_first_per_block(pool, *p_impl, samename, size, limit, false);
+}
+
+void PackageQuery::filter_latest_evr_per_repo(int limit) {
+    filter_first_sorted_by(p_impl->base, limit, latest_per_repo_cmp, *p_impl, true);
 }
 
 void PackageQuery::filter_earliest_evr(int limit) {
-    filter_first_sorted_by(get_rpm_pool(p_impl->base), limit, earliest_cmp, *p_impl);
+    filter_first_sorted_by(p_impl->base, limit, earliest_cmp, *p_impl);
 }
 
 static inline bool priority_solvable_cmp_key(const Solvable * first, const Solvable * second) {
@@ -2600,13 +3055,23 @@ std::pair<bool, libdnf5::rpm::Nevra> PackageQuery::resolve_pkg_spec(
     }
     auto is_file_pattern = libdnf5::utils::is_file_pattern(pkg_spec);
     if (settings.with_filenames && is_file_pattern) {
-        filter_dataiterator(
-            *pool,
-            SOLVABLE_FILELIST,
-            SEARCH_FILES | SEARCH_COMPLETE_FILELIST | (glob ? SEARCH_GLOB : SEARCH_STRING),
-            *p_impl,
-            filter_result,
-            pkg_spec.c_str());
+        sack->p_impl->load_ondemand_repodata(libdnf5::repo::RepodataType::FILELISTS);
+        // Resolving many specs looks up many files, exact paths then use the file index
+        const std::vector<std::pair<uint32_t, Id>> * file_index = nullptr;
+        if (!glob && p_impl->size() >= FILE_INDEX_MIN_QUERY_SIZE) {
+            file_index = sack->p_impl->get_file_index(1);
+        }
+        if (file_index) {
+            filter_file_by_index(*pool, *file_index, *p_impl, filter_result, pkg_spec.c_str());
+        } else {
+            filter_dataiterator(
+                *pool,
+                SOLVABLE_FILELIST,
+                SEARCH_FILES | SEARCH_COMPLETE_FILELIST | (glob ? SEARCH_GLOB : SEARCH_STRING),
+                *p_impl,
+                filter_result,
+                pkg_spec.c_str());
+        }
         if (!filter_result.empty()) {
             *p_impl &= filter_result;
             return {true, libdnf5::rpm::Nevra()};
@@ -2634,14 +3099,22 @@ std::pair<bool, libdnf5::rpm::Nevra> PackageQuery::resolve_pkg_spec(
             }
         }
         // Seach for file provides - more expensive
+        const std::vector<std::pair<uint32_t, Id>> * file_index = nullptr;
+        if (!glob && p_impl->size() >= FILE_INDEX_MIN_QUERY_SIZE) {
+            file_index = sack->p_impl->get_file_index(binary_paths_string.size());
+        }
         for (auto & path : binary_paths_string) {
-            filter_dataiterator(
-                *pool,
-                SOLVABLE_FILELIST,
-                SEARCH_FILES | SEARCH_COMPLETE_FILELIST | (glob ? SEARCH_GLOB : SEARCH_STRING),
-                *p_impl,
-                filter_result,
-                path.c_str());
+            if (file_index) {
+                filter_file_by_index(*pool, *file_index, *p_impl, filter_result, path.c_str());
+            } else {
+                filter_dataiterator(
+                    *pool,
+                    SOLVABLE_FILELIST,
+                    SEARCH_FILES | SEARCH_COMPLETE_FILELIST | (glob ? SEARCH_GLOB : SEARCH_STRING),
+                    *p_impl,
+                    filter_result,
+                    path.c_str());
+            }
             if (!filter_result.empty()) {
                 *p_impl &= filter_result;
                 return {true, libdnf5::rpm::Nevra()};
@@ -2703,7 +3176,8 @@ std::vector<std::vector<Package>> PackageQuery::filter_leaves(bool return_groupe
 
     // build the directed graph of dependencies
     bool use_recommends = p_impl->base->get_config().get_install_weak_deps_option().get_value();
-    auto graph = build_graph(*p_impl->base, *this, pkgs, use_recommends);
+    p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
+    auto graph = build_graph(*pool, pkgs, use_recommends);
 
     // run Kosaraju's algorithm to find strongly connected components
     // without any incoming edges
@@ -2742,6 +3216,39 @@ std::vector<std::vector<Package>> PackageQuery::filter_leaves_groups() {
     return filter_leaves(true);
 }
 
+void PackageQuery::filter_requires_closure(const PackageSet & package_set) {
+    libdnf_assert_same_base(p_impl->base, package_set.get_base());
+    p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
+    ::Pool * pool = *get_rpm_pool(p_impl->base);
+
+    // walk the requires from the frontier, each package is expanded once and the providers are looked up
+    // in the whatprovides index
+    libdnf5::solv::SolvMap closure(pool->nsolvables);
+    std::vector<Id> stack;
+    for (const auto id : *package_set.p_impl) {
+        if (p_impl->contains(id)) {
+            closure.add_unsafe(id);
+            stack.push_back(id);
+        }
+    }
+    while (!stack.empty()) {
+        const auto id = stack.back();
+        stack.pop_back();
+        const auto requires_list = Package(p_impl->base, PackageId(id)).get_requires();
+        for (int i = 0; i < requires_list.size(); ++i) {
+            Id p;
+            Id pp;
+            FOR_PROVIDES(p, pp, requires_list.get_id(i).id) {
+                if (p_impl->contains(p) && !closure.contains_unsafe(p)) {
+                    closure.add_unsafe(p);
+                    stack.push_back(p);
+                }
+            }
+        }
+    }
+    *p_impl &= closure;
+}
+
 void PackageQuery::filter_recent(const time_t timestamp) {
     auto & pool = get_rpm_pool(p_impl->base);
     const unsigned long long time_long = static_cast<unsigned long long>(timestamp);
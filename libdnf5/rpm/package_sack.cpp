@@ -31,6 +31,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 extern "C" {
 #include <solv/chksum.h>
+#include <solv/dataiterator.h>
 #include <solv/repo.h>
 #include <solv/repo_comps.h>
 #include <solv/repo_rpmmd.h>
@@ -42,18 +43,277 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
 #include <filesystem>
+#include <map>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 
 using LibsolvRepo = Repo;
 
 namespace libdnf5::rpm {
 
+/// Returns `true` if the file is listed in the primary metadata. createrepo_c stores there only the files
+/// containing "bin/", files in "/etc/" and the "/usr/lib/sendmail" file. Others are only present in filelists.
+static bool is_primary_file_path(const char * path) {
+    return std::strstr(path, "bin/") || std::strncmp(path, "/etc/", 5) == 0 ||
+           std::strcmp(path, "/usr/lib/sendmail") == 0;
+}
+
+
+/// Resolves the `pkg_spec` in the packages of the repositories `repo_ids` and adds the found packages into `result`.
+/// The result is the same as if the spec was resolved in each of the repositories separately. A repository that
+/// has no match for the spec form found in the other repositories can still match a later form, such repositories
+/// are resolved again together. Every round finds a later form, so the number of rounds is limited by the forms.
+/// @return `true` if any package was found.
+static bool resolve_pkg_spec_in_repos(
+    const BaseWeakPtr & base,
+    const std::string & pkg_spec,
+    const ResolveSpecSettings & settings,
+    std::vector<std::string> repo_ids,
+    PackageSet & result) {
+    bool found_any = false;
+    while (!repo_ids.empty()) {
+        PackageQuery query(base, PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
+        query.filter_repo_id(repo_ids);
+        const auto & [found, nevra] = query.resolve_pkg_spec(pkg_spec, settings, true);
+        if (!found) {
+            break;
+        }
+        result |= query;
+        found_any = true;
+
+        std::set<std::string> matched_repo_ids;
+        for (const auto & pkg : query) {
+            matched_repo_ids.insert(pkg.get_repo_id());
+        }
+        std::erase_if(repo_ids, [&matched_repo_ids](const std::string & id) { return matched_repo_ids.contains(id); });
+    }
+    return found_any;
+}
+
+
+// Downloads the on-demand metadata of the `type` that are missing. A failed download is only reported,
+// the repository is then used without the metadata.
+static void download_ondemand_repodata(
+    const BaseWeakPtr & base, const std::vector<repo::Repo *> & repos, repo::RepodataType type) {
+    std::vector<std::exception_ptr> errors(repos.size());
+    std::atomic<std::size_t> next_repo{0};
+
+    auto download_worker = [&]() {
+        for (std::size_t idx; (idx = next_repo++) < repos.size();) {
+            try {
+                repos[idx]->solv_repo->download_ondemand_repo_ext(type, *repos[idx]->downloader);
+            } catch (...) {
+                errors[idx] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t num_download_workers = std::min(
+        std::max<std::size_t>(1, base->get_config().get_max_parallel_downloads_option().get_value()), repos.size());
+    if (num_download_workers <= 1) {
+        download_worker();
+    } else {
+        std::vector<std::thread> download_workers;
+        download_workers.reserve(num_download_workers);
+        for (std::size_t i = 0; i < num_download_workers; ++i) {
+            download_workers.emplace_back(download_worker);
+        }
+        for (auto & worker : download_workers) {
+            worker.join();
+        }
+    }
+
+    for (const auto & error : errors) {
+        if (error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::runtime_error & e) {
+                base->get_logger()->warning("{}", e.what());
+            }
+        }
+    }
+}
+
+
+bool PackageSack::Impl::load_ondemand_repodata(repo::Repo & repo, repo::RepodataType type, bool download) {
+    if (!repo.solv_repo || !repo.solv_repo->has_ondemand_repo_ext(type)) {
+        return false;
+    }
+
+    if (download) {
+        download_ondemand_repodata(base, {&repo}, type);
+    }
+
+    if (!repo.solv_repo->load_ondemand_repo_ext(type, *repo.downloader)) {
+        return false;
+    }
+
+    // The new repodata can bring file provides, they need to be computed again
+    invalidate_provides();
+    if (type == repo::RepodataType::FILELISTS) {
+        invalidate_file_index();
+    }
+    return true;
+}
+
+
+bool PackageSack::Impl::load_ondemand_repodata(repo::RepodataType type) {
+    auto rq = repo::RepoQuery(base);
+    std::vector<repo::Repo *> repos;
+    for (auto & repo : rq.get_data()) {
+        if (repo->solv_repo && repo->solv_repo->has_ondemand_repo_ext(type)) {
+            repos.push_back(repo.get());
+        }
+    }
+
+    // The downloads run in parallel, loading into the shared pool is sequential
+    download_ondemand_repodata(base, repos, type);
+
+    bool loaded = false;
+    for (auto * repo : repos) {
+        if (load_ondemand_repodata(*repo, type, false)) {
+            loaded = true;
+        }
+    }
+    return loaded;
+}
+
+
+const std::vector<std::pair<uint32_t, Id>> * PackageSack::Impl::get_file_index(std::size_t lookups) {
+    auto nsolvables = get_nsolvables();
+    if (nsolvables == cached_file_index_size) {
+        return &cached_file_index;
+    }
+    file_index_lookups += lookups;
+    if (file_index_lookups < 2) {
+        return nullptr;
+    }
+
+    cached_file_index.clear();
+    auto & pool = get_rpm_pool(base);
+    Dataiterator di;
+    dataiterator_init(&di, *pool, nullptr, 0, SOLVABLE_FILELIST, nullptr, SEARCH_FILES | SEARCH_COMPLETE_FILELIST);
+    while (dataiterator_step(&di) != 0) {
+        cached_file_index.emplace_back(file_path_hash(di.kv.str), di.solvid);
+    }
+    dataiterator_free(&di);
+    std::sort(cached_file_index.begin(), cached_file_index.end());
+    cached_file_index.erase(
+        std::unique(cached_file_index.begin(), cached_file_index.end()), cached_file_index.end());
+    cached_file_index.shrink_to_fit();
+    cached_file_index_size = nsolvables;
+    return &cached_file_index;
+}
+
+
+const std::vector<std::pair<Id, Id>> * PackageSack::Impl::get_obsoletes_index(std::size_t lookups) {
+    auto nsolvables = get_nsolvables();
+    if (nsolvables == cached_obsoletes_index_size) {
+        return &cached_obsoletes_index;
+    }
+    obsoletes_index_lookups += lookups;
+    if (obsoletes_index_lookups < 2) {
+        return nullptr;
+    }
+
+    cached_obsoletes_index.clear();
+    auto & pool = get_rpm_pool(base);
+    for (Id id = 2; id < nsolvables; ++id) {
+        Solvable * solvable = pool.id2solvable(id);
+        if (!solvable->repo || !solvable->dep_obsoletes) {
+            continue;
+        }
+        for (Id * obs_id = solvable->repo->idarraydata + solvable->dep_obsoletes; *obs_id; ++obs_id) {
+            Id name = *obs_id;
+            if (ISRELDEP(name)) {
+                Reldep * rd = GETRELDEP(*pool, name);
+                // only the comparison relations match just the packages with the given name
+                name = rd->flags <= 7 && !ISRELDEP(rd->name) ? rd->name : 0;
+            }
+            cached_obsoletes_index.emplace_back(name, id);
+        }
+    }
+    std::sort(cached_obsoletes_index.begin(), cached_obsoletes_index.end());
+    cached_obsoletes_index.erase(
+        std::unique(cached_obsoletes_index.begin(), cached_obsoletes_index.end()), cached_obsoletes_index.end());
+    cached_obsoletes_index.shrink_to_fit();
+    cached_obsoletes_index_size = nsolvables;
+    return &cached_obsoletes_index;
+}
+
+
+const std::vector<int> * PackageSack::Impl::get_evr_ranks(std::size_t comparisons) {
+    auto nsolvables = get_nsolvables();
+    if (nsolvables == cached_evr_ranks_size) {
+        return &cached_evr_ranks;
+    }
+    evr_ranks_comparisons += comparisons;
+    if (evr_ranks_comparisons < static_cast<std::size_t>(nsolvables)) {
+        return nullptr;
+    }
+
+    auto & pool = get_rpm_pool(base);
+    auto & sorted_solvables = get_sorted_solvables();
+    cached_evr_ranks.assign(static_cast<std::size_t>(nsolvables), 0);
+    std::vector<Id> evrs_by_id;
+    std::vector<Id> evrs_by_evr;
+    std::vector<int> ranks;
+    for (auto block_begin = sorted_solvables.begin(); block_begin != sorted_solvables.end();) {
+        auto block_end = block_begin + 1;
+        while (block_end != sorted_solvables.end() && (*block_end)->name == (*block_begin)->name &&
+               (*block_end)->arch == (*block_begin)->arch) {
+            ++block_end;
+        }
+
+        // The solvables with the same name and arch are sorted by evr id, only the distinct ids are compared
+        evrs_by_id.clear();
+        for (auto it = block_begin; it != block_end; ++it) {
+            if (evrs_by_id.empty() || evrs_by_id.back() != (*it)->evr) {
+                evrs_by_id.push_back((*it)->evr);
+            }
+        }
+        if (evrs_by_id.size() > 1) {
+            evrs_by_evr = evrs_by_id;
+            // stable_sort does not rely on the strict weak ordering of the comparator for memory safety
+            std::stable_sort(evrs_by_evr.begin(), evrs_by_evr.end(), [&pool](Id evr1, Id evr2) {
+                return pool.evrcmp(evr1, evr2, EVRCMP_COMPARE) < 0;
+            });
+            ranks.resize(evrs_by_id.size());
+            int rank = 0;
+            for (std::size_t i = 0; i < evrs_by_evr.size(); ++i) {
+                if (i > 0 && pool.evrcmp(evrs_by_evr[i - 1], evrs_by_evr[i], EVRCMP_COMPARE) != 0) {
+                    ++rank;
+                }
+                auto pos = std::lower_bound(evrs_by_id.begin(), evrs_by_id.end(), evrs_by_evr[i]) - evrs_by_id.begin();
+                ranks[static_cast<std::size_t>(pos)] = rank;
+            }
+            for (auto it = block_begin; it != block_end; ++it) {
+                auto pos = std::lower_bound(evrs_by_id.begin(), evrs_by_id.end(), (*it)->evr) - evrs_by_id.begin();
+                cached_evr_ranks[static_cast<std::size_t>(pool.solvable2id(*it))] =
+                    ranks[static_cast<std::size_t>(pos)];
+            }
+        }
+        block_begin = block_end;
+    }
+    cached_evr_ranks_size = nsolvables;
+    return &cached_evr_ranks;
+}
+
+
 void PackageSack::Impl::make_provides_ready() {
     if (provides_ready) {
         return;
     }
 
+    TraceSpan span(*base, "make_provides_ready");
+
     // Temporarily replaces the considered map with an empty one. Ignores "excludes" during calculation provides.
     libdnf5::solv::SolvMap original_considered_map(0);
     get_rpm_pool(base).swap_considered_map(original_considered_map);
@@ -65,6 +325,21 @@ void PackageSack::Impl::make_provides_ready() {
     libdnf5::solv::IdQueue addedfileprovides_inst;
     pool_addfileprovides_queue(*pool, &addedfileprovides.get_queue(), &addedfileprovides_inst.get_queue());
 
+    // File dependencies not covered by primary metadata can only be resolved using filelists.
+    // Load them if their loading was postponed and compute the file provides again.
+    for (auto file_id : addedfileprovides) {
+        if (!is_primary_file_path(pool.id2str(file_id))) {
+            if (load_ondemand_repodata(repo::RepodataType::FILELISTS)) {
+                base->get_repo_sack()->internalize_repos();
+                addedfileprovides.clear();
+                addedfileprovides_inst.clear();
+                pool_addfileprovides_queue(
+                    *pool, &addedfileprovides.get_queue(), &addedfileprovides_inst.get_queue());
+            }
+            break;
+        }
+    }
+
     if (base->get_repo_sack()->has_system_repo() && !addedfileprovides_inst.empty()) {
         auto system_repo = base->get_repo_sack()->get_system_repo();
         // TODO(lukash) handle the existence of solv_repo in a unified manner?
@@ -120,31 +395,34 @@ void PackageSack::Impl::load_config_excludes_includes(bool only_main) {
         if (!disable_excludes.empty()) {
             rq.filter_id(disable_excludes, libdnf5::sack::QueryCmp::NOT_GLOB);
         }
+
+        // The same patterns are often configured for many repositories, each pattern is resolved
+        // once for all the repositories using it
+        std::map<std::string, std::vector<std::string>> repo_ids_by_include;
+        std::map<std::string, std::vector<std::string>> repo_ids_by_exclude;
         for (const auto & repo : rq) {
-            if (!repo->get_config().get_includepkgs_option().get_value().empty()) {
+            const auto & repo_includes = repo->get_config().get_includepkgs_option().get_value();
+            if (!repo_includes.empty()) {
                 repo->set_use_includes(true);
                 includes_used = true;
             }
+            for (const auto & name : repo_includes) {
+                repo_ids_by_include[name].push_back(repo->get_id());
+            }
+            for (const auto & name : repo->get_config().get_excludepkgs_option().get_value()) {
+                repo_ids_by_exclude[name].push_back(repo->get_id());
+            }
+        }
 
-            PackageQuery query_repo_pkgs(base, PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-            query_repo_pkgs.filter_repo_id({repo->get_id()});
-
-            for (const auto & name : repo->get_config().get_includepkgs_option().get_value()) {
-                PackageQuery query(query_repo_pkgs);
-                const auto & [found, nevra] = query.resolve_pkg_spec(name, resolve_settings, true);
-                if (found) {
-                    includes |= query;
-                    includes_exist = true;
-                }
+        for (auto & [name, repo_ids] : repo_ids_by_include) {
+            if (resolve_pkg_spec_in_repos(base, name, resolve_settings, std::move(repo_ids), includes)) {
+                includes_exist = true;
             }
+        }
 
-            for (const auto & name : repo->get_config().get_excludepkgs_option().get_value()) {
-                PackageQuery query(query_repo_pkgs);
-                const auto & [found, nevra] = query.resolve_pkg_spec(name, resolve_settings, true);
-                if (found) {
-                    excludes |= query;
-                    excludes_exist = true;
-                }
+        for (auto & [name, repo_ids] : repo_ids_by_exclude) {
+            if (resolve_pkg_spec_in_repos(base, name, resolve_settings, std::move(repo_ids), excludes)) {
+                excludes_exist = true;
             }
         }
     }
@@ -205,16 +483,16 @@ const PackageSet PackageSack::Impl::get_user_excludes() {
 void PackageSack::Impl::add_user_excludes(const PackageSet & excludes) {
     if (user_excludes) {
         *user_excludes |= *excludes.p_impl;
-        considered_uptodate = false;
     } else {
-        set_user_excludes(excludes);
+        user_excludes.reset(new libdnf5::solv::SolvMap(*excludes.p_impl));
     }
+    exclude_from_considered(*excludes.p_impl);
 }
 
 void PackageSack::Impl::remove_user_excludes(const PackageSet & excludes) {
     if (user_excludes) {
         *user_excludes -= *excludes.p_impl;
-        considered_uptodate = false;
+        unexclude_from_considered(*excludes.p_impl);
     }
 }
 
@@ -277,16 +555,16 @@ const PackageSet PackageSack::Impl::get_module_excludes() {
 void PackageSack::Impl::add_module_excludes(const PackageSet & excludes) {
     if (module_excludes) {
         *module_excludes |= *excludes.p_impl;
-        considered_uptodate = false;
     } else {
-        set_module_excludes(excludes);
+        module_excludes.reset(new libdnf5::solv::SolvMap(*excludes.p_impl));
     }
+    exclude_from_considered(*excludes.p_impl);
 }
 
 void PackageSack::Impl::remove_module_excludes(const PackageSet & excludes) {
     if (module_excludes) {
         *module_excludes -= *excludes.p_impl;
-        considered_uptodate = false;
+        unexclude_from_considered(*excludes.p_impl);
     }
 }
 
@@ -300,8 +578,90 @@ void PackageSack::Impl::clear_module_excludes() {
     considered_uptodate = false;
 }
 
-std::optional<libdnf5::solv::SolvMap> PackageSack::Impl::compute_considered_map(
-    libdnf5::sack::ExcludeFlags flags) const {
+const libdnf5::solv::SolvMap & PackageSack::Impl::get_no_includes_solvables() {
+    auto nsolvables = get_nsolvables();
+    std::vector<const repo::Repo *> no_includes_repos;
+    for (const auto & repo : base->get_repo_sack()->get_data()) {
+        // TODO(lukash) handle the existence of solv_repo in a unified manner?
+        if (!repo->get_use_includes() && repo->solv_repo) {
+            no_includes_repos.push_back(repo.get());
+        }
+    }
+    if (nsolvables == cached_no_includes_solvables_size && no_includes_repos == cached_no_includes_repos) {
+        return cached_no_includes_solvables;
+    }
+
+    cached_no_includes_solvables = libdnf5::solv::SolvMap(nsolvables);
+    for (const auto * repo : no_includes_repos) {
+        Id solvableid;
+        Solvable * solvable;
+        FOR_REPO_SOLVABLES(repo->solv_repo->repo, solvableid, solvable) {
+            cached_no_includes_solvables.add_unsafe(solvableid);
+        }
+    }
+    cached_no_includes_repos = std::move(no_includes_repos);
+    cached_no_includes_solvables_size = nsolvables;
+    return cached_no_includes_solvables;
+}
+
+void PackageSack::Impl::exclude_from_considered(const libdnf5::solv::SolvMap & excludes) {
+    if (!considered_uptodate) {
+        return;
+    }
+    auto & pool = get_rpm_pool(base);
+    libdnf5::solv::SolvMap considered(0);
+    if (pool.is_considered_map_active()) {
+        if (pool.get_considered_map().allocated_size() < pool.get_nsolvables()) {
+            // the pool has grown since the map was computed
+            considered_uptodate = false;
+            return;
+        }
+        pool.swap_considered_map(considered);
+    } else {
+        // nothing was excluded so far
+        considered = libdnf5::solv::SolvMap(pool.get_nsolvables());
+        considered.set_all();
+    }
+    considered -= excludes;
+    pool.swap_considered_map(considered);
+}
+
+void PackageSack::Impl::unexclude_from_considered(const libdnf5::solv::SolvMap & unexcluded) {
+    if (!considered_uptodate) {
+        return;
+    }
+    auto & pool = get_rpm_pool(base);
+    if (!pool.is_considered_map_active() || pool.get_considered_map().allocated_size() < pool.get_nsolvables()) {
+        considered_uptodate = false;
+        return;
+    }
+
+    // Only the unexcluded packages which are not excluded by another exclude set and are included
+    // can become considered again.
+    libdnf5::solv::SolvMap returned(unexcluded);
+    for (const auto * other_excludes : {&module_excludes, &repo_excludes, &config_excludes, &user_excludes}) {
+        if (*other_excludes) {
+            returned -= **other_excludes;
+        }
+    }
+    if (config_includes || user_includes) {
+        libdnf5::solv::SolvMap included(get_no_includes_solvables());
+        if (config_includes) {
+            included |= *config_includes;
+        }
+        if (user_includes) {
+            included |= *user_includes;
+        }
+        returned &= included;
+    }
+
+    libdnf5::solv::SolvMap considered(0);
+    pool.swap_considered_map(considered);
+    considered |= returned;
+    pool.swap_considered_map(considered);
+}
+
+std::optional<libdnf5::solv::SolvMap> PackageSack::Impl::compute_considered_map(libdnf5::sack::ExcludeFlags flags) {
     if ((static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_CONFIG_EXCLUDES) ||
          (!config_excludes && !config_includes)) &&
         (static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_USER_EXCLUDES) ||
@@ -351,22 +711,10 @@ std::optional<libdnf5::solv::SolvMap> PackageSack::Impl::compute_considered_map(
         }
 
         if (pkg_includes) {
-            pkg_includes->grow(pool.get_nsolvables());
-            libdnf5::solv::SolvMap pkg_includes_tmp(*pkg_includes);
-
             // Add all solvables from repositories which do not use "includes"
-            for (const auto & repo : base->get_repo_sack()->get_data()) {
-                // TODO(lukash) handle the existence of solv_repo in a unified manner?
-                if (!repo->get_use_includes() && repo->solv_repo) {
-                    Id solvableid;
-                    Solvable * solvable;
-                    FOR_REPO_SOLVABLES(repo->solv_repo->repo, solvableid, solvable) {
-                        pkg_includes_tmp.add_unsafe(solvableid);
-                    }
-                }
-            }
+            *pkg_includes |= get_no_includes_solvables();
 
-            considered &= pkg_includes_tmp;
+            considered &= *pkg_includes;
         }
     }
 
@@ -389,6 +737,32 @@ void PackageSack::Impl::recompute_considered_in_pool() {
     considered_uptodate = true;
 }
 
+void PackageSack::Impl::make_indexes_ready() {
+    make_provides_ready();
+    recompute_considered_in_pool();
+    get_solvables();
+    get_sorted_solvables();
+    get_sorted_icase_solvables();
+    get_name_trigram_index();
+    // Requesting as many uses as the build thresholds forces building of the file index and the EVR ranks
+    get_file_index(2);
+    get_evr_ranks(static_cast<std::size_t>(get_nsolvables()));
+}
+
+std::size_t PackageSack::Impl::get_caches_memory_usage() const noexcept {
+    std::size_t size = cached_sorted_solvables.capacity() * sizeof(Solvable *);
+    size += cached_sorted_icase_solvables.capacity() * sizeof(std::pair<Id, Solvable *>);
+    size += static_cast<std::size_t>(cached_solvables.allocated_size() / 8);
+    size += static_cast<std::size_t>(cached_no_includes_solvables.allocated_size() / 8);
+    size += cached_file_index.capacity() * sizeof(std::pair<uint32_t, Id>);
+    size += cached_evr_ranks.capacity() * sizeof(int);
+    size += cached_name_trigram_index.bucket_count() * sizeof(void *);
+    for (const auto & [trigram, name_ids] : cached_name_trigram_index) {
+        size += sizeof(std::pair<const uint32_t, std::vector<Id>>) + name_ids.capacity() * sizeof(Id);
+    }
+    return size;
+}
+
 PackageSackWeakPtr PackageSack::get_weak_ptr() {
     return PackageSackWeakPtr(this, &p_impl->sack_guard);
 }
@@ -451,14 +825,28 @@ void PackageSack::clear_user_includes() {
     p_impl->clear_user_includes();
 }
 
-static libdnf5::rpm::PackageQuery running_kernel_check_path(const libdnf5::BaseWeakPtr & base, const std::string & fn) {
+// Returns installed packages which likely own the running kernel. The kernel release reported by uname is usually
+// "<version>-<release>.<arch>" of the kernel package, the file lists of the packages with a matching version and
+// release are checked first.
+static libdnf5::rpm::PackageQuery running_kernel_candidates(
+    const libdnf5::rpm::PackageQuery & installed, std::string_view kernel_release) {
+    libdnf5::rpm::PackageQuery candidates(
+        installed.get_base(), libdnf5::rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES, true);
+    for (const auto & pkg : installed) {
+        if (kernel_release.starts_with(pkg.get_version() + '-' + pkg.get_release())) {
+            candidates.add(pkg);
+        }
+    }
+    return candidates;
+}
+
+static libdnf5::rpm::PackageQuery running_kernel_check_path(
+    const libdnf5::BaseWeakPtr & base, const libdnf5::rpm::PackageQuery & candidates, const std::string & fn) {
     auto & logger = *base->get_logger();
     if (access(fn.c_str(), F_OK)) {
         logger.debug("Cannot find \"{}\" to verify running kernel", fn);
     }
-    libdnf5::rpm::PackageQuery q(base, libdnf5::rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-
-    q.filter_installed();
+    libdnf5::rpm::PackageQuery q(candidates);
     q.filter_file({fn});
     return q;
 }
@@ -477,16 +865,24 @@ rpm::PackageId PackageSack::Impl::get_running_kernel_id() {
         return running_kernel;
     }
 
-    std::string fn("/boot/vmlinuz-");
-    auto un_release = un.release;
-    fn.append(un_release);
-    auto query = running_kernel_check_path(base, fn);
-
-    if (query.empty()) {
-        fn.clear();
-        fn.append("/lib/modules/");
-        fn.append(un_release);
-        query = running_kernel_check_path(base, fn);
+    std::string un_release = un.release;
+    auto find_kernel = [&](const libdnf5::rpm::PackageQuery & candidates) {
+        auto query = running_kernel_check_path(base, candidates, "/boot/vmlinuz-" + un_release);
+        if (query.empty()) {
+            query = running_kernel_check_path(base, candidates, "/lib/modules/" + un_release);
+        }
+        return query;
+    };
+
+    libdnf5::rpm::PackageQuery installed(base, libdnf5::rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
+    installed.filter_installed();
+    auto candidates = running_kernel_candidates(installed, un_release);
+    auto query = find_kernel(candidates.empty() ? installed : candidates);
+
+    // None of the matching packages owns the kernel files (e.g. a custom kernel with a release that happens
+    // to match another package), search the file lists of all installed packages
+    if (query.empty() && !candidates.empty()) {
+        query = find_kernel(installed);
     }
 
     if (query.empty()) {
@@ -504,4 +900,8 @@ rpm::Package PackageSack::get_running_kernel() {
     return rpm::Package(p_impl->base, p_impl->get_running_kernel_id());
 }
 
+void PackageSack::make_indexes_ready() {
+    p_impl->make_indexes_ready();
+}
+
 }  // namespace libdnf5::rpm
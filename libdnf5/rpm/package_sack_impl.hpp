@@ -32,7 +32,12 @@ extern "C" {
 #include <solv/pool.h>
 }
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
@@ -46,6 +51,31 @@ static inline bool nevra_solvable_cmp_key(const Solvable * first, const Solvable
     return first->evr < second->evr;
 }
 
+/// Returns the case insensitive trigram of the first three characters of `str`.
+static inline uint32_t name_trigram(const char * str) {
+    auto lower = [](char c) -> uint32_t {
+        return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+    };
+    return lower(str[0]) << 16 | lower(str[1]) << 8 | lower(str[2]);
+}
+
+/// Returns the 32-bit FNV-1a hash of the file path used as the key of the file index.
+static inline uint32_t file_path_hash(std::string_view path) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : path) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+/// Returns the pointer to the same solvable in the array of solvables `new_base`.
+/// The pool reallocates its array of solvables when new solvables are added.
+static inline Solvable * rebase_solvable(Solvable * solvable, const Solvable * old_base, Solvable * new_base) {
+    auto offset = (reinterpret_cast<std::uintptr_t>(solvable) - reinterpret_cast<std::uintptr_t>(old_base)) /
+                  sizeof(Solvable);
+    return new_base + offset;
+}
+
 static inline bool nevra_solvable_cmp_icase_key(
     const std::pair<Id, Solvable *> & first, const std::pair<Id, Solvable *> & second) {
     if (first.first != second.first) {
@@ -58,6 +88,11 @@ static inline bool nevra_solvable_cmp_icase_key(
     return first.second->evr < second.second->evr;
 }
 
+namespace libdnf5::repo {
+enum class RepodataType;
+}
+
+
 namespace libdnf5::rpm {
 
 class PackageSack::Impl {
@@ -76,10 +111,58 @@ public:
     /// Return sorted list of all package solvables in format pair<id_of_lowercase_name, Solvable *>
     std::vector<std::pair<Id, Solvable *>> & get_sorted_icase_solvables();
 
+    /// Return trigram index of package names. Maps each case insensitive trigram (see `name_trigram()`)
+    /// of package names to the sorted list of ids of the names containing it.
+    const std::unordered_map<uint32_t, std::vector<Id>> & get_name_trigram_index();
+
+    /// Return index of package files in format pair<file_path_hash(path), solvable_id> sorted by the hash.
+    /// Different paths can have the same hash, the found packages must be verified.
+    ///
+    /// Building the index costs more than a single lookup in the filelists. It is therefore built only once
+    /// the total number of requested lookups reaches two, until then `nullptr` is returned.
+    /// @param lookups Number of the file lookups the caller is going to make using the index.
+    const std::vector<std::pair<uint32_t, Id>> * get_file_index(std::size_t lookups);
+
+    /// Return ranks of the package EVRs indexed by solvable id. The ranks of packages with the same name and
+    /// architecture compare the same way as their EVRs using `evrcmp`, equal EVRs have equal ranks. Ranks of
+    /// packages with a different name or architecture are not comparable.
+    ///
+    /// Like the file index, the ranks are only computed once the total number of requested comparisons reaches
+    /// the number of solvables. Until then `nullptr` is returned and the caller compares the EVRs directly.
+    /// @param comparisons Number of the packages the caller is going to compare using the ranks.
+    const std::vector<int> * get_evr_ranks(std::size_t comparisons);
+
+    /// Return index of package obsoletes in format pair<name_id, solvable_id> sorted by the name id. The name is
+    /// the name of the obsoleted package, obsoletes that can match packages of several names (rich dependencies,
+    /// nested relations) are stored under the name id 0. Each package is listed once per name.
+    ///
+    /// Like the file index, the index is only built once the total number of requested lookups reaches two,
+    /// until then `nullptr` is returned.
+    /// @param lookups Number of the obsoletes lookups the caller is going to make using the index.
+    const std::vector<std::pair<Id, Id>> * get_obsoletes_index(std::size_t lookups);
+
+    /// Drops the file index, it has to be called when file lists are added to the already loaded packages.
+    void invalidate_file_index() {
+        cached_file_index.clear();
+        cached_file_index.shrink_to_fit();
+        cached_file_index_size = -1;
+    }
+
     void make_provides_ready();
 
     void invalidate_provides() { provides_ready = false; }
 
+    /// Loads additional metadata of the `type` that were postponed by the "ondemand_metadata_types" configuration
+    /// option in the repository `repo`. Metadata that are not in the "optional_metadata_types" are downloaded first.
+    /// @param download Whether to download the metadata if they were not downloaded yet.
+    /// @return `true` if any metadata were loaded.
+    bool load_ondemand_repodata(repo::Repo & repo, repo::RepodataType type, bool download = true);
+
+    /// Loads additional metadata of the `type` that were postponed by the "ondemand_metadata_types" configuration
+    /// option in all loaded repositories. Missing metadata of several repositories are downloaded in parallel.
+    /// @return `true` if any metadata were loaded.
+    bool load_ondemand_repodata(repo::RepodataType type);
+
     PackageId get_running_kernel_id();
 
     /// Sets excluded and included packages according to the configuration.
@@ -111,13 +194,32 @@ public:
 
     /// Computes considered map.
     /// If there are no excluded packages, the considered map may not be present in the return value.
-    std::optional<libdnf5::solv::SolvMap> compute_considered_map(libdnf5::sack::ExcludeFlags flags) const;
+    std::optional<libdnf5::solv::SolvMap> compute_considered_map(libdnf5::sack::ExcludeFlags flags);
 
     /// If the considered map in the pool is out of date - `considered_uptodate == false` - it will recompute it.
     /// And sets `considered_uptodate` to` true`.
     void recompute_considered_in_pool();
 
+    /// Computes all the lazily built state used by the queries: the provides, the considered map in the pool,
+    /// the sorted solvables, and the name, file and EVR indexes.
+    void make_indexes_ready();
+
+    /// Returns the approximate number of bytes allocated by the cached sorted solvables and indexes.
+    std::size_t get_caches_memory_usage() const noexcept;
+
 private:
+    /// Return SolvMap with the solvables of the repositories which do not use includes.
+    const libdnf5::solv::SolvMap & get_no_includes_solvables();
+
+    /// Removes newly excluded packages from the up to date considered map in the pool instead of
+    /// recomputing it. Marks the map out of date if it cannot be updated in place.
+    void exclude_from_considered(const libdnf5::solv::SolvMap & excludes);
+
+    /// Returns the packages no longer excluded by one of the exclude sets to the up to date considered map
+    /// in the pool, unless other exclude sets or includes still leave them out. Marks the map out of date
+    /// if it cannot be updated in place.
+    void unexclude_from_considered(const libdnf5::solv::SolvMap & unexcluded);
+
     bool provides_ready{false};
 
     BaseWeakPtr base;
@@ -141,11 +243,27 @@ private:
 
     std::vector<Solvable *> cached_sorted_solvables;
     int cached_sorted_solvables_size{0};
+    const Solvable * cached_sorted_solvables_base{nullptr};
     /// pair<id_of_lowercase_name, Solvable *>
     std::vector<std::pair<Id, Solvable *>> cached_sorted_icase_solvables;
     int cached_sorted_icase_solvables_size{0};
+    const Solvable * cached_sorted_icase_solvables_base{nullptr};
     libdnf5::solv::SolvMap cached_solvables{0};
     int cached_solvables_size{0};
+    std::unordered_map<uint32_t, std::vector<Id>> cached_name_trigram_index;
+    int cached_name_trigram_index_size{0};
+    std::vector<std::pair<uint32_t, Id>> cached_file_index;
+    int cached_file_index_size{-1};
+    std::size_t file_index_lookups{0};
+    std::vector<std::pair<Id, Id>> cached_obsoletes_index;
+    int cached_obsoletes_index_size{-1};
+    std::size_t obsoletes_index_lookups{0};
+    std::vector<int> cached_evr_ranks;
+    int cached_evr_ranks_size{-1};
+    std::size_t evr_ranks_comparisons{0};
+    libdnf5::solv::SolvMap cached_no_includes_solvables{0};
+    std::vector<const repo::Repo *> cached_no_includes_repos;
+    int cached_no_includes_solvables_size{-1};
     PackageId running_kernel;
 
     friend PackageSack;
@@ -163,13 +281,28 @@ inline std::vector<Solvable *> & PackageSack::Impl::get_sorted_solvables() {
         return cached_sorted_solvables;
     }
     auto & solvables_map = get_solvables();
-    cached_sorted_solvables.clear();
-    cached_sorted_solvables.reserve(static_cast<size_t>(nsolvables));
     auto & pool = get_rpm_pool(base);
-    for (Id id : solvables_map) {
-        cached_sorted_solvables.push_back(pool.id2solvable(id));
+    if (nsolvables < cached_sorted_solvables_size) {
+        cached_sorted_solvables.clear();
+        cached_sorted_solvables_size = 0;
+    }
+
+    // Usually the pool only grows by new repositories or packages. Only the new solvables are sorted
+    // and merged with the already sorted ones.
+    if (cached_sorted_solvables_base != pool->solvables) {
+        for (auto & solvable : cached_sorted_solvables) {
+            solvable = rebase_solvable(solvable, cached_sorted_solvables_base, pool->solvables);
+        }
+        cached_sorted_solvables_base = pool->solvables;
+    }
+    auto sorted_count = cached_sorted_solvables.size();
+    auto it = solvables_map.begin();
+    for (it.jump(cached_sorted_solvables_size); it != solvables_map.end(); ++it) {
+        cached_sorted_solvables.push_back(pool.id2solvable(*it));
     }
-    std::sort(cached_sorted_solvables.begin(), cached_sorted_solvables.end(), nevra_solvable_cmp_key);
+    auto middle = cached_sorted_solvables.begin() + static_cast<std::ptrdiff_t>(sorted_count);
+    std::sort(middle, cached_sorted_solvables.end(), nevra_solvable_cmp_key);
+    std::inplace_merge(cached_sorted_solvables.begin(), middle, cached_sorted_solvables.end(), nevra_solvable_cmp_key);
     cached_sorted_solvables_size = nsolvables;
     return cached_sorted_solvables;
 }
@@ -180,19 +313,68 @@ inline std::vector<std::pair<Id, Solvable *>> & PackageSack::Impl::get_sorted_ic
     if (nsolvables == cached_sorted_icase_solvables_size) {
         return cached_sorted_icase_solvables;
     }
+    auto & solvables_map = get_solvables();
+    if (nsolvables < cached_sorted_icase_solvables_size) {
+        cached_sorted_icase_solvables.clear();
+        cached_sorted_icase_solvables_size = 0;
+    }
+
+    // Only the new solvables are sorted and merged with the already sorted ones, see `get_sorted_solvables()`
+    if (cached_sorted_icase_solvables_base != pool->solvables) {
+        for (auto & item : cached_sorted_icase_solvables) {
+            item.second = rebase_solvable(item.second, cached_sorted_icase_solvables_base, pool->solvables);
+        }
+        cached_sorted_icase_solvables_base = pool->solvables;
+    }
+    auto sorted_count = cached_sorted_icase_solvables.size();
     Id name = 0;
     Id icase_name = 0;
-    for (auto * solvable : get_sorted_solvables()) {
+    auto it = solvables_map.begin();
+    for (it.jump(cached_sorted_icase_solvables_size); it != solvables_map.end(); ++it) {
+        auto * solvable = pool.id2solvable(*it);
         if (solvable->name != name) {
-            icase_name = pool.id_to_lowercase_id(solvable->name, 1);
+            name = solvable->name;
+            icase_name = pool.id_to_lowercase_id(name, 1);
         }
-        cached_sorted_icase_solvables.emplace_back(std::make_pair(icase_name, solvable));
+        cached_sorted_icase_solvables.emplace_back(icase_name, solvable);
     }
-    std::sort(cached_sorted_icase_solvables.begin(), cached_sorted_icase_solvables.end(), nevra_solvable_cmp_icase_key);
+    auto middle = cached_sorted_icase_solvables.begin() + static_cast<std::ptrdiff_t>(sorted_count);
+    std::sort(middle, cached_sorted_icase_solvables.end(), nevra_solvable_cmp_icase_key);
+    std::inplace_merge(
+        cached_sorted_icase_solvables.begin(),
+        middle,
+        cached_sorted_icase_solvables.end(),
+        nevra_solvable_cmp_icase_key);
     cached_sorted_icase_solvables_size = nsolvables;
     return cached_sorted_icase_solvables;
 }
 
+inline const std::unordered_map<uint32_t, std::vector<Id>> & PackageSack::Impl::get_name_trigram_index() {
+    auto nsolvables = get_nsolvables();
+    if (nsolvables == cached_name_trigram_index_size) {
+        return cached_name_trigram_index;
+    }
+    cached_name_trigram_index.clear();
+    auto & pool = get_rpm_pool(base);
+    Id name = 0;
+    // solvables are sorted by name ids, so the lists of names are sorted too
+    for (auto * solvable : get_sorted_solvables()) {
+        if (solvable->name == name) {
+            continue;
+        }
+        name = solvable->name;
+        const char * name_str = pool.id2str(name);
+        for (std::size_t i = 0; name_str[i] != '\0' && name_str[i + 1] != '\0' && name_str[i + 2] != '\0'; ++i) {
+            auto & names = cached_name_trigram_index[name_trigram(name_str + i)];
+            if (names.empty() || names.back() != name) {
+                names.push_back(name);
+            }
+        }
+    }
+    cached_name_trigram_index_size = nsolvables;
+    return cached_name_trigram_index;
+}
+
 inline libdnf5::solv::SolvMap & PackageSack::Impl::get_solvables() {
     auto & spool = get_rpm_pool(base);
     ::Pool * pool = *spool;
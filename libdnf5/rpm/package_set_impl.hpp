@@ -56,6 +56,7 @@ public:
 
 private:
     friend PackageSet;
+    friend PackageSetIterator;
     friend PackageQuery;
 
     BaseWeakPtr base;
@@ -80,7 +80,9 @@ void PackageSetIterator::end() {
 
 
 Package PackageSetIterator::operator*() {
-    return {p_impl->package_set->get_base(), libdnf5::rpm::PackageId(**p_impl)};
+    // Use the set's weak pointer directly, PackageSet::get_base() returns a copy which needs to be registered
+    // in and unregistered from the Base's guard for every dereferenced package
+    return {p_impl->package_set->p_impl->base, libdnf5::rpm::PackageId(**p_impl)};
 }
 
 
@@ -86,12 +86,20 @@ ReldepId Reldep::get_reldep_id(
 }
 
 ReldepId Reldep::get_reldep_id(const BaseWeakPtr & base, const std::string & reldep_str, int create) {
+    // The same dependency strings are resolved repeatedly (protected packages, provides in specs),
+    // parse each of them only once
+    auto & pool = get_rpm_pool(base);
+    if (Id cached_id = pool.get_cached_reldep_id(reldep_str)) {
+        return ReldepId(cached_id);
+    }
+
     if (is_rich_dependency(reldep_str)) {
-        Id id = pool_parserpmrichdep(*get_rpm_pool(base), reldep_str.c_str());
+        Id id = pool_parserpmrichdep(*pool, reldep_str.c_str());
         // TODO(jmracek) Replace runtime_error. Do we need to throw an error?
         if (id == 0) {
             throw RuntimeError(M_("Cannot parse a dependency string"));
         }
+        pool.cache_reldep_id(reldep_str, id);
         return ReldepId(id);
     }
 
@@ -99,8 +107,13 @@ ReldepId Reldep::get_reldep_id(const BaseWeakPtr & base, const std::string & rel
     if (!dep_splitter.parse(reldep_str)) {
         throw RuntimeError(M_("Cannot parse a dependency string"));
     }
-    return get_reldep_id(
+    auto reldep_id = get_reldep_id(
         base, dep_splitter.get_name_cstr(), dep_splitter.get_evr_cstr(), dep_splitter.get_cmp_type(), create);
+    // a dependency that was not found in the pool can be created later, only found ids are cached
+    if (reldep_id.id != 0) {
+        pool.cache_reldep_id(reldep_str, reldep_id.id);
+    }
+    return reldep_id;
 }
 
 }  // namespace libdnf5::rpm
@@ -20,6 +20,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/rpm/rpm_signature.hpp"
 
 #include "repo/repo_pgp.hpp"
+#include "rpm/rpm_signature_private.hpp"
 #include "rpm/rpm_log_guard.hpp"
 #include "utils/string.hpp"
 #include "utils/url.hpp"
@@ -104,19 +105,109 @@ std::string KeyInfo::get_short_key_id() const {
     return short_key_id;
 }
 
-RpmSignature::CheckResult RpmSignature::check_package_signature(rpm::Package pkg) const {
-    // is package gpg check even required?
+static bool is_gpgcheck_enabled(const BaseWeakPtr & base, const rpm::Package & pkg) {
     auto repo = pkg.get_repo();
     if (repo->get_type() == libdnf5::repo::Repo::Type::COMMANDLINE) {
-        if (!base->get_config().get_localpkg_gpgcheck_option().get_value()) {
-            return CheckResult::SKIPPED;
+        return base->get_config().get_localpkg_gpgcheck_option().get_value();
+    }
+    return repo->get_config().get_gpgcheck_option().get_value();
+}
+
+// This is brittle and heavily depends on rpm not changing log messages.
+// Here is an example of log messages after verifying a signed package
+// but without public key present in rpmdb:
+//   /path/to/rpm/dummy-signed-1.0.1-0.x86_64.rpm:
+//       Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY
+//       Header RSA signature: NOTFOUND
+//       Header SHA256 digest: OK
+//       Header SHA1 digest: OK
+//       Payload SHA256 digest: OK
+//       RSA signature: NOTFOUND
+//       DSA signature: NOTFOUND
+//       MD5 digest: OK
+// The files are verified in the given order and the messages of each of them
+// start with a line beginning with its path.
+std::vector<RpmSignature::CheckResult> parse_verification_logs(
+    const std::vector<std::string> & rpm_logs, const std::vector<std::string> & paths) {
+    struct FileState {
+        bool failed{false};
+        bool missing_key{false};
+        bool not_trusted{false};
+        bool not_signed{false};
+        bool verified{false};
+    };
+    std::vector<FileState> states(paths.size());
+
+    size_t current = 0;
+    for (const auto & line : rpm_logs) {
+        std::string_view line_v{line};
+        if (current + 1 < paths.size() && line_v.starts_with(paths[current + 1])) {
+            ++current;
         }
-    } else {
-        auto & repo_config = repo->get_config();
-        if (!repo_config.get_gpgcheck_option().get_value()) {
-            return CheckResult::SKIPPED;
+        auto & state = states[current];
+        if (line_v.starts_with(paths[current])) {
+            // "<path>: <message>" lines are errors, e.g. the file could not be opened
+            if (line_v.substr(paths[current].size()).starts_with(": ")) {
+                state.failed = true;
+            }
+            continue;
+        }
+        if (line.find(": BAD") != std::string::npos) {
+            state.failed = true;
+        } else if (line_v.ends_with(": NOKEY")) {
+            state.missing_key = true;
+        } else if (line_v.ends_with(": NOTTRUSTED")) {
+            state.not_trusted = true;
+        } else if (line_v.ends_with(": NOTFOUND")) {
+            state.not_signed = true;
+        } else if (line_v.ends_with(": OK")) {
+            state.verified = true;
+        } else {
+            state.failed = true;
+        }
+    }
+
+    std::vector<RpmSignature::CheckResult> results;
+    results.reserve(states.size());
+    for (const auto & state : states) {
+        // A bad digest or signature makes the package broken regardless of the keys, importing a key would not help
+        if (state.failed) {
+            results.push_back(RpmSignature::CheckResult::FAILED);
+        } else if (state.not_trusted) {
+            results.push_back(RpmSignature::CheckResult::FAILED_NOT_TRUSTED);
+        } else if (state.missing_key) {
+            results.push_back(RpmSignature::CheckResult::FAILED_KEY_MISSING);
+        } else if (state.not_signed) {
+            results.push_back(RpmSignature::CheckResult::FAILED_NOT_SIGNED);
+        } else if (!state.verified) {
+            results.push_back(RpmSignature::CheckResult::FAILED);
+        } else {
+            results.push_back(RpmSignature::CheckResult::OK);
+        }
+    }
+    return results;
+}
+
+RpmSignature::CheckResult RpmSignature::check_package_signature(rpm::Package pkg) const {
+    return check_package_signatures({pkg}).front();
+}
+
+std::vector<RpmSignature::CheckResult> RpmSignature::check_package_signatures(
+    const std::vector<Package> & packages) const {
+    std::vector<CheckResult> results(packages.size(), CheckResult::SKIPPED);
+
+    // is package gpg check even required?
+    std::vector<size_t> checked_indexes;
+    std::vector<std::string> paths;
+    for (size_t idx = 0; idx < packages.size(); ++idx) {
+        if (is_gpgcheck_enabled(base, packages[idx])) {
+            checked_indexes.push_back(idx);
+            paths.push_back(packages[idx].get_package_path());
         }
     }
+    if (paths.empty()) {
+        return results;
+    }
 
     // rpmcliVerifySignatures is the only API rpm provides for signature verification.
     // Unfortunatelly to distinguish key_missing/not_signed/verification_failed cases
@@ -129,61 +220,33 @@ RpmSignature::CheckResult RpmSignature::check_package_signature(rpm::Package pkg
     // the vector of strings.
     libdnf5::rpm::RpmLogGuardStrings rpm_log_guard;
 
+    // All the files are verified within a single rpm transaction, the keyring is loaded only once.
     auto ts_ptr = create_transaction(base);
     auto oldmask = rpmlogSetMask(RPMLOG_UPTO(RPMLOG_PRI(RPMLOG_INFO)));
 
     rpmtsSetVfyLevel(ts_ptr.get(), RPMSIG_SIGNATURE_TYPE);
-    std::string path = pkg.get_package_path();
-    char * const path_array[2] = {&path[0], NULL};
-    auto rc = rpmcliVerifySignatures(ts_ptr.get(), path_array);
+    std::vector<char *> path_array;
+    path_array.reserve(paths.size() + 1);
+    for (auto & path : paths) {
+        path_array.push_back(path.data());
+    }
+    path_array.push_back(nullptr);
+    auto rc = rpmcliVerifySignatures(ts_ptr.get(), path_array.data());
 
     rpmlogSetMask(oldmask);
 
     if (rc == RPMRC_OK) {
-        return CheckResult::OK;
-    }
-
-    // This is brittle and heavily depends on rpm not changing log messages.
-    // Here is an example of log messages after verifying a signed package
-    // but without public key present in rpmdb:
-    //   /path/to/rpm/dummy-signed-1.0.1-0.x86_64.rpm:
-    //       Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY
-    //       Header RSA signature: NOTFOUND
-    //       Header SHA256 digest: OK
-    //       Header SHA1 digest: OK
-    //       Payload SHA256 digest: OK
-    //       RSA signature: NOTFOUND
-    //       DSA signature: NOTFOUND
-    //       MD5 digest: OK
-    bool missing_key{false};
-    bool not_trusted{false};
-    bool not_signed{false};
-    for (const auto & line : rpm_log_guard.get_rpm_logs()) {
-        std::string_view line_v{line};
-        if (line_v.starts_with(path)) {
-            continue;
-        }
-        if (line.find(": BAD") != std::string::npos) {
-            return CheckResult::FAILED;
-        }
-        if (line_v.ends_with(": NOKEY")) {
-            missing_key = true;
-        } else if (line_v.ends_with(": NOTTRUSTED")) {
-            not_trusted = true;
-        } else if (line_v.ends_with(": NOTFOUND")) {
-            not_signed = true;
-        } else if (!line_v.ends_with(": OK")) {
-            return CheckResult::FAILED;
+        for (auto idx : checked_indexes) {
+            results[idx] = CheckResult::OK;
         }
+        return results;
     }
-    if (not_trusted) {
-        return CheckResult::FAILED_NOT_TRUSTED;
-    } else if (missing_key) {
-        return CheckResult::FAILED_KEY_MISSING;
-    } else if (not_signed) {
-        return CheckResult::FAILED_NOT_SIGNED;
+
+    auto file_results = parse_verification_logs(rpm_log_guard.get_rpm_logs(), paths);
+    for (size_t i = 0; i < checked_indexes.size(); ++i) {
+        results[checked_indexes[i]] = file_results[i];
     }
-    return CheckResult::FAILED;
+    return results;
 }
 
 bool RpmSignature::key_present(const KeyInfo & key) const {
@@ -233,7 +296,7 @@ std::vector<KeyInfo> RpmSignature::parse_key_file(const std::string & key_url) {
 
     std::vector<KeyInfo> keys;
     utils::fs::File key_file(key_path, "r");
-    for (auto & key_info : repo::RepoPgp::rawkey2infos(key_file.get_fd(), key_url, key_path)) {
+    for (auto & key_info : repo::RepoPgp::rawkey2infos(base, key_file.get_fd(), key_url, key_path)) {
         keys.emplace_back(key_info);
     }
 
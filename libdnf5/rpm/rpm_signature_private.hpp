@@ -0,0 +1,38 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBDNF5_RPM_RPM_SIGNATURE_PRIVATE_HPP
+#define LIBDNF5_RPM_RPM_SIGNATURE_PRIVATE_HPP
+
+#include "libdnf5/rpm/rpm_signature.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace libdnf5::rpm {
+
+/// Returns the results of the signature check of the files in `paths` parsed from the `rpm_logs` collected
+/// while rpmcliVerifySignatures() verified them in the given order.
+std::vector<RpmSignature::CheckResult> parse_verification_logs(
+    const std::vector<std::string> & rpm_logs, const std::vector<std::string> & paths);
+
+}  // namespace libdnf5::rpm
+
+#endif  // LIBDNF5_RPM_RPM_SIGNATURE_PRIVATE_HPP
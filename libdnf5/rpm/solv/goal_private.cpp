@@ -19,8 +19,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "goal_private.hpp"
 
+#include "base/base_impl.hpp"
 #include "rpm/package_sack_impl.hpp"
 #include "solv/pool.hpp"
+#include "solver_cache.hpp"
 
 #include "libdnf5/common/exception.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
@@ -30,6 +32,9 @@ extern "C" {
 #include <solv/testcase.h>
 }
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 
 
@@ -139,53 +144,61 @@ static void same_name_subqueue(libdnf5::solv::RpmPool & pool, Queue * in, Queue
 }
 
 
-struct InstallonlyCmpData {
-    libdnf5::solv::RpmPool & pool;
-    Id running_kernel;
-};
-
 struct ObsoleteCmpData {
     libdnf5::solv::RpmPool & pool;
     Id obsolete;
 };
 
-int installonly_cmp(const Id * ap, const Id * bp, const InstallonlyCmpData * s_cb) {
-    Id a = *ap;
-    Id b = *bp;
-    auto & pool = s_cb->pool;
-    Id kernel = s_cb->running_kernel;
-    Solvable * sa = pool.id2solvable(a);
-    Solvable * sb = pool.id2solvable(b);
-
-    // if the names are different sort them differently, particular order does not matter as long as it's consistent.
-    int name_diff = sa->name - sb->name;
-    if (name_diff)
-        return name_diff;
+// Position of an installonly package among the packages of the same name, the packages with a higher rank
+// are kept first by limit_installonly_packages().
+enum class InstallonlyRank { INSTALLED, SAME_EVR_AS_RUNNING_KERNEL, RUNNING_KERNEL, AVAILABLE };
 
-    // same name, if one is/depends on the running kernel put it last
+struct InstallonlyCandidate {
+    Id id;
+    Id name;
+    Id evr;
+    InstallonlyRank rank;
+};
 
-    // move available packages to end of the list
-    if (pool->installed != sa->repo)
-        return 1;
+// Sorts installonly packages by name, then by rank and version in ascending order. The rank, which checks
+// the dependencies on the running kernel, is computed once per package instead of in every comparison.
+void sort_installonly_candidates(libdnf5::solv::RpmPool & pool, libdnf5::solv::IdQueue & ids, Id running_kernel) {
+    std::vector<InstallonlyCandidate> candidates;
+    candidates.reserve(static_cast<std::size_t>(ids.size()));
+    for (int i = 0; i < ids.size(); ++i) {
+        Id id = ids[i];
+        Solvable * solvable = pool.id2solvable(id);
+        auto rank = InstallonlyRank::INSTALLED;
+        if (!pool.is_installed(solvable)) {
+            rank = InstallonlyRank::AVAILABLE;
+        } else if (running_kernel >= 0) {
+            if (id == running_kernel || can_depend_on(*pool, solvable, running_kernel)) {
+                rank = InstallonlyRank::RUNNING_KERNEL;
+            } else if (solvable->evr == pool.id2solvable(running_kernel)->evr) {
+                // packages with the same evr as the running kernel are preferred (kernel-devel packages)
+                rank = InstallonlyRank::SAME_EVR_AS_RUNNING_KERNEL;
+            }
+        }
+        candidates.push_back({id, solvable->name, solvable->evr, rank});
+    }
 
-    if (pool->installed != sb->repo)
-        return -1;
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [&pool](const InstallonlyCandidate & first, const InstallonlyCandidate & second) {
+            if (first.name != second.name) {
+                return first.name < second.name;
+            }
+            if (first.rank != second.rank) {
+                return first.rank < second.rank;
+            }
+            return pool.evrcmp(first.evr, second.evr, EVRCMP_COMPARE) < 0;
+        });
 
-    if (kernel >= 0) {
-        if (a == kernel || can_depend_on(*pool, sa, kernel))
-            return 1;
-        if (b == kernel || can_depend_on(*pool, sb, kernel))
-            return -1;
-        // if package has same evr as kernel try them to keep (kernel-devel packages)
-        Solvable * kernelSolvable = pool.id2solvable(kernel);
-        if (sa->evr == kernelSolvable->evr) {
-            return 1;
-        }
-        if (sb->evr == kernelSolvable->evr) {
-            return -1;
-        }
+    ids.clear();
+    for (const auto & candidate : candidates) {
+        ids.push_back(candidate.id);
     }
-    return pool.evrcmp(sa->evr, sb->evr, EVRCMP_COMPARE);
 }
 
 int obsq_cmp(const Id * ap, const Id * bp, const ObsoleteCmpData * s_cb) {
@@ -285,8 +298,7 @@ bool GoalPrivate::limit_installonly_packages(libdnf5::solv::IdQueue & job, Id ru
             continue;
         }
 
-        const InstallonlyCmpData installonly_cmp_data{spool, running_kernel};
-        q.sort(&installonly_cmp, &installonly_cmp_data);
+        sort_installonly_candidates(spool, q, running_kernel);
         std::sort(available_unused_providers.begin(), available_unused_providers.end(), name_solvable_cmp_key);
 
         libdnf5::solv::IdQueue same_names;
@@ -385,7 +397,13 @@ libdnf5::GoalProblem GoalPrivate::resolve() {
         libsolv_transaction = NULL;
     }
 
-    init_solver(pool, libsolv_solver);
+    // Reuse a solver of an already resolved goal, libsolv resets its state at the beginning of every solve
+    if (!libsolv_solver.is_initialized()) {
+        InternalBaseUser::get_solver_cache(base).acquire_solver(libsolv_solver);
+    }
+    if (!libsolv_solver.is_initialized_for(pool)) {
+        init_solver(pool, libsolv_solver);
+    }
 
     // Remove SOLVER_WEAK and add SOLVER_BEST to all transactions to allow report skipped packages and best candidates
     // with broken dependenies
@@ -666,6 +684,17 @@ void GoalPrivate::reset_protected_packages() {
     protected_packages.reset();
 }
 
+void GoalPrivate::release_solver() {
+    if (!libsolv_solver.is_initialized()) {
+        return;
+    }
+    if (base.is_valid()) {
+        InternalBaseUser::get_solver_cache(base).release_solver(libsolv_solver);
+    } else {
+        libsolv_solver.reset();
+    }
+}
+
 void GoalPrivate::set_user_installed_packages(const libdnf5::solv::IdQueue & queue) {
     user_installed_packages.reset(new libdnf5::solv::IdQueue(queue));
 }
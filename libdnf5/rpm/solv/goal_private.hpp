@@ -52,7 +52,8 @@ public:
     /// Copy only inputs but not results from resolve()
     GoalPrivate & operator=(const GoalPrivate & src);
 
-    void set_installonly(const std::vector<std::string> & installonly_names);
+    /// Set ids of the installonly package names
+    void set_installonly(const libdnf5::solv::IdQueue & installonly_ids) { installonly = installonly_ids; };
     void set_installonly_limit(unsigned int limit) { installonly_limit = limit; };
 
     void add_install(libdnf5::solv::IdQueue & queue, bool skip_broken, bool best, bool clean_deps);
@@ -177,6 +178,9 @@ public:
     void add_exclude_from_weak(const libdnf5::solv::SolvMap & solvmap);
 
 private:
+    /// Return the solver to the solvers shared by the goals of the Base
+    void release_solver();
+
     bool limit_installonly_packages(libdnf5::solv::IdQueue & job, Id running_kernel);
 
     libdnf5::solv::IdQueue list_results(Id type_filter1, Id type_filter2);
@@ -259,6 +263,7 @@ inline GoalPrivate::~GoalPrivate() {
     if (libsolv_transaction) {
         transaction_free(libsolv_transaction);
     }
+    release_solver();
 }
 
 inline GoalPrivate & GoalPrivate::operator=(const GoalPrivate & src) {
@@ -267,13 +272,11 @@ inline GoalPrivate & GoalPrivate::operator=(const GoalPrivate & src) {
         staging = src.staging;
         installonly = src.installonly;
         installonly_limit = src.installonly_limit;
-        if (libsolv_solver.is_initialized()) {
-            libsolv_solver.reset();
-        }
         if (libsolv_transaction != nullptr) {
             transaction_free(libsolv_transaction);
             libsolv_transaction = nullptr;
         }
+        release_solver();
         protected_packages.reset(
             src.protected_packages ? new libdnf5::solv::SolvMap(*src.protected_packages) : nullptr);
         removal_of_protected.reset();
@@ -287,13 +290,6 @@ inline GoalPrivate & GoalPrivate::operator=(const GoalPrivate & src) {
     return *this;
 }
 
-inline void GoalPrivate::set_installonly(const std::vector<std::string> & installonly_names) {
-    auto & pool = get_rpm_pool();
-    for (auto & name : installonly_names) {
-        queue_pushunique(&installonly.get_queue(), pool.str2id(name.c_str(), 1));
-    }
-}
-
 inline void GoalPrivate::add_install(libdnf5::solv::IdQueue & queue, bool skip_broken, bool best, bool clean_deps) {
     // TODO dnf_sack_make_provides_ready(sack); When provides recomputed job musy be empty
     clean_deps_present = clean_deps_present || clean_deps;
@@ -0,0 +1,119 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "solver_cache.hpp"
+
+#include "base/base_impl.hpp"
+#include "solv/pool.hpp"
+
+#include "libdnf5/rpm/package_query.hpp"
+
+#include <algorithm>
+
+
+namespace libdnf5::rpm::solv {
+
+namespace {
+
+// Goals of a Base rarely exist at the same time, usually only the goal being resolved and its copy resolved
+// in the strict mode. Solvers above the limit are freed, an idle solver keeps the memory of its rules.
+constexpr std::size_t MAX_POOLED_SOLVERS = 2;
+
+}  // namespace
+
+
+const libdnf5::solv::IdQueue & SolverCache::get_user_installed_packages() {
+    auto nsolvables = get_rpm_pool(base)->nsolvables;
+    auto reasons_generation = InternalBaseUser::get_system_state(base).get_reasons_generation();
+    if (nsolvables == user_installed_nsolvables && reasons_generation == user_installed_reasons_generation) {
+        return user_installed_packages;
+    }
+
+    user_installed_packages.clear();
+    PackageQuery installed_query(base, PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
+    installed_query.filter_installed();
+    for (const auto & pkg : installed_query) {
+        if (pkg.get_reason() > transaction::TransactionItemReason::DEPENDENCY) {
+            user_installed_packages.push_back(pkg.get_id().id);
+        }
+    }
+    user_installed_nsolvables = nsolvables;
+    user_installed_reasons_generation = reasons_generation;
+    return user_installed_packages;
+}
+
+
+const libdnf5::solv::SolvMap & SolverCache::get_protected_packages() {
+    auto nsolvables = get_rpm_pool(base)->nsolvables;
+    auto & names = base->get_config().get_protected_packages_option().get_value();
+    if (nsolvables == protected_nsolvables && names == protected_names) {
+        return protected_packages;
+    }
+
+    protected_packages = libdnf5::solv::SolvMap(nsolvables);
+    PackageQuery protected_query(base, PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
+    protected_query.filter_name(names);
+    for (const auto & pkg : protected_query) {
+        protected_packages.add_unsafe(pkg.get_id().id);
+    }
+    protected_nsolvables = nsolvables;
+    protected_names = names;
+    return protected_packages;
+}
+
+
+const libdnf5::solv::IdQueue & SolverCache::get_installonly() {
+    auto & names = base->get_config().get_installonlypkgs_option().get_value();
+    if (installonly_valid && names == installonly_names) {
+        return installonly;
+    }
+
+    auto & pool = get_rpm_pool(base);
+    installonly.clear();
+    for (auto & name : names) {
+        queue_pushunique(&installonly.get_queue(), pool.str2id(name.c_str(), 1));
+    }
+    installonly_names = names;
+    installonly_valid = true;
+    return installonly;
+}
+
+
+void SolverCache::acquire_solver(libdnf5::solv::Solver & solver) {
+    auto & pool = get_rpm_pool(base);
+    // Solvers created before the pool changed cannot be used anymore
+    std::erase_if(solvers, [&pool](auto & pooled) { return !pooled->is_initialized_for(pool); });
+    if (!solvers.empty()) {
+        solver.swap(*solvers.back());
+        solvers.pop_back();
+    }
+}
+
+
+void SolverCache::release_solver(libdnf5::solv::Solver & solver) {
+    if (solvers.size() < MAX_POOLED_SOLVERS && solver.is_initialized_for(get_rpm_pool(base))) {
+        auto pooled = std::make_unique<libdnf5::solv::Solver>();
+        pooled->swap(solver);
+        solvers.push_back(std::move(pooled));
+    } else {
+        solver.reset();
+    }
+}
+
+}  // namespace libdnf5::rpm::solv
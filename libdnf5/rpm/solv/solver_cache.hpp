@@ -0,0 +1,82 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBDNF5_RPM_SOLV_SOLVER_CACHE_HPP
+#define LIBDNF5_RPM_SOLV_SOLVER_CACHE_HPP
+
+#include "solv/id_queue.hpp"
+#include "solv/solv_map.hpp"
+#include "solv/solver.hpp"
+
+#include "libdnf5/base/base_weak.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace libdnf5::rpm::solv {
+
+/// Solver inputs derived from the state of a Base and the solvers of the already resolved goals, shared by all
+/// goals of the Base. Repeated resolves on an unchanged pool reuse them instead of recomputing the inputs and
+/// creating a new libsolv solver every time. The inputs are recomputed once the number of solvables,
+/// the configuration they are derived from or the package reasons in the system state change.
+class SolverCache {
+public:
+    explicit SolverCache(const BaseWeakPtr & base) : base(base) {}
+
+    /// @return Ids of the installed packages with a reason stronger than DEPENDENCY (USER, GROUP, ...).
+    const libdnf5::solv::IdQueue & get_user_installed_packages();
+
+    /// @return Packages named in the "protected_packages" configuration option, excludes are ignored.
+    const libdnf5::solv::SolvMap & get_protected_packages();
+
+    /// @return Ids of the names in the "installonlypkgs" configuration option.
+    const libdnf5::solv::IdQueue & get_installonly();
+
+    /// Moves a pooled solver created for the current pool into the empty `solver`.
+    /// The `solver` stays empty when there is no such solver.
+    void acquire_solver(libdnf5::solv::Solver & solver);
+
+    /// Takes the `solver` of a goal that no longer needs it to the pool to be reused by another resolve.
+    /// The `solver` is left empty.
+    void release_solver(libdnf5::solv::Solver & solver);
+
+private:
+    BaseWeakPtr base;
+
+    libdnf5::solv::IdQueue user_installed_packages;
+    int user_installed_nsolvables{-1};
+    uint64_t user_installed_reasons_generation{0};
+
+    libdnf5::solv::SolvMap protected_packages{0};
+    int protected_nsolvables{-1};
+    std::vector<std::string> protected_names;
+
+    libdnf5::solv::IdQueue installonly;
+    std::vector<std::string> installonly_names;
+    bool installonly_valid{false};
+
+    std::vector<std::unique_ptr<libdnf5::solv::Solver>> solvers;
+};
+
+}  // namespace libdnf5::rpm::solv
+
+#endif  // LIBDNF5_RPM_SOLV_SOLVER_CACHE_HPP
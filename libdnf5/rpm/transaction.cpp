@@ -33,19 +33,70 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <fmt/format.h>
 #include <rpm/rpmbuild.h>
 #include <rpm/rpmdb.h>
+#include <rpm/rpmkeyring.h>
 #include <rpm/rpmlib.h>
 #include <rpm/rpmpgp.h>
 #include <rpm/rpmtag.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <filesystem>
 #include <map>
+#include <thread>
 #include <type_traits>
 
 
 namespace libdnf5::rpm {
 
+namespace {
+
+struct HeaderDeleter {
+    void operator()(Header header) const { headerFree(header); }
+};
+using HeaderPtr = std::unique_ptr<headerToken_s, HeaderDeleter>;
+
+Header read_header_from_file(rpmts ts, const std::string & file_path) {
+    FD_t fd = Fopen(file_path.c_str(), "r.ufdio");
+
+    if (!fd) {
+        throw TransactionError(
+            M_("Failed to read package header, cannot open file \"{}\": {}"), file_path, std::string(Fstrerror(fd)));
+    }
+
+    const char * descr = file_path.c_str();
+    Header h{};  // Initialization of h is not needed. It is output argument of rpmReadPackageFile().
+    rpmRC rpmrc = rpmReadPackageFile(ts, fd, descr, &h);
+    Fclose(fd);
+
+    switch (rpmrc) {
+        case RPMRC_NOTTRUSTED:
+        case RPMRC_NOKEY:
+        case RPMRC_OK:
+            break;
+        case RPMRC_NOTFOUND:
+        case RPMRC_FAIL:
+        default:
+            h = headerFree(h);
+            throw TransactionError(M_("Failed to read package header from file \"{}\""), file_path);
+            break;
+    }
+
+    return h;
+}
+
+void free_headers(std::vector<Header> & headers) {
+    for (auto & header : headers) {
+        header = headerFree(header);
+    }
+}
+
+}  // namespace
+
+
 RpmHeader & RpmHeader::operator=(const RpmHeader & src) {
     if (&src != this) {
         headerFree(header);
@@ -155,10 +206,25 @@ void Transaction::fill(const base::Transaction & transaction) {
         installonly_versions.insert(std::make_pair(pkg.get_name(), pkg));
     }
 
+    // Read the headers of all inbound packages first. Reading verifies the header digests and signatures,
+    // which is most of the work here, so it is done in parallel.
+    std::vector<std::string> inbound_paths;
+    for (auto & tspkg : transaction_items) {
+        if (libdnf5::transaction::transaction_item_action_is_inbound(tspkg.get_action())) {
+            inbound_paths.push_back(tspkg.get_package().get_package_path());
+        }
+    }
+    std::vector<HeaderPtr> inbound_headers;
+    inbound_headers.reserve(inbound_paths.size());
+    for (auto header : read_pkg_headers(inbound_paths)) {
+        inbound_headers.emplace_back(header);
+    }
+    auto next_inbound_header = inbound_headers.begin();
+
     for (auto & tspkg : transaction_items) {
         switch (tspkg.get_action()) {
             case libdnf5::transaction::TransactionItemAction::INSTALL:
-                install(tspkg);
+                install(tspkg, (next_inbound_header++)->get());
                 // Inbound installonly packages always have `INSTALL` action,
                 // there is no `DOWNGRADE`. We need to detect downgrade
                 // manually to correctly add RPMPROB_FILTER_OLDPACKAGE to rpm
@@ -174,13 +240,13 @@ void Transaction::fill(const base::Transaction & transaction) {
                 }
                 break;
             case libdnf5::transaction::TransactionItemAction::UPGRADE:
-                upgrade(tspkg);
+                upgrade(tspkg, (next_inbound_header++)->get());
                 break;
             case libdnf5::transaction::TransactionItemAction::DOWNGRADE:
-                downgrade(tspkg);
+                downgrade(tspkg, (next_inbound_header++)->get());
                 break;
             case libdnf5::transaction::TransactionItemAction::REINSTALL:
-                reinstall(tspkg);
+                reinstall(tspkg, (next_inbound_header++)->get());
                 break;
             case libdnf5::transaction::TransactionItemAction::REMOVE:
             case libdnf5::transaction::TransactionItemAction::REPLACED:
@@ -209,6 +275,8 @@ int Transaction::run() {
     if (base->get_config().get_ignorearch_option().get_value()) {
         ignore_set |= RPMPROB_FILTER_IGNOREARCH;
     }
+    auto progress_interval = base->get_config().get_progress_interval_option().get_value();
+    progress_throttle = utils::ProgressThrottle(std::chrono::milliseconds(progress_interval));
     rpmtsSetNotifyStyle(ts, 1);
     rpmtsSetNotifyCallback(ts, ts_callback, &callbacks_holder);
     auto rc = rpmtsRun(ts, nullptr, ignore_set);
@@ -260,32 +328,64 @@ BaseWeakPtr Transaction::get_base() const {
 }
 
 Header Transaction::read_pkg_header(const std::string & file_path) const {
-    FD_t fd = Fopen(file_path.c_str(), "r.ufdio");
+    return read_header_from_file(ts, file_path);
+}
 
-    if (!fd) {
-        throw TransactionError(
-            M_("Failed to read package header, cannot open file \"{}\": {}"), file_path, std::string(Fstrerror(fd)));
+std::vector<Header> Transaction::read_pkg_headers(const std::vector<std::string> & file_paths) const {
+    std::vector<Header> headers(file_paths.size(), nullptr);
+    std::vector<std::exception_ptr> errors(file_paths.size());
+
+    auto workers_count = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), file_paths.size());
+    if (workers_count <= 1) {
+        for (std::size_t idx = 0; idx < file_paths.size(); ++idx) {
+            try {
+                headers[idx] = read_pkg_header(file_paths[idx]);
+            } catch (...) {
+                free_headers(headers);
+                throw;
+            }
+        }
+        return headers;
     }
 
-    const char * descr = file_path.c_str();
-    Header h{};  // Initialization of h is not needed. It is output argument of rpmReadPackageFile().
-    rpmRC rpmrc = rpmReadPackageFile(ts, fd, descr, &h);
-    Fclose(fd);
+    // The workers share the keyring of the transaction set, load it once before they start
+    rpmKeyring keyring = rpmtsGetKeyring(ts, 1);
+    std::atomic<std::size_t> next_idx{0};
+    auto worker = [&]() {
+        rpmts worker_ts = rpmtsCreate();
+        rpmtsSetRootDir(worker_ts, rpmtsRootDir(ts));
+        rpmtsSetVSFlags(worker_ts, rpmtsVSFlags(ts));
+        rpmtsSetVfyLevel(worker_ts, rpmtsVfyLevel(ts));
+        rpmtsSetKeyring(worker_ts, keyring);
+        for (auto idx = next_idx++; idx < file_paths.size(); idx = next_idx++) {
+            try {
+                headers[idx] = read_header_from_file(worker_ts, file_paths[idx]);
+            } catch (...) {
+                errors[idx] = std::current_exception();
+            }
+        }
+        rpmtsFree(worker_ts);
+    };
 
-    switch (rpmrc) {
-        case RPMRC_NOTTRUSTED:
-        case RPMRC_NOKEY:
-        case RPMRC_OK:
-            break;
-        case RPMRC_NOTFOUND:
-        case RPMRC_FAIL:
-        default:
-            h = headerFree(h);
-            throw TransactionError(M_("Failed to read package header from file \"{}\""), file_path);
-            break;
+    std::vector<std::thread> workers;
+    workers.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+        workers.emplace_back(worker);
     }
+    for (auto & thread : workers) {
+        thread.join();
+    }
+    rpmKeyringFree(keyring);
 
-    return h;
+    // report the error of the first package that failed, as the serial reading would
+    for (auto & error : errors) {
+        if (error) {
+            free_headers(headers);
+            std::rethrow_exception(error);
+        }
+    }
+
+    return headers;
 }
 
 Header Transaction::get_header(unsigned int rec_offset) {
@@ -305,13 +405,10 @@ Header Transaction::get_header(unsigned int rec_offset) {
     return hdr;
 }
 
-void Transaction::reinstall(TransactionItem & item) {
-    auto file_path = item.get_package().get_package_path();
-    auto * header = read_pkg_header(file_path);
+void Transaction::reinstall(TransactionItem & item, Header header) {
     last_added_item = &item;
     last_item_added_ts_element = false;
     auto rc = rpmtsAddReinstallElement(ts, header, &item);
-    headerFree(header);
     if (rc != 0) {
         //TODO(jrohel): Why? Librpm does not provide this information.
         throw TransactionError(M_("Cannot reinstall package \"{}\""), item.get_package().get_full_nevra());
@@ -346,7 +443,8 @@ void Transaction::erase(TransactionItem & item) {
     }
 }
 
-void Transaction::install_up_down(TransactionItem & item, libdnf5::transaction::TransactionItemAction action) {
+void Transaction::install_up_down(
+    TransactionItem & item, Header header, libdnf5::transaction::TransactionItemAction action) {
     std::string msg_action;
     bool upgrade{true};
     if (action == libdnf5::transaction::TransactionItemAction::UPGRADE) {
@@ -360,12 +458,9 @@ void Transaction::install_up_down(TransactionItem & item, libdnf5::transaction::
     } else {
         libdnf_throw_assertion("Unsupported action: {}", utils::to_underlying(action));
     }
-    auto file_path = item.get_package().get_package_path();
-    auto * header = read_pkg_header(file_path);
     last_added_item = &item;
     last_item_added_ts_element = false;
     auto rc = rpmtsAddInstallElement(ts, header, &item, upgrade ? 1 : 0, nullptr);
-    headerFree(header);
     if (rc != 0) {
         //TODO(jrohel): Why? Librpm does not provide this information.
         throw TransactionError(M_("Cannot {} package \"{}\""), msg_action, item.get_package().get_full_nevra());
@@ -515,7 +610,8 @@ void * Transaction::ts_callback(
     switch (what) {
         case RPMCALLBACK_INST_PROGRESS:
             libdnf_assert_transaction_item_set();
-            if (callbacks) {
+            if (callbacks && transaction.progress_throttle.should_notify(
+                                 static_cast<double>(amount), static_cast<double>(total))) {
                 callbacks->install_progress(*item, amount, total);
             }
             break;
@@ -526,6 +622,7 @@ void * Transaction::ts_callback(
                 "RPM callback install start \"{}\" total {}",
                 to_full_nevra_string(trans_element_to_nevra(trans_element)),
                 total);
+            transaction.progress_throttle.reset();
             if (callbacks) {
                 callbacks->install_start(*item, total);
             }
@@ -549,12 +646,14 @@ void * Transaction::ts_callback(
             }
             break;
         case RPMCALLBACK_TRANS_PROGRESS:
-            if (callbacks) {
+            if (callbacks && transaction.progress_throttle.should_notify(
+                                 static_cast<double>(amount), static_cast<double>(total))) {
                 callbacks->transaction_progress(amount, total);
             }
             break;
         case RPMCALLBACK_TRANS_START:
             logger.info("RPM callback transaction start, total {}", total);
+            transaction.progress_throttle.reset();
             if (callbacks) {
                 callbacks->transaction_start(total);
             }
@@ -567,7 +666,8 @@ void * Transaction::ts_callback(
             break;
         case RPMCALLBACK_UNINST_PROGRESS:
             libdnf_assert_transaction_item_set();
-            if (callbacks) {
+            if (callbacks && transaction.progress_throttle.should_notify(
+                                 static_cast<double>(amount), static_cast<double>(total))) {
                 callbacks->uninstall_progress(*item, amount, total);
             }
             break;
@@ -577,6 +677,7 @@ void * Transaction::ts_callback(
                 "RPM callback uninstall start \"{}\" total {}",
                 to_full_nevra_string(trans_element_to_nevra(trans_element)),
                 total);
+            transaction.progress_throttle.reset();
             if (callbacks) {
                 callbacks->uninstall_start(*item, total);
             }
@@ -679,12 +780,14 @@ void * Transaction::ts_callback(
             }
             break;
         case RPMCALLBACK_VERIFY_PROGRESS:
-            if (callbacks) {
+            if (callbacks && transaction.progress_throttle.should_notify(
+                                 static_cast<double>(amount), static_cast<double>(total))) {
                 callbacks->verify_progress(amount, total);
             }
             break;
         case RPMCALLBACK_VERIFY_START:
             logger.info("RPM callback verify start, total {}", total);
+            transaction.progress_throttle.reset();
             if (callbacks) {
                 callbacks->verify_start(total);
             }
@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define LIBDNF5_RPM_TRANSACTION_HPP
 
 #include "rpm_log_guard.hpp"
+#include "utils/progress_throttle.hpp"
 
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/base/transaction_package.hpp"
@@ -35,6 +36,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <rpm/rpmts.h>
 
 #include <memory>
+#include <vector>
 
 // Required for building with fmt >= 10
 // See: https://github.com/fmtlib/fmt/blob/10.0.0/ChangeLog.rst?plain=1#L68
@@ -334,6 +336,7 @@ private:
     FD_t script_fd{nullptr};
     CallbacksHolder callbacks_holder{nullptr, this};
     FD_t fd_in_cb{nullptr};  // file descriptor used by transaction in callback (install/reinstall package)
+    utils::ProgressThrottle progress_throttle;  // coalesces progress callbacks of the currently processed item
 
     TransactionItem * last_added_item{nullptr};  // item added by last install/reinstall/erase/...
     bool last_item_added_ts_element{false};      // Did the last item add the element ts?
@@ -351,6 +354,12 @@ private:
     /// @return  package header
     Header read_pkg_header(const std::string & file_path) const;
 
+    /// Return headers from packages. The headers are read in parallel, each worker thread uses its own
+    /// rpm transaction set sharing the root dir, verify flags and keyring with `ts`.
+    /// @param file_paths  file paths
+    /// @return  package headers in the order of `file_paths`, the caller is responsible for freeing them
+    std::vector<Header> read_pkg_headers(const std::vector<std::string> & file_paths) const;
+
     /// Get header of package at offset in the rpmdbi database
     Header get_header(unsigned int rec_offset);
 
@@ -358,29 +367,33 @@ private:
     /// The transaction set is checked for duplicate package names.
     /// If found, the package with the "newest" EVR will be replaced.
     /// @param item  item to be installed
-    void install(TransactionItem & item) {
-        install_up_down(item, libdnf5::transaction::TransactionItemAction::INSTALL);
+    /// @param header  header of the package to be installed
+    void install(TransactionItem & item, Header header) {
+        install_up_down(item, header, libdnf5::transaction::TransactionItemAction::INSTALL);
     }
 
     /// Add package to be upgraded to transaction set.
     /// The transaction set is checked for duplicate package names.
     /// If found, the package with the "newest" EVR will be replaced.
     /// @param item  item to be upgraded
-    void upgrade(TransactionItem & item) {
-        install_up_down(item, libdnf5::transaction::TransactionItemAction::UPGRADE);
+    /// @param header  header of the package to be upgraded
+    void upgrade(TransactionItem & item, Header header) {
+        install_up_down(item, header, libdnf5::transaction::TransactionItemAction::UPGRADE);
     }
 
     /// Add package to be upgraded to transaction set.
     /// The transaction set is checked for duplicate package names.
     /// If found, the package with the "newest" EVR will be replaced.
     /// @param item  item to be upgraded
-    void downgrade(TransactionItem & item) {
-        install_up_down(item, libdnf5::transaction::TransactionItemAction::DOWNGRADE);
+    /// @param header  header of the package to be downgraded
+    void downgrade(TransactionItem & item, Header header) {
+        install_up_down(item, header, libdnf5::transaction::TransactionItemAction::DOWNGRADE);
     }
 
     /// Add package to be reinstalled to transaction set.
     /// @param item  item to be reinstalled
-    void reinstall(TransactionItem & item);
+    /// @param header  header of the package to be reinstalled
+    void reinstall(TransactionItem & item, Header header);
 
     /// Add package to be erased to transaction set.
     /// @param item  item to be erased
@@ -390,9 +403,10 @@ private:
     /// The transaction set is checked for duplicate package names.
     /// If found, the package with the "newest" EVR will be replaced.
     /// @param item  item to be erased
+    /// @param header  header of the package
     /// @param action  one of TransactionItemAction::UPGRADE,
     ///     TransactionItemAction::DOWNGRADE, TransactionItemAction::INSTALL
-    void install_up_down(TransactionItem & item, libdnf5::transaction::TransactionItemAction action);
+    void install_up_down(TransactionItem & item, Header header, libdnf5::transaction::TransactionItemAction action);
 
     static Nevra trans_element_to_nevra(rpmte te);
 
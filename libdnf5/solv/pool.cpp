@@ -144,25 +144,6 @@ const char * Pool::get_nevra_with_epoch(Id id) const noexcept {
     return pool_solvable_epoch_optional_2str(this, pool, id, true);
 }
 
-const char * Pool::get_str_from_pool(Id keyname, Id advisory, int index) const {
-    Dataiterator di;
-    const char * str = NULL;
-    int count = 0;
-
-    dataiterator_init(&di, pool, 0, advisory, UPDATE_REFERENCE, 0, 0);
-    while (dataiterator_step(&di)) {
-        dataiterator_setpos(&di);
-        if (count++ == index) {
-            str = lookup_str(SOLVID_POS, keyname);
-            break;
-        }
-    }
-    dataiterator_free(&di);
-
-    return str;
-}
-
-
 unsigned long Pool::get_epoch_num(Id id) const {
     const auto evr = split_evr(get_evr(id));
     if (evr.e) {
@@ -227,6 +208,42 @@ const char * Pool::get_sourcerpm(Id id) const {
     return solvable_lookup_sourcepkg(solvable);
 }
 
+PoolMemoryUsage get_pool_memory_usage(const ::Pool * pool) noexcept {
+    // Only the fields libsolv exposes without LIBSOLV_INTERNAL are used, the hash tables and auxiliary
+    // provides data are not accounted.
+    PoolMemoryUsage usage;
+    usage.strings = static_cast<std::size_t>(pool->ss.nstrings) * sizeof(Offset) + pool->ss.sstrings;
+
+    usage.reldeps = static_cast<std::size_t>(pool->nrels) * sizeof(Reldep);
+
+    if (pool->whatprovides) {
+        usage.whatprovides += static_cast<std::size_t>(pool->ss.nstrings) * sizeof(Offset);
+    }
+    if (pool->whatprovides_rel) {
+        usage.whatprovides += static_cast<std::size_t>(pool->nrels) * sizeof(Offset);
+    }
+    if (pool->whatprovidesdata) {
+        auto whatprovidesdata_len = static_cast<std::size_t>(pool->whatprovidesdataoff) +
+                                    static_cast<std::size_t>(pool->whatprovidesdataleft);
+        usage.whatprovides += whatprovidesdata_len * sizeof(Id);
+    }
+
+    usage.solvables = static_cast<std::size_t>(pool->nsolvables) * sizeof(Solvable);
+    return usage;
+}
+
+
+std::size_t get_repo_memory_usage(const ::Repo * repo) noexcept {
+    // The repodata internals are only exposed with LIBSOLV_INTERNAL, only the dependency arrays
+    // and the rpmdb ids are accounted.
+    std::size_t size = static_cast<std::size_t>(repo->idarraysize) * sizeof(Id);
+    if (repo->rpmdbid) {
+        size += static_cast<std::size_t>(repo->end - repo->start) * sizeof(Id);
+    }
+    return size;
+}
+
+
 std::pair<std::string, std::string> CompsPool::split_solvable_name(std::string_view solvable_name) {
     auto delimiter_position = solvable_name.find(":");
     if (delimiter_position == std::string::npos) {
@@ -27,6 +27,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <climits>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 extern "C" {
 #include <solv/dataiterator.h>
@@ -148,8 +150,6 @@ public:
         return pool_lookup_void(pool, id, keyname);
     }
 
-    const char * get_str_from_pool(Id keyname, Id advisory, int index) const;
-
     Id queuetowhatprovides(IdQueue & queue) const { return pool_queuetowhatprovides(pool, &queue.get_queue()); }
 
     int evrcmp(Id evr1, Id evr2, int mode) const { return pool_evrcmp(pool, evr1, evr2, mode); }
@@ -267,9 +267,44 @@ protected:
 
 class RpmPool : public Pool {
     // TODO(mblaha): Move rpm specific methods from parent Pool class here
+public:
+    /// Returns the id of the dependency parsed from `reldep_str` stored by `cache_reldep_id()`, 0 if there is none.
+    Id get_cached_reldep_id(const std::string & reldep_str) const {
+        auto it = reldep_ids.find(reldep_str);
+        return it == reldep_ids.end() ? 0 : it->second;
+    }
+
+    /// Stores the id of the dependency parsed from `reldep_str`.
+    /// The ids in the pool never change, so the cache remains valid for the whole lifetime of the pool.
+    void cache_reldep_id(const std::string & reldep_str, Id id) {
+        if (reldep_ids.size() >= MAX_CACHED_RELDEP_IDS) {
+            reldep_ids.clear();
+        }
+        reldep_ids.emplace(reldep_str, id);
+    }
+
+private:
+    static constexpr std::size_t MAX_CACHED_RELDEP_IDS = 100000;
+
+    std::unordered_map<std::string, Id> reldep_ids;
 };
 
 
+/// Approximate numbers of bytes allocated by the libsolv pool, without the repositories.
+struct PoolMemoryUsage {
+    std::size_t strings{0};       // the string pool
+    std::size_t reldeps{0};       // the relational dependencies
+    std::size_t whatprovides{0};  // the provides index
+    std::size_t solvables{0};     // the array of solvables
+};
+
+PoolMemoryUsage get_pool_memory_usage(const ::Pool * pool) noexcept;
+
+/// Returns the approximate number of bytes allocated by the dependency arrays of the libsolv repository.
+/// The repodata (the other package metadata) are not included.
+std::size_t get_repo_memory_usage(const ::Repo * repo) noexcept;
+
+
 class CompsPool : public Pool {
 public:
     // Search solvables that correspond to the environment_ids for given key
@@ -25,21 +25,44 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <solv/bitmap.h>
 #include <solv/pooltypes.h>
 
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <stdexcept>
 
 
 namespace libdnf5::solv {
 
-// clang-format off
-// see http://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetTable
-static const unsigned char BIT_COUNT_LOOKUP[256] = {
-    #define B2(n) n, n + 1, n + 1, n + 2
-    #define B4(n) B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
-    #define B6(n) B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
-    B6(0), B6(1), B6(1), B6(2)
-};
-// clang-format on
+// The bitmap operations work with 64-bit words, the compiler can vectorize the loops further.
+// Bit `n` of the libsolv Map is the bit `n % 8` of the byte `n / 8`, the words are therefore loaded
+// in the little-endian order.
+
+/// Loads up to 8 bytes from `bytes` into a word, the missing bytes are zero.
+inline uint64_t load_map_word(const unsigned char * bytes, std::size_t available) noexcept {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes, available < sizeof(word) ? available : sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/// Replaces each byte of `dst` with `op(dst_byte, src_byte)`, processes 8 bytes at once.
+template <typename Op>
+inline void map_apply(unsigned char * dst, const unsigned char * src, std::size_t size, Op op) noexcept {
+    std::size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t dst_word;
+        uint64_t src_word;
+        std::memcpy(&dst_word, dst + i, sizeof(dst_word));
+        std::memcpy(&src_word, src + i, sizeof(src_word));
+        dst_word = op(dst_word, src_word);
+        std::memcpy(dst + i, &dst_word, sizeof(dst_word));
+    }
+    for (; i < size; ++i) {
+        dst[i] = static_cast<unsigned char>(op(uint64_t{dst[i]}, uint64_t{src[i]}));
+    }
+}
 
 
 class ConstMapIterator {
@@ -83,15 +106,11 @@ public:
     /// Sets the iterator to the first contained item or to the end if there are no items.
     void begin() noexcept {
         current_value = BEGIN;
-        map_current = map->map;
         ++*this;
     }
 
     /// Sets the iterator to the end.
-    void end() noexcept {
-        current_value = END;
-        map_current = map_end;
-    }
+    void end() noexcept { current_value = END; }
 
     /// Sets the iterator to the first contained item in the range <id, end>.
     void jump(Id id) noexcept;
@@ -106,9 +125,6 @@ private:
     // pointer to a map owned by SolvMap
     const Map * map;
 
-    // current address in the map
-    const unsigned char * map_current;
-
     // the last address in the map
     const unsigned char * map_end;
 
@@ -190,22 +206,13 @@ public:
     // SET OPERATIONS - Map
 
     /// Union operator
-    SolvMap & operator|=(const Map & other) noexcept {
-        map_or(&map, &other);
-        return *this;
-    }
+    SolvMap & operator|=(const Map & other) noexcept;
 
     /// Difference operator
-    SolvMap & operator-=(const Map & other) noexcept {
-        map_subtract(&map, &other);
-        return *this;
-    }
+    SolvMap & operator-=(const Map & other) noexcept;
 
     /// Intersection operator
-    SolvMap & operator&=(const Map & other) noexcept {
-        map_and(&map, &other);
-        return *this;
-    }
+    SolvMap & operator&=(const Map & other) noexcept;
 
     // SET OPERATIONS - SolvMap
 
@@ -242,37 +249,30 @@ private:
 
 
 inline ConstMapIterator & ConstMapIterator::operator++() noexcept {
-    if (current_value >= 0) {
-        // make a copy of byte with the previous match to avoid changing the map
-        unsigned char byte = *map_current;
-
-        // reset previously seen bits to 0
-        byte = static_cast<unsigned char>(byte >> ((current_value & 7) + 1));
-
-        auto bit = ffs(byte << ((current_value & 7) + 1));
-        if (bit) {
-            // return (current byte * 8) + bit position - 1
-            current_value = (static_cast<int>(map_current - map->map) << 3) + bit - 1;
-            return *this;
-        }
-
-        // no following bit was set in the current byte
-        // move to the next byte and start searching in the next bytes
-        map_current++;
+    if (current_value == END) {
+        return *this;
     }
 
-    while (map_current < map_end) {
-        // skip all empty bytes
-        if (!*map_current) {
-            // move to the next byte
-            map_current++;
-            continue;
+    // the search starts at the bit following the current value
+    auto next = static_cast<std::size_t>(current_value + 1);
+    auto map_size = static_cast<std::size_t>(map_end - map->map);
+    auto pos = next >> 3;
+    if (pos < map_size) {
+        // reset the bits preceding the searched one to 0
+        auto word = load_map_word(map->map + pos, map_size - pos) & (~uint64_t{0} << (next & 7));
+        while (true) {
+            if (word) {
+                // return (current byte * 8) + index of the lowest set bit
+                current_value = static_cast<Id>((pos << 3) + static_cast<std::size_t>(__builtin_ctzll(word)));
+                return *this;
+            }
+            // skip the empty word
+            pos += sizeof(uint64_t);
+            if (pos >= map_size) {
+                break;
+            }
+            word = load_map_word(map->map + pos, map_size - pos);
         }
-
-        // now we have a byte that has at least one bit set
-        // return (current byte * 8) + bit position - 1
-        current_value = (static_cast<int>(map_current - map->map) << 3) + ffs(*map_current) - 1;
-        return *this;
     }
 
     // not found
@@ -287,20 +287,14 @@ inline void ConstMapIterator::jump(Id id) noexcept {
         return;
     }
 
-    const unsigned char * current = map->map + (id >> 3);
-
-    if (current >= map_end) {
+    if (map->map + (id >> 3) >= map_end) {
         end();
         return;
     }
 
-    current_value = id;
-    map_current = current;
-
     // If the element with requested id does not exist in the map, it moves to the next.
-    if (!(*current & (1 << (id & 7)))) {
-        ++*this;
-    }
+    current_value = id - 1;
+    ++*this;
 }
 
 
@@ -345,12 +339,9 @@ inline bool SolvMap::contains(Id id) const noexcept {
 
 
 inline bool SolvMap::empty() const noexcept {
-    const unsigned char * byte = map.map;
-    const unsigned char * end = byte + map.size;
-
-    // iterate through the whole bitmap by moving the address
-    while (byte < end) {
-        if (*byte++) {
+    auto map_size = static_cast<std::size_t>(map.size);
+    for (std::size_t pos = 0; pos < map_size; pos += sizeof(uint64_t)) {
+        if (load_map_word(map.map + pos, map_size - pos)) {
             // return false if a non-zero bit was found
             return false;
         }
@@ -361,18 +352,48 @@ inline bool SolvMap::empty() const noexcept {
 
 
 inline std::size_t SolvMap::size() const noexcept {
-    unsigned char * byte = map.map;
-    unsigned char * end = byte + map.size;
+    auto map_size = static_cast<std::size_t>(map.size);
     std::size_t result = 0;
-
-    // iterate through the whole bitmap by moving the address
-    while (byte < end) {
-        // add number of bits in each byte
-        result += BIT_COUNT_LOOKUP[*byte++];
+    for (std::size_t pos = 0; pos < map_size; pos += sizeof(uint64_t)) {
+        // add number of bits in each word
+        result += static_cast<std::size_t>(__builtin_popcountll(load_map_word(map.map + pos, map_size - pos)));
     }
     return result;
 }
 
+
+inline SolvMap & SolvMap::operator|=(const Map & other) noexcept {
+    if (other.size > map.size) {
+        map_grow(&map, other.size << 3);
+    }
+    map_apply(map.map, other.map, static_cast<std::size_t>(other.size), [](uint64_t dst, uint64_t src) {
+        return dst | src;
+    });
+    return *this;
+}
+
+
+inline SolvMap & SolvMap::operator-=(const Map & other) noexcept {
+    auto size = map.size < other.size ? map.size : other.size;
+    map_apply(map.map, other.map, static_cast<std::size_t>(size), [](uint64_t dst, uint64_t src) {
+        return dst & ~src;
+    });
+    return *this;
+}
+
+
+inline SolvMap & SolvMap::operator&=(const Map & other) noexcept {
+    auto size = map.size < other.size ? map.size : other.size;
+    map_apply(map.map, other.map, static_cast<std::size_t>(size), [](uint64_t dst, uint64_t src) {
+        return dst & src;
+    });
+    if (map.size > size) {
+        // items missing in the other map are not in the intersection
+        std::memset(map.map + size, 0, static_cast<std::size_t>(map.size - size));
+    }
+    return *this;
+}
+
 }  // namespace libdnf5::solv
 
 #endif  // LIBDNF5_SOLV_MAP_HPP
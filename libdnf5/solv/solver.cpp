@@ -22,6 +22,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
 #include <filesystem>
+#include <utility>
 
 extern "C" {
 #include <solv/solver.h>
@@ -34,7 +35,7 @@ extern "C" {
 namespace libdnf5::solv {
 
 Solver::Solver(Pool & pool) {
-    solver = ::solver_create(*pool);
+    init(pool);
 }
 
 Solver::~Solver() {
@@ -48,6 +49,8 @@ void Solver::init(::Pool * pool) {
         ::solver_free(solver);
     }
     solver = ::solver_create(pool);
+    nsolvables = pool->nsolvables;
+    installed = pool->installed;
 }
 
 void Solver::init(Pool & pool) {
@@ -61,6 +64,16 @@ void Solver::reset() {
     }
 }
 
+bool Solver::is_initialized_for(Pool & pool) {
+    return solver && solver->pool == *pool && nsolvables == pool->nsolvables && installed == pool->installed;
+}
+
+void Solver::swap(Solver & other) noexcept {
+    std::swap(solver, other.solver);
+    std::swap(nsolvables, other.nsolvables);
+    std::swap(installed, other.installed);
+}
+
 void Solver::write_debugdata(std::filesystem::path debug_dir, bool with_transaction) {
     solver_initialized_assert();
     std::error_code ec;
@@ -62,6 +62,13 @@ public:
     /// returns true if `solver` exists
     bool is_initialized() { return solver != nullptr; };
 
+    /// returns true if `solver` exists and was created for the current solvables of the `pool`
+    /// libsolv sizes the solver data by the pool, the solver cannot be reused once solvables are added or removed
+    bool is_initialized_for(Pool & pool);
+
+    /// exchange the `solver` objects with `other`
+    void swap(Solver & other) noexcept;
+
     /// Write solver debug data to given directory
     /// @param with_transaction Whether transaction data are dumped
     void write_debugdata(std::filesystem::path debug_dir, bool with_transaction = true);
@@ -112,6 +119,11 @@ public:
 
 protected:
     ::Solver * solver{nullptr};
+
+private:
+    // size of the pool and its installed repository the `solver` was created for
+    int nsolvables{0};
+    ::Repo * installed{nullptr};
 };
 
 
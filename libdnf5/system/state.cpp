@@ -27,6 +27,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/comps/group/package.hpp>
 #include <toml.hpp>
 
+#include <string_view>
+
 
 namespace toml {
 
@@ -263,8 +265,8 @@ transaction::TransactionItemReason State::get_package_reason(const std::string &
 
     if (packages_reason < transaction::TransactionItemReason::GROUP) {
         // group packages are not stored in packages.toml but in groups.toml
-        // using its name
-        std::string name = na;
+        // using its name, the cache is searched by a view of the name without copying it
+        std::string_view name{na};
         auto dot_pos = name.find('.');
         if (dot_pos != name.npos) {
             name = name.substr(0, dot_pos);
@@ -313,6 +315,8 @@ void State::set_package_reason(const std::string & na, transaction::TransactionI
         reason_str);
 
     package_states[na].reason = reason_str;
+    package_states_changed = true;
+    ++reasons_generation;
 }
 
 
@@ -339,6 +343,8 @@ std::set<std::string> State::get_packages_by_reason(const std::set<transaction::
 
 void State::remove_package_na_state(const std::string & na) {
     package_states.erase(na);
+    package_states_changed = true;
+    ++reasons_generation;
 }
 
 
@@ -354,11 +360,13 @@ std::string State::get_package_from_repo(const std::string & nevra) {
 
 void State::set_package_from_repo(const std::string & nevra, const std::string & from_repo) {
     nevra_states[nevra].from_repo = from_repo;
+    nevra_states_changed = true;
 }
 
 
 void State::remove_package_nevra_state(const std::string & nevra) {
     nevra_states.erase(nevra);
+    nevra_states_changed = true;
 }
 
 
@@ -374,13 +382,17 @@ GroupState State::get_group_state(const std::string & id) {
 
 void State::set_group_state(const std::string & id, const GroupState & group_state) {
     group_states[id] = group_state;
+    group_states_changed = true;
     package_groups_cache.reset();
+    ++reasons_generation;
 }
 
 
 void State::remove_group_state(const std::string & id) {
     group_states.erase(id);
+    group_states_changed = true;
     package_groups_cache.reset();
+    ++reasons_generation;
 }
 
 
@@ -396,11 +408,13 @@ EnvironmentState State::get_environment_state(const std::string & id) {
 
 void State::set_environment_state(const std::string & id, const EnvironmentState & environment_state) {
     environment_states[id] = environment_state;
+    environment_states_changed = true;
 }
 
 
 void State::remove_environment_state(const std::string & id) {
     environment_states.erase(id);
+    environment_states_changed = true;
 }
 
 
@@ -463,11 +477,13 @@ ModuleState State::get_module_state(const std::string & name) {
 
 void State::set_module_state(const std::string & name, const ModuleState & module_state) {
     module_states[name] = module_state;
+    module_states_changed = true;
 }
 
 
 void State::remove_module_state(const std::string & name) {
     module_states.erase(name);
+    module_states_changed = true;
 }
 
 
@@ -478,6 +494,7 @@ std::string State::get_rpmdb_cookie() const {
 
 void State::set_rpmdb_cookie(const std::string & cookie) {
     system_state.rpmdb_cookie = cookie;
+    system_state_changed = true;
 }
 
 
@@ -492,16 +509,29 @@ static std::string toml_format(const toml::value & value) {
 }
 
 
+template <typename T>
+static void save_toml_data(
+    const std::filesystem::path & path, const std::string & key, const T & value, bool & changed) {
+    // Formatting and writing the state files is not cheap (there is a record for every installed package
+    // in nevras.toml), rewrite only the files whose content has changed since they were loaded or saved.
+    if (!changed && std::filesystem::exists(path)) {
+        return;
+    }
+
+    utils::fs::File(path, "w").write(toml_format(make_top_value(key, value)));
+    changed = false;
+}
+
+
 void State::save() {
     std::filesystem::create_directories(path);
 
-    utils::fs::File(get_package_state_path(), "w").write(toml_format(make_top_value("packages", package_states)));
-    utils::fs::File(get_nevra_state_path(), "w").write(toml_format(make_top_value("nevras", nevra_states)));
-    utils::fs::File(get_group_state_path(), "w").write(toml_format(make_top_value("groups", group_states)));
-    utils::fs::File(get_environment_state_path(), "w")
-        .write(toml_format(make_top_value("environments", environment_states)));
-    utils::fs::File(get_module_state_path(), "w").write(toml_format(make_top_value("modules", module_states)));
-    utils::fs::File(get_system_state_path(), "w").write(toml_format(make_top_value("system", system_state)));
+    save_toml_data(get_package_state_path(), "packages", package_states, package_states_changed);
+    save_toml_data(get_nevra_state_path(), "nevras", nevra_states, nevra_states_changed);
+    save_toml_data(get_group_state_path(), "groups", group_states, group_states_changed);
+    save_toml_data(get_environment_state_path(), "environments", environment_states, environment_states_changed);
+    save_toml_data(get_module_state_path(), "modules", module_states, module_states_changed);
+    save_toml_data(get_system_state_path(), "system", system_state, system_state_changed);
 }
 
 
@@ -536,11 +566,19 @@ void State::load() {
     module_states = load_toml_data<std::map<std::string, ModuleState>>(get_module_state_path(), "modules");
     system_state = load_toml_data<SystemState>(get_system_state_path(), "system");
     package_groups_cache.reset();
+    ++reasons_generation;
+
+    package_states_changed = false;
+    nevra_states_changed = false;
+    group_states_changed = false;
+    environment_states_changed = false;
+    module_states_changed = false;
+    system_state_changed = false;
 }
 
-const std::map<std::string, std::set<std::string>> & State::get_package_groups_cache() {
+const std::map<std::string, std::set<std::string>, std::less<>> & State::get_package_groups_cache() {
     if (!package_groups_cache) {
-        std::map<std::string, std::set<std::string>> cache;
+        std::map<std::string, std::set<std::string>, std::less<>> cache;
         for (const auto & [group_id, group_state] : group_states) {
             for (const auto & pkg : group_state.packages) {
                 cache[pkg].emplace(group_id);
@@ -595,6 +633,12 @@ void State::reset_packages_states(
     this->nevra_states = std::move(nevra_states);
     this->group_states = std::move(group_states);
     this->environment_states = std::move(environment_states);
+    package_states_changed = true;
+    nevra_states_changed = true;
+    group_states_changed = true;
+    environment_states_changed = true;
+    package_groups_cache.reset();
+    ++reasons_generation;
 
     // Try to save the new system state.
     // dnf can be used without root priviledges or with read-only system state location.
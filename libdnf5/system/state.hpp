@@ -27,7 +27,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/rpm/package.hpp"
 #include "libdnf5/transaction/transaction_item_reason.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <optional>
 #include <set>
@@ -240,6 +242,10 @@ public:
     /// @since 5.0
     void save();
 
+    /// @return A counter incremented by every change of the package or group states, which can change
+    /// the reasons of the packages. Used to detect that the data derived from the reasons are out of date.
+    uint64_t get_reasons_generation() const noexcept { return reasons_generation; }
+
 private:
     friend Base;
 
@@ -251,7 +257,10 @@ private:
     /// Reset modules states to match given new values.
     /// @param new_states New values for modules states.
     /// @since 5.0
-    void reset_module_states(std::map<std::string, ModuleState> new_states) { module_states = new_states; }
+    void reset_module_states(std::map<std::string, ModuleState> new_states) {
+        module_states = new_states;
+        module_states_changed = true;
+    }
 
     /// Reset packages system state to match given values.
     /// @param installed_packages Vector of tuples <rpm::Nevra nevra, TransactionItemReason reason, std::string repository_id> of currently installed packages
@@ -295,7 +304,7 @@ private:
     /// Cache to speed-up searching the group packages in group_states map
     /// @return The map {package_name -> [id of groups the package_name is part of]}
     /// @since 5.0
-    const std::map<std::string, std::set<std::string>> & get_package_groups_cache();
+    const std::map<std::string, std::set<std::string>, std::less<>> & get_package_groups_cache();
 
     std::filesystem::path path;
 
@@ -305,7 +314,17 @@ private:
     std::map<std::string, EnvironmentState> environment_states;
     std::map<std::string, ModuleState> module_states;
     SystemState system_state;
-    std::optional<std::map<std::string, std::set<std::string>>> package_groups_cache;
+    std::optional<std::map<std::string, std::set<std::string>, std::less<>>> package_groups_cache;
+
+    // Whether the corresponding toml file needs to be rewritten by save()
+    bool package_states_changed{false};
+    bool nevra_states_changed{false};
+    bool group_states_changed{false};
+    bool environment_states_changed{false};
+    bool module_states_changed{false};
+    bool system_state_changed{false};
+
+    uint64_t reasons_generation{0};
 };
 
 }  // namespace libdnf5::system
@@ -128,10 +128,11 @@ void CompsEnvironmentDbUtils::insert_transaction_comps_environments(
     libdnf5::utils::SQLite3 & conn, Transaction & trans) {
     auto query_comps_environment_insert = comps_environment_insert_new_query(conn);
     auto query_trans_item_insert = TransItemDbUtils::trans_item_insert_new_query(conn);
+    std::unordered_map<std::string, int64_t> repo_ids;
 
     for (auto & env : trans.get_comps_environments()) {
         comps_environment_insert(*query_comps_environment_insert, env);
-        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, env);
+        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, env, repo_ids);
         CompsEnvironmentGroupDbUtils::comps_environment_groups_insert(conn, env);
     }
 }
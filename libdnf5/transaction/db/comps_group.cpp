@@ -130,10 +130,11 @@ int64_t CompsGroupDbUtils::comps_group_insert(libdnf5::utils::SQLite3::Statement
 void CompsGroupDbUtils::insert_transaction_comps_groups(libdnf5::utils::SQLite3 & conn, Transaction & trans) {
     auto query_comps_group_insert = comps_group_insert_new_query(conn);
     auto query_trans_item_insert = TransItemDbUtils::trans_item_insert_new_query(conn);
+    std::unordered_map<std::string, int64_t> repo_ids;
 
     for (auto & grp : trans.get_comps_groups()) {
         comps_group_insert(*query_comps_group_insert, grp);
-        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, grp);
+        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, grp, repo_ids);
         CompsGroupPackageDbUtils::comps_group_packages_insert(conn, grp);
     }
 }
@@ -28,6 +28,9 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "libdnf5/transaction/rpm_package.hpp"
 #include "libdnf5/transaction/transaction.hpp"
 
+#include <algorithm>
+#include <unordered_set>
+
 
 namespace libdnf5::transaction {
 
@@ -66,6 +69,33 @@ static std::unique_ptr<libdnf5::utils::SQLite3::Query> rpm_transaction_item_sele
 }
 
 
+static constexpr const char * SQL_RPM_TRANSACTIONS_ITEM_SELECT = R"**(
+    SELECT
+        "ti"."id",
+        "ti"."trans_id",
+        "trans_item_action"."name" AS "action",
+        "trans_item_reason"."name" AS "reason",
+        "trans_item_state"."name" AS "state",
+        "r"."repoid",
+        "i"."item_id",
+        "pkg_name"."name",
+        "i"."epoch",
+        "i"."version",
+        "i"."release",
+        "arch"."name" AS "arch"
+    FROM "trans_item" "ti"
+    JOIN "repo" "r" ON "ti"."repo_id" = "r"."id"
+    JOIN "rpm" "i" USING ("item_id")
+    LEFT JOIN "trans_item_action" ON "ti"."action_id" = "trans_item_action"."id"
+    LEFT JOIN "trans_item_reason" ON "ti"."reason_id" = "trans_item_reason"."id"
+    LEFT JOIN "trans_item_state" ON "ti"."state_id" = "trans_item_state"."id"
+    LEFT JOIN "pkg_name" ON "i"."name_id" = "pkg_name"."id"
+    LEFT JOIN "arch" ON "i"."arch_id" = "arch"."id"
+    WHERE "ti"."trans_id" >= ? AND "ti"."trans_id" <= ?
+    ORDER BY "ti"."id"
+)**";
+
+
 int64_t RpmDbUtils::rpm_transaction_item_select(libdnf5::utils::SQLite3::Query & query, Package & pkg) {
     TransItemDbUtils::transaction_item_select(query, pkg);
     pkg.set_name(query.get<std::string>("name"));
@@ -177,6 +207,39 @@ std::vector<Package> RpmDbUtils::get_transaction_packages(libdnf5::utils::SQLite
 }
 
 
+std::unordered_map<int64_t, std::vector<Package>> RpmDbUtils::get_transactions_packages(
+    libdnf5::utils::SQLite3 & conn, std::vector<Transaction> & transactions) {
+    std::unordered_map<int64_t, std::vector<Package>> result;
+    if (transactions.empty()) {
+        return result;
+    }
+
+    // select the items of the whole range of ids and skip those of transactions that were not requested
+    std::unordered_map<int64_t, Transaction *> id_to_transaction;
+    auto [min_it, max_it] = std::minmax_element(
+        transactions.begin(), transactions.end(), [](const Transaction & lhs, const Transaction & rhs) {
+            return lhs.get_id() < rhs.get_id();
+        });
+    for (auto & trans : transactions) {
+        id_to_transaction.emplace(trans.get_id(), &trans);
+        result[trans.get_id()];
+    }
+
+    libdnf5::utils::SQLite3::Query query(conn, SQL_RPM_TRANSACTIONS_ITEM_SELECT);
+    query.bindv(min_it->get_id(), max_it->get_id());
+    while (query.step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
+        auto trans_it = id_to_transaction.find(query.get<int64_t>("trans_id"));
+        if (trans_it == id_to_transaction.end()) {
+            continue;
+        }
+        Package trans_item(*trans_it->second);
+        rpm_transaction_item_select(query, trans_item);
+        result[trans_it->first].push_back(std::move(trans_item));
+    }
+    return result;
+}
+
+
 void RpmDbUtils::insert_transaction_packages(libdnf5::utils::SQLite3 & conn, Transaction & trans) {
     auto query_rpm_select_pk = rpm_select_pk_new_query(conn);
     auto query_item_insert = item_insert_new_query(conn);
@@ -185,19 +248,28 @@ void RpmDbUtils::insert_transaction_packages(libdnf5::utils::SQLite3 & conn, Tra
     auto query_rpm_insert = rpm_insert_new_query(conn);
     auto query_trans_item_insert = TransItemDbUtils::trans_item_insert_new_query(conn);
 
+    // names, archs and repos already handled in this transaction are not looked up in the database again
+    std::unordered_set<std::string> inserted_names;
+    std::unordered_set<std::string> inserted_archs;
+    std::unordered_map<std::string, int64_t> repo_ids;
+
     for (auto & pkg : trans.get_packages()) {
         pkg.set_item_id(rpm_select_pk(*query_rpm_select_pk, pkg));
         if (pkg.get_item_id() == 0) {
             // insert into 'item' table, create item_id
             pkg.set_item_id(item_insert(*query_item_insert));
             // insert package name into 'pkg_name' table if not exists
-            pkg_name_insert_if_not_exists(*query_pkg_name_insert_if_not_exists, pkg.get_name());
+            if (inserted_names.insert(pkg.get_name()).second) {
+                pkg_name_insert_if_not_exists(*query_pkg_name_insert_if_not_exists, pkg.get_name());
+            }
             // insert arch name into 'arch' table if not exists
-            arch_insert_if_not_exists(*query_arch_insert_if_not_exists, pkg.get_arch());
+            if (inserted_archs.insert(pkg.get_arch()).second) {
+                arch_insert_if_not_exists(*query_arch_insert_if_not_exists, pkg.get_arch());
+            }
             // insert into 'rpm' table
             rpm_insert(*query_rpm_insert, pkg);
         }
-        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, pkg);
+        TransItemDbUtils::transaction_item_insert(*query_trans_item_insert, pkg, repo_ids);
     }
 }
 
@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils/sqlite3/sqlite3.hpp"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 
@@ -57,6 +58,12 @@ public:
     static std::vector<Package> get_transaction_packages(libdnf5::utils::SQLite3 & conn, Transaction & trans);
 
 
+    /// Return vectors of Package objects with packages in the transactions mapped by transaction ids.
+    /// All packages are selected with a single query.
+    static std::unordered_map<int64_t, std::vector<Package>> get_transactions_packages(
+        libdnf5::utils::SQLite3 & conn, std::vector<Transaction> & transactions);
+
+
     /// Insert Package objects associated with a transaction into the database
     static void insert_transaction_packages(libdnf5::utils::SQLite3 & conn, Transaction & trans);
 };
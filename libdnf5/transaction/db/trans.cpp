@@ -123,6 +123,37 @@ std::vector<Transaction> TransactionDbUtils::select_transactions_by_range(
 }
 
 
+// The NEVRA is matched in both forms, with and without the epoch
+static constexpr const char * SQL_WHERE_TRANS_WITH_PACKAGE = R"**(
+    WHERE "trans"."id" IN (
+        SELECT
+            "ti"."trans_id"
+        FROM "trans_item" "ti"
+        JOIN "rpm" "i" USING ("item_id")
+        JOIN "pkg_name" ON "i"."name_id" = "pkg_name"."id"
+        JOIN "arch" ON "i"."arch_id" = "arch"."id"
+        WHERE
+            "pkg_name"."name" GLOB ?1
+            OR "pkg_name"."name" || '-' || "i"."version" || '-' || "i"."release" || '.' || "arch"."name" GLOB ?1
+            OR "pkg_name"."name" || '-' || "i"."epoch" || ':' || "i"."version" || '-' || "i"."release" || '.' ||
+                "arch"."name" GLOB ?1
+    )
+)**";
+
+
+std::vector<Transaction> TransactionDbUtils::select_transactions_by_package(
+    const BaseWeakPtr & base, const std::string & pattern) {
+    auto conn = transaction_db_connect(*base);
+
+    std::string sql = std::string(select_sql) + SQL_WHERE_TRANS_WITH_PACKAGE;
+
+    auto query = libdnf5::utils::SQLite3::Query(*conn, sql);
+    query.bindv(pattern);
+
+    return TransactionDbUtils::load_from_select(base, query);
+}
+
+
 static constexpr const char * SQL_TRANS_INSERT = R"**(
     INSERT INTO
         "trans" (
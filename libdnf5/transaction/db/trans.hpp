@@ -51,6 +51,10 @@ public:
     /// Selects transactions with ids within the [start, end] range (inclusive).
     static std::vector<Transaction> select_transactions_by_range(const BaseWeakPtr & base, int64_t start, int64_t end);
 
+    /// Selects transactions with a package whose name or NEVRA matches the GLOB `pattern`.
+    static std::vector<Transaction> select_transactions_by_package(
+        const BaseWeakPtr & base, const std::string & pattern);
+
     /// Create a query for inserting records to the 'trans' table
     static std::unique_ptr<libdnf5::utils::SQLite3::Statement> trans_insert_new_query(libdnf5::utils::SQLite3 & conn);
 
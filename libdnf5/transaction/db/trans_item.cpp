@@ -69,15 +69,21 @@ std::unique_ptr<libdnf5::utils::SQLite3::Statement> TransItemDbUtils::trans_item
 }
 
 
-int64_t TransItemDbUtils::transaction_item_insert(libdnf5::utils::SQLite3::Statement & query, TransactionItem & ti) {
-    // try to find an existing repo
-    auto query_repo_select_pkg = repo_select_pk_new_query(query.get_db());
-    auto repo_id = repo_select_pk(*query_repo_select_pkg, ti.get_repoid());
-
+int64_t TransItemDbUtils::transaction_item_insert(
+    libdnf5::utils::SQLite3::Statement & query,
+    TransactionItem & ti,
+    std::unordered_map<std::string, int64_t> & repo_ids) {
+    auto & repo_id = repo_ids[ti.get_repoid()];
     if (!repo_id) {
-        // if an existing repo was not found, insert a new record
-        auto query_repo_insert = repo_insert_new_query(query.get_db());
-        repo_id = repo_insert(*query_repo_insert, ti.get_repoid());
+        // try to find an existing repo
+        auto query_repo_select_pkg = repo_select_pk_new_query(query.get_db());
+        repo_id = repo_select_pk(*query_repo_select_pkg, ti.get_repoid());
+
+        if (!repo_id) {
+            // if an existing repo was not found, insert a new record
+            auto query_repo_insert = repo_insert_new_query(query.get_db());
+            repo_id = repo_insert(*query_repo_insert, ti.get_repoid());
+        }
     }
 
     // save the transaction item
@@ -25,6 +25,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils/sqlite3/sqlite3.hpp"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 
 namespace libdnf5::transaction {
@@ -44,7 +46,11 @@ public:
 
 
     /// Use a query to insert a new record to the 'trans_item' table
-    static int64_t transaction_item_insert(libdnf5::utils::SQLite3::Statement & query, TransactionItem & ti);
+    /// @param repo_ids  Cache of ids of records in the 'repo' table, shared by the inserts of one transaction
+    static int64_t transaction_item_insert(
+        libdnf5::utils::SQLite3::Statement & query,
+        TransactionItem & ti,
+        std::unordered_map<std::string, int64_t> & repo_ids);
 };
 
 
@@ -20,6 +20,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "libdnf5/transaction/transaction_history.hpp"
 
+#include "db/db.hpp"
+#include "db/rpm.hpp"
 #include "db/trans.hpp"
 
 #include "libdnf5/base/base.hpp"
@@ -54,6 +56,18 @@ std::vector<Transaction> TransactionHistory::list_all_transactions() {
     return TransactionDbUtils::select_transactions_by_ids(base, {});
 }
 
+std::vector<Transaction> TransactionHistory::list_transactions_by_package(const std::string & pattern) {
+    return TransactionDbUtils::select_transactions_by_package(base, pattern);
+}
+
+void TransactionHistory::load_transactions_packages(std::vector<Transaction> & transactions) {
+    auto conn = transaction_db_connect(*base);
+    auto packages = RpmDbUtils::get_transactions_packages(*conn, transactions);
+    for (auto & trans : transactions) {
+        trans.packages = std::move(packages[trans.get_id()]);
+    }
+}
+
 BaseWeakPtr TransactionHistory::get_base() const {
     return base;
 }
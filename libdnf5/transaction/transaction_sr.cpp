@@ -50,6 +50,33 @@ public:
     const char * get_name() const noexcept override { return "TransactionReplayError"; }
 };
 
+namespace {
+
+// Returns the value of the `key` member of the `object` as a string, an empty string if the member is missing.
+std::string get_string_member(json_object * object, const char * key) {
+    json_object * value = nullptr;
+    if (json_object_object_get_ex(object, key, &value) == 0) {
+        return {};
+    }
+    if (json_object_is_type(value, json_type_string)) {
+        return std::string(json_object_get_string(value), static_cast<std::size_t>(json_object_get_string_len(value)));
+    }
+    const char * str = json_object_get_string(value);
+    return str ? str : "";
+}
+
+// The keys are string literals and each of them is added only once, json-c doesn't need to copy them
+// and to look for an existing member with the same key.
+void add_string_member(json_object * object, const char * key, const std::string & value) {
+    json_object_object_add_ex(
+        object,
+        key,
+        json_object_new_string_len(value.c_str(), static_cast<int>(value.size())),
+        JSON_C_OBJECT_ADD_KEY_IS_NEW | JSON_C_OBJECT_KEY_IS_CONSTANT);
+}
+
+}  // namespace
+
 TransactionReplay parse_transaction_replay(const std::string & json_serialized_transaction) {
     if (json_serialized_transaction.empty()) {
         throw TransactionReplayError(M_("Transaction replay JSON serialized transaction input is empty"));
@@ -80,24 +107,14 @@ TransactionReplay parse_transaction_replay(const std::string & json_serialized_t
     // PARSE ENVIRONMENTS
     struct json_object * json_environments = nullptr;
     if (json_object_object_get_ex(data, "environments", &json_environments) != 0) {
-        std::string action;
-        std::string environment_id;
-        std::string repo_id;
-
-        for (std::size_t i = 0; i < json_object_array_length(json_environments); ++i) {
+        const std::size_t count = json_object_array_length(json_environments);
+        transaction_replay.environments.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
             struct json_object * environment = json_object_array_get_idx(json_environments, i);
-            if (json_object_object_get_ex(environment, "action", &value) != 0) {
-                action = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(environment, "id", &value) != 0) {
-                environment_id = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(environment, "repo_id", &value) != 0) {
-                repo_id = json_object_get_string(value);
-            }
-
             transaction_replay.environments.push_back(
-                {transaction_item_action_from_string(action), environment_id, repo_id});
+                {transaction_item_action_from_string(get_string_member(environment, "action")),
+                 get_string_member(environment, "id"),
+                 get_string_member(environment, "repo_id")});
         }
     }
 
@@ -105,31 +122,15 @@ TransactionReplay parse_transaction_replay(const std::string & json_serialized_t
     // PARSE GROUPS
     struct json_object * json_groups = nullptr;
     if (json_object_object_get_ex(data, "groups", &json_groups) != 0) {
-        std::string action;
-        std::string group_id;
-        std::string reason;
-        std::string repo_id;
-
-        for (std::size_t i = 0; i < json_object_array_length(json_groups); ++i) {
+        const std::size_t count = json_object_array_length(json_groups);
+        transaction_replay.groups.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
             struct json_object * group = json_object_array_get_idx(json_groups, i);
-            if (json_object_object_get_ex(group, "action", &value) != 0) {
-                action = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(group, "reason", &value) != 0) {
-                reason = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(group, "id", &value) != 0) {
-                group_id = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(group, "repo_id", &value) != 0) {
-                repo_id = json_object_get_string(value);
-            }
-
             transaction_replay.groups.push_back(
-                {transaction_item_action_from_string(action),
-                 transaction_item_reason_from_string(reason),
-                 group_id,
-                 repo_id});
+                {transaction_item_action_from_string(get_string_member(group, "action")),
+                 transaction_item_reason_from_string(get_string_member(group, "reason")),
+                 get_string_member(group, "id"),
+                 get_string_member(group, "repo_id")});
         }
     }
 
@@ -137,41 +138,17 @@ TransactionReplay parse_transaction_replay(const std::string & json_serialized_t
     // PARSE PACKAGES
     struct json_object * json_packages = nullptr;
     if (json_object_object_get_ex(data, "rpms", &json_packages) != 0) {
-        std::string action;
-        std::string nevra;
-        std::string reason;
-        std::string repo_id;
-        std::string group_id;
-        std::string package_path;
-
-        for (std::size_t i = 0; i < json_object_array_length(json_packages); ++i) {
+        const std::size_t count = json_object_array_length(json_packages);
+        transaction_replay.packages.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
             struct json_object * package = json_object_array_get_idx(json_packages, i);
-            if (json_object_object_get_ex(package, "action", &value) != 0) {
-                action = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(package, "reason", &value) != 0) {
-                reason = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(package, "group_id", &value) != 0) {
-                group_id = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(package, "nevra", &value) != 0) {
-                nevra = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(package, "package_path", &value) != 0) {
-                package_path = json_object_get_string(value);
-            }
-            if (json_object_object_get_ex(package, "repo_id", &value) != 0) {
-                repo_id = json_object_get_string(value);
-            }
-
             transaction_replay.packages.push_back(
-                {transaction_item_action_from_string(action),
-                 transaction_item_reason_from_string(reason),
-                 group_id,
-                 nevra,
-                 package_path,
-                 repo_id});
+                {transaction_item_action_from_string(get_string_member(package, "action")),
+                 transaction_item_reason_from_string(get_string_member(package, "reason")),
+                 get_string_member(package, "group_id"),
+                 get_string_member(package, "nevra"),
+                 get_string_member(package, "package_path"),
+                 get_string_member(package, "repo_id")});
         }
     }
 
@@ -191,17 +168,15 @@ std::string json_serialize(const TransactionReplay & transaction_replay) {
         json_object * json_packages = json_object_new_array_ext(static_cast<int>(count));
         for (const auto & pkg : transaction_replay.packages) {
             json_object * json_package = json_object_new_object();
-            json_object_object_add(json_package, "nevra", json_object_new_string(pkg.nevra.c_str()));
-            json_object_object_add(
-                json_package, "action", json_object_new_string(transaction_item_action_to_string(pkg.action).c_str()));
-            json_object_object_add(
-                json_package, "reason", json_object_new_string(transaction_item_reason_to_string(pkg.reason).c_str()));
-            json_object_object_add(json_package, "repo_id", json_object_new_string(pkg.repo_id.c_str()));
+            add_string_member(json_package, "nevra", pkg.nevra);
+            add_string_member(json_package, "action", transaction_item_action_to_string(pkg.action));
+            add_string_member(json_package, "reason", transaction_item_reason_to_string(pkg.reason));
+            add_string_member(json_package, "repo_id", pkg.repo_id);
             if (!pkg.package_path.empty()) {
-                json_object_object_add(json_package, "package_path", json_object_new_string(pkg.package_path.c_str()));
+                add_string_member(json_package, "package_path", pkg.package_path.native());
             }
             if (!pkg.group_id.empty()) {
-                json_object_object_add(json_package, "group_id", json_object_new_string(pkg.group_id.c_str()));
+                add_string_member(json_package, "group_id", pkg.group_id);
             }
 
             json_object_array_add(json_packages, json_package);
@@ -217,12 +192,10 @@ std::string json_serialize(const TransactionReplay & transaction_replay) {
         json_object * json_groups = json_object_new_array_ext(static_cast<int>(count));
         for (const auto & group : transaction_replay.groups) {
             json_object * json_group = json_object_new_object();
-            json_object_object_add(json_group, "id", json_object_new_string(group.group_id.c_str()));
-            json_object_object_add(
-                json_group, "action", json_object_new_string(transaction_item_action_to_string(group.action).c_str()));
-            json_object_object_add(
-                json_group, "reason", json_object_new_string(transaction_item_reason_to_string(group.reason).c_str()));
-            json_object_object_add(json_group, "repo_id", json_object_new_string(group.repo_id.c_str()));
+            add_string_member(json_group, "id", group.group_id);
+            add_string_member(json_group, "action", transaction_item_action_to_string(group.action));
+            add_string_member(json_group, "reason", transaction_item_reason_to_string(group.reason));
+            add_string_member(json_group, "repo_id", group.repo_id);
             json_object_array_add(json_groups, json_group);
         }
         json_object_object_add(root, "groups", json_groups);
@@ -236,12 +209,9 @@ std::string json_serialize(const TransactionReplay & transaction_replay) {
         json_object * json_environments = json_object_new_array_ext(static_cast<int>(count));
         for (const auto & environment : transaction_replay.environments) {
             json_object * json_environment = json_object_new_object();
-            json_object_object_add(json_environment, "id", json_object_new_string(environment.environment_id.c_str()));
-            json_object_object_add(
-                json_environment,
-                "action",
-                json_object_new_string(transaction_item_action_to_string(environment.action).c_str()));
-            json_object_object_add(json_environment, "repo_id", json_object_new_string(environment.repo_id.c_str()));
+            add_string_member(json_environment, "id", environment.environment_id);
+            add_string_member(json_environment, "action", transaction_item_action_to_string(environment.action));
+            add_string_member(json_environment, "repo_id", environment.repo_id);
 
             json_object_array_add(json_environments, json_environment);
         }
@@ -252,7 +222,7 @@ std::string json_serialize(const TransactionReplay & transaction_replay) {
     ////TODO(amatej): potentially add modules
 
     std::string version = std::string(VERSION_MAJOR) + "." + std::string(VERSION_MINOR);
-    json_object_object_add(root, "version", json_object_new_string(version.c_str()));
+    add_string_member(root, "version", version);
 
     auto json = std::string(json_object_to_json_string_ext(root, JSON_C_TO_STRING_PRETTY));
 
@@ -214,11 +214,13 @@ bool Dnf4Convert::read_package_states_from_history(
 
         auto query_environments =
             std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_CURRENTLY_INSTALLED_ENVIRONMENTS);
+        // The statements for the members of groups and environments are prepared once and reset for each item
+        auto grps_query = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_ENVIRONMENT_GROUPS);
         std::set<std::string> groups_in_environments;
         while (query_environments->step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
             auto environment_id = query_environments->get<std::string>("environmentid");
             auto item_id = query_environments->get<int64_t>("item_id");
-            auto grps_query = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_ENVIRONMENT_GROUPS);
+            grps_query->reset();
             grps_query->bindv(item_id);
             std::set<std::string> groups;
             while (grps_query->step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
@@ -230,11 +232,12 @@ bool Dnf4Convert::read_package_states_from_history(
         }
 
         auto query_groups = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_CURRENTLY_INSTALLED_GROUPS);
+        auto pkgs_query = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_GROUP_PACKAGES);
         while (query_groups->step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
             auto group_id = query_groups->get<std::string>("groupid");
             auto item_id = query_groups->get<int64_t>("item_id");
             auto pkg_types = query_groups->get<int64_t>("pkg_types");
-            auto pkgs_query = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_GROUP_PACKAGES);
+            pkgs_query->reset();
             pkgs_query->bindv(item_id);
             std::set<std::string> packages;
             while (pkgs_query->step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
@@ -254,15 +257,23 @@ bool Dnf4Convert::read_package_states_from_history(
         }
 
         auto query_pkgs = std::make_unique<libdnf5::utils::SQLite3::Query>(*conn, SQL_CURRENTLY_INSTALLED_PACKAGES);
+        // The query returns a row for each installed package, look up the column indexes only once
+        const int reason_idx = query_pkgs->get_column_index("reason");
+        const int repoid_idx = query_pkgs->get_column_index("repoid");
+        const int name_idx = query_pkgs->get_column_index("name");
+        const int epoch_idx = query_pkgs->get_column_index("epoch");
+        const int version_idx = query_pkgs->get_column_index("version");
+        const int release_idx = query_pkgs->get_column_index("release");
+        const int arch_idx = query_pkgs->get_column_index("arch");
         while (query_pkgs->step() == libdnf5::utils::SQLite3::Statement::StepResult::ROW) {
-            auto reason = static_cast<transaction::TransactionItemReason>(query_pkgs->get<int>("reason"));
-            auto repo_id = query_pkgs->get<std::string>("repoid");
+            auto reason = static_cast<transaction::TransactionItemReason>(query_pkgs->get<int>(reason_idx));
+            auto repo_id = query_pkgs->get<std::string>(repoid_idx);
             rpm::Nevra pkg_nevra;
-            pkg_nevra.set_name(query_pkgs->get<std::string>("name"));
-            pkg_nevra.set_epoch(query_pkgs->get<std::string>("epoch"));
-            pkg_nevra.set_version(query_pkgs->get<std::string>("version"));
-            pkg_nevra.set_release(query_pkgs->get<std::string>("release"));
-            pkg_nevra.set_arch(query_pkgs->get<std::string>("arch"));
+            pkg_nevra.set_name(query_pkgs->get<std::string>(name_idx));
+            pkg_nevra.set_epoch(query_pkgs->get<std::string>(epoch_idx));
+            pkg_nevra.set_version(query_pkgs->get<std::string>(version_idx));
+            pkg_nevra.set_release(query_pkgs->get<std::string>(release_idx));
+            pkg_nevra.set_arch(query_pkgs->get<std::string>(arch_idx));
 
             installed_packages_names.insert(pkg_nevra.get_name());
             installed_packages.emplace_back(pkg_nevra, reason, repo_id);
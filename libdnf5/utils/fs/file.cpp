@@ -29,6 +29,9 @@ extern "C" {
 #include <solv/solv_xfopen.h>
 }
 
+#include <sys/stat.h>
+
+#include <algorithm>
 #include <cstdio>
 
 
@@ -224,8 +227,32 @@ bool File::is_at_eof() const {
 
 
 std::string File::read(std::size_t count) {
-    // TODO(pkratoch): This fails for compressed files. Add a fallback for this method that doesn't need ftell and
-    // fseek. It can be then used in libdnf5::Repo::load_available_repo for loading modules.yaml.gz.
+    libdnf_assert_file_open();
+
+    // Streams that are not regular files cannot be sized by seeking (e.g. compressed files opened using
+    // solv_xfopen, pipes), read them in growing chunks directly into the resulting string.
+    struct stat file_stat;
+    auto fd = fileno(file);
+    if (fd < 0 || fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+        constexpr std::size_t min_chunk_size = 65536;
+        std::string res;
+        std::size_t to_read = count == 0 ? min_chunk_size : std::min(count, min_chunk_size);
+        while (to_read > 0) {
+            auto old_size = res.size();
+            res.resize(old_size + to_read);
+            std::size_t size = read(res.data() + old_size, to_read);
+            res.resize(old_size + size);
+            if (size < to_read) {
+                break;
+            }
+            to_read = std::max(res.size(), min_chunk_size);
+            if (count != 0) {
+                to_read = std::min(to_read, count - res.size());
+            }
+        }
+        return res;
+    }
+
     long cur_pos = tell();
     seek(0, SEEK_END);
     std::size_t length_till_end = static_cast<std::size_t>(tell() - cur_pos);
@@ -20,6 +20,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils.hpp"
 
 #include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -85,6 +87,73 @@ void move_recursive(const std::filesystem::path & src, const std::filesystem::pa
     }
 }
 
+bool reflink_file(const std::filesystem::path & src, const std::filesystem::path & dest) noexcept {
+#ifdef FICLONE
+    int src_fd = open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd == -1) {
+        return false;
+    }
+    struct stat src_stat;
+    if (fstat(src_fd, &src_stat) == -1) {
+        close(src_fd);
+        return false;
+    }
+    int dest_fd = open(dest.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, src_stat.st_mode & 0777);
+    if (dest_fd == -1) {
+        close(src_fd);
+        return false;
+    }
+    bool cloned = ioctl(dest_fd, FICLONE, src_fd) == 0;
+    close(dest_fd);
+    close(src_fd);
+    if (!cloned) {
+        unlink(dest.c_str());
+    }
+    return cloned;
+#else
+    (void)src;
+    (void)dest;
+    return false;
+#endif
+}
+
+
+void clone_directory_files(const std::filesystem::path & src, const std::filesystem::path & dest) {
+    for (const auto & dentry : stdfs::directory_iterator(src)) {
+        if (!dentry.is_regular_file()) {
+            continue;
+        }
+        const auto & src_path = dentry.path();
+        auto dest_path = dest / src_path.filename();
+        std::error_code ec;
+        if (reflink_file(src_path, dest_path)) {
+            continue;
+        }
+        stdfs::create_hard_link(src_path, dest_path, ec);
+        if (!ec) {
+            continue;
+        }
+        stdfs::copy_file(src_path, dest_path, stdfs::copy_options::overwrite_existing);
+    }
+}
+
+void break_hard_link(const std::filesystem::path & path) {
+    struct stat path_stat;
+    if (stat(path.c_str(), &path_stat) == -1 || path_stat.st_nlink <= 1) {
+        return;
+    }
+    auto tmp_path = path;
+    tmp_path += ".unlink";
+    stdfs::remove(tmp_path);
+    if (!reflink_file(path, tmp_path)) {
+        stdfs::copy_file(path, tmp_path);
+    }
+    // the copy gets the timestamps of the original, the cache expiration depends on them
+    struct timespec times[2] = {path_stat.st_atim, path_stat.st_mtim};
+    utimensat(AT_FDCWD, tmp_path.c_str(), times, 0);
+    stdfs::rename(tmp_path, path);
+}
+
 [[nodiscard]] std::vector<std::filesystem::path> create_sorted_file_list(
     const std::vector<std::filesystem::path> & directories, std::string_view file_extension) {
     std::vector<stdfs::path> paths;
@@ -37,6 +37,21 @@ namespace libdnf5::utils::fs {
 /// Implements copy and remove fallback.
 void move_recursive(const std::filesystem::path & src, const std::filesystem::path & dest);
 
+/// Creates `dest` as a reflink of `src` which shares the data blocks with it until one of them is modified.
+/// Returns `false` if the filesystem does not support it or `dest` already exists.
+bool reflink_file(const std::filesystem::path & src, const std::filesystem::path & dest) noexcept;
+
+/// Copies the regular files from the `src` directory to the existing `dest` directory, subdirectories are skipped.
+/// Each file is cloned using a reflink if the filesystem supports it, otherwise it is hardlinked, and only
+/// if neither is possible its content is copied. A hardlinked file shares its content and its metadata
+/// (timestamps, permissions) with the source. It can be replaced, but before it is modified in place
+/// or its timestamps are changed, the link must be broken by `break_hard_link()`.
+void clone_directory_files(const std::filesystem::path & src, const std::filesystem::path & dest);
+
+/// Replaces the file at `path` with its own copy (a reflink if possible) if it has more than one hard link.
+/// Afterwards, the file and its metadata can be changed without affecting the other links.
+void break_hard_link(const std::filesystem::path & path);
+
 // Creates an alphabetically sorted list of all files with `file_extension` from `directories`.
 // If a file with the same name is in multiple directories, only the first file found is added to the list.
 // Directories are traversed in the same order as they are in the input vector.
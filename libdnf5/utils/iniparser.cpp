@@ -20,6 +20,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils/iniparser.hpp"
 
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
+#include "libdnf5/utils/fs/file.hpp"
 
 namespace libdnf5 {
 
@@ -28,13 +29,9 @@ constexpr char DELIMITER = '\n';
 namespace {
 
 // Returns the position of the first ']' character that does not define a list/range.
-std::size_t find_end_of_section_name(const std::string & str, std::size_t pos) {
-    if (pos >= str.size()) {
-        return std::string::npos;
-    }
-
+std::size_t find_end_of_section_name(std::string_view str, std::size_t pos) {
     bool range = false;
-    for (std::size_t idx = pos;; ++idx) {
+    for (std::size_t idx = pos; idx < str.size(); ++idx) {
         const auto ch = str[idx];
         if (ch == ']') {
             if (range) {
@@ -48,11 +45,47 @@ std::size_t find_end_of_section_name(const std::string & str, std::size_t pos) {
             return std::string::npos;
         }
     }
+    return std::string::npos;
+}
+
+// Replaces the content of `dst` with the `line` followed by the DELIMITER.
+void assign_line(std::string & dst, std::string_view line) {
+    dst.clear();
+    dst.reserve(line.size() + 1);
+    dst.append(line);
+    dst += DELIMITER;
 }
 
 }  // namespace
 
-IniParser::IniParser(const std::string & file_path) : file(file_path, "r") {}
+IniParser::IniParser(const std::string & file_path) {
+    constexpr std::size_t CHUNK_SIZE = 4096;
+    utils::fs::File file(file_path, "r");
+    std::size_t size = 0;
+    std::size_t read;
+    do {
+        content.resize(size + CHUNK_SIZE);
+        read = file.read(content.data() + size, CHUNK_SIZE);
+        size += read;
+    } while (read == CHUNK_SIZE);
+    content.resize(size);
+}
+
+bool IniParser::read_line() noexcept {
+    if (content_pos >= content.size()) {
+        return false;
+    }
+    auto end = content.find(DELIMITER, content_pos);
+    if (end == std::string::npos) {
+        end = content.size();
+    }
+    line = std::string_view(content).substr(content_pos, end - content_pos);
+    content_pos = end + 1;
+    while (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return true;
+}
 
 void IniParser::trim_value() noexcept {
     auto end = value.find_last_not_of(DELIMITER);
@@ -70,7 +103,7 @@ IniParser::ItemType IniParser::next() {
     raw_item.clear();
     while (true) {
         if (!line_ready) {
-            if (!file.read_line(line)) {
+            if (!read_line()) {
                 if (previous_line_with_key_val) {
                     trim_value();
                     return ItemType::KEY_VAL;
@@ -84,7 +117,7 @@ IniParser::ItemType IniParser::next() {
         // remove UTF-8 BOM (Byte order mark)
         constexpr const char * utf8_bom = "\xEF\xBB\xBF";
         if (line_number == 1 && line.compare(0, 3, utf8_bom) == 0) {
-            line.erase(0, 3);
+            line.remove_prefix(3);
         }
 
         if (line.empty() || line[0] == '#' || line[0] == ';') {  // do not support [rR][eE][mM] comment
@@ -97,7 +130,7 @@ IniParser::ItemType IniParser::next() {
                 raw_item = DELIMITER;
                 return ItemType::EMPTY_LINE;
             }
-            raw_item = line + DELIMITER;
+            assign_line(raw_item, line);
             line_ready = false;
             return ItemType::COMMENT_LINE;
         }
@@ -105,11 +138,12 @@ IniParser::ItemType IniParser::next() {
         if (start == std::string::npos) {
             if (previous_line_with_key_val) {
                 value += DELIMITER;
-                raw_item += line + DELIMITER;
+                raw_item.append(line);
+                raw_item += DELIMITER;
                 line_ready = false;
                 continue;
             }
-            raw_item = line + DELIMITER;
+            assign_line(raw_item, line);
             line_ready = false;
             return ItemType::EMPTY_LINE;
         }
@@ -137,8 +171,8 @@ IniParser::ItemType IniParser::next() {
                     throw IniParserTextAfterSectionError(M_("Text after section on line {}"), line_number);
                 }
             }
-            this->section = line.substr(start, end_sect_pos - start);
-            raw_item = line + DELIMITER;
+            this->section.assign(line.substr(start, end_sect_pos - start));
+            assign_line(raw_item, line);
             line_ready = false;
             return ItemType::SECTION;
         }
@@ -151,8 +185,10 @@ IniParser::ItemType IniParser::next() {
             if (!previous_line_with_key_val) {
                 throw IniParserIllegalContinuationLineError(M_("Illegal continuation line on line {}"), line_number);
             }
-            value += DELIMITER + line.substr(start, end - start + 1);
-            raw_item += line + DELIMITER;
+            value += DELIMITER;
+            value.append(line.substr(start, end - start + 1));
+            raw_item.append(line);
+            raw_item += DELIMITER;
             line_ready = false;
         } else {
             if (line[start] == '=') {
@@ -164,14 +200,14 @@ IniParser::ItemType IniParser::next() {
             }
             auto endkeypos = line.find_last_not_of(" \t", eql_pos - 1);
             auto valuepos = line.find_first_not_of(" \t", eql_pos + 1);
-            key = line.substr(start, endkeypos - start + 1);
+            key.assign(line.substr(start, endkeypos - start + 1));
             if (valuepos != std::string::npos) {
-                value = line.substr(valuepos, end - valuepos + 1);
+                value.assign(line.substr(valuepos, end - valuepos + 1));
             } else {
                 value.clear();
             }
             previous_line_with_key_val = true;
-            raw_item = line + DELIMITER;
+            assign_line(raw_item, line);
             line_ready = false;
         }
     }
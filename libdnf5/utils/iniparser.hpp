@@ -21,10 +21,10 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #define LIBDNF5_UTILS_INIPARSER_HPP
 
 #include "libdnf5/common/exception.hpp"
-#include "libdnf5/utils/fs/file.hpp"
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 
 namespace libdnf5 {
@@ -84,6 +84,7 @@ public:
 ///
 /// IniParser is lowlevel one pass parser of .ini files designed primary for DNF .ini configuration files.
 /// It parses input text to tokens - SECTION, KEY_VAL, COMMENT_LINE, EMPTY_LINE, and END_OF_INPUT.
+/// The whole file is read into memory at once in the constructor, the lines are views into this buffer.
 class IniParser {
 public:
     enum class ItemType {
@@ -111,18 +112,23 @@ public:
     std::string & get_value() noexcept;
     const std::string & get_raw_item() const noexcept;
     std::string & get_raw_item() noexcept;
-    const std::string & get_line() const noexcept;
+    std::string_view get_line() const noexcept;
     void clear_line() noexcept;
     void trim_value() noexcept;
 
 private:
-    utils::fs::File file;
+    /// Sets `line` to the next line of the input without the line ending.
+    /// @return `false` if the end of the input was reached
+    bool read_line() noexcept;
+
+    std::string content;
+    std::size_t content_pos{0};
     int line_number{0};
     std::string section;
     std::string key;
     std::string value;
     std::string raw_item;
-    std::string line;
+    std::string_view line;
     bool line_ready{false};
 };
 
@@ -147,11 +153,11 @@ inline const std::string & IniParser::get_raw_item() const noexcept {
 inline std::string & IniParser::get_raw_item() noexcept {
     return raw_item;
 }
-inline const std::string & IniParser::get_line() const noexcept {
+inline std::string_view IniParser::get_line() const noexcept {
     return line;
 }
 inline void IniParser::clear_line() noexcept {
-    line.clear();
+    line = {};
 }
 
 }  // namespace libdnf5
@@ -67,7 +67,7 @@ void Locker::unlock() {
         if (close(lock_fd) == -1) {
             throw SystemError(errno, M_("Failed to close lock file \"{}\""), path);
         }
-        if (unlink(path.c_str()) == -1) {
+        if (!keep_file && unlink(path.c_str()) == -1) {
             throw SystemError(errno, M_("Failed to delete lock file \"{}\""), path);
         }
     }
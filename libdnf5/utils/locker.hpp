@@ -27,6 +27,9 @@ namespace libdnf5::utils {
 class Locker {
 public:
     explicit Locker(const std::string & path) : path(path){};
+    /// With `keep_file` the lock file is not deleted on unlock. Use it for shared (read) locks,
+    /// deleting the file would let a new writer lock a new file while other readers still hold the old one.
+    Locker(const std::string & path, bool keep_file) : path(path), keep_file(keep_file){};
     ~Locker();
     bool read_lock();
     bool write_lock();
@@ -36,6 +39,7 @@ private:
     bool lock(short int type);
 
     std::string path;
+    bool keep_file{false};
     int lock_fd{-1};
 };
 
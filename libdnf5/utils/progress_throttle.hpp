@@ -0,0 +1,57 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation, either version 2.1 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBDNF5_UTILS_PROGRESS_THROTTLE_HPP
+#define LIBDNF5_UTILS_PROGRESS_THROTTLE_HPP
+
+#include <chrono>
+
+namespace libdnf5::utils {
+
+/// Coalesces the progress notifications of a single item (a downloaded file, an installed package).
+/// A notification is passed on if at least `min_interval` has elapsed since the last passed one,
+/// or if it reports the completion of the item. A zero interval passes all notifications.
+class ProgressThrottle {
+public:
+    explicit ProgressThrottle(std::chrono::milliseconds min_interval = {}) noexcept : min_interval(min_interval) {}
+
+    /// Starts a new item, its first notification is always passed on.
+    void reset() noexcept { last_notification = {}; }
+
+    /// @return `true` if the notification about the `amount` of `total` should be passed on.
+    bool should_notify(double amount, double total) noexcept {
+        if (min_interval.count() <= 0) {
+            return true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if ((total > 0 && amount >= total) || now - last_notification >= min_interval) {
+            last_notification = now;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::chrono::milliseconds min_interval;
+    std::chrono::steady_clock::time_point last_notification{};
+};
+
+}  // namespace libdnf5::utils
+
+#endif
@@ -0,0 +1,143 @@
+#!/bin/bash
+
+
+function usage() {
+    echo "usage: $(basename $0) <dnf5-binary> <repos-directory> <results.csv> [<baseline.csv>]"
+    echo
+    echo "Runs dnf5 commands against the repositories in the subdirectories of <repos-directory>"
+    echo "within a temporary installroot and writes wall time, CPU time, peak RSS and I/O counts"
+    echo "of each scenario to <results.csv>. The standard error output of the scenarios is kept in"
+    echo "<results>.stderr.log next to it. If a scenario fails, the script exits with 1 after writing"
+    echo "the results. If <baseline.csv> (results of a previous run) is given, scenarios whose wall time"
+    echo "or peak RSS grew by more than BENCHMARK_THRESHOLD percent (default 10) are reported and"
+    echo "the script exits with 2."
+    echo
+    echo "Large repositories for the scenarios can be generated by test/data/generate-synthetic-repo.py."
+    echo
+    echo "Environment variables:"
+    echo "    BENCHMARK_SEARCH_TERM   the term for the search scenario (default: pkg)"
+    echo "    BENCHMARK_INSTALL_SPEC  the spec for the install scenario (default: pkg-0)"
+    echo "    BENCHMARK_THRESHOLD     the allowed growth in percent (default: 10)"
+}
+
+
+case "$1" in
+    "-h" | "--help")
+        usage
+        exit 0
+        ;;
+esac
+
+if [ $# -lt 3 ] || [ $# -gt 4 ]; then
+    usage
+    exit 1
+fi
+
+
+DNF5="$1"
+REPOS_DIRECTORY=$(readlink -f "$2")
+RESULTS="$3"
+BASELINE="$4"
+STDERR_LOG="${RESULTS%.csv}.stderr.log"
+
+SEARCH_TERM="${BENCHMARK_SEARCH_TERM:-pkg}"
+INSTALL_SPEC="${BENCHMARK_INSTALL_SPEC:-pkg-0}"
+THRESHOLD="${BENCHMARK_THRESHOLD:-10}"
+
+if [ ! -x /usr/bin/time ]; then
+    echo "/usr/bin/time (GNU time) is required" >&2
+    exit 1
+fi
+
+
+INSTALLROOT=$(mktemp -d)
+trap "rm -rf '${INSTALLROOT}'" EXIT
+
+# configure every subdirectory of the repos directory as a repository
+mkdir -p "${INSTALLROOT}/etc/yum.repos.d"
+for REPO_PATH in "${REPOS_DIRECTORY}"/*/; do
+    REPO_ID=$(basename "${REPO_PATH}")
+    cat > "${INSTALLROOT}/etc/yum.repos.d/${REPO_ID}.repo" <<REPO
+[${REPO_ID}]
+name=${REPO_ID}
+baseurl=file://${REPO_PATH}
+gpgcheck=0
+REPO
+done
+
+DNF5_OPTIONS=(
+    "--installroot=${INSTALLROOT}"
+    "--releasever=benchmark"
+    "--setopt=reposdir=${INSTALLROOT}/etc/yum.repos.d"
+    "--setopt=cachedir=${INSTALLROOT}/cache"
+)
+
+
+FAILED_SCENARIOS=()
+
+# runs the dnf5 subcommand and appends the measured values and the exit code to the results
+# scenarios answering the transaction with --assumeno may also end with the "aborted by the user" error
+function run_scenario() {
+    SCENARIO="$1"
+    shift
+    MEASUREMENT=$(mktemp)
+    STDERR=$(mktemp)
+    /usr/bin/time --quiet -o "${MEASUREMENT}" -f "%e,%U,%S,%M,%I,%O,%w,%c" \
+        "${DNF5}" "${DNF5_OPTIONS[@]}" "$@" > /dev/null 2> "${STDERR}"
+    EXIT_CODE=$?
+    echo "${SCENARIO},$(tail -n 1 "${MEASUREMENT}"),${EXIT_CODE}" >> "${RESULTS}"
+
+    echo "=== ${SCENARIO}: exit code ${EXIT_CODE}" >> "${STDERR_LOG}"
+    cat "${STDERR}" >> "${STDERR_LOG}"
+
+    if [ ${EXIT_CODE} -ne 0 ]; then
+        if [[ ! " $* " =~ " --assumeno " ]] || [ ${EXIT_CODE} -ne 1 ] || \
+           ! grep -q "Operation aborted by the user." "${STDERR}"; then
+            FAILED_SCENARIOS+=("${SCENARIO}")
+        fi
+    fi
+    rm -f "${MEASUREMENT}" "${STDERR}"
+}
+
+
+echo "scenario,wall_s,user_s,sys_s,max_rss_kb,fs_inputs,fs_outputs,voluntary_switches,involuntary_switches,exit_code" \
+    > "${RESULTS}"
+: > "${STDERR_LOG}"
+
+run_scenario makecache_cold makecache
+run_scenario makecache_warm makecache
+run_scenario repoquery repoquery --available
+run_scenario list list --available
+run_scenario search search "${SEARCH_TERM}"
+run_scenario install install --assumeno "${INSTALL_SPEC}"
+run_scenario upgrade upgrade --assumeno
+run_scenario history_list history list
+
+cat "${RESULTS}"
+
+if [ ${#FAILED_SCENARIOS[@]} -gt 0 ]; then
+    echo "failed scenarios: ${FAILED_SCENARIOS[*]} (see ${STDERR_LOG})" >&2
+    exit 1
+fi
+
+if [ -z "${BASELINE}" ]; then
+    exit 0
+fi
+
+# compares the wall time and the peak RSS of the scenarios present in both files
+awk -F, -v threshold="${THRESHOLD}" '
+    FNR == 1 { next }
+    NR == FNR { base_wall[$1] = $2; base_rss[$1] = $5; next }
+    ($1 in base_wall) {
+        limit = 1 + threshold / 100
+        if (base_wall[$1] > 0 && $2 > base_wall[$1] * limit) {
+            printf "%s: wall time %ss, baseline %ss\n", $1, $2, base_wall[$1]
+            regressions++
+        }
+        if (base_rss[$1] > 0 && $5 > base_rss[$1] * limit) {
+            printf "%s: peak RSS %s kB, baseline %s kB\n", $1, $5, base_rss[$1]
+            regressions++
+        }
+    }
+    END { exit regressions > 0 ? 2 : 0 }
+' "${BASELINE}" "${RESULTS}"
@@ -0,0 +1,306 @@
+#!/usr/bin/python3
+
+"""
+Generates repodata (primary, filelists, other, updateinfo and optionally modules)
+of a repository with synthetic packages without building any RPMs.
+
+The packages are called pkg-<number>[-<word>...], pkg-0 is always called just pkg-0.
+Each package requires packages and shared libraries provided by packages with lower
+numbers, so every package is installable. The dependency fan-out, the number of files,
+the length of the names and the advisory coverage follow randomized distributions
+similar to the distribution repositories. The output is reproducible for a given seed.
+"""
+
+
+import argparse
+import gzip
+import hashlib
+import math
+import os
+import random
+from xml.sax.saxutils import escape, quoteattr
+
+
+WORDS = [
+    "libs", "devel", "common", "tools", "utils", "data", "doc", "server", "client", "core",
+    "plugin", "python3", "perl", "static", "headers", "cli", "gui", "config", "extras", "runtime",
+]
+
+FILE_DIRS = ["/usr/bin", "/usr/lib64", "/usr/share/doc", "/usr/share/man/man1", "/etc", "/usr/share"]
+
+ADVISORY_TYPES = [("bugfix", 0.5), ("enhancement", 0.25), ("security", 0.25)]
+SEVERITIES = ["Low", "Moderate", "Important", "Critical"]
+
+
+def lognormal_int(rng, median, sigma, low, high):
+    return max(low, min(high, int(round(rng.lognormvariate(math.log(median), sigma)))))
+
+
+def weighted_choice(rng, choices):
+    value = rng.random()
+    for choice, weight in choices:
+        value -= weight
+        if value < 0:
+            return choice
+    return choices[-1][0]
+
+
+class Package:
+    def __init__(self, rng, idx, name_prefix, arch, library_providers):
+        self.idx = idx
+        suffix_words = 0 if idx == 0 else min(int(rng.expovariate(1.2)), 4)
+        self.short_name = "{}-{}".format(name_prefix, idx)
+        self.name = self.short_name
+        for _ in range(suffix_words):
+            self.name += "-" + rng.choice(WORDS)
+        self.epoch = "1" if rng.random() < 0.05 else "0"
+        self.version = "{}.{}.{}".format(rng.randint(0, 20), rng.randint(0, 30), rng.randint(0, 10))
+        self.release = "{}.fc99".format(rng.randint(1, 30))
+        self.arch = "noarch" if rng.random() < 0.2 else arch
+        self.pkgid = hashlib.sha256(self.nevra().encode()).hexdigest()
+        self.summary = "Synthetic package number {}".format(idx)
+        self.size = lognormal_int(rng, 200000, 1.5, 1000, 500000000)
+
+        self.provides_library = None
+        if self.arch != "noarch" and rng.random() < 0.25:
+            self.provides_library = "lib{}.so.{}()(64bit)".format(self.name, rng.randint(0, 9))
+
+        # requires only packages and libraries with lower numbers, the dependency graph has no cycles
+        self.requires = []
+        if idx > 0:
+            for _ in range(lognormal_int(rng, 3, 0.8, 0, 60)):
+                if library_providers and rng.random() < 0.4:
+                    self.requires.append(rng.choice(library_providers))
+                else:
+                    self.requires.append("{}-{}".format(name_prefix, rng.randrange(idx)))
+            self.requires = sorted(set(self.requires))
+        if self.provides_library:
+            library_providers.append(self.provides_library)
+
+        self.files = []
+        for file_idx in range(lognormal_int(rng, 12, 1.3, 1, 5000)):
+            directory = rng.choice(FILE_DIRS)
+            self.files.append("{}/{}-{}".format(directory, self.name, file_idx))
+        self.files.sort()
+
+    def nevra(self):
+        return "{}-{}:{}-{}.{}".format(self.name, self.epoch, self.version, self.release, self.arch)
+
+    def filename(self):
+        return "{}-{}-{}.{}.rpm".format(self.name, self.version, self.release, self.arch)
+
+    def version_xml(self):
+        return '<version epoch="{}" ver="{}" rel="{}"/>'.format(self.epoch, self.version, self.release)
+
+    def primary_xml(self):
+        lines = [
+            '<package type="rpm">',
+            "  <name>{}</name>".format(self.name),
+            "  <arch>{}</arch>".format(self.arch),
+            "  " + self.version_xml(),
+            '  <checksum type="sha256" pkgid="YES">{}</checksum>'.format(self.pkgid),
+            "  <summary>{}</summary>".format(escape(self.summary)),
+            "  <description>{}</description>".format(escape(self.summary)),
+            "  <packager>Synthetic</packager>",
+            "  <url>https://example.com/{}</url>".format(self.name),
+            '  <time file="1700000000" build="1700000000"/>',
+            '  <size package="{}" installed="{}" archive="{}"/>'.format(self.size, self.size * 3, self.size * 3),
+            '  <location href="Packages/{}"/>'.format(self.filename()),
+            "  <format>",
+            "    <rpm:license>MIT</rpm:license>",
+            "    <rpm:vendor>Synthetic</rpm:vendor>",
+            "    <rpm:group>Unspecified</rpm:group>",
+            "    <rpm:buildhost>localhost</rpm:buildhost>",
+            "    <rpm:sourcerpm>{}-{}-{}.src.rpm</rpm:sourcerpm>".format(self.name, self.version, self.release),
+            '    <rpm:header-range start="4504" end="{}"/>'.format(4504 + self.size // 100),
+            "    <rpm:provides>",
+            '      <rpm:entry name="{}" flags="EQ" epoch="{}" ver="{}" rel="{}"/>'.format(
+                self.name, self.epoch, self.version, self.release),
+        ]
+        # the requires refer to the short name, it is provided also by packages with a longer name
+        if self.name != self.short_name:
+            lines.append("      <rpm:entry name={}/>".format(quoteattr(self.short_name)))
+        if self.provides_library:
+            lines.append("      <rpm:entry name={}/>".format(quoteattr(self.provides_library)))
+        lines.append("    </rpm:provides>")
+        if self.requires:
+            lines.append("    <rpm:requires>")
+            for require in self.requires:
+                lines.append("      <rpm:entry name={}/>".format(quoteattr(require)))
+            lines.append("    </rpm:requires>")
+        # like createrepo, primary contains only the files from the bin and etc directories
+        for path in self.files:
+            if path.startswith("/usr/bin/") or path.startswith("/etc/"):
+                lines.append("    <file>{}</file>".format(escape(path)))
+        lines.append("  </format>")
+        lines.append("</package>")
+        return "\n".join(lines) + "\n"
+
+    def filelists_xml(self):
+        lines = ['<package pkgid="{}" name="{}" arch="{}">'.format(self.pkgid, self.name, self.arch)]
+        lines.append("  " + self.version_xml())
+        for path in self.files:
+            lines.append("  <file>{}</file>".format(escape(path)))
+        lines.append("</package>")
+        return "\n".join(lines) + "\n"
+
+    def other_xml(self):
+        return "\n".join([
+            '<package pkgid="{}" name="{}" arch="{}">'.format(self.pkgid, self.name, self.arch),
+            "  " + self.version_xml(),
+            '  <changelog author="Synthetic &lt;synthetic@example.com&gt; - {}-{}" date="1700000000">'
+            "- Synthetic change</changelog>".format(self.version, self.release),
+            "</package>",
+        ]) + "\n"
+
+    def updateinfo_package_xml(self):
+        return "\n".join([
+            '        <package name="{}" version="{}" release="{}" epoch="{}" arch="{}">'.format(
+                self.name, self.version, self.release, self.epoch, self.arch),
+            "          <filename>{}</filename>".format(self.filename()),
+            "        </package>",
+        ])
+
+
+def generate_updateinfo(rng, packages, coverage):
+    covered = [pkg for pkg in packages if rng.random() < coverage]
+    rng.shuffle(covered)
+    updates = []
+    advisory_idx = 0
+    while covered:
+        count = min(len(covered), lognormal_int(rng, 2, 0.8, 1, 50))
+        advisory_packages, covered = covered[:count], covered[count:]
+        advisory_idx += 1
+        advisory_type = weighted_choice(rng, ADVISORY_TYPES)
+        lines = [
+            '  <update from="synthetic@example.com" status="stable" type="{}" version="1">'.format(advisory_type),
+            "    <id>SYNTHETIC-{}</id>".format(advisory_idx),
+            "    <title>Synthetic advisory {}</title>".format(advisory_idx),
+            '    <issued date="2023-11-14 22:13:20"/>',
+            "    <severity>{}</severity>".format(
+                rng.choice(SEVERITIES) if advisory_type == "security" else "None"),
+            "    <description>Synthetic advisory {}</description>".format(advisory_idx),
+            "    <references>",
+        ]
+        for ref_idx in range(rng.randint(0, 4)):
+            ref_type = "cve" if advisory_type == "security" and ref_idx == 0 else "bugzilla"
+            lines.append(
+                '      <reference href="https://example.com/{0}/{1}-{2}" id="{1}-{2}" type="{0}" '
+                'title="Synthetic reference {1}-{2}"/>'.format(ref_type, advisory_idx, ref_idx))
+        lines.append("    </references>")
+        lines.append("    <pkglist>")
+        lines.append('      <collection short="synthetic">')
+        lines.append("        <name>Synthetic</name>")
+        for pkg in advisory_packages:
+            lines.append(pkg.updateinfo_package_xml())
+        lines.append("      </collection>")
+        lines.append("    </pkglist>")
+        lines.append("  </update>")
+        updates.append("\n".join(lines) + "\n")
+    return updates
+
+
+def generate_modules(rng, module_count, packages_per_module, arch):
+    documents = []
+    module_packages = []
+    library_providers = []
+    for module_idx in range(module_count):
+        name = "module-{}".format(module_idx)
+        artifacts = []
+        for pkg_idx in range(packages_per_module):
+            pkg = Package(rng, pkg_idx, "{}-pkg".format(name), arch, library_providers)
+            pkg.release += ".module_{}".format(module_idx)
+            pkg.pkgid = hashlib.sha256(pkg.nevra().encode()).hexdigest()
+            module_packages.append(pkg)
+            artifacts.append("    - {}".format(pkg.nevra()))
+        documents.append("\n".join([
+            "---",
+            "document: modulemd",
+            "version: 2",
+            "data:",
+            "  name: {}".format(name),
+            "  stream: \"1\"",
+            "  version: 1",
+            "  context: 00000000",
+            "  arch: {}".format(arch),
+            "  summary: Synthetic module {}".format(module_idx),
+            "  description: Synthetic module {}".format(module_idx),
+            "  license:",
+            "    module:",
+            "    - MIT",
+            "  artifacts:",
+            "    rpms:",
+        ] + artifacts + ["..."]) + "\n")
+    return documents, module_packages
+
+
+def write_metadata(repodata_dir, md_type, chunks):
+    content = "".join(chunks).encode()
+    compressed = gzip.compress(content, mtime=0)
+    filename = "{}.xml.gz".format(md_type) if md_type != "modules" else "modules.yaml.gz"
+    with open(os.path.join(repodata_dir, filename), "wb") as f:
+        f.write(compressed)
+    return "\n".join([
+        '  <data type="{}">'.format(md_type),
+        '    <checksum type="sha256">{}</checksum>'.format(hashlib.sha256(compressed).hexdigest()),
+        '    <open-checksum type="sha256">{}</open-checksum>'.format(hashlib.sha256(content).hexdigest()),
+        '    <location href="repodata/{}"/>'.format(filename),
+        "    <timestamp>1700000000</timestamp>",
+        "    <size>{}</size>".format(len(compressed)),
+        "    <open-size>{}</open-size>".format(len(content)),
+        "  </data>",
+    ]) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", help="repository directory, the repodata directory is created in it")
+    parser.add_argument("--packages", type=int, default=10000, help="number of packages (default: 10000)")
+    parser.add_argument("--seed", type=int, default=0, help="seed of the random generator (default: 0)")
+    parser.add_argument("--arch", default="x86_64", help="architecture of the packages (default: x86_64)")
+    parser.add_argument("--advisory-coverage", type=float, default=0.3,
+                        help="fraction of packages listed in advisories (default: 0.3)")
+    parser.add_argument("--modules", type=int, default=0, help="number of modules (default: 0)")
+    parser.add_argument("--packages-per-module", type=int, default=5,
+                        help="number of packages of each module (default: 5)")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+
+    library_providers = []
+    packages = [Package(rng, idx, "pkg", args.arch, library_providers) for idx in range(args.packages)]
+    modules, module_packages = generate_modules(rng, args.modules, args.packages_per_module, args.arch)
+    all_packages = packages + module_packages
+
+    repodata_dir = os.path.join(args.output, "repodata")
+    os.makedirs(repodata_dir, exist_ok=True)
+
+    repomd = ['<?xml version="1.0" encoding="UTF-8"?>\n'
+              '<repomd xmlns="http://linux.duke.edu/metadata/repo" xmlns:rpm="http://linux.duke.edu/metadata/rpm">\n'
+              "  <revision>{}</revision>\n".format(args.seed)]
+    repomd.append(write_metadata(repodata_dir, "primary", [
+        '<?xml version="1.0" encoding="UTF-8"?>\n'
+        '<metadata xmlns="http://linux.duke.edu/metadata/common" xmlns:rpm="http://linux.duke.edu/metadata/rpm" '
+        'packages="{}">\n'.format(len(all_packages))] +
+        [pkg.primary_xml() for pkg in all_packages] + ["</metadata>\n"]))
+    repomd.append(write_metadata(repodata_dir, "filelists", [
+        '<?xml version="1.0" encoding="UTF-8"?>\n'
+        '<filelists xmlns="http://linux.duke.edu/metadata/filelists" packages="{}">\n'.format(len(all_packages))] +
+        [pkg.filelists_xml() for pkg in all_packages] + ["</filelists>\n"]))
+    repomd.append(write_metadata(repodata_dir, "other", [
+        '<?xml version="1.0" encoding="UTF-8"?>\n'
+        '<otherdata xmlns="http://linux.duke.edu/metadata/other" packages="{}">\n'.format(len(all_packages))] +
+        [pkg.other_xml() for pkg in all_packages] + ["</otherdata>\n"]))
+    repomd.append(write_metadata(repodata_dir, "updateinfo", [
+        '<?xml version="1.0" encoding="UTF-8"?>\n<updates>\n'] +
+        generate_updateinfo(rng, packages, args.advisory_coverage) + ["</updates>\n"]))
+    if modules:
+        repomd.append(write_metadata(repodata_dir, "modules", modules))
+    repomd.append("</repomd>\n")
+
+    with open(os.path.join(repodata_dir, "repomd.xml"), "w") as f:
+        f.write("".join(repomd))
+
+
+if __name__ == "__main__":
+    main()
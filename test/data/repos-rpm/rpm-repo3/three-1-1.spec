@@ -0,0 +1,20 @@
+Name:           three
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package requiring package one
+BuildArch:      noarch
+
+Requires:       one
+
+%description
+A dummy package requiring package one.
+
+%files
+
+%changelog
@@ -0,0 +1,95 @@
+# Copyright Contributors to the libdnf project.
+#
+# This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+#
+# Libdnf is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# Libdnf is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+import dbus
+import dbus.mainloop.glib
+import os
+
+from gi.repository import GLib
+
+import support
+
+IFACE_BASE = '{}.Base'.format(support.DNFDAEMON_BUS_NAME)
+
+KEY_PATH = os.path.abspath(os.path.join(os.path.dirname(__file__), '../data/keys/key.pub'))
+
+
+class CachedirLockTest(support.InstallrootCase):
+
+    def setUp(self):
+        super(CachedirLockTest, self).setUp()
+        # unsigned repository with repo_gpgcheck enabled makes the session ask for a key import
+        self.signed_reposdir = os.path.join(self.installroot, 'etc/yum.repos.d')
+        os.makedirs(self.signed_reposdir)
+        with open(os.path.join(self.signed_reposdir, 'signed.repo'), 'w') as f:
+            f.write('[signed]\n')
+            f.write('baseurl=file://{}\n'.format(os.path.join(self.repository_base, 'rpm-repo1')))
+            f.write('gpgcheck=0\n')
+            f.write('repo_gpgcheck=1\n')
+            f.write('gpgkey=file://{}\n'.format(KEY_PATH))
+
+    def open_session(self, bus, iface_session, reposdir):
+        session = iface_session.open_session({
+            "config": {
+                "config_file_path": self.config_file_path,
+                "installroot": self.installroot,
+                "cachedir": os.path.join(self.installroot, "var/cache/dnf"),
+                "reposdir": reposdir,
+            }
+        })
+        return session, dbus.Interface(
+            bus.get_object(support.DNFDAEMON_BUS_NAME, session), dbus_interface=IFACE_BASE)
+
+    def test_key_prompt_does_not_block_other_session(self):
+        bus = dbus.SystemBus(mainloop=dbus.mainloop.glib.DBusGMainLoop(), private=True)
+        # signals are sent only to the connection which opened the session
+        iface_session = dbus.Interface(
+            bus.get_object(support.DNFDAEMON_BUS_NAME, support.DNFDAEMON_OBJECT_PATH),
+            dbus_interface=support.IFACE_SESSION_MANAGER)
+        waiting_session, waiting_base = self.open_session(bus, iface_session, self.signed_reposdir)
+        other_session, other_base = self.open_session(bus, iface_session, self.reposdir)
+        loop = GLib.MainLoop()
+        results = {}
+
+        def on_key_import_request(session_object_path, key_id, user_ids, fingerprint, url, timestamp):
+            # the first session holds the key prompt open, the second one must still load its repositories
+            results['other'] = other_base.read_all_repos(timeout=60)
+            dbus.Interface(
+                bus.get_object(support.DNFDAEMON_BUS_NAME, waiting_session),
+                dbus_interface=support.IFACE_REPO).confirm_key(key_id, False)
+
+        def on_reply(retval):
+            results['waiting'] = retval
+            loop.quit()
+
+        def on_error(error):
+            results['error'] = error
+            loop.quit()
+
+        bus.add_signal_receiver(
+            on_key_import_request, signal_name='repo_key_import_request', path=waiting_session)
+        waiting_base.read_all_repos(reply_handler=on_reply, error_handler=on_error, timeout=120)
+        loop.run()
+
+        self.assertNotIn('error', results)
+        self.assertEqual(dbus.Boolean(True), results['other'])
+        # the key was rejected so the signed repository cannot be loaded
+        self.assertEqual(dbus.Boolean(False), results['waiting'])
+
+        iface_session.close_session(waiting_session)
+        iface_session.close_session(other_session)
+        bus.close()
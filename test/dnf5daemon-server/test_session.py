@@ -43,3 +43,13 @@ class SessionTest(unittest.TestCase):
         # closing non-existent session returns False
         self.assertEqual(dbus.Boolean(False),
                          self.iface.close_session(session))
+
+    def test_metrics(self):
+        session = self.iface.open_session({})
+        metrics = self.iface.get_metrics()
+        self.assertGreaterEqual(metrics['active_sessions'], 1)
+        # the open_session call itself is counted
+        open_session = metrics['methods']['%s.open_session' % support.IFACE_SESSION_MANAGER]
+        self.assertGreaterEqual(open_session['calls'], 1)
+        self.assertEqual(len(metrics['latency_buckets']) + 1, len(open_session['latency_histogram']))
+        self.iface.close_session(session)
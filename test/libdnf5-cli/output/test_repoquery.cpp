@@ -20,6 +20,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "test_repoquery.hpp"
 
+#include <libdnf5-cli/argument_parser.hpp>
 #include <libdnf5-cli/output/repoquery.hpp>
 
 
@@ -141,6 +142,14 @@ void RepoqueryTest::test_format_set_with_tags_with_spacing() {
         std::string("pkg                 1.2-3\npkg-libs            1:1.3-4\nunresolvable        1:2-3\n"),
         std::string(buf));
     free(buf);
+
+    // One tag with right align spec
+    stream = open_memstream(&buf, &len);
+    libdnf5::cli::output::print_pkg_set_with_format(stream, *pkgs, "%15{name}|\n");
+    CPPUNIT_ASSERT_EQUAL(fclose(stream), 0);
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("            pkg|\n       pkg-libs|\n   unresolvable|\n"), std::string(buf));
+    free(buf);
 }
 
 void RepoqueryTest::test_pkg_attr_uniq_sorted() {
@@ -178,6 +187,26 @@ void RepoqueryTest::test_pkg_attr_uniq_sorted() {
     free(buf);
 }
 
+void RepoqueryTest::test_pkg_set_as_json() {
+    FILE * stream = nullptr;
+    char * buf = nullptr;
+    size_t len = 0;
+
+    stream = open_memstream(&buf, &len);
+    libdnf5::cli::output::print_pkg_set_as_json(stream, *pkgs, {"name", "installsize", "requires"});
+    CPPUNIT_ASSERT_EQUAL(fclose(stream), 0);
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("{\"name\":\"pkg\",\"installsize\":222,\"requires\":[]}\n"
+                    "{\"name\":\"pkg-libs\",\"installsize\":222,\"requires\":[]}\n"
+                    "{\"name\":\"unresolvable\",\"installsize\":222,\"requires\":[\"req = 1:2-3\",\"prereq\"]}\n"),
+        std::string(buf));
+    free(buf);
+
+    CPPUNIT_ASSERT_THROW(
+        libdnf5::cli::output::print_pkg_set_as_json(stdout, *pkgs, {"name", "asd"}),
+        libdnf5::cli::ArgumentParserInvalidValueError);
+}
+
 void RepoqueryTest::test_requires_filelists() {
     CPPUNIT_ASSERT_EQUAL(libdnf5::cli::output::requires_filelists("asd"), false);
     CPPUNIT_ASSERT_EQUAL(libdnf5::cli::output::requires_filelists("file"), false);
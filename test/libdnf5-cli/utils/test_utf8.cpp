@@ -90,6 +90,18 @@ void UTF8Test::test_width_ja() {
 }
 
 
+void UTF8Test::test_width_ascii_prefix() {
+    // a long ascii prefix followed by wide characters
+    std::string mixed = "Hello world, " + hello_world_cn;
+    CPPUNIT_ASSERT_EQUAL((size_t)19, libdnf5::cli::utils::utf8::length(mixed));
+    CPPUNIT_ASSERT_EQUAL((size_t)25, libdnf5::cli::utils::utf8::width(mixed));
+    CPPUNIT_ASSERT("world, 你好" == libdnf5::cli::utils::utf8::substr_width(mixed, 6, 11));
+
+    // position after the end of an ascii string
+    CPPUNIT_ASSERT("" == libdnf5::cli::utils::utf8::substr_length(hello_world_en, 20, 3));
+}
+
+
 void UTF8Test::test_substr_length_en() {
     // the whole string
     CPPUNIT_ASSERT(hello_world_en == libdnf5::cli::utils::utf8::substr_length(hello_world_en));
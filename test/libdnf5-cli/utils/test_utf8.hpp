@@ -41,6 +41,7 @@ class UTF8Test : public CppUnit::TestCase {
     CPPUNIT_TEST(test_width_cs);
     CPPUNIT_TEST(test_width_cn);
     CPPUNIT_TEST(test_width_ja);
+    CPPUNIT_TEST(test_width_ascii_prefix);
 
     CPPUNIT_TEST(test_substr_length_en);
     CPPUNIT_TEST(test_substr_length_cs);
@@ -67,6 +68,7 @@ public:
     void test_width_cs();
     void test_width_cn();
     void test_width_ja();
+    void test_width_ascii_prefix();
 
     void test_substr_length_en();
     void test_substr_length_cs();
@@ -77,6 +77,27 @@ void AdvisoryAdvisoryTest::test_get_references() {
     CPPUNIT_ASSERT_EQUAL(std::string("https://foobar/foobarupdate_2"), r.get_url());
 }
 
+void AdvisoryAdvisoryTest::test_get_references_by_type() {
+    // Tests get_references method with reference types filter
+    libdnf5::advisory::AdvisoryQuery advisories(base);
+    advisories.filter_name("DNF-2020-1");
+    libdnf5::advisory::Advisory advisory = *advisories.begin();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, advisory.get_references().size());
+
+    std::vector<libdnf5::advisory::AdvisoryReference> refs = advisory.get_references({"cve"});
+    CPPUNIT_ASSERT_EQUAL((size_t)1, refs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("3333"), refs[0].get_id());
+    CPPUNIT_ASSERT_EQUAL(std::string("cve"), refs[0].get_type());
+
+    refs = advisory.get_references({"bugzilla", "cve"});
+    CPPUNIT_ASSERT_EQUAL((size_t)2, refs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("2222"), refs[0].get_id());
+    CPPUNIT_ASSERT_EQUAL(std::string("222"), refs[0].get_title());
+    CPPUNIT_ASSERT_EQUAL(std::string("3333"), refs[1].get_id());
+
+    CPPUNIT_ASSERT_EQUAL((size_t)0, advisory.get_references({"unknown-type"}).size());
+}
+
 void AdvisoryAdvisoryTest::test_get_collections() {
     // Tests get_collections method
     libdnf5::advisory::AdvisoryQuery advisories(base);
@@ -34,6 +34,7 @@ class AdvisoryAdvisoryTest : public BaseTestCase {
     CPPUNIT_TEST(test_get_type);
     CPPUNIT_TEST(test_get_severity);
     CPPUNIT_TEST(test_get_references);
+    CPPUNIT_TEST(test_get_references_by_type);
     CPPUNIT_TEST(test_get_collections);
 
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +48,7 @@ public:
     //void test_filter_package();
 
     void test_get_references();
+    void test_get_references_by_type();
     void test_get_collections();
 };
 
@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_set.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <set>
 #include <vector>
@@ -208,3 +209,26 @@ void AdvisoryAdvisoryQueryTest::test_get_advisory_packages_sorted() {
     CPPUNIT_ASSERT_EQUAL(std::string("pkg"), adv_pkgs[1].get_name());
     CPPUNIT_ASSERT_EQUAL(std::string("0.1-1"), adv_pkgs[1].get_evr());
 }
+
+void AdvisoryAdvisoryQueryTest::test_get_advisory_packages_sorted_by_name_arch_evr() {
+    // Only packages of the advisories in the query are returned
+    AdvisoryQuery adv_query(base);
+    adv_query.filter_name("DNF-20*", libdnf5::sack::QueryCmp::GLOB);
+    auto adv_pkgs = adv_query.get_advisory_packages_sorted_by_name_arch_evr();
+    std::vector<std::string> names;
+    for (const auto & adv_pkg : adv_pkgs) {
+        names.push_back(adv_pkg.get_name());
+    }
+    std::sort(names.begin(), names.end());
+    CPPUNIT_ASSERT_EQUAL((std::vector<std::string>{"bitcoin", "filesystem", "pkg", "wget", "yum"}), names);
+
+    // Packages with the same name and arch are next to each other
+    adv_query = AdvisoryQuery(base);
+    adv_query.filter_name("PKG-*", libdnf5::sack::QueryCmp::GLOB);
+    adv_pkgs = adv_query.get_advisory_packages_sorted_by_name_arch_evr();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, adv_pkgs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg"), adv_pkgs[0].get_name());
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg"), adv_pkgs[1].get_name());
+
+    CPPUNIT_ASSERT_EQUAL((size_t)7, AdvisoryQuery(base).get_advisory_packages_sorted_by_name_arch_evr().size());
+}
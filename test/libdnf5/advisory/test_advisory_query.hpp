@@ -38,6 +38,7 @@ class AdvisoryAdvisoryQueryTest : public BaseTestCase {
     CPPUNIT_TEST(test_filter_reference);
     CPPUNIT_TEST(test_filter_severity);
     CPPUNIT_TEST(test_get_advisory_packages_sorted);
+    CPPUNIT_TEST(test_get_advisory_packages_sorted_by_name_arch_evr);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -53,6 +54,7 @@ public:
     void test_filter_reference();
     void test_filter_severity();
     void test_get_advisory_packages_sorted();
+    void test_get_advisory_packages_sorted_by_name_arch_evr();
 };
 
 
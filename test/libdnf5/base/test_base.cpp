@@ -21,8 +21,14 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "test_base.hpp"
 
 #include <libdnf5/base/base.hpp>
+#include <libdnf5/base/goal.hpp>
+#include <libdnf5/base/trace.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 
+#include <chrono>
+#include <string>
+#include <vector>
+
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BaseTest);
 
@@ -85,3 +91,71 @@ void BaseTest::test_unlock_not_locked() {
     // Unlocking should work now
     base->unlock();
 }
+
+namespace {
+
+struct ExportedSpan {
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    libdnf5::TraceExporter::Attributes attributes;
+};
+
+// Only records the spans, failed assertions would be swallowed by the TraceSpan destructor.
+class RecordingTraceExporter : public libdnf5::TraceExporter {
+public:
+    explicit RecordingTraceExporter(std::vector<ExportedSpan> & spans) : spans(spans) {}
+
+    void export_span(
+        const char * name,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end,
+        const Attributes & attributes) override {
+        spans.push_back({name, start, end, attributes});
+    }
+
+private:
+    std::vector<ExportedSpan> & spans;
+};
+
+}  // namespace
+
+void BaseTest::test_trace_spans() {
+    auto base = get_preconfigured_base();
+
+    // Without an exporter the spans are not active
+    {
+        libdnf5::TraceSpan span(*base, "disabled");
+        CPPUNIT_ASSERT(!span.is_active());
+    }
+
+    std::vector<ExportedSpan> spans;
+    base->set_trace_exporter(std::make_unique<RecordingTraceExporter>(spans));
+
+    // The inner span is exported before the outer one
+    {
+        libdnf5::TraceSpan outer(*base, "outer");
+        CPPUNIT_ASSERT(outer.is_active());
+        outer.set_attribute("key", "value");
+        libdnf5::TraceSpan inner(*base, "inner");
+    }
+    CPPUNIT_ASSERT_EQUAL(std::size_t{2}, spans.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("inner"), spans[0].name);
+    CPPUNIT_ASSERT_EQUAL(std::string("outer"), spans[1].name);
+    const libdnf5::TraceExporter::Attributes expected_attributes{{"key", "value"}};
+    CPPUNIT_ASSERT(expected_attributes == spans[1].attributes);
+    CPPUNIT_ASSERT(spans[0].start <= spans[0].end);
+    CPPUNIT_ASSERT(spans[1].start <= spans[0].start);
+    CPPUNIT_ASSERT(spans[0].end <= spans[1].end);
+
+    // Resolving a goal is traced
+    spans.clear();
+    base->setup();
+    libdnf5::Goal goal(*base);
+    goal.resolve();
+    CPPUNIT_ASSERT(!spans.empty());
+    CPPUNIT_ASSERT_EQUAL(std::string("goal_resolve"), spans.back().name);
+    for (const auto & span : spans) {
+        CPPUNIT_ASSERT(span.start <= span.end);
+    }
+}
@@ -20,15 +20,33 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "test_goal.hpp"
 
+#include "../shared/private_accessor.hpp"
 #include "../shared/utils.hpp"
+#include "base/base_impl.hpp"
+#include "system/state.hpp"
 
 #include <libdnf5/base/goal.hpp>
+#include <libdnf5/base/transaction_group.hpp>
 #include <libdnf5/base/transaction_package.hpp>
 #include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/rpm/package_set.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BaseGoalTest);
 
+
+namespace {
+
+// Accessor of private Base::p_impl, see private_accessor.hpp
+create_private_getter_template;
+create_getter(priv_impl, &libdnf5::Base::p_impl);
+
+}  // namespace
+
 using namespace libdnf5::transaction;
 
 void BaseGoalTest::setUp() {
@@ -75,6 +93,34 @@ void BaseGoalTest::test_install_not_available() {
         libdnf5::GoalUsedSetting::USED_TRUE, fist_event.get_job_settings()->get_used_skip_unavailable());
 }
 
+void BaseGoalTest::test_used_settings_per_job() {
+    // Jobs added with equal settings share them, the used values are still recorded per job
+    add_repo_repomd("repomd-repo1");
+
+    libdnf5::Goal goal(base);
+    base.get_config().get_skip_unavailable_option().set(true);
+    base.get_config().get_best_option().set(true);
+    base.get_config().get_clean_requirements_on_remove_option().set(true);
+    libdnf5::GoalJobSettings settings;
+    goal.add_rpm_install("not_available", settings);
+    goal.add_rpm_remove("not_installed", settings);
+    auto transaction = goal.resolve();
+
+    auto & log = transaction.get_resolve_logs();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, log.size());
+    auto & install_event = log[0];
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalAction::INSTALL, install_event.get_action());
+    CPPUNIT_ASSERT_EQUAL(
+        libdnf5::GoalUsedSetting::USED_FALSE,
+        install_event.get_job_settings()->get_used_clean_requirements_on_remove());
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalUsedSetting::USED_TRUE, install_event.get_job_settings()->get_used_best());
+    auto & remove_event = log[1];
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalAction::REMOVE, remove_event.get_action());
+    CPPUNIT_ASSERT_EQUAL(
+        libdnf5::GoalUsedSetting::USED_TRUE, remove_event.get_job_settings()->get_used_clean_requirements_on_remove());
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalUsedSetting::UNUSED, remove_event.get_job_settings()->get_used_best());
+}
+
 void BaseGoalTest::test_install_from_cmdline() {
     // Tests installing a cmdline package when there is a package with the same NEVRA available in a repo
     add_repo_rpm("rpm-repo1");
@@ -224,6 +270,72 @@ void BaseGoalTest::test_remove_not_installed() {
     CPPUNIT_ASSERT_EQUAL(libdnf5::GoalUsedSetting::UNUSED, first_event.get_job_settings()->get_used_skip_unavailable());
 }
 
+void BaseGoalTest::test_remove_protected_repeated_resolve() {
+    add_repo_rpm("rpm-repo1");
+    add_system_pkg("repos-rpm/rpm-repo1/one-1-1.noarch.rpm", TransactionItemReason::USER);
+
+    auto & protected_packages = base.get_config().get_protected_packages_option();
+    protected_packages.set(std::vector<std::string>{"one"});
+
+    libdnf5::Goal goal(base);
+    goal.add_rpm_remove("one");
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::SOLVER_ERROR, transaction.get_problems());
+
+    // The protected packages shared by the resolves of the Base follow the configuration
+    protected_packages.set(std::vector<std::string>{});
+    auto transaction_unprotected = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction_unprotected.get_problems());
+
+    std::vector<libdnf5::base::TransactionPackage> expected = {libdnf5::base::TransactionPackage(
+        get_pkg("one-0:1-1.noarch", true),
+        TransactionItemAction::REMOVE,
+        TransactionItemReason::USER,
+        TransactionItemState::STARTED)};
+    CPPUNIT_ASSERT_EQUAL(expected, transaction_unprotected.get_transaction_packages());
+
+    // A new goal reuses the solver released by the previous resolve
+    libdnf5::Goal goal2(base);
+    goal2.add_rpm_remove("one");
+    CPPUNIT_ASSERT_EQUAL(expected, goal2.resolve().get_transaction_packages());
+}
+
+void BaseGoalTest::test_remove_clean_deps_reason_change() {
+    add_repo_rpm("rpm-repo1");
+    add_repo_rpm("rpm-repo3");
+    add_system_pkg("repos-rpm/rpm-repo1/one-1-1.noarch.rpm", TransactionItemReason::USER);
+    add_system_pkg("repos-rpm/rpm-repo3/three-1-1.noarch.rpm", TransactionItemReason::USER);
+    base.get_config().get_clean_requirements_on_remove_option().set(true);
+
+    auto removed_nevras = [](const libdnf5::base::Transaction & transaction) {
+        std::vector<std::string> nevras;
+        for (const auto & tspkg : transaction.get_transaction_packages()) {
+            CPPUNIT_ASSERT_EQUAL(TransactionItemAction::REMOVE, tspkg.get_action());
+            nevras.push_back(tspkg.get_package().get_nevra());
+        }
+        std::sort(nevras.begin(), nevras.end());
+        return nevras;
+    };
+
+    // The user-installed dependency is kept
+    libdnf5::Goal goal(base);
+    goal.add_rpm_remove("three");
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(std::vector<std::string>{"three-0:1-1.noarch"}, removed_nevras(transaction));
+
+    // The user-installed packages shared by the resolves of the Base follow the reasons in the system state,
+    // the number of solvables in the pool does not change
+    (base.*get(priv_impl()))->get_system_state().set_package_reason("one.noarch", TransactionItemReason::DEPENDENCY);
+    auto transaction_dependency = goal.resolve();
+    std::vector<std::string> expected = {"one-0:1-1.noarch", "three-0:1-1.noarch"};
+    CPPUNIT_ASSERT_EQUAL(expected, removed_nevras(transaction_dependency));
+    for (const auto & tspkg : transaction_dependency.get_transaction_packages()) {
+        if (tspkg.get_package().get_name() == "one") {
+            CPPUNIT_ASSERT_EQUAL(TransactionItemReason::CLEAN, tspkg.get_reason());
+        }
+    }
+}
+
 void BaseGoalTest::test_install_installed_pkg() {
     add_repo_rpm("rpm-repo1");
     add_system_pkg("repos-rpm/rpm-repo1/one-1-1.noarch.rpm", TransactionItemReason::DEPENDENCY);
@@ -268,6 +380,48 @@ void BaseGoalTest::test_upgrade() {
     CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
 }
 
+void BaseGoalTest::test_upgrade_package_set() {
+    // The packages of one upgrade job are each matched against the installed packages with the same name
+    add_repo_rpm("rpm-repo1");
+    add_repo_rpm("rpm-repo2");
+    add_repo_rpm("rpm-repo3");
+    add_system_pkg("repos-rpm/rpm-repo1/one-1-1.noarch.rpm", TransactionItemReason::DEPENDENCY);
+    add_system_pkg("repos-rpm/rpm-repo2/two-2-2.noarch.rpm", TransactionItemReason::USER);
+
+    libdnf5::rpm::PackageSet package_set(base);
+    package_set.add(get_pkg("one-0:2-1.noarch"));
+    package_set.add(get_pkg("two-0:2-2.noarch"));
+    package_set.add(get_pkg("three-0:1-1.noarch"));
+
+    libdnf5::Goal goal(base);
+    goal.add_rpm_upgrade(package_set);
+    auto transaction = goal.resolve();
+
+    std::vector<libdnf5::base::TransactionPackage> expected = {
+        libdnf5::base::TransactionPackage(
+            get_pkg("one-0:2-1.noarch"),
+            TransactionItemAction::UPGRADE,
+            TransactionItemReason::DEPENDENCY,
+            TransactionItemState::STARTED),
+        libdnf5::base::TransactionPackage(
+            get_pkg("one-0:1-1.noarch", true),
+            TransactionItemAction::REPLACED,
+            TransactionItemReason::DEPENDENCY,
+            TransactionItemState::STARTED)};
+    CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
+
+    // "two" is installed in the same version and "three" is not installed at all
+    auto & log = transaction.get_resolve_logs();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, log.size());
+    auto & first_event = *log.begin();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalAction::UPGRADE, first_event.get_action());
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::ALREADY_INSTALLED, first_event.get_problem());
+    CPPUNIT_ASSERT_EQUAL(std::string("two.noarch"), *first_event.get_additional_data().begin());
+    auto & second_event = log[1];
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalAction::UPGRADE, second_event.get_action());
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NOT_INSTALLED, second_event.get_problem());
+}
+
 void BaseGoalTest::test_upgrade_from_cmdline() {
     // Tests the upgrade using a cmdline package when a package with the same NEVRA is in available repo
     add_repo_rpm("rpm-repo1");
@@ -527,6 +681,48 @@ void BaseGoalTest::test_distrosync_all() {
     CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
 }
 
+void BaseGoalTest::test_group_upgrade() {
+    // The installed version of the group contains only the "upgrade-kept" package,
+    // the available version adds a mandatory and a default package.
+    auto & system_state = (base.*get(priv_impl()))->get_system_state();
+    system_state.set_group_state(
+        "upgrade-group",
+        {.userinstalled = true, .packages = {}, .package_types = libdnf5::comps::PackageType::MANDATORY});
+    auto group_xml_dir = system_state.get_group_xml_dir();
+    std::filesystem::create_directories(group_xml_dir);
+    std::ofstream(group_xml_dir / "upgrade-group.xml") << R"(<?xml version="1.0" encoding="UTF-8"?>
+<comps>
+  <group>
+    <id>upgrade-group</id>
+    <name>Upgrade group v1</name>
+    <packagelist>
+      <packagereq type="mandatory">upgrade-kept</packagereq>
+    </packagelist>
+  </group>
+</comps>
+)";
+    repo_sack->get_system_repo()->load();
+    add_repo_repomd("repomd-comps-upgrade");
+
+    libdnf5::Goal goal(base);
+    goal.add_group_upgrade("upgrade-group");
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+
+    // Only the package newly added to the group with a type installed with the group is installed
+    std::vector<libdnf5::base::TransactionPackage> expected = {libdnf5::base::TransactionPackage(
+        get_pkg("upgrade-added-0:1-1.noarch"),
+        TransactionItemAction::INSTALL,
+        TransactionItemReason::GROUP,
+        TransactionItemState::STARTED)};
+    CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
+
+    auto & transaction_groups = transaction.get_transaction_groups();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, transaction_groups.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("upgrade-group"), transaction_groups[0].get_group().get_groupid());
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::UPGRADE, transaction_groups[0].get_action());
+}
+
 void BaseGoalTest::test_install_or_reinstall() {
     add_repo_rpm("rpm-repo1");
     add_system_pkg("repos-rpm/rpm-repo1/one-1-1.noarch.rpm", TransactionItemReason::DEPENDENCY);
@@ -552,3 +748,15 @@ void BaseGoalTest::test_install_or_reinstall() {
             TransactionItemState::STARTED)};
     CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
 }
+
+
+void BaseGoalTest::test_install_performance() {
+    // the requires of the synthetic packages form a chain, the installed package pulls in all other names
+    add_repo_synthetic("synthetic", 10000);
+
+    for (int i = 0; i < 10; ++i) {
+        libdnf5::Goal goal(base);
+        goal.add_rpm_install("pkg-0");
+        auto transaction = goal.resolve();
+    }
+}
@@ -33,6 +33,7 @@ class BaseGoalTest : public BaseTestCase {
 #ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_install);
     CPPUNIT_TEST(test_install_not_available);
+    CPPUNIT_TEST(test_used_settings_per_job);
     CPPUNIT_TEST(test_install_multilib_all);
     CPPUNIT_TEST(test_install_installed_pkg);
     CPPUNIT_TEST(test_install_or_reinstall);
@@ -42,7 +43,10 @@ class BaseGoalTest : public BaseTestCase {
     CPPUNIT_TEST(test_reinstall_user);
     CPPUNIT_TEST(test_remove);
     CPPUNIT_TEST(test_remove_not_installed);
+    CPPUNIT_TEST(test_remove_protected_repeated_resolve);
+    CPPUNIT_TEST(test_remove_clean_deps_reason_change);
     CPPUNIT_TEST(test_upgrade);
+    CPPUNIT_TEST(test_upgrade_package_set);
     CPPUNIT_TEST(test_upgrade_from_cmdline);
     CPPUNIT_TEST(test_upgrade_not_downgrade_from_cmdline);
     CPPUNIT_TEST(test_upgrade_not_available);
@@ -53,9 +57,11 @@ class BaseGoalTest : public BaseTestCase {
     CPPUNIT_TEST(test_downgrade_user);
     CPPUNIT_TEST(test_distrosync);
     CPPUNIT_TEST(test_distrosync_all);
+    CPPUNIT_TEST(test_group_upgrade);
 #endif
 
 #ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_install_performance);
 #endif
 
     CPPUNIT_TEST_SUITE_END();
@@ -65,6 +71,7 @@ public:
 
     void test_install();
     void test_install_not_available();
+    void test_used_settings_per_job();
     void test_install_multilib_all();
     void test_install_installed_pkg();
     void test_install_or_reinstall();
@@ -74,7 +81,10 @@ public:
     void test_reinstall_user();
     void test_remove();
     void test_remove_not_installed();
+    void test_remove_protected_repeated_resolve();
+    void test_remove_clean_deps_reason_change();
     void test_upgrade();
+    void test_upgrade_package_set();
     void test_upgrade_from_cmdline();
     void test_upgrade_not_downgrade_from_cmdline();
     void test_upgrade_not_available();
@@ -85,6 +95,9 @@ public:
     void test_downgrade_user();
     void test_distrosync();
     void test_distrosync_all();
+    void test_group_upgrade();
+
+    void test_install_performance();
 };
 
 
@@ -43,6 +43,8 @@ void VarsTest::test_vars() {
         std::string("alternate-default-${nn:+n${nn:-${nnn:}"),
         base->get_vars()->substitute("${var1:+alternate}-${unset:-default}-${nn:+n${nn:-${nnn:}"));
     CPPUNIT_ASSERT_EQUAL(std::string("456"), base->get_vars()->substitute("${unset:-${var1:+${var2:+$var2}}}"));
+    CPPUNIT_ASSERT_EQUAL(std::string("no variables-here"), base->get_vars()->substitute("no variables-here"));
+    CPPUNIT_ASSERT_EQUAL(std::string("escaped\\$var1"), base->get_vars()->substitute("escaped\\\\\\$var1"));
 }
 
 void VarsTest::test_vars_multiple_dirs() {
@@ -166,6 +166,26 @@ void IniparserTest::test_iniparser2() {
 }
 
 
+void IniparserTest::test_iniparser_crlf_without_final_newline() {
+    // Source data
+    constexpr std::string_view ini_file_content =
+        "[section1]\r\n"
+        "key1 = value1\r\n"
+        "\r\n"
+        "key2 = value2";
+
+    // Expected results from parser
+    const std::vector<Item> expected_items = {
+        {ItemType::SECTION, "section1", "", "", "[section1]\n"},
+        {ItemType::KEY_VAL, "section1", "key1", "value1", "key1 = value1\n"},
+        {ItemType::EMPTY_LINE, "section1", "", "", "\n"},
+        {ItemType::KEY_VAL, "section1", "key2", "value2", "key2 = value2\n"},
+        {ItemType::END_OF_INPUT, "section1", "", "", ""}};
+
+    parse_and_check_results(ini_file_content, expected_items);
+}
+
+
 void IniparserTest::test_iniparser_missing_section_header() {
     constexpr std::string_view ini_file_content = "# Test comment1\nkey1 = value1";
 
@@ -30,6 +30,7 @@ class IniparserTest : public CppUnit::TestCase {
 #ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_iniparser);
     CPPUNIT_TEST(test_iniparser2);
+    CPPUNIT_TEST(test_iniparser_crlf_without_final_newline);
     CPPUNIT_TEST(test_iniparser_missing_section_header);
     CPPUNIT_TEST(test_iniparser_missing_bracket);
     CPPUNIT_TEST(test_iniparser_missing_bracket2);
@@ -48,6 +49,7 @@ public:
 
     void test_iniparser();
     void test_iniparser2();
+    void test_iniparser_crlf_without_final_newline();
     void test_iniparser_missing_section_header();
     void test_iniparser_missing_bracket();
     void test_iniparser_missing_bracket2();
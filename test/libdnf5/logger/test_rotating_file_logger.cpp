@@ -107,3 +107,44 @@ void RotatingFileLoggerTest::test() {
     read_content = libdnf5::utils::fs::File(base_log_file_path.string() + ".3", "r").read();
     CPPUNIT_ASSERT_EQUAL(expected_rotated_file_3_content, read_content);
 }
+
+
+void RotatingFileLoggerTest::test_shared_log_file() {
+    const char * const tz = "TZ=UTC";
+    putenv(const_cast<char *>(tz));
+    tzset();
+
+    auto msg_time = std::chrono::system_clock::from_time_t(1582604701);  // "2020-02-25T04:25:01Z"
+    const pid_t pid = 25;
+
+    libdnf5::utils::fs::TempDir temp_logdir("libdnf_unittest_rotating_logger");
+    const auto base_log_file_path = temp_logdir.get_path() / "rotated.log";
+
+    // Two loggers sharing the same log files simulate two processes.
+    // The log files rotated by one logger must be detected by the other one.
+    {
+        constexpr std::size_t MAX_BYTES = 100;
+        constexpr std::size_t BACKUP_COUNT = 2;
+        libdnf5::RotatingFileLogger logger_a(base_log_file_path, MAX_BYTES, BACKUP_COUNT);
+        libdnf5::RotatingFileLogger logger_b(base_log_file_path, MAX_BYTES, BACKUP_COUNT);
+
+        logger_a.write(msg_time += 1s, pid, LogLevel::INFO, "1: Message A");
+        logger_b.write(msg_time += 1s, pid, LogLevel::INFO, "2: Message B");
+        logger_a.write(msg_time += 1s, pid, LogLevel::INFO, "3: Message A");
+        logger_b.write(msg_time += 1s, pid, LogLevel::INFO, "4: Message B");
+    }
+
+    auto read_content = libdnf5::utils::fs::File(base_log_file_path, "r").read();
+    CPPUNIT_ASSERT_EQUAL(
+        std::string(
+            "2020-02-25T04:25:04+0000 [25] INFO 3: Message A\n"
+            "2020-02-25T04:25:05+0000 [25] INFO 4: Message B\n"),
+        read_content);
+
+    read_content = libdnf5::utils::fs::File(base_log_file_path.string() + ".1", "r").read();
+    CPPUNIT_ASSERT_EQUAL(
+        std::string(
+            "2020-02-25T04:25:02+0000 [25] INFO 1: Message A\n"
+            "2020-02-25T04:25:03+0000 [25] INFO 2: Message B\n"),
+        read_content);
+}
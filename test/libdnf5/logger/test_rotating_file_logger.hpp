@@ -28,6 +28,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 class RotatingFileLoggerTest : public CppUnit::TestCase {
     CPPUNIT_TEST_SUITE(RotatingFileLoggerTest);
     CPPUNIT_TEST(test);
+    CPPUNIT_TEST(test_shared_log_file);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +36,7 @@ public:
     void tearDown() override;
 
     void test();
+    void test_shared_log_file();
 };
 
 #endif
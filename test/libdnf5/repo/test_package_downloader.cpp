@@ -24,11 +24,15 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "utils/string.hpp"
 
 #include "libdnf5/utils/fs/file.hpp"
+#include "libdnf5/utils/fs/temp.hpp"
 
 #include <libdnf5/base/base.hpp>
 #include <libdnf5/repo/package_downloader.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+
 #include <filesystem>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(PackageDownloaderTest);
@@ -128,3 +132,90 @@ void PackageDownloaderTest::test_package_downloader_temp_files_memory() {
 
     CPPUNIT_ASSERT_EQUAL(expected, memory.get_files());
 }
+
+void PackageDownloaderTest::test_package_downloader_shared_cache() {
+    auto repo = add_repo_rpm("rpm-repo1");
+
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_name({"one"});
+    query.filter_version({"2"});
+    query.filter_arch({"noarch"});
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+    auto package = *query.begin();
+
+    libdnf5::utils::fs::TempDir shared_cachedir("libdnf5_unittest_shared_cache");
+    base.get_config().get_shared_package_cachedir_option().set(shared_cachedir.get_path().string());
+
+    auto package_path = std::filesystem::path(repo->get_cachedir()) / "packages" / "one-2-1.noarch.rpm";
+    auto checksum = package.get_checksum();
+    auto shared_path = shared_cachedir.get_path() / checksum.get_type_str() / (checksum.get_checksum() + ".rpm");
+
+    // the downloaded package is stored in the shared cache
+    {
+        auto downloader = libdnf5::repo::PackageDownloader(base);
+        downloader.add(package);
+        downloader.download();
+    }
+    CPPUNIT_ASSERT(std::filesystem::exists(shared_path));
+    CPPUNIT_ASSERT_EQUAL((std::uintmax_t)2, std::filesystem::hard_link_count(package_path));
+
+    // the package missing in the repository cache is taken from the shared cache
+    std::filesystem::remove(package_path);
+    CPPUNIT_ASSERT_EQUAL((std::uintmax_t)1, std::filesystem::hard_link_count(shared_path));
+
+    auto cbs_unique_ptr = std::make_unique<DownloadCallbacks>();
+    auto cbs = cbs_unique_ptr.get();
+    base.set_download_callbacks(std::move(cbs_unique_ptr));
+    {
+        auto downloader = libdnf5::repo::PackageDownloader(base);
+        downloader.add(package);
+        downloader.download();
+    }
+    CPPUNIT_ASSERT_EQUAL(1, cbs->end_cnt);
+    CPPUNIT_ASSERT_EQUAL(DownloadCallbacks::TransferStatus::ALREADYEXISTS, cbs->end_status);
+    CPPUNIT_ASSERT(std::filesystem::exists(package_path));
+}
+
+void PackageDownloaderTest::test_package_downloader_shared_cache_eviction() {
+    auto repo = add_repo_rpm("rpm-repo1");
+
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_name({"one"});
+    query.filter_version({"2"});
+    query.filter_arch({"noarch"});
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+    auto package = *query.begin();
+
+    libdnf5::utils::fs::TempDir shared_cachedir("libdnf5_unittest_shared_cache");
+    base.get_config().get_shared_package_cachedir_option().set(shared_cachedir.get_path().string());
+    base.get_config().get_shared_package_cache_size_option().set(package.get_download_size() + 500);
+
+    // an incomplete package file hardlinked with other files, e.g. a stale copy in the shared cache
+    auto package_path = std::filesystem::path(repo->get_cachedir()) / "packages" / "one-2-1.noarch.rpm";
+    std::filesystem::create_directories(package_path.parent_path());
+    auto stale_shared_path = shared_cachedir.get_path() / "sha256" / "stale.rpm";
+    std::filesystem::create_directories(stale_shared_path.parent_path());
+    libdnf5::utils::fs::File(stale_shared_path, "w").write(std::string(1000, 'x'));
+    const struct timespec old_times[2] = {{1, 0}, {1, 0}};
+    utimensat(AT_FDCWD, stale_shared_path.c_str(), old_times, 0);
+    auto other_path = temp->get_path() / "other.rpm";
+    std::filesystem::create_hard_link(stale_shared_path, other_path);
+    std::filesystem::create_hard_link(stale_shared_path, package_path);
+
+    {
+        auto downloader = libdnf5::repo::PackageDownloader(base);
+        downloader.add(package);
+        downloader.download();
+    }
+
+    // the link was broken before the download, librepo did not write into the linked files
+    CPPUNIT_ASSERT_EQUAL(std::string(1000, 'x'), libdnf5::utils::fs::File(other_path, "r").read());
+    CPPUNIT_ASSERT_EQUAL(package.get_download_size(), (unsigned long long)std::filesystem::file_size(package_path));
+
+    // the least recently used package over the size limit was evicted from the shared cache, the linked copy stays
+    auto checksum = package.get_checksum();
+    auto shared_path = shared_cachedir.get_path() / checksum.get_type_str() / (checksum.get_checksum() + ".rpm");
+    CPPUNIT_ASSERT(std::filesystem::exists(shared_path));
+    CPPUNIT_ASSERT(!std::filesystem::exists(stale_shared_path));
+    CPPUNIT_ASSERT(std::filesystem::exists(other_path));
+}
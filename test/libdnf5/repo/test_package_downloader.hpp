@@ -29,11 +29,15 @@ class PackageDownloaderTest : public BaseTestCase {
     CPPUNIT_TEST_SUITE(PackageDownloaderTest);
     CPPUNIT_TEST(test_package_downloader);
     CPPUNIT_TEST(test_package_downloader_temp_files_memory);
+    CPPUNIT_TEST(test_package_downloader_shared_cache);
+    CPPUNIT_TEST(test_package_downloader_shared_cache_eviction);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void test_package_downloader();
     void test_package_downloader_temp_files_memory();
+    void test_package_downloader_shared_cache();
+    void test_package_downloader_shared_cache_eviction();
 };
 
 #endif
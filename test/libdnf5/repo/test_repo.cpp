@@ -21,8 +21,22 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "utils/string.hpp"
 
+#include <libdnf5/advisory/advisory_query.hpp>
 #include <libdnf5/base/base.hpp>
+#include <libdnf5/repo/repo_cache.hpp>
+#include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/utils/format.hpp>
+#include <libdnf5/utils/fs/file.hpp>
 
+#include <rpm/rpmts.h>
+
+extern "C" {
+#include <solv/chksum.h>
+#include <solv/knownid.h>
+}
+
+#include <chrono>
+#include <ctime>
 #include <filesystem>
 
 
@@ -34,6 +48,51 @@ void RepoTest::test_load_system_repo() {
     repo_sack->get_system_repo()->load();
 }
 
+
+void RepoTest::test_load_system_repo_cache() {
+    // an empty rpmdb, its cookie is the key of the system repo cache together with the installroot
+    auto init_rpmdb = [](const std::filesystem::path & installroot) {
+        rpmts ts = rpmtsCreate();
+        rpmtsSetRootDir(ts, installroot.c_str());
+        auto rc = rpmtsInitDB(ts, 0644);
+        rpmtsFree(ts);
+        CPPUNIT_ASSERT_EQUAL(0, rc);
+    };
+    auto load_system_repo = [this](const std::filesystem::path & installroot) {
+        libdnf5::Base other_base;
+        other_base.get_config().get_installroot_option().set(installroot);
+        other_base.get_config().get_cachedir_option().set(temp->get_path() / "cache");
+        other_base.get_vars()->set("arch", "x86_64");
+        other_base.setup();
+        other_base.get_repo_sack()->get_system_repo()->load();
+    };
+
+    auto installroot = temp->get_path() / "installroot";
+    init_rpmdb(installroot);
+    repo_sack->get_system_repo()->load();
+
+    std::filesystem::path cache_path;
+    for (const auto & entry : std::filesystem::recursive_directory_iterator(temp->get_path() / "cache")) {
+        if (entry.path().filename() == "@System.solv") {
+            cache_path = entry.path();
+        }
+    }
+    CPPUNIT_ASSERT_MESSAGE("The system repo cache was not written", !cache_path.empty());
+    auto cache_time = std::filesystem::last_write_time(cache_path) - std::chrono::hours(1);
+    std::filesystem::last_write_time(cache_path, cache_time);
+
+    // the rpmdb cookie is unchanged, the cache is loaded and not written again
+    load_system_repo(installroot);
+    CPPUNIT_ASSERT(std::filesystem::last_write_time(cache_path) == cache_time);
+
+    // the cache was written for another rpmdb, it is not used and is replaced
+    auto other_installroot = temp->get_path() / "other_installroot";
+    std::filesystem::create_directory(other_installroot);
+    init_rpmdb(other_installroot);
+    load_system_repo(other_installroot);
+    CPPUNIT_ASSERT(std::filesystem::last_write_time(cache_path) != cache_time);
+}
+
 namespace {
 
 class DownloadCallbacks : public libdnf5::repo::DownloadCallbacks {
@@ -139,6 +198,53 @@ void RepoTest::test_load_repo_nonexistent() {
     CPPUNIT_ASSERT_THROW(repo_sack->update_and_load_repos(repos), libdnf5::repo::RepoDownloadError);
 }
 
+void RepoTest::test_load_repo_local_in_place() {
+    std::string repoid("repomd-repo1");
+    auto repo = add_repo_repomd(repoid, false);
+    repo->get_config().get_local_in_place_option().set(true);
+
+    auto dl_callbacks = std::make_unique<DownloadCallbacks>();
+    auto dl_callbacks_ptr = dl_callbacks.get();
+    base.set_download_callbacks(std::move(dl_callbacks));
+
+    libdnf5::repo::RepoQuery repos(base);
+    repos.filter_id(repoid);
+    repo_sack->update_and_load_repos(repos);
+
+    // nothing is downloaded, the metadata are used from the repository directory
+    CPPUNIT_ASSERT_EQUAL(0, dl_callbacks_ptr->start_cnt);
+    std::filesystem::path repo_path = PROJECT_SOURCE_DIR "/test/data/repos-repomd";
+    repo_path /= repoid;
+    CPPUNIT_ASSERT(repo->get_metadata_path("primary").starts_with(repo_path.native()));
+    CPPUNIT_ASSERT(!std::filesystem::exists(std::filesystem::path(repo->get_cachedir()) / "repodata"));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg-1.2-3.x86_64"), get_pkg("pkg-1.2-3.x86_64").get_full_nevra());
+}
+
+void RepoTest::test_load_repo_local_in_place_url() {
+    // the repository directory name contains a space which is percent-encoded in the baseurl
+    std::filesystem::path repo_path = temp->get_path() / "local repo";
+    std::filesystem::copy(
+        PROJECT_SOURCE_DIR "/test/data/repos-repomd/repomd-repo1", repo_path, std::filesystem::copy_options::recursive);
+
+    std::string repoid("local-repo");
+    auto repo = repo_sack->create_repo(repoid);
+    repo->get_config().get_baseurl_option().set(std::vector<std::string>{
+        "file://localhost" + (temp->get_path() / "missing").native(),
+        "file://localhost" + (temp->get_path() / "local%20repo").native()});
+    repo->get_config().get_local_in_place_option().set(true);
+
+    libdnf5::repo::RepoQuery repos(base);
+    repos.filter_id(repoid);
+    repo_sack->update_and_load_repos(repos);
+
+    // the metadata are used from the second baseurl, the first one does not exist
+    CPPUNIT_ASSERT(repo->get_metadata_path("primary").starts_with(repo_path.native()));
+    CPPUNIT_ASSERT(!std::filesystem::exists(std::filesystem::path(repo->get_cachedir()) / "repodata"));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg-1.2-3.x86_64"), get_pkg("pkg-1.2-3.x86_64").get_full_nevra());
+}
+
 void RepoTest::test_update_and_load_enabled_repos_twice_fails() {
     // Call this once...
     repo_sack->update_and_load_enabled_repos(true);
@@ -146,3 +252,182 @@ void RepoTest::test_update_and_load_enabled_repos_twice_fails() {
     // calling this again should fail
     CPPUNIT_ASSERT_THROW(repo_sack->update_and_load_enabled_repos(true), libdnf5::UserAssertionError);
 }
+
+void RepoTest::test_load_repo_ondemand_filelists() {
+    base.get_config().get_ondemand_metadata_types_option().set(
+        libdnf5::OptionStringSet::ValueType{libdnf5::METADATA_TYPE_FILELISTS});
+    add_repo_repomd("repomd-repo1");
+
+    // filelists are loaded when the files of the package are requested for the first time
+    const std::vector<std::string> expected = {
+        "/etc/pkg.conf",
+        "/etc/pkg.conf.d",
+    };
+    CPPUNIT_ASSERT_EQUAL(expected, get_pkg("pkg-1.2-3.x86_64").get_files());
+
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_file({"/etc/pkg.conf.d"});
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+
+    // glob patterns without wildcards match the paths exactly
+    libdnf5::rpm::PackageQuery glob_query(base);
+    glob_query.filter_file({"/etc/pkg.conf"}, libdnf5::sack::QueryCmp::GLOB);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, glob_query.size());
+
+    libdnf5::rpm::PackageQuery not_glob_query(base);
+    not_glob_query.filter_file({"/etc/pkg.conf"}, libdnf5::sack::QueryCmp::NOT_GLOB);
+    CPPUNIT_ASSERT(!not_glob_query.contains(get_pkg("pkg-1.2-3.x86_64")));
+}
+
+void RepoTest::test_load_repo_ondemand_filelists_download() {
+    base.get_config().get_optional_metadata_types_option().set(libdnf5::OptionStringSet::ValueType{});
+    base.get_config().get_ondemand_metadata_types_option().set(
+        libdnf5::OptionStringSet::ValueType{libdnf5::METADATA_TYPE_FILELISTS});
+    auto repo = add_repo_repomd("repomd-repo1");
+
+    // filelists are not downloaded together with the repository
+    CPPUNIT_ASSERT(repo->get_metadata_path("filelists").empty());
+
+    // the first query on files downloads them
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_file({"/etc/pkg.conf.d"});
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+    CPPUNIT_ASSERT(repo->get_metadata_path("filelists").starts_with(repo->get_cachedir()));
+}
+
+void RepoTest::test_create_repo_duplicate_id() {
+    repo_sack->create_repo("duplicate");
+    CPPUNIT_ASSERT_THROW(repo_sack->create_repo("duplicate"), libdnf5::repo::RepoIdAlreadyExistsError);
+
+    repo_sack->get_system_repo();
+    CPPUNIT_ASSERT_THROW(repo_sack->create_repo("@System"), libdnf5::repo::RepoIdAlreadyExistsError);
+}
+
+void RepoTest::test_apply_cache_budget() {
+    std::filesystem::path cachedir{base.get_config().get_cachedir_option().get_value()};
+
+    // Creates a cache of a repository that is not configured, with a 1000 bytes large file.
+    auto create_cache = [&](const std::string & name, const std::string & last_used) {
+        std::filesystem::create_directories(cachedir / name / "repodata");
+        libdnf5::utils::fs::File(cachedir / name / "repodata" / "primary.xml", "w").write(std::string(1000, 'x'));
+        libdnf5::repo::RepoCache(base, cachedir / name)
+            .write_attribute(libdnf5::repo::RepoCache::ATTRIBUTE_LAST_USED, last_used);
+    };
+    create_cache("old-0123456789abcdef", "1");
+    create_cache("new-fedcba9876543210", "2");
+    create_cache("recent-0123456789abcdef", std::to_string(std::time(nullptr)));
+
+    // without a budget nothing is removed
+    auto statistics = repo_sack->apply_cache_budget();
+    CPPUNIT_ASSERT_EQUAL(std::size_t{0}, statistics.files_removed);
+
+    // the least recently used cache is removed first, the cache used within the last hour is kept
+    base.get_config().get_cache_budget_option().set("2500");
+    statistics = repo_sack->apply_cache_budget();
+    CPPUNIT_ASSERT(!std::filesystem::exists(cachedir / "old-0123456789abcdef"));
+    CPPUNIT_ASSERT(std::filesystem::exists(cachedir / "new-fedcba9876543210"));
+    CPPUNIT_ASSERT(std::filesystem::exists(cachedir / "recent-0123456789abcdef"));
+
+    // even over the budget, recently used caches are not removed
+    base.get_config().get_cache_budget_option().set("500");
+    statistics = repo_sack->apply_cache_budget();
+    CPPUNIT_ASSERT(!std::filesystem::exists(cachedir / "new-fedcba9876543210"));
+    CPPUNIT_ASSERT(std::filesystem::exists(cachedir / "recent-0123456789abcdef"));
+    CPPUNIT_ASSERT_EQUAL(std::size_t{0}, statistics.errors);
+
+    // loading a repository records the use of its cache
+    auto repo = add_repo_repomd("repomd-repo1");
+    libdnf5::repo::RepoCache repo_cache(base, repo->get_cachedir());
+    CPPUNIT_ASSERT(repo_cache.is_attribute(libdnf5::repo::RepoCache::ATTRIBUTE_LAST_USED));
+}
+
+void RepoTest::test_read_cached_package_names() {
+    auto repo = add_repo_repomd("repomd-repo1");
+
+    // loading the repository writes the package names index to its cache
+    std::vector<std::string> names;
+    CPPUNIT_ASSERT(repo->read_cached_package_names("pkg", names));
+    const std::vector<std::string> expected = {"pkg", "pkg-libs"};
+    CPPUNIT_ASSERT_EQUAL(expected, names);
+
+    names.clear();
+    CPPUNIT_ASSERT(repo->read_cached_package_names("nonexistent", names));
+    CPPUNIT_ASSERT(names.empty());
+
+    // the index is not available for a repository that was never loaded
+    auto unloaded_repo = repo_sack->create_repo("unloaded");
+    CPPUNIT_ASSERT(!unloaded_repo->read_cached_package_names("", names));
+}
+
+namespace {
+
+std::string file_sha256(const std::filesystem::path & path) {
+    auto data = libdnf5::utils::fs::File(path, "r").read();
+    auto * chksum = solv_chksum_create(REPOKEY_TYPE_SHA256);
+    solv_chksum_add(chksum, data.data(), static_cast<int>(data.size()));
+    int len;
+    auto * digest = solv_chksum_get(chksum, &len);
+    std::string hex;
+    for (int i = 0; i < len; ++i) {
+        hex += libdnf5::utils::sformat("{:02x}", digest[i]);
+    }
+    solv_chksum_free(chksum, nullptr);
+    return hex;
+}
+
+}  // namespace
+
+void RepoTest::test_load_repo_corrupt_large_primary() {
+    // The primary is malformed right at the beginning and followed by data much larger than the socket buffer.
+    // Its declared open size is above the threshold for the decompression in a separate thread.
+    auto repo_path = temp->get_path() / "corrupt-large-primary";
+    std::filesystem::create_directories(repo_path / "repodata");
+    auto primary_path = repo_path / "repodata" / "primary.xml.gz";
+    {
+        libdnf5::utils::fs::File primary(primary_path, "w", true);
+        primary.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<metadata packages=\"1\">\n<<package");
+        primary.write(std::string(16 * 1024 * 1024, 'x'));
+    }
+    auto checksum = file_sha256(primary_path);
+    libdnf5::utils::fs::File(repo_path / "repodata" / "repomd.xml", "w")
+        .write(libdnf5::utils::sformat(
+            "<repomd xmlns=\"http://linux.duke.edu/metadata/repo\">\n"
+            "  <revision>1</revision>\n"
+            "  <data type=\"primary\">\n"
+            "    <checksum type=\"sha256\">{0}</checksum>\n"
+            "    <location href=\"repodata/primary.xml.gz\" />\n"
+            "    <size>{1}</size>\n"
+            "    <open-size>{2}</open-size>\n"
+            "  </data>\n"
+            "</repomd>\n",
+            checksum,
+            std::filesystem::file_size(primary_path),
+            64 * 1024 * 1024));
+
+    auto repo = add_repo("corrupt-large-primary", repo_path, false);
+    repo->get_config().get_skip_if_unavailable_option().set(false);
+
+    // loading fails instead of waiting for the decompressing thread blocked on the unread data
+    libdnf5::repo::RepoQuery repos(base);
+    repos.filter_id("corrupt-large-primary");
+    CPPUNIT_ASSERT_THROW(repo_sack->update_and_load_repos(repos), libdnf5::Error);
+}
+
+void RepoTest::test_load_repo_synthetic_performance() {
+    // the repo is generated by test/data/generate-synthetic-repo.py during the build
+    std::filesystem::path repo_path = PROJECT_BINARY_DIR "/test/data/repos-synthetic/synthetic-10k";
+
+    add_repo("synthetic-10k", repo_path);
+
+    // the first query on files loads the filelists
+    for (int i = 0; i < 10; ++i) {
+        libdnf5::rpm::PackageQuery query(base);
+        query.filter_file({"/usr/share/doc/pkg-0-0"});
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        libdnf5::advisory::AdvisoryQuery advisories(base);
+        advisories.filter_type("security");
+        advisories.get_advisory_packages_sorted(libdnf5::rpm::PackageQuery(base));
+    }
+}
@@ -27,17 +27,43 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 class RepoTest : public BaseTestCase {
     CPPUNIT_TEST_SUITE(RepoTest);
+#ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_load_system_repo);
+    CPPUNIT_TEST(test_load_system_repo_cache);
     CPPUNIT_TEST(test_load_repo);
     CPPUNIT_TEST(test_load_repo_nonexistent);
+    CPPUNIT_TEST(test_load_repo_local_in_place);
+    CPPUNIT_TEST(test_load_repo_local_in_place_url);
     CPPUNIT_TEST(test_update_and_load_enabled_repos_twice_fails);
+    CPPUNIT_TEST(test_load_repo_ondemand_filelists);
+    CPPUNIT_TEST(test_load_repo_ondemand_filelists_download);
+    CPPUNIT_TEST(test_create_repo_duplicate_id);
+    CPPUNIT_TEST(test_apply_cache_budget);
+    CPPUNIT_TEST(test_read_cached_package_names);
+    CPPUNIT_TEST(test_load_repo_corrupt_large_primary);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_load_repo_synthetic_performance);
+#endif
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void test_load_system_repo();
+    void test_load_system_repo_cache();
     void test_load_repo();
     void test_load_repo_nonexistent();
+    void test_load_repo_local_in_place();
+    void test_load_repo_local_in_place_url();
     void test_update_and_load_enabled_repos_twice_fails();
+    void test_load_repo_ondemand_filelists();
+    void test_load_repo_ondemand_filelists_download();
+    void test_create_repo_duplicate_id();
+    void test_apply_cache_budget();
+    void test_read_cached_package_names();
+    void test_load_repo_corrupt_large_primary();
+
+    void test_load_repo_synthetic_performance();
 };
 
 #endif
@@ -0,0 +1,83 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test_repo_pgp.hpp"
+
+#include "base/base_impl.hpp"
+#include "repo/repo_pgp.hpp"
+
+#include <libdnf5/utils/fs/file.hpp>
+
+#include <filesystem>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RepoPgpTest);
+
+
+namespace {
+
+const std::filesystem::path KEY_PATH = PROJECT_SOURCE_DIR "/test/data/keys/key.pub";
+
+std::vector<libdnf5::repo::Key> read_keys(
+    const libdnf5::BaseWeakPtr & base, const std::filesystem::path & path, const std::string & url) {
+    libdnf5::utils::fs::File key_file(path, "r");
+    return libdnf5::repo::RepoPgp::rawkey2infos(base, key_file.get_fd(), url, path);
+}
+
+}  // namespace
+
+
+void RepoPgpTest::test_key_file_parsed_once() {
+    auto & key_cache = libdnf5::InternalBaseUser::get_pgp_key_cache(base.get_weak_ptr());
+
+    // two repositories using the same key file
+    auto keys1 = read_keys(base.get_weak_ptr(), KEY_PATH, "file:///repo1.key");
+    auto keys2 = read_keys(base.get_weak_ptr(), KEY_PATH, "file:///repo2.key");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, key_cache.get_parsed_key_data_count());
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, keys1.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, keys2.size());
+    CPPUNIT_ASSERT_EQUAL(keys1[0].get_fingerprint(), keys2[0].get_fingerprint());
+    CPPUNIT_ASSERT_EQUAL(keys1[0].get_raw_key(), keys2[0].get_raw_key());
+
+    // the reused keys are reported with the location of the second repository
+    CPPUNIT_ASSERT_EQUAL(std::string("file:///repo1.key"), keys1[0].get_url());
+    CPPUNIT_ASSERT_EQUAL(std::string("file:///repo2.key"), keys2[0].get_url());
+    CPPUNIT_ASSERT_EQUAL(KEY_PATH.string(), keys2[0].get_path());
+}
+
+
+void RepoPgpTest::test_changed_key_file_parsed_again() {
+    auto & key_cache = libdnf5::InternalBaseUser::get_pgp_key_cache(base.get_weak_ptr());
+    auto key_path = temp->get_path() / "repo.key";
+    auto key_data = libdnf5::utils::fs::File(KEY_PATH, "r").read();
+
+    libdnf5::utils::fs::File(key_path, "w").write(key_data);
+    auto keys = read_keys(base.get_weak_ptr(), key_path, "file:///repo.key");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, keys.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, key_cache.get_parsed_key_data_count());
+
+    // the content of the file changed, it must not be served from the cache
+    libdnf5::utils::fs::File(key_path, "w").write(key_data + "\n");
+    auto changed_keys = read_keys(base.get_weak_ptr(), key_path, "file:///repo.key");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, changed_keys.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, key_cache.get_parsed_key_data_count());
+    CPPUNIT_ASSERT_EQUAL(keys[0].get_fingerprint(), changed_keys[0].get_fingerprint());
+}
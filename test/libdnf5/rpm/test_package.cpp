@@ -59,6 +59,7 @@ void RpmPackageTest::test_get_id() {
 
 void RpmPackageTest::test_get_name() {
     CPPUNIT_ASSERT_EQUAL(std::string("pkg"), get_pkg("pkg-1.2-3.x86_64").get_name());
+    CPPUNIT_ASSERT_EQUAL(std::string_view("pkg"), get_pkg("pkg-1.2-3.x86_64").get_name_view());
 }
 
 
@@ -80,11 +81,13 @@ void RpmPackageTest::test_get_release() {
 
 void RpmPackageTest::test_get_arch() {
     CPPUNIT_ASSERT_EQUAL(std::string("x86_64"), get_pkg("pkg-1.2-3.x86_64").get_arch());
+    CPPUNIT_ASSERT_EQUAL(std::string_view("x86_64"), get_pkg("pkg-1.2-3.x86_64").get_arch_view());
 }
 
 
 void RpmPackageTest::test_get_evr() {
     CPPUNIT_ASSERT_EQUAL(std::string("1.2-3"), get_pkg("pkg-1.2-3.x86_64").get_evr());
+    CPPUNIT_ASSERT_EQUAL(std::string_view("1.2-3"), get_pkg("pkg-1.2-3.x86_64").get_evr_view());
 }
 
 
@@ -170,6 +173,29 @@ void RpmPackageTest::test_get_files() {
 }
 
 
+void RpmPackageTest::test_get_changelogs_since() {
+    const auto pkg = get_pkg("pkg-1.2-3.x86_64");
+
+    auto changelogs = pkg.get_changelogs_since(0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), changelogs.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(1672563600), changelogs[0].timestamp);
+    CPPUNIT_ASSERT_EQUAL(std::string("Jo White"), changelogs[0].author);
+    CPPUNIT_ASSERT_EQUAL(std::string("Second change"), changelogs[0].text);
+    CPPUNIT_ASSERT_EQUAL(static_cast<time_t>(1641027600), changelogs[1].timestamp);
+
+    changelogs = pkg.get_changelogs_since(0, 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), changelogs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Second change"), changelogs[0].text);
+
+    changelogs = pkg.get_changelogs_since(1641027601);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), changelogs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Second change"), changelogs[0].text);
+
+    CPPUNIT_ASSERT(pkg.get_changelogs_since(1672563601).empty());
+    CPPUNIT_ASSERT(get_pkg("pkg-libs-1:1.3-4.x86_64").get_changelogs_since(0).empty());
+}
+
+
 void RpmPackageTest::test_get_provides() {
     auto actual = get_pkg("pkg-1.2-3.x86_64").get_provides();
     const std::vector<Reldep> expected = {Reldep(base, "pkg = 1.2-3")};
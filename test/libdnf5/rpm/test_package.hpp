@@ -52,6 +52,7 @@ class RpmPackageTest : public BaseTestCase {
     CPPUNIT_TEST(test_get_summary);
     CPPUNIT_TEST(test_get_description);
     CPPUNIT_TEST(test_get_files);
+    CPPUNIT_TEST(test_get_changelogs_since);
     CPPUNIT_TEST(test_get_provides);
     CPPUNIT_TEST(test_get_requires);
     CPPUNIT_TEST(test_get_requires_pre);
@@ -103,6 +104,7 @@ public:
     void test_get_summary();
     void test_get_description();
     void test_get_files();
+    void test_get_changelogs_since();
     void test_get_provides();
     void test_get_requires();
     void test_get_requires_pre();
@@ -24,8 +24,12 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_set.hpp>
+#include <libdnf5/rpm/reldep_list.hpp>
+
+#include <fnmatch.h>
 
 #include <filesystem>
+#include <functional>
 #include <set>
 #include <vector>
 
@@ -275,6 +279,86 @@ void RpmPackageQueryTest::test_filter_name() {
     CPPUNIT_ASSERT_EQUAL(expected, to_vector(query9));
 }
 
+void RpmPackageQueryTest::test_filter_name_after_repo_added() {
+    add_repo_solv("solv-repo1");
+
+    PackageQuery query1(base);
+    query1.filter_name({"pkg"});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), query1.size());
+
+    PackageQuery query2(base);
+    query2.filter_name({"PKG"}, libdnf5::sack::QueryCmp::IEXACT);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), query2.size());
+
+    // the sorted packages of the new repo are merged with the already sorted ones
+    add_repo_solv("solv-24pkgs");
+
+    PackageQuery query3(base);
+    query3.filter_name({"pkg"});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(26), query3.size());
+
+    PackageQuery query4(base);
+    query4.filter_name({"PKG"}, libdnf5::sack::QueryCmp::IEXACT);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(26), query4.size());
+
+    PackageQuery query5(base);
+    query5.filter_name({"pkg-libs"});
+    std::vector<Package> expected = {
+        get_pkg("pkg-libs-0:1.2-3.x86_64"), get_pkg("pkg-libs-1:1.2-4.x86_64"), get_pkg("pkg-libs-1:1.3-4.x86_64")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query5));
+
+    PackageQuery query6(base);
+    query6.filter_nevra({"pkg-0:1-24.noarch"});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), query6.size());
+}
+
+void RpmPackageQueryTest::test_filter_name_large_query() {
+    // big enough query to filter the names using the name trigram index
+    add_repo_synthetic("synthetic", 2000);
+
+    auto filter_linear = [this](const std::function<bool(const std::string &)> & match) {
+        std::vector<Package> result;
+        for (const auto & pkg : PackageQuery(base)) {
+            if (match(pkg.get_name())) {
+                result.push_back(pkg);
+            }
+        }
+        return result;
+    };
+
+    PackageQuery query1(base);
+    query1.filter_name({"kg-12"}, libdnf5::sack::QueryCmp::CONTAINS);
+    auto expected = filter_linear([](const std::string & name) { return name.find("kg-12") != std::string::npos; });
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(55), expected.size());
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query1));
+
+    PackageQuery query2(base);
+    query2.filter_name({"KG-12"}, libdnf5::sack::QueryCmp::ICONTAINS);
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query2));
+
+    PackageQuery query3(base);
+    query3.filter_name({"p[k]g-1?2"}, libdnf5::sack::QueryCmp::GLOB);
+    expected = filter_linear([](const std::string & name) { return fnmatch("p[k]g-1?2", name.c_str(), 0) == 0; });
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), expected.size());
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query3));
+
+    PackageQuery query4(base);
+    query4.filter_name({"PKG-3*"}, libdnf5::sack::QueryCmp::IGLOB);
+    expected = filter_linear([](const std::string & name) { return name.rfind("pkg-3", 0) == 0; });
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query4));
+
+    // patterns with no literal run long enough for the index
+    PackageQuery query5(base);
+    query5.filter_name({"*-1"}, libdnf5::sack::QueryCmp::GLOB);
+    expected = filter_linear([](const std::string & name) { return fnmatch("*-1", name.c_str(), 0) == 0; });
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query5));
+
+    PackageQuery query6(base);
+    query6.filter_name({"kg-12"}, libdnf5::sack::QueryCmp::NOT_CONTAINS);
+    expected = filter_linear([](const std::string & name) { return name.find("kg-12") == std::string::npos; });
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query6));
+}
+
 void RpmPackageQueryTest::test_filter_name_packgset() {
     add_repo_solv("solv-repo1");
 
@@ -534,6 +618,62 @@ void RpmPackageQueryTest::test_filter_priority() {
     /// TODO(jmracek) Run test with repository with a different priority and check result
 }
 
+void RpmPackageQueryTest::test_filter_latest_evr_by_priority() {
+    add_repo_solv("solv-repo1");
+    add_repo_solv("solv-24pkgs");
+    // the same packages in a repository with a lower priority
+    auto repo_low = repo_sack->create_repo_from_libsolv_testcase(
+        "solv-repo1-low", PROJECT_SOURCE_DIR "/test/data/repos-solv/solv-repo1.repo");
+    repo_low->set_priority(100);
+
+    for (int limit : {1, 2, -1}) {
+        PackageQuery expected(base);
+        expected.filter_priority();
+        expected.filter_latest_evr(limit);
+
+        PackageQuery query(base);
+        query.filter_latest_evr_by_priority(limit);
+        CPPUNIT_ASSERT_EQUAL(to_vector(expected), to_vector(query));
+    }
+
+    PackageQuery query(base);
+    query.filter_latest_evr_by_priority();
+    std::vector<Package> expected = {
+        get_pkg("pkg-0:1.2-3.src", "solv-repo1"),
+        get_pkg("pkg-0:1.2-3.x86_64", "solv-repo1"),
+        get_pkg("pkg-libs-1:1.3-4.x86_64", "solv-repo1"),
+        get_pkg("pkg-0:1-24.noarch")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+}
+
+void RpmPackageQueryTest::test_filter_latest_evr_per_repo() {
+    add_repo_solv("solv-repo1");
+    // the same packages in another repository
+    repo_sack->create_repo_from_libsolv_testcase(
+        "solv-repo1-copy", PROJECT_SOURCE_DIR "/test/data/repos-solv/solv-repo1.repo");
+
+    PackageQuery query(base);
+    query.filter_latest_evr_per_repo();
+    std::vector<Package> expected = {
+        get_pkg("pkg-0:1.2-3.src", "solv-repo1"),
+        get_pkg("pkg-0:1.2-3.x86_64", "solv-repo1"),
+        get_pkg("pkg-libs-1:1.3-4.x86_64", "solv-repo1"),
+        get_pkg("pkg-0:1.2-3.src", "solv-repo1-copy"),
+        get_pkg("pkg-0:1.2-3.x86_64", "solv-repo1-copy"),
+        get_pkg("pkg-libs-1:1.3-4.x86_64", "solv-repo1-copy")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+
+    // the same as filtering the latest packages of each repository separately
+    PackageQuery repo1_query(base);
+    repo1_query.filter_repo_id({"solv-repo1"});
+    repo1_query.filter_latest_evr();
+    PackageQuery copy_query(base);
+    copy_query.filter_repo_id({"solv-repo1-copy"});
+    copy_query.filter_latest_evr();
+    repo1_query |= copy_query;
+    CPPUNIT_ASSERT_EQUAL(to_vector(repo1_query), to_vector(query));
+}
+
 void RpmPackageQueryTest::test_filter_provides() {
     add_repo_solv("solv-repo1");
 
@@ -559,6 +699,28 @@ void RpmPackageQueryTest::test_filter_provides() {
 }
 
 
+void RpmPackageQueryTest::test_get_unprovided_reldeps() {
+    add_repo_solv("solv-repo1");
+
+    libdnf5::rpm::ReldepList reldeps(base);
+    reldeps.add(libdnf5::rpm::Reldep(base, "libpkg.so.0()(64bit)"));
+    reldeps.add(libdnf5::rpm::Reldep(base, "pkg"));
+    reldeps.add(libdnf5::rpm::Reldep(base, "nonexistent"));
+
+    // "libpkg.so.0()(64bit)" is provided only by pkg-libs packages which are not in the query
+    PackageQuery query(base);
+    query.filter_name({"pkg"});
+
+    libdnf5::rpm::ReldepList expected(base);
+    expected.add(libdnf5::rpm::Reldep(base, "libpkg.so.0()(64bit)"));
+    expected.add(libdnf5::rpm::Reldep(base, "nonexistent"));
+    CPPUNIT_ASSERT(expected == query.get_unprovided_reldeps(reldeps));
+
+    // the query itself is not modified
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), query.size());
+}
+
+
 void RpmPackageQueryTest::test_filter_requires() {
     add_repo_solv("solv-repo1");
 
@@ -583,6 +745,72 @@ void RpmPackageQueryTest::test_filter_requires() {
     CPPUNIT_ASSERT_EQUAL(expected, to_vector(query2));
 }
 
+void RpmPackageQueryTest::test_filter_obsoletes() {
+    add_repo_solv("solv-obsoletes");
+
+    PackageSet old1(base);
+    old1.add(get_pkg("old-1-1.noarch"));
+    PackageSet old2(base);
+    old2.add(get_pkg("old-2-1.noarch"));
+
+    // the repeated filtering switches to the obsoletes index, the results must not change
+    for (int i = 0; i < 3; ++i) {
+        PackageQuery query1(base);
+        query1.filter_obsoletes(old1);
+        std::vector<Package> expected = {get_pkg("new-1-1.noarch"), get_pkg("other-1-1.noarch")};
+        CPPUNIT_ASSERT_EQUAL(expected, to_vector(query1));
+
+        PackageQuery query2(base);
+        query2.filter_obsoletes(old2);
+        expected = {get_pkg("other-1-1.noarch")};
+        CPPUNIT_ASSERT_EQUAL(expected, to_vector(query2));
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_leaves() {
+    add_repo_solv("solv-repo1");
+
+    // pkg-libs-0:1.2-3.x86_64 is the only provider of a Requires of pkg-0:1.2-3.x86_64
+    PackageQuery query(base);
+    query.filter_leaves();
+
+    std::vector<Package> expected = {
+        get_pkg("pkg-0:1.2-3.src"),
+        get_pkg("pkg-0:1.2-3.x86_64"),
+        get_pkg("pkg-libs-1:1.2-4.x86_64"),
+        get_pkg("pkg-libs-1:1.3-4.x86_64")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+
+    // without pkg-0:1.2-3.x86_64 in the query nothing depends on pkg-libs-0:1.2-3.x86_64
+    PackageQuery query2(base);
+    query2.filter_name({"pkg-libs"});
+    auto groups = query2.filter_leaves_groups();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(3), groups.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(3), query2.size());
+}
+
+void RpmPackageQueryTest::test_filter_requires_closure() {
+    add_repo_solv("solv-repo1");
+
+    PackageSet start(base);
+    start.add(get_pkg("pkg-0:1.2-3.x86_64"));
+
+    // pkg-0:1.2-3.x86_64 requires pkg-libs = 1.2-3, provided by pkg-libs-0:1.2-3.x86_64
+    PackageQuery query(base);
+    query.filter_requires_closure(start);
+    std::vector<Package> expected = {get_pkg("pkg-0:1.2-3.x86_64"), get_pkg("pkg-libs-0:1.2-3.x86_64")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+
+    // the requires are resolved only with the packages of the query
+    PackageQuery query2(base);
+    query2.filter_name({"pkg"});
+    query2.filter_requires_closure(start);
+    expected = {get_pkg("pkg-0:1.2-3.x86_64")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query2));
+}
+
 void RpmPackageQueryTest::test_filter_advisories() {
     add_repo_repomd("repomd-repo1");
 
@@ -648,6 +876,45 @@ void RpmPackageQueryTest::test_filter_advisories() {
     }
 }
 
+void RpmPackageQueryTest::test_filter_latest_unresolved_advisories() {
+    add_repo_repomd("repomd-repo1");
+
+    PackageQuery nothing_installed(base);
+    nothing_installed.clear();
+
+    {
+        // Test QueryCmp::GTE with unresolved older advisory pkg
+        libdnf5::advisory::AdvisoryQuery adv_query(base);
+        adv_query.filter_name("PKG-OLDER");
+        PackageQuery query(base);
+        query.filter_latest_unresolved_advisories(adv_query, nothing_installed, libdnf5::sack::QueryCmp::GTE);
+        std::vector<Package> expected = {get_pkg("pkg-0:1.2-3.x86_64")};
+        CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+    }
+
+    {
+        // Test QueryCmp::GTE with older advisory pkg resolved by pkg-0:1.2-3.x86_64
+        libdnf5::advisory::AdvisoryQuery adv_query(base);
+        adv_query.filter_name("PKG-OLDER");
+        PackageQuery installed(base);
+        installed.filter_nevra({"pkg-0:1.2-3.x86_64"});
+        PackageQuery query(base);
+        query.filter_latest_unresolved_advisories(adv_query, installed, libdnf5::sack::QueryCmp::GTE);
+        std::vector<Package> expected = {};
+        CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+    }
+
+    {
+        // Test QueryCmp::EQ with advisory containing several pkgs
+        libdnf5::advisory::AdvisoryQuery adv_query(base);
+        adv_query.filter_name("DNF-2019-1");
+        PackageQuery query(base);
+        query.filter_latest_unresolved_advisories(adv_query, nothing_installed, libdnf5::sack::QueryCmp::EQ);
+        std::vector<Package> expected = {get_pkg("pkg-0:1.2-3.x86_64")};
+        CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+    }
+}
+
 void RpmPackageQueryTest::test_filter_chain() {
     add_repo_solv("solv-repo1");
 
@@ -830,3 +1097,86 @@ void RpmPackageQueryTest::test_filter_provides_performance() {
         query.filter_provides({"prv-all"});
     }
 }
+
+
+// Number of packages in the synthetic repo used by the following performance tests
+static constexpr std::size_t SYNTHETIC_REPO_SIZE = 100000;
+
+
+void RpmPackageQueryTest::test_filter_name_glob_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 100; ++i) {
+        PackageQuery query(base);
+        query.filter_name({"pkg-1*"}, libdnf5::sack::QueryCmp::GLOB);
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_name_contains_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 100; ++i) {
+        PackageQuery query(base);
+        query.filter_name({"g-99"}, libdnf5::sack::QueryCmp::ICONTAINS);
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_nevra_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 1000; ++i) {
+        PackageQuery query(base);
+        query.filter_nevra({"pkg-1234-0:3-1.x86_64"});
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_requires_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 1000; ++i) {
+        PackageQuery query(base);
+        query.filter_requires({"prv-1234"});
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_summary_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 10; ++i) {
+        PackageQuery query(base);
+        query.filter_summary({"number 1234"}, libdnf5::sack::QueryCmp::CONTAINS);
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_latest_evr_synthetic_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    for (int i = 0; i < 100; ++i) {
+        PackageQuery query(base);
+        query.filter_latest_evr();
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_leaves_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE / 10);
+
+    PackageQuery query(base);
+    query.filter_leaves();
+}
+
+
+void RpmPackageQueryTest::test_resolve_pkg_spec_performance() {
+    add_repo_synthetic("synthetic", SYNTHETIC_REPO_SIZE);
+
+    libdnf5::ResolveSpecSettings settings;
+    for (int i = 0; i < 100; ++i) {
+        PackageQuery query(base);
+        query.resolve_pkg_spec("pkg-1234", settings, true);
+    }
+}
@@ -35,6 +35,8 @@ class RpmPackageQueryTest : public BaseTestCase {
     CPPUNIT_TEST(test_filter_latest_evr);
     CPPUNIT_TEST(test_filter_earliest_evr);
     CPPUNIT_TEST(test_filter_name);
+    CPPUNIT_TEST(test_filter_name_after_repo_added);
+    CPPUNIT_TEST(test_filter_name_large_query);
     CPPUNIT_TEST(test_filter_name_packgset);
     CPPUNIT_TEST(test_filter_nevra_packgset);
     CPPUNIT_TEST(test_filter_nevra_packgset_cmp);
@@ -44,9 +46,16 @@ class RpmPackageQueryTest : public BaseTestCase {
     CPPUNIT_TEST(test_filter_version);
     CPPUNIT_TEST(test_filter_release);
     CPPUNIT_TEST(test_filter_priority);
+    CPPUNIT_TEST(test_filter_latest_evr_by_priority);
+    CPPUNIT_TEST(test_filter_latest_evr_per_repo);
     CPPUNIT_TEST(test_filter_provides);
+    CPPUNIT_TEST(test_get_unprovided_reldeps);
     CPPUNIT_TEST(test_filter_requires);
+    CPPUNIT_TEST(test_filter_obsoletes);
+    CPPUNIT_TEST(test_filter_leaves);
+    CPPUNIT_TEST(test_filter_requires_closure);
     CPPUNIT_TEST(test_filter_advisories);
+    CPPUNIT_TEST(test_filter_latest_unresolved_advisories);
     CPPUNIT_TEST(test_filter_chain);
     CPPUNIT_TEST(test_resolve_pkg_spec);
     CPPUNIT_TEST(test_update);
@@ -57,6 +66,14 @@ class RpmPackageQueryTest : public BaseTestCase {
 #ifdef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_filter_latest_evr_performance);
     CPPUNIT_TEST(test_filter_provides_performance);
+    CPPUNIT_TEST(test_filter_name_glob_performance);
+    CPPUNIT_TEST(test_filter_name_contains_performance);
+    CPPUNIT_TEST(test_filter_nevra_performance);
+    CPPUNIT_TEST(test_filter_requires_performance);
+    CPPUNIT_TEST(test_filter_summary_performance);
+    CPPUNIT_TEST(test_filter_latest_evr_synthetic_performance);
+    CPPUNIT_TEST(test_filter_leaves_performance);
+    CPPUNIT_TEST(test_resolve_pkg_spec_performance);
 #endif
 
     CPPUNIT_TEST_SUITE_END();
@@ -68,6 +85,8 @@ public:
     void test_filter_latest_evr();
     void test_filter_earliest_evr();
     void test_filter_name();
+    void test_filter_name_after_repo_added();
+    void test_filter_name_large_query();
     void test_filter_name_packgset();
     void test_filter_nevra_packgset();
     void test_filter_nevra_packgset_cmp();
@@ -77,9 +96,16 @@ public:
     void test_filter_version();
     void test_filter_release();
     void test_filter_provides();
+    void test_get_unprovided_reldeps();
     void test_filter_priority();
+    void test_filter_latest_evr_by_priority();
+    void test_filter_latest_evr_per_repo();
     void test_filter_requires();
+    void test_filter_obsoletes();
+    void test_filter_leaves();
+    void test_filter_requires_closure();
     void test_filter_advisories();
+    void test_filter_latest_unresolved_advisories();
     void test_filter_chain();
     void test_resolve_pkg_spec();
     void test_update();
@@ -88,6 +114,14 @@ public:
 
     void test_filter_latest_evr_performance();
     void test_filter_provides_performance();
+    void test_filter_name_glob_performance();
+    void test_filter_name_contains_performance();
+    void test_filter_nevra_performance();
+    void test_filter_requires_performance();
+    void test_filter_summary_performance();
+    void test_filter_latest_evr_synthetic_performance();
+    void test_filter_leaves_performance();
+    void test_resolve_pkg_spec_performance();
 
     // TODO(jmracek) Add tests when system repo will be available
     // PackageQuery & filter_upgrades();
@@ -22,9 +22,11 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "../shared/utils.hpp"
 
+#include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_sack.hpp>
 #include <libdnf5/rpm/package_set.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <set>
 #include <vector>
@@ -123,3 +125,81 @@ void RpmPackageSackTest::test_remove_user_includes() {
     sack->remove_user_includes(*pkgset);
     CPPUNIT_ASSERT(sack->get_user_includes().contains(*pkg0) == false);
 }
+
+
+void RpmPackageSackTest::test_update_excludes_after_query() {
+    // the excludes are changed while the considered map in the pool is up to date
+    PackageQuery all(base);
+    auto all_count = all.size();
+    auto it = all.begin();
+    PackageSet excluded(base);
+    excluded.add(*it);
+    PackageSet included(base);
+    included.add(*++it);
+
+    sack->add_user_excludes(excluded);
+    CPPUNIT_ASSERT_EQUAL(all_count - 1, PackageQuery(base).size());
+    CPPUNIT_ASSERT(!PackageQuery(base).contains(*excluded.begin()));
+
+    sack->remove_user_excludes(excluded);
+    CPPUNIT_ASSERT_EQUAL(all_count, PackageQuery(base).size());
+
+    // with includes, the removed exclude returns only the included packages
+    sack->set_user_includes(included);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(1), PackageQuery(base).size());
+    sack->add_user_excludes(excluded);
+    sack->remove_user_excludes(excluded);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(1), PackageQuery(base).size());
+    CPPUNIT_ASSERT(PackageQuery(base).contains(*included.begin()));
+}
+
+
+void RpmPackageSackTest::test_config_excludes_shared_by_repos() {
+    auto repo1 = add_repo_solv("solv-repo1");
+    libdnf5::repo::RepoQuery repos(base);
+    repos.filter_id("solv-24pkgs");
+    auto repo_24pkgs = *repos.begin();
+
+    // "pkg-1" matches all the packages in solv-24pkgs (name "pkg", version "1") and nothing in solv-repo1,
+    // the result must be the same as if it was resolved for each repository separately
+    repo_24pkgs->get_config().get_excludepkgs_option().set(std::vector<std::string>{"pkg-1"});
+    repo1->get_config().get_excludepkgs_option().set(std::vector<std::string>{"pkg-1", "pkg-libs"});
+    sack->load_config_excludes_includes();
+
+    PackageQuery query(base);
+    std::vector<std::string> expected = {"pkg-1.2-3.src", "pkg-1.2-3.x86_64"};
+    std::vector<std::string> nevras;
+    for (const auto & pkg : query) {
+        nevras.push_back(pkg.get_nevra());
+    }
+    std::sort(nevras.begin(), nevras.end());
+    CPPUNIT_ASSERT_EQUAL(expected, nevras);
+}
+
+
+void RpmPackageSackTest::test_make_indexes_ready() {
+    PackageQuery query_before(base);
+    query_before.filter_name(std::vector<std::string>{"*PKG*"}, libdnf5::sack::QueryCmp::IGLOB);
+
+    sack->make_indexes_ready();
+    PackageQuery query_after(base);
+    query_after.filter_name(std::vector<std::string>{"*PKG*"}, libdnf5::sack::QueryCmp::IGLOB);
+    CPPUNIT_ASSERT_EQUAL(query_before.size(), query_after.size());
+
+    // changed excludes are taken into account by the next call
+    PackageSet excluded(base);
+    PackageQuery query_all(base);
+    excluded.add(*query_all.begin());
+    sack->add_user_excludes(excluded);
+    sack->make_indexes_ready();
+    PackageQuery query_excluded(base);
+    CPPUNIT_ASSERT_EQUAL(query_all.size() - 1, query_excluded.size());
+    CPPUNIT_ASSERT(!query_excluded.contains(*excluded.begin()));
+
+    // removed excludes as well
+    sack->remove_user_excludes(excluded);
+    sack->make_indexes_ready();
+    PackageQuery query_restored(base);
+    CPPUNIT_ASSERT_EQUAL(query_all.size(), query_restored.size());
+    CPPUNIT_ASSERT(query_restored.contains(*excluded.begin()));
+}
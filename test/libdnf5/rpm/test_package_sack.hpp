@@ -39,6 +39,10 @@ class RpmPackageSackTest : public BaseTestCase {
     CPPUNIT_TEST(test_add_user_includes);
     CPPUNIT_TEST(test_remove_user_includes);
 
+    CPPUNIT_TEST(test_update_excludes_after_query);
+    CPPUNIT_TEST(test_config_excludes_shared_by_repos);
+    CPPUNIT_TEST(test_make_indexes_ready);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -52,6 +56,10 @@ public:
     void test_add_user_includes();
     void test_remove_user_includes();
 
+    void test_update_excludes_after_query();
+    void test_config_excludes_shared_by_repos();
+    void test_make_indexes_ready();
+
 private:
     std::unique_ptr<libdnf5::rpm::PackageSet> pkgset;
     std::unique_ptr<libdnf5::rpm::Package> pkg0;
@@ -74,3 +74,21 @@ void ReldepTest::test_invalid_reldep() {
     CPPUNIT_ASSERT_THROW(libdnf5::rpm::Reldep a(base, "(lab-list if labirinto.txt"), libdnf5::RuntimeError);
     CPPUNIT_ASSERT_THROW(libdnf5::rpm::Reldep a(base, "labirinto = "), libdnf5::RuntimeError);
 }
+
+
+void ReldepTest::test_reldep_id_cache() {
+    // repeated resolution of a dependency string returns the same id
+    libdnf5::rpm::Reldep a(base, "labirinto-cache = 1.0");
+    libdnf5::rpm::Reldep b(base, "labirinto-cache = 1.0");
+    CPPUNIT_ASSERT(a.get_id() == b.get_id());
+    CPPUNIT_ASSERT(a.to_string() == "labirinto-cache = 1.0");
+
+    libdnf5::rpm::Reldep c(base, "(labirinto-cache if labirinto)");
+    libdnf5::rpm::Reldep d(base, "(labirinto-cache if labirinto)");
+    CPPUNIT_ASSERT(c.get_id() == d.get_id());
+    CPPUNIT_ASSERT(a != c);
+
+    // invalid strings are not cached
+    CPPUNIT_ASSERT_THROW(libdnf5::rpm::Reldep e(base, "labirinto-cache = "), libdnf5::RuntimeError);
+    CPPUNIT_ASSERT_THROW(libdnf5::rpm::Reldep e(base, "labirinto-cache = "), libdnf5::RuntimeError);
+}
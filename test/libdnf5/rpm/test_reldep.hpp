@@ -31,6 +31,7 @@ class ReldepTest : public BaseTestCase {
     CPPUNIT_TEST(test_full_reldep);
     CPPUNIT_TEST(test_rich_reldep);
     CPPUNIT_TEST(test_invalid_reldep);
+    CPPUNIT_TEST(test_reldep_id_cache);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -38,6 +39,7 @@ public:
     void test_full_reldep();
     void test_rich_reldep();
     void test_invalid_reldep();
+    void test_reldep_id_cache();
 };
 
 #endif  // TEST_LIBDNF5_RPM_RELDEP_HPP
@@ -0,0 +1,128 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test_rpm_signature.hpp"
+
+#include "rpm/rpm_signature_private.hpp"
+
+#include <string>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RpmSignatureTest);
+
+
+using libdnf5::rpm::parse_verification_logs;
+using CheckResult = libdnf5::rpm::RpmSignature::CheckResult;
+
+
+namespace {
+
+const std::string PATH_ONE = "/path/to/one-1.0-1.x86_64.rpm";
+const std::string PATH_TWO = "/path/to/two-1.0-1.x86_64.rpm";
+
+}  // namespace
+
+
+void RpmSignatureTest::test_parse_verification_logs_ok() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: OK",
+        "    Header SHA256 digest: OK",
+        "    Payload SHA256 digest: OK"};
+    CPPUNIT_ASSERT(parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::OK});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_key_missing() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY",
+        "    Header RSA signature: NOTFOUND",
+        "    Header SHA256 digest: OK",
+        "    Payload SHA256 digest: OK",
+        "    RSA signature: NOTFOUND"};
+    CPPUNIT_ASSERT(
+        parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED_KEY_MISSING});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_not_trusted() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header V4 RSA/SHA256 Signature, key ID 12345678: NOTTRUSTED",
+        "    Header SHA256 digest: OK",
+        "    Payload SHA256 digest: OK"};
+    CPPUNIT_ASSERT(
+        parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED_NOT_TRUSTED});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_not_signed() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header RSA signature: NOTFOUND",
+        "    Header SHA256 digest: OK",
+        "    Payload SHA256 digest: OK",
+        "    RSA signature: NOTFOUND"};
+    CPPUNIT_ASSERT(
+        parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED_NOT_SIGNED});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_bad_digest_with_missing_key() {
+    // importing the missing key cannot fix a package with a broken digest
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY",
+        "    Header SHA256 digest: OK",
+        "    Payload SHA256 digest: BAD (Expected 0123 != 4567)"};
+    CPPUNIT_ASSERT(parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_bad_digest_not_signed() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header RSA signature: NOTFOUND",
+        "    Header SHA256 digest: BAD (Expected 0123 != 4567)",
+        "    Payload SHA256 digest: OK"};
+    CPPUNIT_ASSERT(parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_file_error() {
+    std::vector<std::string> logs{PATH_ONE + ": open failed: No such file or directory"};
+    CPPUNIT_ASSERT(parse_verification_logs(logs, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED});
+
+    // no messages at all means the file was not verified
+    CPPUNIT_ASSERT(parse_verification_logs({}, {PATH_ONE}) == std::vector<CheckResult>{CheckResult::FAILED});
+}
+
+
+void RpmSignatureTest::test_parse_verification_logs_multiple_files() {
+    std::vector<std::string> logs{
+        PATH_ONE + ":",
+        "    Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY",
+        "    Payload SHA256 digest: BAD (Expected 0123 != 4567)",
+        PATH_TWO + ":",
+        "    Header V4 EdDSA/SHA512 Signature, key ID 773dd1ba: NOKEY",
+        "    Payload SHA256 digest: OK"};
+    std::vector<CheckResult> expected{CheckResult::FAILED, CheckResult::FAILED_KEY_MISSING};
+    CPPUNIT_ASSERT(parse_verification_logs(logs, {PATH_ONE, PATH_TWO}) == expected);
+}
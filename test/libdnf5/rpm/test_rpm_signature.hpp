@@ -0,0 +1,50 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBDNF5_TEST_RPM_SIGNATURE_HPP
+#define LIBDNF5_TEST_RPM_SIGNATURE_HPP
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class RpmSignatureTest : public CppUnit::TestCase {
+    CPPUNIT_TEST_SUITE(RpmSignatureTest);
+    CPPUNIT_TEST(test_parse_verification_logs_ok);
+    CPPUNIT_TEST(test_parse_verification_logs_key_missing);
+    CPPUNIT_TEST(test_parse_verification_logs_not_trusted);
+    CPPUNIT_TEST(test_parse_verification_logs_not_signed);
+    CPPUNIT_TEST(test_parse_verification_logs_bad_digest_with_missing_key);
+    CPPUNIT_TEST(test_parse_verification_logs_bad_digest_not_signed);
+    CPPUNIT_TEST(test_parse_verification_logs_file_error);
+    CPPUNIT_TEST(test_parse_verification_logs_multiple_files);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void test_parse_verification_logs_ok();
+    void test_parse_verification_logs_key_missing();
+    void test_parse_verification_logs_not_trusted();
+    void test_parse_verification_logs_not_signed();
+    void test_parse_verification_logs_bad_digest_with_missing_key();
+    void test_parse_verification_logs_bad_digest_not_signed();
+    void test_parse_verification_logs_file_error();
+    void test_parse_verification_logs_multiple_files();
+};
+
+#endif  // LIBDNF5_TEST_RPM_SIGNATURE_HPP
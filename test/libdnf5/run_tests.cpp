@@ -31,6 +31,8 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/logger/stream_logger.hpp>
 
 #include <chrono>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 
@@ -50,16 +52,28 @@ public:
 
 class TimingListener : public CppUnit::TestListener {
 public:
+    /// @param results_path If not empty, durations of the tests are also written to this file in CSV format.
+    explicit TimingListener(const char * results_path) {
+        if (results_path && *results_path) {
+            results.open(results_path);
+            results << "test,duration_ms" << std::endl;
+        }
+    }
+
     void startTest(CppUnit::Test *) override { start = std::chrono::high_resolution_clock::now(); }
 
-    void endTest(CppUnit::Test *) override {
+    void endTest(CppUnit::Test * test) override {
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
         std::cout << " (duration: " << duration << "ms)";
+        if (results.is_open()) {
+            results << test->getName() << "," << duration << std::endl;
+        }
     }
 
 private:
     std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::from_time_t(0);
+    std::ofstream results;
 };
 
 class LogCaptureListener : public CppUnit::TestListener {
@@ -99,7 +113,8 @@ int main(int argc, char * argv[]) {
     CPPUNIT_NS::TestResultCollector result;
     controller.addListener(&result);
 
-    TimingListener timer;
+    // The durations can be stored in a machine-readable form to compare results of performance tests
+    TimingListener timer(std::getenv("LIBDNF5_TEST_TIMING_RESULTS"));
     controller.addListener(&timer);
 
     LogCaptureListener log_capture;
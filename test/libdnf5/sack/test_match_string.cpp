@@ -257,3 +257,49 @@ void SackMatchStringTest::test_invalid() {
     CPPUNIT_ASSERT_THROW(match_string("VALUE", QueryCmp::LT, PATTERN), libdnf5::AssertionError);
     CPPUNIT_ASSERT_THROW(match_string("VALUE", QueryCmp::LTE, PATTERN), libdnf5::AssertionError);
 }
+
+
+void SackMatchStringTest::test_string_matcher() {
+    const std::vector<std::string> values{"AbCdEfGhIjKlMnOp", "abcdef", ""};
+    const std::vector<std::string> patterns{
+        "AbCdEf", "ABcdEf", "KlMnOp", "A[a-d]Cd*Gh*Ij?lMnOp", "A[b-e]+fGhIj.lMNop", ""};
+    const QueryCmp cmps[]{
+        QueryCmp::EXACT,
+        QueryCmp::IEXACT,
+        QueryCmp::GLOB,
+        QueryCmp::IGLOB,
+        QueryCmp::REGEX,
+        QueryCmp::IREGEX,
+        QueryCmp::CONTAINS,
+        QueryCmp::ICONTAINS,
+        QueryCmp::STARTSWITH,
+        QueryCmp::ISTARTSWITH,
+        QueryCmp::ENDSWITH,
+        QueryCmp::IENDSWITH};
+
+    // The matcher must give the same results as match_string() for all input types.
+    for (auto base_cmp : cmps) {
+        for (auto cmp : {base_cmp, base_cmp | QueryCmp::NOT}) {
+            for (const auto & pattern : patterns) {
+                StringMatcher matcher(cmp, pattern);
+                for (const auto & value : values) {
+                    const bool expected = match_string(value, cmp, pattern);
+                    CPPUNIT_ASSERT_EQUAL(expected, matcher.match(value));
+                    CPPUNIT_ASSERT_EQUAL(expected, matcher.match(std::string_view(value)));
+                    CPPUNIT_ASSERT_EQUAL(expected, matcher.match(value.c_str()));
+                }
+                CPPUNIT_ASSERT_EQUAL(match_string(values, cmp, pattern), matcher.match(values));
+            }
+
+            StringMatcher matcher(cmp, patterns);
+            for (const auto & value : values) {
+                CPPUNIT_ASSERT_EQUAL(match_string(value, cmp, patterns), matcher.match(value));
+            }
+            CPPUNIT_ASSERT_EQUAL(match_string(values, cmp, patterns), matcher.match(values));
+            CPPUNIT_ASSERT_EQUAL(match_string(std::string(), cmp, patterns), matcher.match(nullptr));
+        }
+    }
+
+    StringMatcher invalid(QueryCmp::GT, "PATTERN");
+    CPPUNIT_ASSERT_THROW(invalid.match("VALUE"), libdnf5::AssertionError);
+}
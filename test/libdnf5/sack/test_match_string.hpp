@@ -30,11 +30,13 @@ class SackMatchStringTest : public CppUnit::TestCase {
     CPPUNIT_TEST_SUITE(SackMatchStringTest);
     CPPUNIT_TEST(test);
     CPPUNIT_TEST(test_invalid);
+    CPPUNIT_TEST(test_string_matcher);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void test();
     void test_invalid();
+    void test_string_matcher();
 };
 
 
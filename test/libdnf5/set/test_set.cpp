@@ -122,6 +122,30 @@ void SetTest::test_set_unary_operators() {
     s = {1, 2, 3, 4};
     s ^= {2, 4, 6};
     CPPUNIT_ASSERT((s == libdnf5::Set<int>{1, 3, 6}));
+
+    s = {3, 5};
+    s |= {1, 2, 4, 6, 7};
+    CPPUNIT_ASSERT((s == libdnf5::Set<int>{1, 2, 3, 4, 5, 6, 7}));
+
+    s = {1, 2, 3};
+    s &= {};
+    CPPUNIT_ASSERT(s.empty());
+
+    s = {1, 2, 3};
+    s ^= {0, 3, 4};
+    CPPUNIT_ASSERT((s == libdnf5::Set<int>{0, 1, 2, 4}));
+
+    // the other set is the same object
+    s = {1, 2, 3};
+    s |= s;
+    CPPUNIT_ASSERT((s == libdnf5::Set<int>{1, 2, 3}));
+    s &= s;
+    CPPUNIT_ASSERT((s == libdnf5::Set<int>{1, 2, 3}));
+    s -= s;
+    CPPUNIT_ASSERT(s.empty());
+    s = {1, 2, 3};
+    s ^= s;
+    CPPUNIT_ASSERT(s.empty());
 }
 
 // test unary methods update(), intersection(), difference(), symetric_difference(), and swap()
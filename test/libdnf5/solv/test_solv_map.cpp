@@ -21,6 +21,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include "test_solv_map.hpp"
 
 #include <cstdint>
+#include <vector>
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(SolvMapTest);
@@ -135,6 +136,55 @@ void SolvMapTest::test_difference() {
 }
 
 
+void SolvMapTest::test_size() {
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(4), map1->size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(2), map2->size());
+    CPPUNIT_ASSERT(!map1->empty());
+
+    // the map size is not a multiple of the word size
+    libdnf5::solv::SolvMap map(100);
+    CPPUNIT_ASSERT(map.empty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(0), map.size());
+    map.add(63);
+    map.add(64);
+    map.add(99);
+    CPPUNIT_ASSERT(!map.empty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(3), map.size());
+}
+
+
+void SolvMapTest::test_set_operations_different_sizes() {
+    libdnf5::solv::SolvMap small(72);
+    small.add(1);
+    small.add(64);
+    small.add(70);
+
+    libdnf5::solv::SolvMap big(200);
+    big.add(1);
+    big.add(70);
+    big.add(150);
+
+    // union grows the map when needed
+    libdnf5::solv::SolvMap map_union(small);
+    map_union |= big;
+    CPPUNIT_ASSERT(std::vector<Id>(map_union.begin(), map_union.end()) == (std::vector<Id>{1, 64, 70, 150}));
+
+    // intersection clears the items behind the smaller map
+    libdnf5::solv::SolvMap map_intersection(big);
+    map_intersection &= small;
+    CPPUNIT_ASSERT(std::vector<Id>(map_intersection.begin(), map_intersection.end()) == (std::vector<Id>{1, 70}));
+
+    // difference keeps the items behind the smaller map
+    libdnf5::solv::SolvMap map_difference(big);
+    map_difference -= small;
+    CPPUNIT_ASSERT(std::vector<Id>(map_difference.begin(), map_difference.end()) == (std::vector<Id>{150}));
+
+    map_difference = small;
+    map_difference -= big;
+    CPPUNIT_ASSERT(std::vector<Id>(map_difference.begin(), map_difference.end()) == (std::vector<Id>{64}));
+}
+
+
 void SolvMapTest::test_iterator_empty() {
     std::vector<Id> expected = {};
     std::vector<Id> result;
@@ -249,6 +299,26 @@ void SolvMapTest::test_iterator_sparse() {
 }
 
 
+void SolvMapTest::test_iterator_words() {
+    // items in the first and the last bits of the words and in the incomplete last word
+    std::vector<Id> expected = {0, 63, 64, 127, 200, 519, 520, 540};
+
+    libdnf5::solv::SolvMap map(541);
+    for (auto it : expected) {
+        map.add(it);
+    }
+    CPPUNIT_ASSERT(std::vector<Id>(map.begin(), map.end()) == expected);
+
+    auto it = map.begin();
+    it.jump(65);
+    CPPUNIT_ASSERT_EQUAL(*it, 127);
+    it.jump(201);
+    CPPUNIT_ASSERT_EQUAL(*it, 519);
+    it.jump(541);
+    CPPUNIT_ASSERT(it == map.end());
+}
+
+
 void SolvMapTest::test_iterator_performance_empty() {
     // initialize a map filed with zeros
     constexpr int max = 1000000;
@@ -291,3 +361,21 @@ void SolvMapTest::test_iterator_performance_4bits() {
         }
     }
 }
+
+
+void SolvMapTest::test_set_operations_performance() {
+    constexpr int max = 1000000;
+    libdnf5::solv::SolvMap map1(max);
+    libdnf5::solv::SolvMap map2(max);
+    memset(map1.get_map().map, 15, static_cast<std::size_t>(map1.get_map().size));
+    memset(map2.get_map().map, 60, static_cast<std::size_t>(map2.get_map().size));
+
+    std::size_t size = 0;
+    for (int i = 0; i < 5000; ++i) {
+        map1 |= map2;
+        map1 &= map2;
+        map1 -= map2;
+        size += map1.size();
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(0), size);
+}
@@ -39,15 +39,19 @@ class SolvMapTest : public CppUnit::TestCase {
     CPPUNIT_TEST(test_union);
     CPPUNIT_TEST(test_intersection);
     CPPUNIT_TEST(test_difference);
+    CPPUNIT_TEST(test_size);
+    CPPUNIT_TEST(test_set_operations_different_sizes);
     CPPUNIT_TEST(test_iterator_empty);
     CPPUNIT_TEST(test_iterator_full);
     CPPUNIT_TEST(test_iterator_sparse);
+    CPPUNIT_TEST(test_iterator_words);
 #endif
 
 #ifdef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_iterator_performance_empty);
     CPPUNIT_TEST(test_iterator_performance_full);
     CPPUNIT_TEST(test_iterator_performance_4bits);
+    CPPUNIT_TEST(test_set_operations_performance);
 #endif
 
     CPPUNIT_TEST_SUITE_END();
@@ -65,14 +69,18 @@ public:
     void test_union();
     void test_intersection();
     void test_difference();
+    void test_size();
+    void test_set_operations_different_sizes();
 
     void test_iterator_empty();
     void test_iterator_full();
     void test_iterator_sparse();
+    void test_iterator_words();
 
     void test_iterator_performance_empty();
     void test_iterator_performance_full();
     void test_iterator_performance_4bits();
+    void test_set_operations_performance();
 
 private:
     libdnf5::solv::SolvMap * map1;
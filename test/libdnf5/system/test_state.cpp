@@ -230,3 +230,29 @@ module-2 = {enabled_stream="stream-2",installed_profiles=[],state="Disabled"}
     CPPUNIT_ASSERT_EQUAL(
         modules_contents_after_remove, trim(libdnf5::utils::fs::File(path / "modules.toml", "r").read()));
 }
+
+void StateTest::test_state_save_changed_only() {
+    const auto & path = temp_dir->get_path();
+    libdnf5::system::State state(path);
+
+    // modify the files behind the back of the loaded state
+    const std::string packages_contents_modified = packages_contents + "# not rewritten\n";
+    libdnf5::utils::fs::File(path / "packages.toml", "w").write(packages_contents_modified);
+
+    state.set_rpmdb_cookie("bar");
+    state.save();
+
+    // unchanged state is not written, changed and missing files are
+    CPPUNIT_ASSERT_EQUAL(packages_contents_modified, libdnf5::utils::fs::File(path / "packages.toml", "r").read());
+    CPPUNIT_ASSERT_EQUAL(
+        std::string(R"""(version = "1.0"
+system = {rpmdb_cookie="bar"}
+)"""),
+        trim(libdnf5::utils::fs::File(path / "system.toml", "r").read()));
+    CPPUNIT_ASSERT(std::filesystem::exists(path / "environments.toml"));
+
+    state.set_package_reason("pkg.x86_64", transaction::TransactionItemReason::USER);
+    state.save();
+
+    CPPUNIT_ASSERT_EQUAL(packages_contents, trim(libdnf5::utils::fs::File(path / "packages.toml", "r").read()));
+}
@@ -38,6 +38,7 @@ class StateTest : public BaseTestCase {
     CPPUNIT_TEST(test_state_version);
     CPPUNIT_TEST(test_state_read);
     CPPUNIT_TEST(test_state_write);
+    CPPUNIT_TEST(test_state_save_changed_only);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -47,6 +48,7 @@ public:
     void test_state_version();
     void test_state_read();
     void test_state_write();
+    void test_state_save_changed_only();
 
     std::unique_ptr<libdnf5::utils::fs::TempDir> temp_dir;
 };
@@ -27,6 +27,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/transaction/transaction.hpp>
 
 #include <string>
+#include <vector>
 
 
 using namespace libdnf5::transaction;
@@ -110,3 +111,96 @@ void TransactionRpmPackageTest::test_save_load() {
         pkg2_num++;
     }
 }
+
+
+void TransactionRpmPackageTest::test_load_transactions_packages() {
+    auto base = new_base();
+
+    // save three transactions, the n-th one with n packages
+    std::vector<int64_t> ids;
+    for (std::size_t trans_num = 1; trans_num <= 3; trans_num++) {
+        auto trans = (*(base->get_transaction_history()).*get(new_transaction{}))();
+        for (std::size_t i = 0; i < trans_num; i++) {
+            auto & pkg = (trans.*get(new_package{}))();
+            (pkg.*get(set_name{}))("name_" + std::to_string(trans_num) + "_" + std::to_string(i));
+            (pkg.*get(set_epoch{}))("1");
+            (pkg.*get(set_version{}))("2");
+            (pkg.*get(set_release{}))("3");
+            (pkg.*get(set_arch{}))("x86_64");
+            (pkg.*get(set_repoid{}))("repoid");
+            (pkg.*get(set_action{}))(TransactionItemAction::INSTALL);
+            (pkg.*get(set_reason{}))(TransactionItemReason::USER);
+            (pkg.*get(set_state{}))(TransactionItemState::OK);
+        }
+        (trans.*get(start{}))();
+        (trans.*get(finish{}))(TransactionState::OK);
+        ids.push_back(trans.get_id());
+    }
+
+    // create a new Base to force reading the transactions from disk
+    auto base2 = new_base();
+
+    // load packages of the first and the last transaction at once
+    auto ts_list = base2->get_transaction_history()->list_transactions({ids[0], ids[2]});
+    CPPUNIT_ASSERT_EQUAL((size_t)2, ts_list.size());
+    base2->get_transaction_history()->load_transactions_packages(ts_list);
+
+    for (auto & trans : ts_list) {
+        std::size_t trans_num = trans.get_id() == ids[0] ? 1 : 3;
+        auto & packages = trans.get_packages();
+        CPPUNIT_ASSERT_EQUAL(trans_num, packages.size());
+        for (std::size_t i = 0; i < trans_num; i++) {
+            CPPUNIT_ASSERT_EQUAL(
+                std::string("name_") + std::to_string(trans_num) + "_" + std::to_string(i), packages[i].get_name());
+            CPPUNIT_ASSERT_EQUAL(std::string("x86_64"), packages[i].get_arch());
+            CPPUNIT_ASSERT_EQUAL(std::string("repoid"), packages[i].get_repoid());
+        }
+    }
+}
+
+
+void TransactionRpmPackageTest::test_list_transactions_by_package() {
+    auto base = new_base();
+
+    // save two transactions, each with a different package
+    std::vector<int64_t> ids;
+    for (const auto * name : {"openssl", "bash"}) {
+        auto trans = (*(base->get_transaction_history()).*get(new_transaction{}))();
+        auto & pkg = (trans.*get(new_package{}))();
+        (pkg.*get(set_name{}))(name);
+        (pkg.*get(set_epoch{}))("1");
+        (pkg.*get(set_version{}))("2");
+        (pkg.*get(set_release{}))("3");
+        (pkg.*get(set_arch{}))("x86_64");
+        (pkg.*get(set_repoid{}))("repoid");
+        (pkg.*get(set_action{}))(TransactionItemAction::INSTALL);
+        (pkg.*get(set_reason{}))(TransactionItemReason::USER);
+        (pkg.*get(set_state{}))(TransactionItemState::OK);
+        (trans.*get(start{}))();
+        (trans.*get(finish{}))(TransactionState::OK);
+        ids.push_back(trans.get_id());
+    }
+
+    auto history = base->get_transaction_history();
+
+    auto ts_list = history->list_transactions_by_package("openssl");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ts_list.size());
+    CPPUNIT_ASSERT_EQUAL(ids[0], ts_list[0].get_id());
+
+    ts_list = history->list_transactions_by_package("open*");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ts_list.size());
+    CPPUNIT_ASSERT_EQUAL(ids[0], ts_list[0].get_id());
+
+    ts_list = history->list_transactions_by_package("bash-2-3.x86_64");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ts_list.size());
+    CPPUNIT_ASSERT_EQUAL(ids[1], ts_list[0].get_id());
+
+    ts_list = history->list_transactions_by_package("bash-1:2-3.*");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ts_list.size());
+    CPPUNIT_ASSERT_EQUAL(ids[1], ts_list[0].get_id());
+
+    ts_list = history->list_transactions_by_package("*-2-3.x86_64");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, ts_list.size());
+
+    CPPUNIT_ASSERT(history->list_transactions_by_package("zsh").empty());
+}
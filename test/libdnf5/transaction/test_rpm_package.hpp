@@ -31,10 +31,14 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 class TransactionRpmPackageTest : public TransactionTestBase {
     CPPUNIT_TEST_SUITE(TransactionRpmPackageTest);
     CPPUNIT_TEST(test_save_load);
+    CPPUNIT_TEST(test_load_transactions_packages);
+    CPPUNIT_TEST(test_list_transactions_by_package);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void test_save_load();
+    void test_load_transactions_packages();
+    void test_list_transactions_by_package();
 };
 
 
@@ -0,0 +1,131 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test_transaction_sr.hpp"
+
+#include "transaction/transaction_sr.hpp"
+
+#include <libdnf5/common/exception.hpp>
+
+#include <string>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TransactionReplayTest);
+
+
+using namespace libdnf5::transaction;
+
+
+void TransactionReplayTest::test_parse() {
+    auto replay = parse_transaction_replay(R"({
+    "rpms": [
+        {"nevra": "pkg-1.2-3.x86_64", "action": "Install", "reason": "User", "repo_id": "repo1"},
+        {
+            "nevra": "pkg-libs-1.2-3.x86_64",
+            "action": "Upgrade",
+            "reason": "Group",
+            "repo_id": "@commandline",
+            "package_path": "/tmp/pkg-libs-1.2-3.x86_64.rpm",
+            "group_id": "core"
+        }
+    ],
+    "groups": [{"id": "core", "action": "Install", "reason": "User", "repo_id": "repo1"}],
+    "environments": [{"id": "minimal", "action": "Install", "repo_id": "repo1"}],
+    "version": "1.0"
+})");
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2, replay.packages.size());
+    auto & pkg = replay.packages[0];
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg-1.2-3.x86_64"), pkg.nevra);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::INSTALL, pkg.action);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemReason::USER, pkg.reason);
+    CPPUNIT_ASSERT_EQUAL(std::string("repo1"), pkg.repo_id);
+    CPPUNIT_ASSERT(pkg.package_path.empty());
+    CPPUNIT_ASSERT(pkg.group_id.empty());
+    auto & pkg_libs = replay.packages[1];
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg-libs-1.2-3.x86_64"), pkg_libs.nevra);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::UPGRADE, pkg_libs.action);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemReason::GROUP, pkg_libs.reason);
+    CPPUNIT_ASSERT_EQUAL(std::string("@commandline"), pkg_libs.repo_id);
+    CPPUNIT_ASSERT_EQUAL(std::string("/tmp/pkg-libs-1.2-3.x86_64.rpm"), pkg_libs.package_path.native());
+    CPPUNIT_ASSERT_EQUAL(std::string("core"), pkg_libs.group_id);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, replay.groups.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("core"), replay.groups[0].group_id);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::INSTALL, replay.groups[0].action);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemReason::USER, replay.groups[0].reason);
+    CPPUNIT_ASSERT_EQUAL(std::string("repo1"), replay.groups[0].repo_id);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, replay.environments.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("minimal"), replay.environments[0].environment_id);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::INSTALL, replay.environments[0].action);
+    CPPUNIT_ASSERT_EQUAL(std::string("repo1"), replay.environments[0].repo_id);
+}
+
+
+void TransactionReplayTest::test_parse_errors() {
+    CPPUNIT_ASSERT_THROW(parse_transaction_replay(""), libdnf5::Error);
+    CPPUNIT_ASSERT_THROW(parse_transaction_replay("{\"rpms\": ["), libdnf5::Error);
+    CPPUNIT_ASSERT_THROW(parse_transaction_replay(R"({"version": "2.0"})"), libdnf5::Error);
+}
+
+
+void TransactionReplayTest::test_serialize_and_parse() {
+    TransactionReplay replay;
+    replay.packages.push_back(
+        {TransactionItemAction::INSTALL, TransactionItemReason::DEPENDENCY, "", "pkg-1.2-3.x86_64", "", "repo1"});
+    replay.packages.push_back(
+        {TransactionItemAction::REMOVE,
+         TransactionItemReason::GROUP,
+         "core",
+         "pkg-libs-1.2-3.x86_64",
+         "/tmp/pkg-libs-1.2-3.x86_64.rpm",
+         "@System"});
+    replay.groups.push_back({TransactionItemAction::REMOVE, TransactionItemReason::USER, "core", "repo1"});
+    replay.environments.push_back({TransactionItemAction::INSTALL, "minimal", "repo1"});
+
+    auto json = json_serialize(replay);
+    // members with empty values are not serialized
+    CPPUNIT_ASSERT_EQUAL(std::string::npos, json.find("\"package_path\": \"\""));
+    CPPUNIT_ASSERT_EQUAL(std::string::npos, json.find("\"group_id\": \"\""));
+    CPPUNIT_ASSERT(json.find("\"version\": \"1.0\"") != std::string::npos);
+
+    auto parsed = parse_transaction_replay(json);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, parsed.packages.size());
+    for (std::size_t i = 0; i < replay.packages.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].action, parsed.packages[i].action);
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].reason, parsed.packages[i].reason);
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].group_id, parsed.packages[i].group_id);
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].nevra, parsed.packages[i].nevra);
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].package_path.native(), parsed.packages[i].package_path.native());
+        CPPUNIT_ASSERT_EQUAL(replay.packages[i].repo_id, parsed.packages[i].repo_id);
+    }
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, parsed.groups.size());
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::REMOVE, parsed.groups[0].action);
+    CPPUNIT_ASSERT_EQUAL(TransactionItemReason::USER, parsed.groups[0].reason);
+    CPPUNIT_ASSERT_EQUAL(std::string("core"), parsed.groups[0].group_id);
+    CPPUNIT_ASSERT_EQUAL(std::string("repo1"), parsed.groups[0].repo_id);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)1, parsed.environments.size());
+    CPPUNIT_ASSERT_EQUAL(TransactionItemAction::INSTALL, parsed.environments[0].action);
+    CPPUNIT_ASSERT_EQUAL(std::string("minimal"), parsed.environments[0].environment_id);
+    CPPUNIT_ASSERT_EQUAL(std::string("repo1"), parsed.environments[0].repo_id);
+}
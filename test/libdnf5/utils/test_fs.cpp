@@ -25,6 +25,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <fcntl.h>
 #include <libdnf5/common/exception.hpp>
 
+#include <chrono>
 #include <filesystem>
 
 
@@ -311,6 +312,24 @@ void UtilsFsTest::test_file_high_level_io() {
 }
 
 
+void UtilsFsTest::test_file_read_compressed() {
+    libdnf5::utils::fs::TempDir temp_dir("libdnf_unittest_file_read_compressed");
+    auto path = temp_dir.get_path() / "file.gz";
+
+    // more than one read chunk
+    std::string data_w = generate_test_data(200000);
+    {
+        libdnf5::utils::fs::File file(path, "w", true);
+        file.write(data_w);
+    }
+
+    libdnf5::utils::fs::File file(path, "r", true);
+    CPPUNIT_ASSERT_EQUAL(data_w.substr(0, 100000), file.read(100000));
+    CPPUNIT_ASSERT_EQUAL(data_w.substr(100000), file.read());
+    CPPUNIT_ASSERT_EQUAL(std::string(), file.read());
+}
+
+
 void UtilsFsTest::test_file_read_line() {
     libdnf5::utils::fs::TempDir temp_dir("libdnf_unittest_file_read_line");
 
@@ -410,3 +429,29 @@ void UtilsFsTest::test_file_flush() {
 
     CPPUNIT_ASSERT_EQUAL(data_w, data_r);
 }
+
+
+void UtilsFsTest::test_break_hard_link() {
+    libdnf5::utils::fs::TempDir temp_dir("libdnf_unittest_break_hard_link");
+    auto src_path = temp_dir.get_path() / "src";
+    auto link_path = temp_dir.get_path() / "link";
+
+    std::string data = generate_test_data(100);
+    libdnf5::utils::fs::File(src_path, "w").write(data);
+    stdfs::create_hard_link(src_path, link_path);
+    auto src_time = stdfs::last_write_time(src_path);
+
+    break_hard_link(link_path);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uintmax_t>(1), stdfs::hard_link_count(src_path));
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uintmax_t>(1), stdfs::hard_link_count(link_path));
+    CPPUNIT_ASSERT_EQUAL(data, libdnf5::utils::fs::File(link_path, "r").read());
+    CPPUNIT_ASSERT(src_time == stdfs::last_write_time(link_path));
+
+    // changing the timestamp of the copy does not change the original
+    stdfs::last_write_time(link_path, src_time + std::chrono::hours(1));
+    CPPUNIT_ASSERT(src_time == stdfs::last_write_time(src_path));
+
+    // a file without other links is left as it is
+    break_hard_link(src_path);
+    CPPUNIT_ASSERT_EQUAL(data, libdnf5::utils::fs::File(src_path, "r").read());
+}
@@ -43,11 +43,14 @@ class UtilsFsTest : public CppUnit::TestCase {
     CPPUNIT_TEST(test_file_open_fd);
     CPPUNIT_TEST(test_file_putc_getc);
     CPPUNIT_TEST(test_file_high_level_io);
+    CPPUNIT_TEST(test_file_read_compressed);
     CPPUNIT_TEST(test_file_read_line);
     CPPUNIT_TEST(test_file_seek);
     CPPUNIT_TEST(test_file_release);
     CPPUNIT_TEST(test_file_flush);
 
+    CPPUNIT_TEST(test_break_hard_link);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,10 +65,13 @@ public:
     void test_file_open_fd();
     void test_file_putc_getc();
     void test_file_high_level_io();
+    void test_file_read_compressed();
     void test_file_read_line();
     void test_file_seek();
     void test_file_release();
     void test_file_flush();
+
+    void test_break_hard_link();
 };
 
 
@@ -0,0 +1,57 @@
+/*
+Copyright Contributors to the libdnf project.
+
+This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+
+Libdnf is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+Libdnf is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test_progress_throttle.hpp"
+
+#include "utils/progress_throttle.hpp"
+
+#include <chrono>
+
+
+using libdnf5::utils::ProgressThrottle;
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(UtilsProgressThrottleTest);
+
+
+void UtilsProgressThrottleTest::test_zero_interval() {
+    ProgressThrottle throttle;
+    CPPUNIT_ASSERT(throttle.should_notify(1, 10));
+    CPPUNIT_ASSERT(throttle.should_notify(2, 10));
+    CPPUNIT_ASSERT(throttle.should_notify(3, 10));
+}
+
+
+void UtilsProgressThrottleTest::test_interval() {
+    ProgressThrottle throttle(std::chrono::hours(1));
+
+    // the first notification is passed, the following ones within the interval are dropped
+    CPPUNIT_ASSERT(throttle.should_notify(1, 10));
+    CPPUNIT_ASSERT(!throttle.should_notify(2, 10));
+    CPPUNIT_ASSERT(!throttle.should_notify(3, 0));
+
+    // completion is always passed
+    CPPUNIT_ASSERT(throttle.should_notify(10, 10));
+
+    // a new item starts with a passed notification
+    throttle.reset();
+    CPPUNIT_ASSERT(throttle.should_notify(1, 10));
+    CPPUNIT_ASSERT(!throttle.should_notify(2, 10));
+}
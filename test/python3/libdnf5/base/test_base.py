@@ -19,6 +19,8 @@ import unittest
 
 import libdnf5.base
 
+import base_test_case
+
 
 class TestBase(unittest.TestCase):
     def test_base(self):
@@ -60,3 +62,14 @@ class TestBase(unittest.TestCase):
         base.get_config().config_file_path = 'this-path-does-not-exist.conf'
 
         self.assertRaises(RuntimeError, base.load_config)
+
+
+class TestBaseMemoryUsage(base_test_case.BaseTestCase):
+    def test_get_memory_usage(self):
+        self.add_repo_repomd("repomd-repo1")
+
+        usage = self.base.get_memory_usage()
+        self.assertGreater(usage["rpm_pool.strings"], 0)
+        self.assertGreater(usage["rpm_pool.solvables"], 0)
+        self.assertGreater(usage["repo.repomd-repo1"], 0)
+        self.assertIn("logger.memory_buffer", usage)
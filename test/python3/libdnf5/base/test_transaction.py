@@ -15,6 +15,8 @@
 # You should have received a copy of the GNU General Public License
 # along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
+import threading
+
 import libdnf5.base
 
 import base_test_case
@@ -45,3 +47,18 @@ class TestTransaction(base_test_case.BaseTestCase):
         self.assertEqual(1, transaction.get_transaction_packages_count())
         self.assertFalse(transaction.check_gpg_signatures())
         self.assertTrue(len(transaction.get_gpg_signature_problems()) > 0)
+
+    def test_resolve_in_thread(self):
+        # The GIL is released during resolving, other Python threads keep running
+        results = []
+
+        def resolve():
+            goal = libdnf5.base.Goal(self.base)
+            goal.add_rpm_install("pkg")
+            results.append(goal.resolve().get_transaction_packages_count())
+
+        thread = threading.Thread(target=resolve)
+        thread.start()
+        thread.join()
+
+        self.assertEqual([1], results)
@@ -161,3 +161,18 @@ class TestPackageQuery(base_test_case.BaseTestCase):
         self.assertEqual('First change', log.text)
         self.assertEqual('Joe Black', log.author)
         self.assertEqual(1641027600, log.timestamp)
+
+    def test_bulk_getters(self):
+        query = libdnf5.rpm.PackageQuery(self.base)
+        query.filter_name(["pk*"], libdnf5.common.QueryCmp_GLOB)
+        self.assertEqual(list(query.get_names()), ["pkg", "pkg-libs"])
+        self.assertEqual(list(query.get_nevras()), [
+                         "pkg-1.2-3.x86_64", "pkg-libs-1:1.3-4.x86_64"])
+        self.assertEqual(list(query.get_nevras()), [
+                         i.get_nevra() for i in query])
+
+        rows = query.get_attributes(["name", "arch", "evr"])
+        self.assertEqual([list(row) for row in rows], [
+                         ["pkg", "x86_64", "1.2-3"], ["pkg-libs", "x86_64", "1:1.3-4"]])
+
+        self.assertRaises(RuntimeError, query.get_attributes, ["unknown"])
@@ -34,6 +34,7 @@ along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 #include <libdnf5/rpm/package_query.hpp>
 
 #include <filesystem>
+#include <fstream>
 #include <map>
 
 
@@ -76,6 +77,28 @@ libdnf5::repo::RepoWeakPtr BaseTestCase::add_repo_solv(const std::string & repoi
 }
 
 
+libdnf5::repo::RepoWeakPtr BaseTestCase::add_repo_synthetic(const std::string & repoid, std::size_t pkg_count) {
+    constexpr std::size_t versions_per_name = 5;
+    const std::size_t names_count = (pkg_count + versions_per_name - 1) / versions_per_name;
+
+    auto repo_path = temp->get_path() / (repoid + ".repo");
+    std::ofstream repo_file(repo_path);
+    repo_file << "=Ver: 3.0\n";
+    for (std::size_t i = 0; i < pkg_count; ++i) {
+        auto name_idx = i / versions_per_name;
+        repo_file << format("=Pkg: pkg-{} {} 1 {}\n", name_idx, i % versions_per_name + 1, i % 2 ? "noarch" : "x86_64");
+        repo_file << format("=Prv: prv-{}\n", name_idx);
+        if (name_idx + 1 < names_count) {
+            repo_file << format("=Req: prv-{}\n", name_idx + 1);
+        }
+        repo_file << format("=Sum: Summary of the synthetic package number {}\n", i);
+    }
+    repo_file.close();
+
+    return repo_sack->create_repo_from_libsolv_testcase(repoid.c_str(), repo_path.native());
+}
+
+
 libdnf5::advisory::Advisory BaseTestCase::get_advisory(const std::string & name) {
     // This is used for testing queries as well, hence we don't use the AdvisoryQuery facility for filtering
     libdnf5::advisory::AdvisorySet advisories = libdnf5::advisory::AdvisoryQuery(base);
@@ -52,6 +52,11 @@ public:
     // Add (load) a repo from PROJECT_SOURCE_DIR/test/data/repos-solv/<repoid>.repo
     libdnf5::repo::RepoWeakPtr add_repo_solv(const std::string & repoid);
 
+    // Add (load) a generated repo with `pkg_count` packages, used for performance tests.
+    // There are 5 versions of each package name "pkg-<N>", every package provides "prv-<N>"
+    // and requires "prv-<N + 1>", the last name has no requires.
+    libdnf5::repo::RepoWeakPtr add_repo_synthetic(const std::string & repoid, std::size_t pkg_count);
+
     libdnf5::advisory::Advisory get_advisory(const std::string & name);
 
     libdnf5::comps::Environment get_environment(const std::string & environmentid, bool installed = false);